@@ -34,6 +34,7 @@ namespace nd4j {
         _debug.store(false);
         _profile.store(false);
         _precBoost.store(false);
+        _mathPrecision.store(nd4j::MathPrecision::MATH_LIBM);
         _dataType.store(nd4j::DataType::FLOAT32);
 
 #ifndef ANDROID
@@ -130,6 +131,17 @@ namespace nd4j {
         _maxThreads.store(max);
     }
 
+    nd4j::MathPrecision Environment::mathPrecision() {
+        return static_cast<nd4j::MathPrecision>(_mathPrecision.load());
+    }
+
+    void Environment::setMathPrecision(nd4j::MathPrecision precision) {
+        if (precision != nd4j::MathPrecision::MATH_LIBM && precision != nd4j::MathPrecision::MATH_VECTOR && precision != nd4j::MathPrecision::MATH_FAST)
+            throw std::runtime_error("Math precision must be one of [LIBM, VECTOR, FAST]");
+
+        _mathPrecision.store(precision);
+    }
+
     bool Environment::precisionBoostAllowed() {
         return _precBoost.load();
     }
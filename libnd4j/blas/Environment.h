@@ -25,6 +25,8 @@
 #include <dll.h>
 #include <stdexcept>
 #include <array/DataType.h>
+#include <pointercast.h>
+#include <helpers/MathPrecision.h>
 
 namespace nd4j{
     class ND4J_EXPORT Environment {
@@ -38,6 +40,14 @@ namespace nd4j{
         std::atomic<nd4j::DataType> _dataType;
         std::atomic<bool> _precBoost;
         std::atomic<bool> _useMKLDNN{true};
+        std::atomic<bool> _foldQuantization{false};
+        std::atomic<bool> _optimizeLayouts{true};
+        std::atomic<bool> _foldConstants{true};
+        std::atomic<bool> _simplifyGraphs{true};
+        std::atomic<bool> _inferShapes{true};
+        std::atomic<bool> _compileLoops{true};
+        std::atomic<Nd4jLong> _maxLoopIterations{100000000L};
+        std::atomic<int> _mathPrecision;
 
 #ifdef __ND4J_EXPERIMENTAL__
         const bool _experimental = true;
@@ -69,9 +79,59 @@ namespace nd4j{
         int maxThreads();
         void setMaxThreads(int max);
 
+        /**
+         * Accuracy tier used by transcendental transforms (exp, log, tanh, sigmoid, erf etc), see VectorMath.h
+         */
+        nd4j::MathPrecision mathPrecision();
+        void setMathPrecision(nd4j::MathPrecision precision);
+
         bool isUseMKLDNN() { return _useMKLDNN.load(); }
         void setUseMKLDNN(bool useMKLDNN) { _useMKLDNN.store(useMKLDNN); }
 
+        /**
+         * If true, Graph::buildGraph() folds fake-quant nodes into int8 qmatmul/qconv2d nodes.
+         * Off by default: folding reproduces fake_quant_with_min_max_vars grid as is, including its
+         * 2^(numBits - 1) upper bound, so it's only enabled explicitly by users who rely on that grid
+         */
+        bool isFoldQuantization() { return _foldQuantization.load(); }
+        void setFoldQuantization(bool reallyFold) { _foldQuantization.store(reallyFold); }
+
+        /**
+         * If true, built graphs go through Graph::optimizeLayouts(), which removes redundant permute/transpose nodes
+         */
+        bool isOptimizeLayouts() { return _optimizeLayouts.load(); }
+        void setOptimizeLayouts(bool reallyOptimize) { _optimizeLayouts.store(reallyOptimize); }
+
+        /**
+         * If true, built graphs go through Graph::foldConstants() and Graph::pruneUnreachable()
+         */
+        bool isFoldConstants() { return _foldConstants.load(); }
+        void setFoldConstants(bool reallyFold) { _foldConstants.store(reallyFold); }
+
+        /**
+         * If true, built graphs go through Graph::simplify(), which merges duplicate nodes and removes identities
+         */
+        bool isSimplifyGraphs() { return _simplifyGraphs.load(); }
+        void setSimplifyGraphs(bool reallySimplify) { _simplifyGraphs.store(reallySimplify); }
+
+        /**
+         * If true, GraphExecutioner runs Graph::inferShapes() before execution, so nodes with known shapes skip shape functions
+         */
+        bool isInferShapes() { return _inferShapes.load(); }
+        void setInferShapes(bool reallyInfer) { _inferShapes.store(reallyInfer); }
+
+        /**
+         * If true, top-level loop frames are executed by FrameExecutor as straight-line schedules, instead of rewinding graph layers
+         */
+        bool isCompileLoops() { return _compileLoops.load(); }
+        void setCompileLoops(bool reallyCompile) { _compileLoops.store(reallyCompile); }
+
+        /**
+         * Safety limit for number of iterations of a single loop frame, execution fails once it's exceeded. 0 means no limit
+         */
+        Nd4jLong maxLoopIterations() { return _maxLoopIterations.load(); }
+        void setMaxLoopIterations(Nd4jLong maxIterations) { _maxLoopIterations.store(maxIterations); }
+
         nd4j::DataType defaultFloatDataType();
         void setDefaultFloatDataType(nd4j::DataType dtype);
 
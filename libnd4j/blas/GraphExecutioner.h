@@ -28,6 +28,7 @@
 #include <graph/VariableSpace.h>
 #include <graph/Node.h>
 #include <graph/Graph.h>
+#include <graph/ExecutionPlan.h>
 #include <graph/ResultWrapper.h>
 #include <sys/stat.h>
 #include <graph/ExecutionResult.h>
@@ -71,7 +72,10 @@ namespace nd4j {
 
         static Graph *importFromFlatBuffers(const char *filename);
 
-        static Graph *importFromFlatPointer(Nd4jPointer ptr);
+        /**
+        * This method restores Graph from FlatBuffers pointer. If ExecutionPlan is given, graph is mapped according to it
+        */
+        static Graph *importFromFlatPointer(Nd4jPointer ptr, ExecutionPlan *plan = nullptr);
     };
 
     long getFileSize(const char * filename);
@@ -94,6 +94,69 @@ public:
      */
     void setTADThreshold(int num);
 
+    /**
+     * This method selects accuracy tier of transcendental transforms: 0 - libm, 1 - vectorised, 2 - fast
+     * @param precision
+     */
+    void setMathPrecision(int precision);
+
+    /**
+     * This method micro-benchmarks loop kernels and derives per loop family and data type parallelisation thresholds,
+     * see ThresholdsTuner. Takes about a second.
+     * @param profilePath file to save thresholds into, may be nullptr
+     */
+    void calibrateThresholds(const char *profilePath);
+
+    /**
+     * This method loads thresholds saved by calibrateThresholds earlier
+     * @param profilePath
+     * @return false if file can't be read or has no valid entries
+     */
+    bool loadThresholds(const char *profilePath);
+
+    /**
+     * This method drops calibrated thresholds, so element-wise and TAD thresholds are used everywhere again
+     */
+    void resetThresholds();
+
+    /**
+     * This method starts capturing graph execution timeline into file, in Chrome trace-event JSON format
+     * (loadable in chrome://tracing or Perfetto UI)
+     * @param tracePath
+     * @param sampleEvery only every N-th graph execution is captured
+     * @return false if capture is already active or file can't be opened
+     */
+    bool startTraceCapture(const char *tracePath, int sampleEvery);
+
+    /**
+     * This method stops timeline capture and finalizes trace file
+     * @return false if capture wasn't active
+     */
+    bool stopTraceCapture();
+
+    /**
+     * This method enables or disables per-op counters: wall time and, on Linux, hardware counters (cycles,
+     * instructions, LLC misses, branch misses), aggregated per op name and shape class
+     * @param reallyEnable
+     */
+    void enableOpCounters(bool reallyEnable);
+
+    /**
+     * This method returns true if hardware counters are available, meaningful after enableOpCounters(true)
+     */
+    bool hardwareCountersAvailable();
+
+    /**
+     * This method returns per-op counters as CSV text, with achieved GFLOP/s and GB/s derived from op cost model
+     * @return pointer valid until next call
+     */
+    const char* getOpCountersReport();
+
+    /**
+     * This method drops everything collected by op counters so far
+     */
+    void resetOpCounters();
+
     /**
        *
        * @param opNum
@@ -606,6 +669,12 @@ public:
 
     void initializeFunctions(Nd4jPointer *functions);
 
+    /**
+     * This method provides LAPACKE functions for dense linear algebra helpers: {sgetrf, dgetrf, spotrf, dpotrf}.
+     * nullptr entries are allowed, built-in implementations are used for them.
+     */
+    void initializeLapackFunctions(Nd4jPointer *functions);
+
     /**
      * This method acquires memory chunk of requested size on host side
      *
@@ -1579,6 +1648,26 @@ public:
 
     void decodeThreshold(Nd4jPointer *extraPointers, void *dx, Nd4jLong N, void *dz, Nd4jLong *zShapeInfo);
 
+    /**
+     * This method encodes gradients with one of GradientCodec codecs, residual is left in dx
+     *
+     * @param codec codec id, see GradientCodec::Codec
+     * @param capacity size of dz buffer in bytes
+     * @param parameter codec specific parameter: threshold for THRESHOLD_VARINT, number or fraction of elements for TOP_K
+     * @return encoded length in bytes, or minus required length if dz is too small
+     */
+    Nd4jLong encodeGradients(Nd4jPointer *extraPointers, int codec, void *dx, Nd4jLong *xShapeInfo, Nd4jLong N, void *dz, Nd4jLong capacity, float parameter);
+
+    /**
+     * This method decodes message produced by encodeGradients, decoded values are added to dz
+     */
+    void decodeGradients(Nd4jPointer *extraPointers, void *dx, Nd4jLong N, void *dz, Nd4jLong *zShapeInfo);
+
+    /**
+     * This method returns size of buffer in bytes, sufficient for encodeGradients call
+     */
+    Nd4jLong estimateGradientsEncodingLength(int codec, Nd4jLong N, float parameter);
+
 
     void sort(Nd4jPointer *extraPointers,
             void *x, Nd4jLong *xShapeInfo,
@@ -1623,6 +1712,18 @@ public:
 
     int registerGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer flatBufferPointer);
 
+    /**
+     * This method registers graph, using serialized ExecutionPlan to skip toposort and graph passes.
+     * Plan captured from another graph is rejected with ND4J_STATUS_BAD_INPUT. If plan can't be read or doesn't match current set of ops, graph is built as usual
+     */
+    int registerGraphWithPlan(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer flatBufferPointer, Nd4jPointer planPointer, Nd4jLong planLength);
+
+    /**
+     * This method returns serialized ExecutionPlan of registered graph, output shapes are taken from shape inference pass.
+     * Returns nullptr if graph isn't registered or plan can't be built
+     */
+    nd4j::graph::ResultWrapper* exportExecutionPlan(Nd4jPointer *extraPointers, Nd4jLong graphId);
+
     nd4j::graph::VariablesSet *executeStoredGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs);
 
     int unregisterGraph(Nd4jPointer *extraPointers, Nd4jLong graphId);
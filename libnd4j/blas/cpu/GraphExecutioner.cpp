@@ -44,12 +44,17 @@
 #include <chrono>
 #include <ctime>
 #include <graph/execution/LogicExecutor.h>
+#include <graph/execution/FrameExecutor.h>
+#include <graph/profiling/TraceExporter.h>
 #include <array/DataTypeUtils.h>
 #include <helpers/BitwiseUtils.h>
 #include <generated/array_generated.h>
 #include <helpers/ShapeUtils.h>
+#include <helpers/EnumUtils.h>
+#include <helpers/StringUtils.h>
 #include <Status.h>
 #include <deque>
+#include <unordered_set>
 #include <graph/ResultWrapper.h>
 #include <graph/ExecutionResult.h>
 #include <graph/exceptions/graph_execution_exception.h>
@@ -214,9 +219,19 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     }
     auto flowPath = __variableSpace->flowPath();
 
+    // only sampled executions are traced, while capture is off this is single atomic check
+    auto tracer = TraceExporter::getInstance();
+    const bool traced = tracer->sampleExecution();
+    const Nd4jLong traceStart = traced ? TraceExporter::currentTime() : 0L;
+
     Nd4jLong tb0 = Environment::getInstance()->isProfiling() ? GraphProfile::currentTime() : 0L;
     graph->buildGraph();
 
+    if (Environment::getInstance()->isInferShapes())
+        graph->inferShapes(__variableSpace);
+
+    const Nd4jLong traceGraphHash = traced ? graph->hashCode() : 0L;
+
     auto footprintForward = nd4j::memory::MemoryRegistrator::getInstance()->getGraphMemoryFootprint(graph->hashCode());
     if (footprintForward > 0) {
         if (__variableSpace->workspace() != nullptr) {
@@ -244,6 +259,9 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     auto nodeTime = GraphProfile::currentTime();
     int lastId = -10000000;
     Nd4jLong exec_counter = 0;
+
+    // nodes of loop frames executed by FrameExecutor, they're skipped during layers traversal
+    std::unordered_set<int> compiledNodes;
     // we loop through op layers here
     for (int l = 0; l < (int) graph->getOnion()->size(); l++) {
         int layerSize = graph->getOnion()->count(l) == 1 ? graph->getOnion()->at(l)->size() : 0;
@@ -251,13 +269,13 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
         int n = 0;
 // this omp block will probably never be the case
         for (; n < layerSize; n++) {
-            if (++exec_counter > 10000) {
-                l = graph->getOnion()->size();
-                return Status::THROW("Early termination hit");
-            }
-
             Node* node = graph->getOnion()->at(l)->at(n);
 
+            if (!compiledNodes.empty() && compiledNodes.count(node->id()) > 0)
+                continue;
+
+            exec_counter++;
+
             if (Environment::getInstance()->isProfiling())
                 flowPath->profile()->nodeById(node->id(), node->name()->c_str());
 
@@ -350,9 +368,26 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
                 // we expect this node to have frameId set
                 auto frame_id = node->getFrameId();
 
+                // top-level loops are iterated natively by FrameExecutor, without rewinding layers
+                if (frames.empty() && Environment::getInstance()->isCompileLoops()) {
+                    auto frame = graph->frameExecutor(frame_id);
+                    if (frame != nullptr && frame->isApplicable(graph, __variableSpace)) {
+                        auto status = frame->execute(graph, __variableSpace);
+                        if (status != Status::OK())
+                            return status;
+
+                        for (auto v: *frame->nodes())
+                            compiledNodes.insert(v->id());
+
+                        continue;
+                    }
+                }
+
                 // new frame starts here
                 if (frames.size() == 0 || (frames.size() > 0 && frames.back() != frame_id)) {
                     flowPath->registerFrame(frame_id);
+                    // frame may be entered again, i.e. by outer loop or next execution, so iterations limit applies per entry
+                    flowPath->resetNumberOfCycles(frame_id);
                     frames.emplace_back(frame_id);
                     inFrame = true;
                 }
@@ -381,6 +416,13 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
                 if (!flowPath->isRewindPlanned(frame_id)) {
                     auto nextLayer = node->getRewindLayer();
 
+                    auto limit = Environment::getInstance()->maxLoopIterations();
+                    flowPath->incrementNumberOfCycles(frame_id);
+                    if (limit > 0 && flowPath->getNumberOfCycles(frame_id) > limit) {
+                        nd4j_printf("Frame %lld exceeded limit of %lld iterations\n", frame_id, limit);
+                        return Status::THROW("Loop iterations limit exceeded");
+                    }
+
                     nd4j_debug("Node_%i planned rewind to Node_%i at [%i:%i]\n", node->id(), node->getRewindNode(), nextLayer.first, nextLayer.second);
 
                     flowPath->planRewind(frame_id, true);
@@ -435,6 +477,10 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
                 auto timeStart = std::chrono::system_clock::now();
 
+                auto workspace = __variableSpace->workspace();
+                const Nd4jLong spanStart = traced ? TraceExporter::currentTime() : 0L;
+                const Nd4jLong memoryBefore = traced && workspace != nullptr ? workspace->getSpilledSize() + workspace->getUsedSize() : 0L;
+
                 // actual node execution happens right here
                 Nd4jStatus status = executeFlatNode(graph, node, __variableSpace);
 
@@ -445,6 +491,33 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
                 flowPath->setOuterTime(node->id(), outerTime);
 
+                if (traced) {
+                    TraceSpan span;
+                    span.name = node->getCustomOp() != nullptr ? *node->getCustomOp()->getOpName() : std::string(EnumUtils::_OpTypeToString(node->opType())) + "_" + StringUtils::valueToString<Nd4jLong>(node->opNum());
+                    span.category = "node";
+                    span.nodeId = node->id();
+                    span.nodeName = node->name() != nullptr ? *node->name() : std::string();
+                    span.graphHash = traceGraphHash;
+                    span.start = spanStart;
+                    span.duration = TraceExporter::currentTime() - spanStart;
+
+                    if (workspace != nullptr) {
+                        span.memoryUsed = workspace->getSpilledSize() + workspace->getUsedSize();
+                        span.memoryDelta = span.memoryUsed - memoryBefore;
+                    }
+
+                    if (Environment::getInstance()->isProfiling()) {
+                        auto nodeProfile = flowPath->profile()->nodeById(node->id());
+                        span.preparationTime = nodeProfile->getPreparationTime();
+                        span.executionTime = nodeProfile->getExecutionTime();
+                        span.inputTime = nodeProfile->getInputTime();
+                        span.shapeTime = nodeProfile->getShapeFunctionTime();
+                        span.arrayTime = nodeProfile->getArrayTime();
+                    }
+
+                    tracer->record(span);
+                }
+
                 if (status != ND4J_STATUS_OK)
                     return status;
 
@@ -483,9 +556,33 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     if (Environment::getInstance()->isProfiling()) {
         flowPath->profile()->nodeById(lastId)->setTotalTime(GraphProfile::relativeTime(nodeTime));
         flowPath->profile()->setExecutionTime(GraphProfile::relativeTime(timeStart));
+
+        // permute/transpose nodes removed from graph would have copied their inputs
+        Nd4jLong copies = 0L;
+        Nd4jLong bytes = 0L;
+        for (auto &p: *graph->eliminatedPermutes()) {
+            if (!__variableSpace->hasVariable(p) || !__variableSpace->getVariable(p)->hasNDArray())
+                continue;
+
+            auto array = __variableSpace->getVariable(p)->getNDArray();
+            copies++;
+            bytes += array->lengthOf() * array->sizeOfT();
+        }
+        flowPath->profile()->addToEliminatedCopies(copies, bytes);
         //flowPath->profile().printOut();
     }
 
+    if (traced) {
+        TraceSpan span;
+        span.name = "graph";
+        span.category = "graph";
+        span.graphHash = traceGraphHash;
+        span.start = traceStart;
+        span.duration = TraceExporter::currentTime() - traceStart;
+
+        tracer->record(span);
+    }
+
     // saving memory footprint for current run
     if (__variableSpace->workspace() != nullptr) {
         auto m = __variableSpace->workspace()->getAllocatedSize();
@@ -899,9 +996,9 @@ flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuff
             return restoredGraph;
         }
 
-        Graph *GraphExecutioner::importFromFlatPointer(Nd4jPointer ptr) {
+        Graph *GraphExecutioner::importFromFlatPointer(Nd4jPointer ptr, ExecutionPlan *plan) {
             auto fg = GetFlatGraph(reinterpret_cast<uint8_t *>(ptr));
-            auto restoredGraph = new Graph(fg);
+            auto restoredGraph = new Graph(fg, nullptr, plan);
 
             return restoredGraph;
         }
@@ -48,6 +48,7 @@
 #include <graph/exceptions/datatype_exception.h>
 #include <loops/BroadcastScalarConverter.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/OpCounters.h>
 
 
 
@@ -62,6 +63,8 @@
 * @param zShapeInfo
 */
 void NativeOpExcutioner::execIndexReduceScalar(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParams, void *vz, Nd4jLong *zShapeInfo) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_INDEX_REDUCE, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto z = reinterpret_cast<Nd4jLong*>(vz);
 
@@ -91,6 +94,8 @@ void NativeOpExcutioner::execIndexReduce(int opNum,
         int dimensionLength,
         Nd4jLong *tadShapeInfo,
         Nd4jLong *xTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_INDEX_REDUCE, opNum, xShapeInfo, nullptr, resultShapeInfoBuffer);
+
 
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
 
@@ -112,6 +117,8 @@ void NativeOpExcutioner::execIndexReduce(int opNum,
  */
 
 void NativeOpExcutioner::execBroadcast(int opNum, void *x, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, void *result, Nd4jLong *zShapeInfo, int *dimension, int dimensionLength, Nd4jLong *xTadShapeInfo, Nd4jLong *xTadOffsets, Nd4jLong *zTadShapeInfo, Nd4jLong *zTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_BROADCAST, opNum, xShapeInfo, yShapeInfo, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto yType = nd4j::ArrayOptions::dataType(yShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
@@ -174,6 +181,8 @@ void NativeOpExcutioner::execBroadcast(int opNum, void *x, Nd4jLong *xShapeInfo,
 
 
 void NativeOpExcutioner::execInverseBroadcast(int opNum, void *x, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, void *result, Nd4jLong *zShapeInfo, int *dimension, int dimensionLength, Nd4jLong *xTadShapeInfo, Nd4jLong *xTadOffsets, Nd4jLong *zTadShapeInfo, Nd4jLong *zTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_BROADCAST, opNum, xShapeInfo, yShapeInfo, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto yType = nd4j::ArrayOptions::dataType(yShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
@@ -191,6 +200,8 @@ void NativeOpExcutioner::execInverseBroadcast(int opNum, void *x, Nd4jLong *xSha
 }
 
 void NativeOpExcutioner::execBroadcastBool(int opNum, void *x, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, void *result, Nd4jLong *zShapeInfo, int *dimension, int dimensionLength, Nd4jLong *xTadShapeInfo, Nd4jLong *xTadOffsets, Nd4jLong *zTadShapeInfo, Nd4jLong *zTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_BROADCAST_BOOL, opNum, xShapeInfo, yShapeInfo, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto yType = nd4j::ArrayOptions::dataType(yShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
@@ -203,6 +214,8 @@ void NativeOpExcutioner::execBroadcastBool(int opNum, void *x, Nd4jLong *xShapeI
 }
 
 void NativeOpExcutioner::execInverseBroadcastBool(int opNum, void *x, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, void *result, Nd4jLong *zShapeInfo, int *dimension, int dimensionLength, Nd4jLong *xTadShapeInfo, Nd4jLong *xTadOffsets, Nd4jLong *zTadShapeInfo, Nd4jLong *zTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_BROADCAST_BOOL, opNum, xShapeInfo, yShapeInfo, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto yType = nd4j::ArrayOptions::dataType(yShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
@@ -229,6 +242,8 @@ void NativeOpExcutioner::execInverseBroadcastBool(int opNum, void *x, Nd4jLong *
 * @param n
 */
 void NativeOpExcutioner::execPairwiseTransform(int opNum, void *dx, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, void *result, Nd4jLong *zShapeInfo, void *extraParams) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_PAIRWISE, opNum, xShapeInfo, yShapeInfo, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto yType = nd4j::ArrayOptions::dataType(yShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
@@ -252,6 +267,8 @@ void NativeOpExcutioner::execPairwiseTransform(int opNum, void *dx, Nd4jLong *xS
 }
 
 void NativeOpExcutioner::execPairwiseBoolTransform(int opNum, void *dx, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, void *result, Nd4jLong *zShapeInfo, void *extraParams) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_PAIRWISE_BOOL, opNum, xShapeInfo, yShapeInfo, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto yType = nd4j::ArrayOptions::dataType(yShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
@@ -281,6 +298,8 @@ void NativeOpExcutioner::execPairwiseBoolTransform(int opNum, void *dx, Nd4jLong
 * @param zShapeInfo
 */
 void NativeOpExcutioner::execReduceFloat(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParams, void *result, Nd4jLong *zShapeInfo, int *dimension, int dimensionLength, Nd4jLong *tadShapeInfo, Nd4jLong *xTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_REDUCE_FLOAT, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -288,6 +307,8 @@ void NativeOpExcutioner::execReduceFloat(int opNum, void *x, Nd4jLong *xShapeInf
 }
 
 void NativeOpExcutioner::execReduceSame(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParams, void *result, Nd4jLong *zShapeInfo, int *dimension, int dimensionLength, Nd4jLong *tadShapeInfo, Nd4jLong *xTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_REDUCE_SAME, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -295,6 +316,8 @@ void NativeOpExcutioner::execReduceSame(int opNum, void *x, Nd4jLong *xShapeInfo
 }
 
 void NativeOpExcutioner::execReduceBool(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParams, void *result, Nd4jLong *zShapeInfo, int *dimension, int dimensionLength, Nd4jLong *tadShapeInfo, Nd4jLong *xTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_REDUCE_BOOL, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -302,6 +325,8 @@ void NativeOpExcutioner::execReduceBool(int opNum, void *x, Nd4jLong *xShapeInfo
 }
 
 void NativeOpExcutioner::execReduceLong(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParams, void *result, Nd4jLong *zShapeInfo, int *dimension, int dimensionLength, Nd4jLong *tadShapeInfo, Nd4jLong *xTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_REDUCE_LONG, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -318,6 +343,8 @@ void NativeOpExcutioner::execReduceLong(int opNum, void *x, Nd4jLong *xShapeInfo
  * @return
  */
 void NativeOpExcutioner::execReduceFloatScalar(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParams, void *z, Nd4jLong *zShapeInfo) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_REDUCE_FLOAT, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -325,12 +352,16 @@ void NativeOpExcutioner::execReduceFloatScalar(int opNum, void *x, Nd4jLong *xSh
 }
 
 void NativeOpExcutioner::execReduceSameScalar(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParams, void *z, Nd4jLong *zShapeInfo) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_REDUCE_SAME, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
 
     BUILD_SINGLE_SELECTOR(xType, functions::reduce::ReduceSameFunction, ::execScalar(opNum, x, xShapeInfo, extraParams, z, zShapeInfo), LIBND4J_TYPES);
 }
 
 void NativeOpExcutioner::execReduceBoolScalar(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParams, void *z, Nd4jLong *zShapeInfo) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_REDUCE_BOOL, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -338,6 +369,8 @@ void NativeOpExcutioner::execReduceBoolScalar(int opNum, void *x, Nd4jLong *xSha
 }
 
 void NativeOpExcutioner::execReduceLongScalar(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParams, void *z, Nd4jLong *zShapeInfo) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_REDUCE_LONG, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -360,6 +393,8 @@ void NativeOpExcutioner::execReduceLongScalar(int opNum, void *x, Nd4jLong *xSha
  * @param dimensionLength
  */
 void NativeOpExcutioner::execReduce3Scalar(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParamsVals, void *y, Nd4jLong *yShapeInfo, void *z, Nd4jLong *zShapeInfo) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_REDUCE_3, opNum, xShapeInfo, yShapeInfo, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -380,6 +415,8 @@ void NativeOpExcutioner::execReduce3Scalar(int opNum, void *x, Nd4jLong *xShapeI
 * @param zShapeInfo
 */
 void NativeOpExcutioner::execReduce3(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParamsVals, void *y, Nd4jLong *yShapeInfo, void *result, Nd4jLong *zShapeInfo) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_REDUCE_3, opNum, xShapeInfo, yShapeInfo, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -389,6 +426,8 @@ void NativeOpExcutioner::execReduce3(int opNum, void *x, Nd4jLong *xShapeInfo, v
 
 ////////////////////////////////////////////////////////////////////////
 void NativeOpExcutioner::execReduce3All(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParamsVals, void *y, Nd4jLong *yShapeInfo, void *result, Nd4jLong *resultShapeInfoBuffer, int *dimension, int dimensionLength, Nd4jLong *xTadShapeInfo, Nd4jLong *xOffsets, Nd4jLong *yTadShapeInfo, Nd4jLong *yOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_REDUCE_3, opNum, xShapeInfo, yShapeInfo, resultShapeInfoBuffer);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(resultShapeInfoBuffer);
 
@@ -397,6 +436,8 @@ void NativeOpExcutioner::execReduce3All(int opNum, void *x, Nd4jLong *xShapeInfo
 
 ////////////////////////////////////////////////////////////////////////
 void NativeOpExcutioner::execReduce3TAD(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParamsVals, void *y, Nd4jLong *yShapeInfo, void *result, Nd4jLong *resultShapeInfoBuffer, int *dimension, int dimensionLength, Nd4jLong *tadShapeInfo, Nd4jLong *xTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_REDUCE_3, opNum, xShapeInfo, yShapeInfo, resultShapeInfoBuffer);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(resultShapeInfoBuffer);
 
@@ -417,6 +458,8 @@ void NativeOpExcutioner::execReduce3TAD(int opNum, void *x, Nd4jLong *xShapeInfo
 * @param n
 */
 void NativeOpExcutioner::execScalar(int opNum, void *x, Nd4jLong *xShapeInfo, void *result, Nd4jLong *zShapeInfo, void *scalar, Nd4jLong *scalarShapeInfo, void *extraParams) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_SCALAR, opNum, xShapeInfo, scalarShapeInfo, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto yType = nd4j::ArrayOptions::dataType(scalarShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
@@ -438,6 +481,8 @@ void NativeOpExcutioner::execScalar(int opNum, void *x, Nd4jLong *xShapeInfo, vo
 
 ////////////////////////////////////////////////////////////////////////
 void NativeOpExcutioner::execScalar(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParams, void *z, Nd4jLong *zShapeInfo, void *scalars, Nd4jLong *scalarShapeInfo, int *dimension, int dimensionLength, Nd4jLong *tadShapeInfo, Nd4jLong *xTadOffsets, Nd4jLong *tadShapeInfoZ, Nd4jLong *zTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_SCALAR, opNum, xShapeInfo, scalarShapeInfo, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto yType = nd4j::ArrayOptions::dataType(scalarShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
@@ -454,6 +499,8 @@ void NativeOpExcutioner::execScalar(int opNum, void *x, Nd4jLong *xShapeInfo, vo
 }
 
 void NativeOpExcutioner::execScalarBool(int opNum, void *x, Nd4jLong *xShapeInfo, void *result, Nd4jLong *zShapeInfo, void *scalar, Nd4jLong *scalarShapeInfo, void *extraParams) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_SCALAR_BOOL, opNum, xShapeInfo, scalarShapeInfo, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -463,6 +510,8 @@ void NativeOpExcutioner::execScalarBool(int opNum, void *x, Nd4jLong *xShapeInfo
 
 ////////////////////////////////////////////////////////////////////////
 void NativeOpExcutioner::execScalarBool(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParams, void *z, Nd4jLong *zShapeInfo, void *scalars, Nd4jLong *scalarShapeInfo, int *dimension, int dimensionLength, Nd4jLong *tadShapeInfo, Nd4jLong *xTadOffsets, Nd4jLong *tadShapeInfoZ, Nd4jLong *zTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_SCALAR_BOOL, opNum, xShapeInfo, scalarShapeInfo, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto yType = nd4j::ArrayOptions::dataType(scalarShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
@@ -486,6 +535,8 @@ void NativeOpExcutioner::execScalarBool(int opNum, void *x, Nd4jLong *xShapeInfo
 * @param zShapeInfo
 */
 void NativeOpExcutioner::execSummaryStats(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParams, void *result, Nd4jLong *zShapeInfo, bool biasCorrected) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_SUMMARYSTATS, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -503,6 +554,8 @@ void NativeOpExcutioner::execSummaryStats(int opNum, void *x, Nd4jLong *xShapeIn
 * @param zShapeInfo
 */
 void NativeOpExcutioner::execSummaryStatsScalar(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParams, void *result, Nd4jLong *zShapeInfo, bool biasCorrected) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_SUMMARYSTATS, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -522,6 +575,8 @@ void NativeOpExcutioner::execSummaryStatsScalar(int opNum, void *x, Nd4jLong *xS
 * @param dimensionLength
 */
 void NativeOpExcutioner::execSummaryStats(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParams, void *result, Nd4jLong *resultShapeInfoBuffer, int *dimension, int dimensionLength, bool biasCorrected) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_SUMMARYSTATS, opNum, xShapeInfo, nullptr, resultShapeInfoBuffer);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(resultShapeInfoBuffer);
 
@@ -541,6 +596,8 @@ void NativeOpExcutioner::execSummaryStats(int opNum, void *x, Nd4jLong *xShapeIn
 * @param n
 */
 void NativeOpExcutioner::execTransformFloat(int opNum, void *dx, Nd4jLong *xShapeInfo, void *result, Nd4jLong *zShapeInfo, void *extraParams, Nd4jLong *tadShapeInfo, Nd4jLong *xTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_TRANSFORM_FLOAT, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -548,6 +605,8 @@ void NativeOpExcutioner::execTransformFloat(int opNum, void *dx, Nd4jLong *xShap
 }
 
 void NativeOpExcutioner::execTransformBool(int opNum, void *dx, Nd4jLong *xShapeInfo, void *result, Nd4jLong *zShapeInfo, void *extraParams, Nd4jLong *tadShapeInfo, Nd4jLong *xTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_TRANSFORM_BOOL, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -555,6 +614,8 @@ void NativeOpExcutioner::execTransformBool(int opNum, void *dx, Nd4jLong *xShape
 }
 
 void NativeOpExcutioner::execTransformAny(int opNum, void *dx, Nd4jLong *xShapeInfo, void *result, Nd4jLong *zShapeInfo, void *extraParams, Nd4jLong *tadShapeInfo, Nd4jLong *xTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_TRANSFORM_ANY, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -566,6 +627,8 @@ void NativeOpExcutioner::execTransformAny(int opNum, void *dx, Nd4jLong *xShapeI
 }
 
 void NativeOpExcutioner::execTransformSame(int opNum, void *dx, Nd4jLong *xShapeInfo, void *result, Nd4jLong *zShapeInfo, void *extraParams, Nd4jLong *tadShapeInfo, Nd4jLong *xTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_TRANSFORM_SAME, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -573,6 +636,8 @@ void NativeOpExcutioner::execTransformSame(int opNum, void *dx, Nd4jLong *xShape
 }
 
 void NativeOpExcutioner::execTransformStrict(int opNum, void *dx, Nd4jLong *xShapeInfo, void *result, Nd4jLong *zShapeInfo, void *extraParams, Nd4jLong *tadShapeInfo, Nd4jLong *xTadOffsets) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_TRANSFORM_STRICT, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
@@ -581,6 +646,8 @@ void NativeOpExcutioner::execTransformStrict(int opNum, void *dx, Nd4jLong *xSha
 
 ////////////////////////////////////////////////////////////////////////
 void NativeOpExcutioner::execRandom(int opNum, Nd4jPointer state, void *z, Nd4jLong *zShapeInfo, void *extraArguments) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_RANDOM, opNum, nullptr, nullptr, zShapeInfo);
+
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
     BUILD_SINGLE_SELECTOR(zType, functions::random::RandomFunction, ::execTransform(opNum, state, z, zShapeInfo, extraArguments), FLOAT_TYPES);
@@ -588,6 +655,8 @@ void NativeOpExcutioner::execRandom(int opNum, Nd4jPointer state, void *z, Nd4jL
 
 ////////////////////////////////////////////////////////////////////////
 void NativeOpExcutioner::execRandom(int opNum, Nd4jPointer state, void *x, Nd4jLong *xShapeInfo, void *z, Nd4jLong *zShapeInfo, void *extraArguments) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_RANDOM, opNum, xShapeInfo, nullptr, zShapeInfo);
+
     auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
 
     BUILD_SINGLE_SELECTOR(zType, functions::random::RandomFunction, ::execTransform(opNum, state, x, xShapeInfo, z, zShapeInfo, extraArguments), FLOAT_TYPES);
@@ -595,12 +664,16 @@ void NativeOpExcutioner::execRandom(int opNum, Nd4jPointer state, void *x, Nd4jL
 
 ////////////////////////////////////////////////////////////////////////
 void NativeOpExcutioner::execRandom(int opNum, Nd4jPointer state, void *x, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeBuffer, void *z, Nd4jLong *zShapeBuffer, void *extraArguments) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_RANDOM, opNum, xShapeInfo, yShapeBuffer, zShapeBuffer);
+
     auto xType = nd4j::ArrayOptions::dataType(zShapeBuffer);
 
     BUILD_SINGLE_SELECTOR(xType, functions::random::RandomFunction, ::execTransform(opNum, state, x, xShapeInfo, y, yShapeBuffer, z, zShapeBuffer, extraArguments), FLOAT_TYPES);
 }
 
 void NativeOpExcutioner::execReduce3(int opNum, void *x, Nd4jLong *xShapeInfo, void *extraParamsVals, void *y, Nd4jLong *yShapeInfo, void *result, Nd4jLong *resultShapeInfoBuffer, int *dimension, int dimensionLength) {
+    nd4j::OpCountersScope counters(nd4j::graph::OpType_REDUCE_3, opNum, xShapeInfo, yShapeInfo, resultShapeInfoBuffer);
+
     auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
     auto zType = nd4j::ArrayOptions::dataType(resultShapeInfoBuffer);
 
@@ -71,6 +71,10 @@ bool experimentalSupport = false;
 #include <graph/ResultWrapper.h>
 #include <helpers/DebugHelper.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/ThresholdsTuner.h>
+#include <graph/profiling/TraceExporter.h>
+#include <helpers/OpCounters.h>
+#include <loops/gradient_codecs.h>
 
 using namespace nd4j;
 
@@ -84,6 +88,50 @@ void NativeOps::setTADThreshold(int num) {
         nd4j::Environment::getInstance()->setTadThreshold(num);
 }
 
+void NativeOps::setMathPrecision(int precision) {
+    nd4j::Environment::getInstance()->setMathPrecision(static_cast<nd4j::MathPrecision>(precision));
+}
+
+void NativeOps::calibrateThresholds(const char *profilePath) {
+    auto tuner = nd4j::ThresholdsTuner::getInstance();
+    tuner->calibrate();
+
+    if (profilePath != nullptr && !tuner->save(profilePath))
+        nd4j_printf("Can't save thresholds profile to %s\n", profilePath);
+}
+
+bool NativeOps::loadThresholds(const char *profilePath) {
+    return nd4j::ThresholdsTuner::getInstance()->load(profilePath);
+}
+
+void NativeOps::resetThresholds() {
+    nd4j::ThresholdsTuner::getInstance()->reset();
+}
+
+bool NativeOps::startTraceCapture(const char *tracePath, int sampleEvery) {
+    return nd4j::graph::TraceExporter::getInstance()->start(tracePath, sampleEvery);
+}
+
+bool NativeOps::stopTraceCapture() {
+    return nd4j::graph::TraceExporter::getInstance()->stop();
+}
+
+void NativeOps::enableOpCounters(bool reallyEnable) {
+    nd4j::OpCounters::getInstance()->setEnabled(reallyEnable);
+}
+
+bool NativeOps::hardwareCountersAvailable() {
+    return nd4j::PerfCounters::getInstance()->isAvailable();
+}
+
+const char* NativeOps::getOpCountersReport() {
+    return nd4j::OpCounters::getInstance()->report();
+}
+
+void NativeOps::resetOpCounters() {
+    nd4j::OpCounters::getInstance()->reset();
+}
+
 /**
  *
  * @param opNum
@@ -1049,13 +1097,21 @@ void NativeOps::flatten(
  * Since we'll use this from java, jni compiler would like to have method no matter what.
  */
 void NativeOps::initializeDevicesAndFunctions() {
-
+    // ND4J_THRESHOLDS_PROFILE is loaded by ThresholdsTuner itself, calibration is only run if there's no such profile yet
+    auto tuner = nd4j::ThresholdsTuner::getInstance();
+    const char* autotune = std::getenv("ND4J_THRESHOLDS_AUTOTUNE");
+    if (autotune != nullptr && std::string(autotune) == "true" && !tuner->isCalibrated())
+        calibrateThresholds(std::getenv("ND4J_THRESHOLDS_PROFILE"));
 }
 
 void NativeOps::initializeFunctions(Nd4jPointer *functions) {
     nd4j::BlasHelper::getInstance()->initializeFunctions(functions);
 }
 
+void NativeOps::initializeLapackFunctions(Nd4jPointer *functions) {
+    nd4j::BlasHelper::getInstance()->initializeLapackFunctions(functions);
+}
+
 /**
        * This method acquires memory chunk of requested size on host side
        *
@@ -1407,6 +1463,22 @@ void NativeOps::decodeThreshold(Nd4jPointer *extraPointers, void *hX, Nd4jLong N
     // TODO: to be implemented
 }
 
+Nd4jLong NativeOps::encodeGradients(Nd4jPointer *extraPointers, int codec, void *hX, Nd4jLong *hXShapeInfo, Nd4jLong N, void *dz, Nd4jLong capacity, float parameter) {
+    return nd4j::GradientCodecs::getInstance()->encode(codec, nd4j::ArrayOptions::dataType(hXShapeInfo), hX, N, dz, capacity, parameter);
+}
+
+void NativeOps::decodeGradients(Nd4jPointer *extraPointers, void *hX, Nd4jLong N, void *dz, Nd4jLong *hZShapeInfo) {
+    nd4j::GradientCodecs::getInstance()->decode(hX, nd4j::ArrayOptions::dataType(hZShapeInfo), dz, N);
+}
+
+Nd4jLong NativeOps::estimateGradientsEncodingLength(int codec, Nd4jLong N, float parameter) {
+    auto c = nd4j::GradientCodecs::getInstance()->codec(codec);
+    if (c == nullptr)
+        throw std::runtime_error("Unknown gradients codec");
+
+    return c->maxEncodedLength(N, parameter);
+}
+
 bool NativeOps::isP2PAvailable() {
     // always TRUE for cpu backend
     return true;
@@ -2121,6 +2193,60 @@ int NativeOps::registerGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jP
     return ND4J_STATUS_OK;
 }
 
+int NativeOps::registerGraphWithPlan(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer flatBufferPointer, Nd4jPointer planPointer, Nd4jLong planLength) {
+    nd4j::graph::ExecutionPlan *plan = nullptr;
+    try {
+        plan = nd4j::graph::ExecutionPlan::fromBuffer(planPointer, planLength);
+    } catch (std::runtime_error &e) {
+        nd4j_printf("Execution plan can't be loaded: %s\n", e.what());
+    }
+
+    // plan captured from another graph is rejected, instead of being silently ignored
+    if (plan != nullptr && plan->graphFingerprint() != nd4j::graph::Graph::hashFlatGraph(nd4j::graph::GetFlatGraph(flatBufferPointer))) {
+        nd4j_printf("Execution plan doesn't match graph [%lld]\n", (long long) graphId);
+        delete plan;
+        return ND4J_STATUS_BAD_INPUT;
+    }
+
+    auto graph = nd4j::graph::GraphExecutioner::importFromFlatPointer(flatBufferPointer, plan);
+    delete plan;
+
+    nd4j::graph::GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    return ND4J_STATUS_OK;
+}
+
+nd4j::graph::ResultWrapper* NativeOps::exportExecutionPlan(Nd4jPointer *extraPointers, Nd4jLong graphId) {
+    if (!nd4j::graph::GraphHolder::getInstance()->hasGraph(graphId)) {
+        nd4j_printf("GraphHolder doesn't have graph stored for [%lld]\n", (long long) graphId);
+        return nullptr;
+    }
+
+    std::vector<int8_t> buffer;
+    nd4j::graph::Graph *clone = nullptr;
+    try {
+        // stored graph is never executed itself, executeStoredGraph works on clones, so output shapes come from shape pass over a clone
+        auto graph = nd4j::graph::GraphHolder::getInstance()->pullGraph(graphId);
+        clone = graph->cloneWithProxy();
+        clone->inferShapes();
+
+        auto plan = nd4j::graph::ExecutionPlan::fromGraph(graph, clone->getVariableSpace());
+        buffer = plan->asBuffer();
+        delete plan;
+    } catch (std::runtime_error &e) {
+        nd4j_printf("Execution plan can't be exported: %s\n", e.what());
+        delete clone;
+        return nullptr;
+    }
+
+    delete clone;
+
+    auto ptr = new char[buffer.size()];
+    std::memcpy(ptr, buffer.data(), buffer.size());
+
+    return new nd4j::graph::ResultWrapper(buffer.size(), reinterpret_cast<Nd4jPointer>(ptr));
+}
+
 static VariablesSet* executeStoredGraphT(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs) {
     auto graph = nd4j::graph::GraphHolder::getInstance()->cloneGraph(graphId);
     auto varSpace = graph->getVariableSpace();
@@ -1372,6 +1372,10 @@ void NativeOps::initializeFunctions(Nd4jPointer *functions) {
 	*/
 }
 
+void NativeOps::initializeLapackFunctions(Nd4jPointer *functions) {
+    // host LAPACK isn't used by cuda backend
+}
+
 
 /**
  * This method acquires memory chunk of requested size on host side
@@ -2126,6 +2130,51 @@ void NativeOps::setTADThreshold(int num) {
     // this is no-op for CUDA
 }
 
+void NativeOps::setMathPrecision(int precision) {
+    // this is no-op for CUDA
+}
+
+void NativeOps::calibrateThresholds(const char *profilePath) {
+    // this is no-op for CUDA
+}
+
+bool NativeOps::loadThresholds(const char *profilePath) {
+    // this is no-op for CUDA
+    return false;
+}
+
+void NativeOps::resetThresholds() {
+    // this is no-op for CUDA
+}
+
+bool NativeOps::startTraceCapture(const char *tracePath, int sampleEvery) {
+    // this is no-op for CUDA
+    return false;
+}
+
+bool NativeOps::stopTraceCapture() {
+    // this is no-op for CUDA
+    return false;
+}
+
+void NativeOps::enableOpCounters(bool reallyEnable) {
+    // this is no-op for CUDA
+}
+
+bool NativeOps::hardwareCountersAvailable() {
+    // this is no-op for CUDA
+    return false;
+}
+
+const char* NativeOps::getOpCountersReport() {
+    // this is no-op for CUDA
+    return "";
+}
+
+void NativeOps::resetOpCounters() {
+    // this is no-op for CUDA
+}
+
 void NativeOps::execSummaryStats(Nd4jPointer *extraPointers,
                                  int opNum,
                                  void *hX, Nd4jLong *hXShapeInfo,
@@ -2821,6 +2870,20 @@ void NativeOps::decodeThreshold(Nd4jPointer *extraPointers, void *dx, Nd4jLong N
     nd4j::DebugHelper::checkErrorCode(stream, "decodeThresholdFloat(...) failed");
 }
 
+Nd4jLong NativeOps::encodeGradients(Nd4jPointer *extraPointers, int codec, void *dx, Nd4jLong *xShapeInfo, Nd4jLong N, void *dz, Nd4jLong capacity, float parameter) {
+    // this is no-op for CUDA
+    return 0;
+}
+
+void NativeOps::decodeGradients(Nd4jPointer *extraPointers, void *dx, Nd4jLong N, void *dz, Nd4jLong *zShapeInfo) {
+    // this is no-op for CUDA
+}
+
+Nd4jLong NativeOps::estimateGradientsEncodingLength(int codec, Nd4jLong N, float parameter) {
+    // this is no-op for CUDA
+    return 0;
+}
+
 
 void NativeOps::execReduce3All(Nd4jPointer *extraPointers,
 									int opNum,
@@ -3210,6 +3273,60 @@ int NativeOps::registerGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jP
 	return ND4J_STATUS_OK;
 }
 
+int NativeOps::registerGraphWithPlan(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer flatBufferPointer, Nd4jPointer planPointer, Nd4jLong planLength) {
+	nd4j::graph::ExecutionPlan *plan = nullptr;
+	try {
+		plan = nd4j::graph::ExecutionPlan::fromBuffer(planPointer, planLength);
+	} catch (std::runtime_error &e) {
+		nd4j_printf("Execution plan can't be loaded: %s\n", e.what());
+	}
+
+	// plan captured from another graph is rejected, instead of being silently ignored
+	if (plan != nullptr && plan->graphFingerprint() != nd4j::graph::Graph::hashFlatGraph(nd4j::graph::GetFlatGraph(flatBufferPointer))) {
+		nd4j_printf("Execution plan doesn't match graph [%lld]\n", (long long) graphId);
+		delete plan;
+		return ND4J_STATUS_BAD_INPUT;
+	}
+
+	auto graph = nd4j::graph::GraphExecutioner::importFromFlatPointer(flatBufferPointer, plan);
+	delete plan;
+
+	nd4j::graph::GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+	return ND4J_STATUS_OK;
+}
+
+nd4j::graph::ResultWrapper* NativeOps::exportExecutionPlan(Nd4jPointer *extraPointers, Nd4jLong graphId) {
+	if (!nd4j::graph::GraphHolder::getInstance()->hasGraph(graphId)) {
+		nd4j_printf("GraphHolder doesn't have graph stored for [%lld]\n", (long long) graphId);
+		return nullptr;
+	}
+
+	std::vector<int8_t> buffer;
+	nd4j::graph::Graph *clone = nullptr;
+	try {
+		// stored graph is never executed itself, executeStoredGraph works on clones, so output shapes come from shape pass over a clone
+		auto graph = nd4j::graph::GraphHolder::getInstance()->pullGraph(graphId);
+		clone = graph->cloneWithProxy();
+		clone->inferShapes();
+
+		auto plan = nd4j::graph::ExecutionPlan::fromGraph(graph, clone->getVariableSpace());
+		buffer = plan->asBuffer();
+		delete plan;
+	} catch (std::runtime_error &e) {
+		nd4j_printf("Execution plan can't be exported: %s\n", e.what());
+		delete clone;
+		return nullptr;
+	}
+
+	delete clone;
+
+	auto ptr = new char[buffer.size()];
+	std::memcpy(ptr, buffer.data(), buffer.size());
+
+	return new nd4j::graph::ResultWrapper(buffer.size(), reinterpret_cast<Nd4jPointer>(ptr));
+}
+
 
 static VariablesSet* executeStoredGraphT(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs) {
 	auto graph = nd4j::graph::GraphHolder::getInstance()->pullGraph(graphId);
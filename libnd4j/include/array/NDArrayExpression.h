@@ -0,0 +1,335 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Opt-in lazy arithmetic for NDArray: operators applied to lazy(array) build an expression tree,
+// which is materialised in a single fused parallel pass by expr::assign() or expr::evaluate().
+//
+// Usage:
+//      using namespace nd4j::expr;
+//      expr::assign(*ct, sigmoid(lazy(zf) + forgetBias) * lazy(*ct_1) + sigmoid(lazy(zi)) * tanh(lazy(zc)));
+//
+// Leaves follow numpy broadcasting rules against assignment target. Leaves keep references to arrays,
+// so expression must be evaluated within the same statement as its operands, temporaries included.
+//
+
+#ifndef LIBND4J_NDARRAYEXPRESSION_H
+#define LIBND4J_NDARRAYEXPRESSION_H
+
+#include <NDArray.h>
+#include <Environment.h>
+#include <templatemath.h>
+#include <type_traits>
+#include <memory>
+#include <vector>
+
+namespace nd4j {
+namespace expr {
+
+    //////////////////////////////////////////////////////////////////////////
+    // leaf of expression tree: array broadcastable to assignment target
+    class Leaf {
+    private:
+        const NDArray* _array;
+        const int8_t* _buffer = nullptr;
+        Nd4jLong _strides[MAX_RANK];
+        Nd4jLong _lastStride = 0;
+        int _id = 0;
+        int _rank = 0;
+
+    public:
+        static constexpr int leaves = 1;
+
+        explicit Leaf(const NDArray& array) : _array(&array) { }
+
+        template <typename T>
+        void bind(const NDArray& target, int& id, std::vector<std::unique_ptr<NDArray>>& holders) {
+            const NDArray* source = _array;
+            if (source->dataType() != target.dataType()) {
+                holders.emplace_back(const_cast<NDArray*>(source)->cast(target.dataType()));
+                source = holders.back().get();
+            }
+
+            _id = id++;
+            _rank = target.rankOf();
+            _buffer = reinterpret_cast<const int8_t*>(source->getBuffer());
+
+            const int shift = _rank - source->rankOf();
+            if (shift < 0 && source->lengthOf() != 1)
+                throw std::runtime_error("expr: rank of operand is higher than rank of assignment target");
+
+            for (int d = 0; d < _rank; d++) {
+                const int sd = d - shift;
+                if (sd < 0 || source->lengthOf() == 1 || source->sizeAt(sd) == 1)
+                    _strides[d] = 0;
+                else if (source->sizeAt(sd) == target.sizeAt(d))
+                    _strides[d] = source->stridesOf()[sd];
+                else
+                    throw std::runtime_error("expr: operand shape can't be broadcast to assignment target");
+            }
+
+            _lastStride = _rank > 0 ? _strides[_rank - 1] : 0;
+        }
+
+        FORCEINLINE void moveTo(const Nd4jLong* coords, Nd4jLong* offsets) const {
+            Nd4jLong offset = 0;
+            for (int d = 0; d < _rank - 1; d++)
+                offset += coords[d] * _strides[d];
+
+            offsets[_id] = offset;
+        }
+
+        template <typename T>
+        FORCEINLINE T get(const Nd4jLong* offsets, const Nd4jLong c) const {
+            return reinterpret_cast<const T*>(_buffer)[offsets[_id] + c * _lastStride];
+        }
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    class Scalar {
+    private:
+        double _value;
+
+    public:
+        static constexpr int leaves = 0;
+
+        explicit Scalar(const double value) : _value(value) { }
+
+        template <typename T>
+        void bind(const NDArray& target, int& id, std::vector<std::unique_ptr<NDArray>>& holders) { }
+
+        FORCEINLINE void moveTo(const Nd4jLong* coords, Nd4jLong* offsets) const { }
+
+        template <typename T>
+        FORCEINLINE T get(const Nd4jLong* offsets, const Nd4jLong c) const {
+            return static_cast<T>(_value);
+        }
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename Op, typename E>
+    class Unary {
+    private:
+        E _e;
+
+    public:
+        static constexpr int leaves = E::leaves;
+
+        explicit Unary(const E& e) : _e(e) { }
+
+        template <typename T>
+        void bind(const NDArray& target, int& id, std::vector<std::unique_ptr<NDArray>>& holders) {
+            _e.template bind<T>(target, id, holders);
+        }
+
+        FORCEINLINE void moveTo(const Nd4jLong* coords, Nd4jLong* offsets) const {
+            _e.moveTo(coords, offsets);
+        }
+
+        template <typename T>
+        FORCEINLINE T get(const Nd4jLong* offsets, const Nd4jLong c) const {
+            return Op::template op<T>(_e.template get<T>(offsets, c));
+        }
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename Op, typename L, typename R>
+    class Binary {
+    private:
+        L _l;
+        R _r;
+
+    public:
+        static constexpr int leaves = L::leaves + R::leaves;
+
+        Binary(const L& l, const R& r) : _l(l), _r(r) { }
+
+        template <typename T>
+        void bind(const NDArray& target, int& id, std::vector<std::unique_ptr<NDArray>>& holders) {
+            _l.template bind<T>(target, id, holders);
+            _r.template bind<T>(target, id, holders);
+        }
+
+        FORCEINLINE void moveTo(const Nd4jLong* coords, Nd4jLong* offsets) const {
+            _l.moveTo(coords, offsets);
+            _r.moveTo(coords, offsets);
+        }
+
+        template <typename T>
+        FORCEINLINE T get(const Nd4jLong* offsets, const Nd4jLong c) const {
+            return Op::template op<T>(_l.template get<T>(offsets, c), _r.template get<T>(offsets, c));
+        }
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    // element-wise operations
+    struct Add      { template <typename T> static FORCEINLINE T op(T a, T b) { return a + b; } };
+    struct Subtract { template <typename T> static FORCEINLINE T op(T a, T b) { return a - b; } };
+    struct Multiply { template <typename T> static FORCEINLINE T op(T a, T b) { return a * b; } };
+    struct Divide   { template <typename T> static FORCEINLINE T op(T a, T b) { return a / b; } };
+
+    struct Negative { template <typename T> static FORCEINLINE T op(T a) { return -a; } };
+    struct Sigmoid  { template <typename T> static FORCEINLINE T op(T a) { return nd4j::math::nd4j_sigmoid<T, T>(a); } };
+    struct Tanh     { template <typename T> static FORCEINLINE T op(T a) { return nd4j::math::nd4j_tanh<T, T>(a); } };
+    struct Exp      { template <typename T> static FORCEINLINE T op(T a) { return nd4j::math::nd4j_exp<T, T>(a); } };
+    struct Log      { template <typename T> static FORCEINLINE T op(T a) { return nd4j::math::nd4j_log<T, T>(a); } };
+    struct Sqrt     { template <typename T> static FORCEINLINE T op(T a) { return nd4j::math::nd4j_sqrt<T, T>(a); } };
+    struct Abs      { template <typename T> static FORCEINLINE T op(T a) { return nd4j::math::nd4j_abs<T>(a); } };
+
+    //////////////////////////////////////////////////////////////////////////
+    // operand traits: NDArray operands become leaves, arithmetic ones become scalars
+    template <typename E> struct is_expression : std::false_type { };
+    template <> struct is_expression<Leaf> : std::true_type { };
+    template <> struct is_expression<Scalar> : std::true_type { };
+    template <typename Op, typename E> struct is_expression<Unary<Op, E>> : std::true_type { };
+    template <typename Op, typename L, typename R> struct is_expression<Binary<Op, L, R>> : std::true_type { };
+
+    template <typename E, typename Enable = void> struct operand { };
+    template <typename E> struct operand<E, typename std::enable_if<is_expression<E>::value>::type> {
+        typedef E type;
+        static FORCEINLINE const E& wrap(const E& e) { return e; }
+    };
+    template <> struct operand<NDArray> {
+        typedef Leaf type;
+        static FORCEINLINE Leaf wrap(const NDArray& array) { return Leaf(array); }
+    };
+    template <typename E> struct operand<E, typename std::enable_if<std::is_arithmetic<E>::value>::type> {
+        typedef Scalar type;
+        static FORCEINLINE Scalar wrap(const E value) { return Scalar(static_cast<double>(value)); }
+    };
+
+    // binary operators are only enabled when at least one side is already lazy, eager NDArray operators stay intact
+    template <typename L, typename R>
+    struct enable_binary : std::enable_if<(is_expression<L>::value && (is_expression<R>::value || std::is_same<R, NDArray>::value || std::is_arithmetic<R>::value)) ||
+                                          (is_expression<R>::value && std::is_arithmetic<L>::value)> { };
+
+#define LAZY_BINARY_OPERATOR(OPERATOR, OP) \
+    template <typename L, typename R, typename = typename enable_binary<L, R>::type> \
+    FORCEINLINE Binary<OP, typename operand<L>::type, typename operand<R>::type> operator OPERATOR(const L& l, const R& r) { \
+        return Binary<OP, typename operand<L>::type, typename operand<R>::type>(operand<L>::wrap(l), operand<R>::wrap(r)); \
+    }
+
+    LAZY_BINARY_OPERATOR(+, Add)
+    LAZY_BINARY_OPERATOR(-, Subtract)
+    LAZY_BINARY_OPERATOR(*, Multiply)
+    LAZY_BINARY_OPERATOR(/, Divide)
+
+#undef LAZY_BINARY_OPERATOR
+
+#define LAZY_UNARY_FUNCTION(NAME, OP) \
+    template <typename E, typename = typename std::enable_if<is_expression<E>::value>::type> \
+    FORCEINLINE Unary<OP, E> NAME(const E& e) { \
+        return Unary<OP, E>(e); \
+    }
+
+    LAZY_UNARY_FUNCTION(operator-, Negative)
+    LAZY_UNARY_FUNCTION(sigmoid, Sigmoid)
+    LAZY_UNARY_FUNCTION(tanh, Tanh)
+    LAZY_UNARY_FUNCTION(exp, Exp)
+    LAZY_UNARY_FUNCTION(log, Log)
+    LAZY_UNARY_FUNCTION(sqrt, Sqrt)
+    LAZY_UNARY_FUNCTION(abs, Abs)
+
+#undef LAZY_UNARY_FUNCTION
+
+    /**
+     * wraps array into expression leaf, entry point of lazy arithmetic
+     */
+    FORCEINLINE Leaf lazy(const NDArray& array) {
+        return Leaf(array);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename T, typename E>
+    static void assign_(NDArray& target, const E& expression) {
+        E expr(expression);
+        std::vector<std::unique_ptr<NDArray>> holders;
+        int id = 0;
+        expr.template bind<T>(target, id, holders);
+
+        const int rank = target.rankOf();
+        const Nd4jLong* shape = target.shapeOf();
+        const Nd4jLong* strides = target.stridesOf();
+        const Nd4jLong cols = rank > 0 ? shape[rank - 1] : 1;
+        const Nd4jLong rows = cols > 0 ? target.lengthOf() / cols : 0;
+        const Nd4jLong zStride = rank > 0 ? strides[rank - 1] : 0;
+        auto z = reinterpret_cast<T*>(target.buffer());
+
+        // one pass over target: rows in parallel, innermost dimension in tight loop
+        PRAGMA_OMP_PARALLEL_FOR_IF(target.lengthOf() > Environment::getInstance()->elementwiseThreshold())
+        for (Nd4jLong r = 0; r < rows; r++) {
+            Nd4jLong coords[MAX_RANK];
+            Nd4jLong offsets[E::leaves > 0 ? E::leaves : 1];
+
+            Nd4jLong rem = r;
+            Nd4jLong zOffset = 0;
+            for (int d = rank - 2; d >= 0; d--) {
+                coords[d] = rem % shape[d];
+                rem /= shape[d];
+                zOffset += coords[d] * strides[d];
+            }
+
+            expr.moveTo(coords, offsets);
+
+            auto zRow = z + zOffset;
+            if (zStride == 1) {
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong c = 0; c < cols; c++)
+                    zRow[c] = expr.template get<T>(offsets, c);
+            } else {
+                for (Nd4jLong c = 0; c < cols; c++)
+                    zRow[c * zStride] = expr.template get<T>(offsets, c);
+            }
+        }
+    }
+
+    /**
+     * materialises expression into existing target array in one pass, target must have floating point type
+     */
+    template <typename E, typename = typename std::enable_if<is_expression<E>::value>::type>
+    void assign(NDArray& target, const E& expression) {
+        switch (target.dataType()) {
+            case nd4j::DataType::FLOAT32:
+                assign_<float>(target, expression);
+                break;
+            case nd4j::DataType::DOUBLE:
+                assign_<double>(target, expression);
+                break;
+            case nd4j::DataType::HALF:
+                assign_<float16>(target, expression);
+                break;
+            case nd4j::DataType::BFLOAT16:
+                assign_<bfloat16>(target, expression);
+                break;
+            default:
+                throw std::runtime_error("expr::assign: target array must have floating point data type");
+        }
+    }
+
+    /**
+     * materialises expression into new array of given shape and data type
+     */
+    template <typename E, typename = typename std::enable_if<is_expression<E>::value>::type>
+    NDArray evaluate(const E& expression, const std::vector<Nd4jLong>& shape, nd4j::DataType dtype, nd4j::memory::Workspace* workspace = nullptr) {
+        NDArray result('c', shape, dtype, workspace);
+        assign(result, expression);
+        return result;
+    }
+}
+}
+
+#endif //LIBND4J_NDARRAYEXPRESSION_H
@@ -60,6 +60,20 @@ namespace nd4j {
 
         // maximum number of elements
         int _height = 0;
+
+        // contiguous backing store [height, elementShape], used when height and element shape are known
+        // in this mode chunks are views into _storage, so write() copies data straight into its slot
+        nd4j::NDArray* _storage = nullptr;
+
+        // arrays passed to write() in contiguous mode: data is copied into storage, but list owns them as in chunked mode
+        std::map<int, nd4j::NDArray*> _adopted;
+
+        Nd4jStatus validate(NDArray* array);
+        bool fitsStorage(int idx, NDArray* array);
+        void allocateStorage(NDArray* array, Nd4jLong height);
+        void releaseStorage();
+        NDArray* slot(int idx);
+        NDArray* storageView(Nd4jLong rows);
     public:
         NDArrayList(int height, bool expandable = false);
         ~NDArrayList();
@@ -68,14 +82,30 @@ namespace nd4j {
 
         NDArray* read(int idx);
         NDArray* readRaw(int idx);
+
+        /**
+         * This method stores given array at idx, list takes ownership of it and releases it in destructor.
+         * Caller may keep using the array while list is alive
+         */
         Nd4jStatus write(int idx, NDArray* array);
 
+        /**
+         * This method stores copy of given array at idx, without intermediate allocation if list is contiguous
+         */
+        Nd4jStatus assign(int idx, const NDArray& array);
+
         NDArray* pick(std::initializer_list<int> indices);
         NDArray* pick(std::vector<int>& indices);
         bool isWritten(int index);
 
         std::vector<Nd4jLong>& shape();
 
+        /**
+         * This method returns elements stacked along first dimension, caller owns the result.
+         * For contiguous list result is a single memcpy of backing store rows instead of per-element stack op.
+         * It's not a view: stack_list puts result into VariableSpace, where it outlives the list and is read after
+         * the list gets further writes in TensorArray loops
+         */
         NDArray* stack();
         void unstack(NDArray* array, int axis);
 
@@ -91,6 +121,11 @@ namespace nd4j {
         int height();
 
         int counter();
+
+        /**
+         * This method returns true if elements are stored in one contiguous buffer
+         */
+        bool isContiguous();
     };
 }
 
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Lightweight set of TAD views over a single array: base buffer + shared TAD shapeInfo + offsets.
+// Unlike ResultSet, no NDArray is allocated on heap, at() returns non-owning sub-array by value
+//
+
+#ifndef LIBND4J_TADSET_H
+#define LIBND4J_TADSET_H
+
+#include <vector>
+#include <NDArray.h>
+#include <dll.h>
+
+namespace nd4j {
+    class ND4J_EXPORT TadSet {
+    private:
+        int8_t* _buffer = nullptr;
+        Nd4jLong* _tadShapeInfo = nullptr;
+        Nd4jLong* _tadOffsets = nullptr;
+        Nd4jLong _numTads = 0;
+        size_t _sizeOfT = 0;
+        nd4j::memory::Workspace* _workspace = nullptr;
+
+    public:
+        class ND4J_EXPORT iterator {
+        private:
+            const TadSet* _set;
+            Nd4jLong _idx;
+        public:
+            iterator(const TadSet* set, Nd4jLong idx) : _set(set), _idx(idx) { }
+
+            NDArray operator*() const { return _set->at(_idx); }
+            iterator& operator++() { ++_idx; return *this; }
+            bool operator!=(const iterator& other) const { return _idx != other._idx; }
+        };
+
+        /**
+         * builds views of all tensors along given dimensions, TAD shapeInfo and offsets come from ConstantTadHelper cache
+         */
+        TadSet(const NDArray& array, const std::vector<int>& dimensions);
+
+        /**
+         * same as above, for all examples i.e. TADs along all dimensions except 0
+         */
+        static TadSet examples(const NDArray& array);
+
+        Nd4jLong size() const;
+
+        /**
+         * returns non-owning sub-array, pointing into original buffer
+         */
+        NDArray at(const Nd4jLong idx) const;
+        NDArray operator[](const Nd4jLong idx) const;
+
+        /**
+         * raw access for hot loops: typed pointer to first element of TAD, and shared TAD shapeInfo
+         */
+        template <typename T>
+        T* bufferAt(const Nd4jLong idx) const {
+            return reinterpret_cast<T*>(_buffer + _tadOffsets[idx] * _sizeOfT);
+        }
+
+        Nd4jLong* tadShapeInfo() const;
+        Nd4jLong* tadOffsets() const;
+
+        iterator begin() const;
+        iterator end() const;
+    };
+}
+
+#endif //LIBND4J_TADSET_H
@@ -41,6 +41,11 @@ namespace nd4j {
             delete v.second;
 
         _chunks.clear();
+
+        for (auto const& v : _adopted)
+            delete v.second;
+
+        delete _storage;
     }
 
     NDArray* NDArrayList::read(int idx) {
@@ -60,14 +65,7 @@ namespace nd4j {
         return _chunks[idx];
     }
 
-    Nd4jStatus NDArrayList::write(int idx, NDArray* array) {
-        if (_chunks.count(idx) == 0)
-            _elements++;
-        else {
-            delete _chunks[idx];
-        }
-
-
+    Nd4jStatus NDArrayList::validate(NDArray* array) {
         // we store reference shape on first write
         if (_chunks.empty()) {
             _dtype = array->dataType();
@@ -114,15 +112,115 @@ namespace nd4j {
             } else
                 return Status::CODE(ND4J_STATUS_BAD_INPUT, "NDArrayList: all arrays must have same size along inner dimensions");
         }
-        
-        //_elements++;
 
-        // storing reference
-        _chunks[idx] = array;
+        return ND4J_STATUS_OK;
+    }
+
+    bool NDArrayList::fitsStorage(int idx, NDArray* array) {
+        if (idx < 0 || idx >= _storage->sizeAt(0) || array->dataType() != _storage->dataType() || array->rankOf() != _storage->rankOf() - 1)
+            return false;
+
+        for (int e = 0; e < array->rankOf(); e++)
+            if (array->sizeAt(e) != _storage->sizeAt(e + 1))
+                return false;
+
+        return true;
+    }
+
+    void NDArrayList::allocateStorage(NDArray* array, Nd4jLong height) {
+        std::vector<Nd4jLong> shape({height});
+        for (int e = 0; e < array->rankOf(); e++)
+            shape.emplace_back(array->sizeAt(e));
+
+        _storage = new NDArray('c', shape, array->dataType(), _workspace);
+    }
+
+    void NDArrayList::releaseStorage() {
+        // chunks are views into storage, so they get their own buffers now
+        for (auto& v : _chunks) {
+            auto chunk = v.second->dup();
+            delete v.second;
+            v.second = chunk;
+        }
+
+        delete _storage;
+        _storage = nullptr;
+    }
+
+    NDArray* NDArrayList::slot(int idx) {
+        if (_chunks.count(idx) == 0) {
+            auto shape = _storage->getShapeAsVector();
+            shape.erase(shape.begin());
+
+            auto elementLength = _storage->lengthOf() / _storage->sizeAt(0);
+            _chunks[idx] = new NDArray(_storage->bufferWithOffset(idx * elementLength), 'c', shape, _storage->dataType(), _workspace);
+        }
+
+        return _chunks[idx];
+    }
+
+    NDArray* NDArrayList::storageView(Nd4jLong rows) {
+        auto shape = _storage->getShapeAsVector();
+        shape[0] = rows;
+
+        return new NDArray(_storage->buffer(), 'c', shape, _storage->dataType(), _workspace);
+    }
+
+    Nd4jStatus NDArrayList::write(int idx, NDArray* array) {
+        auto status = validate(array);
+        if (status != ND4J_STATUS_OK)
+            return status;
+
+        // list with known height gets single buffer on first write, ragged list or write beyond height falls back to separate chunks
+        if (_storage == nullptr && _chunks.empty() && _height > 0 && idx < _height)
+            allocateStorage(array, _height);
+        else if (_storage != nullptr && !fitsStorage(idx, array))
+            releaseStorage();
+
+        if (_chunks.count(idx) == 0)
+            _elements++;
+
+        if (_storage != nullptr) {
+            auto chunk = slot(idx);
+            if (chunk != array) {
+                chunk->assign(array);
+
+                // caller may still use this array, so it's released together with the list
+                if (_adopted.count(idx) > 0 && _adopted[idx] != array)
+                    delete _adopted[idx];
+
+                _adopted[idx] = array;
+            }
+        } else {
+            if (_chunks.count(idx) > 0 && _chunks[idx] != array)
+                delete _chunks[idx];
+
+            // storing reference
+            _chunks[idx] = array;
+        }
 
         return ND4J_STATUS_OK;
     }
 
+    Nd4jStatus NDArrayList::assign(int idx, const NDArray& array) {
+        auto arrayPtr = const_cast<NDArray*>(&array);
+
+        if (_storage != nullptr && fitsStorage(idx, arrayPtr)) {
+            if (_chunks.count(idx) == 0)
+                _elements++;
+
+            slot(idx)->assign(array);
+            return ND4J_STATUS_OK;
+        }
+
+        auto copy = arrayPtr->dup();
+        auto status = write(idx, copy);
+        if (status != ND4J_STATUS_OK)
+            delete copy;
+
+        return status;
+    }
+
     std::vector<Nd4jLong>& NDArrayList::shape() {
         return _shape;
     }
@@ -133,6 +231,32 @@ namespace nd4j {
 
     void NDArrayList::unstack(NDArray* array, int axis) {
         _axis = axis;
+
+        if (_chunks.empty() && _storage == nullptr && _shape.empty() && array->rankOf() > 0) {
+            // single copy of the whole input into contiguous storage, chunks are views into it
+            if (axis < 0)
+                axis += array->rankOf();
+
+            std::vector<int> permutation({axis});
+            for (int e = 0; e < array->rankOf(); e++)
+                if (e != axis)
+                    permutation.emplace_back(e);
+
+            auto permuted = array->permute(permutation);
+            _storage = permuted->dup('c');
+            delete permuted;
+
+            _dtype = array->dataType();
+            _shape = _storage->getShapeAsVector();
+            _shape[0] = 1;
+
+            for (int e = 0; e < _storage->sizeAt(0); e++)
+                slot(e);
+
+            _elements.store(_storage->sizeAt(0));
+            return;
+        }
+
         std::vector<int> args({axis});
         auto newAxis = ShapeUtils::evalDimsToExclude(array->rankOf(), args);
         auto result = array->allTensorsAlongDimension(newAxis);
@@ -152,6 +276,21 @@ namespace nd4j {
         std::vector<bool> bargs;
         int numElements = _elements.load();
 
+        if (_storage != nullptr && numElements > 0) {
+            bool dense = true;
+            for (int e = 0; e < numElements && dense; e++)
+                dense = isWritten(e);
+
+            // leading rows of storage are exactly the stacked result, single copy detaches it from further writes and list lifetime
+            if (dense) {
+                auto view = storageView(numElements);
+                auto array = view->dup('c');
+                delete view;
+
+                return array;
+            }
+        }
+
         for (int e = 0; e < numElements; e++)
             inputs.emplace_back(_chunks[e]);
 
@@ -189,6 +328,10 @@ namespace nd4j {
             return (int) _chunks.size();
     }
 
+    bool NDArrayList::isContiguous() {
+        return _storage != nullptr;
+    }
+
     bool NDArrayList::isWritten(int index) {
         if (_chunks.count(index) > 0)
             return true;
@@ -230,9 +373,17 @@ namespace nd4j {
         list->_id.second = _id.second;
         list->_name = _name;
         list->_elements.store(_elements.load());
+        list->_dtype = _dtype;
+        list->_shape = _shape;
 
-        for (auto const& v : _chunks) {
-            list->_chunks[v.first] = v.second->dup();
+        if (_storage != nullptr) {
+            list->_storage = _storage->dup();
+            for (auto const& v : _chunks)
+                list->slot(v.first);
+        } else {
+            for (auto const& v : _chunks) {
+                list->_chunks[v.first] = v.second->dup();
+            }
         }
 
         return list;
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <array/TadSet.h>
+#include <helpers/ConstantTadHelper.h>
+#include <algorithm>
+
+namespace nd4j {
+    TadSet::TadSet(const NDArray& array, const std::vector<int>& dimensions) {
+        _buffer = reinterpret_cast<int8_t*>(array.getBuffer());
+        _sizeOfT = array.sizeOfT();
+        _workspace = array.getWorkspace();
+
+        if (dimensions.empty())
+            return;
+
+        std::vector<int> copy(dimensions);
+        if (copy.size() > 1)
+            std::sort(copy.begin(), copy.end());
+
+        if (copy.back() >= array.rankOf())
+            throw std::runtime_error("TadSet: all input dimensions must be smaller than rank of input array !");
+
+        auto& tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(array.getShapeInfo(), copy);
+        _tadShapeInfo = tadPack.primaryShapeInfo();
+        _tadOffsets = tadPack.primaryOffsets();
+        _numTads = tadPack.numberOfTads();
+    }
+
+    TadSet TadSet::examples(const NDArray& array) {
+        std::vector<int> dimensions(array.rankOf() - 1);
+        for (int e = 1; e < array.rankOf(); e++)
+            dimensions[e - 1] = e;
+
+        return TadSet(array, dimensions);
+    }
+
+    Nd4jLong TadSet::size() const {
+        return _numTads;
+    }
+
+    NDArray TadSet::at(const Nd4jLong idx) const {
+        return NDArray(_buffer + _tadOffsets[idx] * _sizeOfT, _tadShapeInfo, _workspace, false, false);
+    }
+
+    NDArray TadSet::operator[](const Nd4jLong idx) const {
+        return at(idx);
+    }
+
+    Nd4jLong* TadSet::tadShapeInfo() const {
+        return _tadShapeInfo;
+    }
+
+    Nd4jLong* TadSet::tadOffsets() const {
+        return _tadOffsets;
+    }
+
+    TadSet::iterator TadSet::begin() const {
+        return iterator(this, 0);
+    }
+
+    TadSet::iterator TadSet::end() const {
+        return iterator(this, _numTads);
+    }
+}
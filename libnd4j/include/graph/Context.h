@@ -173,6 +173,12 @@ namespace nd4j {
 
             bool isValueAvailable(int idx = 0);
 
+            /**
+             * This method returns true if Graph::inferShapes() preallocated all outputs of this node,
+             * and placeholder shapes didn't change since then, so shape functions and validation can be skipped
+             */
+            bool hasKnownShapes();
+
             Variable* ensureVariable(int idx = 0);
 
             unsigned long width() override;
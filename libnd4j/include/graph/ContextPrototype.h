@@ -35,6 +35,16 @@ namespace nd4j {
         protected:
             // int ids of the input nodes
             std::vector<std::pair<int, int>> _inputs;
+
+            // VariableSpace slots of inputs, assigned by Graph once it's built
+            std::vector<int> _inputSlots;
+
+            // outputs of this node were preallocated by Graph::inferShapes() for given shape class
+            Nd4jLong _shapeClass = 0;
+            int _knownOutputs = 0;
+
+            // hash of input shapes outputs were inferred for
+            Nd4jLong _knownInputs = 0;
             int _nodeId;
             std::vector<double> _tArgs;
             std::vector<int> _iArgs;
@@ -78,6 +88,21 @@ namespace nd4j {
             void fillInputs(std::initializer_list<int> inputs);
             void fillInputs(std::vector<int>& inputs);
             std::vector<std::pair<int, int>>* inputs();
+            std::vector<int>* inputSlots();
+
+            /**
+             * These methods mark node as having its output shapes inferred and preallocated for given shape class
+             * Pass 0 as shape class to reset the mark
+             */
+            void setKnownShapes(Nd4jLong shapeClass, int numOutputs, Nd4jLong inputShapes = 0);
+            Nd4jLong shapeClass();
+            int knownOutputs();
+            Nd4jLong knownInputs();
+
+            /**
+             * This method mixes given shapeInfo into hash, used to check inputs of nodes with known shapes
+             */
+            static Nd4jLong shapeHash(Nd4jLong hash, const Nd4jLong *shapeInfo);
 
             std::vector<double>* getTArguments();
             std::vector<int>* getIArguments();
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Execution plan: state of built Graph, i.e. node order, rewritten node inputs and arguments, slot assignments,
+// output shapes seen so far and constants produced by graph passes. Plan can be serialized next to FlatGraph,
+// and applied on registration, so toposort and graph passes are skipped.
+//
+
+#ifndef LIBND4J_EXECUTIONPLAN_H
+#define LIBND4J_EXECUTIONPLAN_H
+
+#include <vector>
+#include <pointercast.h>
+#include <dll.h>
+#include <NDArray.h>
+
+namespace nd4j {
+    namespace graph {
+        class Graph;
+        class VariableSpace;
+
+        class ND4J_EXPORT ExecutionPlan {
+        public:
+            // "NDEP" in little-endian
+            static const int MAGIC = 0x5045444E;
+            static const int VERSION = 2;
+
+            struct NodePlan {
+                int id = 0;
+                int layer = 0;
+
+                // hash of custom op, 0 for legacy ops, which are built from FlatNode as is
+                Nd4jLong opHash = 0L;
+
+                std::vector<std::pair<int, int>> inputs;
+                std::vector<int> inputSlots;
+                std::vector<int> iArgs;
+                std::vector<double> tArgs;
+                std::vector<bool> bArgs;
+
+                // shapeInfo of each output seen when plan was captured, empty if node wasn't executed yet
+                std::vector<std::vector<Nd4jLong>> shapes;
+            };
+
+        protected:
+            Nd4jLong _registryVersion = 0L;
+            Nd4jLong _requiredMemory = 0L;
+
+            // Graph::hashFlatGraph() of the graph plan was captured from
+            Nd4jLong _graphFingerprint = 0L;
+
+            // ids of nodes removed by graph passes, every other node of the graph must be planned
+            std::vector<int> _removed;
+
+            // nodes in execution order
+            std::vector<NodePlan> _nodes;
+
+            // (node, output) pairs in order of slots
+            std::vector<std::pair<int, int>> _slots;
+
+            // constant variables created by graph passes, owned by plan
+            std::vector<std::pair<int, NDArray*>> _constants;
+
+        public:
+            ExecutionPlan() = default;
+            ~ExecutionPlan();
+
+            ExecutionPlan(const ExecutionPlan& other) = delete;
+            ExecutionPlan& operator=(const ExecutionPlan& other) = delete;
+
+            /**
+             * This method captures plan of built graph. Output shapes and memory requirements are taken from given VariableSpace,
+             * or from VariableSpace of the graph itself, so they are available only if graph was executed at least once
+             */
+            static ExecutionPlan* fromGraph(Graph *graph, VariableSpace *state = nullptr);
+
+            /**
+             * This method restores plan from serialized form, throws std::runtime_error if buffer is malformed
+             */
+            static ExecutionPlan* fromBuffer(const void *buffer, Nd4jLong length);
+
+            /**
+             * This method returns serialized form of this plan
+             */
+            std::vector<int8_t> asBuffer();
+
+            /**
+             * This method returns fingerprint of ops available in OpRegistrator. Plans built against another set of ops aren't applied
+             */
+            static Nd4jLong registryVersion();
+
+            bool isCompatible();
+
+            Nd4jLong graphFingerprint();
+
+            // total size of node outputs in bytes, used to pre-allocate workspace
+            Nd4jLong requiredMemory();
+
+            std::vector<NodePlan>* nodes();
+
+            std::vector<int>* removedNodes();
+
+            std::vector<std::pair<int, int>>* slots();
+
+            std::vector<std::pair<int, NDArray*>>* constants();
+        };
+    }
+}
+
+#endif //LIBND4J_EXECUTIONPLAN_H
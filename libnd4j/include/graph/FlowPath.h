@@ -22,6 +22,7 @@
 #define LIBND4J_FLOWPATH_H
 
 #include <map>
+#include <vector>
 #include <pointercast.h>
 #include <graph/NodeState.h>
 #include <graph/FrameState.h>
@@ -32,10 +33,13 @@ namespace nd4j {
     namespace graph {
         class ND4J_EXPORT FlowPath {
         private:
-            std::map<int, NodeState> _states;
+            // states of nodes are indexed by node id, map is used only for ids out of [0, MAX_FLAT_ID) range
+            static const int MAX_FLAT_ID = 1 << 16;
+            std::vector<NodeState> _states;
+            std::map<int, NodeState> _sparseStates;
             std::map<Nd4jLong, FrameState> _frames;
 
-            void ensureNode(int nodeId);
+            NodeState& ensureNode(int nodeId);
             void ensureFrame(int nodeId);
 
             GraphProfile _profile;
@@ -74,6 +78,7 @@ namespace nd4j {
             void setRewindPositionOnce(Nd4jLong frameId, int position);
 
             void incrementNumberOfCycles(Nd4jLong frameId);
+            void resetNumberOfCycles(Nd4jLong frameId);
             Nd4jLong getNumberOfCycles(Nd4jLong frameId);
 
             GraphProfile* profile();
@@ -52,6 +52,11 @@ namespace nd4j {
              */
             void incrementNumberOfCycles();
 
+            /**
+             * This method resets number of cycles, used when Frame is entered again
+             */
+            void resetNumberOfCycles();
+
             /**
              * This method returns TRUE is frame was activated at LoopCond
              * @return
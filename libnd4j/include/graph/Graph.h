@@ -39,6 +39,9 @@
 namespace nd4j {
     namespace graph {
 
+        class ExecutionPlan;
+        class FrameExecutor;
+
         class ND4J_EXPORT Graph {
         protected:
             ExecutorConfiguration *_configuration;
@@ -66,6 +69,21 @@ namespace nd4j {
             std::map<int, Scope*> _mappedScopes;
             std::vector<Scope*> _scopes;
 
+            // inputs of permute/transpose nodes removed by optimizeLayouts(), used to report sizes of copies that were avoided
+            std::vector<std::pair<int, int>> _eliminatedPermutes;
+
+            // ids of constant variables created by graph passes: folded results and quantised weights
+            std::vector<int> _derivedConstants;
+
+            // ids of nodes removed by graph passes, stored in ExecutionPlan
+            std::vector<int> _removedNodes;
+
+            // hash of FlatGraph this graph was imported from, 0 for graphs built in code
+            Nd4jLong _fingerprint = 0L;
+
+            // compiled loop frames, nullptr is stored for frames that can't be compiled
+            std::map<Nd4jLong, FrameExecutor*> _frameExecutors;
+
 ////////////////////////////////////////
             Nd4jStatus validateNode(nd4j::graph::Node *node);
 
@@ -79,8 +97,26 @@ namespace nd4j {
 
             void prepareOutputs();
 
+            // this method releases compiled loop frames, they're compiled again on demand
+            void forgetFrames();
+
+            // this method removes node from all internal structures and releases it
+            void eraseNode(nd4j::graph::Node *node);
+
+            // this method rebuilds onion layers of mapped nodes from their inputs
+            void relayerNodes();
+
+            // this method assigns VariableSpace slots to outputs of mapped nodes, and stores slots of inputs in their ContextPrototypes
+            void assignSlots();
+
+            // this method maps nodes according to given ExecutionPlan, returns false if plan doesn't match this graph
+            bool applyPlan(ExecutionPlan *plan);
+
         public:
-            Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr);
+            /**
+             * If ExecutionPlan is provided and matches given FlatGraph, toposort and graph passes are skipped, and state from plan is used instead
+             */
+            Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr, ExecutionPlan *plan = nullptr);
 
             ~Graph();
 
@@ -93,6 +129,104 @@ namespace nd4j {
             // this method will build structured representation of graph
             Nd4jStatus buildGraph();
 
+            /**
+             * This method replaces matmul/conv2d nodes fed by fake_quant_with_min_max_vars nodes with constant ranges by qmatmul/qconv2d nodes.
+             * Weights are quantised to INT8 once, fake-quant nodes left without consumers are removed.
+             * Called from buildGraph() when enabled via Environment::setFoldQuantization(true)
+             *
+             * @return number of folded nodes
+             */
+            int foldFakeQuantization();
+
+            /**
+             * This method merges duplicate nodes, i.e. nodes with the same op, inputs and arguments, and removes identity-like nodes:
+             * identity ops and multiplications by scalar one. Chains of reshapes using the same order are collapsed into single reshape.
+             * Called after graph is built unless disabled via Environment::setSimplifyGraphs(false)
+             *
+             * @return number of removed nodes
+             */
+            int simplify();
+
+            /**
+             * This method evaluates nodes that depend on constants only, and replaces them with constant variables holding their results.
+             * Only variables marked via Variable::markConstant() count as constants, regular variables can be fed between runs.
+             * Random and control flow ops are never folded, graphs without placeholders are left as is.
+             * Called after graph is built unless disabled via Environment::setFoldConstants(false)
+             *
+             * @return number of folded nodes
+             */
+            int foldConstants();
+
+            /**
+             * This method removes nodes that don't contribute to explicitly requested outputs. Applies to OutputMode_EXPLICIT only.
+             * Called after foldConstants() unless disabled via Environment::setFoldConstants(false)
+             *
+             * @return number of removed nodes
+             */
+            int pruneUnreachable();
+
+            /**
+             * This method runs shape functions of the whole graph for current placeholder shapes, and preallocates node outputs,
+             * so nodes with known shapes skip validation and shape functions at runtime. Nothing is done if placeholder shapes
+             * didn't change since last call. Values of small non-floating external inputs are part of shape class, nodes that depend on
+             * runtime values of other non-floating inputs are left as is.
+             * Called by GraphExecutioner unless disabled via Environment::setInferShapes(false)
+             *
+             * @param variableSpace VariableSpace to preallocate outputs in, graph's own VariableSpace is used if nullptr
+             * @return number of nodes with known shapes
+             */
+            int inferShapes(VariableSpace *variableSpace = nullptr);
+
+            /**
+             * This method removes redundant permute/transpose nodes from built graph:
+             * - identity permutations are dropped, chains of permutes are composed into single permute or cancelled
+             * - permutes are moved past elementwise ops and layout-aware ops (conv/pooling with dataFormat argument),
+             *   if that makes them adjacent to another permute, so segment between them runs in layout of the source tensor
+             * Graph outputs are never changed. Called after graph is built unless disabled via Environment::setOptimizeLayouts(false)
+             *
+             * @return number of eliminated permute/transpose nodes
+             */
+            int optimizeLayouts();
+
+            /**
+             * This method returns inputs of permute/transpose nodes eliminated by optimizeLayouts()
+             */
+            FORCEINLINE std::vector<std::pair<int, int>>* eliminatedPermutes() {
+                return &_eliminatedPermutes;
+            }
+
+            /**
+             * This method returns ids of constant variables created by foldFakeQuantization() and foldConstants()
+             */
+            FORCEINLINE std::vector<int>* derivedConstants() {
+                return &_derivedConstants;
+            }
+
+            /**
+             * This method returns ids of nodes removed by graph passes
+             */
+            FORCEINLINE std::vector<int>* removedNodes() {
+                return &_removedNodes;
+            }
+
+            /**
+             * This method returns hash of FlatGraph this graph was imported from, ExecutionPlan is applied only to the same graph
+             */
+            FORCEINLINE Nd4jLong fingerprint() {
+                return _fingerprint;
+            }
+
+            /**
+             * This method hashes ids, ops, inputs and arguments of all nodes of given FlatGraph, and values of all its non-placeholder variables
+             */
+            static Nd4jLong hashFlatGraph(const FlatGraph *flatGraph);
+
+            /**
+             * This method returns true if node gives the same result for the same inputs and has no side effects,
+             * so it can be merged with identical node or evaluated fewer times
+             */
+            static bool isDeterministic(Node* node);
+
             // this method will return estimated memory size (in bytes) required for 1 full graph execution round
             Nd4jLong estimateRequiredMemory();
 
@@ -132,6 +266,12 @@ namespace nd4j {
              */
             std::map<int, nd4j::graph::Node*> *getMapped();
 
+            /**
+             * This method returns compiled schedule of given loop frame, or nullptr if frame can't be executed as straight-line schedule
+             * Frames are compiled on first request
+             */
+            FrameExecutor* frameExecutor(Nd4jLong frameId);
+
             /**
              * This method returns outputs of this graph
              * @return
@@ -272,6 +412,17 @@ namespace nd4j {
                         (*this->_onion)[v.first] = vec;
                 }
 
+                for (auto &v: *other->eliminatedPermutes())
+                    this->_eliminatedPermutes.emplace_back(v);
+
+                for (auto v: *other->derivedConstants())
+                    this->_derivedConstants.emplace_back(v);
+
+                for (auto v: *other->removedNodes())
+                    this->_removedNodes.emplace_back(v);
+
+                this->_fingerprint = other->fingerprint();
+
                 this->_built.store(other->built());
             }
         };
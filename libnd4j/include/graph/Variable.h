@@ -45,6 +45,9 @@ namespace nd4j {
             bool _placeholder = false;
             bool _removable = true;
 
+            // true for variables that can't be fed from outside, i.e. CONSTANT ones from FlatGraph
+            bool _constant = false;
+
             // for now we're setting default to numeric
             // in future we'll be fetching it right from the array, 
             //InputType _variableType = InputType_UNDEFINED;
@@ -78,6 +81,7 @@ namespace nd4j {
             bool isReadOnly();
             bool isEmpty();
             bool isRemovable();
+            bool isConstant();
 
             bool isPlaceholder();
 
@@ -94,6 +98,7 @@ namespace nd4j {
             void markExternal(bool reallyExternal);
             void markReadOnly(bool reallyReadOnly);
             void markRemovable(bool reallyRemovable);
+            void markConstant(bool reallyConstant);
 
             int id();
             int index();
@@ -55,6 +55,11 @@ namespace nd4j {
 
             virtual std::vector<Variable*> getVariables();
 
+            virtual int registerSlot(std::pair<int,int>& pair);
+            virtual int numberOfSlots();
+            virtual nd4j::graph::Variable* getVariableBySlot(int slot, const std::pair<int,int>& pair);
+            virtual std::pair<int,int> slotPair(int slot);
+
             virtual void putVariable(std::pair<int,int>& pair, NDArray *array);
             virtual void putVariable(std::pair<int,int>& pair, Variable *variable);
             virtual void putVariable(int id, Variable *variable);
@@ -69,6 +69,17 @@ namespace nd4j {
 
             FlowPath* _flow = nullptr;
 
+            // dense slots of (node, output) pairs, assigned once graph is built, and variables cached for them
+            std::map<std::pair<int, int>, int> _slotIds;
+            std::vector<std::pair<int, int>> _slotPairs;
+            std::vector<Variable*> _slots;
+
+            // hash of placeholder/constant shapes output shapes were inferred for, 0 if none
+            Nd4jLong _shapeClass = 0;
+
+            // drops cached variable of given pair, so next lookup by slot resolves it again
+            void invalidateSlot(const std::pair<int, int>& pair);
+
         public:
             VariableSpace();
             virtual ~VariableSpace();
@@ -99,6 +110,23 @@ namespace nd4j {
 
             virtual std::vector<Variable*> getVariables();
 
+            /**
+             * These methods provide lookups by dense slot index, instead of map lookups by (node, output) pair
+             * registerSlot() returns slot of given pair, assigning new one if needed.
+             * getVariableBySlot() returns nullptr if slot doesn't belong to given pair or variable doesn't exist yet
+             * slotPair() returns (node, output) pair that owns given slot
+             */
+            virtual int registerSlot(std::pair<int,int>& pair);
+            virtual int numberOfSlots();
+            virtual nd4j::graph::Variable* getVariableBySlot(int slot, const std::pair<int,int>& pair);
+            virtual std::pair<int,int> slotPair(int slot);
+
+            /**
+             * Shape class is set by Graph::inferShapes(), and identifies input shapes preallocated outputs match
+             */
+            Nd4jLong shapeClass() { return _shapeClass; }
+            void setShapeClass(Nd4jLong shapeClass) { _shapeClass = shapeClass; }
+
             virtual void putVariable(std::pair<int,int>& pair, NDArray *array);
             virtual void putVariable(std::pair<int,int>& pair, Variable *variable);
             virtual void putVariable(int id, Variable *variable);
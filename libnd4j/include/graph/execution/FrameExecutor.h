@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Straight-line executor for TF-style loop frames: Enter -> Merge -> LoopCond -> Switch -> body -> NextIteration -> Exit
+//
+
+#ifndef LIBND4J_FRAMEEXECUTOR_H
+#define LIBND4J_FRAMEEXECUTOR_H
+
+#include <pointercast.h>
+#include <graph/Node.h>
+#include <graph/Graph.h>
+#include <vector>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class holds precompiled schedule of a single loop frame, and iterates it natively,
+         * instead of rewinding onion layers and re-checking Enter/Merge/Switch state on every iteration.
+         *
+         * Enter nodes are evaluated once per frame execution, and deterministic ops depending only on Enter nodes and values
+         * from outside of the frame are hoisted: they're executed once before the loop instead of on every iteration.
+         * Loop variables are carried between iterations by swapping output buffers of NextIteration sources,
+         * so per-iteration tensors are reused as long as their shapes stay the same.
+         */
+        class FrameExecutor {
+        protected:
+            Nd4jLong _frameId;
+
+            // all nodes of the frame, Enter and Exit nodes included
+            std::vector<Node*> _nodes;
+            std::vector<Node*> _enters;
+            std::vector<Node*> _exits;
+
+            // loop variables: Merge node, its Switch and NextIteration nodes, indices match
+            std::vector<Node*> _merges;
+            std::vector<Node*> _switches;
+            std::vector<Node*> _nextIterations;
+
+            Node* _loopCond = nullptr;
+
+            // ops evaluating loop condition and loop body, in execution order
+            std::vector<Node*> _condition;
+            std::vector<Node*> _body;
+
+            // loop-invariant ops, executed once before the first iteration
+            std::vector<Node*> _invariant;
+
+            // outputs of nodes outside of the frame, consumed within it
+            std::vector<std::pair<int, int>> _external;
+
+            FrameExecutor() = default;
+
+            // this method releases arrays owned by condition and body nodes, and optionally by invariant ones, so they're allocated again with new shapes
+            void releaseOutputs(VariableSpace *variableSpace, bool invariant);
+        public:
+            ~FrameExecutor() = default;
+
+            /**
+             * This method builds schedule for given frame, returns nullptr if frame structure isn't supported:
+             * nested frames, conditionals within loop body, or multiple loop conditions
+             */
+            static FrameExecutor* compile(Graph *graph, Nd4jLong frameId);
+
+            /**
+             * This method returns true if all inputs of the frame are available, so it can be executed right now
+             */
+            bool isApplicable(Graph *graph, VariableSpace *variableSpace);
+
+            /**
+             * This method executes whole loop, and leaves its results in Exit nodes.
+             * Number of iterations is limited by Environment::maxLoopIterations()
+             */
+            Nd4jStatus execute(Graph *graph, VariableSpace *variableSpace);
+
+            Nd4jLong frameId();
+            std::vector<Node*>* nodes();
+            std::vector<Node*>* invariant();
+        };
+    }
+}
+
+
+#endif //LIBND4J_FRAMEEXECUTOR_H
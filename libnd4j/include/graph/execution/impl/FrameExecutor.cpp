@@ -0,0 +1,472 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Straight-line executor for TF-style loop frames
+//
+
+#include <graph/execution/FrameExecutor.h>
+#include <GraphExecutioner.h>
+#include <Environment.h>
+#include <Status.h>
+#include <set>
+
+namespace nd4j {
+    namespace graph {
+        static bool isLogic(Node *node, int opNum) {
+            return node->opType() == OpType_LOGIC && node->opNum() == opNum;
+        }
+
+        // binds array to the output of a logic node. owned array is released together with variable, or once something else is bound
+        static void bindArray(VariableSpace *variableSpace, int nodeId, int index, NDArray *array, bool owned = false) {
+            std::pair<int, int> pair(nodeId, index);
+            if (!variableSpace->hasVariable(pair))
+                variableSpace->putVariable(pair, new Variable(nullptr, nullptr, nodeId, index));
+
+            auto var = variableSpace->getVariable(pair);
+            if (var->hasNDArray() && var->getNDArray() != array && var->isRemovable() && !var->isReadOnly())
+                delete var->getNDArray();
+
+            var->setNDArray(array);
+            var->markRemovable(owned);
+            var->markReadOnly(!owned);
+        }
+
+        static NDArray* fetchArray(VariableSpace *variableSpace, std::pair<int, int> &pair) {
+            if (!variableSpace->hasVariable(pair))
+                return nullptr;
+
+            auto var = variableSpace->getVariable(pair);
+            return var->hasNDArray() ? var->getNDArray() : nullptr;
+        }
+
+        FrameExecutor* FrameExecutor::compile(Graph *graph, Nd4jLong frameId) {
+            auto mapped = graph->getMapped();
+
+            std::map<int, std::vector<Node*>> consumers;
+            for (auto &v: *mapped)
+                for (auto &p: *v.second->input())
+                    if (mapped->count(p.first) > 0)
+                        consumers[p.first].emplace_back(v.second);
+
+            // frame consists of everything reachable from its Enter nodes, up to Exit nodes
+            std::set<int> members;
+            std::vector<Node*> pending;
+            for (auto &v: *mapped)
+                if (isLogic(v.second, logic::Enter) && v.second->getFrameId() == frameId) {
+                    members.insert(v.first);
+                    pending.emplace_back(v.second);
+                }
+
+            if (pending.empty())
+                return nullptr;
+
+            while (!pending.empty()) {
+                auto node = pending.back();
+                pending.pop_back();
+
+                if (isLogic(node, logic::Exit))
+                    continue;
+
+                for (auto consumer: consumers[node->id()]) {
+                    if (members.count(consumer->id()) > 0)
+                        continue;
+
+                    // nested frames, scopes and embedded graphs stay on generic path
+                    if (consumer->hasGraphEmbedded())
+                        return nullptr;
+
+                    if (consumer->opType() == OpType_LOGIC && !isLogic(consumer, logic::Merge) && !isLogic(consumer, logic::Switch) && !isLogic(consumer, logic::LoopCond) && !isLogic(consumer, logic::NextIteration) && !isLogic(consumer, logic::Exit))
+                        return nullptr;
+
+                    members.insert(consumer->id());
+                    pending.emplace_back(consumer);
+                }
+            }
+
+            auto frame = new FrameExecutor();
+            frame->_frameId = frameId;
+
+            auto reject = [&] (const char *reason) -> FrameExecutor* {
+                nd4j_debug("Frame %lld can't be compiled: %s\n", frameId, reason);
+                delete frame;
+                return nullptr;
+            };
+
+            std::vector<Node*> merges, switches, operations;
+            for (auto &l: *graph->getOnion())
+                for (auto node: *l.second) {
+                    if (members.count(node->id()) == 0)
+                        continue;
+
+                    frame->_nodes.emplace_back(node);
+
+                    if (node->opType() != OpType_LOGIC)
+                        operations.emplace_back(node);
+                    else if (isLogic(node, logic::Enter))
+                        frame->_enters.emplace_back(node);
+                    else if (isLogic(node, logic::Exit))
+                        frame->_exits.emplace_back(node);
+                    else if (isLogic(node, logic::Merge))
+                        merges.emplace_back(node);
+                    else if (isLogic(node, logic::Switch))
+                        switches.emplace_back(node);
+                    else if (isLogic(node, logic::LoopCond)) {
+                        if (frame->_loopCond != nullptr)
+                            return reject("multiple LoopCond nodes");
+
+                        frame->_loopCond = node;
+                    }
+                }
+
+            if (frame->_loopCond == nullptr || frame->_loopCond->input()->empty())
+                return reject("no LoopCond");
+
+            // each loop variable is Merge of Enter and NextIteration, routed by Switch driven by LoopCond
+            std::set<int> carried;
+            for (auto merge: merges) {
+                if (merge->input()->size() != 2 || mapped->count(merge->input()->at(1).first) == 0)
+                    return reject("Merge without NextIteration");
+
+                auto nextIteration = mapped->at(merge->input()->at(1).first);
+                if (!isLogic(nextIteration, logic::NextIteration) || members.count(nextIteration->id()) == 0 || nextIteration->input()->empty())
+                    return reject("Merge without NextIteration");
+
+                Node *routing = nullptr;
+                for (auto s: switches)
+                    if (s->input()->size() == 2 && s->input()->at(0).first == merge->id()) {
+                        if (routing != nullptr)
+                            return reject("Merge routed by multiple Switch nodes");
+
+                        routing = s;
+                    }
+
+                if (routing == nullptr || routing->input()->at(1).first != frame->_loopCond->id())
+                    return reject("Switch isn't driven by LoopCond");
+
+                // value either passes through unchanged, or comes from body op. each op output is carried by single variable
+                auto source = nextIteration->input()->at(0);
+                bool passThrough = source.first == routing->id() && source.second == 1;
+                if (!passThrough) {
+                    if (members.count(source.first) == 0 || mapped->at(source.first)->opType() == OpType_LOGIC || carried.count(source.first) > 0)
+                        return reject("unsupported NextIteration source");
+
+                    carried.insert(source.first);
+                }
+
+                frame->_merges.emplace_back(merge);
+                frame->_switches.emplace_back(routing);
+                frame->_nextIterations.emplace_back(nextIteration);
+            }
+
+            if (frame->_switches.size() != switches.size())
+                return reject("conditional within loop body");
+
+            for (auto exit: frame->_exits) {
+                auto &p = exit->input()->at(0);
+                if (p.second != 0 || std::none_of(switches.begin(), switches.end(), [&] (Node* s) { return s->id() == p.first; }))
+                    return reject("Exit isn't fed by Switch");
+            }
+
+            // condition ops are those LoopCond depends on, everything else is loop body
+            std::set<int> condition;
+            std::vector<int> stack = {frame->_loopCond->input()->at(0).first};
+            while (!stack.empty()) {
+                auto id = stack.back();
+                stack.pop_back();
+
+                if (members.count(id) == 0 || condition.count(id) > 0)
+                    continue;
+
+                auto node = mapped->at(id);
+                if (node->opType() == OpType_LOGIC) {
+                    if (!isLogic(node, logic::Merge) && !isLogic(node, logic::Enter))
+                        return reject("loop condition depends on loop body");
+
+                    continue;
+                }
+
+                condition.insert(id);
+                for (auto &p: *node->input())
+                    stack.emplace_back(p.first);
+            }
+
+            // values coming from outside of the frame or from logic nodes live across iterations, they can't be overwritten in place
+            for (auto node: operations)
+                for (auto &p: *node->input())
+                    if (node->isInplace() && (members.count(p.first) == 0 || mapped->at(p.first)->opType() == OpType_LOGIC))
+                        node->markInplace(false);
+
+            // ops fed only by Enter nodes, values from outside of the frame, or other invariant ops give the same result on every iteration.
+            // outputs carried by NextIteration are taken over by frame, so their producers run every iteration
+            std::set<int> invariant;
+            for (auto node: operations) {
+                if (carried.count(node->id()) > 0 || node->input()->empty() || !Graph::isDeterministic(node))
+                    continue;
+
+                bool hoisted = true;
+                for (auto &p: *node->input())
+                    if (members.count(p.first) > 0 && !isLogic(mapped->at(p.first), logic::Enter) && invariant.count(p.first) == 0)
+                        hoisted = false;
+
+                if (hoisted)
+                    invariant.insert(node->id());
+            }
+
+            for (auto node: operations) {
+                bool isCondition = condition.count(node->id()) > 0;
+
+                for (auto &p: *node->input()) {
+                    if (members.count(p.first) > 0) {
+                        auto producer = mapped->at(p.first);
+                        if (isLogic(producer, logic::Switch) && (isCondition || p.second != 1))
+                            return reject("op consumes inactive Switch branch");
+                    } else if (p.first > 0 && mapped->count(p.first) == 0) {
+                        return reject("unmapped input");
+                    }
+                }
+
+                if (invariant.count(node->id()) > 0)
+                    frame->_invariant.emplace_back(node);
+                else if (isCondition)
+                    frame->_condition.emplace_back(node);
+                else
+                    frame->_body.emplace_back(node);
+            }
+
+            // outputs of invariant ops are read on every iteration as well
+            for (auto node: operations)
+                for (auto &p: *node->input())
+                    if (node->isInplace() && invariant.count(p.first) > 0)
+                        node->markInplace(false);
+
+            std::set<std::pair<int, int>> external;
+            for (auto node: frame->_nodes)
+                for (auto &p: *node->input())
+                    if (members.count(p.first) == 0)
+                        external.insert(p);
+
+            frame->_external.assign(external.begin(), external.end());
+
+            nd4j_debug("Frame %lld compiled: %i loop variables, %i condition ops, %i body ops, %i invariant ops\n", frameId, (int) frame->_merges.size(), (int) frame->_condition.size(), (int) frame->_body.size(), (int) frame->_invariant.size());
+
+            return frame;
+        }
+
+        bool FrameExecutor::isApplicable(Graph *graph, VariableSpace *variableSpace) {
+            auto flowPath = variableSpace->flowPath();
+
+            for (auto p: _external) {
+                if (p.first > 0 && flowPath != nullptr && (!flowPath->wasExecuted(p.first) || !flowPath->isNodeActive(p.first)))
+                    return false;
+
+                // NDArrayList loop variables are handled by generic path
+                if (fetchArray(variableSpace, p) == nullptr)
+                    return false;
+            }
+
+            return true;
+        }
+
+        void FrameExecutor::releaseOutputs(VariableSpace *variableSpace, bool invariant) {
+            for (auto list: {&_condition, &_body, &_invariant})
+                for (auto node: *list) {
+                    if (!invariant && list == &_invariant)
+                        break;
+
+                    for (int e = 0; variableSpace->hasVariable(node->id(), e); e++) {
+                        auto var = variableSpace->getVariable(node->id(), e);
+                        if (var->hasNDArray() && var->isRemovable() && !var->isReadOnly()) {
+                            delete var->getNDArray();
+                            var->setNDArray(nullptr);
+                        }
+                    }
+                }
+        }
+
+        Nd4jStatus FrameExecutor::execute(Graph *graph, VariableSpace *variableSpace) {
+            auto flowPath = variableSpace->flowPath();
+            const auto limit = Environment::getInstance()->maxLoopIterations();
+            const int numVariables = (int) _merges.size();
+
+            // outputs left by previous execution may have different shapes
+            releaseOutputs(variableSpace, true);
+
+            for (auto enter: _enters) {
+                NDArray *array = nullptr;
+                for (auto &p: *enter->input())
+                    if ((array = fetchArray(variableSpace, p)) != nullptr)
+                        break;
+
+                if (array == nullptr)
+                    return Status::THROW("FrameExecutor: Enter node has no input");
+
+                bindArray(variableSpace, enter->id(), 0, array);
+            }
+
+            // values of loop variables, and arrays owned by frame: buffers carried from the previous iteration
+            std::vector<NDArray*> values(numVariables, nullptr);
+            std::vector<NDArray*> owned(numVariables, nullptr);
+            for (int e = 0; e < numVariables; e++) {
+                values[e] = fetchArray(variableSpace, _merges[e]->input()->at(0));
+                if (values[e] == nullptr)
+                    return Status::THROW("FrameExecutor: loop variable isn't initialized");
+            }
+
+            auto run = [&] (std::vector<Node*> &schedule) -> Nd4jStatus {
+                for (auto node: schedule) {
+                    auto status = GraphExecutioner::executeFlatNode(graph, node, variableSpace);
+                    if (status != Status::OK())
+                        return status;
+                }
+
+                return Status::OK();
+            };
+
+            // loop invariants are evaluated once, their outputs are read by every iteration
+            auto status = run(_invariant);
+            if (status != Status::OK())
+                return status;
+
+            std::vector<std::vector<Nd4jLong>> shapes(numVariables);
+            Nd4jLong iterations = 0;
+            while (true) {
+                // once shapes of loop variables change, outputs of previous iteration can't be reused
+                bool reshaped = false;
+                for (int e = 0; e < numVariables; e++) {
+                    auto shape = values[e]->getShapeAsVector();
+                    if (shape != shapes[e]) {
+                        reshaped = reshaped || iterations > 0;
+                        shapes[e] = shape;
+                    }
+                }
+
+                if (reshaped)
+                    releaseOutputs(variableSpace, false);
+
+                for (int e = 0; e < numVariables; e++)
+                    bindArray(variableSpace, _merges[e]->id(), 0, values[e]);
+
+                if ((status = run(_condition)) != Status::OK())
+                    break;
+
+                auto predicate = fetchArray(variableSpace, _loopCond->input()->at(0));
+                if (predicate == nullptr) {
+                    status = Status::THROW("FrameExecutor: loop condition wasn't evaluated");
+                    break;
+                }
+
+                bindArray(variableSpace, _loopCond->id(), 0, predicate);
+                if (!predicate->e<bool>(0))
+                    break;
+
+                if (limit > 0 && iterations >= limit) {
+                    nd4j_printf("Frame %lld exceeded limit of %lld iterations\n", _frameId, limit);
+                    status = Status::THROW("Loop iterations limit exceeded");
+                    break;
+                }
+
+                for (int e = 0; e < numVariables; e++) {
+                    bindArray(variableSpace, _switches[e]->id(), 1, values[e]);
+                    flowPath->markBranch(_switches[e]->id(), 1);
+                }
+
+                if ((status = run(_body)) != Status::OK())
+                    break;
+
+                for (int e = 0; e < numVariables; e++) {
+                    auto source = _nextIterations[e]->input()->at(0);
+                    auto next = fetchArray(variableSpace, source);
+                    if (next == nullptr) {
+                        status = Status::THROW("FrameExecutor: NextIteration has no input");
+                        break;
+                    }
+
+                    bindArray(variableSpace, _nextIterations[e]->id(), 0, next);
+
+                    // pass-through variable
+                    if (next == values[e])
+                        continue;
+
+                    auto var = variableSpace->getVariable(source);
+                    if (var->isRemovable() && !var->isReadOnly() && !next->isView()) {
+                        // op owns its output: frame takes it over, and gives previous buffer back to op, so it's reused on next iteration
+                        auto spare = owned[e];
+                        if (spare != nullptr && (!spare->isSameShape(next) || spare->dataType() != next->dataType())) {
+                            delete spare;
+                            spare = nullptr;
+                        }
+
+                        var->setNDArray(spare);
+                        owned[e] = next;
+                    } else {
+                        // output belongs to someone else, so it's copied into frame buffer
+                        if (owned[e] != nullptr && owned[e]->isSameShape(next) && owned[e]->dataType() == next->dataType()) {
+                            owned[e]->assign(next);
+                        } else {
+                            auto copy = next->dup(next->ordering());
+                            delete owned[e];
+                            owned[e] = copy;
+                        }
+                    }
+
+                    values[e] = owned[e];
+                }
+
+                if (status != Status::OK())
+                    break;
+
+                iterations++;
+            }
+
+            // Merge variables own frame buffers from now on, and release them on the next execution
+            for (int e = 0; e < numVariables; e++)
+                bindArray(variableSpace, _merges[e]->id(), 0, values[e], owned[e] != nullptr && values[e] == owned[e]);
+
+            if (status != Status::OK())
+                return status;
+
+            for (int e = 0; e < numVariables; e++) {
+                bindArray(variableSpace, _switches[e]->id(), 0, values[e]);
+                flowPath->markBranch(_switches[e]->id(), 0);
+            }
+
+            for (auto exit: _exits)
+                bindArray(variableSpace, exit->id(), 0, fetchArray(variableSpace, exit->input()->at(0)));
+
+            for (auto node: _nodes) {
+                flowPath->markNodeActive(node->id(), true);
+                flowPath->markExecuted(node->id(), true);
+            }
+
+            nd4j_debug("Frame %lld finished after %lld iterations\n", _frameId, iterations);
+
+            return Status::OK();
+        }
+
+        Nd4jLong FrameExecutor::frameId() {
+            return _frameId;
+        }
+
+        std::vector<Node*>* FrameExecutor::nodes() {
+            return &_nodes;
+        }
+
+        std::vector<Node*>* FrameExecutor::invariant() {
+            return &_invariant;
+        }
+    }
+}
@@ -34,6 +34,14 @@ namespace nd4j {
                     this->_inputs.push_back(v);
                 }
 
+                for (const auto &v: *(prototype->inputSlots())) {
+                    this->_inputSlots.push_back(v);
+                }
+
+                this->_shapeClass = prototype->shapeClass();
+                this->_knownOutputs = prototype->knownOutputs();
+                this->_knownInputs = prototype->knownInputs();
+
                 for (const auto &v: *(prototype->getTArguments())) {
                     this->_tArgs.push_back(v);
                 }
@@ -223,7 +231,13 @@ namespace nd4j {
 
             auto p = this->_inputs[idx];
 
-            auto v = variable(p);
+            // slot lookup is direct indexing, map lookup is used only if slots weren't assigned or variable isn't there yet
+            Variable* v = nullptr;
+            if (idx < this->_inputSlots.size() && _variableSpace != nullptr)
+                v = _variableSpace->getVariableBySlot(this->_inputSlots[idx], p);
+
+            if (v == nullptr)
+                v = variable(p);
 
             if (Environment::getInstance()->isDebugAndVerbose() && v != nullptr &&  v->getNDArray() != nullptr) {
                 auto array = v->getNDArray();
@@ -345,6 +359,32 @@ namespace nd4j {
             return false;
         }
 
+        bool Context::hasKnownShapes() {
+            if (_knownOutputs <= 0 || _shapeClass == 0 || _variableSpace == nullptr || _variableSpace->shapeClass() != _shapeClass)
+                return false;
+
+            for (int e = 0; e < _knownOutputs; e++)
+                if (!isValueAvailable(e))
+                    return false;
+
+            // cheap check of actual input shapes, on mismatch node goes through full validation, which rejects stale outputs
+            Nd4jLong inputShapes = 17;
+            for (int e = 0; e < (int) width(); e++) {
+                auto input = array(e);
+                if (input == nullptr)
+                    return false;
+
+                inputShapes = shapeHash(inputShapes, input->shapeInfo());
+            }
+
+            if (inputShapes != _knownInputs) {
+                nd4j_debug("Input shapes of node_%i don't match inferred ones\n", _nodeId);
+                return false;
+            }
+
+            return true;
+        }
+
         NDArray* Context::getNDArray(int idx) {
             return array(idx);
         }
@@ -22,6 +22,7 @@
 #include <dll.h>
 #include <types/float16.h>
 #include <graph/ContextPrototype.h>
+#include <helpers/shape.h>
 
 namespace nd4j {
     namespace graph {
@@ -52,6 +53,36 @@ namespace nd4j {
             return &_inputs;
         }
 
+        std::vector<int>* ContextPrototype::inputSlots() {
+            return &_inputSlots;
+        }
+
+        void ContextPrototype::setKnownShapes(Nd4jLong shapeClass, int numOutputs, Nd4jLong inputShapes) {
+            _shapeClass = shapeClass;
+            _knownOutputs = shapeClass == 0 ? 0 : numOutputs;
+            _knownInputs = shapeClass == 0 ? 0 : inputShapes;
+        }
+
+        Nd4jLong ContextPrototype::knownInputs() {
+            return _knownInputs;
+        }
+
+        Nd4jLong ContextPrototype::shapeHash(Nd4jLong hash, const Nd4jLong *shapeInfo) {
+            auto result = (uint64_t) hash;
+            for (int e = 0; e < shape::shapeInfoLength(shapeInfo); e++)
+                result = result * 31 + (uint64_t) shapeInfo[e];
+
+            return (Nd4jLong) result;
+        }
+
+        Nd4jLong ContextPrototype::shapeClass() {
+            return _shapeClass;
+        }
+
+        int ContextPrototype::knownOutputs() {
+            return _knownOutputs;
+        }
+
         void ContextPrototype::fillInputs(std::vector<int>& inputs) {
             for (int e = 0; e < inputs.size(); e++) {
                 auto v = inputs.at(e);
@@ -161,6 +192,13 @@ namespace nd4j {
             for (auto v: _inputs)
                 clone->_inputs.emplace_back(v);
 
+            for (auto v: _inputSlots)
+                clone->_inputSlots.emplace_back(v);
+
+            clone->_shapeClass = _shapeClass;
+            clone->_knownOutputs = _knownOutputs;
+            clone->_knownInputs = _knownInputs;
+
             for (auto v: _tArgs)
                 clone->_tArgs.emplace_back(v);
 
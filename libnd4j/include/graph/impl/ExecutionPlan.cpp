@@ -0,0 +1,377 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Serialization of built graph state, see ExecutionPlan.h for details
+//
+
+#include <graph/ExecutionPlan.h>
+#include <graph/Graph.h>
+#include <ops/declarable/OpRegistrator.h>
+#include <helpers/helper_hash.h>
+#include <Status.h>
+#include <cstring>
+#include <stdexcept>
+
+namespace nd4j {
+    namespace graph {
+
+        namespace {
+        // plain little-endian writer/reader, plans are meant to be loaded by the same build of libnd4j they were captured with
+        class PlanWriter {
+        private:
+            std::vector<int8_t> &_buffer;
+
+        public:
+            explicit PlanWriter(std::vector<int8_t> &buffer) : _buffer(buffer) { }
+
+            template <typename T>
+            void write(const T value) {
+                auto ptr = reinterpret_cast<const int8_t *>(&value);
+                _buffer.insert(_buffer.end(), ptr, ptr + sizeof(T));
+            }
+
+            template <typename T>
+            void writeVector(const std::vector<T> &values) {
+                write<Nd4jLong>(values.size());
+                for (auto v: values)
+                    write<T>(v);
+            }
+
+            void writeBytes(const void *bytes, Nd4jLong length) {
+                auto ptr = reinterpret_cast<const int8_t *>(bytes);
+                _buffer.insert(_buffer.end(), ptr, ptr + length);
+            }
+        };
+
+        class PlanReader {
+        private:
+            const int8_t *_ptr;
+            const int8_t *_end;
+
+        public:
+            PlanReader(const void *buffer, Nd4jLong length) {
+                _ptr = reinterpret_cast<const int8_t *>(buffer);
+                _end = _ptr + length;
+            }
+
+            void readBytes(void *bytes, Nd4jLong length) {
+                if (length < 0 || _end - _ptr < length)
+                    throw std::runtime_error("ExecutionPlan: unexpected end of buffer");
+
+                memcpy(bytes, _ptr, length);
+                _ptr += length;
+            }
+
+            template <typename T>
+            T read() {
+                T value;
+                readBytes(&value, sizeof(T));
+                return value;
+            }
+
+            Nd4jLong remaining() {
+                return _end - _ptr;
+            }
+
+            // vectors can't be longer than rest of the buffer, that protects us from allocating garbage lengths
+            Nd4jLong readLength(Nd4jLong elementSize) {
+                auto length = read<Nd4jLong>();
+                if (length < 0 || length * elementSize > _end - _ptr)
+                    throw std::runtime_error("ExecutionPlan: malformed buffer");
+
+                return length;
+            }
+
+            template <typename T>
+            std::vector<T> readVector() {
+                auto length = readLength(sizeof(T));
+                std::vector<T> result(length);
+                for (Nd4jLong e = 0; e < length; e++)
+                    result[e] = read<T>();
+
+                return result;
+            }
+        };
+        }
+
+        ExecutionPlan::~ExecutionPlan() {
+            for (auto &v: _constants)
+                delete v.second;
+        }
+
+        Nd4jLong ExecutionPlan::registryVersion() {
+            // list of custom ops includes their signatures, so any change in op set changes the version
+            std::string ops(nd4j::ops::OpRegistrator::getInstance()->getAllCustomOperations());
+            return nd4j::ops::HashHelper::getInstance()->getLongHash(ops);
+        }
+
+        bool ExecutionPlan::isCompatible() {
+            return _registryVersion == registryVersion();
+        }
+
+        Nd4jLong ExecutionPlan::graphFingerprint() {
+            return _graphFingerprint;
+        }
+
+        std::vector<int>* ExecutionPlan::removedNodes() {
+            return &_removed;
+        }
+
+        Nd4jLong ExecutionPlan::requiredMemory() {
+            return _requiredMemory;
+        }
+
+        std::vector<ExecutionPlan::NodePlan>* ExecutionPlan::nodes() {
+            return &_nodes;
+        }
+
+        std::vector<std::pair<int, int>>* ExecutionPlan::slots() {
+            return &_slots;
+        }
+
+        std::vector<std::pair<int, NDArray*>>* ExecutionPlan::constants() {
+            return &_constants;
+        }
+
+        ExecutionPlan* ExecutionPlan::fromGraph(Graph *graph, VariableSpace *state) {
+            if (graph->buildGraph() != nd4j::Status::OK())
+                throw std::runtime_error("ExecutionPlan: graph can't be built");
+
+            if (!graph->getMapped()->empty() && graph->getVariableSpace()->numberOfSlots() == 0)
+                throw std::runtime_error("ExecutionPlan: graph has no slots assigned");
+
+            auto space = graph->getVariableSpace();
+            if (state == nullptr)
+                state = space;
+
+            auto plan = new ExecutionPlan();
+            plan->_registryVersion = registryVersion();
+            plan->_graphFingerprint = graph->fingerprint();
+            plan->_removed = *graph->removedNodes();
+
+            for (auto &l: *graph->getOnion()) {
+                for (auto node: *l.second) {
+                    NodePlan np;
+                    np.id = node->id();
+                    np.layer = node->getLayer();
+
+                    if (node->opType() == OpType_CUSTOM && node->hasCustomOp())
+                        np.opHash = node->getCustomOp()->getOpDescriptor()->getHash();
+
+                    for (auto &p: *node->input())
+                        np.inputs.emplace_back(p);
+
+                    if (node->hasBlockAttached()) {
+                        auto block = node->getContextPrototype();
+                        np.inputSlots = *block->inputSlots();
+                        np.iArgs = *block->getIArguments();
+                        np.tArgs = *block->getTArguments();
+                        np.bArgs = *block->getBArguments();
+                    }
+
+                    for (int e = 0; state->hasVariable(np.id, e); e++) {
+                        auto var = state->getVariable(np.id, e);
+                        if (!var->hasNDArray() || var->hasNDArrayList())
+                            break;
+
+                        auto array = var->getNDArray();
+                        auto shapeInfo = array->shapeInfo();
+                        np.shapes.emplace_back(std::vector<Nd4jLong>(shapeInfo, shapeInfo + shape::shapeInfoLength(shapeInfo)));
+                        plan->_requiredMemory += array->lengthOf() * array->sizeOfT();
+                    }
+
+                    plan->_nodes.emplace_back(np);
+                }
+            }
+
+            for (int e = 0; e < space->numberOfSlots(); e++)
+                plan->_slots.emplace_back(space->slotPair(e));
+
+            for (auto id: *graph->derivedConstants()) {
+                if (!space->hasVariable(id) || !space->getVariable(id)->hasNDArray())
+                    continue;
+
+                auto array = space->getVariable(id)->getNDArray();
+                if (array->isS()) {
+                    delete plan;
+                    throw std::runtime_error("ExecutionPlan: string constants aren't supported");
+                }
+
+                plan->_constants.emplace_back(std::pair<int, NDArray*>(id, array->dup('c')));
+            }
+
+            return plan;
+        }
+
+        std::vector<int8_t> ExecutionPlan::asBuffer() {
+            std::vector<int8_t> buffer;
+            PlanWriter writer(buffer);
+
+            writer.write<int>(MAGIC);
+            writer.write<int>(VERSION);
+            writer.write<Nd4jLong>(_registryVersion);
+            writer.write<Nd4jLong>(_requiredMemory);
+            writer.write<Nd4jLong>(_graphFingerprint);
+            writer.writeVector<int>(_removed);
+
+            writer.write<Nd4jLong>(_nodes.size());
+            for (auto &np: _nodes) {
+                writer.write<int>(np.id);
+                writer.write<int>(np.layer);
+                writer.write<Nd4jLong>(np.opHash);
+
+                writer.write<Nd4jLong>(np.inputs.size());
+                for (auto &p: np.inputs) {
+                    writer.write<int>(p.first);
+                    writer.write<int>(p.second);
+                }
+
+                writer.writeVector<int>(np.inputSlots);
+                writer.writeVector<int>(np.iArgs);
+                writer.writeVector<double>(np.tArgs);
+
+                writer.write<Nd4jLong>(np.bArgs.size());
+                for (bool v: np.bArgs)
+                    writer.write<int8_t>(v ? 1 : 0);
+
+                writer.write<Nd4jLong>(np.shapes.size());
+                for (auto &s: np.shapes)
+                    writer.writeVector<Nd4jLong>(s);
+            }
+
+            writer.write<Nd4jLong>(_slots.size());
+            for (auto &p: _slots) {
+                writer.write<int>(p.first);
+                writer.write<int>(p.second);
+            }
+
+            // constants are stored as shapeInfo followed by raw c-ordered buffer
+            writer.write<Nd4jLong>(_constants.size());
+            for (auto &c: _constants) {
+                auto shapeInfo = c.second->shapeInfo();
+                writer.write<int>(c.first);
+                writer.writeVector<Nd4jLong>(std::vector<Nd4jLong>(shapeInfo, shapeInfo + shape::shapeInfoLength(shapeInfo)));
+                writer.write<Nd4jLong>(c.second->lengthOf() * c.second->sizeOfT());
+                writer.writeBytes(c.second->getBuffer(), c.second->lengthOf() * c.second->sizeOfT());
+            }
+
+            return buffer;
+        }
+
+        ExecutionPlan* ExecutionPlan::fromBuffer(const void *buffer, Nd4jLong length) {
+            PlanReader reader(buffer, length);
+
+            if (reader.read<int>() != MAGIC)
+                throw std::runtime_error("ExecutionPlan: buffer doesn't contain execution plan");
+
+            if (reader.read<int>() != VERSION)
+                throw std::runtime_error("ExecutionPlan: unsupported plan version");
+
+            auto plan = new ExecutionPlan();
+            try {
+                plan->_registryVersion = reader.read<Nd4jLong>();
+                plan->_requiredMemory = reader.read<Nd4jLong>();
+                plan->_graphFingerprint = reader.read<Nd4jLong>();
+                plan->_removed = reader.readVector<int>();
+
+                auto numNodes = reader.readLength(sizeof(int));
+                for (Nd4jLong e = 0; e < numNodes; e++) {
+                    NodePlan np;
+                    np.id = reader.read<int>();
+                    np.layer = reader.read<int>();
+                    np.opHash = reader.read<Nd4jLong>();
+
+                    auto numInputs = reader.readLength(2 * sizeof(int));
+                    for (Nd4jLong i = 0; i < numInputs; i++) {
+                        int first = reader.read<int>();
+                        int second = reader.read<int>();
+                        np.inputs.emplace_back(std::pair<int, int>(first, second));
+                    }
+
+                    np.inputSlots = reader.readVector<int>();
+                    np.iArgs = reader.readVector<int>();
+                    np.tArgs = reader.readVector<double>();
+
+                    auto numBArgs = reader.readLength(sizeof(int8_t));
+                    for (Nd4jLong i = 0; i < numBArgs; i++)
+                        np.bArgs.emplace_back(reader.read<int8_t>() != 0);
+
+                    auto numShapes = reader.readLength(sizeof(Nd4jLong));
+                    for (Nd4jLong i = 0; i < numShapes; i++)
+                        np.shapes.emplace_back(reader.readVector<Nd4jLong>());
+
+                    plan->_nodes.emplace_back(np);
+                }
+
+                auto numSlots = reader.readLength(2 * sizeof(int));
+                for (Nd4jLong e = 0; e < numSlots; e++) {
+                    int first = reader.read<int>();
+                    int second = reader.read<int>();
+                    plan->_slots.emplace_back(std::pair<int, int>(first, second));
+                }
+
+                auto numConstants = reader.readLength(sizeof(int));
+                for (Nd4jLong e = 0; e < numConstants; e++) {
+                    int id = reader.read<int>();
+                    auto shapeInfo = reader.readVector<Nd4jLong>();
+                    if (shapeInfo.empty() || shapeInfo[0] < 0 || shapeInfo[0] > MAX_RANK || (Nd4jLong) shapeInfo.size() != shape::shapeInfoLength((int) shapeInfo[0]))
+                        throw std::runtime_error("ExecutionPlan: malformed constant shape");
+
+                    // shape and size are validated against the rest of the buffer before anything is allocated
+                    Nd4jLong arrayLength = 1;
+                    for (int d = 1; d <= shapeInfo[0]; d++) {
+                        if (shapeInfo[d] < 0 || (shapeInfo[d] > 0 && arrayLength > reader.remaining() / shapeInfo[d]))
+                            throw std::runtime_error("ExecutionPlan: malformed constant shape");
+
+                        arrayLength *= shapeInfo[d];
+                    }
+
+                    // constants are always written in c order, so strides are checked as well
+                    const int rank = (int) shapeInfo[0];
+                    Nd4jLong stride = 1;
+                    for (int d = rank; d >= 1; d--) {
+                        if (shapeInfo[d] > 1 && shapeInfo[rank + d] != stride)
+                            throw std::runtime_error("ExecutionPlan: malformed constant shape");
+
+                        stride *= shapeInfo[d];
+                    }
+
+                    if (rank > 0 && shape::order(shapeInfo.data()) != 'c')
+                        throw std::runtime_error("ExecutionPlan: malformed constant shape");
+
+                    auto dtype = ArrayOptions::dataType(shapeInfo.data());
+                    if (dtype == nd4j::DataType::UTF8)
+                        throw std::runtime_error("ExecutionPlan: string constants aren't supported");
+
+                    auto bytes = reader.read<Nd4jLong>();
+                    if (bytes != arrayLength * (Nd4jLong) DataTypeUtils::sizeOfElement(dtype) || bytes > reader.remaining())
+                        throw std::runtime_error("ExecutionPlan: malformed constant buffer");
+
+                    auto array = new NDArray(shapeInfo.data(), true);
+                    plan->_constants.emplace_back(std::pair<int, NDArray*>(id, array));
+
+                    reader.readBytes(array->getBuffer(), bytes);
+                }
+            } catch (std::runtime_error &e) {
+                delete plan;
+                throw;
+            }
+
+            return plan;
+        }
+    }
+}
@@ -23,11 +23,23 @@
 namespace nd4j {
     namespace graph {
 
-        void FlowPath::ensureNode(int nodeId) {
-            if (_states.count(nodeId) == 0) {
+        NodeState& FlowPath::ensureNode(int nodeId) {
+            if (nodeId >= 0 && nodeId < MAX_FLAT_ID) {
+                if (nodeId >= (int) _states.size()) {
+                    _states.reserve(nodeId + 1);
+                    for (int e = _states.size(); e <= nodeId; e++)
+                        _states.emplace_back(NodeState(e));
+                }
+
+                return _states[nodeId];
+            }
+
+            if (_sparseStates.count(nodeId) == 0) {
                 NodeState state(nodeId);
-                _states[nodeId] = state;
+                _sparseStates[nodeId] = state;
             }
+
+            return _sparseStates[nodeId];
         }
 
         void FlowPath::ensureFrame(int frameId) {
@@ -38,51 +50,35 @@ namespace nd4j {
         }
 
         void FlowPath::setInnerTime(int nodeId, Nd4jLong time) {
-            ensureNode(nodeId);
-
-            _states[nodeId].setInnerTime(time);
+            ensureNode(nodeId).setInnerTime(time);
         }
 
         void FlowPath::setOuterTime(int nodeId, Nd4jLong time) {
-            ensureNode(nodeId);
-
-            _states[nodeId].setOuterTime(time);
+            ensureNode(nodeId).setOuterTime(time);
         }
 
         Nd4jLong FlowPath::innerTime(int nodeId) {
-            ensureNode(nodeId);
-
-            return _states[nodeId].innerTime();
+            return ensureNode(nodeId).innerTime();
         }
 
         Nd4jLong FlowPath::outerTime(int nodeId) {
-            ensureNode(nodeId);
-
-            return _states[nodeId].outerTime();
+            return ensureNode(nodeId).outerTime();
         }
 
         bool FlowPath::isNodeActive(int nodeId) {
-            ensureNode(nodeId);
-
-            return _states[nodeId].isActive();
+            return ensureNode(nodeId).isActive();
         }
             
         void FlowPath::markNodeActive(int nodeId, bool isActive) {
-            ensureNode(nodeId);
-
-            _states[nodeId].markActive(isActive);
+            ensureNode(nodeId).markActive(isActive);
         }
 
         int FlowPath::branch(int nodeId){
-            ensureNode(nodeId);
-
-            return _states[nodeId].branch();
+            return ensureNode(nodeId).branch();
         }
 
         void FlowPath::markBranch(int nodeId, int index) {
-            ensureNode(nodeId);
-
-            _states[nodeId].markBranch(index);
+            ensureNode(nodeId).markBranch(index);
         }
 
         bool FlowPath::isFrameActive(Nd4jLong frameId) {
@@ -131,17 +127,21 @@ namespace nd4j {
             _frames[frameId].incrementNumberOfCycles();
         }
 
+        void FlowPath::resetNumberOfCycles(Nd4jLong frameId) {
+            _frames[frameId].resetNumberOfCycles();
+        }
+
         Nd4jLong FlowPath::getNumberOfCycles(Nd4jLong frameId) {
             return _frames[frameId].getNumberOfCycles();
         }
 
 
         bool FlowPath::wasExecuted(int nodeId) {
-            return _states[nodeId].wasExecuted();
+            return ensureNode(nodeId).wasExecuted();
         }
 
         void FlowPath::markExecuted(int nodeId, bool wasExecuted) {
-            _states[nodeId].markExecuted(wasExecuted);
+            ensureNode(nodeId).markExecuted(wasExecuted);
         }
 
         GraphProfile* FlowPath::profile() {
@@ -35,6 +35,10 @@ namespace nd4j {
             ++_numberOfCycles;
         }
 
+        void FrameState::resetNumberOfCycles() {
+            _numberOfCycles = 0;
+        }
+
         bool FrameState::wasActivated() {
             return _activated;
         }
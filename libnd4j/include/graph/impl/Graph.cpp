@@ -23,12 +23,24 @@
 #include <graph/FlatUtils.h>
 #include <NativeOps.h>
 #include <vector>
+#include <tuple>
+#include <set>
+#include <unordered_map>
+#include <cstring>
+#include <graph/Context.h>
+#include <ops/declarable/DeclarableListOp.h>
+#include <graph/ExecutionPlan.h>
+#include <graph/execution/FrameExecutor.h>
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/OpRegistrator.h>
+#include <helpers/helper_hash.h>
 #include <graph/VariableProxy.h>
 #include <graph/exceptions/graph_exception.h>
 #include <graph/exceptions/unresolved_input_exception.h>
 #include <graph/exceptions/unresolved_output_exception.h>
+#include <ops/declarable/helpers/quantization.h>
+#include <NDArrayFactory.h>
+#include <Environment.h>
 
 namespace nd4j {
     namespace graph {
@@ -298,6 +310,8 @@ namespace nd4j {
             for (auto v: _scopes)
                 delete v;
 
+            forgetFrames();
+
             delete _mapped;
             delete _nodes;
             delete _variableSpace;
@@ -307,6 +321,7 @@ namespace nd4j {
 
         void Graph::addNode(Node *node) {
             _built.store(false);
+            forgetFrames();
 
             if (node->opType() == OpType_LOGIC) {
                 // nd4j_debug("Adding LogicOp [%i]\n", node->opNum());
@@ -511,12 +526,1315 @@ namespace nd4j {
             }
         }
 
+        int Graph::foldFakeQuantization() {
+            auto lookup = [&] (int id) -> Node* {
+                if (_mapped->count(id) > 0)
+                    return _mapped->at(id);
+
+                if (_unmapped.count(id) > 0)
+                    return _unmapped.at(id);
+
+                return nullptr;
+            };
+
+            auto isOp = [] (Node* node, const char* name) -> bool {
+                return node != nullptr && node->hasCustomOp() && *node->getCustomOp()->getOpName() == name;
+            };
+
+            // constants are external variables with arrays attached, placeholders are filled later, so they don't count
+            auto constantArray = [&] (std::pair<int, int>& p) -> NDArray* {
+                if (p.first >= 0 || !_variableSpace->hasVariable(p.first))
+                    return nullptr;
+
+                auto var = _variableSpace->getVariable(p.first);
+                if (var->isPlaceholder() || !var->hasNDArray())
+                    return nullptr;
+
+                return var->getNDArray();
+            };
+
+            // only fake-quant nodes with constant ranges and grids that fit into 8 bits can be folded
+            auto fakeQuantGrid = [&] (Node* node, float& scale, int& zeroPoint, int& quantMin, int& quantMax) -> bool {
+                if (!isOp(node, "fake_quant_with_min_max_vars") || node->input()->size() != 3 || !node->hasBlockAttached())
+                    return false;
+
+                auto min = constantArray(node->input()->at(1));
+                auto max = constantArray(node->input()->at(2));
+                if (min == nullptr || max == nullptr)
+                    return false;
+
+                auto iArgs = node->getContextPrototype()->getIArguments();
+                int numBits = iArgs->size() == 2 ? iArgs->at(0) : 8;
+                bool narrowed = iArgs->size() == 2 && iArgs->at(1) != 0;
+                if (numBits < 2 || numBits > 8)
+                    return false;
+
+                ops::helpers::nudgeQuantizationRange(min->e<float>(0), max->e<float>(0), numBits, narrowed, scale, zeroPoint, quantMin, quantMax);
+                return scale > 0.f;
+            };
+
+            std::map<int, int> consumers;
+            for (auto node: _handles)
+                for (auto &p: *node->input())
+                    if (p.first > 0)
+                        consumers[p.first]++;
+
+            int nextId = -1;
+            for (auto var: _variableSpace->getVariables())
+                if (var->id() <= nextId)
+                    nextId = var->id() - 1;
+
+            auto putConstant = [&] (NDArray* array) -> int {
+                auto var = new Variable(array, nullptr, nextId, 0);
+                var->markExternal(true);
+                var->markConstant(true);
+                _variableSpace->putVariable(nextId, var);
+                _derivedConstants.emplace_back(nextId);
+                return nextId--;
+            };
+
+            std::vector<Node*> candidates;
+            for (auto &v: _unmapped)
+                candidates.emplace_back(v.second);
+            for (auto &v: *_mapped)
+                candidates.emplace_back(v.second);
+
+            std::vector<Node*> folded;
+            int cnt = 0;
+            for (auto node: candidates) {
+                const bool isMatmul = isOp(node, "matmul");
+                const bool isConv = isOp(node, "conv2d");
+                if ((!isMatmul && !isConv) || !node->hasBlockAttached())
+                    continue;
+
+                auto inputs = node->input();
+                auto block = node->getContextPrototype();
+                auto iArgs = block->getIArguments();
+
+                if (isMatmul) {
+                    // transposed operands are left as is
+                    if (inputs->size() != 2 || std::any_of(iArgs->begin(), iArgs->end(), [] (int v) { return v != 0; }))
+                        continue;
+                } else if ((inputs->size() != 2 && inputs->size() != 3) || iArgs->size() < 9 || iArgs->size() > 10)
+                    continue;
+
+                if (inputs->at(0).first <= 0 || inputs->at(1).first <= 0 || inputs->at(0).second != 0 || inputs->at(1).second != 0)
+                    continue;
+
+                auto fqX = lookup(inputs->at(0).first);
+                auto fqW = lookup(inputs->at(1).first);
+
+                float xScale, wScale;
+                int xZeroPoint, xMin, xMax, wZeroPoint, wMin, wMax;
+                if (!fakeQuantGrid(fqX, xScale, xZeroPoint, xMin, xMax) || !fakeQuantGrid(fqW, wScale, wZeroPoint, wMin, wMax))
+                    continue;
+
+                auto weights = constantArray(fqW->input()->at(0));
+                if (weights == nullptr || !weights->isR() || (isConv && weights->rankOf() != 4) || (isMatmul && weights->rankOf() != 2))
+                    continue;
+
+                // weights are stored as INT8 with offset 128, so zero point is shifted the same way
+                auto quantized = new NDArray(weights->ordering(), weights->getShapeAsVector(), nd4j::DataType::INT8, weights->getWorkspace());
+                ops::helpers::quantize(*weights, wScale, wZeroPoint, wMin, wMax, *quantized);
+
+                std::vector<std::pair<int, int>> newInputs;
+                newInputs.emplace_back(fqX->input()->at(0));
+                newInputs.emplace_back(std::pair<int, int>(putConstant(quantized), 0));
+                newInputs.emplace_back(std::pair<int, int>(putConstant(NDArrayFactory::create_<float>(wScale)), 0));
+                newInputs.emplace_back(std::pair<int, int>(putConstant(NDArrayFactory::create_<int>(wZeroPoint - 128)), 0));
+                if (isConv && inputs->size() == 3)
+                    newInputs.emplace_back(inputs->at(2));
+
+                auto op = nd4j::ops::OpRegistrator::getInstance()->getOperation(isMatmul ? "qmatmul" : "qconv2d");
+                node->setCustomOp(op);
+                block->setOpDescriptor(op->getOpDescriptor());
+
+                inputs->clear();
+                block->inputs()->clear();
+                for (auto &p: newInputs) {
+                    node->pickInput(p);
+                    block->pickInput(p);
+                }
+
+                if (isMatmul)
+                    iArgs->clear();
+                else if (iArgs->size() == 9)
+                    iArgs->emplace_back(0);
+
+                iArgs->emplace_back(0);
+                iArgs->emplace_back(xMin);
+                iArgs->emplace_back(xMax);
+
+                block->getTArguments()->clear();
+                block->getTArguments()->emplace_back(xScale);
+                block->getTArguments()->emplace_back(xZeroPoint);
+
+                for (auto fq: {fqX, fqW})
+                    if (--consumers[fq->id()] == 0 && std::find(folded.begin(), folded.end(), fq) == folded.end())
+                        folded.emplace_back(fq);
+
+                nd4j_debug("Folded fake quantization into node_%i\n", node->id());
+                cnt++;
+            }
+
+            // fake-quant nodes without consumers left aren't needed anymore, unless they were explicitly requested as outputs
+            for (auto fq: folded) {
+                if (consumers[fq->id()] != 0 || std::find(_output.begin(), _output.end(), fq->id()) != _output.end())
+                    continue;
+
+                eraseNode(fq);
+            }
+
+            return cnt;
+        }
+
+        void Graph::forgetFrames() {
+            for (auto &v: _frameExecutors)
+                delete v.second;
+
+            _frameExecutors.clear();
+        }
+
+        FrameExecutor* Graph::frameExecutor(Nd4jLong frameId) {
+            if (_frameExecutors.count(frameId) == 0)
+                _frameExecutors[frameId] = FrameExecutor::compile(this, frameId);
+
+            return _frameExecutors[frameId];
+        }
+
+        void Graph::eraseNode(Node *node) {
+            forgetFrames();
+
+            const int id = node->id();
+            if (_unmapped.count(id) > 0) {
+                _unmapped.erase(id);
+                _unmappedMap.erase(std::remove(_unmappedMap.begin(), _unmappedMap.end(), id), _unmappedMap.end());
+            } else {
+                _mapped->erase(id);
+                if (_onion->count(node->getLayer()) > 0) {
+                    auto layer = _onion->at(node->getLayer());
+                    layer->erase(std::remove(layer->begin(), layer->end(), node), layer->end());
+                }
+            }
+
+            _nodes->erase(std::remove(_nodes->begin(), _nodes->end(), id), _nodes->end());
+            _autos.erase(std::remove(_autos.begin(), _autos.end(), id), _autos.end());
+            _handles.erase(std::remove(_handles.begin(), _handles.end(), node), _handles.end());
+            _removedNodes.emplace_back(id);
+
+            delete node;
+        }
+
+        void Graph::relayerNodes() {
+            std::map<int, int> layers;
+            std::vector<Node*> pending;
+            for (auto &v: *_mapped)
+                pending.emplace_back(v.second);
+
+            while (!pending.empty()) {
+                std::vector<Node*> blocked;
+                for (auto node: pending) {
+                    int layer = 0;
+                    bool resolved = true;
+                    for (auto &in: *node->input()) {
+                        if (_mapped->count(in.first) == 0)
+                            continue;
+
+                        if (layers.count(in.first) == 0) {
+                            resolved = false;
+                            break;
+                        }
+
+                        layer = nd4j::math::nd4j_max<int>(layer, layers[in.first] + 1);
+                    }
+
+                    if (resolved)
+                        layers[node->id()] = layer;
+                    else
+                        blocked.emplace_back(node);
+                }
+
+                if (blocked.size() == pending.size())
+                    throw graph::graph_exception("Graph can't be split into layers");
+
+                pending = blocked;
+            }
+
+            for (auto &v: *_onion)
+                delete v.second;
+            _onion->clear();
+
+            for (auto &v: *_mapped) {
+                auto node = v.second;
+                node->setLayer(layers[node->id()]);
+                expandOnion(node->getLayer());
+                _onion->at(node->getLayer())->push_back(node);
+            }
+        }
+
+        void Graph::assignSlots() {
+            for (auto v: *_nodes) {
+                if (_mapped->count(v) == 0)
+                    continue;
+
+                auto node = _mapped->at(v);
+                std::pair<int, int> output(node->id(), 0);
+                _variableSpace->registerSlot(output);
+
+                if (!node->hasBlockAttached())
+                    continue;
+
+                auto block = node->getContextPrototype();
+                block->inputSlots()->clear();
+                for (auto &in: *block->inputs())
+                    block->inputSlots()->emplace_back(_variableSpace->registerSlot(in));
+            }
+        }
+
+        bool Graph::applyPlan(ExecutionPlan *plan) {
+            if (!plan->isCompatible()) {
+                nd4j_printf("Execution plan was built against different set of ops, graph will be built from scratch\n", "");
+                return false;
+            }
+
+            if (plan->graphFingerprint() != _fingerprint) {
+                nd4j_printf("Execution plan was built for different graph, graph will be built from scratch\n", "");
+                return false;
+            }
+
+            // plan is validated before anything is changed, so on mismatch graph is still built the usual way
+            std::set<int> planned;
+            for (auto &np: *plan->nodes()) {
+                if (_unmapped.count(np.id) == 0 || planned.count(np.id) > 0 || np.layer < 0)
+                    return false;
+
+                if (np.opHash != 0L && nd4j::ops::OpRegistrator::getInstance()->getOperation(np.opHash) == nullptr)
+                    return false;
+
+                planned.insert(np.id);
+            }
+
+            // every node of the graph must be either planned or explicitly removed by the plan
+            std::set<int> removedIds(plan->removedNodes()->begin(), plan->removedNodes()->end());
+            for (auto &v: _unmapped)
+                if (planned.count(v.first) == 0 && removedIds.count(v.first) == 0)
+                    return false;
+
+            std::set<int> constants;
+            for (auto &c: *plan->constants()) {
+                if (_variableSpace->hasVariable(c.first))
+                    return false;
+
+                constants.insert(c.first);
+            }
+
+            for (auto &np: *plan->nodes())
+                for (auto &p: np.inputs)
+                    if (planned.count(p.first) == 0 && constants.count(p.first) == 0 && !_variableSpace->hasVariable(p.first))
+                        return false;
+
+            for (auto &c: *plan->constants()) {
+                auto var = new Variable(c.second->dup(c.second->ordering()), nullptr, c.first, 0);
+                var->markExternal(true);
+                var->markConstant(true);
+                _variableSpace->putVariable(c.first, var);
+                _derivedConstants.emplace_back(c.first);
+            }
+
+            // nodes removed by graph passes aren't needed
+            std::vector<Node*> removed;
+            for (auto id: *plan->removedNodes())
+                if (_unmapped.count(id) > 0 && planned.count(id) == 0)
+                    removed.emplace_back(_unmapped.at(id));
+
+            for (auto node: removed)
+                eraseNode(node);
+
+            for (auto &np: *plan->nodes()) {
+                auto node = _unmapped.at(np.id);
+
+                if (np.opHash != 0L && (!node->hasCustomOp() || node->getCustomOp()->getOpDescriptor()->getHash() != np.opHash)) {
+                    auto op = nd4j::ops::OpRegistrator::getInstance()->getOperation(np.opHash);
+                    node->setCustomOp(op);
+                    if (node->hasBlockAttached())
+                        node->getContextPrototype()->setOpDescriptor(op->getOpDescriptor());
+                }
+
+                node->input()->clear();
+                for (auto p: np.inputs)
+                    node->pickInput(p);
+
+                if (node->hasBlockAttached()) {
+                    auto block = node->getContextPrototype();
+                    block->inputs()->clear();
+                    for (auto p: np.inputs)
+                        block->pickInput(p);
+
+                    *block->getIArguments() = np.iArgs;
+                    *block->getTArguments() = np.tArgs;
+                    *block->getBArguments() = np.bArgs;
+                }
+
+                node->setLayer(np.layer);
+                expandOnion(np.layer);
+                addNode(node);
+                injectNode(node);
+                _unmapped.erase(np.id);
+            }
+
+            _unmappedMap.clear();
+
+            // slots are registered in the same order, so stored input slots stay valid
+            for (auto p: *plan->slots())
+                _variableSpace->registerSlot(p);
+
+            for (auto &np: *plan->nodes()) {
+                auto node = _mapped->at(np.id);
+                if (node->hasBlockAttached())
+                    *node->getContextPrototype()->inputSlots() = np.inputSlots;
+            }
+
+            if (_configuration->_footprintForward == 0 && plan->requiredMemory() > 0) {
+                _configuration->_footprintForward = plan->requiredMemory();
+                _variableSpace->workspace()->expandBy(plan->requiredMemory());
+            }
+
+            _built = true;
+
+            return true;
+        }
+
+        int Graph::optimizeLayouts() {
+            // in VARIABLE_SPACE mode every intermediate result is exposed, control flow brings frames and back edges - both are left as is
+            if (_configuration->_outputMode == OutputMode_VARIABLE_SPACE || !_unmapped.empty() || !_scopes.empty())
+                return 0;
+
+            for (auto &v: *_mapped)
+                if (v.second->opType() == OpType_LOGIC)
+                    return 0;
+
+            auto isOp = [] (Node* node, const char* name) -> bool {
+                return node != nullptr && node->hasCustomOp() && *node->getCustomOp()->getOpName() == name;
+            };
+
+            auto isPermutation = [&] (Node* node) -> bool {
+                return (isOp(node, "permute") || isOp(node, "transpose")) && node->hasBlockAttached() && !node->input()->empty() && node->input()->size() <= 2;
+            };
+
+            // consumers of each node, collected again after every rewrite
+            std::map<int, std::vector<Node*>> consumers;
+
+            // final nodes and explicit outputs are visible outside of graph, so their content must stay intact
+            auto isPinned = [&] (Node* node) -> bool {
+                return node->hasExternalOutputs() || consumers[node->id()].empty() || std::find(_output.begin(), _output.end(), node->id()) != _output.end();
+            };
+
+            auto constantArray = [&] (std::pair<int, int>& p) -> NDArray* {
+                if (p.first >= 0 || !_variableSpace->hasVariable(p.first))
+                    return nullptr;
+
+                auto var = _variableSpace->getVariable(p.first);
+                if (var->isPlaceholder() || !var->hasNDArray())
+                    return nullptr;
+
+                return var->getNDArray();
+            };
+
+            // permutation applied by permute/transpose node, empty vector stands for reversed order of dimensions of unknown rank
+            auto permutationOf = [&] (Node* node, std::vector<int>& perm) -> bool {
+                auto inputs = node->input();
+                auto iArgs = node->getContextPrototype()->getIArguments();
+                perm.clear();
+
+                if (inputs->size() == 1) {
+                    // transpose with single input always reverses dimensions
+                    if (isOp(node, "permute"))
+                        perm = *iArgs;
+                    return true;
+                }
+
+                if (!iArgs->empty()) {
+                    perm = *iArgs;
+                    return true;
+                }
+
+                auto axis = constantArray(inputs->at(1));
+                if (axis == nullptr)
+                    return false;
+
+                for (Nd4jLong e = 0; e < axis->lengthOf(); e++) {
+                    int ax = axis->e<int>(e);
+                    perm.emplace_back(ax < 0 ? ax + (int) axis->lengthOf() : ax);
+                }
+                return true;
+            };
+
+            auto isIdentity = [] (const std::vector<int>& perm) -> bool {
+                if (perm.empty())
+                    return false;
+
+                for (int e = 0; e < (int) perm.size(); e++)
+                    if (perm[e] != e)
+                        return false;
+
+                return true;
+            };
+
+            // permutation r equal to p followed by q: -1 if it can't be evaluated, 0 if it's identity, 1 otherwise
+            auto compose = [&] (const std::vector<int>& p, const std::vector<int>& q, std::vector<int>& r) -> int {
+                r.clear();
+
+                // reversed twice, rank doesn't matter
+                if (p.empty() && q.empty())
+                    return 0;
+
+                auto reversed = [] (int rank) -> std::vector<int> {
+                    std::vector<int> v(rank);
+                    for (int e = 0; e < rank; e++)
+                        v[e] = rank - 1 - e;
+                    return v;
+                };
+
+                auto a = p.empty() ? reversed(q.size()) : p;
+                auto b = q.empty() ? reversed(p.size()) : q;
+                if (a.size() != b.size())
+                    return -1;
+
+                for (auto ax: b) {
+                    if (ax < 0 || ax >= (int) a.size())
+                        return -1;
+                    r.emplace_back(a[ax]);
+                }
+
+                return isIdentity(r) ? 0 : 1;
+            };
+
+            // ops that commute with any permutation: single-input elementwise transforms
+            // legacy transforms that are applied to each element independently. Histogram, Pooling2D, Col2Im, Im2col, Reverse,
+            // IsMax and SoftMax family depend on shape or dimensions, so they aren't listed
+            static const std::set<int> pointwiseFloat = {1, 3};
+            static const std::set<int> pointwiseSame = {0, 1, 2, 3, 4, 5, 6, 7, 11, 12, 13, 15, 17, 18, 19, 21};
+            static const std::set<int> pointwiseBool = {1, 2, 3, 4, 5, 6, 7};
+            static const std::set<int> pointwiseStrict = [] {
+                // everything after SoftMax, SoftMaxDerivative and LogSoftMax
+                std::set<int> ops;
+                for (int e = 3; e <= 56; e++)
+                    ops.insert(e);
+
+                return ops;
+            }();
+
+            auto isElementwise = [&] (Node* node) -> bool {
+                if (node->input()->size() != 1)
+                    return false;
+
+                const int opNum = (int) node->opNum();
+                switch (node->opType()) {
+                    case OpType_SCALAR:
+                    case OpType_SCALAR_BOOL:
+                        return node->getDimensions()->empty();
+                    case OpType_TRANSFORM_FLOAT:
+                        return node->getDimensions()->empty() && pointwiseFloat.count(opNum) > 0;
+                    case OpType_TRANSFORM_SAME:
+                        return node->getDimensions()->empty() && pointwiseSame.count(opNum) > 0;
+                    case OpType_TRANSFORM_BOOL:
+                        return node->getDimensions()->empty() && pointwiseBool.count(opNum) > 0;
+                    case OpType_TRANSFORM_STRICT:
+                        return node->getDimensions()->empty() && pointwiseStrict.count(opNum) > 0;
+                    case OpType_CUSTOM: {
+                        static const std::vector<std::string> names = {"identity", "relu", "relu6", "lrelu", "elu", "selu", "sigmoid", "tanh", "softplus", "softsign",
+                                                                       "cube", "hardsigmoid", "hardtanh", "rationaltanh", "rectifiedtanh", "thresholdedrelu"};
+                        return node->hasCustomOp() && std::find(names.begin(), names.end(), *node->getCustomOp()->getOpName()) != names.end();
+                    }
+                    default:
+                        return false;
+                }
+            };
+
+            // ops accepting both channels-first and channels-last input: op name, index of dataFormat iArg, rank of input
+            static const std::vector<std::tuple<std::string, int, int>> layoutAware = {
+                    std::make_tuple("conv2d", 9, 4), std::make_tuple("depthwise_conv2d", 9, 4),
+                    std::make_tuple("maxpool2d", 10, 4), std::make_tuple("avgpool2d", 10, 4), std::make_tuple("pnormpool2d", 10, 4),
+                    std::make_tuple("conv3dnew", 13, 5), std::make_tuple("maxpool3dnew", 14, 5), std::make_tuple("avgpool3dnew", 14, 5)};
+
+            // returns index of dataFormat iArg if node fed with given permutation can consume permute input directly, -1 otherwise
+            // [bS, C, ...] -> [bS, ..., C] into channels-last op equals channels-first op followed by the same permutation, and vice versa
+            auto flippableFormat = [&] (Node* node, const std::vector<int>& perm) -> int {
+                if (!node->hasCustomOp() || !node->hasBlockAttached())
+                    return -1;
+
+                for (auto &entry: layoutAware) {
+                    if (*node->getCustomOp()->getOpName() != std::get<0>(entry))
+                        continue;
+
+                    const int idx = std::get<1>(entry);
+                    const int rank = std::get<2>(entry);
+                    auto iArgs = node->getContextPrototype()->getIArguments();
+                    if ((int) perm.size() != rank || (int) iArgs->size() < idx)
+                        return -1;
+
+                    std::vector<int> toLast = {0}, toFirst = {0, rank - 1};
+                    for (int e = 2; e < rank; e++)
+                        toLast.emplace_back(e);
+                    toLast.emplace_back(1);
+                    for (int e = 1; e < rank - 1; e++)
+                        toFirst.emplace_back(e);
+
+                    const int dataFormat = (int) iArgs->size() > idx ? iArgs->at(idx) : 0;
+                    if ((perm == toLast && dataFormat == 1) || (perm == toFirst && dataFormat == 0))
+                        return idx;
+
+                    return -1;
+                }
+
+                return -1;
+            };
+
+            auto setInput = [&] (Node* node, int index, std::pair<int, int> input) {
+                node->input()->at(index) = input;
+                if (node->hasBlockAttached() && (int) node->getContextPrototype()->inputs()->size() > index)
+                    node->getContextPrototype()->inputs()->at(index) = input;
+            };
+
+            auto rewire = [&] (std::pair<int, int> from, std::pair<int, int> to) {
+                for (auto &v: *_mapped)
+                    for (int e = 0; e < (int) v.second->input()->size(); e++)
+                        if (v.second->input()->at(e) == from)
+                            setInput(v.second, e, to);
+            };
+
+            auto setPermutation = [&] (Node* node, const std::vector<int>& perm) {
+                auto block = node->getContextPrototype();
+                if (!isOp(node, "permute")) {
+                    auto op = nd4j::ops::OpRegistrator::getInstance()->getOperation("permute");
+                    node->setCustomOp(op);
+                    block->setOpDescriptor(op->getOpDescriptor());
+                }
+
+                node->input()->resize(1);
+                block->inputs()->resize(1);
+                *block->getIArguments() = perm;
+            };
+
+            // permute would have copied tensor it was fed with, so that tensor is saved to report size of avoided copy
+            auto eliminate = [&] (Node* node, std::pair<int, int> witness) {
+                _eliminatedPermutes.emplace_back(witness);
+                nd4j_debug("Eliminated permute node_%i\n", node->id());
+                eraseNode(node);
+            };
+
+            // single pass over nodes applies first possible rewrite, then consumers are collected again
+            const int before = (int) _eliminatedPermutes.size();
+            bool changed = true;
+            bool rewired = false;
+            while (changed) {
+                changed = false;
+
+                consumers.clear();
+                for (auto &v: *_mapped)
+                    for (auto &in: *v.second->input())
+                        if (_mapped->count(in.first) > 0 && (consumers[in.first].empty() || consumers[in.first].back() != v.second))
+                            consumers[in.first].emplace_back(v.second);
+
+                for (auto &v: *_mapped) {
+                    auto node = v.second;
+                    std::vector<int> perm;
+                    if (!isPermutation(node) || !permutationOf(node, perm))
+                        continue;
+
+                    const auto source = node->input()->at(0);
+                    const std::pair<int, int> result(node->id(), 0);
+                    auto &users = consumers[node->id()];
+
+                    // 1) identity permutation is just a copy
+                    if (isIdentity(perm) && !isPinned(node)) {
+                        rewire(result, source);
+                        eliminate(node, source);
+                        changed = true;
+                        break;
+                    }
+
+                    // 2) permutes consuming this one are composed with it, and cancelled if composition is identity
+                    bool composed = false;
+                    for (auto user: users) {
+                        std::vector<int> next, merged;
+                        if (!isPermutation(user) || user->input()->at(0) != result || !permutationOf(user, next))
+                            continue;
+
+                        const int kind = compose(perm, next, merged);
+                        if (kind < 0 || (kind == 0 && merged.empty() && isPinned(user)))
+                            continue;
+
+                        if (kind == 0 && !isPinned(user)) {
+                            rewire(std::pair<int, int>(user->id(), 0), source);
+                            eliminate(user, source);
+                        } else {
+                            setInput(user, 0, source);
+                            setPermutation(user, merged);
+                        }
+
+                        composed = true;
+                    }
+
+                    if (composed) {
+                        bool used = false;
+                        for (auto &u: *_mapped)
+                            for (auto &in: *u.second->input())
+                                used |= in == result;
+
+                        if (!used && !isPinned(node))
+                            eliminate(node, source);
+
+                        changed = true;
+                        break;
+                    }
+
+                    // 3) permute is moved down through chain of elementwise/layout-aware ops, if chain ends with another permute
+                    if (users.size() != 1 || isPinned(node))
+                        continue;
+
+                    std::vector<Node*> chain;
+                    auto current = users[0];
+                    auto input = result;
+                    bool reachable = false;
+                    while (true) {
+                        if (isPermutation(current) && current->input()->at(0) == input) {
+                            reachable = !chain.empty();
+                            break;
+                        }
+
+                        const bool elementwise = isElementwise(current);
+                        if ((!elementwise && flippableFormat(current, perm) < 0) || current->input()->at(0) != input || isPinned(current))
+                            break;
+
+                        // the only link to the rest of chain must be the first input
+                        bool single = true;
+                        for (int e = 1; e < (int) current->input()->size(); e++)
+                            single &= current->input()->at(e).first != input.first;
+
+                        auto &next = consumers[current->id()];
+                        if (!single || next.size() != 1)
+                            break;
+
+                        chain.emplace_back(current);
+                        input = std::pair<int, int>(current->id(), 0);
+                        current = next[0];
+                    }
+
+                    if (!reachable)
+                        continue;
+
+                    for (auto link: chain) {
+                        const std::pair<int, int> linkResult(link->id(), 0);
+
+                        // node <- link becomes link <- node
+                        rewire(linkResult, result);
+                        setInput(link, 0, node->input()->at(0));
+                        setInput(node, 0, linkResult);
+
+                        const int idx = flippableFormat(link, perm);
+                        if (!isElementwise(link) && idx >= 0) {
+                            auto iArgs = link->getContextPrototype()->getIArguments();
+                            if ((int) iArgs->size() == idx)
+                                iArgs->emplace_back(0);
+                            iArgs->at(idx) = iArgs->at(idx) == 0 ? 1 : 0;
+                        }
+
+                        nd4j_debug("Moved permute node_%i past node_%i\n", node->id(), link->id());
+                    }
+
+                    changed = true;
+                    break;
+                }
+
+                rewired |= changed;
+            }
+
+            // permutes moved past other nodes change layers too, even if nothing was eliminated
+            const int cnt = (int) _eliminatedPermutes.size() - before;
+            if (rewired)
+                relayerNodes();
+
+            return cnt;
+        }
+
+        // ops with random or otherwise non-reproducible results must be evaluated on every run,
+        // and ops writing into their inputs (in-place nodes, scatter_*, assign, list ops) have side effects two identical nodes don't share
+        bool Graph::isDeterministic(Node* node) {
+            if (!node->hasCustomOp() || !node->hasBlockAttached() || node->hasGraphEmbedded() || node->getContextPrototype()->isInplace())
+                return false;
+
+            auto opType = node->opType();
+            if (opType == OpType_RANDOM || opType == OpType_LOGIC || opType == OpType_GRAPH || opType == OpType_BOOLEAN)
+                return false;
+
+            auto name = *node->getCustomOp()->getOpName();
+            if (name.find("random") != std::string::npos || name.find("dropout") != std::string::npos)
+                return false;
+
+            const bool listOp = name.size() > 5 && name.compare(name.size() - 5, 5, "_list") == 0;
+            return name.compare(0, 7, "scatter") != 0 && name != "assign" && !listOp;
+        }
+
+        int Graph::simplify() {
+            if (_configuration->_outputMode == OutputMode_VARIABLE_SPACE || !_unmapped.empty() || !_scopes.empty())
+                return 0;
+
+            for (auto &v: *_mapped)
+                if (v.second->opType() == OpType_LOGIC)
+                    return 0;
+
+            const int before = (int) _mapped->size();
+
+            auto isOp = [] (Node* node, const char* name) -> bool {
+                return node != nullptr && node->hasCustomOp() && *node->getCustomOp()->getOpName() == name;
+            };
+
+            std::map<int, int> consumers;
+            for (auto node: _handles)
+                for (auto &p: *node->input())
+                    if (p.first > 0)
+                        consumers[p.first]++;
+
+            // results of these nodes are visible outside of graph, so they can't be replaced
+            auto isPinned = [&] (Node* node) -> bool {
+                return node->hasExternalOutputs() || consumers[node->id()] == 0 || std::find(_output.begin(), _output.end(), node->id()) != _output.end();
+            };
+
+            auto constantArray = [&] (std::pair<int, int>& p) -> NDArray* {
+                if (p.first >= 0 || !_variableSpace->hasVariable(p))
+                    return nullptr;
+
+                auto var = _variableSpace->getVariable(p);
+                if (!var->isConstant() || var->isPlaceholder() || !var->hasNDArray())
+                    return nullptr;
+
+                return var->getNDArray();
+            };
+
+            // multiplication by one is a copy only if it neither promotes data type nor broadcasts source to bigger rank,
+            // so source must be variable with known array
+            auto isNeutralOne = [&] (std::pair<int, int>& one, std::pair<int, int>& source) -> bool {
+                auto array = constantArray(one);
+                if (array == nullptr || !array->isScalar() || array->e<double>(0) != 1.0)
+                    return false;
+
+                if (source.first >= 0 || !_variableSpace->hasVariable(source) || !_variableSpace->getVariable(source)->hasNDArray())
+                    return false;
+
+                auto sourceArray = _variableSpace->getVariable(source)->getNDArray();
+                return sourceArray->dataType() == array->dataType() && sourceArray->rankOf() >= array->rankOf();
+            };
+
+            // source of identity-like node: identity op itself, or multiplication by scalar one
+            auto identitySource = [&] (Node* node, std::pair<int, int>& source) -> bool {
+                auto inputs = node->input();
+                if (isOp(node, "identity") && inputs->size() == 1) {
+                    source = inputs->at(0);
+                    return true;
+                }
+
+                if (isOp(node, "multiply") && inputs->size() == 2) {
+                    for (int e = 0; e < 2; e++)
+                        if (isNeutralOne(inputs->at(e), inputs->at(1 - e))) {
+                            source = inputs->at(1 - e);
+                            return true;
+                        }
+                }
+
+                return false;
+            };
+
+            // order used by reshape node, 0 if it can't be told at build time
+            auto reshapeOrder = [&] (Node* node) -> char {
+                if (!isOp(node, "reshape") || !node->hasBlockAttached() || node->input()->empty())
+                    return 0;
+
+                auto iArgs = node->getContextPrototype()->getIArguments();
+                if (iArgs->empty() || (node->input()->size() == 1 && iArgs->at(0) >= 0))
+                    return 'c';
+
+                return iArgs->at(0) < 0 ? (char) -iArgs->at(0) : 0;
+            };
+
+            auto replaceInput = [&] (Node* node, int index, std::pair<int, int> source) {
+                auto &p = node->input()->at(index);
+                if (p.first > 0)
+                    consumers[p.first]--;
+
+                if (source.first > 0)
+                    consumers[source.first]++;
+
+                p = source;
+                node->getContextPrototype()->inputs()->at(index) = source;
+            };
+
+            // all references to outputs of node are moved to another node or variable
+            auto redirect = [&] (int id, std::pair<int, int> target, bool keepIndex) {
+                for (auto consumer: _handles) {
+                    if (!consumer->hasBlockAttached())
+                        continue;
+
+                    for (int e = 0; e < (int) consumer->input()->size(); e++) {
+                        auto p = consumer->input()->at(e);
+                        if (p.first == id)
+                            replaceInput(consumer, e, keepIndex ? std::pair<int, int>(target.first, p.second) : target);
+                    }
+                }
+            };
+
+            // node is identified by op, inputs and all arguments stored in its ContextPrototype
+            auto keyOf = [&] (Node* node) -> std::string {
+                auto block = node->getContextPrototype();
+                std::string key = std::to_string((int) node->opType()) + ':' + std::to_string(node->opNum()) + ':' + *node->getCustomOp()->getOpName();
+                key += ':' + std::to_string((int) node->dataType()) + ':' + std::to_string((int) block->dataType());
+
+                // legacy scalar ops keep their operand inside of op instance, so such nodes are never merged
+                if (node->opType() == OpType_SCALAR || node->opType() == OpType_SCALAR_BOOL)
+                    key += "|s" + std::to_string(reinterpret_cast<Nd4jLong>(node->getCustomOp()));
+
+                key += "|i";
+                for (auto &p: *node->input())
+                    key += std::to_string(p.first) + ':' + std::to_string(p.second) + ',';
+
+                key += "|d";
+                for (auto v: *node->getDimensions())
+                    key += std::to_string(v) + ',';
+
+                // float arguments are compared bitwise
+                key += "|t";
+                for (auto v: *block->getTArguments()) {
+                    Nd4jLong bits;
+                    memcpy(&bits, &v, sizeof(bits));
+                    key += std::to_string(bits) + ',';
+                }
+
+                key += "|a";
+                for (auto v: *block->getIArguments())
+                    key += std::to_string(v) + ',';
+
+                key += "|b";
+                for (auto v: *block->getBArguments())
+                    key += v ? '1' : '0';
+
+                key += "|x";
+                for (auto v: *block->getAxis())
+                    key += std::to_string(v) + ',';
+
+                return key;
+            };
+
+            // nodes are visited in topological order, so inputs of every node are already deduplicated
+            std::vector<int> order;
+            for (auto &l: *_onion)
+                for (auto node: *l.second)
+                    order.emplace_back(node->id());
+
+            std::unordered_map<std::string, Node*> seen;
+            std::map<int, std::string> keys;
+
+            auto erase = [&] (Node* node) {
+                if (keys.count(node->id()) > 0) {
+                    seen.erase(keys[node->id()]);
+                    keys.erase(node->id());
+                }
+
+                for (auto &p: *node->input())
+                    if (p.first > 0)
+                        consumers[p.first]--;
+
+                eraseNode(node);
+            };
+
+            for (auto id: order) {
+                if (_mapped->count(id) == 0)
+                    continue;
+
+                auto node = _mapped->at(id);
+                if (!node->hasBlockAttached() || !node->hasCustomOp())
+                    continue;
+
+                std::pair<int, int> source;
+                if (identitySource(node, source) && !isPinned(node)) {
+                    nd4j_debug("Removing identity node_%i\n", id);
+                    redirect(id, source, false);
+                    erase(node);
+                    continue;
+                }
+
+                // reshape of reshape: outer one can take source of inner one, if both use the same order
+                auto reshape = reshapeOrder(node);
+                if (reshape != 0 && node->input()->at(0).first > 0 && _mapped->count(node->input()->at(0).first) > 0) {
+                    auto inner = _mapped->at(node->input()->at(0).first);
+                    if (reshapeOrder(inner) == reshape && node->input()->at(0).second == 0) {
+                        nd4j_debug("Collapsing reshape chain node_%i -> node_%i\n", inner->id(), id);
+                        replaceInput(node, 0, inner->input()->at(0));
+
+                        if (consumers[inner->id()] == 0 && !inner->hasExternalOutputs() && std::find(_output.begin(), _output.end(), inner->id()) == _output.end())
+                            erase(inner);
+                    }
+                }
+
+                if (!isDeterministic(node))
+                    continue;
+
+                auto key = keyOf(node);
+                if (seen.count(key) > 0 && !isPinned(node)) {
+                    nd4j_debug("Merging node_%i into node_%i\n", id, seen[key]->id());
+                    redirect(id, std::pair<int, int>(seen[key]->id(), 0), true);
+                    erase(node);
+                    continue;
+                }
+
+                if (seen.count(key) == 0) {
+                    seen[key] = node;
+                    keys[id] = key;
+                }
+            }
+
+            const int after = (int) _mapped->size();
+            if (after != before)
+                relayerNodes();
+
+            nd4j_verbose("Graph simplification: %i nodes before, %i nodes after\n", before, after);
+
+            return before - after;
+        }
+
+        int Graph::foldConstants() {
+            // without placeholders whole graph is constant, and there's nothing to gain from evaluating it twice
+            if (_configuration->_outputMode == OutputMode_VARIABLE_SPACE || !_unmapped.empty() || !_scopes.empty() || _variableSpace->numberOfPlaceholders() == 0)
+                return 0;
+
+            for (auto &v: *_mapped)
+                if (v.second->opType() == OpType_LOGIC)
+                    return 0;
+
+            // regular variables can be replaced between runs, i.e. by executeStoredGraph, so only true constants are folded
+            auto isConstant = [&] (std::pair<int, int>& p) -> bool {
+                if (p.first >= 0 || !_variableSpace->hasVariable(p))
+                    return false;
+
+                auto var = _variableSpace->getVariable(p);
+                return var->isConstant() && !var->isPlaceholder() && var->hasNDArray();
+            };
+
+            std::map<int, int> consumers;
+            for (auto node: _handles)
+                for (auto &p: *node->input())
+                    if (p.first > 0)
+                        consumers[p.first]++;
+
+            int nextId = -1;
+            for (auto var: _variableSpace->getVariables())
+                if (var->id() <= nextId)
+                    nextId = var->id() - 1;
+
+            std::vector<Node*> candidates;
+            for (auto &l: *_onion)
+                for (auto node: *l.second)
+                    candidates.emplace_back(node);
+
+            int cnt = 0;
+            for (auto node: candidates) {
+                const int id = node->id();
+
+                // results of final nodes are fetched by their ids, so such nodes stay in graph
+                if (!isDeterministic(node) || consumers[id] == 0 || node->hasExternalOutputs() || std::find(_output.begin(), _output.end(), id) != _output.end())
+                    continue;
+
+                auto block = node->getContextPrototype();
+                // output that already holds an array is state carried between runs
+                if (block->isInplace() || node->input()->empty() || (_variableSpace->hasVariable(id, 0) && _variableSpace->getVariable(id, 0)->hasNDArray()))
+                    continue;
+
+                if (!std::all_of(node->input()->begin(), node->input()->end(), [&] (std::pair<int, int>& p) { return isConstant(p); }))
+                    continue;
+
+                Context context(block, _variableSpace);
+                if (node->getCustomOp()->execute(&context) != Status::OK()) {
+                    nd4j_debug("Node_%i can't be folded, it'll be evaluated at runtime\n", id);
+                    continue;
+                }
+
+                std::vector<NDArray*> inputs;
+                for (auto &p: *node->input())
+                    inputs.emplace_back(_variableSpace->getVariable(p)->getNDArray());
+
+                // each output becomes new constant, arrays sharing buffer with inputs are copied
+                std::map<int, int> folded;
+                bool complete = true;
+                for (int e = 0; _variableSpace->hasVariable(id, e); e++) {
+                    auto var = _variableSpace->getVariable(id, e);
+                    if (!var->hasNDArray() || var->hasNDArrayList()) {
+                        complete = false;
+                        break;
+                    }
+
+                    auto array = var->getNDArray();
+                    bool aliased = std::any_of(inputs.begin(), inputs.end(), [&] (NDArray* in) { return in->getBuffer() == array->getBuffer(); });
+                    if (aliased)
+                        array = array->dup(array->ordering());
+                    else
+                        var->setNDArray(nullptr);
+
+                    auto constant = new Variable(array, nullptr, nextId, 0);
+                    constant->markExternal(true);
+                    constant->markConstant(true);
+                    _variableSpace->putVariable(nextId, constant);
+                    _derivedConstants.emplace_back(nextId);
+                    folded[e] = nextId--;
+                }
+
+                for (auto consumer: _handles)
+                    for (auto &p: *consumer->input())
+                        if (p.first == id && folded.count(p.second) == 0)
+                            complete = false;
+
+                // partially evaluated node stays in graph, its outputs will be overwritten on the first run
+                if (!complete || folded.empty())
+                    continue;
+
+                for (auto consumer: _handles) {
+                    std::vector<std::vector<std::pair<int, int>>*> lists = {consumer->input()};
+                    if (consumer->hasBlockAttached())
+                        lists.emplace_back(consumer->getContextPrototype()->inputs());
+
+                    for (auto list: lists)
+                        for (auto &p: *list)
+                            if (p.first == id)
+                                p = std::pair<int, int>(folded[p.second], 0);
+                }
+
+                nd4j_debug("Folded constant node_%i\n", id);
+                eraseNode(node);
+                cnt++;
+            }
+
+            if (cnt > 0)
+                relayerNodes();
+
+            return cnt;
+        }
+
+        int Graph::pruneUnreachable() {
+            // only explicit outputs tell what's actually needed
+            if (_configuration->_outputMode != OutputMode_EXPLICIT || _output.empty() || !_unmapped.empty() || !_scopes.empty())
+                return 0;
+
+            for (auto &v: *_mapped)
+                if (v.second->opType() == OpType_LOGIC)
+                    return 0;
+
+            std::vector<int> pending;
+            for (auto v: _output)
+                pending.emplace_back(v);
+
+            // nodes writing into external variables have side effects, so they're roots as well
+            for (auto &v: *_mapped)
+                if (v.second->hasExternalOutputs())
+                    pending.emplace_back(v.first);
+
+            std::set<int> reachable;
+            while (!pending.empty()) {
+                int id = pending.back();
+                pending.pop_back();
+
+                if (_mapped->count(id) == 0 || reachable.count(id) > 0)
+                    continue;
+
+                reachable.insert(id);
+                for (auto &p: *_mapped->at(id)->input())
+                    pending.emplace_back(p.first);
+            }
+
+            std::vector<Node*> dead;
+            for (auto &v: *_mapped)
+                if (reachable.count(v.first) == 0)
+                    dead.emplace_back(v.second);
+
+            for (auto node: dead) {
+                nd4j_debug("Pruned unreachable node_%i\n", node->id());
+                eraseNode(node);
+            }
+
+            if (!dead.empty())
+                relayerNodes();
+
+            return (int) dead.size();
+        }
+
+        int Graph::inferShapes(VariableSpace *variableSpace) {
+            auto space = variableSpace == nullptr ? _variableSpace : variableSpace;
+
+            if (!_built.load() || !_unmapped.empty() || !_scopes.empty())
+                return 0;
+
+            for (auto &v: *_mapped)
+                if (v.second->opType() == OpType_LOGIC)
+                    return 0;
+
+            // shape class covers shapes and data types of all external variables consumed by this graph,
+            // and values of small non-floating ones, since any external variable can be overwritten before execution
+            static const Nd4jLong maxHashedValues = 256;
+
+            std::set<std::pair<int, int>> external;
+            for (auto node: _handles)
+                for (auto &p: *node->input())
+                    if (p.first < 0)
+                        external.insert(p);
+
+            std::set<std::pair<int, int>> hashed;
+            uint64_t hash = 17;
+            for (auto p: external) {
+                if (!space->hasVariable(p) || !space->getVariable(p)->hasNDArray()) {
+                    space->setShapeClass(0);
+                    return 0;
+                }
+
+                auto array = space->getVariable(p)->getNDArray();
+                hash = hash * 31 + (uint64_t) p.first;
+                hash = (uint64_t) ContextPrototype::shapeHash((Nd4jLong) hash, array->shapeInfo());
+
+                if (!array->isR() && !array->isS() && array->lengthOf() <= maxHashedValues) {
+                    for (Nd4jLong e = 0; e < array->lengthOf(); e++)
+                        hash = hash * 31 + (uint64_t) array->e<Nd4jLong>(e);
+
+                    hashed.insert(p);
+                }
+            }
+
+            const Nd4jLong shapeClass = hash == 0 ? 1 : (Nd4jLong) hash;
+            if (shapeClass == space->shapeClass())
+                return 0;
+
+            space->setShapeClass(shapeClass);
+
+            // these ops produce shapes that depend on input values, not only on input shapes
+            static const std::vector<std::string> valueDependent = {"unique", "unique_with_counts", "where", "where_np", "boolean_mask", "non_max_suppression", "range", "choose", "listdiff", "dynamic_partition", "dynamic_stitch"};
+
+            std::set<int> known;
+            int cnt = 0;
+            for (auto &l: *_onion) {
+                for (auto node: *l.second) {
+                    if (!node->hasBlockAttached())
+                        continue;
+
+                    auto block = node->getContextPrototype();
+                    block->setKnownShapes(0, 0);
+
+                    auto opType = node->opType();
+                    if (!node->hasCustomOp() || node->hasGraphEmbedded() || block->isInplace() || opType == OpType_RANDOM || opType == OpType_LOGIC || opType == OpType_GRAPH || opType == OpType_BOOLEAN)
+                        continue;
+
+                    auto op = node->getCustomOp();
+                    if (dynamic_cast<nd4j::ops::DeclarableListOp*>(op) != nullptr)
+                        continue;
+
+                    const bool constantsOnly = std::find(valueDependent.begin(), valueDependent.end(), *op->getOpName()) != valueDependent.end();
+
+                    // values of non-floating inputs may define output shapes (shape arrays, axis, indices), so they must be part of shape class
+                    auto isResolved = [&] (std::pair<int, int>& p) -> bool {
+                        if (p.first > 0 && known.count(p.first) == 0)
+                            return false;
+
+                        if (!space->hasVariable(p))
+                            return false;
+
+                        auto var = space->getVariable(p);
+                        if (!var->hasNDArray() || var->hasNDArrayList())
+                            return false;
+
+                        if (hashed.count(p) > 0)
+                            return true;
+
+                        return !constantsOnly && var->getNDArray()->isR();
+                    };
+
+                    if (block->inputs()->empty() || !std::all_of(block->inputs()->begin(), block->inputs()->end(), isResolved))
+                        continue;
+
+                    ShapeList *outSha = nullptr;
+                    bool inferred = false;
+                    try {
+                        Context ctx(block, space);
+                        if (op->validateNonEmptyInput(ctx) == Status::OK() && op->validateArguments(ctx) == Status::OK() && op->validateDataTypes(ctx) == Status::OK()) {
+                            ShapeList inSha;
+                            Nd4jLong inputShapes = 17;
+                            for (auto &p: *block->inputs()) {
+                                inSha.push_back(space->getVariable(p)->getNDArray()->getShapeInfo());
+                                inputShapes = ContextPrototype::shapeHash(inputShapes, space->getVariable(p)->getNDArray()->shapeInfo());
+                            }
+
+                            outSha = op->calculateOutputShape(&inSha, ctx);
+
+                            const int numOutputs = outSha->size();
+                            inferred = numOutputs > 0;
+                            for (int e = 0; e < numOutputs && inferred; e++)
+                                inferred = !DataTypeUtils::isS(ArrayOptions::dataType(outSha->at(e)));
+
+                            for (int e = 0; e < numOutputs && inferred; e++) {
+                                auto out = outSha->at(e);
+                                std::pair<int, int> pair(node->id(), e);
+
+                                if (space->hasVariable(pair)) {
+                                    auto var = space->getVariable(pair);
+                                    if (var->hasNDArrayList()) {
+                                        inferred = false;
+                                        break;
+                                    }
+
+                                    if (var->hasNDArray()) {
+                                        auto array = var->getNDArray();
+                                        if (shape::equalsSoft(out, array->shapeInfo()) && array->dataType() == ArrayOptions::dataType(out))
+                                            continue;
+
+                                        // arrays provided by user can't be replaced
+                                        if (!var->isRemovable()) {
+                                            inferred = false;
+                                            break;
+                                        }
+                                    }
+                                }
+
+                                // preallocated outputs live across runs, so they're never placed into workspace
+                                ctx.pushNDArrayToVariableSpace(pair, new NDArray(out, true, nullptr), true);
+                            }
+
+                            if (inferred)
+                                block->setKnownShapes(shapeClass, numOutputs, inputShapes);
+                        }
+                    } catch (std::exception &e) {
+                        nd4j_debug("Shape inference failed for node_%i: %s\n", node->id(), e.what());
+                        inferred = false;
+                    }
+
+                    if (outSha != nullptr) {
+                        outSha->destroy();
+                        delete outSha;
+                    }
+
+                    if (inferred) {
+                        known.insert(node->id());
+                        cnt++;
+                    }
+                }
+            }
+
+            nd4j_verbose("Shape inference: %i of %i nodes have known shapes\n", cnt, (int) _mapped->size());
+
+            return cnt;
+        }
+
         Nd4jStatus Graph::buildGraph() {
             if (_built.load()) {
                 prepareOutputs();
                 return ND4J_STATUS_OK;
             }
 
+            if (Environment::getInstance()->isFoldQuantization())
+                foldFakeQuantization();
+
             typename std::map<int, Node *>::iterator fit;
             int cnts = 0;
             for ( fit = _unmapped.begin(); fit != _unmapped.end(); fit++ ) {
@@ -699,6 +2017,20 @@ namespace nd4j {
             if (_unmapped.size() == 0)
                 _built.store(true);
 
+            if (_built.load() && Environment::getInstance()->isSimplifyGraphs())
+                simplify();
+
+            if (_built.load() && Environment::getInstance()->isFoldConstants()) {
+                foldConstants();
+                pruneUnreachable();
+            }
+
+            if (_built.load() && Environment::getInstance()->isOptimizeLayouts())
+                optimizeLayouts();
+
+            if (_built.load())
+                assignSlots();
+
             prepareOutputs();
 
             return nd4j::Status::OK();
@@ -864,12 +2196,105 @@ namespace nd4j {
             }
         }
 
-        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace) {
+        Nd4jLong Graph::hashFlatGraph(const FlatGraph *flatGraph) {
+            if (flatGraph == nullptr || flatGraph->nodes() == nullptr)
+                return 0L;
+
+            // nodes are hashed in order of ids, so fingerprint doesn't depend on order of serialization
+            std::map<int, const FlatNode*> nodes;
+            for (unsigned int e = 0; e < flatGraph->nodes()->size(); e++) {
+                auto node = flatGraph->nodes()->Get(e);
+                nodes[node->id()] = node;
+            }
+
+            std::string bytes;
+            auto append = [&bytes] (const void *ptr, size_t length) {
+                bytes.append(reinterpret_cast<const char *>(ptr), length);
+            };
+
+            for (auto &v: nodes) {
+                auto node = v.second;
+                int id = node->id();
+                int opType = (int) node->opType();
+                int64_t opNum = node->opNum();
+                append(&id, sizeof(id));
+                append(&opType, sizeof(opType));
+                append(&opNum, sizeof(opNum));
+
+                // inputs are given either as pairs or as plain ids
+                if (node->inputPaired() != nullptr) {
+                    for (unsigned int i = 0; i < node->inputPaired()->size(); i++) {
+                        int pair[2] = {node->inputPaired()->Get(i)->first(), node->inputPaired()->Get(i)->second()};
+                        append(pair, sizeof(pair));
+                    }
+                } else if (node->input() != nullptr)
+                    append(node->input()->data(), node->input()->size() * sizeof(int32_t));
+
+                // vectors are separated by their lengths, so same values moved between them give different hash
+                int32_t lengths[4] = {(int32_t) (node->extraInteger() == nullptr ? 0 : node->extraInteger()->size()),
+                                      (int32_t) (node->extraParams() == nullptr ? 0 : node->extraParams()->size()),
+                                      (int32_t) (node->extraBools() == nullptr ? 0 : node->extraBools()->size()),
+                                      (int32_t) (node->dimensions() == nullptr ? 0 : node->dimensions()->size())};
+                append(lengths, sizeof(lengths));
+
+                if (lengths[0] > 0)
+                    append(node->extraInteger()->data(), lengths[0] * sizeof(int64_t));
+
+                if (lengths[1] > 0)
+                    append(node->extraParams()->data(), lengths[1] * sizeof(double));
+
+                if (lengths[2] > 0)
+                    append(node->extraBools()->data(), lengths[2] * sizeof(uint8_t));
+
+                if (lengths[3] > 0)
+                    append(node->dimensions()->data(), lengths[3] * sizeof(int32_t));
+            }
+
+            auto hash = (uint64_t) nd4j::ops::HashHelper::getInstance()->getLongHash(bytes);
+            if (flatGraph->variables() == nullptr)
+                return (Nd4jLong) hash;
+
+            // folded constants stored in plan are computed from variable values, so those are hashed too.
+            // weights may be large, so they're mixed in place with FNV-1a instead of being copied into the string
+            auto mix = [&hash] (const void *ptr, size_t length) {
+                auto data = reinterpret_cast<const uint8_t *>(ptr);
+                for (size_t e = 0; e < length; e++) {
+                    hash ^= data[e];
+                    hash *= 1099511628211ULL;
+                }
+            };
+
+            std::map<std::pair<int, int>, const FlatVariable*> variables;
+            for (unsigned int e = 0; e < flatGraph->variables()->size(); e++) {
+                auto var = flatGraph->variables()->Get(e);
+                variables[std::pair<int, int>(var->id()->first(), var->id()->second())] = var;
+            }
+
+            for (auto &v: variables) {
+                auto var = v.second;
+                auto array = var->ndarray();
+                if (var->variabletype() == VarType_PLACEHOLDER || array == nullptr || array->buffer() == nullptr)
+                    continue;
+
+                int header[3] = {v.first.first, v.first.second, (int) array->dtype()};
+                mix(header, sizeof(header));
+
+                if (array->shape() != nullptr)
+                    mix(array->shape()->data(), array->shape()->size() * sizeof(int64_t));
+
+                mix(array->buffer()->data(), array->buffer()->size());
+            }
+
+            return (Nd4jLong) hash;
+        }
+
+        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace, ExecutionPlan *plan) {
             this->_onion = new std::map<int, std::vector<Node *> *>();
             this->_mapped = new std::map<int, Node *> ();
             this->_nodes = new std::vector<int>();
             this->_variableSpace = variableSpace == nullptr ? new VariableSpace() : variableSpace;
             bool trusted = flatGraph != nullptr;
+            this->_fingerprint = hashFlatGraph(flatGraph);
 
             // add 0 layer
             this->expandOnion(0);
@@ -943,9 +2368,24 @@ namespace nd4j {
                 }
 
 
-                this->toposortNodes();
+                if (plan == nullptr || !this->applyPlan(plan)) {
+                    this->toposortNodes();
+
+                    _built = true;
 
-                _built = true;
+                    if (Environment::getInstance()->isSimplifyGraphs())
+                        this->simplify();
+
+                    if (Environment::getInstance()->isFoldConstants()) {
+                        this->foldConstants();
+                        this->pruneUnreachable();
+                    }
+
+                    if (Environment::getInstance()->isOptimizeLayouts())
+                        this->optimizeLayouts();
+
+                    this->assignSlots();
+                }
             }
 
             /**
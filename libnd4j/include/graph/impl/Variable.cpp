@@ -36,6 +36,7 @@ namespace nd4j {
             result->markExternal(this->_external);
             result->setId(this->_id);
             result->markReadOnly(this->_readOnly);
+            result->markConstant(this->_constant);
             result->setName(&this->_name);
             result->setIndex(this->_index);
 
@@ -57,6 +58,7 @@ namespace nd4j {
             result->_external = this->_external;
             result->_id = this->_id;
             result->_readOnly = this->_readOnly;
+            result->_constant = this->_constant;
             result->_name = this->_name;
             result->_index = this->_index;
 
@@ -126,6 +128,10 @@ namespace nd4j {
             return _readOnly;
         }
 
+        bool nd4j::graph::Variable::isConstant() {
+            return _constant;
+        }
+
         void nd4j::graph::Variable::markExternal(bool reallyExternal) {
             this->_external = reallyExternal;
         }
@@ -140,6 +146,10 @@ namespace nd4j {
             this->_readOnly = reallyReadOnly;
         }
 
+        void nd4j::graph::Variable::markConstant(bool reallyConstant) {
+            this->_constant = reallyConstant;
+        }
+
         nd4j::NDArray * nd4j::graph::Variable::getNDArray() {
             if (_variableType != VariableType::NDARRAY) {
                 nd4j_printf("Variable[%i:%i/<%s>] is has [%s] type, but NDArray was requested\n", this->_id, this->_index, this->_name.c_str(), EnumUtils::_VariableTypeToString(_variableType));
@@ -228,6 +238,7 @@ namespace nd4j {
                         _ndarray->triggerAllocationFlag(true, true);
 
                         _variableType = VariableType::NDARRAY;
+                        _constant = true;
                     }
                     break;
                 case VarType_ARRAY: {
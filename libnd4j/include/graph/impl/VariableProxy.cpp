@@ -115,6 +115,31 @@ namespace nd4j {
             return result;
         }
 
+
+        int VariableProxy::registerSlot(std::pair<int,int>& pair) {
+            return _backed->registerSlot(pair);
+        }
+
+
+        int VariableProxy::numberOfSlots() {
+            return _backed->numberOfSlots();
+        }
+
+
+        Variable* VariableProxy::getVariableBySlot(int slot, const std::pair<int,int>& pair) {
+            // variables of current space shadow backed ones, and they aren't cached
+            std::pair<int, int> p(pair);
+            if (_current->hasVariable(p))
+                return _current->getVariable(p);
+
+            return _backed->getVariableBySlot(slot, pair);
+        }
+
+
+        std::pair<int,int> VariableProxy::slotPair(int slot) {
+            return _backed->slotPair(slot);
+        }
+
         
         bool VariableProxy::hasVariable(std::string *symbol) {
             return _current->hasVariable(symbol) || _backed->hasVariable(symbol);
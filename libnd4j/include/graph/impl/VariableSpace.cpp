@@ -42,6 +42,11 @@ namespace nd4j {
                 result->injectVariable(pair, clonedVar);
             }
 
+            result->_slotIds = _slotIds;
+            result->_slotPairs = _slotPairs;
+            result->_slots.resize(_slots.size(), nullptr);
+            result->_shapeClass = _shapeClass;
+
             return result;
         }
 
@@ -77,6 +82,7 @@ namespace nd4j {
                 this->_symbolic[*(variable->getName())] = variable;
 
             this->_paired[pair] = variable;
+            invalidateSlot(pair);
 
             this->_handles->push_back(variable);
         }
@@ -151,6 +157,60 @@ namespace nd4j {
             return nullptr;
         }
 
+        int VariableSpace::registerSlot(std::pair<int,int>& pair) {
+            std::lock_guard<std::mutex> lock(_varmap);
+
+            auto it = _slotIds.find(pair);
+            if (it != _slotIds.end())
+                return it->second;
+
+            const int slot = _slotPairs.size();
+            _slotIds[pair] = slot;
+            _slotPairs.emplace_back(pair);
+            _slots.emplace_back(nullptr);
+
+            return slot;
+        }
+
+        int VariableSpace::numberOfSlots() {
+            return _slotPairs.size();
+        }
+
+        Variable* VariableSpace::getVariableBySlot(int slot, const std::pair<int,int>& pair) {
+            // cache is filled lazily and invalidated by puts, both happen under the same lock
+            std::lock_guard<std::mutex> lock(_varmap);
+
+            if (slot < 0 || slot >= (int) _slotPairs.size() || _slotPairs[slot] != pair)
+                return nullptr;
+
+            auto variable = _slots[slot];
+            if (variable != nullptr)
+                return variable;
+
+            // first lookup goes through maps, result is cached until variable for this pair is replaced
+            auto &p = _slotPairs[slot];
+            if (!hasVariable(p))
+                return nullptr;
+
+            variable = getVariable(p);
+            _slots[slot] = variable;
+
+            return variable;
+        }
+
+        std::pair<int,int> VariableSpace::slotPair(int slot) {
+            if (slot < 0 || slot >= (int) _slotPairs.size())
+                throw std::runtime_error("Slot index is out of range");
+
+            return _slotPairs[slot];
+        }
+
+        void VariableSpace::invalidateSlot(const std::pair<int, int>& pair) {
+            auto it = _slotIds.find(pair);
+            if (it != _slotIds.end())
+                _slots[it->second] = nullptr;
+        }
+
         bool nd4j::graph::VariableSpace::hasVariable(int id) {
             return _variables.count(id) == 1 || _temporary.count(id) == 1;
         }
@@ -230,6 +290,7 @@ namespace nd4j {
 
             //std::pair<std::pair<int, int>, nd4j::graph::Variable *> p(pair, variable);
             _paired[pair] = variable;
+            invalidateSlot(pair);
 
             _varmap.unlock();
         }
@@ -303,6 +364,8 @@ namespace nd4j {
                 _temporary[id] = variable;
             }
 
+            invalidateSlot(std::pair<int, int>(id, 0));
+
             _varmap.unlock();
 
             std::pair<int,int> pair(id, 0);
@@ -390,10 +453,13 @@ namespace nd4j {
                     this->_symbolic[*(clonedVar->getName())] = clonedVar;
 
                 this->_paired[pair] = clonedVar;
+                invalidateSlot(pair);
 
                 this->_handles->push_back(clonedVar);
             }
 
+            this->_shapeClass = other._shapeClass;
+
             return *this;
         }
 
@@ -44,6 +44,10 @@ namespace nd4j {
             Nd4jLong _memoryTemporary = 0L;
             Nd4jLong _memoryObjects = 0L;
 
+            // copies avoided due to permute/transpose nodes removed from graph, and their size in bytes
+            Nd4jLong _eliminatedCopies = 0L;
+            Nd4jLong _eliminatedBytes = 0L;
+
             // time spent for graph construction
             Nd4jLong _buildTime = 0L;
 
@@ -73,6 +77,11 @@ namespace nd4j {
             void addToTemporary(Nd4jLong bytes);
             void addToObjects(Nd4jLong bytes);
 
+            /**
+             * This method adds number and total size of copies that weren't made, since layout optimization removed them from graph
+             */
+            void addToEliminatedCopies(Nd4jLong copies, Nd4jLong bytes);
+
             /**
              * This method allows to set graph construction (i.e. deserialization) time in nanoseconds
              */
@@ -89,6 +89,13 @@ namespace nd4j {
             Nd4jLong getObjectsSize();
             Nd4jLong getTotalSize();
 
+            Nd4jLong getPreparationTime();
+            Nd4jLong getExecutionTime();
+            Nd4jLong getTotalTime();
+            Nd4jLong getShapeFunctionTime();
+            Nd4jLong getArrayTime();
+            Nd4jLong getInputTime();
+
             std::string& name();
 
             void merge(NodeProfile *other);
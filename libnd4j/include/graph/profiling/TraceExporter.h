@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Exporter of graph execution timelines in trace-event JSON format (chrome://tracing, Perfetto UI)
+//
+
+#ifndef ND4J_GRAPH_TRACE_EXPORTER_H
+#define ND4J_GRAPH_TRACE_EXPORTER_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace nd4j {
+    namespace graph {
+
+        /**
+         * Single span on timeline: node execution or whole graph execution.
+         * Times are nanoseconds of TraceExporter::currentTime() clock, breakdown times are -1 if unknown.
+         */
+        struct ND4J_EXPORT TraceSpan {
+            std::string name;
+            std::string category;
+            int nodeId = -1;
+            std::string nodeName;
+            Nd4jLong graphHash = 0L;
+
+            Nd4jLong start = 0L;
+            Nd4jLong duration = 0L;
+
+            // change of workspace usage during span, and usage after it
+            Nd4jLong memoryDelta = 0L;
+            Nd4jLong memoryUsed = -1L;
+
+            // NodeProfile breakdown, available when Environment::isProfiling() is set
+            Nd4jLong preparationTime = -1L;
+            Nd4jLong executionTime = -1L;
+            Nd4jLong inputTime = -1L;
+            Nd4jLong shapeTime = -1L;
+            Nd4jLong arrayTime = -1L;
+        };
+
+        /**
+         * Capture is started with target file and sampling rate: only every Nth graph execution is traced, so
+         * capture can be left on in production. Events are streamed into file as they come, file becomes valid
+         * JSON once capture is stopped.
+         */
+        class ND4J_EXPORT TraceExporter {
+        private:
+            static TraceExporter* _instance;
+
+            std::atomic<bool> _capturing;
+            std::atomic<Nd4jLong> _executions;
+            std::atomic<int> _sampleEvery;
+
+            std::mutex _mutex;
+            std::ofstream _file;
+            bool _first = true;
+            Nd4jLong _events = 0L;
+            std::map<std::thread::id, int> _threads;
+
+            TraceExporter();
+
+            int threadId();
+            void writeEvent(const std::string& json);
+
+        public:
+            static TraceExporter* getInstance();
+
+            /**
+             * Starts capture into given file, previous capture is stopped first.
+             * @param sampleEvery trace every Nth graph execution, values < 1 mean each one
+             * @return false if file can't be opened
+             */
+            bool start(const char* path, int sampleEvery = 1);
+
+            /**
+             * Stops capture and finalizes file. Returns false if there was no capture.
+             */
+            bool stop();
+
+            bool isCapturing();
+
+            /**
+             * Called once per graph execution, returns true if this execution has to be traced
+             */
+            bool sampleExecution();
+
+            /**
+             * Appends complete span to trace, and workspace usage counter if it's known
+             */
+            void record(const TraceSpan& span);
+
+            /**
+             * Number of events written during current (or last) capture
+             */
+            Nd4jLong numberOfEvents();
+
+            /**
+             * Monotonic clock used for spans, in nanoseconds
+             */
+            static Nd4jLong currentTime();
+        };
+    }
+}
+
+#endif
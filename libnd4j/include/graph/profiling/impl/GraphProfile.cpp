@@ -52,6 +52,11 @@ namespace nd4j {
             _memoryObjects += bytes;
         }
 
+        void GraphProfile::addToEliminatedCopies(Nd4jLong copies, Nd4jLong bytes) {
+            _eliminatedCopies += copies;
+            _eliminatedBytes += bytes;
+        }
+
         void GraphProfile::setBuildTime(Nd4jLong nanos) {
             _buildTime = nanos;
         }
@@ -126,6 +131,8 @@ namespace nd4j {
             _memoryTemporary += other->_memoryTemporary;
             _memoryTotal += other->_memoryTotal;
             _memoryObjects += other->_memoryObjects;
+            _eliminatedCopies += other->_eliminatedCopies;
+            _eliminatedBytes += other->_eliminatedBytes;
 
             _executionTime += other->_executionTime;
             _buildTime += other->_buildTime;
@@ -145,6 +152,8 @@ namespace nd4j {
             _memoryTemporary = other->_memoryTemporary;
             _memoryTotal = other->_memoryTotal;
             _memoryObjects = other->_memoryObjects;
+            _eliminatedCopies = other->_eliminatedCopies;
+            _eliminatedBytes = other->_eliminatedBytes;
 
             _executionTime = other->_executionTime;
             _buildTime = other->_buildTime;
@@ -175,6 +184,7 @@ namespace nd4j {
             }
 
             nd4j_printf("ACT: %lld; TMP: %lld; OBJ: %lld; TTL: %lld;\n", act / _merges, tmp / _merges, obj / _merges, ttl / _merges);
+            nd4j_printf("Layout: %lld copies eliminated, %lld bytes;\n", _eliminatedCopies / _merges, _eliminatedBytes / _merges);
 
             nd4j_printf("\nTime:\n", "");
             nd4j_printf("Construction time: %lld ns;\n", _buildTime / _merges);
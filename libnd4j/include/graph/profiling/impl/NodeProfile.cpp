@@ -65,6 +65,30 @@ namespace nd4j {
             return _memoryTotal;
         }
 
+        Nd4jLong NodeProfile::getPreparationTime() {
+            return _preparationTime;
+        }
+
+        Nd4jLong NodeProfile::getExecutionTime() {
+            return _executionTime;
+        }
+
+        Nd4jLong NodeProfile::getTotalTime() {
+            return _totalTime;
+        }
+
+        Nd4jLong NodeProfile::getShapeFunctionTime() {
+            return _shapeTime;
+        }
+
+        Nd4jLong NodeProfile::getArrayTime() {
+            return _arrayTime;
+        }
+
+        Nd4jLong NodeProfile::getInputTime() {
+            return _inputTime;
+        }
+
         void NodeProfile::setBuildTime(Nd4jLong time) {
             _buildTime = time;
         }
@@ -0,0 +1,208 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Trace Event Format JSON writer: complete ("X") events for spans, counter ("C") events for workspace usage
+//
+
+#include <graph/profiling/TraceExporter.h>
+#include <helpers/logger.h>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+namespace nd4j {
+    namespace graph {
+
+        // JSON string literal contents
+        static std::string escape(const std::string& value) {
+            std::string result;
+            result.reserve(value.size());
+
+            for (auto c : value) {
+                switch (c) {
+                    case '"': result += "\\\""; break;
+                    case '\\': result += "\\\\"; break;
+                    case '\n': result += "\\n"; break;
+                    case '\r': result += "\\r"; break;
+                    case '\t': result += "\\t"; break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            char buffer[8];
+                            snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<int>(c));
+                            result += buffer;
+                        } else
+                            result += c;
+                }
+            }
+
+            return result;
+        }
+
+        // trace-event timestamps are microseconds, fractional part keeps nanoseconds
+        static void writeMicros(std::ostringstream& stream, Nd4jLong nanos) {
+            stream << nanos / 1000 << "." << std::setw(3) << std::setfill('0') << (nanos % 1000 + 1000) % 1000;
+        }
+
+        TraceExporter::TraceExporter() {
+            _capturing.store(false);
+            _executions.store(0L);
+            _sampleEvery.store(1);
+        }
+
+        TraceExporter* TraceExporter::getInstance() {
+            if (_instance == 0)
+                _instance = new TraceExporter();
+
+            return _instance;
+        }
+
+        Nd4jLong TraceExporter::currentTime() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        bool TraceExporter::isCapturing() {
+            return _capturing.load();
+        }
+
+        bool TraceExporter::sampleExecution() {
+            if (!_capturing.load())
+                return false;
+
+            return _executions++ % _sampleEvery.load() == 0;
+        }
+
+        Nd4jLong TraceExporter::numberOfEvents() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _events;
+        }
+
+        bool TraceExporter::start(const char* path, int sampleEvery) {
+            stop();
+
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            _file.open(path, std::ios::out | std::ios::trunc);
+            if (!_file.is_open()) {
+                nd4j_printf("TraceExporter: can't open [%s] for writing\n", path);
+                return false;
+            }
+
+            _file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+            _file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"libnd4j\"}}";
+            _first = false;
+            _events = 0L;
+            _threads.clear();
+
+            _executions.store(0L);
+            _sampleEvery.store(sampleEvery < 1 ? 1 : sampleEvery);
+            _capturing.store(true);
+
+            return true;
+        }
+
+        bool TraceExporter::stop() {
+            _capturing.store(false);
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_file.is_open())
+                return false;
+
+            _file << "\n]}\n";
+            _file.close();
+
+            return true;
+        }
+
+        int TraceExporter::threadId() {
+            auto id = std::this_thread::get_id();
+            auto it = _threads.find(id);
+            if (it != _threads.end())
+                return it->second;
+
+            // small sequential ids, with thread name metadata event written on first use
+            int tid = static_cast<int>(_threads.size()) + 1;
+            _threads[id] = tid;
+
+            std::ostringstream stream;
+            stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+            writeEvent(stream.str());
+
+            return tid;
+        }
+
+        void TraceExporter::writeEvent(const std::string& json) {
+            if (!_first)
+                _file << ",\n";
+
+            _file << json;
+            _first = false;
+            _events++;
+        }
+
+        void TraceExporter::record(const TraceSpan& span) {
+            if (!_capturing.load())
+                return;
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_file.is_open())
+                return;
+
+            const int tid = threadId();
+
+            std::ostringstream stream;
+            stream << "{\"name\":\"" << escape(span.name) << "\",\"cat\":\"" << escape(span.category) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ",\"ts\":";
+            writeMicros(stream, span.start);
+            stream << ",\"dur\":";
+            writeMicros(stream, span.duration);
+
+            stream << ",\"args\":{\"graph\":" << span.graphHash;
+            if (span.nodeId >= 0)
+                stream << ",\"node_id\":" << span.nodeId;
+            if (!span.nodeName.empty())
+                stream << ",\"node_name\":\"" << escape(span.nodeName) << "\"";
+
+            stream << ",\"memory_delta\":" << span.memoryDelta;
+
+            if (span.preparationTime >= 0)
+                stream << ",\"preparation_ns\":" << span.preparationTime;
+            if (span.executionTime >= 0)
+                stream << ",\"execution_ns\":" << span.executionTime;
+            if (span.inputTime >= 0)
+                stream << ",\"input_ns\":" << span.inputTime;
+            if (span.shapeTime >= 0)
+                stream << ",\"shape_ns\":" << span.shapeTime;
+            if (span.arrayTime >= 0)
+                stream << ",\"array_ns\":" << span.arrayTime;
+            stream << "}}";
+
+            writeEvent(stream.str());
+
+            if (span.memoryUsed >= 0) {
+                std::ostringstream counter;
+                counter << "{\"name\":\"workspace\",\"ph\":\"C\",\"pid\":1,\"tid\":" << tid << ",\"ts\":";
+                writeMicros(counter, span.start + span.duration);
+                counter << ",\"args\":{\"bytes\":" << span.memoryUsed << "}}";
+
+                writeEvent(counter.str());
+            }
+        }
+
+        TraceExporter* TraceExporter::_instance = 0;
+    }
+}
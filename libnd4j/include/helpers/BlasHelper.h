@@ -142,6 +142,16 @@ namespace nd4j {
                            double* u, int ldu, double* vt,
                            int ldvt);
 
+    typedef int (*LapackeSgetrf)(LAPACK_LAYOUT matrix_layout, int m, int n,
+                           float* a, int lda, int* ipiv);
+    typedef int (*LapackeDgetrf)(LAPACK_LAYOUT matrix_layout, int m, int n,
+                           double* a, int lda, int* ipiv);
+
+    typedef int (*LapackeSpotrf)(LAPACK_LAYOUT matrix_layout, char uplo, int n,
+                           float* a, int lda);
+    typedef int (*LapackeDpotrf)(LAPACK_LAYOUT matrix_layout, char uplo, int n,
+                           double* a, int lda);
+
     typedef cublasStatus_t (CUBLASWINAPI *CublasSgemv)(cublasHandle_t handle, 
                                                       cublasOperation_t trans, 
                                                       int m, 
@@ -388,6 +398,10 @@ namespace nd4j {
         LapackeDgesvd lapackeDgesvd;
         LapackeSgesdd lapackeSgesdd;
         LapackeDgesdd lapackeDgesdd;
+        LapackeSgetrf lapackeSgetrf = nullptr;
+        LapackeDgetrf lapackeDgetrf = nullptr;
+        LapackeSpotrf lapackeSpotrf = nullptr;
+        LapackeDpotrf lapackeDpotrf = nullptr;
 
         CublasSgemv cublasSgemv;
         CublasDgemv cublasDgemv;
@@ -409,6 +423,11 @@ namespace nd4j {
         void initializeFunctions(Nd4jPointer *functions);
 		void initializeDeviceFunctions(Nd4jPointer *functions);
 
+        /**
+         * LAPACKE functions used by dense linear algebra helpers: {sgetrf, dgetrf, spotrf, dpotrf}, nullptr for absent ones
+         */
+        void initializeLapackFunctions(Nd4jPointer *functions);
+
         template <typename T>
         bool hasGEMV();
 
@@ -435,6 +454,13 @@ namespace nd4j {
 
         LapackeSgesdd sgesdd();
         LapackeDgesdd dgesdd();
+
+        // these return nullptr unless LAPACK functions were provided
+        LapackeSgetrf sgetrf();
+        LapackeDgetrf dgetrf();
+
+        LapackeSpotrf spotrf();
+        LapackeDpotrf dpotrf();
         
         // destructor
         ~BlasHelper() noexcept; 
@@ -0,0 +1,484 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Dense linear algebra engine behind lup/cholesky helpers and triangular_solve: LU with partial pivoting,
+// Cholesky factorization and triangular solve over contiguous row-major square matrices.
+//
+// Large matrices are factorized LAPACK-style by panels of blockSize() columns: panel is factorized with row loops,
+// trailing submatrix is updated with single GEMM (BLAS one if available). If LAPACK functions were provided
+// through BlasHelper, getrf/potrf go there instead. Matrices up to 8x8 have their own kernels with compile-time
+// sizes (see linalg::Tiny), these are meant for batches spread over threads.
+//
+
+#ifndef LIBND4J_LINEARALGEBRAHELPER_H
+#define LIBND4J_LINEARALGEBRAHELPER_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <helpers/BlasHelper.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace nd4j {
+namespace linalg {
+
+    /**
+     * Kernels for matrices of order N <= 8. All loop bounds are compile-time constants, so compiler unrolls them completely
+     * and keeps the matrix in registers. Input matrices are row-major a[N * N].
+     */
+    template <typename T, int N>
+    struct Tiny {
+
+        // LU with partial pivoting in place, returns false for singular matrix; sign gets sign of row permutation
+        static FORCEINLINE bool lu(T* a, T& sign) {
+            bool regular = true;
+            sign = static_cast<T>(1);
+
+            for (int j = 0; j < N; j++) {
+                int p = j;
+                for (int i = j + 1; i < N; i++)
+                    if (std::abs(a[i * N + j]) > std::abs(a[p * N + j]))
+                        p = i;
+
+                if (a[p * N + j] == static_cast<T>(0)) {
+                    regular = false;
+                    continue;
+                }
+
+                if (p != j) {
+                    for (int c = 0; c < N; c++)
+                        std::swap(a[j * N + c], a[p * N + c]);
+                    sign = -sign;
+                }
+
+                const T inv = static_cast<T>(1) / a[j * N + j];
+                for (int i = j + 1; i < N; i++) {
+                    const T l = a[i * N + j] * inv;
+                    a[i * N + j] = l;
+                    for (int c = j + 1; c < N; c++)
+                        a[i * N + c] -= l * a[j * N + c];
+                }
+            }
+
+            return regular;
+        }
+
+        static FORCEINLINE T determinant(const T* x) {
+            T a[N * N];
+            for (int e = 0; e < N * N; e++)
+                a[e] = x[e];
+
+            T det;
+            if (!lu(a, det))
+                return static_cast<T>(0);
+
+            for (int j = 0; j < N; j++)
+                det *= a[j * N + j];
+
+            return det;
+        }
+
+        // Gauss-Jordan elimination with partial pivoting, returns false for singular matrix
+        static FORCEINLINE bool inverse(const T* x, T* z) {
+            T a[N * N];
+            for (int e = 0; e < N * N; e++) {
+                a[e] = x[e];
+                z[e] = static_cast<T>(0);
+            }
+            for (int j = 0; j < N; j++)
+                z[j * N + j] = static_cast<T>(1);
+
+            for (int j = 0; j < N; j++) {
+                int p = j;
+                for (int i = j + 1; i < N; i++)
+                    if (std::abs(a[i * N + j]) > std::abs(a[p * N + j]))
+                        p = i;
+
+                if (a[p * N + j] == static_cast<T>(0))
+                    return false;
+
+                if (p != j)
+                    for (int c = 0; c < N; c++) {
+                        std::swap(a[j * N + c], a[p * N + c]);
+                        std::swap(z[j * N + c], z[p * N + c]);
+                    }
+
+                const T inv = static_cast<T>(1) / a[j * N + j];
+                for (int c = 0; c < N; c++) {
+                    a[j * N + c] *= inv;
+                    z[j * N + c] *= inv;
+                }
+
+                for (int i = 0; i < N; i++) {
+                    if (i == j)
+                        continue;
+
+                    const T f = a[i * N + j];
+                    for (int c = 0; c < N; c++) {
+                        a[i * N + c] -= f * a[j * N + c];
+                        z[i * N + c] -= f * z[j * N + c];
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        // lower triangular factor into l, upper triangle of l is zeroed; returns false if matrix isn't positive definite
+        static FORCEINLINE bool cholesky(const T* x, T* l) {
+            bool positive = true;
+            for (int e = 0; e < N * N; e++)
+                l[e] = static_cast<T>(0);
+
+            for (int j = 0; j < N; j++) {
+                T d = x[j * N + j];
+                for (int p = 0; p < j; p++)
+                    d -= l[j * N + p] * l[j * N + p];
+
+                positive = positive && d > static_cast<T>(0);
+                l[j * N + j] = std::sqrt(d);
+
+                for (int i = j + 1; i < N; i++) {
+                    T s = x[i * N + j];
+                    for (int p = 0; p < j; p++)
+                        s -= l[i * N + p] * l[j * N + p];
+                    l[i * N + j] = s / l[j * N + j];
+                }
+            }
+
+            return positive;
+        }
+    };
+}
+
+    class LinearAlgebraHelper {
+    public:
+        // width of panels for blocked factorizations
+        static FORCEINLINE int blockSize() { return 32; }
+
+        // matrices up to this order go to linalg::Tiny kernels
+        static FORCEINLINE int maxTinyOrder() { return 8; }
+
+        static FORCEINLINE int maxThreads() {
+#ifdef _OPENMP
+            return omp_in_parallel() ? 1 : omp_get_max_threads();
+#else
+            return 1;
+#endif
+        }
+
+        /**
+         * LU factorization with partial pivoting in place: P * A = L * U, L has unit diagonal and shares storage with U.
+         * Rows i and pivots[i] were swapped at step i. swaps gets number of actual row swaps.
+         * Returns false if matrix is singular, factorization is complete anyway.
+         */
+        template <typename T>
+        static bool getrf(T* a, int n, int* pivots, int& swaps) {
+            bool regular = true;
+            if (n > maxTinyOrder() && lapackGetrf(a, n, pivots, swaps, regular))
+                return regular;
+
+
+            swaps = 0;
+            const int nb = n <= 2 * blockSize() ? n : blockSize();
+
+            for (int k0 = 0; k0 < n; k0 += nb) {
+                const int k1 = std::min(n, k0 + nb);
+
+                // panel: columns [k0, k1) of rows [k0, n), row swaps are applied to whole rows
+                for (int j = k0; j < k1; j++) {
+                    int p = j;
+                    for (int i = j + 1; i < n; i++)
+                        if (std::abs(a[i * n + j]) > std::abs(a[p * n + j]))
+                            p = i;
+
+                    pivots[j] = p;
+                    if (a[p * n + j] == static_cast<T>(0)) {
+                        regular = false;
+                        continue;
+                    }
+
+                    if (p != j) {
+                        std::swap_ranges(a + j * n, a + (j + 1) * n, a + p * n);
+                        swaps++;
+                    }
+
+                    const T inv = static_cast<T>(1) / a[j * n + j];
+                    PRAGMA_OMP_PARALLEL_FOR_IF(static_cast<Nd4jLong>(n - j) * (k1 - j) > parallelThreshold() && maxThreads() > 1)
+                    for (int i = j + 1; i < n; i++) {
+                        const T l = a[i * n + j] * inv;
+                        a[i * n + j] = l;
+                        for (int c = j + 1; c < k1; c++)
+                            a[i * n + c] -= l * a[j * n + c];
+                    }
+                }
+
+                if (k1 == n)
+                    break;
+
+                // U12 = L11^-1 * A12
+                for (int j = k0; j < k1; j++)
+                    for (int i = j + 1; i < k1; i++) {
+                        const T l = a[i * n + j];
+                        PRAGMA_OMP_SIMD
+                        for (int c = k1; c < n; c++)
+                            a[i * n + c] -= l * a[j * n + c];
+                    }
+
+                // A22 -= L21 * U12
+                gemmUpdate<T>(n - k1, n - k1, k1 - k0, a + k1 * n + k0, n, a + k0 * n + k1, n, a + k1 * n + k1, n);
+            }
+
+            return regular;
+        }
+
+        /**
+         * Cholesky factorization in place: A = L * L^T, L is written into lower triangle of a, upper one is left as garbage.
+         * Returns false if matrix isn't positive definite, contents of a are unspecified then.
+         */
+        template <typename T>
+        static bool potrf(T* a, int n) {
+            int info = 0;
+            if (n > maxTinyOrder() && lapackPotrf(a, n, info))
+                return info == 0;
+
+            bool positive = true;
+            const int nb = n <= 2 * blockSize() ? n : blockSize();
+            std::vector<T> panelT;
+
+            for (int k0 = 0; k0 < n; k0 += nb) {
+                const int k1 = std::min(n, k0 + nb);
+
+                // L11 and L21 column by column, contributions of previous panels are already subtracted
+                for (int j = k0; j < k1; j++) {
+                    T d = a[j * n + j];
+                    for (int p = k0; p < j; p++)
+                        d -= a[j * n + p] * a[j * n + p];
+
+                    positive = positive && d > static_cast<T>(0);
+                    const T diag = std::sqrt(d);
+                    a[j * n + j] = diag;
+
+                    PRAGMA_OMP_PARALLEL_FOR_IF(static_cast<Nd4jLong>(n - j) * (j - k0 + 1) > parallelThreshold() && maxThreads() > 1)
+                    for (int i = j + 1; i < n; i++) {
+                        T s = a[i * n + j];
+                        for (int p = k0; p < j; p++)
+                            s -= a[i * n + p] * a[j * n + p];
+                        a[i * n + j] = s / diag;
+                    }
+                }
+
+                if (k1 == n)
+                    break;
+
+                // A22 -= L21 * L21^T
+                const int rest = n - k1;
+                const int width = k1 - k0;
+                panelT.resize(static_cast<size_t>(width) * rest);
+                for (int i = 0; i < rest; i++)
+                    for (int p = 0; p < width; p++)
+                        panelT[p * rest + i] = a[(k1 + i) * n + k0 + p];
+
+                gemmUpdate<T>(rest, rest, width, a + k1 * n + k0, n, panelT.data(), rest, a + k1 * n + k1, n);
+            }
+
+            return positive;
+        }
+
+        /**
+         * Solves A * X = B in place of B, A [n, n] is triangular, B is [n, m], both row-major.
+         * Only lower (or upper) triangle of A is read, unitDiagonal means diagonal of A is assumed to be ones.
+         */
+        template <typename T>
+        static void trsm(const T* a, int n, bool lower, bool unitDiagonal, T* b, int m) {
+            const int nb = blockSize();
+
+            if (lower) {
+                for (int i0 = 0; i0 < n; i0 += nb) {
+                    const int i1 = std::min(n, i0 + nb);
+
+                    // B[i0:i1] -= L[i0:i1, 0:i0] * X[0:i0]
+                    gemmUpdate<T>(i1 - i0, m, i0, a + i0 * n, n, b, m, b + i0 * m, m);
+
+                    for (int i = i0; i < i1; i++)
+                        solveRow<T>(a, n, b, m, i, i0, i, unitDiagonal);
+                }
+            }
+            else {
+                for (int i1 = n; i1 > 0; i1 -= nb) {
+                    const int i0 = std::max(0, i1 - nb);
+
+                    // B[i0:i1] -= U[i0:i1, i1:n] * X[i1:n]
+                    gemmUpdate<T>(i1 - i0, m, n - i1, a + i0 * n + i1, n, b + i1 * m, m, b + i0 * m, m);
+
+                    for (int i = i1 - 1; i >= i0; i--)
+                        solveRow<T>(a, n, b, m, i, i + 1, i1, unitDiagonal);
+                }
+            }
+        }
+
+        /**
+         * C[m, n] -= A[m, k] * B[k, n], all row-major with given leading dimensions
+         */
+        template <typename T>
+        static void gemmUpdate(int m, int n, int k, const T* a, int lda, const T* b, int ldb, T* c, int ldc) {
+            if (m <= 0 || n <= 0 || k <= 0)
+                return;
+
+            if (blasGemm(m, n, k, a, lda, b, ldb, c, ldc))
+                return;
+
+            PRAGMA_OMP_PARALLEL_FOR_IF(static_cast<Nd4jLong>(m) * n * k > parallelThreshold() && m > 1 && maxThreads() > 1)
+            for (int i = 0; i < m; i++) {
+                T* ci = c + static_cast<Nd4jLong>(i) * ldc;
+                for (int p = 0; p < k; p++) {
+                    const T aip = a[static_cast<Nd4jLong>(i) * lda + p];
+                    const T* bp = b + static_cast<Nd4jLong>(p) * ldb;
+
+                    PRAGMA_OMP_SIMD
+                    for (int j = 0; j < n; j++)
+                        ci[j] -= aip * bp[j];
+                }
+            }
+        }
+
+    private:
+        // minimal amount of multiply-adds to go parallel
+        static FORCEINLINE Nd4jLong parallelThreshold() { return 65536; }
+
+        // row i of X: b_i = (b_i - sum_{p in [p0, p1)} a_ip * x_p) / a_ii
+        template <typename T>
+        static FORCEINLINE void solveRow(const T* a, int n, T* b, int m, int i, int p0, int p1, bool unitDiagonal) {
+            T* bi = b + static_cast<Nd4jLong>(i) * m;
+            for (int p = p0; p < p1; p++) {
+                const T l = a[i * n + p];
+                const T* bp = b + static_cast<Nd4jLong>(p) * m;
+
+                PRAGMA_OMP_SIMD
+                for (int j = 0; j < m; j++)
+                    bi[j] -= l * bp[j];
+            }
+
+            if (!unitDiagonal) {
+                const T inv = static_cast<T>(1) / a[i * n + i];
+
+                PRAGMA_OMP_SIMD
+                for (int j = 0; j < m; j++)
+                    bi[j] *= inv;
+            }
+        }
+
+        template <typename T>
+        static FORCEINLINE bool blasGemm(int m, int n, int k, const T* a, int lda, const T* b, int ldb, T* c, int ldc) {
+            return false;
+        }
+
+        // BLAS call overhead isn't worth it for tiny updates
+        static FORCEINLINE bool worthBlas(int m, int n, int k) {
+            return static_cast<Nd4jLong>(m) * n * k >= 32768;
+        }
+
+        static FORCEINLINE bool blasGemm(int m, int n, int k, const float* a, int lda, const float* b, int ldb, float* c, int ldc) {
+            if (!worthBlas(m, n, k) || !BlasHelper::getInstance()->hasGEMM<float>())
+                return false;
+
+            BlasHelper::getInstance()->sgemm()(CblasRowMajor, CblasNoTrans, CblasNoTrans, m, n, k, -1.0f, const_cast<float*>(a), lda, const_cast<float*>(b), ldb, 1.0f, c, ldc);
+            return true;
+        }
+
+        static FORCEINLINE bool blasGemm(int m, int n, int k, const double* a, int lda, const double* b, int ldb, double* c, int ldc) {
+            if (!worthBlas(m, n, k) || !BlasHelper::getInstance()->hasGEMM<double>())
+                return false;
+
+            BlasHelper::getInstance()->dgemm()(CblasRowMajor, CblasNoTrans, CblasNoTrans, m, n, k, -1.0, const_cast<double*>(a), lda, const_cast<double*>(b), ldb, 1.0, c, ldc);
+            return true;
+        }
+
+        template <typename T>
+        static FORCEINLINE bool lapackGetrf(T* a, int n, int* pivots, int& swaps, bool& regular) {
+            return false;
+        }
+
+        template <typename T>
+        static FORCEINLINE bool lapackPotrf(T* a, int n, int& info) {
+            return false;
+        }
+
+        // LAPACK pivots are 1-based
+        static FORCEINLINE void lapackPivots(int n, int* pivots, int& swaps) {
+            swaps = 0;
+            for (int i = 0; i < n; i++) {
+                pivots[i]--;
+                if (pivots[i] != i)
+                    swaps++;
+            }
+        }
+
+        static FORCEINLINE bool lapackGetrf(float* a, int n, int* pivots, int& swaps, bool& regular) {
+            auto getrf = BlasHelper::getInstance()->sgetrf();
+            if (getrf == nullptr)
+                return false;
+
+            const int info = getrf(LAPACK_ROW_MAJOR, n, n, a, n, pivots);
+            if (info < 0)
+                return false;
+
+            regular = info == 0;
+            lapackPivots(n, pivots, swaps);
+            return true;
+        }
+
+        static FORCEINLINE bool lapackGetrf(double* a, int n, int* pivots, int& swaps, bool& regular) {
+            auto getrf = BlasHelper::getInstance()->dgetrf();
+            if (getrf == nullptr)
+                return false;
+
+            const int info = getrf(LAPACK_ROW_MAJOR, n, n, a, n, pivots);
+            if (info < 0)
+                return false;
+
+            regular = info == 0;
+            lapackPivots(n, pivots, swaps);
+            return true;
+        }
+
+        static FORCEINLINE bool lapackPotrf(float* a, int n, int& info) {
+            auto potrf = BlasHelper::getInstance()->spotrf();
+            if (potrf == nullptr)
+                return false;
+
+            info = potrf(LAPACK_ROW_MAJOR, 'L', n, a, n);
+            return true;
+        }
+
+        static FORCEINLINE bool lapackPotrf(double* a, int n, int& info) {
+            auto potrf = BlasHelper::getInstance()->dpotrf();
+            if (potrf == nullptr)
+                return false;
+
+            info = potrf(LAPACK_ROW_MAJOR, 'L', n, a, n);
+            return true;
+        }
+    };
+}
+
+#endif //LIBND4J_LINEARALGEBRAHELPER_H
@@ -0,0 +1,122 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Process-wide LRU cache of MKL-DNN primitives, keyed by op name, shapes, strides, data types and op arguments
+//
+
+#ifndef LIBND4J_MKLDNNCACHE_H
+#define LIBND4J_MKLDNNCACHE_H
+
+#ifndef __STANDALONE_BUILD__
+#include "config.h"
+#endif
+
+#ifdef HAVE_MKLDNN
+#include <mkldnn.hpp>
+#include <NDArray.h>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nd4j {
+
+    /**
+     * Primitives built for one set of shapes and arguments, together with memory they operate on.
+     * Memory bound to op arrays gets data pointers of new arrays every time primitives are reused.
+     */
+    class ND4J_EXPORT MKLDNNPrimitives {
+    public:
+        std::vector<mkldnn::memory> _memory;
+        std::vector<mkldnn::primitive> _operations;
+
+        // pairs of memory index and array index
+        std::vector<std::pair<int, int>> _bindings;
+
+        void bind(const std::vector<const NDArray*> &arrays);
+    };
+
+    class ND4J_EXPORT MKLDNNCache {
+    private:
+        static MKLDNNCache* _instance;
+
+        typedef std::pair<std::string, std::shared_ptr<MKLDNNPrimitives>> Entry;
+
+        mkldnn::engine _engine = mkldnn::engine(mkldnn::engine::cpu, 0);
+
+        std::mutex _mutex;
+        size_t _capacity = 256;
+
+        // idle primitives, most recently used first. the same key can be present several times,
+        // since primitives are taken out of cache while being executed
+        std::list<Entry> _entries;
+        std::unordered_multimap<std::string, std::list<Entry>::iterator> _index;
+
+        std::atomic<Nd4jLong> _hits;
+        std::atomic<Nd4jLong> _misses;
+        std::atomic<Nd4jLong> _evictions;
+
+        MKLDNNCache();
+
+        void evictOne();
+
+    public:
+        static MKLDNNCache* getInstance();
+
+        /**
+         * All cached primitives are created for this engine
+         */
+        const mkldnn::engine& getEngine() { return _engine; }
+
+        /**
+         * This method builds cache key for given op name, arrays and arguments
+         */
+        static std::string keyOf(const std::string &opName, const std::vector<const NDArray*> &inputs, const std::vector<const NDArray*> &outputs,
+                const std::vector<float> &floatArguments, const std::vector<int> &intArguments);
+
+        /**
+         * This method takes primitives out of cache, so they can't be used concurrently. Returns nullptr on miss.
+         */
+        std::shared_ptr<MKLDNNPrimitives> acquire(const std::string &key);
+
+        /**
+         * This method puts primitives back into cache, least recently used ones are evicted if cache is full
+         */
+        void release(const std::string &key, const std::shared_ptr<MKLDNNPrimitives> &primitives);
+
+        void setCapacity(size_t capacity);
+        size_t capacity();
+        size_t size();
+
+        Nd4jLong hits();
+        Nd4jLong misses();
+        Nd4jLong evictions();
+        double hitRate();
+
+        /**
+         * This method drops all cached primitives and resets counters
+         */
+        void purge();
+    };
+}
+#endif
+
+#endif //LIBND4J_MKLDNNCACHE_H
@@ -27,20 +27,34 @@
 
 #ifdef HAVE_MKLDNN
 #include <mkldnn.hpp>
+#include <helpers/MKLDNNCache.h>
+#include <algorithm>
 
 namespace nd4j {
+    /**
+     * Primitives are taken from process-wide MKLDNNCache by shapes and arguments, so new arrays with the same shapes
+     * don't cause rebuild: memory added with addMemory(memory, array) just gets buffer of new array.
+     * Primitives go back to cache only after successful execution, so partially built ones are never reused.
+     */
     class MKLDNNStream {
     protected:
         std::string _opName;
+        std::string _key;
 
-        std::vector<const NDArray*> _inputs;
-        std::vector<const NDArray*> _outputs;
-        std::vector<float> _floatArguments;
-        std::vector<int> _intArguments;
+        // inputs followed by outputs
+        std::vector<const NDArray*> _arrays;
 
-        mkldnn::engine _engine = mkldnn::engine(mkldnn::engine::cpu, 0);
-        std::vector<mkldnn::memory> _memory;
-        std::vector<mkldnn::primitive> _operations;
+        mkldnn::engine _engine = MKLDNNCache::getInstance()->getEngine();
+        std::shared_ptr<MKLDNNPrimitives> _primitives;
+
+        // returns primitives to cache if they were executed successfully, otherwise just drops them
+        void release(bool executed) {
+            // copies of this stream might share primitives, only last one returns them
+            if (executed && _primitives != nullptr && _primitives.unique())
+                MKLDNNCache::getInstance()->release(_key, _primitives);
+
+            _primitives.reset();
+        }
 
     public:
         template <typename X, typename Y>
@@ -59,36 +73,68 @@ namespace nd4j {
 
         MKLDNNStream(const std::string &opName) : _opName(opName) { }
 
+        ~MKLDNNStream() {
+            // primitives left here weren't executed, i.e. building them has thrown
+            release(false);
+        }
+
+        /**
+         * This method returns true if primitives have to be built, false if they were found in cache
+         * and are bound to given arrays already
+         */
         bool checkAndReset(const std::vector<const NDArray*> &inputs, const std::vector<const NDArray*> &outputs,
                 const std::vector<float> &floatArguments, const std::vector<int> &intArguments) {
-            if (inputs != _inputs || outputs != _outputs || floatArguments != _floatArguments || intArguments != _intArguments) {
-                _inputs = inputs;
-                _outputs = outputs;
-                _floatArguments = floatArguments;
-                _intArguments = intArguments;
-                _operations.clear();
-                _memory.clear();
-                return true;
+            auto key = MKLDNNCache::keyOf(_opName, inputs, outputs, floatArguments, intArguments);
+
+            _arrays = inputs;
+            _arrays.insert(_arrays.end(), outputs.begin(), outputs.end());
+
+            if (_primitives == nullptr || key != _key) {
+                release(false);
+                _key = key;
+                _primitives = MKLDNNCache::getInstance()->acquire(_key);
+
+                if (_primitives == nullptr) {
+                    nd4j_debug("Building MKL-DNN primitives for %s\n", _opName.c_str());
+                    _primitives = std::make_shared<MKLDNNPrimitives>();
+                    return true;
+                }
             }
+
+            _primitives->bind(_arrays);
             return false;
         }
 
         const mkldnn::engine &getEngine() { return _engine; }
         void setEngine(const mkldnn::engine &engine) { _engine = engine; }
 
-        const std::vector<mkldnn::memory> &getMemory() { return _memory; }
-        void setMemory(const std::vector<mkldnn::memory> &memory) { _memory = memory; }
-        void addMemory(const mkldnn::memory &memory) { _memory.push_back(memory); }
+        const std::vector<mkldnn::memory> &getMemory() { return _primitives->_memory; }
+        void setMemory(const std::vector<mkldnn::memory> &memory) { _primitives->_memory = memory; _primitives->_bindings.clear(); }
+        void addMemory(const mkldnn::memory &memory) { _primitives->_memory.push_back(memory); }
+
+        /**
+         * This method adds memory which uses buffer of given array, one of arrays passed to checkAndReset()
+         */
+        void addMemory(const mkldnn::memory &memory, const NDArray* array) {
+            auto it = std::find(_arrays.begin(), _arrays.end(), array);
+            if (array == nullptr || it == _arrays.end())
+                throw std::runtime_error("MKLDNNStream: memory can be bound only to op inputs or outputs");
+
+            _primitives->_bindings.emplace_back(static_cast<int>(_primitives->_memory.size()), static_cast<int>(it - _arrays.begin()));
+            _primitives->_memory.push_back(memory);
+        }
 
-        const std::vector<mkldnn::primitive> &getOperations() { return _operations; }
-        void setOperations(const std::vector<mkldnn::primitive> &operations) { _operations = operations; }
-        void addOperation(const mkldnn::primitive &operation) { _operations.push_back(operation); }
+        const std::vector<mkldnn::primitive> &getOperations() { return _primitives->_operations; }
+        void setOperations(const std::vector<mkldnn::primitive> &operations) { _primitives->_operations = operations; }
+        void addOperation(const mkldnn::primitive &operation) { _primitives->_operations.push_back(operation); }
 
         bool submitAndWait(mkldnn::stream::kind kind = mkldnn::stream::kind::eager) {
             nd4j_debug("Executing %s with MKL-DNN\n", _opName.c_str());
             // need to create a new one because already executed streams become unusable
             mkldnn::stream stream(kind);
-            return stream.submit(_operations).wait();
+            auto result = stream.submit(_primitives->_operations).wait();
+            release(result);
+            return result;
         }
     };
 }
@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Accuracy tiers of transcendental transforms, kept apart from VectorMath.h so Environment.h doesn't pull kernels in
+//
+
+#ifndef LIBND4J_MATHPRECISION_H
+#define LIBND4J_MATHPRECISION_H
+
+namespace nd4j {
+
+    /**
+     * Accuracy tiers of transcendental transforms, see Environment::setMathPrecision()
+     *
+     * MATH_LIBM   - scalar libm calls, same as platformmath.h. This is the default
+     * MATH_VECTOR - vectorised kernels, float results within bounds documented in VectorMath.h
+     * MATH_FAST   - vectorised kernels with shorter polynomials and no special values handling:
+     *               inputs are clamped to the range where results are finite and normal
+     */
+    enum MathPrecision {
+        MATH_LIBM = 0,
+        MATH_VECTOR = 1,
+        MATH_FAST = 2,
+    };
+}
+
+#endif //LIBND4J_MATHPRECISION_H
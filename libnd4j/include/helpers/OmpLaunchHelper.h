@@ -25,6 +25,8 @@
 #include <vector>
 #include <pointercast.h>
 #include <op_boilerplate.h>
+#include <array/DataType.h>
+#include <helpers/ThresholdsTuner.h>
 
 namespace nd4j {
 
@@ -36,6 +38,9 @@ class OmpLaunchHelper {
         
         OmpLaunchHelper(const Nd4jLong N, float desiredNumThreads = -1);
 
+        // thresholds are taken from ThresholdsTuner table for given loop family and data type
+        OmpLaunchHelper(const Nd4jLong N, float desiredNumThreads, LoopFamily::Family family, nd4j::DataType dataType);
+
         FORCEINLINE Nd4jLong getThreadOffset(const int threadNum);
         FORCEINLINE Nd4jLong getItersPerThread(const int threadNum);
 
@@ -45,7 +50,10 @@ class OmpLaunchHelper {
         static int betterThreads(Nd4jLong N);
         static int betterThreads(Nd4jLong N, int maxThreads);
 
+        static int betterThreads(Nd4jLong N, int maxThreads, LoopFamily::Family family, nd4j::DataType dataType);
+
         static int tadThreads(Nd4jLong tadLength, Nd4jLong numTads);
+        static int tadThreads(Nd4jLong tadLength, Nd4jLong numTads, LoopFamily::Family family, nd4j::DataType dataType);
 
         int _numThreads;
 		unsigned int _itersPerThread;
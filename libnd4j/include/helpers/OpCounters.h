@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Per-op performance registry: wall time and hardware counters (helpers/PerfCounters.h), aggregated per op name and
+// shape class, plus achieved GFLOP/s and GB/s derived from op cost model.
+//
+// Cost model gives floating point operations and bytes of compulsory memory traffic for single op invocation.
+// Default model is one operation per element of the largest operand and every input and output read/written once,
+// which is exact enough for element-wise ops and reductions. Ops doing more work per element (matmul, convolutions,
+// softmax) declare their own model via declareCost(). Legacy ops always use default model.
+//
+// Shape class is data type of the first operand plus power-of-two bucket of the largest operand length, so the same
+// op on tiny and huge arrays is reported separately. Ops executed inside other ops are counted for both.
+//
+
+#ifndef LIBND4J_OPCOUNTERS_H
+#define LIBND4J_OPCOUNTERS_H
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <dll.h>
+#include <pointercast.h>
+#include <array/DataType.h>
+#include <helpers/PerfCounters.h>
+#include <graph/generated/utils_generated.h>
+
+namespace nd4j {
+
+    class NDArray;
+
+    struct ND4J_EXPORT OpCost {
+        double flops = 0.0;
+        double bytes = 0.0;
+    };
+
+    typedef OpCost (*OpCostFunction)(const std::vector<NDArray*>& inputs, const std::vector<NDArray*>& outputs, const std::vector<int>& iArgs);
+
+    struct ND4J_EXPORT OpCountersEntry {
+        std::string opName;
+        std::string shapeClass;
+        Nd4jLong invocations = 0L;
+        Nd4jLong time = 0L;
+        PerfSample counters;
+        double flops = 0.0;
+        double bytes = 0.0;
+
+        double gflops() const;
+        double gbps() const;
+        double ipc() const;
+    };
+
+    class ND4J_EXPORT OpCounters {
+    private:
+        static OpCounters* _instance;
+
+        std::atomic<bool> _enabled;
+
+        std::mutex _mutex;
+        std::map<std::string, OpCostFunction> _costs;
+        std::map<std::pair<std::string, std::string>, OpCountersEntry> _entries;
+        std::string _report;
+
+        OpCounters();
+
+    public:
+        static OpCounters* getInstance();
+
+        /**
+         * Enables or disables collection, hardware counters are opened/closed accordingly
+         */
+        void setEnabled(bool reallyEnable);
+        bool isEnabled();
+
+        /**
+         * Declares cost model for given op name, replacing previous one
+         */
+        void declareCost(const std::string& opName, OpCostFunction function);
+
+        /**
+         * Cost of single invocation, declared model if there's one, default model otherwise
+         */
+        OpCost costOf(const std::string& opName, const std::vector<NDArray*>& inputs, const std::vector<NDArray*>& outputs, const std::vector<int>& iArgs);
+
+        static OpCost defaultCost(const std::vector<NDArray*>& inputs, const std::vector<NDArray*>& outputs, const std::vector<int>& iArgs);
+
+        static std::string shapeClass(nd4j::DataType dataType, Nd4jLong length);
+
+        /**
+         * Records single invocation of custom op
+         */
+        void record(const std::string& opName, const std::vector<NDArray*>& inputs, const std::vector<NDArray*>& outputs, const std::vector<int>& iArgs, Nd4jLong time, const PerfSample& counters);
+
+        /**
+         * Records single invocation with precomputed shape class and cost
+         */
+        void record(const std::string& opName, const std::string& shapeClass, const OpCost& cost, Nd4jLong time, const PerfSample& counters);
+
+        std::vector<OpCountersEntry> entries();
+
+        /**
+         * CSV report, one line per op and shape class, sorted by total time. Hardware counter columns are -1 if
+         * counters aren't available. Returned pointer is valid until next call.
+         */
+        const char* report();
+
+        void reset();
+
+        /**
+         * Monotonic clock used for timings, in nanoseconds
+         */
+        static Nd4jLong currentTime();
+    };
+
+    /**
+     * Counts legacy op invocation for the lifetime of the scope, if OpCounters are enabled
+     */
+    class ND4J_EXPORT OpCountersScope {
+    private:
+        bool _active;
+        nd4j::graph::OpType _opType;
+        int _opNum;
+        Nd4jLong *_x, *_y, *_z;
+        Nd4jLong _start = 0L;
+        PerfSample _counters;
+
+    public:
+        OpCountersScope(nd4j::graph::OpType opType, int opNum, Nd4jLong *xShapeInfo, Nd4jLong *yShapeInfo, Nd4jLong *zShapeInfo);
+        ~OpCountersScope();
+    };
+}
+
+#endif //LIBND4J_OPCOUNTERS_H
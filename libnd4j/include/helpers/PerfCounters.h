@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Hardware performance counters: cycles, instructions, last level cache misses and branch misses.
+//
+// On Linux counters come from perf_event_open(2). Each thread which takes part in op execution (caller thread and
+// OpenMP pool threads) gets its own counter group, and read() sums all of them, so delta between two reads covers
+// parallel regions as well. Work done concurrently by unrelated threads is counted too. Elsewhere, or when kernel
+// doesn't allow user-space counting (see /proc/sys/kernel/perf_event_paranoid), isAvailable() returns false and
+// read() returns zeros.
+//
+
+#ifndef LIBND4J_PERFCOUNTERS_H
+#define LIBND4J_PERFCOUNTERS_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <dll.h>
+#include <pointercast.h>
+
+namespace nd4j {
+
+    struct ND4J_EXPORT PerfSample {
+        Nd4jLong cycles = 0L;
+        Nd4jLong instructions = 0L;
+        Nd4jLong llcMisses = 0L;
+        Nd4jLong branchMisses = 0L;
+
+        PerfSample operator-(const PerfSample& other) const;
+        PerfSample& operator+=(const PerfSample& other);
+    };
+
+    class ND4J_EXPORT PerfCounters {
+    private:
+        static PerfCounters* _instance;
+
+        std::atomic<bool> _enabled;
+        std::atomic<bool> _available;
+        std::atomic<int> _generation;
+
+        std::mutex _mutex;
+        // group leader descriptors, one per attached thread
+        std::vector<int> _groups;
+
+        PerfCounters();
+
+        // opens counter group for calling thread, unless it's opened already
+        void attachCurrentThread();
+        void closeGroups();
+
+    public:
+        static PerfCounters* getInstance();
+
+        /**
+         * Opens counters for calling thread and OpenMP pool threads. Returns false if counters aren't available.
+         */
+        bool enable();
+
+        /**
+         * Closes all counters
+         */
+        void disable();
+
+        bool isEnabled();
+
+        /**
+         * True if hardware counters can be used on this system, meaningful after enable()
+         */
+        bool isAvailable();
+
+        /**
+         * Current counter values, summed over all attached threads. Calling thread is attached on first use.
+         */
+        PerfSample read();
+    };
+}
+
+#endif //LIBND4J_PERFCOUNTERS_H
@@ -0,0 +1,227 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Prefix scan engine behind cumsum/cumprod and scan-based helpers (offsets, compaction).
+//
+// Long sequences use blocked two-pass reduce-then-scan: every thread reduces its block (8 independent accumulators,
+// so the loop vectorizes), block totals are scanned serially, then every thread scans its block seeded with the carry.
+// Many short TADs are spread over threads instead, each TAD is scanned serially.
+// Results of parallel scans of floating point values may differ from serial ones in rounding only.
+//
+
+#ifndef LIBND4J_PREFIXSCAN_H
+#define LIBND4J_PREFIXSCAN_H
+
+#include <algorithm>
+#include <vector>
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <helpers/shape.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace nd4j {
+namespace scan {
+
+    template <typename T>
+    struct Add {
+        static FORCEINLINE T identity() { return static_cast<T>(0); }
+        static FORCEINLINE T op(const T& a, const T& b) { return static_cast<T>(a + b); }
+    };
+
+    template <typename T>
+    struct Multiply {
+        static FORCEINLINE T identity() { return static_cast<T>(1); }
+        static FORCEINLINE T op(const T& a, const T& b) { return static_cast<T>(a * b); }
+    };
+}
+
+    class PrefixScan {
+    public:
+        // minimal number of elements per thread for parallel scan
+        static FORCEINLINE Nd4jLong parallelGrain() { return 32768; }
+
+        static FORCEINLINE int maxThreads() {
+#ifdef _OPENMP
+            return omp_in_parallel() ? 1 : omp_get_max_threads();
+#else
+            return 1;
+#endif
+        }
+
+        /**
+         * Scan of x[0], x[xStride], ... into z[0], z[zStride], ...
+         * inclusive: z[i] = x[0] op ... op x[i], exclusive: z[i] = x[0] op ... op x[i - 1] and z[0] = identity.
+         * Reverse scan goes from the last element to the first one. x and z may be the same buffer.
+         * Returns reduction of all elements.
+         */
+        template <typename T, typename Op>
+        static T scan(const T* x, Nd4jLong xStride, T* z, Nd4jLong zStride, Nd4jLong length, bool exclusive, bool reverse, int numThreads = maxThreads()) {
+            if (length <= 0)
+                return Op::identity();
+
+            if (reverse) {
+                x += (length - 1) * xStride;
+                z += (length - 1) * zStride;
+                xStride = -xStride;
+                zStride = -zStride;
+            }
+
+            const int numBlocks = threadsFor(length, numThreads);
+            if (numBlocks == 1)
+                return scanBlock<T, Op>(x, xStride, z, zStride, length, exclusive, Op::identity());
+
+            const Nd4jLong span = (length + numBlocks - 1) / numBlocks;
+            std::vector<T> carries(numBlocks + 1, Op::identity());
+
+            PRAGMA_OMP_PARALLEL_FOR_THREADS(numBlocks)
+            for (int b = 0; b < numBlocks; b++) {
+                const Nd4jLong start = b * span;
+                const Nd4jLong stop = std::min<Nd4jLong>(length, start + span);
+                if (start < stop)
+                    carries[b + 1] = reduceBlock<T, Op>(x + start * xStride, xStride, stop - start);
+            }
+
+            for (int b = 0; b < numBlocks; b++)
+                carries[b + 1] = Op::op(carries[b], carries[b + 1]);
+
+            PRAGMA_OMP_PARALLEL_FOR_THREADS(numBlocks)
+            for (int b = 0; b < numBlocks; b++) {
+                const Nd4jLong start = b * span;
+                const Nd4jLong stop = std::min<Nd4jLong>(length, start + span);
+                if (start < stop)
+                    scanBlock<T, Op>(x + start * xStride, xStride, z + start * zStride, zStride, stop - start, exclusive, carries[b]);
+            }
+
+            return carries[numBlocks];
+        }
+
+        /**
+         * Scan of contiguous buffer
+         */
+        template <typename T, typename Op>
+        static T scan(const T* x, T* z, Nd4jLong length, bool exclusive, bool reverse = false, int numThreads = maxThreads()) {
+            return scan<T, Op>(x, 1, z, 1, length, exclusive, reverse, numThreads);
+        }
+
+        /**
+         * Scan of array described by xShapeInfo into array described by zShapeInfo, elements are enumerated in logical order.
+         * Arrays without elementwise stride are scanned serially.
+         */
+        template <typename T, typename Op>
+        static void scan(const T* x, const Nd4jLong* xShapeInfo, T* z, const Nd4jLong* zShapeInfo, bool exclusive, bool reverse, int numThreads = maxThreads()) {
+            auto xShape = const_cast<Nd4jLong*>(xShapeInfo);
+            auto zShape = const_cast<Nd4jLong*>(zShapeInfo);
+            const Nd4jLong length = shape::length(xShape);
+            const Nd4jLong xEws = shape::elementWiseStride(xShape);
+            const Nd4jLong zEws = shape::elementWiseStride(zShape);
+
+            if (xEws >= 1 && zEws >= 1 && (length == 1 || (shape::order(xShape) == 'c' && shape::order(zShape) == 'c'))) {
+                scan<T, Op>(x, xEws, z, zEws, length, exclusive, reverse, numThreads);
+                return;
+            }
+
+            T sum = Op::identity();
+            for (Nd4jLong i = 0; i < length; i++) {
+                const Nd4jLong e = reverse ? length - i - 1 : i;
+                const T v = x[shape::getIndexOffset(e, xShape, length)];
+                const Nd4jLong zOffset = shape::getIndexOffset(e, zShape, length);
+
+                if (exclusive) {
+                    z[zOffset] = sum;
+                    sum = Op::op(sum, v);
+                } else {
+                    sum = Op::op(sum, v);
+                    z[zOffset] = sum;
+                }
+            }
+        }
+
+        /**
+         * Batched mode: scans every TAD of x into corresponding TAD of z.
+         * Many TADs are spread over threads, few long TADs are scanned one by one, each in parallel.
+         */
+        template <typename T, typename Op>
+        static void scanTads(const T* x, const Nd4jLong* xTadShapeInfo, const Nd4jLong* xTadOffsets, T* z, const Nd4jLong* zTadShapeInfo, const Nd4jLong* zTadOffsets, Nd4jLong numTads, bool exclusive, bool reverse) {
+            const Nd4jLong tadLength = shape::length(const_cast<Nd4jLong*>(xTadShapeInfo));
+            const int numThreads = maxThreads();
+
+            if (numTads >= numThreads || tadLength < parallelGrain()) {
+                PRAGMA_OMP_PARALLEL_FOR_ARGS(if(numTads > 1) schedule(guided))
+                for (Nd4jLong t = 0; t < numTads; t++)
+                    scan<T, Op>(x + xTadOffsets[t], xTadShapeInfo, z + zTadOffsets[t], zTadShapeInfo, exclusive, reverse, 1);
+            }
+            else {
+                for (Nd4jLong t = 0; t < numTads; t++)
+                    scan<T, Op>(x + xTadOffsets[t], xTadShapeInfo, z + zTadOffsets[t], zTadShapeInfo, exclusive, reverse, numThreads);
+            }
+        }
+
+    private:
+        static FORCEINLINE int threadsFor(Nd4jLong length, int numThreads) {
+            const Nd4jLong byGrain = length / parallelGrain();
+            return static_cast<int>(std::max<Nd4jLong>(1, std::min<Nd4jLong>(numThreads, byGrain)));
+        }
+
+        template <typename T, typename Op>
+        static T reduceBlock(const T* x, Nd4jLong stride, Nd4jLong length) {
+            T total = Op::identity();
+            Nd4jLong e = 0;
+
+            if (stride == 1) {
+                T acc[8];
+                for (int l = 0; l < 8; l++)
+                    acc[l] = Op::identity();
+
+                for (; e + 8 <= length; e += 8)
+                    for (int l = 0; l < 8; l++)
+                        acc[l] = Op::op(acc[l], x[e + l]);
+
+                for (int l = 0; l < 8; l++)
+                    total = Op::op(total, acc[l]);
+            }
+
+            for (; e < length; e++)
+                total = Op::op(total, x[e * stride]);
+
+            return total;
+        }
+
+        template <typename T, typename Op>
+        static T scanBlock(const T* x, Nd4jLong xStride, T* z, Nd4jLong zStride, Nd4jLong length, bool exclusive, T sum) {
+            if (exclusive) {
+                for (Nd4jLong e = 0; e < length; e++) {
+                    const T v = x[e * xStride];
+                    z[e * zStride] = sum;
+                    sum = Op::op(sum, v);
+                }
+            }
+            else {
+                for (Nd4jLong e = 0; e < length; e++) {
+                    sum = Op::op(sum, x[e * xStride]);
+                    z[e * zStride] = sum;
+                }
+            }
+
+            return sum;
+        }
+    };
+}
+
+#endif //LIBND4J_PREFIXSCAN_H
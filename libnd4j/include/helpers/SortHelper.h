@@ -0,0 +1,442 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Sorting engine behind SpecialMethods::sortGeneric/sortTadGeneric, COO indices sort and sort-based ops.
+//
+// Numeric keys are sorted with parallel LSD radix sort (8 bits per pass) over order-preserving unsigned encoding:
+// sign bit flipped for signed integers, all bits flipped for negative floats and sign bit set for non-negative ones.
+// Passes where all keys share the same digit are skipped, so i.e. small indices cost 1-2 passes instead of 8.
+// Radix sort is stable, descending order is ascending order of inverted keys, so it's stable too.
+// Comparator-based sorts (i.e. lexicographic ones) go to parallel merge sort.
+//
+
+#ifndef LIBND4J_SORTHELPER_H
+#define LIBND4J_SORTHELPER_H
+
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+#include <type_traits>
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <helpers/shape.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace nd4j {
+namespace sort {
+
+    template <int size> struct UnsignedOf;
+    template <> struct UnsignedOf<1> { typedef uint8_t type; };
+    template <> struct UnsignedOf<2> { typedef uint16_t type; };
+    template <> struct UnsignedOf<4> { typedef uint32_t type; };
+    template <> struct UnsignedOf<8> { typedef uint64_t type; };
+
+    /**
+     * Order-preserving mapping of T onto unsigned integer of the same width.
+     * Primary template covers IEEE-754 types: float16, bfloat16, float, double.
+     * NaNs end up at the ends of the range, ordered by their bit patterns.
+     */
+    template <typename T, bool isIntegral = std::is_integral<T>::value, bool isSigned = std::is_signed<T>::value>
+    struct RadixKey {
+        typedef typename UnsignedOf<sizeof(T)>::type K;
+        static const K sign = K(1) << (sizeof(K) * 8 - 1);
+
+        static FORCEINLINE K encode(const T& v) {
+            K k;
+            memcpy(&k, reinterpret_cast<const void*>(&v), sizeof(K));
+            return (k & sign) ? K(~k) : K(k | sign);
+        }
+
+        static FORCEINLINE T decode(K k) {
+            k = (k & sign) ? K(k ^ sign) : K(~k);
+            T v;
+            memcpy(reinterpret_cast<void*>(&v), &k, sizeof(K));
+            return v;
+        }
+    };
+
+    template <typename T>
+    struct RadixKey<T, true, true> {
+        typedef typename UnsignedOf<sizeof(T)>::type K;
+        static const K sign = K(1) << (sizeof(K) * 8 - 1);
+
+        static FORCEINLINE K encode(const T& v) { return K(K(v) ^ sign); }
+        static FORCEINLINE T decode(K k) { return static_cast<T>(K(k ^ sign)); }
+    };
+
+    template <typename T>
+    struct RadixKey<T, true, false> {
+        typedef typename UnsignedOf<sizeof(T)>::type K;
+
+        static FORCEINLINE K encode(const T& v) { return static_cast<K>(v); }
+        static FORCEINLINE T decode(K k) { return static_cast<T>(k); }
+    };
+}
+
+    class SortHelper {
+    public:
+        // arrays shorter than this are sorted with std::sort/std::stable_sort, must not exceed 256
+        static FORCEINLINE Nd4jLong radixThreshold() { return 256; }
+
+        // minimal number of elements per thread for parallel passes
+        static FORCEINLINE Nd4jLong parallelGrain() { return 32768; }
+
+        static FORCEINLINE int maxThreads() {
+#ifdef _OPENMP
+            return omp_in_parallel() ? 1 : omp_get_max_threads();
+#else
+            return 1;
+#endif
+        }
+
+        /**
+         * In-place sort of contiguous buffer
+         */
+        template <typename T>
+        static void sort(T* x, Nd4jLong length, bool descending, int numThreads = maxThreads()) {
+            typedef typename sort::RadixKey<T>::K K;
+            std::vector<K> keys, tmp;
+            sortStrided<T>(x, length, 1, nullptr, descending, numThreads, keys, tmp);
+        }
+
+        /**
+         * In-place sort of array described by xShapeInfo, elements are enumerated in logical order
+         */
+        template <typename T>
+        static void sort(T* x, Nd4jLong* xShapeInfo, bool descending, int numThreads = maxThreads()) {
+            typedef typename sort::RadixKey<T>::K K;
+            const Nd4jLong length = shape::length(xShapeInfo);
+            const Nd4jLong ews = shape::elementWiseStride(xShapeInfo);
+
+            std::vector<Nd4jLong> offsets;
+            if (ews < 1)
+                offsets = indexOffsets(xShapeInfo);
+
+            std::vector<K> keys, tmp;
+            sortStrided<T>(x, length, ews, offsets.empty() ? nullptr : offsets.data(), descending, numThreads, keys, tmp);
+        }
+
+        /**
+         * Segmented mode: sorts every TAD of x in place.
+         * Many TADs are spread over threads with guided scheduling, each thread reuses its own scratch buffers.
+         * When there are fewer TADs than threads, TADs are sorted one by one, each with all threads.
+         */
+        template <typename T>
+        static void sortTads(T* x, Nd4jLong* tadShapeInfo, Nd4jLong* tadOffsets, Nd4jLong numTads, bool descending) {
+            typedef typename sort::RadixKey<T>::K K;
+            const Nd4jLong tadLength = shape::length(tadShapeInfo);
+            const Nd4jLong tadEws = shape::elementWiseStride(tadShapeInfo);
+            const int numThreads = maxThreads();
+
+            if (tadLength < 2 || numTads < 1)
+                return;
+
+            // offsets within TAD are the same for all TADs, so they are evaluated once
+            std::vector<Nd4jLong> offsets;
+            if (tadEws < 1)
+                offsets = indexOffsets(tadShapeInfo);
+            const Nd4jLong* tadIndexOffsets = offsets.empty() ? nullptr : offsets.data();
+
+            if (numTads >= numThreads || tadLength < parallelGrain()) {
+                PRAGMA_OMP_PARALLEL_THREADS(numThreads)
+                {
+                    std::vector<K> keys, tmp;
+
+                    PRAGMA_OMP_FOR_ARGS(schedule(guided))
+                    for (Nd4jLong r = 0; r < numTads; r++)
+                        sortStrided<T>(x + tadOffsets[r], tadLength, tadEws, tadIndexOffsets, descending, 1, keys, tmp);
+                }
+            }
+            else {
+                std::vector<K> keys, tmp;
+
+                for (Nd4jLong r = 0; r < numTads; r++)
+                    sortStrided<T>(x + tadOffsets[r], tadLength, tadEws, tadIndexOffsets, descending, numThreads, keys, tmp);
+            }
+        }
+
+        /**
+         * Key-value mode: stable sort of keys, values are permuted along with them.
+         */
+        template <typename T, typename V>
+        static void sortByKey(T* keys, V* values, Nd4jLong length, bool descending, int numThreads = maxThreads()) {
+            typedef sort::RadixKey<T> R;
+            typedef typename R::K K;
+
+            if (length < 2)
+                return;
+
+            if (length < radixThreshold()) {
+                std::vector<std::pair<T, V>> pairs(length);
+                for (Nd4jLong e = 0; e < length; e++)
+                    pairs[e] = std::make_pair(keys[e], values[e]);
+
+                if (descending)
+                    std::stable_sort(pairs.begin(), pairs.end(), [](const std::pair<T, V>& a, const std::pair<T, V>& b) { return b.first < a.first; });
+                else
+                    std::stable_sort(pairs.begin(), pairs.end(), [](const std::pair<T, V>& a, const std::pair<T, V>& b) { return a.first < b.first; });
+
+                for (Nd4jLong e = 0; e < length; e++) {
+                    keys[e] = pairs[e].first;
+                    values[e] = pairs[e].second;
+                }
+                return;
+            }
+
+            numThreads = threadsFor(length, numThreads);
+            std::vector<K> encoded(length), tmp(length);
+            std::vector<V> valuesTmp(length);
+
+            encode<T>(keys, length, 1, nullptr, descending, encoded.data(), numThreads);
+            radixSort<K, V>(encoded.data(), values, tmp.data(), valuesTmp.data(), length, numThreads);
+            decode<T>(encoded.data(), length, 1, nullptr, descending, keys, numThreads);
+        }
+
+        /**
+         * Key-value mode with implicit values: writes into indices the permutation that stably sorts x, x itself is left intact.
+         */
+        template <typename T>
+        static void argSort(const T* x, Nd4jLong length, Nd4jLong* indices, bool descending, int numThreads = maxThreads()) {
+            typedef typename sort::RadixKey<T>::K K;
+
+            for (Nd4jLong e = 0; e < length; e++)
+                indices[e] = e;
+
+            if (length < 2)
+                return;
+
+            if (length < radixThreshold()) {
+                if (descending)
+                    std::stable_sort(indices, indices + length, [x](Nd4jLong a, Nd4jLong b) { return x[b] < x[a]; });
+                else
+                    std::stable_sort(indices, indices + length, [x](Nd4jLong a, Nd4jLong b) { return x[a] < x[b]; });
+                return;
+            }
+
+            numThreads = threadsFor(length, numThreads);
+            std::vector<K> encoded(length), tmp(length);
+            std::vector<Nd4jLong> indicesTmp(length);
+
+            encode<T>(x, length, 1, nullptr, descending, encoded.data(), numThreads);
+            radixSort<K, Nd4jLong>(encoded.data(), indices, tmp.data(), indicesTmp.data(), length, numThreads);
+        }
+
+        /**
+         * Stable parallel merge sort with arbitrary comparator: chunks are sorted independently, then merged pairwise
+         */
+        template <typename E, typename Less>
+        static void mergeSort(E* x, Nd4jLong length, Less less, int numThreads = maxThreads()) {
+            const int numChunks = threadsFor(length, numThreads);
+
+            if (numChunks <= 1) {
+                std::stable_sort(x, x + length, less);
+                return;
+            }
+
+            std::vector<Nd4jLong> bounds(numChunks + 1);
+            for (int c = 0; c <= numChunks; c++)
+                bounds[c] = length * c / numChunks;
+
+            PRAGMA_OMP_PARALLEL_FOR_THREADS(numChunks)
+            for (int c = 0; c < numChunks; c++)
+                std::stable_sort(x + bounds[c], x + bounds[c + 1], less);
+
+            std::vector<E> buffer(length);
+            E* src = x;
+            E* dst = buffer.data();
+
+            for (int width = 1; width < numChunks; width *= 2) {
+                const int numMerges = (numChunks + 2 * width - 1) / (2 * width);
+
+                PRAGMA_OMP_PARALLEL_FOR_THREADS(numMerges)
+                for (int m = 0; m < numMerges; m++) {
+                    const Nd4jLong lo = bounds[std::min(2 * m * width, numChunks)];
+                    const Nd4jLong mid = bounds[std::min((2 * m + 1) * width, numChunks)];
+                    const Nd4jLong hi = bounds[std::min((2 * m + 2) * width, numChunks)];
+
+                    // std::merge takes equal elements from the first range first, so stability is preserved
+                    std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, less);
+                }
+
+                std::swap(src, dst);
+            }
+
+            if (src != x)
+                std::copy(src, src + length, x);
+        }
+
+    private:
+        static FORCEINLINE int threadsFor(Nd4jLong length, int numThreads) {
+            const Nd4jLong byGrain = length / parallelGrain();
+            return static_cast<int>(std::max<Nd4jLong>(1, std::min<Nd4jLong>(numThreads, byGrain)));
+        }
+
+        static std::vector<Nd4jLong> indexOffsets(Nd4jLong* shapeInfo) {
+            const Nd4jLong length = shape::length(shapeInfo);
+            std::vector<Nd4jLong> offsets(length);
+
+            PRAGMA_OMP_PARALLEL_FOR_IF(length > parallelGrain())
+            for (Nd4jLong e = 0; e < length; e++)
+                offsets[e] = shape::getIndexOffset(e, shapeInfo, length);
+
+            return offsets;
+        }
+
+        // element e lives at x[offsets[e]] if offsets are given, at x[e * ews] otherwise
+        template <typename T, typename K>
+        static void encode(const T* x, Nd4jLong length, Nd4jLong ews, const Nd4jLong* offsets, bool descending, K* keys, int numThreads) {
+            const K flip = descending ? static_cast<K>(~K(0)) : K(0);
+
+            PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
+            for (Nd4jLong e = 0; e < length; e++)
+                keys[e] = sort::RadixKey<T>::encode(x[offsets == nullptr ? e * ews : offsets[e]]) ^ flip;
+        }
+
+        template <typename T, typename K>
+        static void decode(const K* keys, Nd4jLong length, Nd4jLong ews, const Nd4jLong* offsets, bool descending, T* x, int numThreads) {
+            const K flip = descending ? static_cast<K>(~K(0)) : K(0);
+
+            PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
+            for (Nd4jLong e = 0; e < length; e++)
+                x[offsets == nullptr ? e * ews : offsets[e]] = sort::RadixKey<T>::decode(keys[e] ^ flip);
+        }
+
+        /**
+         * LSD radix sort, 8 bits per pass. Each thread owns contiguous chunk of input: it counts digits of its chunk,
+         * then scatters it to positions given by digit-major/chunk-minor prefix sums, which keeps the sort stable.
+         * values may be nullptr, sorted data always ends up in keys/values.
+         */
+        template <typename K, typename V>
+        static void radixSort(K* keys, V* values, K* keysTmp, V* valuesTmp, Nd4jLong length, int numChunks) {
+            const Nd4jLong chunk = (length + numChunks - 1) / numChunks;
+            std::vector<Nd4jLong> histograms(numChunks * 256);
+
+            K* srcK = keys;
+            K* dstK = keysTmp;
+            V* srcV = values;
+            V* dstV = valuesTmp;
+
+            for (int shift = 0; shift < static_cast<int>(sizeof(K)) * 8; shift += 8) {
+                PRAGMA_OMP_PARALLEL_FOR_THREADS(numChunks)
+                for (int c = 0; c < numChunks; c++) {
+                    auto hist = histograms.data() + c * 256;
+                    const Nd4jLong start = c * chunk;
+                    const Nd4jLong stop = std::min(length, start + chunk);
+
+                    std::fill(hist, hist + 256, 0);
+                    for (Nd4jLong e = start; e < stop; e++)
+                        hist[(srcK[e] >> shift) & 0xFF]++;
+                }
+
+                // all keys have the same digit, this pass wouldn't move anything
+                const int digit = (srcK[0] >> shift) & 0xFF;
+                Nd4jLong sameDigit = 0;
+                for (int c = 0; c < numChunks; c++)
+                    sameDigit += histograms[c * 256 + digit];
+
+                if (sameDigit == length)
+                    continue;
+
+                Nd4jLong offset = 0;
+                for (int d = 0; d < 256; d++)
+                    for (int c = 0; c < numChunks; c++) {
+                        const Nd4jLong count = histograms[c * 256 + d];
+                        histograms[c * 256 + d] = offset;
+                        offset += count;
+                    }
+
+                PRAGMA_OMP_PARALLEL_FOR_THREADS(numChunks)
+                for (int c = 0; c < numChunks; c++) {
+                    auto position = histograms.data() + c * 256;
+                    const Nd4jLong start = c * chunk;
+                    const Nd4jLong stop = std::min(length, start + chunk);
+
+                    if (srcV != nullptr) {
+                        for (Nd4jLong e = start; e < stop; e++) {
+                            const Nd4jLong p = position[(srcK[e] >> shift) & 0xFF]++;
+                            dstK[p] = srcK[e];
+                            dstV[p] = srcV[e];
+                        }
+                    } else {
+                        for (Nd4jLong e = start; e < stop; e++)
+                            dstK[position[(srcK[e] >> shift) & 0xFF]++] = srcK[e];
+                    }
+                }
+
+                std::swap(srcK, dstK);
+                std::swap(srcV, dstV);
+            }
+
+            if (srcK != keys) {
+                memcpy(keys, srcK, length * sizeof(K));
+                if (values != nullptr)
+                    std::copy(srcV, srcV + length, values);
+            }
+        }
+
+        /**
+         * Sorts single array: x[e * ews] or x[offsets[e]], using (and growing if needed) caller's scratch buffers.
+         */
+        template <typename T, typename K>
+        static void sortStrided(T* x, Nd4jLong length, Nd4jLong ews, const Nd4jLong* offsets, bool descending, int numThreads,
+                                std::vector<K>& keys, std::vector<K>& tmp) {
+            if (length < 2)
+                return;
+
+            const bool contiguous = offsets == nullptr && ews == 1;
+
+            if (length < radixThreshold()) {
+                // short strided arrays are gathered on stack
+                T local[256];
+                T* data = x;
+                if (!contiguous) {
+                    data = local;
+                    for (Nd4jLong e = 0; e < length; e++)
+                        data[e] = x[offsets == nullptr ? e * ews : offsets[e]];
+                }
+
+                if (descending)
+                    std::sort(data, data + length, [](const T& a, const T& b) { return b < a; });
+                else
+                    std::sort(data, data + length, [](const T& a, const T& b) { return a < b; });
+
+                if (!contiguous)
+                    for (Nd4jLong e = 0; e < length; e++)
+                        x[offsets == nullptr ? e * ews : offsets[e]] = data[e];
+                return;
+            }
+
+            numThreads = threadsFor(length, numThreads);
+            if (keys.size() < static_cast<size_t>(length)) {
+                keys.resize(length);
+                tmp.resize(length);
+            }
+
+            // strided input is gathered while encoding and scattered back while decoding, so no extra copies
+            encode<T, K>(x, length, ews, offsets, descending, keys.data(), numThreads);
+            radixSort<K, Nd4jLong>(keys.data(), nullptr, tmp.data(), nullptr, length, numThreads);
+            decode<T, K>(keys.data(), length, ews, offsets, descending, x, numThreads);
+        }
+    };
+}
+
+#endif //LIBND4J_SORTHELPER_H
@@ -0,0 +1,339 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Loops over arrays with arbitrary strides, used when none of specialized LoopKind cases applies
+//
+// Instead of evaluating offset of every element with divisions by each dimension, shapes are coalesced first:
+// unit dimensions are dropped and neighbouring dimensions, contiguous with respect to each other, are merged.
+// Offsets are then advanced incrementally, and permuted copies are done tile by tile.
+//
+
+#ifndef LIBND4J_STRIDEDLOOPS_H
+#define LIBND4J_STRIDEDLOOPS_H
+
+#include <utility>
+#include <shape.h>
+#include <templatemath.h>
+#include <openmp_pragmas.h>
+
+namespace nd4j {
+
+class ND4J_EXPORT StridedLoops {
+
+    public:
+        // side of square tile for transposing loops: 32 x 32 elements of x and z stay in L1 cache
+        static const int TILE = 32;
+
+        struct Coalesced {
+            int rank;
+            Nd4jLong shape[MAX_RANK];
+            Nd4jLong xStride[MAX_RANK];
+            Nd4jLong zStride[MAX_RANK];
+        };
+
+        /**
+         * This method builds joint iteration space for x and z of the same shape, sorting dimensions by decreasing z stride
+         * @return false if shapes of x and z differ
+         */
+        static FORCEINLINE bool coalesce(const Nd4jLong* xShapeInfo, const Nd4jLong* zShapeInfo, Coalesced& dims);
+
+        /**
+         * z = op(x) over coalesced iteration space of x and z of the same shape
+         */
+        template <typename OpType, typename X, typename Z, typename E>
+        static FORCEINLINE void loopCoalesced(const X* x, Z* z, const Coalesced& dims, E* extraParams, const int numThreads);
+
+        /**
+         * z = op(x) for x and z of the same length but different shapes, elements are matched by their c-order indices
+         */
+        template <typename OpType, typename X, typename Z, typename E>
+        static FORCEINLINE void loopIncremental(const X* x, const Nd4jLong* xShapeInfo, Z* z, const Nd4jLong* zShapeInfo, E* extraParams, const int numThreads);
+
+    private:
+        // merges dimensions of single array, order of iteration is kept
+        static FORCEINLINE int coalesceOne(const Nd4jLong* shapeInfo, Nd4jLong* shape, Nd4jLong* stride);
+
+        // sets coordinates of element with given c-order index and returns its offset
+        static FORCEINLINE Nd4jLong init(const int rank, const Nd4jLong* shape, const Nd4jLong* stride, Nd4jLong index, Nd4jLong* coords);
+
+        // moves coordinates to next element in c order and returns new offset
+        static FORCEINLINE Nd4jLong advance(const int rank, const Nd4jLong* shape, const Nd4jLong* stride, Nd4jLong* coords, Nd4jLong offset);
+
+        static FORCEINLINE Nd4jLong absolute(const Nd4jLong value) { return value < 0 ? -value : value; }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+bool StridedLoops::coalesce(const Nd4jLong* xShapeInfo, const Nd4jLong* zShapeInfo, Coalesced& dims) {
+
+    if (!shape::shapeEquals(xShapeInfo, zShapeInfo))
+        return false;
+
+    const int rank = shape::rank(xShapeInfo);
+    const Nd4jLong* shape   = shape::shapeOf(const_cast<Nd4jLong*>(xShapeInfo));
+    const Nd4jLong* xStride = shape::stride(const_cast<Nd4jLong*>(xShapeInfo));
+    const Nd4jLong* zStride = shape::stride(const_cast<Nd4jLong*>(zShapeInfo));
+
+    // unit dimensions don't contribute to offsets
+    dims.rank = 0;
+    for (int e = 0; e < rank; e++) {
+        if (shape[e] == 1)
+            continue;
+
+        dims.shape[dims.rank] = shape[e];
+        dims.xStride[dims.rank] = xStride[e];
+        dims.zStride[dims.rank] = zStride[e];
+        dims.rank++;
+    }
+
+    if (dims.rank == 0) {
+        dims.rank = 1;
+        dims.shape[0] = 1;
+        dims.xStride[0] = dims.zStride[0] = 0;
+        return true;
+    }
+
+    // elements are matched by coordinates, so dimensions may go in any order: z is written as sequentially as possible
+    for (int i = 1; i < dims.rank; i++)
+        for (int j = i; j > 0 && absolute(dims.zStride[j - 1]) < absolute(dims.zStride[j]); j--) {
+            std::swap(dims.shape[j - 1], dims.shape[j]);
+            std::swap(dims.xStride[j - 1], dims.xStride[j]);
+            std::swap(dims.zStride[j - 1], dims.zStride[j]);
+        }
+
+    // outer dimension is merged into inner one, if it steps over whole inner dimension in both arrays
+    int last = 0;
+    for (int e = 1; e < dims.rank; e++) {
+        if (dims.xStride[last] == dims.xStride[e] * dims.shape[e] && dims.zStride[last] == dims.zStride[e] * dims.shape[e]) {
+            dims.shape[last] *= dims.shape[e];
+            dims.xStride[last] = dims.xStride[e];
+            dims.zStride[last] = dims.zStride[e];
+        } else {
+            last++;
+            dims.shape[last] = dims.shape[e];
+            dims.xStride[last] = dims.xStride[e];
+            dims.zStride[last] = dims.zStride[e];
+        }
+    }
+    dims.rank = last + 1;
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+int StridedLoops::coalesceOne(const Nd4jLong* shapeInfo, Nd4jLong* shape, Nd4jLong* stride) {
+
+    const int rank = shape::rank(shapeInfo);
+    const Nd4jLong* inShape  = shape::shapeOf(const_cast<Nd4jLong*>(shapeInfo));
+    const Nd4jLong* inStride = shape::stride(const_cast<Nd4jLong*>(shapeInfo));
+
+    int cnt = 0;
+    for (int e = 0; e < rank; e++) {
+        if (inShape[e] == 1)
+            continue;
+
+        if (cnt > 0 && stride[cnt - 1] == inStride[e] * inShape[e]) {
+            shape[cnt - 1] *= inShape[e];
+            stride[cnt - 1] = inStride[e];
+        } else {
+            shape[cnt] = inShape[e];
+            stride[cnt] = inStride[e];
+            cnt++;
+        }
+    }
+
+    if (cnt == 0) {
+        shape[0] = 1;
+        stride[0] = 0;
+        cnt = 1;
+    }
+
+    return cnt;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+Nd4jLong StridedLoops::init(const int rank, const Nd4jLong* shape, const Nd4jLong* stride, Nd4jLong index, Nd4jLong* coords) {
+
+    Nd4jLong offset = 0;
+    for (int e = rank - 1; e >= 0; e--) {
+        coords[e] = index % shape[e];
+        index /= shape[e];
+        offset += coords[e] * stride[e];
+    }
+
+    return offset;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+Nd4jLong StridedLoops::advance(const int rank, const Nd4jLong* shape, const Nd4jLong* stride, Nd4jLong* coords, Nd4jLong offset) {
+
+    for (int e = rank - 1; e >= 0; e--) {
+        offset += stride[e];
+        if (++coords[e] < shape[e])
+            return offset;
+
+        offset -= shape[e] * stride[e];
+        coords[e] = 0;
+    }
+
+    return offset;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+template <typename OpType, typename X, typename Z, typename E>
+void StridedLoops::loopCoalesced(const X* x, Z* z, const Coalesced& dims, E* extraParams, const int numThreads) {
+
+    const int inner = dims.rank - 1;
+    const Nd4jLong innerLen = dims.shape[inner];
+    const Nd4jLong xInner = dims.xStride[inner];
+    const Nd4jLong zInner = dims.zStride[inner];
+
+    if (dims.rank == 1) {
+        PRAGMA_OMP_PARALLEL_FOR_SIMD_THREADS(numThreads)
+        for (Nd4jLong i = 0; i < innerLen; i++)
+            z[i * zInner] = OpType::op(x[i * xInner], extraParams);
+
+        return;
+    }
+
+    // dimension x is most contiguous along
+    int xDim = inner;
+    for (int e = 0; e < inner; e++)
+        if (absolute(dims.xStride[e]) < absolute(dims.xStride[xDim]))
+            xDim = e;
+
+    if (xDim != inner && dims.shape[xDim] >= TILE && innerLen >= TILE) {
+        // transposition: z is written along inner dimension, x is read along xDim
+        // both are traversed tile by tile, so every cache line of x loaded for first row of tile is reused by next rows
+        const Nd4jLong xDimLen = dims.shape[xDim];
+        const Nd4jLong xOuter = dims.xStride[xDim];
+        const Nd4jLong zOuter = dims.zStride[xDim];
+        const Nd4jLong aTiles = (xDimLen + TILE - 1) / TILE;
+        const Nd4jLong bTiles = (innerLen + TILE - 1) / TILE;
+
+        Nd4jLong outerLen = 1;
+        for (int e = 0; e < inner; e++)
+            if (e != xDim)
+                outerLen *= dims.shape[e];
+
+        PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
+        for (Nd4jLong t = 0; t < outerLen * aTiles * bTiles; t++) {
+            const Nd4jLong a0 = ((t / bTiles) % aTiles) * TILE;
+            const Nd4jLong b0 = (t % bTiles) * TILE;
+            const Nd4jLong aLen = nd4j::math::nd4j_min<Nd4jLong>(TILE, xDimLen - a0);
+            const Nd4jLong bLen = nd4j::math::nd4j_min<Nd4jLong>(TILE, innerLen - b0);
+
+            // offsets of remaining dimensions are evaluated once per tile
+            Nd4jLong o = t / (aTiles * bTiles);
+            Nd4jLong xOffset = a0 * xOuter + b0 * xInner;
+            Nd4jLong zOffset = a0 * zOuter + b0 * zInner;
+            for (int e = inner - 1; e >= 0; e--) {
+                if (e == xDim)
+                    continue;
+
+                const Nd4jLong coord = o % dims.shape[e];
+                o /= dims.shape[e];
+                xOffset += coord * dims.xStride[e];
+                zOffset += coord * dims.zStride[e];
+            }
+
+            for (Nd4jLong a = 0; a < aLen; a++) {
+                const X* xi = x + xOffset + a * xOuter;
+                Z* zi = z + zOffset + a * zOuter;
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong b = 0; b < bLen; b++)
+                    zi[b * zInner] = OpType::op(xi[b * xInner], extraParams);
+            }
+        }
+
+        return;
+    }
+
+    // rows along inner dimension, offsets of rows are advanced incrementally within each chunk
+    const Nd4jLong rows = shape::prodLong(dims.shape, inner);
+    const int chunks = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(numThreads, rows));
+    const Nd4jLong rowsPerChunk = (rows + chunks - 1) / chunks;
+
+    PRAGMA_OMP_PARALLEL_FOR_THREADS(chunks)
+    for (int c = 0; c < chunks; c++) {
+        const Nd4jLong start = c * rowsPerChunk;
+        const Nd4jLong stop = nd4j::math::nd4j_min<Nd4jLong>(rows, start + rowsPerChunk);
+        if (start >= stop)
+            continue;
+
+        Nd4jLong coords[MAX_RANK];
+        Nd4jLong xOffset = init(inner, dims.shape, dims.xStride, start, coords);
+        Nd4jLong zOffset = init(inner, dims.shape, dims.zStride, start, coords);
+
+        for (Nd4jLong r = start; r < stop; r++) {
+            const X* xi = x + xOffset;
+            Z* zi = z + zOffset;
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong b = 0; b < innerLen; b++)
+                zi[b * zInner] = OpType::op(xi[b * xInner], extraParams);
+
+            // both arrays share coordinates, so z offset follows the same carries
+            for (int e = inner - 1; e >= 0; e--) {
+                xOffset += dims.xStride[e];
+                zOffset += dims.zStride[e];
+                if (++coords[e] < dims.shape[e])
+                    break;
+
+                xOffset -= dims.shape[e] * dims.xStride[e];
+                zOffset -= dims.shape[e] * dims.zStride[e];
+                coords[e] = 0;
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+template <typename OpType, typename X, typename Z, typename E>
+void StridedLoops::loopIncremental(const X* x, const Nd4jLong* xShapeInfo, Z* z, const Nd4jLong* zShapeInfo, E* extraParams, const int numThreads) {
+
+    Nd4jLong xShape[MAX_RANK], xStride[MAX_RANK], zShape[MAX_RANK], zStride[MAX_RANK];
+    const int xRank = coalesceOne(xShapeInfo, xShape, xStride);
+    const int zRank = coalesceOne(zShapeInfo, zShape, zStride);
+
+    const Nd4jLong len = shape::length(zShapeInfo);
+    const int chunks = static_cast<int>(nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(numThreads, len)));
+    const Nd4jLong lenPerChunk = (len + chunks - 1) / chunks;
+
+    PRAGMA_OMP_PARALLEL_FOR_THREADS(chunks)
+    for (int c = 0; c < chunks; c++) {
+        const Nd4jLong start = c * lenPerChunk;
+        const Nd4jLong stop = nd4j::math::nd4j_min<Nd4jLong>(len, start + lenPerChunk);
+        if (start >= stop)
+            continue;
+
+        Nd4jLong xCoords[MAX_RANK], zCoords[MAX_RANK];
+        Nd4jLong xOffset = init(xRank, xShape, xStride, start, xCoords);
+        Nd4jLong zOffset = init(zRank, zShape, zStride, start, zCoords);
+
+        for (Nd4jLong i = start; i < stop; i++) {
+            z[zOffset] = OpType::op(x[xOffset], extraParams);
+            xOffset = advance(xRank, xShape, xStride, xCoords, xOffset);
+            zOffset = advance(zRank, zShape, zStride, zCoords, zOffset);
+        }
+    }
+}
+
+}
+
+#endif //LIBND4J_STRIDEDLOOPS_H
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Per loop family and data type parallelisation thresholds.
+//
+// Environment::elementwiseThreshold() is a single number for every loop, whether it's cheap abs or expensive tanh.
+// This table keeps, for each loop family and data type, minimal number of elements worth a separate thread and
+// number of threads past which loop doesn't get any faster (memory bandwidth is saturated). The table is filled either
+// by calibrate(), which micro-benchmarks representative kernels on this machine, or from profile file saved earlier.
+// Until then OmpLaunchHelper behaves exactly as before.
+//
+// Profile file is plain text, one "family dtype elementsPerThread maxThreads" entry per line, '#' starts a comment.
+// ND4J_THRESHOLDS_PROFILE environment variable points to profile loaded on startup, with ND4J_THRESHOLDS_AUTOTUNE=true
+// calibration is run on startup if there's no such profile yet, and result is saved there.
+//
+
+#ifndef LIBND4J_THRESHOLDSTUNER_H
+#define LIBND4J_THRESHOLDSTUNER_H
+
+#include <atomic>
+#include <dll.h>
+#include <pointercast.h>
+#include <array/DataType.h>
+
+namespace nd4j {
+
+    class ND4J_EXPORT LoopFamily {
+    public:
+        // GENERIC loops aren't calibrated and always use Environment thresholds
+        enum Family {GENERIC = 0, TRANSFORM, TRANSFORM_STRICT, PAIRWISE, REDUCE, BROADCAST, NUM_FAMILIES};
+    };
+
+    class ND4J_EXPORT ThresholdsTuner {
+    private:
+        static const int NUM_SLOTS = 7;
+
+        static ThresholdsTuner* _instance;
+
+        std::atomic<Nd4jLong> _elementsPerThread[LoopFamily::NUM_FAMILIES][NUM_SLOTS];
+        std::atomic<int> _maxThreads[LoopFamily::NUM_FAMILIES][NUM_SLOTS];
+        std::atomic<bool> _calibrated;
+
+        ThresholdsTuner();
+
+        // table column for data type: float32, double, half, bfloat16, int32, int64 and the rest
+        static int slotOf(nd4j::DataType dataType);
+
+    public:
+        static ThresholdsTuner* getInstance();
+
+        /**
+         * Minimal number of elements worth a separate thread, Environment::elementwiseThreshold() unless calibrated
+         */
+        Nd4jLong elementsPerThread(LoopFamily::Family family, nd4j::DataType dataType);
+
+        /**
+         * Number of threads past which loop doesn't scale anymore, omp_get_max_threads() unless calibrated
+         */
+        int maxThreads(LoopFamily::Family family, nd4j::DataType dataType);
+
+        /**
+         * Sets table entry, values <= 0 mean fallback to Environment thresholds for this entry
+         */
+        void setEntry(LoopFamily::Family family, nd4j::DataType dataType, Nd4jLong elementsPerThread, int maxThreads);
+
+        bool isCalibrated();
+
+        /**
+         * Drops all entries, so Environment thresholds are used everywhere again
+         */
+        void reset();
+
+        /**
+         * Micro-benchmarks transform, pairwise, reduction and broadcast kernels for each data type and fills the table.
+         * Takes about a second, must be called outside of parallel regions. CPU backend only.
+         */
+        void calibrate();
+
+        /**
+         * Loads profile file, returns false if file can't be read or has no valid entries; table is left untouched then
+         */
+        bool load(const char* path);
+
+        /**
+         * Saves current table into profile file, returns false if file can't be written
+         */
+        bool save(const char* path);
+    };
+}
+
+#endif //LIBND4J_THRESHOLDSTUNER_H
@@ -0,0 +1,298 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Branch-free polynomial approximations of transcendental functions.
+// Unlike platformmath.h these don't call libm, so loops over them get auto-vectorised.
+//
+// Error bounds below are measured against double-precision libm over every 61st float32 bit pattern,
+// with flush-to-zero enabled (as our -funsafe-math-optimizations builds do), i.e. subnormals are ignored.
+//
+
+#ifndef LIBND4J_VECTORMATH_H
+#define LIBND4J_VECTORMATH_H
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <openmp_pragmas.h>
+#include <helpers/MathPrecision.h>
+
+namespace nd4j {
+
+namespace math {
+namespace vec {
+
+    // we're not using unions here, memcpy is what compilers recognize as plain register move
+    FORCEINLINE float int_as_float(int32_t v) {
+        float r;
+        memcpy(&r, &v, sizeof(r));
+        return r;
+    }
+
+    FORCEINLINE int32_t float_as_int(float v) {
+        int32_t r;
+        memcpy(&r, &v, sizeof(r));
+        return r;
+    }
+
+    /**
+     * exp(x), max error 1.5 ulp (double-precision range reduction, Cephes polynomial).
+     * Overflow gives +inf, NaN is propagated.
+     * Fast tier: max relative error 4.5e-6 (single-precision range reduction), inputs clamped to [-87.3, 88.7]
+     */
+    template <bool fast>
+    FORCEINLINE float exp(float x) {
+        if (fast) {
+            const float xc = x < -87.33654f ? -87.33654f : (x > 88.72283f ? 88.72283f : x);
+            const float n = std::floor(xc * 1.44269504088896341f + 0.5f);
+            const float r = xc - n * 0.693147180559945309f;
+            const float p = 1.f + r + r * r * (0.49999748867020777f + r * (0.16666523260765537f + r * (0.04183382577709283f + r * 0.008369141227188803f)));
+
+            // n is within [-126, 128] here, and exponent of p is 126 or 127, so plain exponent field increment is enough
+            return int_as_float(float_as_int(p) + static_cast<int32_t>(static_cast<uint32_t>(static_cast<int32_t>(n)) << 23));
+        }
+
+        const float xc = x < -104.f ? -104.f : (x > 89.f ? 89.f : x);
+        const double nd = std::floor(static_cast<double>(xc) * 1.4426950408889634 + 0.5);
+
+        // reduction done in double: a single rounding, which stays exact under -fassociative-math
+        const float r = static_cast<float>(static_cast<double>(xc) - nd * 0.69314718055994530942);
+        const float z = r * r;
+        const float p = ((((( 1.9875691500E-4f * r + 1.3981999507E-3f) * r + 8.3334519073E-3f) * r + 4.1665795894E-2f) * r + 1.6666665459E-1f) * r + 5.0000001201E-1f) * z + r + 1.f;
+
+        // 2^n goes straight into exponent field. Integer math is used on purpose: float multiplications by
+        // power-of-2 factors could be reassociated under -fassociative-math and overflow prematurely
+        const int32_t n = static_cast<int32_t>(nd);
+        const float normal = int_as_float(float_as_int(p) + static_cast<int32_t>(static_cast<uint32_t>(n) << 23));
+
+        // subnormal results: scale up first, single rounding happens on the final multiplication
+        const float subnormal = p * int_as_float((n + 227) << 23) * 7.88860905221011805412e-31f;
+
+        const float inf = int_as_float(0x7f800000);
+        const float result = xc > 88.7228390f ? inf : (xc < -87.3365448f ? subnormal : normal);
+
+        return x != x ? x : result;
+    }
+
+    /**
+     * log(x), max error 1 ulp (Cephes polynomial, exponent accumulated in double).
+     * Handles subnormals, zero (-inf), negative values (NaN) and +inf.
+     * Fast tier: max relative error 1.5e-6, only positive normal inputs are supported
+     */
+    template <bool fast>
+    FORCEINLINE float log(float x) {
+        if (fast) {
+            int32_t bits = float_as_int(x);
+            int32_t e = ((bits >> 23) & 0xff) - 127;
+            float m = int_as_float((bits & 0x007fffff) | 0x3f800000);
+
+            // m is moved into [sqrt(0.5), sqrt(2)) to keep polynomial argument small
+            const bool big = m > 1.41421356f;
+            m = big ? m * 0.5f : m;
+            e = big ? e + 1 : e;
+
+            const float t = m - 1.f;
+            const float t2 = t * t;
+            const float p = t2 * t * (0.3333376743547488f + t * (-0.24993375017575628f + t * (0.19933339170328504f + t * (-0.1694239942522619f + t * (0.15981800186014256f - t * 0.11002643487204389f)))));
+
+            return static_cast<float>(e) * 0.693147180559945309f + (t - 0.5f * t2 + p);
+        }
+
+        // subnormals are scaled into normal range first
+        const bool sub = x < 1.17549435e-38f;
+        const float xs = sub ? x * 8388608.f : x;
+        const int32_t bits = float_as_int(xs);
+        int32_t e = ((bits >> 23) & 0xff) - (sub ? 150 : 127);
+        float m = int_as_float((bits & 0x007fffff) | 0x3f800000);
+
+        const bool big = m > 1.41421356f;
+        m = big ? m * 0.5f : m;
+        e = big ? e + 1 : e;
+
+        const float t = m - 1.f;
+        const float z = t * t;
+        float y = ((((((((7.0376836292E-2f * t - 1.1514610310E-1f) * t + 1.1676998740E-1f) * t - 1.2420140846E-1f) * t + 1.4249322787E-1f) * t - 1.6668057665E-1f) * t + 2.0000714765E-1f) * t - 2.4999993993E-1f) * t + 3.3333331174E-1f) * t * z;
+        y -= 0.5f * z;
+
+        const float result = static_cast<float>(static_cast<double>(e) * 0.69314718055994530942 + static_cast<double>(t + y));
+
+        const float nan = int_as_float(0x7fc00000);
+        const float inf = int_as_float(0x7f800000);
+        return x != x ? x : (x < 0.f ? nan : (x == 0.f ? -inf : (x == inf ? inf : result)));
+    }
+
+    /**
+     * tanh(x), max error 1.5 ulp (odd polynomial below 0.625, exp-based identity above). Fast tier: 3 ulp
+     */
+    template <bool fast>
+    FORCEINLINE float tanh(float x) {
+        const float a = x < 0.f ? -x : x;
+        const float z = x * x;
+        const float small = ((((-5.70498872745E-3f * z + 2.06390887954E-2f) * z - 5.37397155531E-2f) * z + 1.33314422036E-1f) * z - 3.33332819422E-1f) * z * x + x;
+
+        // exp overflows to +inf for large arguments, which correctly turns into 1.0
+        const float e = exp<fast>(2.f * (a > 44.f ? 44.f : a));
+        const float large = 1.f - 2.f / (e + 1.f);
+
+        return a < 0.625f ? small : (x < 0.f ? -large : large);
+    }
+
+    /**
+     * sigmoid(x) = 1 / (1 + exp(-x)), max error 3 ulp. Fast tier: max relative error 4.5e-6
+     */
+    template <bool fast>
+    FORCEINLINE float sigmoid(float x) {
+        return 1.f / (1.f + exp<fast>(-x));
+    }
+
+    /**
+     * erf(x), max error 2.5 ulp (odd polynomial below 0.921875, exp of polynomial approximation of log(erfc) above).
+     * Fast tier: same polynomial below 0.921875, Abramowitz & Stegun 7.1.26 above, max error 4.5 ulp
+     */
+    template <bool fast>
+    FORCEINLINE float erf(float x) {
+        const float a = x < 0.f ? -x : x;
+        const float z = x * x;
+        const float small = x * (1.1283791497046636f + z * (-0.3761249403285727f + z * (0.11281818419730648f + z * (-0.02676667612152965f + z * (0.004993249969606702f - z * 0.0005991149211318607f)))));
+
+        if (fast) {
+            const float t = 1.f / (1.f + 0.3275911f * a);
+            const float p = t * (0.254829592f + t * (-0.284496736f + t * (1.421413741f + t * (-1.453152027f + t * 1.061405429f))));
+            const float r = 1.f - p * exp<true>(-a * a);
+            return a < 0.921875f ? small : (x < 0.f ? -r : r);
+        }
+
+        // erf is exactly 1.0f past 3.92
+        const float ac = a > 3.92f ? 3.92f : a;
+        const float q = 0.0003080826263846565f + ac * (-1.1301892958247723f + ac * (-0.6318933084530183f + ac * (-0.1100244602242771f + ac * (0.02639388457292764f + ac * (-0.004751526784492939f + ac * (0.0005954053092899937f + ac * (-4.592970494544712e-05f + ac * 1.6325436869533164e-06f)))))));
+        const float large = a > 3.92f ? 1.f : 1.f - exp<false>(q);
+
+        return a < 0.921875f ? small : (x < 0.f ? -large : large);
+    }
+
+
+    /**
+     * Wrappers used by VectorMath kernels: each one provides vectorised float implementation and libm reference
+     */
+    struct Exp {
+        template <bool fast> static FORCEINLINE float op(float x) { return exp<fast>(x); }
+        template <typename T> static FORCEINLINE T ref(T x) { return std::exp(x); }
+    };
+
+    struct Log {
+        template <bool fast> static FORCEINLINE float op(float x) { return log<fast>(x); }
+        template <typename T> static FORCEINLINE T ref(T x) { return std::log(x); }
+    };
+
+    struct Tanh {
+        template <bool fast> static FORCEINLINE float op(float x) { return tanh<fast>(x); }
+        template <typename T> static FORCEINLINE T ref(T x) { return std::tanh(x); }
+    };
+
+    struct Sigmoid {
+        template <bool fast> static FORCEINLINE float op(float x) { return sigmoid<fast>(x); }
+        template <typename T> static FORCEINLINE T ref(T x) { return static_cast<T>(1) / (static_cast<T>(1) + std::exp(-x)); }
+    };
+
+    struct Erf {
+        template <bool fast> static FORCEINLINE float op(float x) { return erf<fast>(x); }
+        template <typename T> static FORCEINLINE T ref(T x) { return std::erf(x); }
+    };
+
+    struct Swish {
+        template <bool fast> static FORCEINLINE float op(float x) { return x * sigmoid<fast>(x); }
+        template <typename T> static FORCEINLINE T ref(T x) { return x / (static_cast<T>(1) + std::exp(-x)); }
+    };
+
+    struct GELU {
+        template <bool fast> static FORCEINLINE float op(float x) { return x * sigmoid<fast>(1.702f * x); }
+        template <typename T> static FORCEINLINE T ref(T x) { return x / (static_cast<T>(1) + std::exp(static_cast<T>(-1.702) * x)); }
+    };
+
+    struct ELU {
+        template <bool fast> static FORCEINLINE float op(float x) { return x >= 0.f ? x : exp<fast>(x) - 1.f; }
+        template <typename T> static FORCEINLINE T ref(T x) { return x >= static_cast<T>(0) ? x : std::exp(x) - static_cast<T>(1); }
+    };
+}
+}
+
+    class VectorMath {
+    private:
+        // float16/bfloat16 are converted through small on-stack blocks, so math itself still runs on float lanes
+        static const int BLOCK = 256;
+
+        template <typename X, typename OpType, bool fast>
+        static FORCEINLINE void loop(const X* x, X* z, Nd4jLong length, std::true_type isFloat) {
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong e = 0; e < length; e++)
+                z[e] = static_cast<X>(OpType::template op<fast>(static_cast<float>(x[e])));
+        }
+
+        template <typename X, typename OpType, bool fast>
+        static FORCEINLINE void loop(const X* x, X* z, Nd4jLong length, std::false_type isFloat) {
+            float buffer[BLOCK];
+            for (Nd4jLong b = 0; b < length; b += BLOCK) {
+                const int span = static_cast<int>(length - b < BLOCK ? length - b : BLOCK);
+
+                for (int e = 0; e < span; e++)
+                    buffer[e] = static_cast<float>(x[b + e]);
+
+                PRAGMA_OMP_SIMD
+                for (int e = 0; e < span; e++)
+                    buffer[e] = OpType::template op<fast>(buffer[e]);
+
+                for (int e = 0; e < span; e++)
+                    z[b + e] = static_cast<X>(buffer[e]);
+            }
+        }
+
+    public:
+        /**
+         * This method returns true if vectorised kernels cover given type at given precision.
+         * Doubles always go through libm: their accuracy budget doesn't fit short polynomials
+         */
+        template <typename X>
+        static FORCEINLINE bool isVectorised(MathPrecision precision) {
+            return precision != MATH_LIBM && !std::is_same<X, double>::value;
+        }
+
+        /**
+         * This method applies OpType to contiguous buffer, single-threaded.
+         * x and z may point to the same buffer
+         */
+        template <typename X, typename OpType>
+        static FORCEINLINE void transform(const X* x, X* z, Nd4jLong length, MathPrecision precision) {
+            if (!isVectorised<X>(precision)) {
+                // half types go through float libm, just like platformmath.h does
+                typedef typename std::conditional<std::is_same<X, double>::value, double, float>::type W;
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < length; e++)
+                    z[e] = static_cast<X>(OpType::template ref<W>(static_cast<W>(x[e])));
+            } else if (precision == MATH_FAST) {
+                loop<X, OpType, true>(x, z, length, std::integral_constant<bool, std::is_same<X, float>::value>());
+            } else {
+                loop<X, OpType, false>(x, z, length, std::integral_constant<bool, std::is_same<X, float>::value>());
+            }
+        }
+    };
+}
+
+#endif //LIBND4J_VECTORMATH_H
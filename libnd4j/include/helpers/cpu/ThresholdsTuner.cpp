@@ -0,0 +1,231 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Calibration of ThresholdsTuner table: representative kernels of each loop family are timed on this machine
+//
+
+#include <helpers/ThresholdsTuner.h>
+#include <array/DataTypeUtils.h>
+#include <helpers/logger.h>
+#include <op_boilerplate.h>
+#include <ops/ops.h>
+#include <types/float16.h>
+#include <types/bfloat16.h>
+#include <chrono>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace nd4j {
+
+    // loop is worth a thread when thread's chunk costs this many times more than spawning it
+    static const double FORK_COST_FACTOR = 4.;
+
+    // thread count is considered saturated when it's within this factor from the best time
+    static const double SATURATION_FACTOR = 1.1;
+
+    // elements in arrays used to measure scaling, large enough to leave caches
+    static const Nd4jLong SCALING_LENGTH = 1 << 21;
+
+    // elements used to measure serial per-element cost, small enough to stay in L2
+    static const Nd4jLong SERIAL_LENGTH = 1 << 15;
+
+    // broadcast kernel applies [TAD_LENGTH] row to each TAD
+    static const Nd4jLong TAD_LENGTH = 256;
+
+    static int availableThreads() {
+#ifdef _OPENMP
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+    }
+
+    static double nanosSince(const std::chrono::time_point<std::chrono::high_resolution_clock>& start) {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count());
+    }
+
+    // each kernel processes [start, stop) range of elements, just like per-thread chunks in TransformLoops/ReductionLoops
+    template <typename T>
+    struct CalibrationKernels {
+
+        static void transform(const T* x, const T*, T* z, Nd4jLong start, Nd4jLong stop) {
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = start; i < stop; i++)
+                z[i] = simdOps::Abs<T>::op(x[i], nullptr);
+        }
+
+        static void transformStrict(const T* x, const T*, T* z, Nd4jLong start, Nd4jLong stop) {
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = start; i < stop; i++)
+                z[i] = simdOps::Tanh<T>::op(x[i], nullptr);
+        }
+
+        static void pairwise(const T* x, const T* y, T* z, Nd4jLong start, Nd4jLong stop) {
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = start; i < stop; i++)
+                z[i] = simdOps::Add<T, T, T>::op(x[i], y[i], nullptr);
+        }
+
+        static void reduce(const T* x, const T*, T* z, Nd4jLong start, Nd4jLong stop) {
+            T sum = static_cast<T>(0);
+            for (Nd4jLong i = start; i < stop; i++)
+                sum = simdOps::Add<T, T, T>::op(sum, x[i]);
+            z[start] = sum;
+        }
+
+        static void broadcast(const T* x, const T* y, T* z, Nd4jLong start, Nd4jLong stop) {
+            for (Nd4jLong t = start / TAD_LENGTH; t < stop / TAD_LENGTH; t++) {
+                const auto xt = x + t * TAD_LENGTH;
+                auto zt = z + t * TAD_LENGTH;
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong i = 0; i < TAD_LENGTH; i++)
+                    zt[i] = simdOps::Add<T, T, T>::op(xt[i], y[i], nullptr);
+            }
+        }
+    };
+
+    template <typename T>
+    class FamilyCalibration {
+    public:
+        typedef void (*Kernel)(const T* x, const T* y, T* z, Nd4jLong start, Nd4jLong stop);
+
+        // best of few runs of kernel over length elements split between given number of threads, in nanoseconds
+        static double time(Kernel kernel, const T* x, const T* y, T* z, Nd4jLong length, int threads, int runs) {
+            double best = -1.;
+            for (int r = 0; r < runs; r++) {
+                auto start = std::chrono::high_resolution_clock::now();
+
+                if (threads > 1) {
+                    // chunks are multiples of TAD_LENGTH, so broadcast kernel gets whole TADs
+                    const Nd4jLong span = ((length / threads + TAD_LENGTH - 1) / TAD_LENGTH) * TAD_LENGTH;
+
+                    PRAGMA_OMP_PARALLEL_THREADS(threads)
+                    {
+                        const Nd4jLong begin = span * omp_get_thread_num();
+                        const Nd4jLong end = begin + span < length ? begin + span : length;
+                        if (begin < end)
+                            kernel(x, y, z, begin, end);
+                    }
+                }
+                else
+                    kernel(x, y, z, 0, length);
+
+                auto elapsed = nanosSince(start);
+                if (best < 0. || elapsed < best)
+                    best = elapsed;
+            }
+
+            return best;
+        }
+
+        static void calibrate(ThresholdsTuner* tuner, LoopFamily::Family family, Kernel kernel, double forkNanos, std::vector<T>& x, std::vector<T>& y, std::vector<T>& z) {
+            const int available = availableThreads();
+
+            // warm up, then serial cost per element on cached data
+            time(kernel, x.data(), y.data(), z.data(), SERIAL_LENGTH, 1, 2);
+            const double perElement = time(kernel, x.data(), y.data(), z.data(), SERIAL_LENGTH, 1, 5) / static_cast<double>(SERIAL_LENGTH);
+
+            Nd4jLong elementsPerThread = static_cast<Nd4jLong>(FORK_COST_FACTOR * forkNanos / (perElement > 0. ? perElement : 1e-3));
+            elementsPerThread = ((elementsPerThread + TAD_LENGTH - 1) / TAD_LENGTH) * TAD_LENGTH;
+            elementsPerThread = nd4j::math::nd4j_max<Nd4jLong>(TAD_LENGTH, nd4j::math::nd4j_min<Nd4jLong>(elementsPerThread, SCALING_LENGTH));
+
+            // scaling on data which doesn't fit caches: cheap loops saturate memory bandwidth well before all cores are busy
+            std::vector<int> candidates;
+            for (int t = 1; t < available; t *= 2)
+                candidates.push_back(t);
+            candidates.push_back(available);
+
+            std::vector<double> times(candidates.size());
+            double best = -1.;
+            for (size_t c = 0; c < candidates.size(); c++) {
+                times[c] = time(kernel, x.data(), y.data(), z.data(), SCALING_LENGTH, candidates[c], 3);
+                if (best < 0. || times[c] < best)
+                    best = times[c];
+            }
+
+            int maxThreads = available;
+            for (size_t c = 0; c < candidates.size(); c++)
+                if (times[c] <= SATURATION_FACTOR * best) {
+                    maxThreads = candidates[c];
+                    break;
+                }
+
+            tuner->setEntry(family, DataTypeUtils::fromT<T>(), elementsPerThread, maxThreads);
+
+            nd4j_debug("Thresholds: family %i, dtype %i: %.3f ns per element, %lld elements per thread, %i threads max\n", (int) family, (int) DataTypeUtils::fromT<T>(), perElement, (long long) elementsPerThread, maxThreads);
+        }
+
+        static void calibrateAll(ThresholdsTuner* tuner, double forkNanos, bool floating) {
+            std::vector<T> x(SCALING_LENGTH), y(SCALING_LENGTH), z(SCALING_LENGTH);
+            for (Nd4jLong i = 0; i < SCALING_LENGTH; i++) {
+                x[i] = static_cast<T>(floating ? static_cast<float>(i % 2000 - 1000) / 1000.f : static_cast<float>(i % 2000 - 1000));
+                y[i] = static_cast<T>(floating ? static_cast<float>(i % 1000) / 1000.f : static_cast<float>(i % 1000));
+            }
+
+            calibrate(tuner, LoopFamily::TRANSFORM, &CalibrationKernels<T>::transform, forkNanos, x, y, z);
+            if (floating)
+                calibrate(tuner, LoopFamily::TRANSFORM_STRICT, &CalibrationKernels<T>::transformStrict, forkNanos, x, y, z);
+            calibrate(tuner, LoopFamily::PAIRWISE, &CalibrationKernels<T>::pairwise, forkNanos, x, y, z);
+            calibrate(tuner, LoopFamily::REDUCE, &CalibrationKernels<T>::reduce, forkNanos, x, y, z);
+            calibrate(tuner, LoopFamily::BROADCAST, &CalibrationKernels<T>::broadcast, forkNanos, x, y, z);
+        }
+    };
+
+    // cost of opening and closing parallel region with all threads, in nanoseconds
+    static double forkJoinNanos() {
+        const int threads = availableThreads();
+        double best = -1.;
+        volatile int sink = 0;
+
+        for (int r = 0; r < 64; r++) {
+            auto start = std::chrono::high_resolution_clock::now();
+
+            PRAGMA_OMP_PARALLEL_THREADS(threads)
+            {
+                if (omp_get_thread_num() == 0)
+                    sink = sink + 1;
+            }
+
+            auto elapsed = nanosSince(start);
+            if (best < 0. || elapsed < best)
+                best = elapsed;
+        }
+
+        return best;
+    }
+
+    void ThresholdsTuner::calibrate() {
+        if (availableThreads() <= 1) {
+            nd4j_printf("Thresholds calibration skipped: single thread available\n", "");
+            return;
+        }
+
+        const double forkNanos = forkJoinNanos();
+
+        reset();
+        FamilyCalibration<float>::calibrateAll(this, forkNanos, true);
+        FamilyCalibration<double>::calibrateAll(this, forkNanos, true);
+        FamilyCalibration<float16>::calibrateAll(this, forkNanos, true);
+        FamilyCalibration<bfloat16>::calibrateAll(this, forkNanos, true);
+        FamilyCalibration<int>::calibrateAll(this, forkNanos, false);
+        FamilyCalibration<Nd4jLong>::calibrateAll(this, forkNanos, false);
+    }
+}
@@ -51,6 +51,15 @@ namespace nd4j {
         this->lapackeDgesdd = (LapackeDgesdd)functions[9];
     }
 
+    void BlasHelper::initializeLapackFunctions(Nd4jPointer *functions) {
+        nd4j_debug("Initializing LAPACK\n","");
+
+        this->lapackeSgetrf = (LapackeSgetrf)functions[0];
+        this->lapackeDgetrf = (LapackeDgetrf)functions[1];
+        this->lapackeSpotrf = (LapackeSpotrf)functions[2];
+        this->lapackeDpotrf = (LapackeDpotrf)functions[3];
+    }
+
     void BlasHelper::initializeDeviceFunctions(Nd4jPointer *functions) {
         nd4j_debug("Initializing device BLAS\n","");
 
@@ -329,6 +338,22 @@ namespace nd4j {
         return this->lapackeDgesdd;
     }
 
+    LapackeSgetrf BlasHelper::sgetrf() {
+        return this->lapackeSgetrf;
+    }
+
+    LapackeDgetrf BlasHelper::dgetrf() {
+        return this->lapackeDgetrf;
+    }
+
+    LapackeSpotrf BlasHelper::spotrf() {
+        return this->lapackeSpotrf;
+    }
+
+    LapackeDpotrf BlasHelper::dpotrf() {
+        return this->lapackeDpotrf;
+    }
+
     // destructor
     BlasHelper::~BlasHelper() noexcept { }
 
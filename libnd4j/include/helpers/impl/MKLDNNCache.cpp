@@ -0,0 +1,181 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Process-wide LRU cache of MKL-DNN primitives
+//
+
+#include <helpers/MKLDNNCache.h>
+
+#ifdef HAVE_MKLDNN
+#include <helpers/logger.h>
+#include <cstring>
+
+namespace nd4j {
+
+    void MKLDNNPrimitives::bind(const std::vector<const NDArray*> &arrays) {
+        for (const auto &binding: _bindings)
+            _memory[binding.first].set_data_handle(const_cast<NDArray*>(arrays[binding.second])->buffer());
+    }
+
+    MKLDNNCache::MKLDNNCache() {
+        _hits = 0;
+        _misses = 0;
+        _evictions = 0;
+    }
+
+    MKLDNNCache* MKLDNNCache::getInstance() {
+        if (_instance == 0)
+            _instance = new MKLDNNCache();
+
+        return _instance;
+    }
+
+    std::string MKLDNNCache::keyOf(const std::string &opName, const std::vector<const NDArray*> &inputs, const std::vector<const NDArray*> &outputs,
+            const std::vector<float> &floatArguments, const std::vector<int> &intArguments) {
+        std::string key(opName);
+        key.reserve(256);
+
+        // shapeInfo covers shape, strides, data type and order
+        auto appendArrays = [&] (const std::vector<const NDArray*> &arrays) {
+            for (auto array: arrays) {
+                if (array == nullptr) {
+                    key += "|n";
+                    continue;
+                }
+
+                auto shapeInfo = array->getShapeInfo();
+                auto length = shape::shapeInfoLength(shapeInfo);
+                key += '|';
+                for (int e = 0; e < length; e++) {
+                    key += std::to_string(shapeInfo[e]);
+                    key += ',';
+                }
+            }
+        };
+
+        appendArrays(inputs);
+        key += "|o";
+        appendArrays(outputs);
+
+        // float arguments are compared bitwise
+        key += "|f";
+        for (auto v: floatArguments) {
+            int bits;
+            memcpy(&bits, &v, sizeof(float));
+            key += std::to_string(bits);
+            key += ',';
+        }
+
+        key += "|i";
+        for (auto v: intArguments) {
+            key += std::to_string(v);
+            key += ',';
+        }
+
+        return key;
+    }
+
+    std::shared_ptr<MKLDNNPrimitives> MKLDNNCache::acquire(const std::string &key) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _index.find(key);
+        if (it == _index.end()) {
+            _misses++;
+            return nullptr;
+        }
+
+        auto primitives = it->second->second;
+        _entries.erase(it->second);
+        _index.erase(it);
+        _hits++;
+
+        return primitives;
+    }
+
+    void MKLDNNCache::release(const std::string &key, const std::shared_ptr<MKLDNNPrimitives> &primitives) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _entries.emplace_front(key, primitives);
+        _index.emplace(key, _entries.begin());
+
+        while (_entries.size() > _capacity)
+            evictOne();
+    }
+
+    void MKLDNNCache::evictOne() {
+        auto last = std::prev(_entries.end());
+        auto range = _index.equal_range(last->first);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == last) {
+                _index.erase(it);
+                break;
+            }
+        }
+
+        nd4j_debug("MKLDNNCache: evicting primitives for %s\n", last->first.c_str());
+        _entries.erase(last);
+        _evictions++;
+    }
+
+    void MKLDNNCache::setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _capacity = capacity;
+        while (_entries.size() > _capacity)
+            evictOne();
+    }
+
+    size_t MKLDNNCache::capacity() {
+        return _capacity;
+    }
+
+    size_t MKLDNNCache::size() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries.size();
+    }
+
+    Nd4jLong MKLDNNCache::hits() {
+        return _hits.load();
+    }
+
+    Nd4jLong MKLDNNCache::misses() {
+        return _misses.load();
+    }
+
+    Nd4jLong MKLDNNCache::evictions() {
+        return _evictions.load();
+    }
+
+    double MKLDNNCache::hitRate() {
+        auto total = _hits.load() + _misses.load();
+        return total > 0 ? static_cast<double>(_hits.load()) / total : 0.0;
+    }
+
+    void MKLDNNCache::purge() {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _index.clear();
+        _entries.clear();
+        _hits = 0;
+        _misses = 0;
+        _evictions = 0;
+    }
+
+    MKLDNNCache* MKLDNNCache::_instance = 0;
+}
+#endif
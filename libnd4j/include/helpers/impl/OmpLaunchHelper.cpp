@@ -30,20 +30,26 @@ namespace nd4j {
 
 
 ////////////////////////////////////////////////////////////////////////////////
-OmpLaunchHelper::OmpLaunchHelper(const Nd4jLong N, float desiredNumThreads) {            
+OmpLaunchHelper::OmpLaunchHelper(const Nd4jLong N, float desiredNumThreads) : OmpLaunchHelper(N, desiredNumThreads, LoopFamily::GENERIC, nd4j::DataType::FLOAT32) {
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OmpLaunchHelper::OmpLaunchHelper(const Nd4jLong N, float desiredNumThreads, LoopFamily::Family family, nd4j::DataType dataType) {
+
+    auto maxItersPerThread = ThresholdsTuner::getInstance()->elementsPerThread(family, dataType);
 
-    auto maxItersPerThread = Environment::getInstance()->elementwiseThreshold();    
-        
     if(N < maxItersPerThread)
         _numThreads = 1;
     else {
         #ifdef _OPENMP
+            const int maxThreads = ThresholdsTuner::getInstance()->maxThreads(family, dataType);
             if(desiredNumThreads == -1)
-                desiredNumThreads = omp_get_max_threads();
+                desiredNumThreads = maxThreads;
             else if(desiredNumThreads < 1) 
                 desiredNumThreads = 1;
             else
-                desiredNumThreads = nd4j::math::nd4j_min<int>(omp_get_max_threads(), desiredNumThreads);
+                desiredNumThreads = nd4j::math::nd4j_min<int>(maxThreads, desiredNumThreads);
         #else
             desiredNumThreads = 1;
         #endif
@@ -88,6 +94,37 @@ Nd4jLong OmpLaunchHelper::betterSpan(Nd4jLong N) {
         }
     }
 
+    int OmpLaunchHelper::betterThreads(Nd4jLong N, int maxThreads, LoopFamily::Family family, nd4j::DataType dataType) {
+        auto tuner = ThresholdsTuner::getInstance();
+        if (!tuner->isCalibrated())
+            return betterThreads(N, maxThreads);
+
+        auto t = tuner->elementsPerThread(family, dataType);
+        if (N < t)
+            return 1;
+        else {
+            maxThreads = nd4j::math::nd4j_min<int>(maxThreads, tuner->maxThreads(family, dataType));
+            return static_cast<int>(nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(N / t, maxThreads)));
+        }
+    }
+
+    int OmpLaunchHelper::tadThreads(Nd4jLong tadLength, Nd4jLong numTads, LoopFamily::Family family, nd4j::DataType dataType) {
+        auto tuner = ThresholdsTuner::getInstance();
+
+        // without calibration it's the same decision as before
+        if (!tuner->isCalibrated())
+            return tadThreads(tadLength, numTads);
+
+        auto totalLength = tadLength * numTads;
+        auto perThread = tuner->elementsPerThread(family, dataType);
+
+        if (totalLength < perThread)
+            return 1;
+
+        auto threads = nd4j::math::nd4j_min<Nd4jLong>(totalLength / perThread, numTads);
+        return static_cast<int>(nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(threads, tuner->maxThreads(family, dataType))));
+    }
+
     int OmpLaunchHelper::tadThreads(Nd4jLong tadLength, Nd4jLong numTads) {
 #ifdef _OPENMP
         auto maxThreads = omp_get_max_threads();
@@ -0,0 +1,297 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Per-op performance registry and built-in cost models, see helpers/OpCounters.h
+//
+
+#include <helpers/OpCounters.h>
+#include <helpers/EnumUtils.h>
+#include <helpers/StringUtils.h>
+#include <array/DataTypeUtils.h>
+#include <helpers/shape.h>
+#include <NDArray.h>
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+namespace nd4j {
+
+    double OpCountersEntry::gflops() const {
+        return time > 0 ? flops / static_cast<double>(time) : 0.0;
+    }
+
+    double OpCountersEntry::gbps() const {
+        return time > 0 ? bytes / static_cast<double>(time) : 0.0;
+    }
+
+    double OpCountersEntry::ipc() const {
+        return counters.cycles > 0 ? static_cast<double>(counters.instructions) / static_cast<double>(counters.cycles) : 0.0;
+    }
+
+    static Nd4jLong largestLength(const std::vector<NDArray*>& inputs, const std::vector<NDArray*>& outputs) {
+        Nd4jLong result = 0L;
+        for (auto array: inputs)
+            if (array != nullptr)
+                result = nd4j::math::nd4j_max<Nd4jLong>(result, array->lengthOf());
+
+        for (auto array: outputs)
+            if (array != nullptr)
+                result = nd4j::math::nd4j_max<Nd4jLong>(result, array->lengthOf());
+
+        return result;
+    }
+
+    static double outputLength(const std::vector<NDArray*>& outputs) {
+        return outputs.empty() || outputs[0] == nullptr ? 0.0 : static_cast<double>(outputs[0]->lengthOf());
+    }
+
+    // [..., M, K] x [..., K, N]: one multiply-add per output element and K
+    static OpCost matmulCost(const std::vector<NDArray*>& inputs, const std::vector<NDArray*>& outputs, const std::vector<int>& iArgs) {
+        auto cost = OpCounters::defaultCost(inputs, outputs, iArgs);
+        if (inputs.size() < 2 || inputs[0] == nullptr)
+            return cost;
+
+        auto x = inputs[0];
+        const bool transX = !iArgs.empty() && iArgs[0] != 0;
+        Nd4jLong k = x->rankOf() < 2 ? x->lengthOf() : transX ? x->sizeAt(-2) : x->sizeAt(-1);
+
+        cost.flops = 2.0 * outputLength(outputs) * k;
+        return cost;
+    }
+
+    // weights [k..., iC, oC]: each output element is dot product over kernel window and input channels
+    static OpCost convolutionCost(const std::vector<NDArray*>& inputs, const std::vector<NDArray*>& outputs, const std::vector<int>& iArgs) {
+        auto cost = OpCounters::defaultCost(inputs, outputs, iArgs);
+        if (inputs.size() < 2 || inputs[1] == nullptr || inputs[1]->rankOf() < 2)
+            return cost;
+
+        auto weights = inputs[1];
+        cost.flops = 2.0 * outputLength(outputs) * (weights->lengthOf() / weights->sizeAt(-1));
+        return cost;
+    }
+
+    // weights [kH, kW, iC, mC]: each output element is dot product over kernel window only
+    static OpCost depthwiseConvolutionCost(const std::vector<NDArray*>& inputs, const std::vector<NDArray*>& outputs, const std::vector<int>& iArgs) {
+        auto cost = OpCounters::defaultCost(inputs, outputs, iArgs);
+        if (inputs.size() < 2 || inputs[1] == nullptr || inputs[1]->rankOf() != 4)
+            return cost;
+
+        cost.flops = 2.0 * outputLength(outputs) * inputs[1]->sizeAt(0) * inputs[1]->sizeAt(1);
+        return cost;
+    }
+
+    // weights [kH, kW, oC, iC]: each input element is scattered over kernel window and output channels
+    static OpCost deconvolutionCost(const std::vector<NDArray*>& inputs, const std::vector<NDArray*>& outputs, const std::vector<int>& iArgs) {
+        auto cost = OpCounters::defaultCost(inputs, outputs, iArgs);
+        if (inputs.size() < 2 || inputs[0] == nullptr || inputs[1] == nullptr || inputs[1]->rankOf() != 4)
+            return cost;
+
+        auto weights = inputs[1];
+        cost.flops = 2.0 * inputs[0]->lengthOf() * (weights->lengthOf() / weights->sizeAt(-1));
+        return cost;
+    }
+
+    // max, subtraction, exp, sum and division per element
+    static OpCost softmaxCost(const std::vector<NDArray*>& inputs, const std::vector<NDArray*>& outputs, const std::vector<int>& iArgs) {
+        auto cost = OpCounters::defaultCost(inputs, outputs, iArgs);
+        cost.flops *= 5.0;
+        return cost;
+    }
+
+    OpCounters::OpCounters() {
+        _enabled.store(false);
+
+        _costs["matmul"] = matmulCost;
+        _costs["conv1d"] = convolutionCost;
+        _costs["conv2d"] = convolutionCost;
+        _costs["conv3dnew"] = convolutionCost;
+        _costs["pointwise_conv2d"] = convolutionCost;
+        _costs["depthwise_conv2d"] = depthwiseConvolutionCost;
+        _costs["deconv2d"] = deconvolutionCost;
+        _costs["softmax"] = softmaxCost;
+        _costs["log_softmax"] = softmaxCost;
+    }
+
+    OpCounters* OpCounters::getInstance() {
+        if (_instance == 0)
+            _instance = new OpCounters();
+
+        return _instance;
+    }
+
+    Nd4jLong OpCounters::currentTime() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void OpCounters::setEnabled(bool reallyEnable) {
+        if (reallyEnable)
+            PerfCounters::getInstance()->enable();
+        else
+            PerfCounters::getInstance()->disable();
+
+        _enabled.store(reallyEnable);
+    }
+
+    bool OpCounters::isEnabled() {
+        return _enabled.load();
+    }
+
+    void OpCounters::declareCost(const std::string& opName, OpCostFunction function) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _costs[opName] = function;
+    }
+
+    OpCost OpCounters::defaultCost(const std::vector<NDArray*>& inputs, const std::vector<NDArray*>& outputs, const std::vector<int>& iArgs) {
+        OpCost cost;
+        cost.flops = static_cast<double>(largestLength(inputs, outputs));
+
+        for (auto array: inputs)
+            if (array != nullptr)
+                cost.bytes += static_cast<double>(array->lengthOf()) * array->sizeOfT();
+
+        for (auto array: outputs)
+            if (array != nullptr)
+                cost.bytes += static_cast<double>(array->lengthOf()) * array->sizeOfT();
+
+        return cost;
+    }
+
+    OpCost OpCounters::costOf(const std::string& opName, const std::vector<NDArray*>& inputs, const std::vector<NDArray*>& outputs, const std::vector<int>& iArgs) {
+        OpCostFunction function = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _costs.find(opName);
+            if (it != _costs.end())
+                function = it->second;
+        }
+
+        return function != nullptr ? function(inputs, outputs, iArgs) : defaultCost(inputs, outputs, iArgs);
+    }
+
+    std::string OpCounters::shapeClass(nd4j::DataType dataType, Nd4jLong length) {
+        int bucket = 0;
+        while ((1LL << bucket) < length && bucket < 62)
+            bucket++;
+
+        return DataTypeUtils::asString(dataType) + "/2^" + StringUtils::valueToString<int>(bucket);
+    }
+
+    void OpCounters::record(const std::string& opName, const std::vector<NDArray*>& inputs, const std::vector<NDArray*>& outputs, const std::vector<int>& iArgs, Nd4jLong time, const PerfSample& counters) {
+        NDArray* first = !inputs.empty() ? inputs[0] : !outputs.empty() ? outputs[0] : nullptr;
+        auto dataType = first != nullptr ? first->dataType() : nd4j::DataType::INHERIT;
+
+        record(opName, shapeClass(dataType, largestLength(inputs, outputs)), costOf(opName, inputs, outputs, iArgs), time, counters);
+    }
+
+    void OpCounters::record(const std::string& opName, const std::string& shapeClass, const OpCost& cost, Nd4jLong time, const PerfSample& counters) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto& entry = _entries[std::make_pair(opName, shapeClass)];
+        if (entry.invocations == 0) {
+            entry.opName = opName;
+            entry.shapeClass = shapeClass;
+        }
+
+        entry.invocations++;
+        entry.time += time;
+        entry.counters += counters;
+        entry.flops += cost.flops;
+        entry.bytes += cost.bytes;
+    }
+
+    std::vector<OpCountersEntry> OpCounters::entries() {
+        std::vector<OpCountersEntry> result;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (const auto& v: _entries)
+                result.emplace_back(v.second);
+        }
+
+        std::sort(result.begin(), result.end(), [](const OpCountersEntry& a, const OpCountersEntry& b) -> bool { return a.time > b.time; });
+        return result;
+    }
+
+    const char* OpCounters::report() {
+        auto list = entries();
+        const bool hardware = PerfCounters::getInstance()->isAvailable();
+
+        std::ostringstream stream;
+        stream << "op,shape_class,invocations,time_ns,cycles,instructions,llc_misses,branch_misses,ipc,gflops,gbps\n";
+        for (const auto& entry: list) {
+            stream << entry.opName << "," << entry.shapeClass << "," << entry.invocations << "," << entry.time << ",";
+            if (hardware)
+                stream << entry.counters.cycles << "," << entry.counters.instructions << "," << entry.counters.llcMisses << "," << entry.counters.branchMisses << "," << entry.ipc();
+            else
+                stream << "-1,-1,-1,-1,-1";
+
+            stream << "," << entry.gflops() << "," << entry.gbps() << "\n";
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _report = stream.str();
+        return _report.c_str();
+    }
+
+    void OpCounters::reset() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.clear();
+    }
+
+    OpCountersScope::OpCountersScope(nd4j::graph::OpType opType, int opNum, Nd4jLong *xShapeInfo, Nd4jLong *yShapeInfo, Nd4jLong *zShapeInfo) {
+        _active = OpCounters::getInstance()->isEnabled();
+        if (!_active)
+            return;
+
+        _opType = opType;
+        _opNum = opNum;
+        _x = xShapeInfo;
+        _y = yShapeInfo;
+        _z = zShapeInfo;
+
+        _counters = PerfCounters::getInstance()->read();
+        _start = OpCounters::currentTime();
+    }
+
+    OpCountersScope::~OpCountersScope() {
+        if (!_active)
+            return;
+
+        auto time = OpCounters::currentTime() - _start;
+        auto counters = PerfCounters::getInstance()->read() - _counters;
+
+        // default cost model: every operand is read or written once, one operation per element of the largest one
+        OpCost cost;
+        Nd4jLong length = 0L;
+        for (auto shapeInfo: {_x, _y, _z}) {
+            if (shapeInfo == nullptr)
+                continue;
+
+            auto len = shape::length(shapeInfo);
+            length = nd4j::math::nd4j_max<Nd4jLong>(length, len);
+            cost.bytes += static_cast<double>(len) * DataTypeUtils::sizeOfElement(ArrayOptions::dataType(shapeInfo));
+        }
+        cost.flops = static_cast<double>(length);
+
+        auto dataType = _x != nullptr ? ArrayOptions::dataType(_x) : _z != nullptr ? ArrayOptions::dataType(_z) : nd4j::DataType::INHERIT;
+        auto name = std::string(EnumUtils::_OpTypeToString(_opType)) + "_" + StringUtils::valueToString<int>(_opNum);
+
+        OpCounters::getInstance()->record(name, OpCounters::shapeClass(dataType, length), cost, time, counters);
+    }
+
+    OpCounters* OpCounters::_instance = 0;
+}
@@ -0,0 +1,195 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// perf_event_open based counters, see helpers/PerfCounters.h
+//
+
+#include <helpers/PerfCounters.h>
+#include <helpers/logger.h>
+#include <openmp_pragmas.h>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace nd4j {
+
+    PerfSample PerfSample::operator-(const PerfSample& other) const {
+        PerfSample result;
+        result.cycles = cycles - other.cycles;
+        result.instructions = instructions - other.instructions;
+        result.llcMisses = llcMisses - other.llcMisses;
+        result.branchMisses = branchMisses - other.branchMisses;
+        return result;
+    }
+
+    PerfSample& PerfSample::operator+=(const PerfSample& other) {
+        cycles += other.cycles;
+        instructions += other.instructions;
+        llcMisses += other.llcMisses;
+        branchMisses += other.branchMisses;
+        return *this;
+    }
+
+#ifdef __linux__
+    static const int NUM_EVENTS = 4;
+    static const uint64_t EVENTS[NUM_EVENTS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+    // generation counter group of this thread was opened for, groups of previous generations are closed already
+    static thread_local int attachedGeneration = -1;
+
+    static int openEvent(uint64_t config, int groupFd) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = groupFd < 0 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // pid 0, cpu -1: calling thread, on whatever cpu it runs
+        return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0));
+    }
+#endif
+
+    PerfCounters::PerfCounters() {
+        _enabled.store(false);
+        _available.store(false);
+        _generation.store(0);
+    }
+
+    PerfCounters* PerfCounters::getInstance() {
+        if (_instance == 0)
+            _instance = new PerfCounters();
+
+        return _instance;
+    }
+
+    void PerfCounters::attachCurrentThread() {
+#ifdef __linux__
+        const int generation = _generation.load();
+        if (attachedGeneration == generation)
+            return;
+
+        attachedGeneration = generation;
+
+        int leader = openEvent(EVENTS[0], -1);
+        if (leader < 0)
+            return;
+
+        for (int e = 1; e < NUM_EVENTS; e++) {
+            if (openEvent(EVENTS[e], leader) < 0) {
+                // group without all events is useless, closing leader closes members as well
+                close(leader);
+                return;
+            }
+        }
+
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _groups.emplace_back(leader);
+        _available.store(true);
+#endif
+    }
+
+    void PerfCounters::closeGroups() {
+        std::lock_guard<std::mutex> lock(_mutex);
+#ifdef __linux__
+        for (auto leader: _groups)
+            close(leader);
+#endif
+        _groups.clear();
+        _generation++;
+    }
+
+    bool PerfCounters::enable() {
+        if (_enabled.load())
+            return _available.load();
+
+        _enabled.store(true);
+
+        attachCurrentThread();
+
+        // pool threads are the ones doing actual work in parallel regions
+        PRAGMA_OMP_PARALLEL
+        {
+            attachCurrentThread();
+        }
+
+        if (!_available.load())
+            nd4j_printf("PerfCounters: hardware counters aren't available, only timings will be collected\n", "");
+
+        return _available.load();
+    }
+
+    void PerfCounters::disable() {
+        _enabled.store(false);
+        closeGroups();
+        _available.store(false);
+    }
+
+    bool PerfCounters::isEnabled() {
+        return _enabled.load();
+    }
+
+    bool PerfCounters::isAvailable() {
+        return _available.load();
+    }
+
+    PerfSample PerfCounters::read() {
+        PerfSample result;
+        if (!_enabled.load())
+            return result;
+
+        attachCurrentThread();
+
+#ifdef __linux__
+        // nr, time_enabled, time_running, then values in group order
+        uint64_t buffer[3 + NUM_EVENTS];
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto leader: _groups) {
+            if (::read(leader, buffer, sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer)) || buffer[0] != NUM_EVENTS)
+                continue;
+
+            // counters could be multiplexed with other users of PMU, values are scaled to full time then
+            double scale = buffer[2] > 0 && buffer[2] < buffer[1] ? static_cast<double>(buffer[1]) / static_cast<double>(buffer[2]) : 1.0;
+
+            PerfSample sample;
+            sample.cycles = static_cast<Nd4jLong>(buffer[3] * scale);
+            sample.instructions = static_cast<Nd4jLong>(buffer[4] * scale);
+            sample.llcMisses = static_cast<Nd4jLong>(buffer[5] * scale);
+            sample.branchMisses = static_cast<Nd4jLong>(buffer[6] * scale);
+
+            result += sample;
+        }
+#endif
+
+        return result;
+    }
+
+    PerfCounters* PerfCounters::_instance = 0;
+}
@@ -0,0 +1,187 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Thresholds table and its profile files, calibration itself lives in helpers/cpu/ThresholdsTuner.cpp
+//
+
+#include <helpers/ThresholdsTuner.h>
+#include <Environment.h>
+#include <helpers/logger.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace nd4j {
+
+    static const char* FAMILY_NAMES[LoopFamily::NUM_FAMILIES] = {"generic", "transform", "transform_strict", "pairwise", "reduce", "broadcast"};
+    static const char* SLOT_NAMES[] = {"float32", "double", "half", "bfloat16", "int32", "int64", "other"};
+
+    ThresholdsTuner::ThresholdsTuner() {
+        reset();
+
+        const char* profile = std::getenv("ND4J_THRESHOLDS_PROFILE");
+        if (profile != nullptr && load(profile))
+            nd4j_debug("Thresholds profile loaded from %s\n", profile);
+    }
+
+    ThresholdsTuner* ThresholdsTuner::getInstance() {
+        if (_instance == 0)
+            _instance = new ThresholdsTuner();
+
+        return _instance;
+    }
+
+    int ThresholdsTuner::slotOf(nd4j::DataType dataType) {
+        switch (dataType) {
+            case nd4j::DataType::FLOAT32: return 0;
+            case nd4j::DataType::DOUBLE: return 1;
+            case nd4j::DataType::HALF: return 2;
+            case nd4j::DataType::BFLOAT16: return 3;
+            case nd4j::DataType::INT32: return 4;
+            case nd4j::DataType::INT64: return 5;
+            default: return NUM_SLOTS - 1;
+        }
+    }
+
+    Nd4jLong ThresholdsTuner::elementsPerThread(LoopFamily::Family family, nd4j::DataType dataType) {
+        if (_calibrated.load()) {
+            auto value = _elementsPerThread[family][slotOf(dataType)].load();
+            if (value > 0)
+                return value;
+        }
+
+        return Environment::getInstance()->elementwiseThreshold();
+    }
+
+    int ThresholdsTuner::maxThreads(LoopFamily::Family family, nd4j::DataType dataType) {
+#ifdef _OPENMP
+        const int available = omp_get_max_threads();
+#else
+        const int available = 1;
+#endif
+        if (_calibrated.load()) {
+            auto value = _maxThreads[family][slotOf(dataType)].load();
+            if (value > 0)
+                return value < available ? value : available;
+        }
+
+        return available;
+    }
+
+    void ThresholdsTuner::setEntry(LoopFamily::Family family, nd4j::DataType dataType, Nd4jLong elementsPerThread, int maxThreads) {
+        if (family == LoopFamily::GENERIC)
+            return;
+
+        _elementsPerThread[family][slotOf(dataType)].store(elementsPerThread > 0 ? elementsPerThread : 0);
+        _maxThreads[family][slotOf(dataType)].store(maxThreads > 0 ? maxThreads : 0);
+        _calibrated.store(true);
+    }
+
+    bool ThresholdsTuner::isCalibrated() {
+        return _calibrated.load();
+    }
+
+    void ThresholdsTuner::reset() {
+        _calibrated.store(false);
+
+        for (int f = 0; f < LoopFamily::NUM_FAMILIES; f++)
+            for (int s = 0; s < NUM_SLOTS; s++) {
+                _elementsPerThread[f][s].store(0);
+                _maxThreads[f][s].store(0);
+            }
+    }
+
+    bool ThresholdsTuner::load(const char* path) {
+        std::ifstream file(path);
+        if (!file.is_open())
+            return false;
+
+        Nd4jLong elements[LoopFamily::NUM_FAMILIES][NUM_SLOTS] = {};
+        int threads[LoopFamily::NUM_FAMILIES][NUM_SLOTS] = {};
+        int entries = 0;
+
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            std::istringstream stream(line);
+            std::string familyName, slotName;
+            Nd4jLong e = 0;
+            int t = 0;
+            if (!(stream >> familyName >> slotName >> e >> t))
+                continue;
+
+            int f = 1, s = 0;
+            while (f < LoopFamily::NUM_FAMILIES && familyName != FAMILY_NAMES[f])
+                f++;
+            while (s < NUM_SLOTS && slotName != SLOT_NAMES[s])
+                s++;
+
+            if (f == LoopFamily::NUM_FAMILIES || s == NUM_SLOTS || e <= 0 || t <= 0) {
+                nd4j_printf("Thresholds profile %s: skipping malformed entry [%s]\n", path, line.c_str());
+                continue;
+            }
+
+            elements[f][s] = e;
+            threads[f][s] = t;
+            entries++;
+        }
+
+        if (entries == 0)
+            return false;
+
+        reset();
+        for (int f = 1; f < LoopFamily::NUM_FAMILIES; f++)
+            for (int s = 0; s < NUM_SLOTS; s++) {
+                _elementsPerThread[f][s].store(elements[f][s]);
+                _maxThreads[f][s].store(threads[f][s]);
+            }
+        _calibrated.store(true);
+
+        return true;
+    }
+
+    bool ThresholdsTuner::save(const char* path) {
+        std::ofstream file(path);
+        if (!file.is_open())
+            return false;
+
+#ifdef _OPENMP
+        file << "# nd4j thresholds profile, calibrated with " << omp_get_max_threads() << " threads\n";
+#endif
+        file << "# family dtype elementsPerThread maxThreads\n";
+
+        for (int f = 1; f < LoopFamily::NUM_FAMILIES; f++)
+            for (int s = 0; s < NUM_SLOTS; s++) {
+                auto e = _elementsPerThread[f][s].load();
+                auto t = _maxThreads[f][s].load();
+                if (e > 0 && t > 0)
+                    file << FAMILY_NAMES[f] << " " << SLOT_NAMES[s] << " " << e << " " << t << "\n";
+            }
+
+        return file.good();
+    }
+
+    ThresholdsTuner* ThresholdsTuner::_instance = 0;
+}
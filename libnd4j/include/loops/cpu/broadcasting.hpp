@@ -23,6 +23,7 @@
 #include <loops/legacy_ops.h>
 #include <types/types.h>
 #include <LoopKind.h>
+#include <OmpLaunchHelper.h>
 #include <helpers/ConstantTadHelper.h>
 
 using namespace simdOps;
@@ -131,9 +132,14 @@ namespace functions {
                 auto lenZ = shape::length(zTadShapeInfo);
                 auto lenY = shape::length(yShapeInfo);
 
-                int tadsPerThread = tads / TAD_THRESHOLD;
-                int threads = nd4j::math::nd4j_max<int>(1, tadsPerThread);
-                threads = nd4j::math::nd4j_min<int>(threads, omp_get_max_threads());
+                int threads;
+                if (nd4j::ThresholdsTuner::getInstance()->isCalibrated())
+                    threads = nd4j::OmpLaunchHelper::tadThreads(tadLength, tads, nd4j::LoopFamily::BROADCAST, nd4j::DataTypeUtils::fromT<X>());
+                else {
+                    int tadsPerThread = tads / TAD_THRESHOLD;
+                    threads = nd4j::math::nd4j_max<int>(1, tadsPerThread);
+                    threads = nd4j::math::nd4j_min<int>(threads, omp_get_max_threads());
+                }
                 
                 auto xEws = shape::elementWiseStride(xTadShapeShapeInfo);
                 auto yEws = shape::elementWiseStride(yShapeInfo);
@@ -317,9 +323,14 @@ namespace functions {
             auto lenZ = shape::length(zTadShapeInfo);
             auto lenX = shape::length(xShapeInfo);
 
-            int tadsPerThread = tads / TAD_THRESHOLD;
-            int threads = nd4j::math::nd4j_max<int>(1, tadsPerThread);
-            threads = nd4j::math::nd4j_min<int>(threads, omp_get_max_threads());
+            int threads;
+            if (nd4j::ThresholdsTuner::getInstance()->isCalibrated())
+                threads = nd4j::OmpLaunchHelper::tadThreads(tadLength, tads, nd4j::LoopFamily::BROADCAST, nd4j::DataTypeUtils::fromT<X>());
+            else {
+                int tadsPerThread = tads / TAD_THRESHOLD;
+                threads = nd4j::math::nd4j_max<int>(1, tadsPerThread);
+                threads = nd4j::math::nd4j_min<int>(threads, omp_get_max_threads());
+            }
             
             auto yEws = shape::elementWiseStride(yTadShapeShapeInfo);
             auto xEws = shape::elementWiseStride(xShapeInfo);
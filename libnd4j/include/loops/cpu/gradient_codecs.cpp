@@ -0,0 +1,766 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// CPU implementation of gradient compression codecs, see gradient_codecs.h for message layout
+//
+
+#include <loops/gradient_codecs.h>
+#include <types/types.h>
+#include <op_boilerplate.h>
+#include <templatemath.h>
+#include <helpers/logger.h>
+#include <algorithm>
+#include <functional>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace nd4j {
+
+    // number of elements per block for varint-based codecs: delta within block always fits into 3 bytes
+    static const Nd4jLong VARINT_BLOCK = 65536;
+    static const int VARINT_MAX_BYTES = 3;
+
+    // number of elements per block for sign codecs, every block has its own scales
+    static const Nd4jLong SIGN_BLOCK = 4096;
+
+    static FORCEINLINE Nd4jLong blocksOf(Nd4jLong N, Nd4jLong blockLength) {
+        return (N + blockLength - 1) / blockLength;
+    }
+
+    static FORCEINLINE int writeVarint(uint8_t *p, uint32_t value) {
+        int length = 0;
+        while (value >= 0x80) {
+            p[length++] = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        p[length++] = static_cast<uint8_t>(value);
+        return length;
+    }
+
+    static FORCEINLINE uint32_t readVarint(const uint8_t *&p) {
+        uint32_t value = 0;
+        int shift = 0;
+        uint8_t byte;
+        do {
+            byte = *p++;
+            value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        return value;
+    }
+
+    static void writeHeader(void *dz, int codec, Nd4jLong N, Nd4jLong length, float parameter) {
+        auto header = reinterpret_cast<int *>(dz);
+        header[0] = codec;
+        header[1] = static_cast<int>(N);
+        header[2] = static_cast<int>(length);
+        memcpy(&header[3], &parameter, sizeof(float));
+    }
+
+    static float parameterOf(const void *dx) {
+        float parameter;
+        memcpy(&parameter, reinterpret_cast<const int *>(dx) + 3, sizeof(float));
+        return parameter;
+    }
+
+    template <typename T>
+    static FORCEINLINE float magnitudeOf(T value) {
+        return nd4j::math::nd4j_abs<float>(static_cast<float>(value));
+    }
+
+    /**
+     * Varint-based codecs encode blocks into separate buffers, this method lays them out after header:
+     * offsets table of numBlocks + 1 ints, followed by blocks payload. Returns encoded length, or minus required length.
+     */
+    static Nd4jLong layoutBlocks(std::vector<std::vector<uint8_t>> &buffers, void *dz, Nd4jLong capacity) {
+        auto numBlocks = static_cast<Nd4jLong>(buffers.size());
+        auto tableLength = (numBlocks + 1) * static_cast<Nd4jLong>(sizeof(int));
+
+        Nd4jLong payload = 0;
+        for (const auto &buffer: buffers)
+            payload += buffer.size();
+
+        auto length = GradientCodec::HEADER_LENGTH + tableLength + payload;
+        if (length > capacity)
+            return -length;
+
+        if (length > std::numeric_limits<int>::max())
+            throw std::runtime_error("GradientCodec: encoded message exceeds 2GB");
+
+        auto offsets = reinterpret_cast<int *>(reinterpret_cast<uint8_t *>(dz) + GradientCodec::HEADER_LENGTH);
+        auto data = reinterpret_cast<uint8_t *>(offsets) + tableLength;
+
+        offsets[0] = 0;
+        for (Nd4jLong b = 0; b < numBlocks; b++)
+            offsets[b + 1] = offsets[b] + static_cast<int>(buffers[b].size());
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided))
+        for (Nd4jLong b = 0; b < numBlocks; b++)
+            if (!buffers[b].empty())
+                memcpy(data + offsets[b], buffers[b].data(), buffers[b].size());
+
+        return length;
+    }
+
+    static FORCEINLINE const int* offsetsOf(const void *dx) {
+        return reinterpret_cast<const int *>(reinterpret_cast<const uint8_t *>(dx) + GradientCodec::HEADER_LENGTH);
+    }
+
+    static FORCEINLINE const uint8_t* payloadOf(const void *dx, Nd4jLong numBlocks) {
+        return reinterpret_cast<const uint8_t *>(offsetsOf(dx) + numBlocks + 1);
+    }
+
+//////////////////////////////////////////////////////////////////////////
+// Threshold encoding with delta-varint indices: every element with |x| >= threshold is sent as +-threshold.
+// Element is encoded as varint of ((index - previous index) << 1 | sign)
+
+    template <typename T>
+    static Nd4jLong encodeThresholdVarint_(void *vx, Nd4jLong N, void *vz, Nd4jLong capacity, float threshold) {
+        auto x = reinterpret_cast<T *>(vx);
+        auto numBlocks = blocksOf(N, VARINT_BLOCK);
+        auto t = static_cast<T>(threshold);
+        auto mt = static_cast<T>(-threshold);
+
+        std::vector<std::vector<uint8_t>> buffers(numBlocks);
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided))
+        for (Nd4jLong b = 0; b < numBlocks; b++) {
+            auto start = b * VARINT_BLOCK;
+            auto stop = nd4j::math::nd4j_min<Nd4jLong>(N, start + VARINT_BLOCK);
+
+            Nd4jLong count = 0;
+            PRAGMA_OMP_SIMD_ARGS(reduction(+:count))
+            for (Nd4jLong e = start; e < stop; e++)
+                count += (x[e] >= t || x[e] <= mt) ? 1 : 0;
+
+            auto &buffer = buffers[b];
+            buffer.resize(count * VARINT_MAX_BYTES);
+
+            auto p = buffer.data();
+            auto previous = start;
+            for (Nd4jLong e = start; e < stop; e++) {
+                if (x[e] >= t) {
+                    p += writeVarint(p, static_cast<uint32_t>((e - previous) << 1));
+                    previous = e;
+                } else if (x[e] <= mt) {
+                    p += writeVarint(p, static_cast<uint32_t>(((e - previous) << 1) | 1));
+                    previous = e;
+                }
+            }
+
+            buffer.resize(p - buffer.data());
+        }
+
+        auto length = layoutBlocks(buffers, vz, capacity);
+        if (length < 0)
+            return length;
+
+        writeHeader(vz, GradientCodec::THRESHOLD_VARINT, N, length, threshold);
+
+        // error feedback: encoded part is subtracted from source
+        PRAGMA_OMP_PARALLEL_FOR_SIMD
+        for (Nd4jLong e = 0; e < N; e++)
+            x[e] = x[e] >= t ? x[e] - t : x[e] <= mt ? x[e] + t : x[e];
+
+        return length;
+    }
+
+    template <typename T>
+    static void decodeThresholdVarint_(const void *vx, void *vz, Nd4jLong N) {
+        auto z = reinterpret_cast<T *>(vz);
+        auto numBlocks = blocksOf(N, VARINT_BLOCK);
+        auto offsets = offsetsOf(vx);
+        auto data = payloadOf(vx, numBlocks);
+        auto t = static_cast<T>(parameterOf(vx));
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided))
+        for (Nd4jLong b = 0; b < numBlocks; b++) {
+            auto p = data + offsets[b];
+            auto end = data + offsets[b + 1];
+            auto e = b * VARINT_BLOCK;
+
+            while (p < end) {
+                auto code = readVarint(p);
+                e += code >> 1;
+                z[e] += (code & 1) ? -t : t;
+            }
+        }
+    }
+
+    class ThresholdVarintCodec : public GradientCodec {
+    public:
+        int id() const override { return THRESHOLD_VARINT; }
+        const char* name() const override { return "threshold_varint"; }
+
+        Nd4jLong maxEncodedLength(Nd4jLong N, float parameter) const override {
+            return HEADER_LENGTH + (blocksOf(N, VARINT_BLOCK) + 1) * sizeof(int) + N * VARINT_MAX_BYTES;
+        }
+
+        Nd4jLong encode(nd4j::DataType dataType, void *dx, Nd4jLong N, void *dz, Nd4jLong capacity, float parameter) override {
+            if (parameter <= 0.0f)
+                throw std::runtime_error("ThresholdVarintCodec: threshold should be positive");
+
+            BUILD_SINGLE_SELECTOR(dataType, return encodeThresholdVarint_, (dx, N, dz, capacity, parameter), FLOAT_TYPES);
+        }
+
+        void decode(const void *dx, nd4j::DataType dataType, void *dz, Nd4jLong N) override {
+            BUILD_SINGLE_SELECTOR(dataType, decodeThresholdVarint_, (dx, dz, N), FLOAT_TYPES);
+        }
+    };
+
+//////////////////////////////////////////////////////////////////////////
+// Top-k sparsification: exactly k elements of largest magnitude are sent as is, ties are resolved by index.
+// Block payload: varint count, count float32 values, count delta-varint indices
+
+    // parameter is either number of elements, or fraction of them if below 1.0
+    static FORCEINLINE Nd4jLong topKOf(Nd4jLong N, float parameter) {
+        auto k = parameter >= 1.0f ? static_cast<Nd4jLong>(parameter) : static_cast<Nd4jLong>(static_cast<double>(parameter) * N + 0.5);
+        return nd4j::math::nd4j_min<Nd4jLong>(nd4j::math::nd4j_max<Nd4jLong>(1, k), N);
+    }
+
+    template <typename T>
+    static Nd4jLong encodeTopK_(void *vx, Nd4jLong N, void *vz, Nd4jLong capacity, float parameter) {
+        auto x = reinterpret_cast<T *>(vx);
+        auto numBlocks = blocksOf(N, VARINT_BLOCK);
+
+        auto k = topKOf(N, parameter);
+
+        std::vector<Nd4jLong> greater(numBlocks, 0);
+        std::vector<Nd4jLong> ties(numBlocks, 0);
+        float kth = std::numeric_limits<float>::max();
+
+        if (k > 0) {
+            // threshold estimate from strided sample, aiming at ~2k candidates, so exact selection works on a small subset
+            auto sampleLength = nd4j::math::nd4j_min<Nd4jLong>(N, 16384);
+            auto stride = N / sampleLength;
+            std::vector<float> sample(sampleLength);
+            for (Nd4jLong e = 0; e < sampleLength; e++)
+                sample[e] = magnitudeOf(x[e * stride]);
+
+            auto above = nd4j::math::nd4j_min<Nd4jLong>(sampleLength - 1, (2 * k * sampleLength) / N);
+            std::nth_element(sample.begin(), sample.begin() + (sampleLength - 1 - above), sample.end());
+            auto estimate = sample[sampleLength - 1 - above];
+
+            std::vector<Nd4jLong> candidates(numBlocks + 1, 0);
+            auto countCandidates = [&] (float threshold) -> Nd4jLong {
+                PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided))
+                for (Nd4jLong b = 0; b < numBlocks; b++) {
+                    auto start = b * VARINT_BLOCK;
+                    auto stop = nd4j::math::nd4j_min<Nd4jLong>(N, start + VARINT_BLOCK);
+
+                    Nd4jLong count = 0;
+                    PRAGMA_OMP_SIMD_ARGS(reduction(+:count))
+                    for (Nd4jLong e = start; e < stop; e++)
+                        count += magnitudeOf(x[e]) >= threshold ? 1 : 0;
+
+                    candidates[b + 1] = count;
+                }
+
+                for (Nd4jLong b = 0; b < numBlocks; b++)
+                    candidates[b + 1] += candidates[b];
+
+                return candidates[numBlocks];
+            };
+
+            // estimate was too high, so we fall back to full selection
+            if (countCandidates(estimate) < k) {
+                estimate = 0.0f;
+                countCandidates(estimate);
+            }
+
+            std::vector<float> magnitudes(candidates[numBlocks]);
+
+            PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided))
+            for (Nd4jLong b = 0; b < numBlocks; b++) {
+                auto start = b * VARINT_BLOCK;
+                auto stop = nd4j::math::nd4j_min<Nd4jLong>(N, start + VARINT_BLOCK);
+                auto p = magnitudes.data() + candidates[b];
+
+                for (Nd4jLong e = start; e < stop; e++) {
+                    auto m = magnitudeOf(x[e]);
+                    if (m >= estimate)
+                        *p++ = m;
+                }
+            }
+
+            std::nth_element(magnitudes.begin(), magnitudes.begin() + (k - 1), magnitudes.end(), std::greater<float>());
+            kth = magnitudes[k - 1];
+
+            PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided))
+            for (Nd4jLong b = 0; b < numBlocks; b++) {
+                auto start = b * VARINT_BLOCK;
+                auto stop = nd4j::math::nd4j_min<Nd4jLong>(N, start + VARINT_BLOCK);
+
+                Nd4jLong g = 0, eq = 0;
+                PRAGMA_OMP_SIMD_ARGS(reduction(+:g,eq))
+                for (Nd4jLong e = start; e < stop; e++) {
+                    auto m = magnitudeOf(x[e]);
+                    g += m > kth ? 1 : 0;
+                    eq += m == kth ? 1 : 0;
+                }
+
+                greater[b] = g;
+                ties[b] = eq;
+            }
+
+            // elements equal to k-th magnitude are taken in index order, till we have exactly k elements
+            Nd4jLong remaining = k;
+            for (Nd4jLong b = 0; b < numBlocks; b++)
+                remaining -= greater[b];
+
+            for (Nd4jLong b = 0; b < numBlocks; b++) {
+                ties[b] = nd4j::math::nd4j_min<Nd4jLong>(ties[b], remaining);
+                remaining -= ties[b];
+            }
+        }
+
+        std::vector<std::vector<uint8_t>> buffers(numBlocks);
+        std::vector<std::vector<int>> selected(numBlocks);
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided))
+        for (Nd4jLong b = 0; b < numBlocks; b++) {
+            auto start = b * VARINT_BLOCK;
+            auto stop = nd4j::math::nd4j_min<Nd4jLong>(N, start + VARINT_BLOCK);
+            auto count = greater[b] + ties[b];
+
+            auto &buffer = buffers[b];
+            auto &indices = selected[b];
+            buffer.resize(VARINT_MAX_BYTES + count * (sizeof(float) + VARINT_MAX_BYTES));
+            indices.reserve(count);
+
+            auto p = buffer.data();
+            p += writeVarint(p, static_cast<uint32_t>(count));
+
+            auto values = p;
+            p += count * sizeof(float);
+
+            auto tiesLeft = ties[b];
+            auto previous = start;
+            for (Nd4jLong e = start; e < stop && static_cast<Nd4jLong>(indices.size()) < count; e++) {
+                auto m = magnitudeOf(x[e]);
+                if (m > kth || (m == kth && tiesLeft-- > 0)) {
+                    auto value = static_cast<float>(x[e]);
+                    memcpy(values, &value, sizeof(float));
+                    values += sizeof(float);
+
+                    p += writeVarint(p, static_cast<uint32_t>(e - previous));
+                    previous = e;
+                    indices.emplace_back(static_cast<int>(e - start));
+                }
+            }
+
+            buffer.resize(p - buffer.data());
+        }
+
+        auto length = layoutBlocks(buffers, vz, capacity);
+        if (length < 0)
+            return length;
+
+        writeHeader(vz, GradientCodec::TOP_K, N, length, parameter);
+
+        // error feedback: whatever wasn't representable in float32 stays in source
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided))
+        for (Nd4jLong b = 0; b < numBlocks; b++) {
+            auto bx = x + b * VARINT_BLOCK;
+            for (auto i: selected[b])
+                bx[i] = bx[i] - static_cast<T>(static_cast<float>(bx[i]));
+        }
+
+        return length;
+    }
+
+    template <typename T>
+    static void decodeTopK_(const void *vx, void *vz, Nd4jLong N) {
+        auto z = reinterpret_cast<T *>(vz);
+        auto numBlocks = blocksOf(N, VARINT_BLOCK);
+        auto offsets = offsetsOf(vx);
+        auto data = payloadOf(vx, numBlocks);
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided))
+        for (Nd4jLong b = 0; b < numBlocks; b++) {
+            auto p = data + offsets[b];
+            auto count = readVarint(p);
+            auto values = p;
+            p += count * sizeof(float);
+
+            auto e = b * VARINT_BLOCK;
+            for (uint32_t i = 0; i < count; i++) {
+                float value;
+                memcpy(&value, values + i * sizeof(float), sizeof(float));
+                e += readVarint(p);
+                z[e] += static_cast<T>(value);
+            }
+        }
+    }
+
+    class TopKCodec : public GradientCodec {
+    public:
+        int id() const override { return TOP_K; }
+        const char* name() const override { return "top_k"; }
+
+        Nd4jLong maxEncodedLength(Nd4jLong N, float parameter) const override {
+            auto k = topKOf(N, parameter);
+            auto numBlocks = blocksOf(N, VARINT_BLOCK);
+            return HEADER_LENGTH + (numBlocks + 1) * sizeof(int) + numBlocks * VARINT_MAX_BYTES + k * (sizeof(float) + VARINT_MAX_BYTES);
+        }
+
+        Nd4jLong encode(nd4j::DataType dataType, void *dx, Nd4jLong N, void *dz, Nd4jLong capacity, float parameter) override {
+            if (parameter <= 0.0f)
+                throw std::runtime_error("TopKCodec: number or fraction of elements should be positive");
+
+            BUILD_SINGLE_SELECTOR(dataType, return encodeTopK_, (dx, N, dz, capacity, parameter), FLOAT_TYPES);
+        }
+
+        void decode(const void *dx, nd4j::DataType dataType, void *dz, Nd4jLong N) override {
+            BUILD_SINGLE_SELECTOR(dataType, decodeTopK_, (dx, dz, N), FLOAT_TYPES);
+        }
+    };
+
+//////////////////////////////////////////////////////////////////////////
+// Sign quantisation. Both codecs have fixed-size blocks: two float scales followed by packed codes.
+// 1 bit: element is either mean of non-negative elements of the block, or minus mean magnitude of negative ones.
+// 2 bits: sign and magnitude level, levels are mean magnitudes below and above mean magnitude of the block.
+
+    template <int BITS>
+    static FORCEINLINE Nd4jLong signBlockLength(Nd4jLong elements) {
+        const Nd4jLong perWord = 32 / BITS;
+        return 2 * sizeof(float) + ((elements + perWord - 1) / perWord) * sizeof(uint32_t);
+    }
+
+    template <int BITS>
+    static FORCEINLINE Nd4jLong signEncodedLength(Nd4jLong N) {
+        auto full = N / SIGN_BLOCK;
+        auto tail = N % SIGN_BLOCK;
+        return GradientCodec::HEADER_LENGTH + full * signBlockLength<BITS>(SIGN_BLOCK) + (tail > 0 ? signBlockLength<BITS>(tail) : 0);
+    }
+
+    template <typename T>
+    static void encodeSign1Block(T *x, Nd4jLong length, uint8_t *block) {
+        float positive = 0.0f, negative = 0.0f;
+        Nd4jLong numPositive = 0;
+
+        PRAGMA_OMP_SIMD_ARGS(reduction(+:positive,negative,numPositive))
+        for (Nd4jLong e = 0; e < length; e++) {
+            auto v = static_cast<float>(x[e]);
+            if (v >= 0.0f) {
+                positive += v;
+                numPositive++;
+            } else
+                negative -= v;
+        }
+
+        float scales[2] = {numPositive > 0 ? positive / numPositive : 0.0f, numPositive < length ? negative / (length - numPositive) : 0.0f};
+        memcpy(block, scales, sizeof(scales));
+
+        auto p = static_cast<T>(scales[0]);
+        auto n = static_cast<T>(scales[1]);
+        auto words = block + sizeof(scales);
+
+        for (Nd4jLong w = 0; w * 32 < length; w++) {
+            auto bx = x + w * 32;
+            auto limit = nd4j::math::nd4j_min<Nd4jLong>(32, length - w * 32);
+
+            uint32_t bits = 0;
+            PRAGMA_OMP_SIMD_ARGS(reduction(|:bits))
+            for (Nd4jLong j = 0; j < limit; j++)
+                bits |= static_cast<uint32_t>(static_cast<float>(bx[j]) >= 0.0f) << j;
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong j = 0; j < limit; j++)
+                bx[j] = ((bits >> j) & 1) ? bx[j] - p : bx[j] + n;
+
+            memcpy(words + w * sizeof(uint32_t), &bits, sizeof(uint32_t));
+        }
+    }
+
+    template <typename T>
+    static void decodeSign1Block(const uint8_t *block, T *z, Nd4jLong length) {
+        float scales[2];
+        memcpy(scales, block, sizeof(scales));
+
+        auto p = static_cast<T>(scales[0]);
+        auto n = static_cast<T>(-scales[1]);
+        auto words = block + sizeof(scales);
+
+        for (Nd4jLong w = 0; w * 32 < length; w++) {
+            auto bz = z + w * 32;
+            auto limit = nd4j::math::nd4j_min<Nd4jLong>(32, length - w * 32);
+
+            uint32_t bits;
+            memcpy(&bits, words + w * sizeof(uint32_t), sizeof(uint32_t));
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong j = 0; j < limit; j++)
+                bz[j] += ((bits >> j) & 1) ? p : n;
+        }
+    }
+
+    template <typename T>
+    static void encodeSign2Block(T *x, Nd4jLong length, uint8_t *block) {
+        float sum = 0.0f;
+
+        PRAGMA_OMP_SIMD_ARGS(reduction(+:sum))
+        for (Nd4jLong e = 0; e < length; e++)
+            sum += magnitudeOf(x[e]);
+
+        auto mean = sum / length;
+        float low = 0.0f, high = 0.0f;
+        Nd4jLong numHigh = 0;
+
+        PRAGMA_OMP_SIMD_ARGS(reduction(+:low,high,numHigh))
+        for (Nd4jLong e = 0; e < length; e++) {
+            auto m = magnitudeOf(x[e]);
+            if (m >= mean) {
+                high += m;
+                numHigh++;
+            } else
+                low += m;
+        }
+
+        float scales[2] = {numHigh < length ? low / (length - numHigh) : 0.0f, numHigh > 0 ? high / numHigh : 0.0f};
+        memcpy(block, scales, sizeof(scales));
+
+        auto words = block + sizeof(scales);
+
+        for (Nd4jLong w = 0; w * 16 < length; w++) {
+            auto bx = x + w * 16;
+            auto limit = nd4j::math::nd4j_min<Nd4jLong>(16, length - w * 16);
+
+            uint32_t bits = 0;
+            PRAGMA_OMP_SIMD_ARGS(reduction(|:bits))
+            for (Nd4jLong j = 0; j < limit; j++) {
+                auto v = static_cast<float>(bx[j]);
+                uint32_t code = (v < 0.0f ? 1 : 0) | (magnitudeOf(v) >= mean ? 2 : 0);
+                bits |= code << (2 * j);
+            }
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong j = 0; j < limit; j++) {
+                auto code = (bits >> (2 * j)) & 3;
+                auto level = scales[code >> 1];
+                bx[j] = static_cast<T>(static_cast<float>(bx[j]) - ((code & 1) ? -level : level));
+            }
+
+            memcpy(words + w * sizeof(uint32_t), &bits, sizeof(uint32_t));
+        }
+    }
+
+    template <typename T>
+    static void decodeSign2Block(const uint8_t *block, T *z, Nd4jLong length) {
+        float scales[2];
+        memcpy(scales, block, sizeof(scales));
+
+        // all 4 possible values, indexed by code
+        T levels[4] = {static_cast<T>(scales[0]), static_cast<T>(-scales[0]), static_cast<T>(scales[1]), static_cast<T>(-scales[1])};
+        auto words = block + sizeof(scales);
+
+        for (Nd4jLong w = 0; w * 16 < length; w++) {
+            auto bz = z + w * 16;
+            auto limit = nd4j::math::nd4j_min<Nd4jLong>(16, length - w * 16);
+
+            uint32_t bits;
+            memcpy(&bits, words + w * sizeof(uint32_t), sizeof(uint32_t));
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong j = 0; j < limit; j++)
+                bz[j] += levels[(bits >> (2 * j)) & 3];
+        }
+    }
+
+    template <typename T, int BITS>
+    static Nd4jLong encodeSign_(void *vx, Nd4jLong N, void *vz, Nd4jLong capacity) {
+        auto length = signEncodedLength<BITS>(N);
+        if (length > capacity)
+            return -length;
+
+        auto x = reinterpret_cast<T *>(vx);
+        auto data = reinterpret_cast<uint8_t *>(vz) + GradientCodec::HEADER_LENGTH;
+        auto numBlocks = blocksOf(N, SIGN_BLOCK);
+        auto fullBlockLength = signBlockLength<BITS>(SIGN_BLOCK);
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided))
+        for (Nd4jLong b = 0; b < numBlocks; b++) {
+            auto start = b * SIGN_BLOCK;
+            auto elements = nd4j::math::nd4j_min<Nd4jLong>(SIGN_BLOCK, N - start);
+
+            if (BITS == 1)
+                encodeSign1Block<T>(x + start, elements, data + b * fullBlockLength);
+            else
+                encodeSign2Block<T>(x + start, elements, data + b * fullBlockLength);
+        }
+
+        writeHeader(vz, BITS == 1 ? GradientCodec::SIGN_1BIT : GradientCodec::SIGN_2BIT, N, length, 0.0f);
+
+        return length;
+    }
+
+    template <typename T, int BITS>
+    static void decodeSign_(const void *vx, void *vz, Nd4jLong N) {
+        auto z = reinterpret_cast<T *>(vz);
+        auto data = reinterpret_cast<const uint8_t *>(vx) + GradientCodec::HEADER_LENGTH;
+        auto numBlocks = blocksOf(N, SIGN_BLOCK);
+        auto fullBlockLength = signBlockLength<BITS>(SIGN_BLOCK);
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided))
+        for (Nd4jLong b = 0; b < numBlocks; b++) {
+            auto start = b * SIGN_BLOCK;
+            auto elements = nd4j::math::nd4j_min<Nd4jLong>(SIGN_BLOCK, N - start);
+
+            if (BITS == 1)
+                decodeSign1Block<T>(data + b * fullBlockLength, z + start, elements);
+            else
+                decodeSign2Block<T>(data + b * fullBlockLength, z + start, elements);
+        }
+    }
+
+    template <typename T>
+    static Nd4jLong encodeSign1_(void *vx, Nd4jLong N, void *vz, Nd4jLong capacity) {
+        return encodeSign_<T, 1>(vx, N, vz, capacity);
+    }
+
+    template <typename T>
+    static Nd4jLong encodeSign2_(void *vx, Nd4jLong N, void *vz, Nd4jLong capacity) {
+        return encodeSign_<T, 2>(vx, N, vz, capacity);
+    }
+
+    template <typename T>
+    static void decodeSign1_(const void *vx, void *vz, Nd4jLong N) {
+        decodeSign_<T, 1>(vx, vz, N);
+    }
+
+    template <typename T>
+    static void decodeSign2_(const void *vx, void *vz, Nd4jLong N) {
+        decodeSign_<T, 2>(vx, vz, N);
+    }
+
+    class Sign1BitCodec : public GradientCodec {
+    public:
+        int id() const override { return SIGN_1BIT; }
+        const char* name() const override { return "sign_1bit"; }
+
+        Nd4jLong maxEncodedLength(Nd4jLong N, float parameter) const override {
+            return signEncodedLength<1>(N);
+        }
+
+        Nd4jLong encode(nd4j::DataType dataType, void *dx, Nd4jLong N, void *dz, Nd4jLong capacity, float parameter) override {
+            BUILD_SINGLE_SELECTOR(dataType, return encodeSign1_, (dx, N, dz, capacity), FLOAT_TYPES);
+        }
+
+        void decode(const void *dx, nd4j::DataType dataType, void *dz, Nd4jLong N) override {
+            BUILD_SINGLE_SELECTOR(dataType, decodeSign1_, (dx, dz, N), FLOAT_TYPES);
+        }
+    };
+
+    class Sign2BitCodec : public GradientCodec {
+    public:
+        int id() const override { return SIGN_2BIT; }
+        const char* name() const override { return "sign_2bit"; }
+
+        Nd4jLong maxEncodedLength(Nd4jLong N, float parameter) const override {
+            return signEncodedLength<2>(N);
+        }
+
+        Nd4jLong encode(nd4j::DataType dataType, void *dx, Nd4jLong N, void *dz, Nd4jLong capacity, float parameter) override {
+            BUILD_SINGLE_SELECTOR(dataType, return encodeSign2_, (dx, N, dz, capacity), FLOAT_TYPES);
+        }
+
+        void decode(const void *dx, nd4j::DataType dataType, void *dz, Nd4jLong N) override {
+            BUILD_SINGLE_SELECTOR(dataType, decodeSign2_, (dx, dz, N), FLOAT_TYPES);
+        }
+    };
+
+//////////////////////////////////////////////////////////////////////////
+
+    int GradientCodec::codecOf(const void *encoded) {
+        return reinterpret_cast<const int *>(encoded)[0];
+    }
+
+    Nd4jLong GradientCodec::lengthOf(const void *encoded) {
+        return reinterpret_cast<const int *>(encoded)[2];
+    }
+
+    GradientCodecs::GradientCodecs() {
+        registerCodec(new ThresholdVarintCodec());
+        registerCodec(new TopKCodec());
+        registerCodec(new Sign1BitCodec());
+        registerCodec(new Sign2BitCodec());
+    }
+
+    GradientCodecs* GradientCodecs::getInstance() {
+        if (_instance == 0)
+            _instance = new GradientCodecs();
+
+        return _instance;
+    }
+
+    void GradientCodecs::registerCodec(GradientCodec* codec) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _codecs.find(codec->id());
+        if (it != _codecs.end()) {
+            if (it->second == codec)
+                return;
+
+            delete it->second;
+        }
+
+        _codecs[codec->id()] = codec;
+    }
+
+    GradientCodec* GradientCodecs::codec(int id) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _codecs.find(id);
+        return it == _codecs.end() ? nullptr : it->second;
+    }
+
+    Nd4jLong GradientCodecs::encode(int codecId, nd4j::DataType dataType, void *dx, Nd4jLong N, void *dz, Nd4jLong capacity, float parameter) {
+        auto c = codec(codecId);
+        if (c == nullptr) {
+            nd4j_printf("GradientCodecs: unknown codec [%i]\n", codecId);
+            throw std::runtime_error("GradientCodecs: unknown codec");
+        }
+
+        if (N > std::numeric_limits<int>::max())
+            throw std::runtime_error("GradientCodecs: number of elements exceeds 2^31");
+
+        return c->encode(dataType, dx, N, dz, capacity, parameter);
+    }
+
+    void GradientCodecs::decode(const void *dx, nd4j::DataType dataType, void *dz, Nd4jLong N) {
+        auto codecId = GradientCodec::codecOf(dx);
+        auto c = codec(codecId);
+        if (c == nullptr) {
+            nd4j_printf("GradientCodecs: unknown codec [%i]\n", codecId);
+            throw std::runtime_error("GradientCodecs: unknown codec");
+        }
+
+        auto encodedN = reinterpret_cast<const int *>(dx)[1];
+        if (encodedN != N) {
+            nd4j_printf("GradientCodecs: message has %i elements, but target has %lld\n", encodedN, (long long) N);
+            throw std::runtime_error("GradientCodecs: length mismatch");
+        }
+
+        c->decode(dx, dataType, dz, N);
+    }
+
+    GradientCodecs* GradientCodecs::_instance = 0;
+}
@@ -59,7 +59,7 @@ Nd4jLong IndexReduce<X>::execScalar(void *vx, Nd4jLong *xShapeInfo, void *vextra
     auto startingIndex = OpType::startingIndexValue(x);
     auto len = shape::length(xShapeInfo);
     auto xEws = shape::elementWiseStride(xShapeInfo);
-    nd4j::OmpLaunchHelper info(len);
+    nd4j::OmpLaunchHelper info(len, -1, nd4j::LoopFamily::REDUCE, nd4j::DataTypeUtils::fromT<X>());
 
     uint xShapeInfoCast[MAX_RANK];
     bool canCastX = nd4j::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
@@ -67,7 +67,7 @@ namespace functions {
             auto z = reinterpret_cast<Z *>(vz);
             auto extraParams = reinterpret_cast<X *>(vextraParams);
 
-            nd4j::OmpLaunchHelper info(n);
+            nd4j::OmpLaunchHelper info(n, -1, nd4j::LoopFamily::PAIRWISE, nd4j::DataTypeUtils::fromT<X>());
 
             if (xEws == 1 && yEws == 1 && zEws == 1) {
 
@@ -141,7 +141,7 @@ namespace functions {
             auto yEws = shape::elementWiseStride(yShapeInfo);
             auto zEws = shape::elementWiseStride(zShapeInfo);
 
-            nd4j::OmpLaunchHelper info(n);
+            nd4j::OmpLaunchHelper info(n, -1, nd4j::LoopFamily::PAIRWISE, nd4j::DataTypeUtils::fromT<X>());
 
             if (shape::isScalar(yShapeInfo)) {
 
@@ -220,7 +220,7 @@ namespace functions {
                 auto extraParams = reinterpret_cast<Z *>(vextraParams);
 
                 auto startingVal = OpType::startingValue(x);
-                nd4j::OmpLaunchHelper info(length);
+                nd4j::OmpLaunchHelper info(length, -1, nd4j::LoopFamily::REDUCE, nd4j::DataTypeUtils::fromT<X>());
                 int nt = info._numThreads;
 
             if (xEws == 1) {
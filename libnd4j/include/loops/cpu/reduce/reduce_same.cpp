@@ -226,7 +226,7 @@ namespace functions {
                 auto extraParams = reinterpret_cast<X *>(vextraParams);
 
                 auto startingVal = OpType::startingValue(x);
-                nd4j::OmpLaunchHelper info(length);
+                nd4j::OmpLaunchHelper info(length, -1, nd4j::LoopFamily::REDUCE, nd4j::DataTypeUtils::fromT<X>());
 
                 if (xEws == 1) {
 
@@ -24,6 +24,9 @@
 #include <loops/legacy_ops.h>
 #include <helpers/ConstantTadHelper.h>
 #include <Loops.h>
+#include <helpers/BlasHelper.h>
+#include <vector>
+#include <limits>
 
 using namespace simdOps;
 
@@ -219,6 +222,269 @@ void Reduce3<X,Y>::exec( const int opNum,
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+// Blocked all-pairs kernels.
+// Both TAD sets are brought to row-major matrices [numTads, tadLen], packed only if TADs aren't already laid out like that.
+// Dot, Euclidean and cosine ops are evaluated as one GEMM x * y^T plus squared norms, i.e. ||x - y||^2 = ||x||^2 + ||y||^2 - 2 * x.y
+// Manhattan, Jaccard and Hamming ops go through cache-tiled pair kernels: tile of x rows against tile of y rows, chunk by chunk along tadLen.
+namespace blocked {
+
+    // number of pairs * tadLen below which per-pair loops are good enough
+    static const Nd4jLong REDUCE3_ALL_THRESHOLD = 65536;
+
+    static const Nd4jLong TILE_X = 16;
+    static const Nd4jLong TILE_Y = 64;
+    static const Nd4jLong TILE_LEN = 512;
+
+    template <typename T>
+    struct PairDot {
+        static FORCEINLINE void accumulate(const T* a, const T* b, Nd4jLong length, T& acc0, T& acc1) {
+            T sum = static_cast<T>(0.f);
+            PRAGMA_OMP_SIMD_ARGS(reduction(+:sum))
+            for (Nd4jLong e = 0; e < length; e++)
+                sum += a[e] * b[e];
+            acc0 += sum;
+        }
+
+        static FORCEINLINE T finalize(T acc0, T acc1, Nd4jLong length) { return acc0; }
+    };
+
+    template <typename T>
+    struct PairManhattan {
+        static FORCEINLINE void accumulate(const T* a, const T* b, Nd4jLong length, T& acc0, T& acc1) {
+            T sum = static_cast<T>(0.f);
+            PRAGMA_OMP_SIMD_ARGS(reduction(+:sum))
+            for (Nd4jLong e = 0; e < length; e++)
+                sum += nd4j::math::nd4j_abs<T>(a[e] - b[e]);
+            acc0 += sum;
+        }
+
+        static FORCEINLINE T finalize(T acc0, T acc1, Nd4jLong length) { return acc0; }
+    };
+
+    template <typename T>
+    struct PairJaccard {
+        static FORCEINLINE void accumulate(const T* a, const T* b, Nd4jLong length, T& acc0, T& acc1) {
+            T sumMin = static_cast<T>(0.f);
+            T sumMax = static_cast<T>(0.f);
+            PRAGMA_OMP_SIMD_ARGS(reduction(+:sumMin) reduction(+:sumMax))
+            for (Nd4jLong e = 0; e < length; e++) {
+                sumMin += nd4j::math::nd4j_min<T>(a[e], b[e]);
+                sumMax += nd4j::math::nd4j_max<T>(a[e], b[e]);
+            }
+            acc0 += sumMin;
+            acc1 += sumMax;
+        }
+
+        static FORCEINLINE T finalize(T acc0, T acc1, Nd4jLong length) { return static_cast<T>(1.f) - acc0 / acc1; }
+    };
+
+    template <typename T>
+    struct PairHamming {
+        static FORCEINLINE void accumulate(const T* a, const T* b, Nd4jLong length, T& acc0, T& acc1) {
+            T sum = static_cast<T>(0.f);
+            PRAGMA_OMP_SIMD_ARGS(reduction(+:sum))
+            for (Nd4jLong e = 0; e < length; e++)
+                sum += a[e] == b[e] ? static_cast<T>(0.f) : static_cast<T>(1.f);
+            acc0 += sum;
+        }
+
+        static FORCEINLINE T finalize(T acc0, T acc1, Nd4jLong length) { return acc0 / static_cast<T>(length); }
+    };
+
+    // returns TADs as [numTads, tadLen] row-major matrix, packed into buffer if they are not laid out that way already
+    template <typename T>
+    static const T* rows(const T* x, Nd4jLong* tadShapeInfo, Nd4jLong* tadOffsets, Nd4jLong numTads, Nd4jLong tadLen, std::vector<T>& buffer) {
+        bool regular = shape::elementWiseStride(tadShapeInfo) == 1;
+        for (Nd4jLong r = 1; r < numTads && regular; r++)
+            regular = tadOffsets[r] == tadOffsets[0] + r * tadLen;
+
+        if (regular)
+            return x + tadOffsets[0];
+
+        buffer.resize(numTads * tadLen);
+        auto packed = buffer.data();
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numTads > 1)
+        for (Nd4jLong r = 0; r < numTads; r++) {
+            auto tad = x + tadOffsets[r];
+            for (Nd4jLong e = 0; e < tadLen; e++)
+                packed[r * tadLen + e] = tad[shape::getIndexOffset(e, tadShapeInfo, tadLen)];
+        }
+
+        return packed;
+    }
+
+    template <typename T>
+    static void squaredNorms(const T* a, Nd4jLong numRows, Nd4jLong length, std::vector<T>& norms) {
+        norms.resize(numRows);
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numRows * length > REDUCE3_ALL_THRESHOLD)
+        for (Nd4jLong r = 0; r < numRows; r++) {
+            T acc = static_cast<T>(0.f), unused = static_cast<T>(0.f);
+            PairDot<T>::accumulate(a + r * length, a + r * length, length, acc, unused);
+            norms[r] = acc;
+        }
+    }
+
+    // c[(i * numB + j) * cEws] = OpType(a[i], b[j])
+    template <typename T, typename OpType>
+    static void tiledPairs(const T* a, Nd4jLong numA, const T* b, Nd4jLong numB, Nd4jLong length, T* c, Nd4jLong cEws) {
+        const Nd4jLong tilesA = (numA + TILE_X - 1) / TILE_X;
+        const Nd4jLong tilesB = (numB + TILE_Y - 1) / TILE_Y;
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(guided) collapse(2))
+        for (Nd4jLong ta = 0; ta < tilesA; ta++) {
+            for (Nd4jLong tb = 0; tb < tilesB; tb++) {
+                const Nd4jLong startA = ta * TILE_X;
+                const Nd4jLong startB = tb * TILE_Y;
+                const Nd4jLong sizeA = nd4j::math::nd4j_min<Nd4jLong>(TILE_X, numA - startA);
+                const Nd4jLong sizeB = nd4j::math::nd4j_min<Nd4jLong>(TILE_Y, numB - startB);
+
+                T acc0[TILE_X * TILE_Y];
+                T acc1[TILE_X * TILE_Y];
+                for (Nd4jLong e = 0; e < TILE_X * TILE_Y; e++) {
+                    acc0[e] = static_cast<T>(0.f);
+                    acc1[e] = static_cast<T>(0.f);
+                }
+
+                // chunks of both tiles stay in cache while every pair of their rows is processed
+                for (Nd4jLong k = 0; k < length; k += TILE_LEN) {
+                    const Nd4jLong chunk = nd4j::math::nd4j_min<Nd4jLong>(TILE_LEN, length - k);
+                    for (Nd4jLong i = 0; i < sizeA; i++)
+                        for (Nd4jLong j = 0; j < sizeB; j++)
+                            OpType::accumulate(a + (startA + i) * length + k, b + (startB + j) * length + k, chunk, acc0[i * TILE_Y + j], acc1[i * TILE_Y + j]);
+                }
+
+                for (Nd4jLong i = 0; i < sizeA; i++)
+                    for (Nd4jLong j = 0; j < sizeB; j++)
+                        c[((startA + i) * numB + startB + j) * cEws] = OpType::finalize(acc0[i * TILE_Y + j], acc1[i * TILE_Y + j], length);
+            }
+        }
+    }
+
+    static bool gemm(const float* a, int numA, const float* b, int numB, int length, float* c) {
+        if (!nd4j::BlasHelper::getInstance()->hasGEMM(nd4j::DataType::FLOAT32))
+            return false;
+
+        nd4j::BlasHelper::getInstance()->sgemm()(CblasRowMajor, CblasNoTrans, CblasTrans, numA, numB, length, 1.0f, const_cast<float*>(a), length, const_cast<float*>(b), length, 0.0f, c, numB);
+        return true;
+    }
+
+    static bool gemm(const double* a, int numA, const double* b, int numB, int length, double* c) {
+        if (!nd4j::BlasHelper::getInstance()->hasGEMM(nd4j::DataType::DOUBLE))
+            return false;
+
+        nd4j::BlasHelper::getInstance()->dgemm()(CblasRowMajor, CblasNoTrans, CblasTrans, numA, numB, length, 1.0, const_cast<double*>(a), length, const_cast<double*>(b), length, 0.0, c, numB);
+        return true;
+    }
+
+    template <typename T>
+    static bool execAll(const int opNum, T* x, Nd4jLong* xShapeInfo, T* y, Nd4jLong* yShapeInfo, T* z, Nd4jLong* zShapeInfo,
+                        Nd4jLong* xTadShapeInfo, Nd4jLong* xOffsets, Nd4jLong* yTadShapeInfo, Nd4jLong* yOffsets) {
+
+        // EqualsWithEps isn't a metric worth blocking
+        if (opNum == 4)
+            return false;
+
+        const Nd4jLong tadLen = shape::length(xTadShapeInfo);
+        const Nd4jLong zEws = shape::elementWiseStride(zShapeInfo);
+        if (tadLen < 1 || zEws < 1)
+            return false;
+
+        const Nd4jLong numX = shape::length(xShapeInfo) / tadLen;
+        const Nd4jLong numY = shape::length(yShapeInfo) / tadLen;
+        if (numX * numY * tadLen < REDUCE3_ALL_THRESHOLD)
+            return false;
+
+        std::vector<T> xBuffer, yBuffer;
+        const T* a = rows<T>(x, xTadShapeInfo, xOffsets, numX, tadLen, xBuffer);
+        const T* b = rows<T>(y, yTadShapeInfo, yOffsets, numY, tadLen, yBuffer);
+
+        switch (opNum) {
+            case 0:
+                tiledPairs<T, PairManhattan<T>>(a, numX, b, numY, tadLen, z, zEws);
+                return true;
+            case 6:
+                tiledPairs<T, PairJaccard<T>>(a, numX, b, numY, tadLen, z, zEws);
+                return true;
+            case 7:
+                tiledPairs<T, PairHamming<T>>(a, numX, b, numY, tadLen, z, zEws);
+                return true;
+            default:
+                break;
+        }
+
+        // dot products first: straight into z when it's contiguous
+        std::vector<T> dotBuffer;
+        T* dots = z;
+        if (zEws != 1) {
+            dotBuffer.resize(numX * numY);
+            dots = dotBuffer.data();
+        }
+
+        const bool int32Dims = numX < std::numeric_limits<int>::max() && numY < std::numeric_limits<int>::max() && tadLen < std::numeric_limits<int>::max();
+        if (!int32Dims || !gemm(a, static_cast<int>(numX), b, static_cast<int>(numY), static_cast<int>(tadLen), dots))
+            tiledPairs<T, PairDot<T>>(a, numX, b, numY, tadLen, dots, 1);
+
+        std::vector<T> xNorms, yNorms;
+        if (opNum != 3) {
+            squaredNorms<T>(a, numX, tadLen, xNorms);
+            squaredNorms<T>(b, numY, tadLen, yNorms);
+        }
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(collapse(2))
+        for (Nd4jLong i = 0; i < numX; i++) {
+            for (Nd4jLong j = 0; j < numY; j++) {
+                const T dot = dots[i * numY + j];
+                T result;
+                switch (opNum) {
+                    case 1:
+                        // rounding may turn distance between (almost) equal vectors slightly negative
+                        result = nd4j::math::nd4j_sqrt<T, T>(nd4j::math::nd4j_max<T>(static_cast<T>(0.f), xNorms[i] + yNorms[j] - static_cast<T>(2.f) * dot));
+                        break;
+                    case 2:
+                        result = dot / (nd4j::math::nd4j_sqrt<T, T>(xNorms[i]) * nd4j::math::nd4j_sqrt<T, T>(yNorms[j]));
+                        break;
+                    case 5:
+                        result = static_cast<T>(1.f) - dot / (nd4j::math::nd4j_sqrt<T, T>(xNorms[i]) * nd4j::math::nd4j_sqrt<T, T>(yNorms[j]));
+                        break;
+                    default:
+                        result = dot;
+                }
+                z[(i * numY + j) * zEws] = result;
+            }
+        }
+
+        return true;
+    }
+
+    // blocked kernels are available for float and double, and only when input and output types match
+    template <typename X, typename Z>
+    struct Dispatcher {
+        static bool execAll(const int opNum, void* vx, Nd4jLong* xShapeInfo, void* vy, Nd4jLong* yShapeInfo, void* vz, Nd4jLong* zShapeInfo,
+                            Nd4jLong* xTadShapeInfo, Nd4jLong* xOffsets, Nd4jLong* yTadShapeInfo, Nd4jLong* yOffsets) {
+            return false;
+        }
+    };
+
+    template <>
+    struct Dispatcher<float, float> {
+        static bool execAll(const int opNum, void* vx, Nd4jLong* xShapeInfo, void* vy, Nd4jLong* yShapeInfo, void* vz, Nd4jLong* zShapeInfo,
+                            Nd4jLong* xTadShapeInfo, Nd4jLong* xOffsets, Nd4jLong* yTadShapeInfo, Nd4jLong* yOffsets) {
+            return blocked::execAll<float>(opNum, reinterpret_cast<float*>(vx), xShapeInfo, reinterpret_cast<float*>(vy), yShapeInfo, reinterpret_cast<float*>(vz), zShapeInfo, xTadShapeInfo, xOffsets, yTadShapeInfo, yOffsets);
+        }
+    };
+
+    template <>
+    struct Dispatcher<double, double> {
+        static bool execAll(const int opNum, void* vx, Nd4jLong* xShapeInfo, void* vy, Nd4jLong* yShapeInfo, void* vz, Nd4jLong* zShapeInfo,
+                            Nd4jLong* xTadShapeInfo, Nd4jLong* xOffsets, Nd4jLong* yTadShapeInfo, Nd4jLong* yOffsets) {
+            return blocked::execAll<double>(opNum, reinterpret_cast<double*>(vx), xShapeInfo, reinterpret_cast<double*>(vy), yShapeInfo, reinterpret_cast<double*>(vz), zShapeInfo, xTadShapeInfo, xOffsets, yTadShapeInfo, yOffsets);
+        }
+    };
+}
+
 //////////////////////////////////////////////////////////////////////////
 template <typename X, typename Y>
 void Reduce3<X,Y>::execAll(const int opNum,
@@ -230,6 +496,23 @@ void Reduce3<X,Y>::execAll(const int opNum,
                             Nd4jLong *xTadShapeInfo, Nd4jLong *xOffsets,
                             Nd4jLong *yTadShapeInfo, Nd4jLong *yOffsets) {
 
+    if (blocked::Dispatcher<X,Y>::execAll(opNum, vx, xShapeInfo, vy, yShapeInfo, vz, zShapeInfo, xTadShapeInfo, xOffsets, yTadShapeInfo, yOffsets))
+        return;
+
+    execAllLoops(opNum, vx, xShapeInfo, extraParamsVals, vy, yShapeInfo, vz, zShapeInfo, dimension, dimensionLength, xTadShapeInfo, xOffsets, yTadShapeInfo, yOffsets);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename X, typename Y>
+void Reduce3<X,Y>::execAllLoops(const int opNum,
+                            void *vx, Nd4jLong *xShapeInfo,
+                            void *extraParamsVals,
+                            void *vy, Nd4jLong *yShapeInfo,
+                            void *vz, Nd4jLong *zShapeInfo,
+                            int *dimension, int dimensionLength,
+                            Nd4jLong *xTadShapeInfo, Nd4jLong *xOffsets,
+                            Nd4jLong *yTadShapeInfo, Nd4jLong *yOffsets) {
+
     DISPATCH_BY_OPNUM_TT(execAll, PARAMS(vx, xShapeInfo, extraParamsVals, vy, yShapeInfo, vz, zShapeInfo, dimension, dimensionLength, xTadShapeInfo, xOffsets, yTadShapeInfo, yOffsets), REDUCE3_OPS);
 }
 
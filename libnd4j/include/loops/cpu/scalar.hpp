@@ -153,7 +153,7 @@ void ScalarTransform<X, Y, Z>::transform(void *vx, Nd4jLong *xShapeInfo,
         uint xShapeInfoCast[MAX_RANK];
         const bool canCastX = nd4j::DataTypeUtils::castShapeInfo<uint>(xShapeInfo, xShapeInfoCast);
 
-        nd4j::OmpLaunchHelper info(len);
+        nd4j::OmpLaunchHelper info(len, -1, nd4j::LoopFamily::PAIRWISE, nd4j::DataTypeUtils::fromT<X>());
 
         if(shape::haveSameShapeAndStrides(xShapeInfo, zShapeInfo)) {
 
@@ -206,7 +206,7 @@ void ScalarTransform<X, Y, Z>::transform(void *vx, Nd4jLong xEws,
     auto scalar = reinterpret_cast<Y *>(vscalar)[0];
     auto extraParams = reinterpret_cast<Z *>(vextraParams);
 
-    nd4j::OmpLaunchHelper info(len);
+    nd4j::OmpLaunchHelper info(len, -1, nd4j::LoopFamily::PAIRWISE, nd4j::DataTypeUtils::fromT<X>());
 
     if (xEws == 1 && zEws == 1) {
 
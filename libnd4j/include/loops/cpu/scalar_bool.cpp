@@ -161,7 +161,7 @@ namespace functions {
             uint xShapeInfoCast[MAX_RANK];
             const bool canCastX = nd4j::DataTypeUtils::castShapeInfo<uint>(xShapeInfo, xShapeInfoCast);
 
-            nd4j::OmpLaunchHelper info(len);
+            nd4j::OmpLaunchHelper info(len, -1, nd4j::LoopFamily::PAIRWISE, nd4j::DataTypeUtils::fromT<X>());
                                
             if(shape::haveSameShapeAndStrides(xShapeInfo, zShapeInfo)) {
 
@@ -215,7 +215,7 @@ namespace functions {
                 auto scalar = reinterpret_cast<X *>(vscalar)[0];
                 auto extraParams = reinterpret_cast<X *>(vextraParams); 
 
-                nd4j::OmpLaunchHelper info(len);
+                nd4j::OmpLaunchHelper info(len, -1, nd4j::LoopFamily::PAIRWISE, nd4j::DataTypeUtils::fromT<X>());
 
                 if (xEws == 1 && zEws == 1) {
 
@@ -23,12 +23,59 @@
 #include <types/types.h>
 #include <loops/transform_strict.h>
 #include <loops/legacy_ops.h>
+#include <helpers/VectorMath.h>
+#include <Environment.h>
 
 using namespace simdOps;
 
 namespace functions {
     namespace transform {
 
+        // legacy ops which have vectorised counterparts in VectorMath.h, everything else maps to void
+        template <typename X, typename OpType> struct VectorisedOp { typedef void type; };
+        template <typename X> struct VectorisedOp<X, simdOps::Exp<X>> { typedef nd4j::math::vec::Exp type; };
+        template <typename X> struct VectorisedOp<X, simdOps::Log<X>> { typedef nd4j::math::vec::Log type; };
+        template <typename X> struct VectorisedOp<X, simdOps::Tanh<X>> { typedef nd4j::math::vec::Tanh type; };
+        template <typename X> struct VectorisedOp<X, simdOps::Sigmoid<X>> { typedef nd4j::math::vec::Sigmoid type; };
+        template <typename X> struct VectorisedOp<X, simdOps::Erf<X>> { typedef nd4j::math::vec::Erf type; };
+        template <typename X> struct VectorisedOp<X, simdOps::Swish<X>> { typedef nd4j::math::vec::Swish type; };
+        template <typename X> struct VectorisedOp<X, simdOps::GELU<X>> { typedef nd4j::math::vec::GELU type; };
+        template <typename X> struct VectorisedOp<X, simdOps::ELU<X>> { typedef nd4j::math::vec::ELU type; };
+
+        template <typename X, typename VecOp>
+        static FORCEINLINE bool execVectorised(X *x, Nd4jLong *xShapeInfo, X *z, Nd4jLong *zShapeInfo) {
+            const auto precision = nd4j::Environment::getInstance()->mathPrecision();
+            if (!nd4j::VectorMath::isVectorised<X>(precision))
+                return false;
+
+            // only contiguous buffers here, strided cases stay within TransformLoops
+            if (nd4j::LoopKind::deduceKindOfLoopXZ(xShapeInfo, zShapeInfo) != nd4j::LoopKind::EWS1)
+                return false;
+
+            nd4j::OmpLaunchHelper threadsInfo(shape::length(xShapeInfo), -1, nd4j::LoopFamily::TRANSFORM_STRICT, nd4j::DataTypeUtils::fromT<X>());
+
+            PRAGMA_OMP_PARALLEL_THREADS(threadsInfo._numThreads)
+            {
+                const auto threadNum = omp_get_thread_num();
+                const auto threadOffset = threadsInfo.getThreadOffset(threadNum);
+                const auto lenPerThread = threadsInfo.getItersPerThread(threadNum);
+
+                nd4j::VectorMath::transform<X, VecOp>(x + threadOffset, z + threadOffset, lenPerThread, precision);
+            }
+
+            return true;
+        }
+
+        template <typename X, typename VecOp>
+        static FORCEINLINE bool execVectorised(X *x, Nd4jLong *xShapeInfo, X *z, Nd4jLong *zShapeInfo, std::true_type isVoid) {
+            return false;
+        }
+
+        template <typename X, typename VecOp>
+        static FORCEINLINE bool execVectorised(X *x, Nd4jLong *xShapeInfo, X *z, Nd4jLong *zShapeInfo, std::false_type isVoid) {
+            return execVectorised<X, VecOp>(x, xShapeInfo, z, zShapeInfo);
+        }
+
         template <typename X>
         void TransformStrict<X>::exec(
 				int opNum,
@@ -62,7 +109,11 @@ namespace functions {
                 return;
             }
 
-            nd4j::TransformLoops<X,X,X>::template loopTransform<OpType, true>(x, xShapeInfo, z, zShapeInfo, extraParams);
+            typedef typename VectorisedOp<X, OpType>::type VecOp;
+            if (execVectorised<X, VecOp>(x, xShapeInfo, z, zShapeInfo, std::is_void<VecOp>()))
+                return;
+
+            nd4j::TransformLoops<X,X,X>::template loopTransform<OpType, true>(x, xShapeInfo, z, zShapeInfo, extraParams, nd4j::LoopFamily::TRANSFORM_STRICT);
         }
 
         BUILD_SINGLE_TEMPLATE(template class ND4J_EXPORT TransformStrict, , FLOAT_TYPES);
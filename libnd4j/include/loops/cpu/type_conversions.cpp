@@ -22,6 +22,8 @@
 #include <op_boilerplate.h>
 #include <loops/type_conversions.h>
 #include <OmpLaunchHelper.h>
+#include <helpers/PrefixScan.h>
+#include <vector>
 
 namespace nd4j {
 
@@ -102,58 +104,45 @@ namespace nd4j {
         auto l = static_cast<int>(N);
         z[1] = l;
 
-        int threads = OmpLaunchHelper::betterThreads(N);
-        int span = OmpLaunchHelper::betterSpan(N, threads);
-
         T tt = static_cast<T>(threshold);
         T mtt = -tt;
 
-        // we use 3 as offset, since first 12 bytes are occupied with header
-        int flimit = limit + 4;
-        volatile int cnt = 4;
-        volatile bool flag = false;
-        PRAGMA_OMP_PARALLEL_THREADS(threads)
-        {
-            int tid = omp_get_thread_num();
-            int start = span * tid;
-            int stop = span * (tid + 1);
-            if (stop > l)
-                stop = l;
-
-            for (int e = start; e < stop; e++) {
-                bool flag_load;
-#pragma omp atomic read
-                flag_load = flag;
-                if (flag_load)
-                    break;
+        // compaction goes in two passes over the same blocks: number of updates within each block first,
+        // then exclusive scan of these numbers gives position of each block's first update within z,
+        // so updates are written in order of elements, and only first limit updates are applied
+        const int numBlocks = OmpLaunchHelper::betterThreads(N);
+        const int span = static_cast<int>(OmpLaunchHelper::betterSpan(N, numBlocks));
+        std::vector<int> positions(numBlocks + 1, 0);
 
-                T cUpd = x[e];
-                if (cUpd >= tt) {
-                    int idx;
-#pragma omp atomic capture
-                    idx = cnt++;
+        PRAGMA_OMP_PARALLEL_FOR_THREADS(numBlocks)
+        for (int b = 0; b < numBlocks; b++) {
+            const int start = span * b;
+            const int stop = nd4j::math::nd4j_min<int>(l, start + span);
 
-                    if (idx >= flimit) {
-#pragma omp atomic write
-                        flag = true;
-                        break;
-                    }
+            int cnt = 0;
+            for (int e = start; e < stop; e++)
+                if (x[e] >= tt || x[e] <= mtt)
+                    cnt++;
 
-                    z[idx] = e + 1;
-                    x[e] -= tt;
-                } else if (cUpd <= mtt) {
-                    int idx;
-#pragma omp atomic capture
-                    idx = cnt++;
+            positions[b] = cnt;
+        }
 
-                    if (idx >= flimit) {
-#pragma omp atomic write
-                        flag = true;
-                        break;
-                    }
+        PrefixScan::scan<int, scan::Add<int>>(positions.data(), positions.data(), numBlocks + 1, true);
 
+        // we use 4 as offset, since first 16 bytes are occupied with header
+        PRAGMA_OMP_PARALLEL_FOR_THREADS(numBlocks)
+        for (int b = 0; b < numBlocks; b++) {
+            const int start = span * b;
+            const int stop = nd4j::math::nd4j_min<int>(l, start + span);
 
-                    z[idx] = -e - 1;
+            int idx = positions[b];
+            for (int e = start; e < stop && idx < limit; e++) {
+                T cUpd = x[e];
+                if (cUpd >= tt) {
+                    z[4 + idx++] = e + 1;
+                    x[e] -= tt;
+                } else if (cUpd <= mtt) {
+                    z[4 + idx++] = -e - 1;
                     x[e] += tt;
                 }
             }
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Gradient compression codecs for distributed training, next to threshold encoding in TypeCast.
+//
+// Encoded message starts with 16 bytes header: codec id, number of elements, encoded length in bytes and codec
+// parameter (as float bits). Source is split into fixed-size blocks, each block is encoded independently, so both
+// encoding and decoding are done in parallel. Every codec keeps error feedback in source buffer: after encoding source
+// holds residual, i.e. source - decoded, exactly like threshold encoding does. Decoding adds decoded values to target.
+//
+// Varint-based codecs write block byte offsets after header, so decoder doesn't need to scan preceding blocks. Sparse
+// indices within block are delta-encoded LEB128 varints.
+//
+
+#ifndef LIBND4J_GRADIENT_CODECS_H
+#define LIBND4J_GRADIENT_CODECS_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <array/DataType.h>
+#include <map>
+#include <mutex>
+
+namespace nd4j {
+
+    class ND4J_EXPORT GradientCodec {
+    public:
+        // built-in codecs, ids of custom codecs should start from CUSTOM
+        enum Codec {THRESHOLD_VARINT = 1, TOP_K = 2, SIGN_1BIT = 3, SIGN_2BIT = 4, CUSTOM = 64};
+
+        static const int HEADER_LENGTH = 16;
+
+        virtual ~GradientCodec() = default;
+
+        virtual int id() const = 0;
+        virtual const char* name() const = 0;
+
+        /**
+         * Upper bound of encoded length in bytes, header included
+         */
+        virtual Nd4jLong maxEncodedLength(Nd4jLong N, float parameter) const = 0;
+
+        /**
+         * Encodes N elements of dx into dz, leaving residual in dx.
+         * @param parameter codec specific: threshold, fraction or number of elements to keep, ignored by sign codecs
+         * @return encoded length in bytes, or minus required length if capacity isn't enough (dx isn't modified then)
+         */
+        virtual Nd4jLong encode(nd4j::DataType dataType, void *dx, Nd4jLong N, void *dz, Nd4jLong capacity, float parameter) = 0;
+
+        /**
+         * Adds decoded values to N elements of dz
+         */
+        virtual void decode(const void *dx, nd4j::DataType dataType, void *dz, Nd4jLong N) = 0;
+
+        static int codecOf(const void *encoded);
+        static Nd4jLong lengthOf(const void *encoded);
+    };
+
+    class ND4J_EXPORT GradientCodecs {
+    private:
+        static GradientCodecs* _instance;
+
+        std::mutex _mutex;
+        std::map<int, GradientCodec*> _codecs;
+
+        GradientCodecs();
+
+    public:
+        static GradientCodecs* getInstance();
+
+        /**
+         * Registers codec, registry takes ownership. Codec with the same id is replaced.
+         */
+        void registerCodec(GradientCodec* codec);
+
+        /**
+         * Returns codec for given id, or nullptr if there's no such codec
+         */
+        GradientCodec* codec(int id);
+
+        Nd4jLong encode(int codecId, nd4j::DataType dataType, void *dx, Nd4jLong N, void *dz, Nd4jLong capacity, float parameter);
+
+        /**
+         * Decodes message produced by any registered codec, codec is taken from header
+         */
+        void decode(const void *dx, nd4j::DataType dataType, void *dz, Nd4jLong N);
+    };
+}
+
+#endif //LIBND4J_GRADIENT_CODECS_H
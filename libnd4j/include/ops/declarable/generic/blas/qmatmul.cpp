@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Quantised matmul: uint8 x int8 -> int32, see helpers/quantization.h
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_qmatmul)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/quantization.h>
+
+namespace nd4j {
+    namespace ops {
+
+        CUSTOM_OP_IMPL(qmatmul, 4, 1, false, 2, -2) {
+            auto x = INPUT_VARIABLE(0);
+            auto y = INPUT_VARIABLE(1);
+            auto yScales = INPUT_VARIABLE(2);
+            auto yZeroPoints = INPUT_VARIABLE(3);
+            auto bias = block.width() > 4 ? INPUT_VARIABLE(4) : nullptr;
+            auto z = OUTPUT_VARIABLE(0);
+
+            const int iSize = (int) block.getIArguments()->size();
+            const bool quantizedOutput = iSize > 0 && INT_ARG(0) == 1;
+            const int quantMin = iSize > 1 ? INT_ARG(1) : 0;
+            const int quantMax = iSize > 2 ? INT_ARG(2) : 255;
+
+            const float xScale = T_ARG(0);
+            const int xZeroPoint = static_cast<int>(T_ARG(1));
+
+            REQUIRE_TRUE(x->rankOf() == 2 && y->rankOf() == 2, 0, "QMATMUL OP: both inputs must be matrices, but got x rank = %i, y rank = %i !", x->rankOf(), y->rankOf());
+            REQUIRE_TRUE(x->sizeAt(1) == y->sizeAt(0), 0, "QMATMUL OP: input arrays have inconsistent shapes for matrix product: x %s, y %s !", ShapeUtils::shapeAsString(x).c_str(), ShapeUtils::shapeAsString(y).c_str());
+            REQUIRE_TRUE(y->dataType() == nd4j::DataType::INT8, 0, "QMATMUL OP: y must have INT8 data type !");
+            REQUIRE_TRUE(x->dataType() == nd4j::DataType::UINT8 || x->isR(), 0, "QMATMUL OP: x must have UINT8 or floating point data type !");
+            REQUIRE_TRUE(quantMin >= 0 && quantMax <= 255 && quantMin < quantMax, 0, "QMATMUL OP: integer grid must lie within [0, 255], but got [%i, %i] !", quantMin, quantMax);
+
+            const Nd4jLong N = y->sizeAt(1);
+            REQUIRE_TRUE(yScales->lengthOf() == 1 || yScales->lengthOf() == N, 0, "QMATMUL OP: y scales must be scalar or have length %i, but got %i !", N, yScales->lengthOf());
+            REQUIRE_TRUE(yZeroPoints->lengthOf() == 1 || yZeroPoints->lengthOf() == N, 0, "QMATMUL OP: y zero points must be scalar or have length %i, but got %i !", N, yZeroPoints->lengthOf());
+            if (bias)
+                REQUIRE_TRUE(bias->lengthOf() == N, 0, "QMATMUL OP: bias must have length %i, but got %i !", N, bias->lengthOf());
+            if (quantizedOutput)
+                REQUIRE_TRUE(block.getTArguments()->size() > 3 && T_ARG(2) > 0., 0, "QMATMUL OP: output scale and zero point are required for UINT8 output !");
+
+            const float outScale = quantizedOutput ? T_ARG(2) : 1.f;
+            const int outZeroPoint = quantizedOutput ? static_cast<int>(T_ARG(3)) : 0;
+
+            helpers::qmatmul(x, y, xScale, xZeroPoint, yScales, yZeroPoints, bias, z, outScale, outZeroPoint, quantMin, quantMax);
+
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(qmatmul) {
+            auto xShapeInfo = inputShape->at(0);
+            auto yShapeInfo = inputShape->at(1);
+
+            REQUIRE_TRUE(shape::rank(xShapeInfo) == 2 && shape::rank(yShapeInfo) == 2, 0, "QMATMUL OP: both inputs must be matrices, but got x rank = %i, y rank = %i !", shape::rank(xShapeInfo), shape::rank(yShapeInfo));
+
+            const bool quantizedOutput = block.getIArguments()->size() > 0 && INT_ARG(0) == 1;
+            auto xType = ArrayOptions::dataType(xShapeInfo);
+            auto zType = quantizedOutput ? nd4j::DataType::UINT8 : DataTypeUtils::isR(xType) ? xType : Environment::getInstance()->defaultFloatDataType();
+
+            auto newShape = ShapeBuilders::createShapeInfo(zType, 'c', {shape::sizeAt(xShapeInfo, 0), shape::sizeAt(yShapeInfo, 1)}, block.getWorkspace());
+
+            return SHAPELIST(newShape);
+        }
+
+        DECLARE_TYPES(qmatmul) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(0, {nd4j::DataType::UINT8, ALL_FLOATS})
+                    ->setAllowedInputTypes(1, nd4j::DataType::INT8)
+                    ->setAllowedInputTypes(2, {ALL_FLOATS})
+                    ->setAllowedInputTypes(3, {ALL_INTS})
+                    ->setAllowedInputTypes(4, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(0, {nd4j::DataType::UINT8, ALL_FLOATS});
+        }
+    }
+}
+
+#endif
@@ -104,7 +104,7 @@ CUSTOM_OP_IMPL(conv3dnew, 2, 1, false, 0, 13) {
             auto user_dst_memory = mkldnn::memory({user_dst_md, engine}, output->buffer());
 
             auto conv_src_memory = user_src_memory;
-            streams[0].addMemory(user_src_memory);
+            streams[0].addMemory(user_src_memory, input);
             if (mkldnn::memory::primitive_desc(conv_prim_desc.src_primitive_desc())
                     != user_src_memory.get_primitive_desc()) {
                 conv_src_memory = mkldnn::memory(conv_prim_desc.src_primitive_desc());
@@ -113,7 +113,7 @@ CUSTOM_OP_IMPL(conv3dnew, 2, 1, false, 0, 13) {
             }
 
             auto conv_weights_memory = user_weights_memory;
-            streams[0].addMemory(user_weights_memory);
+            streams[0].addMemory(user_weights_memory, weights);
             if (mkldnn::memory::primitive_desc(conv_prim_desc.weights_primitive_desc())
                     != user_weights_memory.get_primitive_desc()) {
                 conv_weights_memory = mkldnn::memory(conv_prim_desc.weights_primitive_desc());
@@ -122,7 +122,7 @@ CUSTOM_OP_IMPL(conv3dnew, 2, 1, false, 0, 13) {
             }
 
             auto conv_dst_memory = user_dst_memory;
-            streams[0].addMemory(user_dst_memory);
+            streams[0].addMemory(user_dst_memory, output);
             if (mkldnn::memory::primitive_desc(conv_prim_desc.dst_primitive_desc())
                     != user_dst_memory.get_primitive_desc()) {
                 conv_dst_memory = mkldnn::memory(conv_prim_desc.dst_primitive_desc());
@@ -131,7 +131,7 @@ CUSTOM_OP_IMPL(conv3dnew, 2, 1, false, 0, 13) {
 
             if (bias != nullptr) {
                 auto conv_bias_memory = mkldnn::memory(conv_prim_desc.bias_primitive_desc(), bias->buffer());
-                streams[0].addMemory(conv_bias_memory);
+                streams[0].addMemory(conv_bias_memory, bias);
                 streams[0].addOperation(convolution_forward(conv_prim_desc, conv_src_memory, conv_weights_memory, conv_bias_memory, conv_dst_memory));
             } else {
                 streams[0].addOperation(convolution_forward(conv_prim_desc, conv_src_memory, conv_weights_memory, conv_dst_memory));
@@ -331,7 +331,7 @@ CUSTOM_OP_IMPL(conv3dnew_bp, 3, 2, false, 0, 13) {
 
             auto conv_prim_desc = convolution_forward::primitive_desc(conv_desc, streams[0].getEngine());
 
-            if (gradW != nullptr) {
+            if (resetW && gradW != nullptr) {
                 auto convW_desc = gradB != nullptr
                         ? convolution_backward_weights::desc(
                                 convolution_direct, conv_src_md, conv_diff_weights_md, conv_bias_md,
@@ -347,7 +347,7 @@ CUSTOM_OP_IMPL(conv3dnew_bp, 3, 2, false, 0, 13) {
                 auto userW_dst_memory = mkldnn::memory({user_dst_md, engine}, const_cast<NDArray*>(gradO)->buffer());
 
                 auto convW_src_memory = userW_src_memory;
-                streams[0].addMemory(userW_src_memory);
+                streams[0].addMemory(userW_src_memory, input);
                 if (mkldnn::memory::primitive_desc(convW_prim_desc.src_primitive_desc())
                         != userW_src_memory.get_primitive_desc()) {
                     convW_src_memory = mkldnn::memory(convW_prim_desc.src_primitive_desc());
@@ -356,7 +356,7 @@ CUSTOM_OP_IMPL(conv3dnew_bp, 3, 2, false, 0, 13) {
                 }
 
                 auto convW_weights_memory = userW_weights_memory;
-                streams[0].addMemory(userW_weights_memory);
+                streams[0].addMemory(userW_weights_memory, gradW);
                 if (mkldnn::memory::primitive_desc(convW_prim_desc.diff_weights_primitive_desc())
                         != userW_weights_memory.get_primitive_desc()) {
                     convW_weights_memory = mkldnn::memory(convW_prim_desc.diff_weights_primitive_desc());
@@ -364,7 +364,7 @@ CUSTOM_OP_IMPL(conv3dnew_bp, 3, 2, false, 0, 13) {
                 }
 
                 auto convW_dst_memory = userW_dst_memory;
-                streams[0].addMemory(userW_dst_memory);
+                streams[0].addMemory(userW_dst_memory, gradO);
                 if (mkldnn::memory::primitive_desc(convW_prim_desc.diff_dst_primitive_desc())
                         != userW_dst_memory.get_primitive_desc()) {
                     convW_dst_memory = mkldnn::memory(convW_prim_desc.diff_dst_primitive_desc());
@@ -374,7 +374,7 @@ CUSTOM_OP_IMPL(conv3dnew_bp, 3, 2, false, 0, 13) {
 
                 if (gradB != nullptr) {
                     auto convW_bias_memory = mkldnn::memory(convW_prim_desc.diff_bias_primitive_desc(), gradB->buffer());
-                    streams[0].addMemory(convW_bias_memory);
+                    streams[0].addMemory(convW_bias_memory, gradB);
                     streams[0].addOperation(convolution_backward_weights(convW_prim_desc, convW_src_memory, convW_dst_memory, convW_weights_memory, convW_bias_memory));
                 } else {
                     streams[0].addOperation(convolution_backward_weights(convW_prim_desc, convW_src_memory, convW_dst_memory, convW_weights_memory));
@@ -386,7 +386,7 @@ CUSTOM_OP_IMPL(conv3dnew_bp, 3, 2, false, 0, 13) {
                 }
             }
 
-            if (gradI != nullptr) {
+            if (resetI && gradI != nullptr) {
                 auto convI_desc =
                         convolution_backward_data::desc(
                                 convolution_direct, conv_diff_src_md, conv_weights_md,
@@ -399,7 +399,7 @@ CUSTOM_OP_IMPL(conv3dnew_bp, 3, 2, false, 0, 13) {
                 auto userI_dst_memory = mkldnn::memory({user_dst_md, engine}, const_cast<NDArray*>(gradO)->buffer());
 
                 auto convI_src_memory = userI_src_memory;
-                streams[1].addMemory(userI_src_memory);
+                streams[1].addMemory(userI_src_memory, gradI);
                 if (mkldnn::memory::primitive_desc(convI_prim_desc.diff_src_primitive_desc())
                         != userI_src_memory.get_primitive_desc()) {
                     convI_src_memory = mkldnn::memory(convI_prim_desc.diff_src_primitive_desc());
@@ -407,7 +407,7 @@ CUSTOM_OP_IMPL(conv3dnew_bp, 3, 2, false, 0, 13) {
                 }
 
                 auto convI_weights_memory = userI_weights_memory;
-                streams[1].addMemory(userI_weights_memory);
+                streams[1].addMemory(userI_weights_memory, weights);
                 if (mkldnn::memory::primitive_desc(convI_prim_desc.weights_primitive_desc())
                         != userI_weights_memory.get_primitive_desc()) {
                     convI_weights_memory = mkldnn::memory(convI_prim_desc.weights_primitive_desc());
@@ -416,7 +416,7 @@ CUSTOM_OP_IMPL(conv3dnew_bp, 3, 2, false, 0, 13) {
                 }
 
                 auto convI_dst_memory = userI_dst_memory;
-                streams[1].addMemory(userI_dst_memory);
+                streams[1].addMemory(userI_dst_memory, gradO);
                 if (mkldnn::memory::primitive_desc(convI_prim_desc.diff_dst_primitive_desc())
                         != userI_dst_memory.get_primitive_desc()) {
                     convI_dst_memory = mkldnn::memory(convI_prim_desc.diff_dst_primitive_desc());
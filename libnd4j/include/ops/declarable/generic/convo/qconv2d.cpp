@@ -0,0 +1,145 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Quantised conv2d: uint8 input, int8 weights, int32 accumulation, see helpers/quantization.h
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_qconv2d)
+
+#include <ops/declarable/CustomOperations.h>
+#include <declarable/generic/helpers/convolutions.h>
+#include <ops/declarable/helpers/quantization.h>
+
+namespace nd4j {
+namespace ops  {
+
+CUSTOM_OP_IMPL(qconv2d, 4, 1, false, 2, 9) {
+
+    auto input   = INPUT_VARIABLE(0);                                    // [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW)
+    auto weights = INPUT_VARIABLE(1);                                    // [kH, kW, iC, oC] always
+    auto wScales = INPUT_VARIABLE(2);                                    // [oC] or scalar
+    auto wZeroPoints = INPUT_VARIABLE(3);                                // [oC] or scalar
+    auto bias    = block.width() > 4 ? INPUT_VARIABLE(4) : nullptr;      // [oC]
+
+    auto output  = OUTPUT_VARIABLE(0);                                   // [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW)
+
+    const int iSize = (int) block.getIArguments()->size();
+
+    int sH = INT_ARG(2);                                                        // strides height
+    int sW = INT_ARG(3);                                                        // strides width
+    int pH = INT_ARG(4);                                                        // paddings height
+    int pW = INT_ARG(5);                                                        // paddings width
+    int dH = INT_ARG(6);                                                        // dilations height
+    int dW = INT_ARG(7);                                                        // dilations width
+    int isSameMode = INT_ARG(8);                                                // 0-VALID, 1-SAME
+    bool isNCHW    = iSize > 9 ? !INT_ARG(9) : 1;                               // INT_ARG(9): 0-NCHW,  1-NHWC
+    bool quantizedOutput = iSize > 10 && INT_ARG(10) == 1;                      // INT_ARG(10): 0-floating point, 1-UINT8
+    int quantMin = iSize > 11 ? INT_ARG(11) : 0;
+    int quantMax = iSize > 12 ? INT_ARG(12) : 255;
+
+    int kH = INT_ARG(0) > 0 ? INT_ARG(0) : static_cast<int>(weights->sizeAt(0)); // filter(kernel) height
+    int kW = INT_ARG(1) > 0 ? INT_ARG(1) : static_cast<int>(weights->sizeAt(1)); // filter(kernel) width
+
+    int bS, iC, iH, iW, oC, oH, oW;                             // batch size, input channels, input height/width, output channels, output height/width;
+    int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;       // corresponding indexes
+    ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, *input, *output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWoC, indWkH, indOoH);
+
+    std::string expectedWeightsShape = ShapeUtils::shapeAsString({kH, kW, iC, oC});
+    REQUIRE_TRUE(expectedWeightsShape == ShapeUtils::shapeAsString(weights), 0, "CUSTOM QCONV2D OP: wrong shape of weights array, expected is %s, but got %s instead !", expectedWeightsShape.c_str(), ShapeUtils::shapeAsString(weights).c_str());
+    REQUIRE_TRUE(weights->dataType() == nd4j::DataType::INT8, 0, "CUSTOM QCONV2D OP: weights must have INT8 data type !");
+    REQUIRE_TRUE(input->dataType() == nd4j::DataType::UINT8 || input->isR(), 0, "CUSTOM QCONV2D OP: input must have UINT8 or floating point data type !");
+    REQUIRE_TRUE(wScales->lengthOf() == 1 || wScales->lengthOf() == oC, 0, "CUSTOM QCONV2D OP: weights scales must be scalar or have length %i, but got %i !", oC, wScales->lengthOf());
+    REQUIRE_TRUE(wZeroPoints->lengthOf() == 1 || wZeroPoints->lengthOf() == oC, 0, "CUSTOM QCONV2D OP: weights zero points must be scalar or have length %i, but got %i !", oC, wZeroPoints->lengthOf());
+    REQUIRE_TRUE(quantMin >= 0 && quantMax <= 255 && quantMin < quantMax, 0, "CUSTOM QCONV2D OP: integer grid must lie within [0, 255], but got [%i, %i] !", quantMin, quantMax);
+    if (bias)
+        REQUIRE_TRUE(bias->rankOf() <= 2 && oC == bias->lengthOf(), 0, "CUSTOM QCONV2D OP: wrong shape of array with biases, expected rank, length: <=2, %i, but got %i, %i instead !", oC, bias->rankOf(), bias->lengthOf());
+    if (quantizedOutput)
+        REQUIRE_TRUE(block.getTArguments()->size() > 3 && T_ARG(2) > 0., 0, "CUSTOM QCONV2D OP: output scale and zero point are required for UINT8 output !");
+
+    const float xScale = T_ARG(0);
+    const int xZeroPoint = static_cast<int>(T_ARG(1));
+    const float outScale = quantizedOutput ? T_ARG(2) : 1.f;
+    const int outZeroPoint = quantizedOutput ? static_cast<int>(T_ARG(3)) : 0;
+
+    helpers::qconv2d(input, weights, xScale, xZeroPoint, wScales, wZeroPoints, bias, output, outScale, outZeroPoint, quantMin, quantMax, kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW);
+
+    return Status::OK();
+}
+
+
+DECLARE_SHAPE_FN(qconv2d) {
+
+    auto inputShapeInfo   = inputShape->at(0);                                  // [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW)
+    auto weightsShapeInfo = inputShape->at(1);                                  // [kH, kW, iC, oC] always
+
+    const int iSize = (int) block.getIArguments()->size();
+
+    int sH = INT_ARG(2);                                                        // strides height
+    int sW = INT_ARG(3);                                                        // strides width
+    int pH = INT_ARG(4);                                                        // paddings height
+    int pW = INT_ARG(5);                                                        // paddings width
+    int dH = INT_ARG(6);                                                        // dilations height
+    int dW = INT_ARG(7);                                                        // dilations width
+    int isSameMode = INT_ARG(8);                                                // 0-VALID, 1-SAME
+    int isNCHW  = iSize > 9 ? !INT_ARG(9) : 1;                                  // INT_ARG(9): 0-NCHW, 1-NHWC
+    bool quantizedOutput = iSize > 10 && INT_ARG(10) == 1;
+
+    int kH = INT_ARG(0) > 0 ? INT_ARG(0) : static_cast<int>(shape::sizeAt(weightsShapeInfo, 0)); // filter(kernel) height
+    int kW = INT_ARG(1) > 0 ? INT_ARG(1) : static_cast<int>(shape::sizeAt(weightsShapeInfo, 1)); // filter(kernel) width
+
+    const int rank = 4;
+
+    REQUIRE_TRUE(inputShapeInfo[0]   == rank, 0, "CUSTOM QCONV2D OP: rank of input array must be equal to %i, but got %i instead !", rank, inputShapeInfo[0]);
+    REQUIRE_TRUE(weightsShapeInfo[0] == rank, 0, "CUSTOM QCONV2D OP: rank of weights array must be equal to %i, but got %i instead !", rank, weightsShapeInfo[0]);
+
+    const int indIiH   = isNCHW ? 2 : 1;
+
+    const int bS = inputShapeInfo[1];                            // batch size
+    const int iH = inputShapeInfo[indIiH+1];                     // input height
+    const int iW = inputShapeInfo[indIiH+2];                     // input width
+    const int oC = weightsShapeInfo[3+1];                        // output channels
+
+    int oH, oW;                                                  // output height, width
+    ConvolutionUtils::calcOutSizePool2D(oH, oW, kH, kW, sH, sW, pH, pW, dH, dW, iH, iW, isSameMode);
+
+    auto inputType = ArrayOptions::dataType(inputShapeInfo);
+    auto outputType = quantizedOutput ? nd4j::DataType::UINT8 : DataTypeUtils::isR(inputType) ? inputType : Environment::getInstance()->defaultFloatDataType();
+
+    Nd4jLong* outputShapeInfo = nullptr;
+    if (isNCHW)
+        outputShapeInfo = ShapeBuilders::createShapeInfo(outputType, 'c', {bS, oC, oH, oW}, block.getWorkspace());
+    else
+        outputShapeInfo = ShapeBuilders::createShapeInfo(outputType, 'c', {bS, oH, oW, oC}, block.getWorkspace());
+
+    return SHAPELIST(outputShapeInfo);
+}
+
+DECLARE_TYPES(qconv2d) {
+    getOpDescriptor()
+            ->setAllowedInputTypes(0, {nd4j::DataType::UINT8, ALL_FLOATS})
+            ->setAllowedInputTypes(1, nd4j::DataType::INT8)
+            ->setAllowedInputTypes(2, {ALL_FLOATS})
+            ->setAllowedInputTypes(3, {ALL_INTS})
+            ->setAllowedInputTypes(4, {ALL_FLOATS})
+            ->setAllowedOutputTypes(0, {nd4j::DataType::UINT8, ALL_FLOATS});
+}
+
+}
+}
+
+#endif
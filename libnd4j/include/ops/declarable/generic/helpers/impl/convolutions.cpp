@@ -633,7 +633,7 @@ static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDA
             auto user_dst_memory = mkldnn::memory({user_dst_md, engine}, output->buffer());
 
             auto conv_src_memory = user_src_memory;
-            streams[0].addMemory(user_src_memory);
+            streams[0].addMemory(user_src_memory, input);
             if (mkldnn::memory::primitive_desc(conv_prim_desc.src_primitive_desc())
                     != user_src_memory.get_primitive_desc()) {
                 conv_src_memory = mkldnn::memory(conv_prim_desc.src_primitive_desc());
@@ -642,7 +642,7 @@ static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDA
             }
 
             auto conv_weights_memory = user_weights_memory;
-            streams[0].addMemory(user_weights_memory);
+            streams[0].addMemory(user_weights_memory, weights);
             if (mkldnn::memory::primitive_desc(conv_prim_desc.weights_primitive_desc())
                     != user_weights_memory.get_primitive_desc()) {
                 conv_weights_memory = mkldnn::memory(conv_prim_desc.weights_primitive_desc());
@@ -651,7 +651,7 @@ static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDA
             }
 
             auto conv_dst_memory = user_dst_memory;
-            streams[0].addMemory(user_dst_memory);
+            streams[0].addMemory(user_dst_memory, output);
             if (mkldnn::memory::primitive_desc(conv_prim_desc.dst_primitive_desc())
                     != user_dst_memory.get_primitive_desc()) {
                 conv_dst_memory = mkldnn::memory(conv_prim_desc.dst_primitive_desc());
@@ -660,7 +660,7 @@ static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDA
 
             if (bias != nullptr) {
                 auto conv_bias_memory = mkldnn::memory(conv_prim_desc.bias_primitive_desc(), const_cast<NDArray*>(bias)->buffer());
-                streams[0].addMemory(conv_bias_memory);
+                streams[0].addMemory(conv_bias_memory, bias);
                 streams[0].addOperation(convolution_forward(conv_prim_desc, conv_src_memory, conv_weights_memory, conv_bias_memory, conv_dst_memory));
             } else {
                 streams[0].addOperation(convolution_forward(conv_prim_desc, conv_src_memory, conv_weights_memory, conv_dst_memory));
@@ -678,6 +678,59 @@ static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDA
 #endif
     nd4j_debug("MKL-DNN is not used for conv2d!\n", 0);
 
+    // native channels-last path: contiguous [iC] vectors of input are gathered straight into rows of columns matrix,
+    // so neither permuted im2col nor output reordering is required
+    const bool sameTypes = input->dataType() == output->dataType() && weights->dataType() == output->dataType();
+    if(!isNCHW && sameTypes && input->ordering() == 'c' && input->ews() == 1 && weights->ordering() == 'c' && weights->ews() == 1 && output->ordering() == 'c' && output->ews() == 1 &&
+       bS*oH*oW > 1 && kH*kW*iC > 1 && oC > 1) {
+
+        const Nd4jLong colLen = kH*kW*iC;
+        NDArray col('c', {bS*oH*oW, colLen}, output->dataType(), output->getWorkspace());
+
+        const Y* x = const_cast<NDArray*>(input)->bufferAsT<Y>();
+        Y* cols = col.bufferAsT<Y>();
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(collapse(2))
+        for(int b = 0; b < bS; ++b) {
+            for(int oh = 0; oh < oH; ++oh) {
+                for(int ow = 0; ow < oW; ++ow) {
+                    Y* row = cols + ((b*oH + oh)*oW + ow) * colLen;
+                    for(int kh = 0; kh < kH; ++kh) {
+                        const int ih = oh*sH - pH + kh*dH;
+                        for(int kw = 0; kw < kW; ++kw) {
+                            const int iw = ow*sW - pW + kw*dW;
+                            Y* z = row + (kh*kW + kw)*iC;
+                            if(ih < 0 || ih >= iH || iw < 0 || iw >= iW) {
+                                PRAGMA_OMP_SIMD
+                                for(int c = 0; c < iC; ++c)
+                                    z[c] = static_cast<Y>(0.f);
+                            }
+                            else {
+                                const Y* xi = x + ((b*iH + ih)*iW + iw)*iC;
+                                PRAGMA_OMP_SIMD
+                                for(int c = 0; c < iC; ++c)
+                                    z[c] = xi[c];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        NDArray* weightsReshaped = weights->reshape('c', {colLen, oC});            // [kH, kW, iC, oC] -> [kH*kW*iC, oC]
+        NDArray* outputReshaped  = output->reshape('c', {bS*oH*oW, oC});           // [bS, oH, oW, oC] -> [bS*oH*oW, oC]
+
+        MmulHelper::mmul(&col, weightsReshaped, outputReshaped, 1., 0.);          // [bS*oH*oW, kH*kW*iC] x [kH*kW*iC, oC] = [bS*oH*oW, oC]
+
+        delete weightsReshaped;
+        delete outputReshaped;
+
+        if(bias)
+            helpers::addBias(*output, *bias, isNCHW);
+
+        return;
+    }
+
     std::vector<int> permutForOutput;
     if(!isNCHW)
         input = input->permute({0, 3, 1, 2});                                       // [bS, iH, iW, iC] -> [bS, iC, iH, iW] if NHWC
@@ -777,7 +830,7 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
 
             auto conv_prim_desc = convolution_forward::primitive_desc(conv_desc, streams[0].getEngine());
 
-            if (gradW != nullptr) {
+            if (resetW && gradW != nullptr) {
                 auto convW_desc = gradB != nullptr
                         ? convolution_backward_weights::desc(
                                 convolution_direct, conv_src_md, conv_diff_weights_md, conv_bias_md,
@@ -793,7 +846,7 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
                 auto userW_dst_memory = mkldnn::memory({user_dst_md, engine}, const_cast<NDArray*>(gradO)->buffer());
 
                 auto convW_src_memory = userW_src_memory;
-                streams[0].addMemory(userW_src_memory);
+                streams[0].addMemory(userW_src_memory, input);
                 if (mkldnn::memory::primitive_desc(convW_prim_desc.src_primitive_desc())
                         != userW_src_memory.get_primitive_desc()) {
                     convW_src_memory = mkldnn::memory(convW_prim_desc.src_primitive_desc());
@@ -802,7 +855,7 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
                 }
 
                 auto convW_weights_memory = userW_weights_memory;
-                streams[0].addMemory(userW_weights_memory);
+                streams[0].addMemory(userW_weights_memory, gradW);
                 if (mkldnn::memory::primitive_desc(convW_prim_desc.diff_weights_primitive_desc())
                         != userW_weights_memory.get_primitive_desc()) {
                     convW_weights_memory = mkldnn::memory(convW_prim_desc.diff_weights_primitive_desc());
@@ -810,7 +863,7 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
                 }
 
                 auto convW_dst_memory = userW_dst_memory;
-                streams[0].addMemory(userW_dst_memory);
+                streams[0].addMemory(userW_dst_memory, gradO);
                 if (mkldnn::memory::primitive_desc(convW_prim_desc.diff_dst_primitive_desc())
                         != userW_dst_memory.get_primitive_desc()) {
                     convW_dst_memory = mkldnn::memory(convW_prim_desc.diff_dst_primitive_desc());
@@ -820,7 +873,7 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
 
                 if (gradB != nullptr) {
                     auto convW_bias_memory = mkldnn::memory(convW_prim_desc.diff_bias_primitive_desc(), gradB->buffer());
-                    streams[0].addMemory(convW_bias_memory);
+                    streams[0].addMemory(convW_bias_memory, gradB);
                     streams[0].addOperation(convolution_backward_weights(convW_prim_desc, convW_src_memory, convW_dst_memory, convW_weights_memory, convW_bias_memory));
                 } else {
                     streams[0].addOperation(convolution_backward_weights(convW_prim_desc, convW_src_memory, convW_dst_memory, convW_weights_memory));
@@ -832,7 +885,7 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
                 }
             }
 
-            if (gradI != nullptr) {
+            if (resetI && gradI != nullptr) {
                 auto convI_desc =
                         convolution_backward_data::desc(
                                 convolution_direct, conv_diff_src_md, conv_weights_md,
@@ -845,7 +898,7 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
                 auto userI_dst_memory = mkldnn::memory({user_dst_md, engine}, const_cast<NDArray*>(gradO)->buffer());
 
                 auto convI_src_memory = userI_src_memory;
-                streams[1].addMemory(userI_src_memory);
+                streams[1].addMemory(userI_src_memory, gradI);
                 if (mkldnn::memory::primitive_desc(convI_prim_desc.diff_src_primitive_desc())
                         != userI_src_memory.get_primitive_desc()) {
                     convI_src_memory = mkldnn::memory(convI_prim_desc.diff_src_primitive_desc());
@@ -853,7 +906,7 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
                 }
 
                 auto convI_weights_memory = userI_weights_memory;
-                streams[1].addMemory(userI_weights_memory);
+                streams[1].addMemory(userI_weights_memory, weights);
                 if (mkldnn::memory::primitive_desc(convI_prim_desc.weights_primitive_desc())
                         != userI_weights_memory.get_primitive_desc()) {
                     convI_weights_memory = mkldnn::memory(convI_prim_desc.weights_primitive_desc());
@@ -862,7 +915,7 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
                 }
 
                 auto convI_dst_memory = userI_dst_memory;
-                streams[1].addMemory(userI_dst_memory);
+                streams[1].addMemory(userI_dst_memory, gradO);
                 if (mkldnn::memory::primitive_desc(convI_prim_desc.diff_dst_primitive_desc())
                         != userI_dst_memory.get_primitive_desc()) {
                     convI_dst_memory = mkldnn::memory(convI_prim_desc.diff_dst_primitive_desc());
@@ -955,6 +1008,64 @@ static void depthwiseConv2d_(const NDArray* input, const NDArray* weights, const
     ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, *input, *output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWmC, indWkH, indOoH);
     mC = weights->sizeAt(indWmC);                           // channels multiplier
 
+    if(isSameMode)                       // SAME
+        ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
+
+    // native channels-last path: every kernel tap is a multiply-add over contiguous [iC*mC] vector of output
+    const bool sameTypes = input->dataType() == output->dataType() && weights->dataType() == output->dataType();
+    if(!isNCHW && sameTypes && input->ordering() == 'c' && input->ews() == 1 && weights->ordering() == 'c' && weights->ews() == 1 && output->ordering() == 'c' && output->ews() == 1) {
+
+        const Y* x = const_cast<NDArray*>(input)->bufferAsT<Y>();
+        const Y* w = const_cast<NDArray*>(weights)->bufferAsT<Y>();
+        Y* out = output->bufferAsT<Y>();
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(collapse(2))
+        for(int b = 0; b < bS; ++b) {
+            for(int oh = 0; oh < oH; ++oh) {
+                for(int ow = 0; ow < oW; ++ow) {
+
+                    Y* z = out + ((b*oH + oh)*oW + ow) * oC;
+
+                    PRAGMA_OMP_SIMD
+                    for(int i = 0; i < oC; ++i)
+                        z[i] = static_cast<Y>(0.f);
+
+                    for(int kh = 0; kh < kH; ++kh) {
+                        const int ih = oh*sH - pH + kh*dH;
+                        if(ih < 0 || ih >= iH)
+                            continue;
+                        for(int kw = 0; kw < kW; ++kw) {
+                            const int iw = ow*sW - pW + kw*dW;
+                            if(iw < 0 || iw >= iW)
+                                continue;
+
+                            const Y* xi = x + ((b*iH + ih)*iW + iw)*iC;
+                            const Y* wi = w + (kh*kW + kw)*oC;
+
+                            if(mC == 1) {
+                                PRAGMA_OMP_SIMD
+                                for(int c = 0; c < iC; ++c)
+                                    z[c] += xi[c] * wi[c];
+                            }
+                            else {
+                                for(int c = 0; c < iC; ++c) {
+                                    PRAGMA_OMP_SIMD
+                                    for(int m = 0; m < mC; ++m)
+                                        z[c*mC + m] += xi[c] * wi[c*mC + m];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        if(bias)
+            output->applyBroadcast(broadcast::Add, {indIOioC}, bias);
+
+        return;
+    }
+
     std::vector<std::vector<Nd4jLong>> modifColumns = {{1,0,4,5,2,3}, {iC,bS*oH*oW,kH*kW}};  // [bS,iC,kH,kW,oH,oW] -> [iC,bS,oH,oW,kH,kW] -> [iC,bS*oH*oW,kH*kW]
     std::vector<std::vector<Nd4jLong>> modifOutput;
     std::vector<Nd4jLong> outReShape;
@@ -969,9 +1080,6 @@ static void depthwiseConv2d_(const NDArray* input, const NDArray* weights, const
         modifOutput = {{1,0,3,4,2},{iC, bS*oH*oW, mC}};                                 // [bS,iC,mC,oH,oW] -> [iC,bS,oH,oW,mC] -> [iC,bS*oH*oW,mC]
     }
 
-    if(isSameMode)                       // SAME
-        ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
-
     NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
     NDArray* outputReshaped = output->reshape(output->ordering(), outReShape);
 
@@ -1390,6 +1498,216 @@ void ConvolutionUtils::getMKLDNNMemoryDescPool3d(
 }
 #endif
 
+//////////////////////////////////////////////////////////////////////////
+// channels-last (NHWC) pooling: channel stride is 1 both in input and output, so channel is used as simd lane
+template <typename T>
+static void pooling2dChannelsLast_(const NDArray& input, NDArray& output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0) {
+    // input is  [bS, iC, iH, iW] with iStride1 == 1
+    // output is [bS, iC, oH, oW] with oStride1 == 1
+    T* out = output.bufferAsT<T>();
+    T* in  = const_cast<NDArray&>(input).bufferAsT<T>();
+
+    const int kHEff = kH + (kH-1)*(dH-1);
+    const int kWEff = kW + (kW-1)*(dW-1);
+
+    const int bS = input.sizeAt(0);
+    const int iC = input.sizeAt(1);
+    const int iH = input.sizeAt(2);
+    const int iW = input.sizeAt(3);
+    const int oH = output.sizeAt(2);
+    const int oW = output.sizeAt(3);
+
+    const Nd4jLong iStride0 = input.stridesOf()[0];
+    const Nd4jLong iStride2 = input.stridesOf()[2];
+    const Nd4jLong iStride3 = input.stridesOf()[3];
+    const Nd4jLong oStride0 = output.stridesOf()[0];
+    const Nd4jLong oStride2 = output.stridesOf()[2];
+    const Nd4jLong oStride3 = output.stridesOf()[3];
+
+    const T initial = poolingMode == 0 ? -DataTypeUtils::max<T>() : static_cast<T>(0.f);
+    const T pNorm   = static_cast<T>(extraParam0);
+
+    PRAGMA_OMP_PARALLEL_FOR_ARGS(collapse(2))
+    for(int b = 0; b < bS; ++b) {
+        for(int oh = 0; oh < oH; ++oh) {
+            for(int ow = 0; ow < oW; ++ow) {
+
+                Nd4jLong hstart = oh * sH - pH;
+                Nd4jLong wstart = ow * sW - pW;
+                Nd4jLong hend = hstart + kHEff;
+                Nd4jLong wend = wstart + kWEff;
+
+                if(hstart < 0)
+                    hstart += dH * ((-hstart + dH - 1) / dH);
+                if(wstart < 0)
+                    wstart += dW * ((-wstart + dW - 1) / dW);
+                if(hend > iH)
+                    hend -= dH * ((hend-iH + dH - 1) / dH);
+                if(wend > iW)
+                    wend -= dW * ((wend-iW + dW - 1) / dW);
+
+                T* z = out + b * oStride0 + oh * oStride2 + ow * oStride3;
+
+                PRAGMA_OMP_SIMD
+                for(int c = 0; c < iC; ++c)
+                    z[c] = initial;
+
+                for (Nd4jLong h = hstart; h < hend; h += dH) {
+                    for (Nd4jLong w = wstart; w < wend; w += dW) {
+                        const T* x = in + b * iStride0 + h * iStride2 + w * iStride3;
+                        if(poolingMode == 0) {
+                            PRAGMA_OMP_SIMD
+                            for(int c = 0; c < iC; ++c)
+                                z[c] = x[c] > z[c] ? x[c] : z[c];
+                        }
+                        else if(poolingMode == 1) {
+                            PRAGMA_OMP_SIMD
+                            for(int c = 0; c < iC; ++c)
+                                z[c] += x[c];
+                        }
+                        else {
+                            PRAGMA_OMP_SIMD
+                            for(int c = 0; c < iC; ++c)
+                                z[c] += nd4j::math::nd4j_pow<T,T,T>(nd4j::math::nd4j_abs<T>(x[c]), pNorm);
+                        }
+                    }
+                }
+
+                if(poolingMode == 1) {
+                    T divisor = static_cast<T>(1.f);
+                    if (extraParam0 == 0)           //Exclude padding
+                        divisor = static_cast<T>(((hend - hstart + dH - 1) / dH) * ((wend - wstart + dW - 1) / dW));
+                    else if (extraParam0 == 1)      //Include padding
+                        divisor = static_cast<T>(kH * kW);
+
+                    if(extraParam0 == 0 || extraParam0 == 1) {
+                        PRAGMA_OMP_SIMD
+                        for(int c = 0; c < iC; ++c)
+                            z[c] /= divisor;
+                    }
+                }
+                else if(poolingMode == 2) {
+                    PRAGMA_OMP_SIMD
+                    for(int c = 0; c < iC; ++c)
+                        z[c] = nd4j::math::nd4j_pow<T,T,T>(z[c], static_cast<T>((T)1.f) / pNorm);
+                }
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void pooling3dChannelsLast_(const NDArray& input, NDArray& output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int poolingMode, const int extraParam0) {
+    // input is  [bS, iC, iD, iH, iW] with iStride1 == 1
+    // output is [bS, iC, oD, oH, oW] with oStride1 == 1
+    T* out = output.bufferAsT<T>();
+    T* in  = const_cast<NDArray&>(input).bufferAsT<T>();
+
+    const int kDEff = kD + (kD-1)*(dD-1);
+    const int kHEff = kH + (kH-1)*(dH-1);
+    const int kWEff = kW + (kW-1)*(dW-1);
+
+    const int bS = input.sizeAt(0);
+    const int iC = input.sizeAt(1);
+    const int iD = input.sizeAt(2);
+    const int iH = input.sizeAt(3);
+    const int iW = input.sizeAt(4);
+    const int oD = output.sizeAt(2);
+    const int oH = output.sizeAt(3);
+    const int oW = output.sizeAt(4);
+
+    const Nd4jLong iStride0 = input.stridesOf()[0];
+    const Nd4jLong iStride2 = input.stridesOf()[2];
+    const Nd4jLong iStride3 = input.stridesOf()[3];
+    const Nd4jLong iStride4 = input.stridesOf()[4];
+    const Nd4jLong oStride0 = output.stridesOf()[0];
+    const Nd4jLong oStride2 = output.stridesOf()[2];
+    const Nd4jLong oStride3 = output.stridesOf()[3];
+    const Nd4jLong oStride4 = output.stridesOf()[4];
+
+    const T initial = poolingMode == 0 ? -DataTypeUtils::max<T>() : static_cast<T>(0.f);
+    const T pNorm   = static_cast<T>(extraParam0);
+
+    PRAGMA_OMP_PARALLEL_FOR_ARGS(collapse(2))
+    for(int b = 0; b < bS; ++b) {
+        for(int od = 0; od < oD; ++od) {
+            for(int oh = 0; oh < oH; ++oh) {
+                for(int ow = 0; ow < oW; ++ow) {
+
+                    Nd4jLong dstart = od * sD - pD;
+                    Nd4jLong hstart = oh * sH - pH;
+                    Nd4jLong wstart = ow * sW - pW;
+                    Nd4jLong dend = dstart + kDEff;
+                    Nd4jLong hend = hstart + kHEff;
+                    Nd4jLong wend = wstart + kWEff;
+
+                    if(dstart < 0)
+                        dstart += dD * ((-dstart + dD - 1) / dD);
+                    if(hstart < 0)
+                        hstart += dH * ((-hstart + dH - 1) / dH);
+                    if(wstart < 0)
+                        wstart += dW * ((-wstart + dW - 1) / dW);
+                    if(dend > iD)
+                        dend -= dD * ((dend-iD + dD - 1) / dD);
+                    if(hend > iH)
+                        hend -= dH * ((hend-iH + dH - 1) / dH);
+                    if(wend > iW)
+                        wend -= dW * ((wend-iW + dW - 1) / dW);
+
+                    T* z = out + b * oStride0 + od * oStride2 + oh * oStride3 + ow * oStride4;
+
+                    PRAGMA_OMP_SIMD
+                    for(int c = 0; c < iC; ++c)
+                        z[c] = initial;
+
+                    for (Nd4jLong d = dstart; d < dend; d += dD) {
+                        for (Nd4jLong h = hstart; h < hend; h += dH) {
+                            for (Nd4jLong w = wstart; w < wend; w += dW) {
+                                const T* x = in + b * iStride0 + d * iStride2 + h * iStride3 + w * iStride4;
+                                if(poolingMode == 0) {
+                                    PRAGMA_OMP_SIMD
+                                    for(int c = 0; c < iC; ++c)
+                                        z[c] = x[c] > z[c] ? x[c] : z[c];
+                                }
+                                else if(poolingMode == 1) {
+                                    PRAGMA_OMP_SIMD
+                                    for(int c = 0; c < iC; ++c)
+                                        z[c] += x[c];
+                                }
+                                else {
+                                    PRAGMA_OMP_SIMD
+                                    for(int c = 0; c < iC; ++c)
+                                        z[c] += nd4j::math::nd4j_pow<T,T,T>(nd4j::math::nd4j_abs<T>(x[c]), pNorm);
+                                }
+                            }
+                        }
+                    }
+
+                    if(poolingMode == 1) {
+                        T divisor = static_cast<T>(1.f);
+                        if (extraParam0 == 0)           //Exclude padding
+                            divisor = static_cast<T>(((dend - dstart + dD - 1) / dD) * ((hend - hstart + dH - 1) / dH) * ((wend - wstart + dW - 1) / dW));
+                        else if (extraParam0 == 1)      //Include padding
+                            divisor = static_cast<T>(kD * kH * kW);
+
+                        if(extraParam0 == 0 || extraParam0 == 1) {
+                            PRAGMA_OMP_SIMD
+                            for(int c = 0; c < iC; ++c)
+                                z[c] /= divisor;
+                        }
+                    }
+                    else if(poolingMode == 2) {
+                        PRAGMA_OMP_SIMD
+                        for(int c = 0; c < iC; ++c)
+                            z[c] = nd4j::math::nd4j_pow<T,T,T>(z[c], static_cast<T>((T)1.f) / pNorm);
+                    }
+                }
+            }
+        }
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 template <typename T>
 static void pooling2d_(nd4j::graph::Context& block, const NDArray& input, NDArray& output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0) {
@@ -1437,7 +1755,7 @@ static void pooling2d_(nd4j::graph::Context& block, const NDArray& input, NDArra
             auto user_dst_memory = mkldnn::memory({user_dst_md, engine}, output.buffer());
 
             auto pool_src_memory = user_src_memory;
-            streams[0].addMemory(user_src_memory);
+            streams[0].addMemory(user_src_memory, &input);
             if (mkldnn::memory::primitive_desc(pool_prim_desc.src_primitive_desc())
                     != user_src_memory.get_primitive_desc()) {
                 pool_src_memory = mkldnn::memory(pool_prim_desc.src_primitive_desc());
@@ -1446,7 +1764,7 @@ static void pooling2d_(nd4j::graph::Context& block, const NDArray& input, NDArra
             }
 
             auto pool_dst_memory = user_dst_memory;
-            streams[0].addMemory(user_dst_memory);
+            streams[0].addMemory(user_dst_memory, &output);
             if (mkldnn::memory::primitive_desc(pool_prim_desc.dst_primitive_desc())
                     != user_dst_memory.get_primitive_desc()) {
                 pool_dst_memory = mkldnn::memory(pool_prim_desc.dst_primitive_desc());
@@ -1467,6 +1785,11 @@ static void pooling2d_(nd4j::graph::Context& block, const NDArray& input, NDArra
 #endif
     nd4j_debug("MKL-DNN is not used for pooling2d!\n", 0);
 
+    if(input.stridesOf()[1] == 1 && output.stridesOf()[1] == 1 && iC > 1 && poolingMode <= 2) {
+        pooling2dChannelsLast_<T>(input, output, kH, kW, sH, sW, pH, pW, dH, dW, poolingMode, extraParam0);
+        return;
+    }
+
     const Nd4jLong iStride0 = input.stridesOf()[0];
     const Nd4jLong iStride1 = input.stridesOf()[1];
     const Nd4jLong iStride2 = input.stridesOf()[2];
@@ -1676,7 +1999,7 @@ static void pooling3d_(nd4j::graph::Context& block, const NDArray& input, NDArra
             auto user_dst_memory = mkldnn::memory({user_dst_md, engine}, output.buffer());
 
             auto pool_src_memory = user_src_memory;
-            streams[0].addMemory(user_src_memory);
+            streams[0].addMemory(user_src_memory, &input);
             if (mkldnn::memory::primitive_desc(pool_prim_desc.src_primitive_desc())
                     != user_src_memory.get_primitive_desc()) {
                 pool_src_memory = mkldnn::memory(pool_prim_desc.src_primitive_desc());
@@ -1685,7 +2008,7 @@ static void pooling3d_(nd4j::graph::Context& block, const NDArray& input, NDArra
             }
 
             auto pool_dst_memory = user_dst_memory;
-            streams[0].addMemory(user_dst_memory);
+            streams[0].addMemory(user_dst_memory, &output);
             if (mkldnn::memory::primitive_desc(pool_prim_desc.dst_primitive_desc())
                     != user_dst_memory.get_primitive_desc()) {
                 pool_dst_memory = mkldnn::memory(pool_prim_desc.dst_primitive_desc());
@@ -1706,6 +2029,11 @@ static void pooling3d_(nd4j::graph::Context& block, const NDArray& input, NDArra
 #endif
     nd4j_debug("MKL-DNN is not used for pooling3d!\n", 0);
 
+    if(input.stridesOf()[1] == 1 && output.stridesOf()[1] == 1 && iC > 1 && poolingMode <= 2) {
+        pooling3dChannelsLast_<T>(input, output, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, poolingMode, extraParam0);
+        return;
+    }
+
     const Nd4jLong iStride0 = input.stridesOf()[0];
     const Nd4jLong iStride1 = input.stridesOf()[1];
     const Nd4jLong iStride2 = input.stridesOf()[2];
@@ -1970,7 +2298,7 @@ static void pooling2dBP_(nd4j::graph::Context& block, const NDArray& input, cons
             auto userB_dst_memory = mkldnn::memory({user_dst_md, engine}, const_cast<NDArray&>(gradO).buffer());
 
             auto poolB_src_memory = userB_src_memory;
-            streams[0].addMemory(userB_src_memory);
+            streams[0].addMemory(userB_src_memory, &gradI);
             if (mkldnn::memory::primitive_desc(poolB_prim_desc.diff_src_primitive_desc())
                     != userB_src_memory.get_primitive_desc()) {
                 poolB_src_memory = mkldnn::memory(poolB_prim_desc.diff_src_primitive_desc());
@@ -1978,7 +2306,7 @@ static void pooling2dBP_(nd4j::graph::Context& block, const NDArray& input, cons
             }
 
             auto poolB_dst_memory = userB_dst_memory;
-            streams[0].addMemory(userB_dst_memory);
+            streams[0].addMemory(userB_dst_memory, &gradO);
             if (mkldnn::memory::primitive_desc(poolB_prim_desc.diff_dst_primitive_desc())
                     != userB_dst_memory.get_primitive_desc()) {
                 poolB_dst_memory = mkldnn::memory(poolB_prim_desc.diff_dst_primitive_desc());
@@ -1990,7 +2318,7 @@ static void pooling2dBP_(nd4j::graph::Context& block, const NDArray& input, cons
                 auto user_src_memory = mkldnn::memory({user_src_md, engine}, const_cast<NDArray&>(input).buffer());
 
                 auto pool_src_memory = user_src_memory;
-                streams[0].addMemory(user_src_memory);
+                streams[0].addMemory(user_src_memory, &input);
                 if (mkldnn::memory::primitive_desc(pool_prim_desc.src_primitive_desc())
                         != user_src_memory.get_primitive_desc()) {
                     pool_src_memory = mkldnn::memory(pool_prim_desc.src_primitive_desc());
@@ -2267,7 +2595,7 @@ static void pooling3dBP_(nd4j::graph::Context& block, const NDArray& input, cons
             auto userB_dst_memory = mkldnn::memory({user_dst_md, engine}, const_cast<NDArray&>(gradO).buffer());
 
             auto poolB_src_memory = userB_src_memory;
-            streams[0].addMemory(userB_src_memory);
+            streams[0].addMemory(userB_src_memory, &gradI);
             if (mkldnn::memory::primitive_desc(poolB_prim_desc.diff_src_primitive_desc())
                     != userB_src_memory.get_primitive_desc()) {
                 poolB_src_memory = mkldnn::memory(poolB_prim_desc.diff_src_primitive_desc());
@@ -2275,7 +2603,7 @@ static void pooling3dBP_(nd4j::graph::Context& block, const NDArray& input, cons
             }
 
             auto poolB_dst_memory = userB_dst_memory;
-            streams[0].addMemory(userB_dst_memory);
+            streams[0].addMemory(userB_dst_memory, &gradO);
             if (mkldnn::memory::primitive_desc(poolB_prim_desc.diff_dst_primitive_desc())
                     != userB_dst_memory.get_primitive_desc()) {
                 poolB_dst_memory = mkldnn::memory(poolB_prim_desc.diff_dst_primitive_desc());
@@ -2287,7 +2615,7 @@ static void pooling3dBP_(nd4j::graph::Context& block, const NDArray& input, cons
                 auto user_src_memory = mkldnn::memory({user_src_md, engine}, const_cast<NDArray&>(input).buffer());
 
                 auto pool_src_memory = user_src_memory;
-                streams[0].addMemory(user_src_memory);
+                streams[0].addMemory(user_src_memory, &input);
                 if (mkldnn::memory::primitive_desc(pool_prim_desc.src_primitive_desc())
                         != user_src_memory.get_primitive_desc()) {
                     pool_src_memory = mkldnn::memory(pool_prim_desc.src_primitive_desc());
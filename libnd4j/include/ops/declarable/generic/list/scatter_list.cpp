@@ -56,8 +56,7 @@ namespace nd4j {
                 if (idx >= tads->size())
                     return ND4J_STATUS_BAD_ARGUMENTS;
 
-                auto arr = tads->at(e)->dup(array->ordering());
-                auto res = list->write(idx, arr);
+                auto res = list->assign(idx, *tads->at(e));
                 if (res != ND4J_STATUS_OK)
                     return res;
             }
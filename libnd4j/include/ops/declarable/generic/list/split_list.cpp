@@ -66,7 +66,7 @@ namespace nd4j {
                 
                 auto subarray = (*array)(indices);
 
-                auto status = list->write(e, subarray.dup(array->ordering()));
+                auto status = list->assign(e, subarray);
                 
                 if (status != ND4J_STATUS_OK)
                     return status;
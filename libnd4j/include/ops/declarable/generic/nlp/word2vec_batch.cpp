@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_word2vec_batch)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/sg_cb.h>
+#include <chrono>
+
+namespace nd4j {
+    namespace ops {
+        CONFIGURABLE_OP_IMPL(word2vec_batch, 12, 12, true, 0, 0) {
+            auto inputs = INPUT_VARIABLE(0);
+            auto lockedRows = INPUT_VARIABLE(1);
+            auto positives = INPUT_VARIABLE(2);
+
+            auto indices = INPUT_VARIABLE(3);
+            auto codes = INPUT_VARIABLE(4);
+
+            auto syn0 = INPUT_VARIABLE(5);
+            auto syn1 = INPUT_VARIABLE(6);
+            auto syn1neg = INPUT_VARIABLE(7);
+
+            auto expTable = INPUT_VARIABLE(8);
+            auto negTable = INPUT_VARIABLE(9);
+
+            auto alpha = INPUT_VARIABLE(10);
+            auto randomValue = INPUT_VARIABLE(11);
+
+            auto numWorkers = block.numI() > 0 ? INT_ARG(0) : omp_get_max_threads();
+            auto nsRounds = block.numI() > 1 ? INT_ARG(1) : 0;
+            auto maxGroupSize = block.numI() > 2 ? INT_ARG(2) : 16;
+
+            REQUIRE_TRUE(block.isInplace(), 0, "word2vec_batch: this operation requires inplace execution only");
+
+            REQUIRE_TRUE(syn0->rankOf() == 2, 0, "word2vec_batch: syn0 must have rank 2, but got rank %i instead", syn0->rankOf());
+            REQUIRE_TRUE(inputs->rankOf() == 1 || inputs->rankOf() == 2, 0, "word2vec_batch: inputs must have rank 1 or 2, but got rank %i instead", inputs->rankOf());
+            REQUIRE_TRUE(lockedRows->isEmpty() || lockedRows->isSameShape(inputs), 0, "word2vec_batch: lockedRows must be empty or have the same shape as inputs");
+
+            const Nd4jLong numExamples = inputs->sizeAt(0);
+            REQUIRE_TRUE(alpha->lengthOf() == numExamples && randomValue->lengthOf() == numExamples, 0, "word2vec_batch: alpha and randomValue must have one value per example");
+            REQUIRE_TRUE(positives->isEmpty() || positives->lengthOf() == numExamples, 0, "word2vec_batch: positives must be empty or have one value per example");
+            REQUIRE_TRUE(indices->isSameShape(codes), 0, "word2vec_batch: indices and codes must have the same shape");
+            REQUIRE_TRUE(indices->isEmpty() || (indices->rankOf() == 2 && indices->sizeAt(0) == numExamples), 0, "word2vec_batch: indices must be empty or have shape [numExamples, pathLength]");
+
+            REQUIRE_TRUE(syn1->isEmpty() || syn1->dataType() == syn0->dataType(), 0, "word2vec_batch: all syn tables must have the same data type");
+            REQUIRE_TRUE(syn1neg->isEmpty() || syn1neg->dataType() == syn0->dataType(), 0, "word2vec_batch: all syn tables must have the same data type");
+            REQUIRE_TRUE(syn0->dataType() == expTable->dataType(), 0, "word2vec_batch: expTable must have the same data type as syn0 table");
+            REQUIRE_TRUE(negTable->isEmpty() || syn0->dataType() == negTable->dataType(), 0, "word2vec_batch: negTable must have the same data type as syn0 table");
+
+            auto timeStart = std::chrono::system_clock::now();
+
+            auto processed = nd4j::ops::helpers::word2vecBatch(*syn0, *syn1, *syn1neg, *expTable, *negTable, *inputs, *lockedRows, *positives, *indices, *codes, *alpha, *randomValue, nsRounds, maxGroupSize, numWorkers);
+
+            if (Environment::getInstance()->isVerbose()) {
+                auto time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - timeStart).count();
+                auto cores = nd4j::math::nd4j_max<int>(1, nd4j::math::nd4j_min<int>(numWorkers, omp_get_max_threads()));
+                nd4j_printf("word2vec_batch: %lld words in %lld us, %.1f words/sec/core\n", (long long) processed, (long long) time, time > 0 ? processed * 1e6 / time / cores : 0.0);
+            }
+
+            return Status::OK();
+        }
+
+        DECLARE_TYPES(word2vec_batch) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(0, nd4j::DataType::INT32)
+                    ->setAllowedInputTypes(1, nd4j::DataType::INT32)
+                    ->setAllowedInputTypes(2, nd4j::DataType::INT32)
+                    ->setAllowedInputTypes(3, nd4j::DataType::INT32)
+                    ->setAllowedInputTypes(4, nd4j::DataType::INT8)
+                    ->setAllowedInputTypes(5, {ALL_FLOATS})
+                    ->setAllowedInputTypes(6, {ALL_FLOATS})
+                    ->setAllowedInputTypes(7, {ALL_FLOATS})
+                    ->setAllowedInputTypes(8, {ALL_FLOATS})
+                    ->setAllowedInputTypes(9, {ALL_FLOATS})
+                    ->setAllowedInputTypes(10, {ALL_FLOATS})
+                    ->setAllowedInputTypes(11, nd4j::DataType::INT64)
+                    ->setAllowedOutputTypes(nd4j::DataType::ANY);
+        }
+    }
+}
+
+#endif
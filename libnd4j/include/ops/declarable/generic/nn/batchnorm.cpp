@@ -222,7 +222,8 @@ CUSTOM_OP_IMPL(batchnorm_new, 3, 1, false, 1, 2) {
         weights({0, 1, 0, 0}).assign(1.0f);
         weights({1, 2, 0, 0}).assign(0.0f);
 
-        if (streams[0].checkAndReset({input, mean, variance, gamma, beta}, {output}, {(float)epsilon}, axes)) {
+        // weights are packed into temporary array every call, so it's bound like inputs
+        if (streams[0].checkAndReset({input, mean, variance, gamma, beta, &weights}, {output}, {(float)epsilon}, axes)) {
             mkldnn_memory_desc_t empty;
             mkldnn::memory::desc batchnorm_src_md(empty), batchnorm_dst_md(empty), user_src_md(empty), user_dst_md(empty);
 
@@ -241,7 +242,7 @@ CUSTOM_OP_IMPL(batchnorm_new, 3, 1, false, 1, 2) {
             auto batchnorm_variance_memory = mkldnn::memory(batchnorm_prim_desc.variance_primitive_desc(), variance->buffer());
 
             auto batchnorm_src_memory = user_src_memory;
-            streams[0].addMemory(user_src_memory);
+            streams[0].addMemory(user_src_memory, input);
             if (mkldnn::memory::primitive_desc({batchnorm_src_md, engine})
                     != user_src_memory.get_primitive_desc()) {
                 batchnorm_src_memory = mkldnn::memory({batchnorm_src_md, engine});
@@ -250,19 +251,19 @@ CUSTOM_OP_IMPL(batchnorm_new, 3, 1, false, 1, 2) {
             }
 
             auto batchnorm_dst_memory = user_dst_memory;
-            streams[0].addMemory(user_dst_memory);
+            streams[0].addMemory(user_dst_memory, output);
             if (mkldnn::memory::primitive_desc(batchnorm_prim_desc.dst_primitive_desc())
                     != user_dst_memory.get_primitive_desc()) {
                 batchnorm_dst_memory = mkldnn::memory(batchnorm_prim_desc.dst_primitive_desc());
                 streams[0].addMemory(batchnorm_dst_memory);
             }
 
-            streams[0].addMemory(batchnorm_mean_memory);
-            streams[0].addMemory(batchnorm_variance_memory);
+            streams[0].addMemory(batchnorm_mean_memory, mean);
+            streams[0].addMemory(batchnorm_variance_memory, variance);
 
             if (applyScale || applyOffset) {
                 auto batchnorm_weights_memory = mkldnn::memory(batchnorm_prim_desc.weights_primitive_desc(), weights.buffer());
-                streams[0].addMemory(batchnorm_weights_memory);
+                streams[0].addMemory(batchnorm_weights_memory, &weights);
                 streams[0].addOperation(batch_normalization_forward(batchnorm_prim_desc, (mkldnn::primitive::at)batchnorm_src_memory,
                         (mkldnn::primitive::at)batchnorm_mean_memory, (mkldnn::primitive::at)batchnorm_variance_memory, (mkldnn::primitive::at)batchnorm_weights_memory, batchnorm_dst_memory));
             } else {
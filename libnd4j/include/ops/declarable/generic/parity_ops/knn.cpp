@@ -0,0 +1,153 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// k nearest neighbours search ops: brute force and vantage-point tree, see helpers/knn.h
+//
+
+#include <op_boilerplate.h>
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/knn.h>
+
+namespace nd4j {
+    namespace ops {
+
+#if NOT_EXCLUDED(OP_knn_search)
+        CUSTOM_OP_IMPL(knn_search, 2, 2, false, 0, 1) {
+            auto data = INPUT_VARIABLE(0);
+            auto queries = INPUT_VARIABLE(1);
+            auto indices = OUTPUT_VARIABLE(0);
+            auto distances = OUTPUT_VARIABLE(1);
+
+            const int k = INT_ARG(0);
+            const int metric = block.getIArguments()->size() > 1 ? INT_ARG(1) : (int) nd4j::reduce3::EuclideanDistance;
+
+            REQUIRE_TRUE(data->rankOf() == 2 && queries->rankOf() == 2, 0, "KNN_SEARCH OP: data and queries must be matrices, but got ranks %i and %i !", data->rankOf(), queries->rankOf());
+            REQUIRE_TRUE(data->sizeAt(1) == queries->sizeAt(1), 0, "KNN_SEARCH OP: data and queries must have the same number of columns, but got %i and %i !", data->sizeAt(1), queries->sizeAt(1));
+            REQUIRE_TRUE(data->dataType() == queries->dataType(), 0, "KNN_SEARCH OP: data and queries must have the same data type !");
+            REQUIRE_TRUE(k > 0 && k <= data->sizeAt(0), 0, "KNN_SEARCH OP: k must be within [1, %i], but got %i !", data->sizeAt(0), k);
+            REQUIRE_TRUE(metric == nd4j::reduce3::ManhattanDistance || metric == nd4j::reduce3::EuclideanDistance || metric == nd4j::reduce3::CosineDistance, 0, "KNN_SEARCH OP: metric must be one of Manhattan (0), Euclidean (1) or Cosine (5) distances, but got %i !", metric);
+
+            helpers::knnBruteForce(*data, *queries, k, metric, *indices, *distances);
+
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(knn_search) {
+            auto dataShapeInfo = inputShape->at(0);
+            auto queriesShapeInfo = inputShape->at(1);
+            const Nd4jLong k = INT_ARG(0);
+
+            auto indicesShape = ShapeBuilders::createShapeInfo(nd4j::DataType::INT64, 'c', {shape::sizeAt(queriesShapeInfo, 0), k}, block.getWorkspace());
+            auto distancesShape = ShapeBuilders::createShapeInfo(ArrayOptions::dataType(dataShapeInfo), 'c', {shape::sizeAt(queriesShapeInfo, 0), k}, block.getWorkspace());
+
+            return SHAPELIST(indicesShape, distancesShape);
+        }
+
+        DECLARE_TYPES(knn_search) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes({ALL_FLOATS})
+                    ->setAllowedOutputTypes(0, nd4j::DataType::INT64)
+                    ->setAllowedOutputTypes(1, {ALL_FLOATS});
+        }
+#endif
+
+#if NOT_EXCLUDED(OP_vptree_build)
+        CUSTOM_OP_IMPL(vptree_build, 1, 2, false, 0, 0) {
+            auto data = INPUT_VARIABLE(0);
+            auto nodes = OUTPUT_VARIABLE(0);
+            auto radii = OUTPUT_VARIABLE(1);
+
+            const int metric = block.getIArguments()->size() > 0 ? INT_ARG(0) : (int) nd4j::reduce3::EuclideanDistance;
+
+            REQUIRE_TRUE(data->rankOf() == 2, 0, "VPTREE_BUILD OP: data must be a matrix, but got rank %i !", data->rankOf());
+            REQUIRE_TRUE(data->sizeAt(0) > 0, 0, "VPTREE_BUILD OP: data must not be empty !");
+            REQUIRE_TRUE(metric == nd4j::reduce3::ManhattanDistance || metric == nd4j::reduce3::EuclideanDistance, 0, "VPTREE_BUILD OP: metric must be one of Manhattan (0) or Euclidean (1) distances, but got %i !", metric);
+
+            helpers::vpTreeBuild(*data, metric, *nodes, *radii);
+
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(vptree_build) {
+            auto dataShapeInfo = inputShape->at(0);
+
+            auto nodesShape = ShapeBuilders::createShapeInfo(nd4j::DataType::INT64, 'c', {shape::sizeAt(dataShapeInfo, 0), (Nd4jLong) 3}, block.getWorkspace());
+            auto radiiShape = ShapeBuilders::createShapeInfo(ArrayOptions::dataType(dataShapeInfo), 'c', {shape::sizeAt(dataShapeInfo, 0)}, block.getWorkspace());
+
+            return SHAPELIST(nodesShape, radiiShape);
+        }
+
+        DECLARE_TYPES(vptree_build) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes({ALL_FLOATS})
+                    ->setAllowedOutputTypes(0, nd4j::DataType::INT64)
+                    ->setAllowedOutputTypes(1, {ALL_FLOATS});
+        }
+#endif
+
+#if NOT_EXCLUDED(OP_vptree_search)
+        CUSTOM_OP_IMPL(vptree_search, 4, 2, false, 0, 1) {
+            auto data = INPUT_VARIABLE(0);
+            auto nodes = INPUT_VARIABLE(1);
+            auto radii = INPUT_VARIABLE(2);
+            auto queries = INPUT_VARIABLE(3);
+            auto indices = OUTPUT_VARIABLE(0);
+            auto distances = OUTPUT_VARIABLE(1);
+
+            const int iSize = (int) block.getIArguments()->size();
+            const int k = INT_ARG(0);
+            const int metric = iSize > 1 ? INT_ARG(1) : (int) nd4j::reduce3::EuclideanDistance;
+            const Nd4jLong maxVisits = iSize > 2 ? INT_ARG(2) : 0;
+
+            REQUIRE_TRUE(data->rankOf() == 2 && queries->rankOf() == 2, 0, "VPTREE_SEARCH OP: data and queries must be matrices, but got ranks %i and %i !", data->rankOf(), queries->rankOf());
+            REQUIRE_TRUE(data->sizeAt(1) == queries->sizeAt(1), 0, "VPTREE_SEARCH OP: data and queries must have the same number of columns, but got %i and %i !", data->sizeAt(1), queries->sizeAt(1));
+            REQUIRE_TRUE(data->dataType() == queries->dataType() && data->dataType() == radii->dataType(), 0, "VPTREE_SEARCH OP: data, radii and queries must have the same data type !");
+            REQUIRE_TRUE(nodes->dataType() == nd4j::DataType::INT64, 0, "VPTREE_SEARCH OP: nodes must have INT64 data type !");
+            REQUIRE_TRUE(nodes->rankOf() == 2 && nodes->sizeAt(0) == data->sizeAt(0) && nodes->sizeAt(1) == 3, 0, "VPTREE_SEARCH OP: nodes must have shape [%i, 3], but got %s !", data->sizeAt(0), ShapeUtils::shapeAsString(nodes).c_str());
+            REQUIRE_TRUE(radii->lengthOf() == data->sizeAt(0), 0, "VPTREE_SEARCH OP: radii must have length %i, but got %i !", data->sizeAt(0), radii->lengthOf());
+            REQUIRE_TRUE(k > 0 && k <= data->sizeAt(0), 0, "VPTREE_SEARCH OP: k must be within [1, %i], but got %i !", data->sizeAt(0), k);
+            REQUIRE_TRUE(metric == nd4j::reduce3::ManhattanDistance || metric == nd4j::reduce3::EuclideanDistance, 0, "VPTREE_SEARCH OP: metric must be one of Manhattan (0) or Euclidean (1) distances, but got %i !", metric);
+            REQUIRE_TRUE(maxVisits >= 0, 0, "VPTREE_SEARCH OP: max visits must be non-negative, but got %i !", maxVisits);
+
+            helpers::vpTreeSearch(*data, *nodes, *radii, *queries, k, metric, maxVisits, *indices, *distances);
+
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(vptree_search) {
+            auto dataShapeInfo = inputShape->at(0);
+            auto queriesShapeInfo = inputShape->at(3);
+            const Nd4jLong k = INT_ARG(0);
+
+            auto indicesShape = ShapeBuilders::createShapeInfo(nd4j::DataType::INT64, 'c', {shape::sizeAt(queriesShapeInfo, 0), k}, block.getWorkspace());
+            auto distancesShape = ShapeBuilders::createShapeInfo(ArrayOptions::dataType(dataShapeInfo), 'c', {shape::sizeAt(queriesShapeInfo, 0), k}, block.getWorkspace());
+
+            return SHAPELIST(indicesShape, distancesShape);
+        }
+
+        DECLARE_TYPES(vptree_search) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(0, {ALL_FLOATS})
+                    ->setAllowedInputTypes(1, nd4j::DataType::INT64)
+                    ->setAllowedInputTypes(2, {ALL_FLOATS})
+                    ->setAllowedInputTypes(3, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(0, nd4j::DataType::INT64)
+                    ->setAllowedOutputTypes(1, {ALL_FLOATS});
+        }
+#endif
+    }
+}
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// triangular_solve op: batched solution of triangular systems, tf.linalg.triangular_solve
+//
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_triangular_solve)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/triangular_solve.h>
+
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(triangular_solve, 2, 1, false, 0, 0) {
+            auto matrix = INPUT_VARIABLE(0);
+            auto rhs = INPUT_VARIABLE(1);
+            auto output = OUTPUT_VARIABLE(0);
+
+            const bool lower = block.numB() > 0 ? B_ARG(0) : true;
+            const bool adjoint = block.numB() > 1 ? B_ARG(1) : false;
+
+            REQUIRE_TRUE(matrix->rankOf() >= 2, 0, "TRIANGULAR_SOLVE OP: the rank of matrix array should not be less than 2, but %i is given !", matrix->rankOf());
+            REQUIRE_TRUE(matrix->rankOf() == rhs->rankOf(), 0, "TRIANGULAR_SOLVE OP: matrix and rhs arrays should have the same rank, but got %i and %i !", matrix->rankOf(), rhs->rankOf());
+            REQUIRE_TRUE(matrix->sizeAt(-1) == matrix->sizeAt(-2), 0, "TRIANGULAR_SOLVE OP: the last two dimensions of matrix array should be equal, but %i and %i are given !", matrix->sizeAt(-2), matrix->sizeAt(-1));
+            REQUIRE_TRUE(matrix->sizeAt(-1) == rhs->sizeAt(-2), 0, "TRIANGULAR_SOLVE OP: rhs array should have %i rows, but %i are given !", matrix->sizeAt(-1), rhs->sizeAt(-2));
+            for (int e = 0; e < matrix->rankOf() - 2; e++)
+                REQUIRE_TRUE(matrix->sizeAt(e) == rhs->sizeAt(e), 0, "TRIANGULAR_SOLVE OP: batch dimensions of matrix and rhs arrays should be equal, but dimension %i differs: %i vs %i !", e, matrix->sizeAt(e), rhs->sizeAt(e));
+            REQUIRE_TRUE(matrix->dataType() == rhs->dataType(), 0, "TRIANGULAR_SOLVE OP: matrix and rhs arrays should have the same data type !");
+
+            return helpers::triangularSolve(matrix, rhs, lower, adjoint, output);
+        }
+
+        DECLARE_SHAPE_FN(triangular_solve) {
+            auto rhsShapeInfo = inputShape->at(1);
+
+            Nd4jLong* outShapeInfo = nullptr;
+            COPY_SHAPE(rhsShapeInfo, outShapeInfo);
+
+            return SHAPELIST(outShapeInfo);
+        }
+
+        DECLARE_TYPES(triangular_solve) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes({ALL_FLOATS})
+                    ->setAllowedOutputTypes({ALL_FLOATS})
+                    ->setSameMode(true);
+        }
+    }
+}
+
+#endif
@@ -46,6 +46,32 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(matmul_bp, 3, 2, false, 0, -2);
         #endif
 
+        /**
+         * Quantised matrix multiplication: UINT8 x INT8 with int32 accumulation, followed by per-channel requantisation.
+         * Real values are r = scale * (q - zeroPoint).
+         *
+         * Input arrays:
+         * 0: x, [M, K], UINT8 or floating point. Floating point x is quantised on the fly with TArgs 0, 1
+         * 1: y, [K, N], INT8
+         * 2: y scales, scalar or [N]
+         * 3: y zero points, scalar or [N]
+         * 4: optional bias, [N], added in real domain
+         *
+         * T arguments:
+         * 0: x scale
+         * 1: x zero point
+         * 2: output scale, required for UINT8 output
+         * 3: output zero point, required for UINT8 output
+         *
+         * Optional Integer arguments:
+         * 0: output type: 0 - dequantised floating point (default), 1 - UINT8
+         * 1: lower bound of integer grid for on-the-fly quantisation of x (default 0)
+         * 2: upper bound of integer grid for on-the-fly quantisation of x (default 255)
+         */
+        #if NOT_EXCLUDED(OP_qmatmul)
+        DECLARE_CUSTOM_OP(qmatmul, 4, 1, false, 2, -2);
+        #endif
+
         /**
          * tensorMmul/tensorDot operation
          * takes 2 ndarrays, and 2 sets of axes
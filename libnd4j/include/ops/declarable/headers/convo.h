@@ -68,6 +68,31 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(conv2d_input_bp, 3, 1, false, 0, 9);
         #endif
 
+        /**
+         * Quantised 2D convolution: UINT8 input, INT8 weights, int32 accumulation and per-channel requantisation.
+         * Expected inputs:
+         * x: 4D array, UINT8 or floating point (quantised on the fly with TArgs 0, 1)
+         * weights: 4D array [kH, kW, iC, oC], INT8
+         * weights scales: scalar or vector of length outputChannels
+         * weights zero points: scalar or vector of length outputChannels
+         * bias: optional vector, length of outputChannels
+         *
+         * T arguments:
+         * 0: x scale
+         * 1: x zero point
+         * 2: output scale, required for UINT8 output
+         * 3: output zero point, required for UINT8 output
+         *
+         * IntArgs:
+         * 0 - 9: same as conv2d
+         * 10: output type: 0 - dequantised floating point (default), 1 - UINT8
+         * 11: lower bound of integer grid for on-the-fly quantisation of x (default 0)
+         * 12: upper bound of integer grid for on-the-fly quantisation of x (default 255)
+         */
+        #if NOT_EXCLUDED(OP_qconv2d)
+        DECLARE_CUSTOM_OP(qconv2d, 4, 1, false, 2, 9);
+        #endif
+
         /**
          * Depthwise convolution2d op:
          * Expected inputs:
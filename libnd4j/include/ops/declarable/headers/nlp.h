@@ -32,6 +32,29 @@ namespace nd4j {
         #if NOT_EXCLUDED(OP_cbow)
         DECLARE_CONFIGURABLE_OP(cbow, 15, 15, true, 0, 0);
         #endif
+
+        /**
+         * Batched Hogwild training step for skipgram, cbow and subword (fastText) models.
+         *
+         * Input arrays:
+         *    0: inputs [numExamples, width] - syn0 rows averaged into hidden vector of each example, -1 for padding:
+         *       one row for skipgram, context window for cbow, word row followed by its n-gram rows for subwords
+         *    1: lockedRows [numExamples, width] - 1 for rows which aren't updated, or empty
+         *    2: positives [numExamples] - positive word for negative sampling, or empty
+         *    3: indices [numExamples, pathLength] - hierarchic softmax path, -1 for padding, or empty
+         *    4: codes [numExamples, pathLength] - hierarchic softmax codes, or empty
+         *    5: syn0, 6: syn1, 7: syn1Neg, 8: expTable, 9: negTable
+         *   10: alpha [numExamples] - learning rates
+         *   11: randomValue [numExamples] - rng seeds, negatives of each group are drawn with seed of its first example
+         *
+         * Int arguments:
+         *    0: number of threads
+         *    1: number of negative samples
+         *    2: optional, maximal group size, 16 by default. Consecutive examples sharing positive word and path form a group.
+         */
+        #if NOT_EXCLUDED(OP_word2vec_batch)
+        DECLARE_CONFIGURABLE_OP(word2vec_batch, 12, 12, true, 0, 0);
+        #endif
     }
 }
 
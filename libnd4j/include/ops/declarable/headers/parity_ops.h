@@ -1598,6 +1598,23 @@ namespace nd4j {
         #if NOT_EXCLUDED(OP_cholesky)
         DECLARE_OP(cholesky, 1, 1, true);
         #endif
+
+        /*
+         * triangular_solve op - solves systems with triangular matrices: matrix * output = rhs, for each pair of
+         * matrices when rank > 2. Only lower (or upper) triangle of matrix is used.
+         * input:
+         *     0 - matrices - tensor with shape (..., M, M) by float type
+         *     1 - rhs - tensor with shape (..., M, K), batch dimensions equal to ones of matrices
+         *
+         * bool params (optional):
+         *     0 - lower - matrices are lower triangular (default true)
+         *     1 - adjoint - solve system with transposed matrices instead (default false)
+         *
+         * output - tensor with the same shape as rhs
+         * */
+        #if NOT_EXCLUDED(OP_triangular_solve)
+        DECLARE_CUSTOM_OP(triangular_solve, 2, 1, false, 0, 0);
+        #endif
         /*
          * nth_element - apply nth_element for last dimension of input tensor
          * input array:
@@ -1629,6 +1646,65 @@ namespace nd4j {
         DECLARE_CONFIGURABLE_OP(fake_quant_with_min_max_vars, 3, 1, true, 0, -2);
         #endif
 
+        /**
+         * knn_search - exact k nearest neighbours search by brute force, distances are evaluated in blocks
+         * with reduce3 all-pairs kernels and merged into per-query top-k heaps on the fly
+         *
+         * input params:
+         *    0 - data [N, d]
+         *    1 - queries [Q, d]
+         *
+         * int params:
+         *    0 - k, number of neighbours
+         *    1 - metric, reduce3 op number (optional): 0 - Manhattan, 1 - Euclidean (default), 5 - Cosine distance
+         *
+         * output:
+         *    0 - indices of neighbours [Q, k] INT64, sorted by distance
+         *    1 - distances to neighbours [Q, k]
+         */
+        #if NOT_EXCLUDED(OP_knn_search)
+        DECLARE_CUSTOM_OP(knn_search, 2, 2, false, 0, 1);
+        #endif
+
+        /**
+         * vptree_build - builds vantage-point tree index for k nearest neighbours search
+         *
+         * input params:
+         *    0 - data [N, d]
+         *
+         * int params:
+         *    0 - metric, reduce3 op number (optional): 0 - Manhattan, 1 - Euclidean (default)
+         *
+         * output:
+         *    0 - nodes [N, 3] INT64: {point index, inner child, outer child}, -1 for absent child, root is node 0
+         *    1 - radii [N], median distance from node's point to the rest of its subtree
+         */
+        #if NOT_EXCLUDED(OP_vptree_build)
+        DECLARE_CUSTOM_OP(vptree_build, 1, 2, false, 0, 0);
+        #endif
+
+        /**
+         * vptree_search - k nearest neighbours search in vantage-point tree built by vptree_build
+         *
+         * input params:
+         *    0 - data [N, d], the same the tree was built over
+         *    1 - nodes [N, 3] INT64
+         *    2 - radii [N]
+         *    3 - queries [Q, d]
+         *
+         * int params:
+         *    0 - k, number of neighbours
+         *    1 - metric, must be the one tree was built with (optional, Euclidean by default)
+         *    2 - max number of visited nodes per query (optional): 0 means exact search (default), otherwise search is approximate
+         *
+         * output:
+         *    0 - indices of neighbours [Q, k] INT64, sorted by distance
+         *    1 - distances to neighbours [Q, k]
+         */
+        #if NOT_EXCLUDED(OP_vptree_search)
+        DECLARE_CUSTOM_OP(vptree_search, 4, 2, false, 0, 1);
+        #endif
+
     }
 }
 
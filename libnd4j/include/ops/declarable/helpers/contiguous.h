@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Helpers for ops working on raw buffers: contiguous copies of arrays, and accumulator types
+//
+
+#ifndef LIBND4J_HELPERS_CONTIGUOUS_H
+#define LIBND4J_HELPERS_CONTIGUOUS_H
+
+#include <op_boilerplate.h>
+#include <NDArray.h>
+#include <memory>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    /**
+     * Type values are accumulated in: float for float and half types, double for double
+     */
+    template <typename T>
+    struct AccumulatorOf { typedef float type; };
+
+    template <>
+    struct AccumulatorOf<double> { typedef double type; };
+
+    /**
+     * Returns c-ordered contiguous array: either given one, or its copy kept in copy
+     */
+    inline const NDArray& contiguous(const NDArray& array, std::unique_ptr<NDArray>& copy) {
+        if (array.ordering() == 'c' && array.ews() == 1)
+            return array;
+
+        copy.reset(const_cast<NDArray&>(array).dup('c'));
+        return *copy;
+    }
+
+    /**
+     * Returns c-ordered contiguous array to write results into: either given one, or temporary one kept in temp.
+     * In latter case caller assigns temp back to array
+     */
+    inline NDArray& contiguousOutput(NDArray& array, std::unique_ptr<NDArray>& temp) {
+        if (array.ordering() == 'c' && array.ews() == 1)
+            return array;
+
+        temp.reset(new NDArray('c', array.getShapeAsVector(), array.dataType(), array.getWorkspace()));
+        return *temp;
+    }
+
+}
+}
+}
+
+#endif //LIBND4J_HELPERS_CONTIGUOUS_H
@@ -23,6 +23,7 @@
 #include <ShapeUtils.h>
 #include <numeric>
 #include <ConstantTadHelper.h>
+#include <helpers/VectorMath.h>
 
 namespace nd4j    {
 namespace ops     {
@@ -48,11 +49,15 @@ static void softMaxForVector_(void *input, Nd4jLong *inShapeInfo, void *output,
             for (int i = 0; i < length; i++)
                 max = nd4j::math::nd4j_max<T>(max, inBuff[i]);
 
+            PRAGMA_OMP_SIMD
+            for (int i = 0; i < length; i++)
+                outBuff[i] = inBuff[i] - max;
+
+            nd4j::VectorMath::transform<T, nd4j::math::vec::Exp>(outBuff, outBuff, length, Environment::getInstance()->mathPrecision());
+
             PRAGMA_OMP_SIMD_SUM(sum)
-            for (int i = 0; i < length; i++) {
-                outBuff[i] = nd4j::math::nd4j_exp<T, T>(inBuff[i] - max);
+            for (int i = 0; i < length; i++)
                 sum += outBuff[i];
-            }
 
             PRAGMA_OMP_SIMD
             for (int i = 0; i < length; i++)
@@ -170,7 +175,9 @@ static void softmax_(const NDArray& input, NDArray& output, const int dimension)
         
         if(shape::elementWiseStride(tadShapeInfo) == 1){
 
-            PRAGMA_OMP_PARALLEL_FOR_SIMD
+            const auto precision = Environment::getInstance()->mathPrecision();
+
+            PRAGMA_OMP_PARALLEL_FOR
             for (uint i = 0; i < numOfSubArrs; ++i) {
 
                 T* inBuff  = input.bufferAsT<T>()  + tadOffsets[i];
@@ -182,11 +189,14 @@ static void softmax_(const NDArray& input, NDArray& output, const int dimension)
                 for(uint j = 0; j < tadLen; ++j)
                     max = nd4j::math::nd4j_max<T>(max, inBuff[j]);            
             
-                for (uint j = 0; j < tadLen; ++j) {
-                    T temp = nd4j::math::nd4j_exp<T,T>(inBuff[j] - max);
-                    outBuff[j] = temp;
-                    sum += temp;
-                }
+                for (uint j = 0; j < tadLen; ++j)
+                    outBuff[j] = inBuff[j] - max;
+
+                // exp is the only expensive part here, and it's vectorised along TAD
+                nd4j::VectorMath::transform<T, nd4j::math::vec::Exp>(outBuff, outBuff, tadLen, precision);
+
+                for (uint j = 0; j < tadLen; ++j)
+                    sum += outBuff[j];
             
                 for (uint j = 0; j < tadLen; ++j)
                     outBuff[j] /= sum;            
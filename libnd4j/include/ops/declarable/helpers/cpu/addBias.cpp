@@ -72,14 +72,20 @@ static void addBias_(NDArray& input, const NDArray& bias, const bool isNCHW) {
         oH = input.sizeAt(1);
         oW = input.sizeAt(2);
 
+        // bias offsets are the same for every [oC] vector, so evaluate them once and keep contiguous copy of bias
+        std::vector<X> biasVec(oC);
+        for (int c = 0; c < oC; ++c)
+            biasVec[c] = static_cast<X>(biasBuff[shape::indexOffset(c, bias.getShapeInfo(), biasShapeInfoCast, oC, canCastBias)]);
+        const X* b = biasVec.data();
+
         PRAGMA_OMP_PARALLEL_FOR
         for (int i = 0; i < bS*oH*oW; ++i) {
 
+            X* z = inBuff + i * oC;
+
             PRAGMA_OMP_SIMD
-            for (int c = 0; c < oC; ++c) {
-                auto biasOffset = shape::indexOffset(c, bias.getShapeInfo(), biasShapeInfoCast, oC, canCastBias);
-                inBuff[i * oC + c] += static_cast<X>(biasBuff[biasOffset]);
-            }                            
+            for (int c = 0; c < oC; ++c)
+                z[c] += b[c];
         }
     }        
 }
@@ -54,6 +54,36 @@ static void batchnorm_(const NDArray* input, const NDArray* mean, const NDArray*
 
     const Nd4jLong  lenBig        = input->lengthOf();
     const Nd4jLong  lenSmall      = mean->lengthOf();
+
+    // channels-last case (NHWC, NDHWC, [bS, C]): channel is the contiguous innermost dimension,
+    // so per-channel parameters are packed into plain vectors and used along simd lane
+    if(axes.size() == 1 && axes[0] == input->rankOf() - 1 && input->ordering() == 'c' && input->ews() == 1 && output->ordering() == 'c' && output->ews() == 1) {
+
+        const Nd4jLong numRows = lenBig / lenSmall;
+
+        std::vector<T> meanVec(lenSmall), sigmaVec(lenSmall), betaVec(lenSmall, static_cast<T>(0.f));
+        for (Nd4jLong c = 0; c < lenSmall; ++c) {
+            meanVec[c]  = mean->e<T>(c);
+            sigmaVec[c] = sigmaInvGam.e<T>(c);
+            if(beta != nullptr)
+                betaVec[c] = beta->e<T>(c);
+        }
+
+        const T* m = meanVec.data();
+        const T* s = sigmaVec.data();
+        const T* b = betaVec.data();
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(lenBig > Environment::getInstance()->elementwiseThreshold())
+        for (Nd4jLong r = 0; r < numRows; ++r) {
+            const T* x = inBuff  + r * lenSmall;
+                  T* z = outBuff + r * lenSmall;
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong c = 0; c < lenSmall; ++c)
+                z[c] = (x[c] - m[c]) * s[c] + b[c];
+        }
+        return;
+    }
     const Nd4jLong* inShapeInfo   = input->getShapeInfo();
     const Nd4jLong* meanShapeInfo = mean->getShapeInfo();
 
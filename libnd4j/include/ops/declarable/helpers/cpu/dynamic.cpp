@@ -18,6 +18,7 @@
 // Created by george on 05.04.18.
 //
 #include <ops/declarable/helpers/dynamic.h>
+#include <array/TadSet.h>
 
 namespace nd4j {
     namespace ops {
@@ -34,7 +35,7 @@ namespace nd4j {
                     for (int i = sourceDimsLen; i > 0; i--)
                         sourceDims[sourceDimsLen - i] = input->rankOf() - i;
 
-                    std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(sourceDims));
+                    TadSet listOfTensors(*input, sourceDims);
 
                     unsigned int outSize = outputList.size();
 
@@ -49,15 +50,14 @@ namespace nd4j {
                         for (int k = 1; k < r; k++)
                             outDims[k - 1] = k;
 
-                        std::unique_ptr<ResultSet> listOutForCurrent(
-                                outputs[i].first->allTensorsAlongDimension(outDims));
+                        TadSet listOutForCurrent(*outputs[i].first, outDims);
 
                         outputs[i].second = 0;
 
                         PRAGMA_OMP_PARALLEL_FOR_IF(indices->lengthOf() > Environment::getInstance()->elementwiseThreshold())
                         for (int e = 0; e < indices->lengthOf(); ++e)
                             if ((*indices).e<Nd4jLong>(e) == i)
-                                listOutForCurrent->at(outputs[i].second++)->assign(listOfTensors->at(e));
+                                listOutForCurrent.at(outputs[i].second++).assign(listOfTensors.at(e));
                     }
 
                 } else {
@@ -102,7 +102,7 @@ namespace nd4j {
                     for (int i = restDims.size(); i > 0;  i--)
                         restDims[restDims.size() - i] = output->rankOf() - i;
 
-                    std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+                    TadSet listOfOutTensors(*output, restDims);
 
                     for (int e = 0; e < numOfData; e++) {
                         auto data = inputs[e];
@@ -111,7 +111,7 @@ namespace nd4j {
                         for (int i = sourceDims.size(); i > 0;  i--)
                             sourceDims[sourceDims.size() - i] = data->rankOf() - i;
 
-                        std::unique_ptr<ResultSet> listOfTensors(data->allTensorsAlongDimension(sourceDims));
+                        TadSet listOfTensors(*data, sourceDims);
 
                         for (int i = 0; i < index->lengthOf(); i++) {
                             auto pos = index->e<Nd4jLong>(i);
@@ -125,7 +125,7 @@ namespace nd4j {
                                 return ND4J_STATUS_VALIDATION;
                             }
 
-                            listOfOutTensors->at(pos)->assign(listOfTensors->at(i));
+                            listOfOutTensors.at(pos).assign(listOfTensors.at(i));
                         }
                     }
                 }
@@ -143,7 +143,7 @@ namespace nd4j {
                     for (int i = sourceDimsLen; i > 0; i--)
                         sourceDims[sourceDimsLen - i] = input->rankOf() - i;
 
-                    std::unique_ptr<ResultSet> listOfTensors(outputList[0]->allTensorsAlongDimension(sourceDims));
+                    TadSet listOfTensors(*outputList[0], sourceDims);
 
                     for (unsigned int i = 0; i < inputGradientList.size(); i++) {
                         outputs[i].first = inputGradientList[i];
@@ -153,14 +153,13 @@ namespace nd4j {
                         for (int k = 1; k < outputs[i].first->rankOf(); k++)
                             outDims[k - 1] = k;
 
-                        std::unique_ptr<ResultSet> listOutForCurrent(
-                                outputs[i].first->allTensorsAlongDimension(outDims));
+                        TadSet listOutForCurrent(*outputs[i].first, outDims);
 
                         outputs[i].second = 0;
 
                         for (int e = 0; e < indices->lengthOf(); ++e)
                             if (indices->e<Nd4jLong>(e) == i)
-                                listOfTensors->at(e)->assign(listOutForCurrent->at(outputs[i].second++));
+                                listOfTensors.at(e).assign(listOutForCurrent.at(outputs[i].second++));
                     }
                 }
                 else { // one-dimensional case
@@ -28,6 +28,7 @@
 #include <ops/declarable/CustomOperations.h>
 #include<ops/declarable/helpers/transforms.h>
 #include <MmulHelper.h>
+#include <array/NDArrayExpression.h>
 
 namespace nd4j 	  {
 namespace ops 	  {
@@ -39,19 +40,11 @@ static FORCEINLINE NDArray sigmoid(const NDArray& arr) {
     return (const_cast<NDArray&>(arr)).transform(transform::Sigmoid);
 }
 
-static FORCEINLINE void sigmoidInplace(const NDArray& arr) {
-    (const_cast<NDArray&>(arr)).applyTransform(transform::Sigmoid);
-}
-
 //////////////////////////////////////////////////////////////////////////
 static FORCEINLINE NDArray tanh(const NDArray& arr) {
     return (const_cast<NDArray&>(arr)).transform(transform::Tanh);
 }
 
-static FORCEINLINE void tanhInplace(const NDArray& arr) {
-    (const_cast<NDArray&>(arr)).applyTransform(transform::Tanh);
-}
-
 //////////////////////////////////////////////////////////////////////////
 void gruCell(const NDArray* x, const NDArray* hLast, const NDArray* Wru, const NDArray* Wc,
              const NDArray* bru, const NDArray* bc,
@@ -87,10 +80,10 @@ void gruCell(const NDArray* x, const NDArray* hLast, const NDArray* Wru, const N
     auto concatOut = result->at(0);
 
     //mmul/z for reset and update gates: (x * weight_ux + hLast * weight_xr + b_u)
-    auto m = mmul(*concatOut, *Wru);    //mmul: [bs, (nIn+numUnits)]* [(inSize+numUnits), 2*numUnits] = [bs, 4*numUnits]
-    m += (*bru);
+    using namespace nd4j::expr;
 
-    sigmoidInplace(m);  //sigmoid(rz) and sigmoid(uz)
+    auto m = mmul(*concatOut, *Wru);    //mmul: [bs, (nIn+numUnits)]* [(inSize+numUnits), 2*numUnits] = [bs, 4*numUnits]
+    expr::assign(m, sigmoid(lazy(m) + *bru));  //sigmoid(rz) and sigmoid(uz)
     auto mr = m({0,0, 0, nU});
     auto mu = m({0,0, nU, 2*nU});
 
@@ -103,15 +96,10 @@ void gruCell(const NDArray* x, const NDArray* hLast, const NDArray* Wru, const N
 
     //c = tanh(x * weight_cx + (hLast .* r) * weight_cr + b_c)
     MmulHelper::mmul(concatOut, const_cast<NDArray*>(Wc), c, 1.0, 0.0);       //c = 1.0 * concatOut * Wc + 0.0 * c
-    *c += *bc;
-    tanhInplace(*c);
+    expr::assign(*c, tanh(lazy(*c) + *bc));
 
     //Output: h = (1-u).*c + u .* hPrev
-    //auto hResult = (*u) * (*hLast) + (1.0f - *u) * (*c); const_cast<NDArray*>(h)->assign(&hResult);
-    u->applyPairwiseTransform(pairwise::Multiply, hLast, h, nullptr);        //h = u * hLast
-    auto temp = (1.0f - *u);
-    temp *= (*c);
-    (*h) += temp;
+    expr::assign(*h, lazy(*u) * (*hLast) + (1.0f - lazy(*u)) * (*c));
 
     delete result;
 }
@@ -164,18 +152,23 @@ void gruCellBP(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDA
 
 // h is current cell output [bS, nU], that is at current time step t
 
+using namespace nd4j::expr;
+
+const int bS = h0->sizeAt(0);
 const int nU = h0->sizeAt(1);
+const auto dtype = h0->dataType();
+const auto workspace = h0->getWorkspace();
 
 // ***** feed forward step ***** //
 // gates = sigmoid(x*Wx + h0*Wh + b)
-auto gates = sigmoid(mmul(*x, (*Wx)({0,0, 0,2*nU})) + mmul(*h0, (*Wh)({0,0, 0,2*nU})) + (*b)({0,2*nU}));       // [bS, 2*nU] + [bS, 2*nU] + [1, 2*nU] = [bS, 2*nU]
+auto gates = expr::evaluate(sigmoid(lazy(mmul(*x, (*Wx)({0,0, 0,2*nU}))) + mmul(*h0, (*Wh)({0,0, 0,2*nU})) + (*b)({0,2*nU})), {bS, 2*nU}, dtype, workspace);       // [bS, 2*nU] + [bS, 2*nU] + [1, 2*nU] = [bS, 2*nU]
 // reset gate
 auto r = gates({0,0, 0, nU});               // [bS, nU]
 // update gate
 auto u = gates({0,0, nU, 2*nU});            // [bS, nU]
 // ◦ means element-wise product or so called Hadamard product
 // n = tanh(x*Wx + (r◦h0)*Wh + b)
-auto n = tanh(mmul(*x, (*Wx)({0,0, 2*nU,3*nU})) + mmul((*h0)*r, (*Wh)({0,0, 2*nU,3*nU})) + (*b)({2*nU,3*nU}));     // [bS, nU]
+auto n = expr::evaluate(tanh(lazy(mmul(*x, (*Wx)({0,0, 2*nU,3*nU}))) + mmul((*h0)*r, (*Wh)({0,0, 2*nU,3*nU})) + (*b)({2*nU,3*nU})), {bS, nU}, dtype, workspace);     // [bS, nU]
 
 // ***** back prop step ***** //
 auto Wxr  = (*Wx)({0,0, 0,   nU});
@@ -205,33 +198,35 @@ auto dLdbr = (*dLdb)({0,     nU});
 auto dLdbu = (*dLdb)({nU,  2*nU});
 auto dLdbn = (*dLdb)({2*nU,3*nU});
 
-auto dhdu   = *h0  - n;              // [bS, nU]
-auto dhdn   = 1.f - u;               // [bS, nU]
-auto dSigdu = u * (1.f - u);         // [bS, nU]
-auto dSigdr = r * (1.f - r);         // [bS, nU]
-auto dActdn = 1.f - n * n;           // [bS, nU]
+// dhdu = h0 - n, dhdn = 1 - u, dSigdu = u*(1-u), dSigdr = r*(1-r), dActdn = 1 - n*n, all [bS, nU]
+// element-wise chains are fused, so only products consumed by mmul/reduce get materialised
+auto dSigdr = expr::evaluate(lazy(r) * (1.f - lazy(r)), {bS, nU}, dtype, workspace);            // [bS, nU]
+auto dActdn = expr::evaluate(1.f - lazy(n) * n, {bS, nU}, dtype, workspace);                    // [bS, nU]
 auto dndr   = mmul(dActdn * (*h0), WhnT);
 auto drdh0  = mmul(dSigdr, WhrT);
 
-auto dLdn = (*dLdh) * dhdn;
-auto dLdu = (*dLdh) * dhdu;
-auto dLdr = dLdn * dndr;
+auto dLdn = expr::evaluate(lazy(*dLdh) * (1.f - lazy(u)), {bS, nU}, dtype, workspace);          // dLdh * dhdn
+auto dLdu = expr::evaluate(lazy(*dLdh) * (lazy(*h0) - n), {bS, nU}, dtype, workspace);          // dLdh * dhdu
+
+auto dLdrSig = expr::evaluate(lazy(dLdn) * dndr * dSigdr, {bS, nU}, dtype, workspace);          // dLdr * dSigdr
+auto dLduSig = expr::evaluate(lazy(dLdu) * (lazy(u) * (1.f - lazy(u))), {bS, nU}, dtype, workspace);     // dLdu * dSigdu
+auto dLdnAct = expr::evaluate(lazy(dLdn) * dActdn, {bS, nU}, dtype, workspace);                 // dLdn * dActdn
 
-dLdx->assign( mmul(dLdu * dSigdu, WxuT) + mmul(dLdr * dSigdr, WxrT) + mmul(dLdn * dActdn, WxnT) );      // [bS,iS]
-dLdh0->assign( mmul(dLdu * dSigdu, WhuT) + mmul(dLdn * dActdn * (r + drdh0), WhnT) + (*dLdh)*u );       // [bS,nU]
+dLdx->assign( mmul(dLduSig, WxuT) + mmul(dLdrSig, WxrT) + mmul(dLdnAct, WxnT) );      // [bS,iS]
+dLdh0->assign( mmul(dLduSig, WhuT) + mmul(expr::evaluate(lazy(dLdnAct) * (lazy(r) + drdh0), {bS, nU}, dtype, workspace), WhnT) + (*dLdh)*u );       // [bS,nU]
 
-dLdWxr.assign( mmul(xT, dSigdr * dLdr) );                                                               //  [iS,nU]
-dLdWhr.assign( mmul(h0T, dSigdr * dLdr) );                                                              //  [nU,nU]
+dLdWxr.assign( mmul(xT, dLdrSig) );                                                               //  [iS,nU]
+dLdWhr.assign( mmul(h0T, dLdrSig) );                                                              //  [nU,nU]
 
-dLdWxu.assign( mmul(xT, dSigdu * dLdu) );                                                               //  [iS,nU]
-dLdWhu.assign( mmul(h0T, dSigdu * dLdu) );                                                              //  [nU,nU]
+dLdWxu.assign( mmul(xT, dLduSig) );                                                               //  [iS,nU]
+dLdWhu.assign( mmul(h0T, dLduSig) );                                                              //  [nU,nU]
 
-dLdWxn.assign( mmul(xT, dActdn * dLdn) );                                                               //  [iS,nU]
-dLdWhn.assign( mmul((r*(*h0)).transp(), dActdn * dLdn) );                                               //  [nU,nU]
+dLdWxn.assign( mmul(xT, dLdnAct) );                                                               //  [iS,nU]
+dLdWhn.assign( mmul((r*(*h0)).transp(), dLdnAct) );                                               //  [nU,nU]
 
-dLdbr.assign( (dSigdr * dLdr).reduceAlongDims(reduce::Sum, {0}));                          // [nU]
-dLdbu.assign( (dSigdu * dLdu).reduceAlongDims(reduce::Sum, {0}));                          // [nU]
-dLdbn.assign( (dActdn * dLdn).reduceAlongDims(reduce::Sum, {0}));                          // [nU]
+dLdbr.assign( dLdrSig.reduceAlongDims(reduce::Sum, {0}));                          // [nU]
+dLdbu.assign( dLduSig.reduceAlongDims(reduce::Sum, {0}));                          // [nU]
+dLdbn.assign( dLdnAct.reduceAlongDims(reduce::Sum, {0}));                          // [nU]
 
 if(dLdWx0 != nullptr)
     *dLdWx += *dLdWx0;
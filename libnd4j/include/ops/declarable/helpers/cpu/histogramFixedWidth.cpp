@@ -19,6 +19,8 @@
 //
 
 #include <ops/declarable/helpers/histogramFixedWidth.h>
+#include <OmpLaunchHelper.h>
+#include <vector>
 
 namespace nd4j {
 namespace ops {
@@ -30,12 +32,6 @@ void histogramFixedWidth_(const NDArray& input, const NDArray& range, NDArray& o
 
      const int nbins = output.lengthOf();
 
-    // firstly initialize output with zeros 
-    if(output.ews() == 1)
-        memset(output.buffer(), 0, nbins * output.sizeOfT());
-    else
-        output = 0;
-
     const T leftEdge  = range.e<double>(0);
     const T rightEdge = range.e<double>(1);
 
@@ -43,33 +39,40 @@ void histogramFixedWidth_(const NDArray& input, const NDArray& range, NDArray& o
     const T secondEdge     = leftEdge + binWidth;
     const T lastButOneEdge = rightEdge - binWidth;
 
-    Nd4jLong inputLength = input.lengthOf();
+    const Nd4jLong inputLength = input.lengthOf();
+
+    // every block of input is counted into its own histogram, these are summed up at the end, so threads never contend for bins
+    const int numBlocks = OmpLaunchHelper::betterThreads(inputLength);
+    const Nd4jLong span = OmpLaunchHelper::betterSpan(inputLength, numBlocks);
+    std::vector<Nd4jLong> bins(numBlocks * nbins, 0);
 
-    PRAGMA_OMP_PARALLEL_FOR
-    for(Nd4jLong i = 0; i < inputLength; ++i) {
+    PRAGMA_OMP_PARALLEL_FOR_THREADS(numBlocks)
+    for (int b = 0; b < numBlocks; ++b) {
 
-        const T value = input.e<T>(i);
+        auto blockBins = bins.data() + b * nbins;
+        const Nd4jLong stop = nd4j::math::nd4j_min<Nd4jLong>(inputLength, (b + 1) * span);
 
-        if(value < secondEdge) {
+        for(Nd4jLong i = b * span; i < stop; ++i) {
 
-            PRAGMA_OMP_CRITICAL
-            {
-                output.p<Nd4jLong>(0, output.e<Nd4jLong>(0) + 1);
-            }
-        } else if(value >= lastButOneEdge) {
-            PRAGMA_OMP_CRITICAL
-            {
-                output.p<Nd4jLong>(nbins - 1, output.e<Nd4jLong>(nbins - 1) + 1);
-            }
-        } else {
-            Nd4jLong currInd = static_cast<Nd4jLong>((value - leftEdge) / binWidth);
+            const T value = input.e<T>(i);
 
-            PRAGMA_OMP_CRITICAL
-            {
-                output.p<Nd4jLong>(currInd, output.e<Nd4jLong>(currInd) + 1);
-            }
+            if(value < secondEdge)
+                blockBins[0]++;
+            else if(value >= lastButOneEdge)
+                blockBins[nbins - 1]++;
+            else
+                blockBins[static_cast<Nd4jLong>((value - leftEdge) / binWidth)]++;
         }
     }
+
+    for(int j = 0; j < nbins; ++j) {
+
+        Nd4jLong count = 0;
+        for (int b = 0; b < numBlocks; ++b)
+            count += bins[b * nbins + j];
+
+        output.p<Nd4jLong>(j, count);
+    }
 }
 
 void histogramFixedWidth(const NDArray& input, const NDArray& range, NDArray& output) {
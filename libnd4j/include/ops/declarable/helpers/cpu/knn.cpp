@@ -0,0 +1,352 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// k nearest neighbours search, see helpers/knn.h
+//
+
+#include <ops/declarable/helpers/knn.h>
+#include <ops/declarable/helpers/contiguous.h>
+#include <array/DataTypeUtils.h>
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    template <typename T>
+    static FORCEINLINE typename AccumulatorOf<T>::type distance(const T* a, const T* b, Nd4jLong length, int metric) {
+        typedef typename AccumulatorOf<T>::type A;
+        A sum = static_cast<A>(0.f);
+
+        if (metric == nd4j::reduce3::ManhattanDistance) {
+            PRAGMA_OMP_SIMD_ARGS(reduction(+:sum))
+            for (Nd4jLong e = 0; e < length; e++)
+                sum += nd4j::math::nd4j_abs<A>(static_cast<A>(a[e]) - static_cast<A>(b[e]));
+            return sum;
+        }
+
+        PRAGMA_OMP_SIMD_ARGS(reduction(+:sum))
+        for (Nd4jLong e = 0; e < length; e++) {
+            const A diff = static_cast<A>(a[e]) - static_cast<A>(b[e]);
+            sum += diff * diff;
+        }
+        return nd4j::math::nd4j_sqrt<A, A>(sum);
+    }
+
+    // bounded max-heap of (distance, index) pairs: keeps k smallest ones seen so far
+    template <typename T>
+    class NeighboursHeap {
+    private:
+        std::vector<std::pair<T, Nd4jLong>> _heap;
+        size_t _k;
+
+    public:
+        explicit NeighboursHeap(int k) : _k(k) {
+            _heap.reserve(k);
+        }
+
+        bool full() const {
+            return _heap.size() == _k;
+        }
+
+        // distance of the farthest of current k neighbours
+        T bound() const {
+            return _heap.front().first;
+        }
+
+        void push(T dist, Nd4jLong index) {
+            // NaN (i.e. cosine distance to zero vector) would break heap ordering
+            if (dist != dist)
+                dist = DataTypeUtils::max<T>();
+
+            const std::pair<T, Nd4jLong> item(dist, index);
+            if (_heap.size() < _k) {
+                _heap.push_back(item);
+                std::push_heap(_heap.begin(), _heap.end());
+            }
+            else if (item < _heap.front()) {
+                std::pop_heap(_heap.begin(), _heap.end());
+                _heap.back() = item;
+                std::push_heap(_heap.begin(), _heap.end());
+            }
+        }
+
+        void write(NDArray& indices, NDArray& distances, Nd4jLong row) {
+            std::sort_heap(_heap.begin(), _heap.end());
+            for (size_t e = 0; e < _heap.size(); e++) {
+                indices.p(row * _k + e, _heap[e].second);
+                distances.p(row * _k + e, _heap[e].first);
+            }
+        }
+    };
+
+//////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    static void knnBruteForce_(const NDArray& data, const NDArray& queries, int k, int metric, NDArray& indices, NDArray& distances) {
+        std::unique_ptr<NDArray> dataCopy, queriesCopy;
+        const NDArray& x = contiguous(data, dataCopy);
+        const NDArray& q = contiguous(queries, queriesCopy);
+
+        const Nd4jLong numPoints = x.sizeAt(0);
+        const Nd4jLong numQueries = q.sizeAt(0);
+
+        // tiles of distances are [blockQ, blockN]: large enough for blocked reduce3 kernels, small enough to stay in L3
+        const Nd4jLong blockQ = nd4j::math::nd4j_min<Nd4jLong>(numQueries, 256);
+        const Nd4jLong blockN = nd4j::math::nd4j_min<Nd4jLong>(numPoints, 8192);
+
+        std::vector<NeighboursHeap<T>> heaps(numQueries, NeighboursHeap<T>(k));
+
+        for (Nd4jLong q0 = 0; q0 < numQueries; q0 += blockQ) {
+            const Nd4jLong q1 = nd4j::math::nd4j_min<Nd4jLong>(numQueries, q0 + blockQ);
+            auto queriesBlock = q({q0, q1,  0, 0});
+
+            for (Nd4jLong n0 = 0; n0 < numPoints; n0 += blockN) {
+                const Nd4jLong n1 = nd4j::math::nd4j_min<Nd4jLong>(numPoints, n0 + blockN);
+                auto pointsBlock = x({n0, n1,  0, 0});
+
+                std::unique_ptr<NDArray> tile(queriesBlock.applyAllReduce3(static_cast<nd4j::reduce3::Ops>(metric), &pointsBlock, {1}));
+                auto tileBuffer = reinterpret_cast<T*>(tile->buffer());
+                const Nd4jLong width = n1 - n0;
+
+                PRAGMA_OMP_PARALLEL_FOR_IF(q1 - q0 > 1)
+                for (Nd4jLong r = 0; r < q1 - q0; r++) {
+                    auto& heap = heaps[q0 + r];
+                    for (Nd4jLong j = 0; j < width; j++)
+                        heap.push(tileBuffer[r * width + j], n0 + j);
+                }
+            }
+        }
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numQueries > 1)
+        for (Nd4jLong r = 0; r < numQueries; r++)
+            heaps[r].write(indices, distances, r);
+    }
+
+    void knnBruteForce(const NDArray& data, const NDArray& queries, int k, int metric, NDArray& indices, NDArray& distances) {
+        BUILD_SINGLE_SELECTOR(data.dataType(), knnBruteForce_, (data, queries, k, metric, indices, distances), FLOAT_TYPES);
+    }
+
+//////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    static void vpTreeBuild_(const NDArray& data, int metric, NDArray& nodes, NDArray& radii) {
+        typedef typename AccumulatorOf<T>::type A;
+
+        std::unique_ptr<NDArray> dataCopy;
+        const NDArray& x = contiguous(data, dataCopy);
+
+        const Nd4jLong numPoints = x.sizeAt(0);
+        const Nd4jLong dims = x.sizeAt(1);
+        auto points = reinterpret_cast<const T*>(x.getBuffer());
+
+        // node n lives at position n of items: its subtree occupies [n, end), inner child starts at n + 1
+        std::vector<std::pair<A, Nd4jLong>> items(numPoints);
+        for (Nd4jLong e = 0; e < numPoints; e++)
+            items[e] = std::make_pair(static_cast<A>(0.f), e);
+
+        std::vector<Nd4jLong> tree(numPoints * 3, -1);
+        std::vector<T> radius(numPoints, static_cast<T>(0.f));
+
+        std::vector<std::pair<Nd4jLong, Nd4jLong>> ranges;
+        ranges.push_back(std::make_pair(0, numPoints));
+
+        while (!ranges.empty()) {
+            const Nd4jLong lo = ranges.back().first;
+            const Nd4jLong hi = ranges.back().second;
+            ranges.pop_back();
+
+            // vantage point is picked pseudo-randomly, but deterministically
+            const Nd4jLong pick = lo + static_cast<Nd4jLong>((static_cast<uint64_t>(lo) * 2654435761ULL + static_cast<uint64_t>(hi)) % static_cast<uint64_t>(hi - lo));
+            std::swap(items[lo], items[pick]);
+
+            if (hi - lo == 1)
+                continue;
+
+            const T* vantage = points + items[lo].second * dims;
+
+            PRAGMA_OMP_PARALLEL_FOR_IF(hi - lo > 4096)
+            for (Nd4jLong e = lo + 1; e < hi; e++)
+                items[e].first = distance<T>(vantage, points + items[e].second * dims, dims, metric);
+
+            // inner subtree: [lo + 1, mid), outer subtree: [mid, hi)
+            const Nd4jLong mid = (lo + 1 + hi) / 2;
+            std::nth_element(items.begin() + lo + 1, items.begin() + mid, items.begin() + hi);
+            radius[lo] = static_cast<T>(items[mid].first);
+
+            if (mid > lo + 1) {
+                tree[lo * 3 + 1] = lo + 1;
+                ranges.push_back(std::make_pair(lo + 1, mid));
+            }
+            tree[lo * 3 + 2] = mid;
+            ranges.push_back(std::make_pair(mid, hi));
+        }
+
+        for (Nd4jLong n = 0; n < numPoints; n++) {
+            tree[n * 3] = items[n].second;
+            for (int e = 0; e < 3; e++)
+                nodes.p(n * 3 + e, tree[n * 3 + e]);
+            radii.p(n, radius[n]);
+        }
+    }
+
+    void vpTreeBuild(const NDArray& data, int metric, NDArray& nodes, NDArray& radii) {
+        BUILD_SINGLE_SELECTOR(data.dataType(), vpTreeBuild_, (data, metric, nodes, radii), FLOAT_TYPES);
+    }
+
+//////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    static void vpTreeSearch_(const NDArray& data, const NDArray& nodes, const NDArray& radii, const NDArray& queries, int k, int metric, Nd4jLong maxVisits, NDArray& indices, NDArray& distances) {
+        typedef typename AccumulatorOf<T>::type A;
+
+        std::unique_ptr<NDArray> dataCopy, queriesCopy, nodesCopy, radiiCopy;
+        const NDArray& x = contiguous(data, dataCopy);
+        const NDArray& q = contiguous(queries, queriesCopy);
+        const NDArray& n = contiguous(nodes, nodesCopy);
+        const NDArray& r = contiguous(radii, radiiCopy);
+
+        const Nd4jLong numQueries = q.sizeAt(0);
+        const Nd4jLong dims = x.sizeAt(1);
+        auto points = reinterpret_cast<const T*>(x.getBuffer());
+        auto queryPoints = reinterpret_cast<const T*>(q.getBuffer());
+        auto tree = reinterpret_cast<const Nd4jLong*>(n.getBuffer());
+        auto radius = reinterpret_cast<const T*>(r.getBuffer());
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numQueries > 1)
+        for (Nd4jLong i = 0; i < numQueries; i++) {
+            const T* query = queryPoints + i * dims;
+            NeighboursHeap<T> heap(k);
+
+            // pending subtrees with lower bounds of distances from query to their points
+            std::vector<std::pair<Nd4jLong, A>> pending;
+            pending.push_back(std::make_pair(0, static_cast<A>(0.f)));
+            Nd4jLong visits = 0;
+
+            while (!pending.empty()) {
+                const Nd4jLong node = pending.back().first;
+                const A bound = pending.back().second;
+                pending.pop_back();
+
+                if (heap.full() && bound > static_cast<A>(heap.bound()))
+                    continue;
+                if (maxVisits > 0 && visits >= maxVisits)
+                    break;
+
+                const Nd4jLong point = tree[node * 3];
+                const A dist = distance<T>(query, points + point * dims, dims, metric);
+                visits++;
+                heap.push(static_cast<T>(dist), point);
+
+                // triangle inequality: inner points are at least dist - mu away, outer ones at least mu - dist
+                const A mu = static_cast<A>(radius[node]);
+                const Nd4jLong inner = tree[node * 3 + 1];
+                const Nd4jLong outer = tree[node * 3 + 2];
+                const A innerBound = nd4j::math::nd4j_max<A>(bound, dist - mu);
+                const A outerBound = nd4j::math::nd4j_max<A>(bound, mu - dist);
+
+                // nearer side goes last, so it's explored first
+                if (dist < mu) {
+                    if (outer >= 0)
+                        pending.push_back(std::make_pair(outer, outerBound));
+                    if (inner >= 0)
+                        pending.push_back(std::make_pair(inner, innerBound));
+                } else {
+                    if (inner >= 0)
+                        pending.push_back(std::make_pair(inner, innerBound));
+                    if (outer >= 0)
+                        pending.push_back(std::make_pair(outer, outerBound));
+                }
+            }
+
+            heap.write(indices, distances, i);
+        }
+    }
+
+    void vpTreeSearch(const NDArray& data, const NDArray& nodes, const NDArray& radii, const NDArray& queries, int k, int metric, Nd4jLong maxVisits, NDArray& indices, NDArray& distances) {
+        BUILD_SINGLE_SELECTOR(data.dataType(), vpTreeSearch_, (data, nodes, radii, queries, k, metric, maxVisits, indices, distances), FLOAT_TYPES);
+    }
+
+//////////////////////////////////////////////////////////////////////////
+    static FORCEINLINE Nd4jLong alignTo64(Nd4jLong offset) {
+        return (offset + 63) / 64 * 64;
+    }
+
+    static VPTreeFileLayout vpTreeLayout(Nd4jLong numPoints, Nd4jLong dims, int metric, nd4j::DataType dataType) {
+        VPTreeFileLayout layout;
+        layout.numPoints = numPoints;
+        layout.dims = dims;
+        layout.metric = metric;
+        layout.dataType = dataType;
+
+        const Nd4jLong sizeOfT = DataTypeUtils::sizeOfElement(dataType);
+        layout.dataOffset = 64;
+        layout.nodesOffset = alignTo64(layout.dataOffset + numPoints * dims * sizeOfT);
+        layout.radiiOffset = alignTo64(layout.nodesOffset + numPoints * 3 * sizeof(Nd4jLong));
+        layout.fileLength = layout.radiiOffset + numPoints * sizeOfT;
+
+        return layout;
+    }
+
+    VPTreeFileLayout vpTreeFileLayout(const void* vheader) {
+        auto header = reinterpret_cast<const Nd4jLong*>(vheader);
+
+        if (header[0] != VPTREE_FILE_MAGIC)
+            throw std::runtime_error("vpTreeFileLayout: not a VP-tree file");
+        if (header[1] != VPTREE_FILE_VERSION)
+            throw std::runtime_error("vpTreeFileLayout: unsupported VP-tree file version");
+
+        return vpTreeLayout(header[2], header[3], static_cast<int>(header[4]), static_cast<nd4j::DataType>(header[5]));
+    }
+
+    // writes section of file at given offset, padding it with zeros from current position
+    static void writeSection(std::ofstream& stream, Nd4jLong offset, const NDArray& array) {
+        std::unique_ptr<NDArray> copy;
+        const NDArray& contiguousArray = contiguous(array, copy);
+
+        const Nd4jLong position = static_cast<Nd4jLong>(stream.tellp());
+        const std::vector<char> padding(offset - position, 0);
+        if (!padding.empty())
+            stream.write(padding.data(), padding.size());
+
+        stream.write(reinterpret_cast<const char*>(contiguousArray.getBuffer()), contiguousArray.lengthOf() * contiguousArray.sizeOfT());
+    }
+
+    void vpTreeWrite(const std::string& fileName, const NDArray& data, const NDArray& nodes, const NDArray& radii, int metric) {
+        if (nodes.dataType() != nd4j::DataType::INT64 || radii.dataType() != data.dataType())
+            throw std::runtime_error("vpTreeWrite: nodes must be INT64 and radii must have the same data type as data");
+
+        const auto layout = vpTreeLayout(data.sizeAt(0), data.sizeAt(1), metric, data.dataType());
+        const Nd4jLong header[8] = {VPTREE_FILE_MAGIC, VPTREE_FILE_VERSION, layout.numPoints, layout.dims, layout.metric, static_cast<Nd4jLong>(layout.dataType), 0, 0};
+
+        std::ofstream stream(fileName, std::ios::binary | std::ios::out | std::ios::trunc);
+        if (!stream.good())
+            throw std::runtime_error("vpTreeWrite: can't open file " + fileName);
+
+        stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+        writeSection(stream, layout.dataOffset, data);
+        writeSection(stream, layout.nodesOffset, nodes);
+        writeSection(stream, layout.radiiOffset, radii);
+
+        if (!stream.good())
+            throw std::runtime_error("vpTreeWrite: failed to write file " + fileName);
+    }
+
+}
+}
+}
@@ -100,7 +100,7 @@ static int lrnFunctor_(nd4j::graph::Context& block, NDArray* input, NDArray* out
             auto user_dst_memory = mkldnn::memory({user_dst_md, engine}, output->buffer());
 
             auto lrn_src_memory = user_src_memory;
-            streams[0].addMemory(user_src_memory);
+            streams[0].addMemory(user_src_memory, input);
             if (mkldnn::memory::primitive_desc(lrn_prim_desc.src_primitive_desc())
                     != user_src_memory.get_primitive_desc()) {
                 lrn_src_memory = mkldnn::memory(lrn_prim_desc.src_primitive_desc());
@@ -109,7 +109,7 @@ static int lrnFunctor_(nd4j::graph::Context& block, NDArray* input, NDArray* out
             }
 
             auto lrn_dst_memory = user_dst_memory;
-            streams[0].addMemory(user_dst_memory);
+            streams[0].addMemory(user_dst_memory, output);
             if (mkldnn::memory::primitive_desc(lrn_prim_desc.dst_primitive_desc())
                     != user_dst_memory.get_primitive_desc()) {
                 lrn_dst_memory = mkldnn::memory(lrn_prim_desc.dst_primitive_desc());
@@ -156,7 +156,42 @@ static int lrnFunctor_(nd4j::graph::Context& block, NDArray* input, NDArray* out
     const T tbeta  = static_cast<T>(beta);
     const T talpha = static_cast<T>(alpha);    
 
-    if(inTadEws == 1 && outTadEws == 1) {
+    if(inTadEws == 1 && outTadEws == 1 && depth < 8) {
+
+        // channels-last windowed kernel: squared sums are accumulated over 2*depth+1 shifted copies of channel vector,
+        // each shift is a plain simd loop over channels, so there is no loop-carried dependency as in running sum below
+        PRAGMA_OMP_PARALLEL
+        {
+            const auto threadNum  = omp_get_thread_num();
+            const auto numThreads = omp_get_num_threads();
+            std::vector<T> sum(tadLen);
+            T* sq = sum.data();
+
+            for (Nd4jLong i = threadNum; i < numOfTads; i += numThreads) {
+                const T* x = inBuff  + inTadOffsets[i];
+                      T* y = outBuff + outTadOffsets[i];
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong j = 0; j < tadLen; ++j)
+                    sq[j] = x[j] * x[j];
+
+                for (int d = 1; d <= depth && d < tadLen; ++d) {
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong j = d; j < tadLen; ++j)
+                        sq[j] += x[j - d] * x[j - d];
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong j = 0; j < tadLen - d; ++j)
+                        sq[j] += x[j + d] * x[j + d];
+                }
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong j = 0; j < tadLen; ++j)
+                    y[j] = x[j] / nd4j::math::nd4j_pow<T, T, T>(tbias + talpha * sq[j], tbeta);
+            }
+        }
+    }
+    else if(inTadEws == 1 && outTadEws == 1) {
         
         PRAGMA_OMP_PARALLEL_FOR_SIMD
         for (uint i = 0; i < numOfTads; ++i) {
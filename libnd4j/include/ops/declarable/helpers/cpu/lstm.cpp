@@ -34,6 +34,7 @@
 #include <array/NDArrayList.h>
 #include <iterator>
 #include <MmulHelper.h>
+#include <array/NDArrayExpression.h>
 
 namespace nd4j 	  {
 namespace ops 	  {
@@ -112,7 +113,10 @@ void lstmCell(const NDArray* xt, const NDArray* ht_1, const NDArray* ct_1, const
     const int numProj     = ht_1->sizeAt(1);
     const int numUnits    = ct_1->sizeAt(1);
 
-    auto z = mmul(*xt, *Wx) + mmul(*ht_1, *Wh) + *b;      // [bS x 4*numUnits] + [bS x 4*numUnits] + [1 x 4*numUnits] = [bS x 4*numUnits]
+    using namespace nd4j::expr;
+
+    auto z = mmul(*xt, *Wx);
+    expr::assign(z, lazy(z) + mmul(*ht_1, *Wh) + *b);      // [bS x 4*numUnits] + [bS x 4*numUnits] + [1 x 4*numUnits] = [bS x 4*numUnits]
 
     auto zit = z({0,0, 0,            numUnits});      	// z for input gate,  = mmul(Wxi,xt) + mmul(Whi,ht_1) + bi    = [bS x numUnits]
     auto zft = z({0,0, numUnits,   2*numUnits});      	// z for forget gate, = mmul(Wxf,xt) + mmul(Whf,ht_1) + bf    = [bS x numUnits]
@@ -120,32 +124,31 @@ void lstmCell(const NDArray* xt, const NDArray* ht_1, const NDArray* ct_1, const
     auto zot = z({0,0, 3*numUnits, 4*numUnits});      	// z for output gate, = mmul(Wxo,xt) + mmul(Who,ht_1) + bo    = [bS x numUnits]
 
     if(peephole) {                                              // add peephole connections: z  +  ct_1*Wc
-        zit += (*ct_1) * (*Wc)({0,          numUnits});       // add peephole connections to input gate
-        zft += (*ct_1) * (*Wc)({numUnits, 2*numUnits});       // add peephole connections to forget gate
+        expr::assign(zit, lazy(zit) + lazy(*ct_1) * (*Wc)({0,          numUnits}));       // add peephole connections to input gate
+        expr::assign(zft, lazy(zft) + lazy(*ct_1) * (*Wc)({numUnits, 2*numUnits}));       // add peephole connections to forget gate
     }
 
     // current sell state = ft*ct_1 + it*tanh(mmul(Wxc,xt) + mmul(Whc,ht_1) + bc
-    ct->assign( sigmoid(zft + forgetBias) * (*ct_1) + sigmoid(zit) * tanh(zct) );
+    expr::assign(*ct, sigmoid(lazy(zft) + forgetBias) * (*ct_1) + sigmoid(lazy(zit)) * tanh(lazy(zct)));
 
     // if clipping value is provided then cell state is clipped by this value prior to the cell output activation
     if(clippingCellValue > 0.0)
         clipping(ct, clippingCellValue);
 
     if(peephole)
-        zot += (*ct) * (*Wc)({{2*numUnits, 3*numUnits}});            // add peephole connections to output gate zot + ct*Wc
+        expr::assign(zot, lazy(zot) + lazy(*ct) * (*Wc)({{2*numUnits, 3*numUnits}}));            // add peephole connections to output gate zot + ct*Wc
 
     // current cell output = ot*tanh(ct)
-    auto htNoPeepHole = sigmoid(zot) * tanh(*ct);      // = [bS x numUnits]
-
     // apply projection
     if(projection) {
+        auto htNoPeepHole = expr::evaluate(sigmoid(lazy(zot)) * tanh(lazy(*ct)), {bS, numUnits}, ct->dataType(), ct->getWorkspace());      // = [bS x numUnits]
         ht->assign( mmul(htNoPeepHole, *Wp) );                           // [bS x numUnits] * [ numUnits x numProj] = [bS x numProj]
         // if clipping projection is provided then projected cell output state is clipped by this value
         if(clippingProjValue != 0.)
             clipping(ht, clippingProjValue);
     }
     else
-        ht->assign(&htNoPeepHole);
+        expr::assign(*ht, sigmoid(lazy(zot)) * tanh(lazy(*ct)));      // = [bS x numUnits]
 }
 
 template <typename T>
@@ -210,6 +213,8 @@ void lstmBlockCell(const NDArray* xt, const NDArray* cLast, const NDArray* yLast
     const double clippingCellValue   = params[2];              // clipping value for ct, if it is not equal to zero, then cell state is clipped
 
 
+    using namespace nd4j::expr;
+
     const int bS   = xt->sizeAt(0);
     const int inSize      = xt->sizeAt(1);
     const int numUnits    = cLast->sizeAt(1);
@@ -238,8 +243,8 @@ void lstmBlockCell(const NDArray* xt, const NDArray* cLast, const NDArray* yLast
     auto zo = (*m)({0,0, 3*numUnits, 4*numUnits});      	// z for output gate, [bS, numUnits]
 
     if(peephole) {                                              // add peephole connections: z  +  ct_1*Wc
-        zi += (*cLast) * (*Wci);       // add peephole connections to input gate
-        zf += (*cLast) * (*Wcf);       // add peephole connections to forget gate
+        expr::assign(zi, lazy(zi) + lazy(*cLast) * (*Wci));       // add peephole connections to input gate
+        expr::assign(zf, lazy(zf) + lazy(*cLast) * (*Wcf));       // add peephole connections to forget gate
     }
 
     // current sell state = ft*cLast + it*tanh(mmul(Wxc,xt) + mmul(Whc,ht_1) + bc
@@ -267,9 +272,7 @@ void lstmBlockCell(const NDArray* xt, const NDArray* cLast, const NDArray* yLast
         BUILD_SINGLE_SELECTOR(z->dataType(), fusedTanh, (z, i, c, cLast, f, h), FLOAT_TYPES);
     } else {
         //cell state = blockInput .* inputGate + prevCellState .* forgetGate
-        z->applyPairwiseTransform(pairwise::Multiply, i, c, nullptr);       //c = z * i
-        auto temp = (*f) * (*cLast);
-        *c += temp;                              //c = (i * z) + (zf * (*cLast))
+        expr::assign(*c, lazy(*z) * (*i) + lazy(*f) * (*cLast));     //c = (i * z) + (zf * (*cLast))
         c->applyTransform(transform::Tanh, h);  //h = tanh(c)
 
     }
@@ -282,8 +285,7 @@ void lstmBlockCell(const NDArray* xt, const NDArray* cLast, const NDArray* yLast
 
     if(peephole) {
         // add peephole connections to output gate zot + ct*Wc
-        auto prod = *c * (*Wco);
-        zo += prod;
+        expr::assign(zo, lazy(zo) + lazy(*c) * (*Wco));
     }
     zo.applyTransform(transform::Sigmoid, o);   // o = sigmoid(zo)
 
@@ -14,171 +14,158 @@
  * SPDX-License-Identifier: Apache-2.0
  ******************************************************************************/
 
+
 //
 //  @author raver119@gmail.com
 //
 
-#include <ops/declarable/helpers/top_k.h>
-#include <MmulHelper.h>
+#include <ops/declarable/helpers/lup.h>
+#include <ops/declarable/helpers/contiguous.h>
+#include <helpers/LinearAlgebraHelper.h>
 #include <NDArrayFactory.h>
 #include <Status.h>
+#include <limits>
+#include <memory>
+#include <vector>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
-    template <typename T> 
-    static void _swapRows(NDArray* matrix, int theFirst, int theSecond) {
-
-        if (theFirst != theSecond)
-            for (int i = 0; i < matrix->columns(); i++) {
-                T _e0 = matrix->e<T>(theFirst, i);
-                T _e1 = matrix->e<T>(theSecond, i);
-
-                matrix->p<T>(theFirst, i, _e1);
-                matrix->p<T>(theSecond, i, _e0);
-            }
+    // small matrices are spread over threads one per thread, large ones use all threads within factorization itself
+    static bool parallelOverBatch(Nd4jLong batch, int n) {
+        return batch > 1 && (n <= 2 * LinearAlgebraHelper::blockSize() || batch >= LinearAlgebraHelper::maxThreads());
     }
-    BUILD_SINGLE_TEMPLATE(template void _swapRows, (NDArray* matrix, int theFirst, int theSecond), FLOAT_TYPES);
 
-    void swapRows(NDArray* matrix, int theFirst, int theSecond) {
-        BUILD_SINGLE_SELECTOR(matrix->dataType(), _swapRows, (matrix, theFirst, theSecond), FLOAT_TYPES);
+    // scratch matrix of given length, kept on stack for orders up to 8
+    template <typename C>
+    class Scratch {
+    public:
+        explicit Scratch(Nd4jLong length) : _heap(length > 64 ? length : 0) { }
+        C* data() { return _heap.empty() ? _stack : _heap.data(); }
+
+    private:
+        C _stack[64];
+        std::vector<C> _heap;
+    };
+
+    template <typename C>
+    static FORCEINLINE void load(const C* x, Nd4jLong length, C* a) {
+        std::copy(x, x + length, a);
     }
 
-    template <typename T>
-    static void _invertLowerMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        int n = inputMatrix->rows();
-        invertedMatrix->assign(0.f);
-
-        PRAGMA_OMP_PARALLEL_FOR_IF(n > Environment::getInstance()->elementwiseThreshold())
-        for (int i = 0; i < n; i++)
-            invertedMatrix->p(i, i, 1.0f);
-
-        if (inputMatrix->isIdentityMatrix()) return;
-
-        PRAGMA_OMP_PARALLEL_FOR_IF(n > Environment::getInstance()->elementwiseThreshold())
-        for (int i = 1; i < n; i++)
-            invertedMatrix->p(i, i - 1,  -inputMatrix->e<T>(i, i - 1));
-
-        //PRAGMA_OMP_PARALLEL_FOR_SIMD
-        for (int i = 2; i < n; i++) {
-            for (int j = i - 2; j > -1; --j) 
-                for (int k = 0; k < i; k++) 
-                    invertedMatrix->t<T>(i, j) -= (invertedMatrix->t<T>(k, j) * inputMatrix->t<T>(i, k));
-        }
+    template <typename T, typename C>
+    static FORCEINLINE void load(const T* x, Nd4jLong length, C* a) {
+        for (Nd4jLong i = 0; i < length; i++)
+            a[i] = static_cast<C>(x[i]);
     }
 
-    BUILD_SINGLE_TEMPLATE(template void _invertLowerMatrix, (NDArray* inputMatrix, NDArray* invertedMatrix);, FLOAT_TYPES);
-
-    void invertLowerMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        BUILD_SINGLE_SELECTOR(inputMatrix->dataType(), _invertLowerMatrix, (inputMatrix, invertedMatrix), FLOAT_TYPES);
+    template <typename C, typename T>
+    static FORCEINLINE void store(const C* a, Nd4jLong length, T* z) {
+        for (Nd4jLong i = 0; i < length; i++)
+            z[i] = static_cast<T>(a[i]);
     }
 
-    template <typename T>
-    static void _invertUpperMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        int n = inputMatrix->rows();
-        invertedMatrix->setIdentity();
-
-        if (inputMatrix->isIdentityMatrix()) { // the inverse for I is I
-            return;
+    // LU in place, sign gets sign of row permutation; returns false for singular matrix
+    template <typename C>
+    static bool luOf(C* a, int n, int* pivots, C& sign) {
+        switch (n) {
+            case 1: return linalg::Tiny<C, 1>::lu(a, sign);
+            case 2: return linalg::Tiny<C, 2>::lu(a, sign);
+            case 3: return linalg::Tiny<C, 3>::lu(a, sign);
+            case 4: return linalg::Tiny<C, 4>::lu(a, sign);
+            case 5: return linalg::Tiny<C, 5>::lu(a, sign);
+            case 6: return linalg::Tiny<C, 6>::lu(a, sign);
+            case 7: return linalg::Tiny<C, 7>::lu(a, sign);
+            case 8: return linalg::Tiny<C, 8>::lu(a, sign);
+            default: {
+                int swaps = 0;
+                bool regular = LinearAlgebraHelper::getrf<C>(a, n, pivots, swaps);
+                sign = swaps % 2 ? static_cast<C>(-1) : static_cast<C>(1);
+                return regular;
+            }
         }
+    }
 
-        PRAGMA_OMP_PARALLEL_FOR_IF(n > Environment::getInstance()->elementwiseThreshold())
-        for (int i = 0; i < n; i++)
-            invertedMatrix->p(i, i, invertedMatrix->e<T>(i, i) / inputMatrix->e<T>(i, i));
-
-        PRAGMA_OMP_PARALLEL_FOR_IF(n > Environment::getInstance()->elementwiseThreshold())
-        for (int i = 0; i < n - 1; i++)
-            invertedMatrix->p(i, i + 1, invertedMatrix->e<T>(i, i+1) - (inputMatrix->e<T>(i, i + 1) * invertedMatrix->e<T>(i + 1, i + 1) / inputMatrix->e<T>(i, i)));
-
-//        PRAGMA_OMP_PARALLEL_FOR_SIMD
-        for (int i = n - 2; i > - 1; i--) {
-            for (int j = i + 2; j < n; j++) 
-                for (int k = i; k < n; k++) 
-                    invertedMatrix->t<T>(i, j) -= ((invertedMatrix->t<T>(k, j) * inputMatrix->t<T>(i, k) / inputMatrix->t<T>(i, i)));
+    // inverse of x into z, returns false for singular matrix
+    template <typename C>
+    static bool tinyInverseOf(const C* x, int n, C* z) {
+        switch (n) {
+            case 1: return linalg::Tiny<C, 1>::inverse(x, z);
+            case 2: return linalg::Tiny<C, 2>::inverse(x, z);
+            case 3: return linalg::Tiny<C, 3>::inverse(x, z);
+            case 4: return linalg::Tiny<C, 4>::inverse(x, z);
+            case 5: return linalg::Tiny<C, 5>::inverse(x, z);
+            case 6: return linalg::Tiny<C, 6>::inverse(x, z);
+            case 7: return linalg::Tiny<C, 7>::inverse(x, z);
+            default: return linalg::Tiny<C, 8>::inverse(x, z);
         }
     }
 
-    BUILD_SINGLE_TEMPLATE(template void _invertUpperMatrix, (NDArray* inputMatrix, NDArray* invertedMatrix);, FLOAT_TYPES);
-
-    void invertUpperMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-        BUILD_SINGLE_SELECTOR(inputMatrix->dataType(), _invertUpperMatrix, (inputMatrix, invertedMatrix), FLOAT_TYPES);
+    // lower factor of x into l with zeroed upper triangle, returns false if matrix isn't positive definite
+    template <typename C>
+    static bool choleskyOf(C* x, int n, C* l) {
+        switch (n) {
+            case 1: return linalg::Tiny<C, 1>::cholesky(x, l);
+            case 2: return linalg::Tiny<C, 2>::cholesky(x, l);
+            case 3: return linalg::Tiny<C, 3>::cholesky(x, l);
+            case 4: return linalg::Tiny<C, 4>::cholesky(x, l);
+            case 5: return linalg::Tiny<C, 5>::cholesky(x, l);
+            case 6: return linalg::Tiny<C, 6>::cholesky(x, l);
+            case 7: return linalg::Tiny<C, 7>::cholesky(x, l);
+            case 8: return linalg::Tiny<C, 8>::cholesky(x, l);
+            default: {
+                bool positive = LinearAlgebraHelper::potrf<C>(x, n);
+                for (int i = 0; i < n; i++)
+                    for (int j = 0; j < n; j++)
+                        l[i * n + j] = j <= i ? x[i * n + j] : static_cast<C>(0);
+                return positive;
+            }
+        }
     }
 
-
+    // fills det with determinant of each matrix in batch, logarithms of absolute values are used if logAbs is set;
+    // regular[e] is false for singular matrices
     template <typename T>
-    static NDArray _lup(NDArray* input, NDArray* compound, NDArray* permutation) {
+    static void determinants(NDArray* input, bool logAbs, std::vector<typename AccumulatorOf<T>::type>& det, std::unique_ptr<bool[]>& regular) {
+        typedef typename AccumulatorOf<T>::type C;
 
-        const int rowNum = input->rows();
-        const int columnNum = input->columns();
+        std::unique_ptr<NDArray> inputCopy;
+        const T* x = contiguous(*input, inputCopy).template bufferAsT<T>();
 
-        NDArray determinant = NDArrayFactory::create<T>(1.f);
-        std::unique_ptr<NDArray> compoundMatrix(input->dup()); // copy
-        std::unique_ptr<NDArray> permutationMatrix(input->dupUninitialized()); //put identity
-        permutationMatrix->setIdentity();
+        const int n = static_cast<int>(input->sizeAt(-1));
+        const Nd4jLong n2 = static_cast<Nd4jLong>(n) * n;
+        const Nd4jLong batch = input->lengthOf() / n2;
 
-        T pivotValue; // = T(0.0);
-        int pivot; // = -1;
-        int swapCount = 0;
+        det.resize(batch);
+        regular.reset(new bool[batch]);
 
-        for(int i = 0; i < rowNum; i++ ) {
-            pivotValue = T(0.0);
-            pivot = -1;
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallelOverBatch(batch, n)) schedule(guided))
+        for (Nd4jLong e = 0; e < batch; e++) {
+            Scratch<C> a(n2);
+            Scratch<int> pivots(n);
 
-            for(int rowCounter = i; rowCounter < rowNum; rowCounter++ ) {
-                if(nd4j::math::nd4j_abs(compoundMatrix->e<T>(rowCounter, i)) > pivotValue ) {
-                    pivotValue = nd4j::math::nd4j_abs(compoundMatrix->e<T>(rowCounter, i));
-                    pivot = rowCounter;
-                }
-            }
+            load(x + e * n2, n2, a.data());
 
-            if( pivotValue != T(0.0) ) {
-                swapRows(compoundMatrix.get(), pivot, i);
-                swapRows(permutationMatrix.get(), pivot, i);
-                if (pivot != i)
-                    swapCount++;
-
-                for( int j = i + 1; j < rowNum; j++ ) {
-                    compoundMatrix->p(j, i, compoundMatrix->e<T>(j, i) / compoundMatrix->e<T>(i, i));
-                    for( int k = i + 1; k < rowNum; k++ ) {
-                        T arg = compoundMatrix->e<T>(j, i) * compoundMatrix->e<T>(i, k);
-                        compoundMatrix->p(j, k, compoundMatrix->e<T>(j, k) - arg);
-                    }
-                }
-            }
-        }
+            C sign;
+            regular[e] = luOf<C>(a.data(), n, pivots.data(), sign);
 
-        for (int e = 0; e < rowNum; e++) {
-            // nd4j_printf("Compound matrix diag %i %f.\n", e, (*compoundMatrix)(e, e));
-            determinant *= compoundMatrix->e<T>(e, e);
+            C value = logAbs ? static_cast<C>(0) : sign;
+            for (int i = 0; i < n; i++)
+                value = logAbs ? value + nd4j::math::nd4j_log<C, C>(nd4j::math::nd4j_abs<C>(a.data()[i * n + i])) : value * a.data()[i * n + i];
+
+            det[e] = regular[e] || logAbs ? value : static_cast<C>(0);
         }
-        if (swapCount % 2) determinant = -determinant;
-        if (compound != nullptr)
-            *compound = *compoundMatrix;
-        if (permutation != nullptr)
-            *permutation = *permutationMatrix;
-        return determinant;
     }
 
-    BUILD_SINGLE_TEMPLATE(template NDArray _lup, (NDArray* input, NDArray* output, NDArray* permutation), FLOAT_TYPES);
-
-
-
     template <typename T>
     static int _determinant(NDArray* input, NDArray* output) {
+        std::vector<typename AccumulatorOf<T>::type> det;
+        std::unique_ptr<bool[]> regular;
+        determinants<T>(input, false, det, regular);
 
-        Nd4jLong n = input->sizeAt(-1);
-        Nd4jLong n2 = n * n;
-
-        auto matrix = NDArrayFactory::create(input->ordering(), {n, n}, input->dataType(), input->getWorkspace()); //, block.getWorkspace());
-
-        for (int e = 0; e < output->lengthOf(); e++) {
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; ++k, ++row) {
-                matrix.p(row, input->e<T>(k));
-            }
-
-            output->p(e, _lup<T>(&matrix, (NDArray*)nullptr, (NDArray*)nullptr));
-        }
+        for (Nd4jLong e = 0; e < output->lengthOf(); e++)
+            output->p(e, det[e]);
 
         return Status::OK();
     }
@@ -189,22 +176,17 @@ namespace helpers {
         BUILD_SINGLE_SELECTOR(input->dataType(), return _determinant, (input, output), FLOAT_TYPES);
     }
 
-template <typename T>
+    template <typename T>
     int log_abs_determinant_(NDArray* input, NDArray* output) {
+        std::vector<typename AccumulatorOf<T>::type> det;
+        std::unique_ptr<bool[]> regular;
 
-        Nd4jLong n = input->sizeAt(-1);
-        Nd4jLong n2 = n * n;
+        // sum of logarithms of diagonal doesn't overflow where determinant itself does
+        determinants<T>(input, true, det, regular);
 
-        NDArray matrix = NDArrayFactory::create(input->ordering(), {n, n}, input->dataType(), input->getWorkspace()); //, block.getWorkspace());
-
-        for (int e = 0; e < output->lengthOf(); e++) {
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; ++k, ++row) {
-                matrix.p(row, input->e<T>(k));
-            }
-	    NDArray det = _lup<T>(&matrix, (NDArray*)nullptr, (NDArray*)nullptr);
-	    if (det.e<T>(0) != 0.f)
-             	output->p(e, nd4j::math::nd4j_log<T,T>(nd4j::math::nd4j_abs(det.t<T>(0))));
-        }
+        for (Nd4jLong e = 0; e < output->lengthOf(); e++)
+            if (regular[e])
+                output->p(e, det[e]);
 
         return ND4J_STATUS_OK;
     }
@@ -217,53 +199,73 @@ template <typename T>
 
     template <typename T>
     static int _inverse(NDArray* input, NDArray* output) {
+        typedef typename AccumulatorOf<T>::type C;
 
-        auto n = input->sizeAt(-1);
-        auto n2 = n * n;
-        auto totalCount = output->lengthOf() / n2;
-        
-        output->assign(0.f); // fill up output tensor with zeros
-        auto matrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace()); //, block.getWorkspace());
-        auto compound = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace()); //, block.getWorkspace());
-        auto permutation = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace());
-        auto lowerMatrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace());
-        auto upperMatrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), input->getWorkspace());
-
-        for (int e = 0; e < totalCount; e++) {
-            if (e)
-                matrix.assign(0.f);
-
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; k++) {
-                matrix.p(row++, input->e<T>(k));
-            }
-            T det = _lup<T>(&matrix, &compound, &permutation).template e<T>(0);
+        std::unique_ptr<NDArray> inputCopy, outputTemp;
+        const T* x = contiguous(*input, inputCopy).template bufferAsT<T>();
+        NDArray& target = contiguousOutput(*output, outputTemp);
+        T* z = target.bufferAsT<T>();
 
-            // FIXME: and how this is going to work on float16?
-            if (nd4j::math::nd4j_abs<T>(det) < T(0.0000001)) {
-                nd4j_printf("matrix_inverse: The matrix %i has no inverse due determinant is %lf. Quiting...\n", e, det);
-                matrix.printIndexedBuffer("Wrong matrix");
-                return ND4J_STATUS_VALIDATION;
+        const int n = static_cast<int>(input->sizeAt(-1));
+        const Nd4jLong n2 = static_cast<Nd4jLong>(n) * n;
+        const Nd4jLong batch = output->lengthOf() / n2;
+
+        std::vector<C> dets(batch);
+        std::unique_ptr<bool[]> failed(new bool[batch]);
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallelOverBatch(batch, n)) schedule(guided))
+        for (Nd4jLong e = 0; e < batch; e++) {
+            const bool tiny = n <= LinearAlgebraHelper::maxTinyOrder();
+            Scratch<C> a(n2), inverted(n2);
+            Scratch<int> pivots(n);
+
+            load(x + e * n2, n2, a.data());
+
+            // tiny matrices are inverted by Gauss-Jordan from the original, so LU goes to scratch there
+            C* lu = a.data();
+            if (tiny) {
+                lu = inverted.data();
+                load(a.data(), n2, lu);
             }
-            lowerMatrix.setIdentity(); // set up U to identity matrix
-            for (int k = 1; k < n; k++) {  // and then put all values under main diagonal on to it
-                for (int j = 0; j < k; j++)
-                    lowerMatrix.p(k, j, compound.template e<T>(k, j));
+
+            C sign;
+            C det = luOf<C>(lu, n, pivots.data(), sign) ? sign : static_cast<C>(0);
+            for (int i = 0; i < n; i++)
+                det *= lu[i * n + i];
+
+            dets[e] = det;
+            failed[e] = nd4j::math::nd4j_abs<C>(det) < static_cast<C>(0.0000001);
+            if (failed[e])
+                continue;
+
+            if (tiny) {
+                tinyInverseOf<C>(a.data(), n, inverted.data());
             }
-            upperMatrix.setIdentity(); // set up U to identity matrix
-            for (int k = 0; k < n; k++) {  // and then put all values under main diagonal on to it
-                for (int j = k; j < n; j++)
-                    upperMatrix.p(k, j, compound.template e<T>(k, j));
+            else {
+                // A^-1 = U^-1 * L^-1 * P
+                C* b = inverted.data();
+                std::fill(b, b + n2, static_cast<C>(0));
+                for (int i = 0; i < n; i++)
+                    b[i * n + i] = static_cast<C>(1);
+                for (int i = 0; i < n; i++)
+                    if (pivots.data()[i] != i)
+                        std::swap_ranges(b + i * n, b + (i + 1) * n, b + pivots.data()[i] * n);
+
+                LinearAlgebraHelper::trsm<C>(a.data(), n, true, true, b, n);
+                LinearAlgebraHelper::trsm<C>(a.data(), n, false, false, b, n);
             }
-            invertUpperMatrix(&upperMatrix, &matrix);
 
-            invertLowerMatrix(&lowerMatrix, &upperMatrix);
+            store(inverted.data(), n2, z + e * n2);
+        }
 
-            nd4j::MmulHelper::mmul(&matrix, &upperMatrix, &compound, 1.0, 0.0);
-            nd4j::MmulHelper::mmul(&compound, &permutation, &matrix, 1.0, 0.0);
-            for (int k = e * n2, row = 0; k < (e + 1) * n2; k++) {
-                output->p(k, matrix.template e<T>(row++));
+        for (Nd4jLong e = 0; e < batch; e++)
+            if (failed[e]) {
+                nd4j_printf("matrix_inverse: The matrix %i has no inverse due determinant is %lf. Quiting...\n", (int) e, (double) dets[e]);
+                return ND4J_STATUS_VALIDATION;
             }
-        }
+
+        if (outputTemp)
+            output->assign(outputTemp.get());
 
         return Status::OK();
     }
@@ -274,25 +276,37 @@ template <typename T>
 
     template <typename T>
     static bool checkCholeskyInput_(NDArray const* input) {
-        //std::unique_ptr<NDArray> matrix(NDArrayFactory::create_('c', {n, n}, input->dataType())); //, block.getWorkspace());
-        std::unique_ptr<ResultSet> lastMatrixList(input->allTensorsAlongDimension({input->rankOf() - 2, input->rankOf()-1}));
-        for (size_t i = 0; i < lastMatrixList->size(); i++) {
-            auto thisMatrix = lastMatrixList->at(i);
-            // check for symmetric
-            for (Nd4jLong r = 0; r < thisMatrix->rows(); r++)
-                for (Nd4jLong c = 0; c < thisMatrix->columns(); c++)
-                    if (nd4j::math::nd4j_abs(thisMatrix->e<T>(r, c) - lastMatrixList->at(i)->e<T>(c,r)) > T(1.e-6f)) return false;
-
-            NDArray output = NDArrayFactory::create<T>(0.);
-            if (ND4J_STATUS_OK != determinant(thisMatrix, &output)) return false;
-            if (output.e<T>(0) <= T(0)) return 0;
-            NDArray reversedMatrix(*thisMatrix);
-            if (ND4J_STATUS_OK != inverse(thisMatrix, &reversedMatrix)) return false;
-            if (ND4J_STATUS_OK != determinant(&reversedMatrix, &output)) return false;
-            if (output.e<T>(0) <= T(0)) return 0;
+        typedef typename AccumulatorOf<T>::type C;
+
+        std::unique_ptr<NDArray> inputCopy;
+        const T* x = contiguous(*input, inputCopy).template bufferAsT<T>();
+
+        const int n = static_cast<int>(input->sizeAt(-1));
+        const Nd4jLong n2 = static_cast<Nd4jLong>(n) * n;
+        const Nd4jLong batch = input->lengthOf() / n2;
+
+        // symmetric and positive definite, the latter one means cholesky factorization succeeds
+        std::unique_ptr<bool[]> valid(new bool[batch]);
 
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallelOverBatch(batch, n)) schedule(guided))
+        for (Nd4jLong e = 0; e < batch; e++) {
+            Scratch<C> a(n2), l(n2);
+            load(x + e * n2, n2, a.data());
+
+            bool symmetric = true;
+            for (int r = 0; r < n && symmetric; r++)
+                for (int c = r + 1; c < n; c++)
+                    if (nd4j::math::nd4j_abs<C>(a.data()[r * n + c] - a.data()[c * n + r]) > static_cast<C>(1.e-6f)) {
+                        symmetric = false;
+                        break;
+                    }
+
+            valid[e] = symmetric && choleskyOf<C>(a.data(), n, l.data());
         }
 
+        for (Nd4jLong e = 0; e < batch; e++)
+            if (!valid[e])
+                return false;
 
         return true;
     }
@@ -304,71 +318,75 @@ template <typename T>
 
     template <typename T>
     int cholesky_(NDArray* input, NDArray* output, bool inplace) {
+        typedef typename AccumulatorOf<T>::type C;
 
-        auto n = input->sizeAt(-1);
-        auto n2 = n * n;
-        auto totalCount = output->lengthOf() / n2;
-        if (!inplace)
-             output->assign(0.f); // fill up output tensor with zeros only inplace=false
+        // inplace means output is input itself, so copy of input is made before anything gets written
+        std::unique_ptr<NDArray> inputCopy, outputTemp;
+        if (inplace || input->ordering() != 'c' || input->ews() != 1)
+            inputCopy.reset(input->dup('c'));
+        const T* x = (inputCopy ? *inputCopy : *input).template bufferAsT<T>();
+        NDArray& target = contiguousOutput(*output, outputTemp);
+        T* z = target.bufferAsT<T>();
 
-        std::unique_ptr<NDArray> matrix(NDArrayFactory::create_('c', {n, n}, input->dataType())); //, block.getWorkspace());
-        std::unique_ptr<NDArray> lowerMatrix(NDArrayFactory::create_('c',{n, n}, input->dataType()));
+        const int n = static_cast<int>(input->sizeAt(-1));
+        const Nd4jLong n2 = static_cast<Nd4jLong>(n) * n;
+        const Nd4jLong batch = output->lengthOf() / n2;
 
-        for (int e = 0; e < totalCount; e++) {
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallelOverBatch(batch, n)) schedule(guided))
+        for (Nd4jLong e = 0; e < batch; e++) {
+            Scratch<C> a(n2), l(n2);
+            load(x + e * n2, n2, a.data());
 
-            // fill up matrix
-            for (int k = e * n2, l = 0; k < (e + 1) * n2; k++) {
-                matrix->p(l++, input->e<T>(k));
-            }
-            //if (e) // from the second loop need to zero matrix
-            lowerMatrix->assign(0.f);
-
-            for (Nd4jLong col = 0; col < n; col++) {
-                for (Nd4jLong row = 0; row < col; row++) {
-                    T rowSum = 0;
-                    for (Nd4jLong k = 0; k < row; ++k)
-                        rowSum += (lowerMatrix->e<T>(col, k) * lowerMatrix->e<T>(row, k));
-                    lowerMatrix->p(col, row, (matrix->e<T>(row, col) - rowSum) / lowerMatrix->e<double>(row, row));
-                }
-                T diagonalSum = 0;
-                for (Nd4jLong k = 0; k < col;  ++k)
-                    diagonalSum += lowerMatrix->e<T>(col, k) * lowerMatrix->e<T>(col, k);
-                lowerMatrix->p(col, col, nd4j::math::nd4j_sqrt<T, T>(matrix->e<T>(col, col) - diagonalSum));
-                //nd4j_printf("%i: ", col);
-                //lowerMatrix->printIndexedBuffer("Lower matrix");
-            }
-            for (int k = e * n2, l = 0; k < (e + 1) * n2; k++) {
-                output->p(k, lowerMatrix->e<T>(l++));
-            }
+            choleskyOf<C>(a.data(), n, l.data());
+
+            store(l.data(), n2, z + e * n2);
         }
 
+        if (outputTemp)
+            output->assign(outputTemp.get());
+
         return ND4J_STATUS_OK;
     }
 
     int cholesky(NDArray* input, NDArray* output, bool inplace) {
         BUILD_SINGLE_SELECTOR(input->dataType(), return cholesky_, (input, output, inplace), FLOAT_TYPES);
-    }    
+    }
     BUILD_SINGLE_TEMPLATE(template int cholesky_, (NDArray* input, NDArray* output, bool inplace), FLOAT_TYPES);
     BUILD_SINGLE_TEMPLATE(template int _inverse, (NDArray* input, NDArray* output), FLOAT_TYPES);
 
     template <typename T>
     int logdetFunctor_(NDArray* input, NDArray* output) {
-        std::unique_ptr<NDArray> tempOutput(input->dup());
-        int res = cholesky_<T>(input, tempOutput.get(), false);
-        if (res != ND4J_STATUS_OK)
-            return res;
-        auto n = input->sizeAt(-1);
-        auto totalCount = output->lengthOf();
-        std::vector<T> d(n);
-        std::unique_ptr<ResultSet> matricies(tempOutput->allTensorsAlongDimension({input->rankOf()-2, input->rankOf() - 1}));
-        std::unique_ptr<ResultSet> inputMatricies(input->allTensorsAlongDimension({input->rankOf()-2, input->rankOf() - 1}));
-        for (Nd4jLong e = 0; e < totalCount; e++) {
-
-            //d[0] = inputMatricies->at(e)->t<T>(0, 0);
-            for (size_t i = 0; i < n; ++i) {
-                output->t<T>(e) += nd4j::math::nd4j_log<T,T>(nd4j::math::nd4j_pow<T,T,T>(matricies->at(e)->t<T>(i, i), T(2)));
+        typedef typename AccumulatorOf<T>::type C;
+
+        std::unique_ptr<NDArray> inputCopy;
+        const T* x = contiguous(*input, inputCopy).template bufferAsT<T>();
+
+        const int n = static_cast<int>(input->sizeAt(-1));
+        const Nd4jLong n2 = static_cast<Nd4jLong>(n) * n;
+        const Nd4jLong batch = output->lengthOf();
+
+        std::vector<C> logdet(batch);
+
+        // log(det(A)) = log(det(L)^2) = 2 * sum(log(L_ii))
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallelOverBatch(batch, n)) schedule(guided))
+        for (Nd4jLong e = 0; e < batch; e++) {
+            Scratch<C> a(n2), l(n2);
+            load(x + e * n2, n2, a.data());
+
+            if (!choleskyOf<C>(a.data(), n, l.data())) {
+                logdet[e] = std::numeric_limits<C>::quiet_NaN();
+                continue;
             }
+
+            C sum = static_cast<C>(0);
+            for (int i = 0; i < n; i++)
+                sum += nd4j::math::nd4j_log<C, C>(l.data()[i * n + i]);
+            logdet[e] = static_cast<C>(2) * sum;
         }
+
+        for (Nd4jLong e = 0; e < batch; e++)
+            output->p(e, logdet[e]);
+
         return ND4J_STATUS_OK;
     }
 
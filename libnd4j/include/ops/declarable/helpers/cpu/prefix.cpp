@@ -20,7 +20,8 @@
 
 #include <ops/ops.h>
 #include <helpers/shape.h>
-#include <helpers/TAD.h>
+#include <helpers/PrefixScan.h>
+#include <helpers/ConstantTadHelper.h>
 #include <ops/declarable/helpers/prefix.h>
 
 namespace nd4j {
@@ -30,88 +31,24 @@ namespace nd4j {
             static void __prefix(scalar::Ops op, void* vx, Nd4jLong* xShapeInfo, void* vz, Nd4jLong* zShapeInfo, bool exclusive, bool reverse) {
                 auto x = reinterpret_cast<T *>(vx);
                 auto z = reinterpret_cast<T *>(vz);
-                auto length = shape::length(xShapeInfo);
 
-                T prevSum = op == scalar::Add ? (T) 0 : (T) 1;
-                T sum = prevSum;
-                                
-                if (reverse) {
-                    if (shape::elementWiseStride(xShapeInfo) == 1 && shape::elementWiseStride(zShapeInfo) == 1 &&
-                        shape::order(xShapeInfo) == 'c' && shape::order(zShapeInfo) == 'c') {
-
-                        for (Nd4jLong e = length - 1; e >= 0; --e) {
-                            sum = op == scalar::Add ? simdOps::Add<T, T, T>::op(sum, x[e]) : simdOps::Multiply<T, T, T>::op(sum, x[e]);
-                            if (!exclusive)
-                                prevSum = sum;
-
-                            z[e] = prevSum;
-
-                            prevSum = sum;
-                        }
-                    } 
-                    else {
-                        
-                        for (Nd4jLong e = length - 1; e >= 0; --e) {
-
-                            auto xOffset = shape::getIndexOffset(e, xShapeInfo, length);
-                            auto zOffset = shape::getIndexOffset(e, zShapeInfo, length);
-                            sum = op == scalar::Add ? simdOps::Add<T, T, T>::op(sum, x[xOffset]) : simdOps::Multiply<T, T, T>::op(sum, x[xOffset]);
-                            
-                            if (!exclusive)
-                                prevSum = sum;
-
-                            z[zOffset] = prevSum;
-                            prevSum = sum;
-                        }
-                    }
-                } else {
-                    if (shape::elementWiseStride(xShapeInfo) == 1 && shape::elementWiseStride(zShapeInfo) == 1 &&
-                        shape::order(xShapeInfo) == 'c' && shape::order(zShapeInfo) == 'c') {                        
-
-                        for (int e = 0; e < length; e++) {
-                            sum = op == scalar::Add ? simdOps::Add<T, T, T>::op(sum, x[e]) : simdOps::Multiply<T, T, T>::op(sum, x[e]);
-
-                            if (!exclusive)
-                                prevSum = sum;
-
-                            z[e] = prevSum;
-
-                            prevSum = sum;
-                        }
-                    } 
-                    else {
-                    
-                        for (int e = 0; e < length; e++) {
-                            
-                            auto xOffset = shape::getIndexOffset(e, xShapeInfo, length);
-                            auto zOffset = shape::getIndexOffset(e, zShapeInfo, length);
-                            sum = op == scalar::Add ? simdOps::Add<T, T, T>::op(sum, x[xOffset]) : simdOps::Multiply<T, T, T>::op(sum, x[xOffset]);
-
-                            if (!exclusive)
-                                prevSum = sum;
-
-                            z[zOffset] = prevSum;
-                            prevSum = sum;
-                        }
-                    }
-                }
+                if (op == scalar::Add)
+                    PrefixScan::scan<T, scan::Add<T>>(x, xShapeInfo, z, zShapeInfo, exclusive, reverse);
+                else
+                    PrefixScan::scan<T, scan::Multiply<T>>(x, xShapeInfo, z, zShapeInfo, exclusive, reverse);
             };
 
             template <typename T>
             static void __prefix(scalar::Ops op, NDArray* x, NDArray* z, std::vector<int>& dims, bool exclusive, bool reverse) {
-                auto xTads = x->allTensorsAlongDimension(dims);
-                auto zTads = z->allTensorsAlongDimension(dims);
-                auto t = xTads->size();
-
-                for (int e = 0; e < t; e++) {
-                    auto tx = xTads->at(e);
-                    auto tz = zTads->at(e);
-
-                    __prefix<T>(op, tx->buffer(), tx->shapeInfo(), tz->buffer(), tz->shapeInfo(), exclusive, reverse);
-                }
-
-                delete xTads;
-                delete zTads;
+                auto xTads = ConstantTadHelper::getInstance()->tadForDimensions(x->shapeInfo(), dims);
+                auto zTads = ConstantTadHelper::getInstance()->tadForDimensions(z->shapeInfo(), dims);
+                auto xBuffer = reinterpret_cast<T *>(x->buffer());
+                auto zBuffer = reinterpret_cast<T *>(z->buffer());
+
+                if (op == scalar::Add)
+                    PrefixScan::scanTads<T, scan::Add<T>>(xBuffer, xTads.primaryShapeInfo(), xTads.primaryOffsets(), zBuffer, zTads.primaryShapeInfo(), zTads.primaryOffsets(), xTads.numberOfTads(), exclusive, reverse);
+                else
+                    PrefixScan::scanTads<T, scan::Multiply<T>>(xBuffer, xTads.primaryShapeInfo(), xTads.primaryOffsets(), zBuffer, zTads.primaryShapeInfo(), zTads.primaryOffsets(), xTads.numberOfTads(), exclusive, reverse);
             };
 
             template <typename T>
@@ -0,0 +1,364 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Int8 inference helpers, see quantization.h
+//
+
+#include <ops/declarable/helpers/quantization.h>
+#include <ops/declarable/generic/helpers/convolutions.h>
+#include <Environment.h>
+#include <vector>
+#include <memory>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    // number of B columns processed by one cache block: 64 columns x K bytes stay in L2 while all rows of A pass over them
+    static const int QGEMM_BLOCK_N = 64;
+
+    void nudgeQuantizationRange(float min, float max, int numBits, bool narrowed, float& scale, int& zeroPoint, int& quantMin, int& quantMax) {
+        // this is the same integer grid fakeQuantWithMinMaxVars uses, so folded graphs reproduce fake-quant results.
+        // note: upper bound is 2^(numBits - 1) (128 for 8 bits), not 2^numBits - 1. That's how the op behaves today,
+        // and folding must match it bit for bit, so both have to be changed together if the op grid is ever fixed
+        quantMin = narrowed ? 1 : 0;
+        quantMax = 1 << (numBits - 1);
+
+        scale = (max - min) / static_cast<float>(quantMax - quantMin);
+        const float zeroPointFromMin = static_cast<float>(quantMin) - min / scale;
+
+        if (zeroPointFromMin < quantMin)
+            zeroPoint = quantMin;
+        else if (zeroPointFromMin > quantMax)
+            zeroPoint = quantMax;
+        else
+            zeroPoint = static_cast<int>(roundf(zeroPointFromMin));
+    }
+
+    template <typename X, typename Z>
+    static void quantize_(const NDArray& input, float scale, int zeroPoint, int quantMin, int quantMax, int offset, NDArray& output) {
+        const float nudgedMin = (quantMin - zeroPoint) * scale;
+        const float nudgedMax = (quantMax - zeroPoint) * scale;
+        const Nd4jLong length = input.lengthOf();
+
+        auto quantizeOne = [&] (X value) -> Z {
+            float v = static_cast<float>(value);
+            v = v < nudgedMin ? nudgedMin : v > nudgedMax ? nudgedMax : v;
+            int q = static_cast<int>(nd4j::math::nd4j_floor<float, float>((v - nudgedMin) / scale + 0.5f)) + quantMin;
+            q = q < quantMin ? quantMin : q > quantMax ? quantMax : q;
+            return static_cast<Z>(q - offset);
+        };
+
+        if (input.ews() == 1 && output.ews() == 1 && input.ordering() == output.ordering()) {
+            auto x = input.bufferAsT<X>();
+            auto z = output.bufferAsT<Z>();
+
+            PRAGMA_OMP_PARALLEL_FOR_SIMD_ARGS(if(length > Environment::getInstance()->elementwiseThreshold()))
+            for (Nd4jLong e = 0; e < length; e++)
+                z[e] = quantizeOne(x[e]);
+        } else {
+            for (Nd4jLong e = 0; e < length; e++)
+                output.p<Z>(e, quantizeOne(input.e<X>(e)));
+        }
+    }
+
+    void quantize(const NDArray& input, float scale, int zeroPoint, int quantMin, int quantMax, NDArray& output) {
+        if (output.dataType() == nd4j::DataType::UINT8) {
+            BUILD_SINGLE_PARTIAL_SELECTOR(input.dataType(), quantize_<, uint8_t>(input, scale, zeroPoint, quantMin, quantMax, 0, output), FLOAT_TYPES);
+        } else if (output.dataType() == nd4j::DataType::INT8) {
+            BUILD_SINGLE_PARTIAL_SELECTOR(input.dataType(), quantize_<, int8_t>(input, scale, zeroPoint, quantMin, quantMax, 128, output), FLOAT_TYPES);
+        } else
+            throw std::runtime_error("quantize: output data type must be UINT8 or INT8");
+    }
+
+    // one row of A against up to QGEMM_BLOCK_N rows of transposed B, 4 columns share each load of A
+    static FORCEINLINE void qgemmRow(const uint8_t* a, const int8_t* bt, int K, int N, int32_t* c) {
+        int j = 0;
+        for (; j + 4 <= N; j += 4) {
+            auto b0 = bt + (Nd4jLong) (j + 0) * K;
+            auto b1 = bt + (Nd4jLong) (j + 1) * K;
+            auto b2 = bt + (Nd4jLong) (j + 2) * K;
+            auto b3 = bt + (Nd4jLong) (j + 3) * K;
+            int32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+            PRAGMA_OMP_SIMD_ARGS(reduction(+:s0,s1,s2,s3))
+            for (int k = 0; k < K; k++) {
+                const int32_t av = a[k];
+                s0 += av * b0[k];
+                s1 += av * b1[k];
+                s2 += av * b2[k];
+                s3 += av * b3[k];
+            }
+
+            c[j] = s0;
+            c[j + 1] = s1;
+            c[j + 2] = s2;
+            c[j + 3] = s3;
+        }
+
+        for (; j < N; j++) {
+            auto b0 = bt + (Nd4jLong) j * K;
+            int32_t s0 = 0;
+
+            PRAGMA_OMP_SIMD_ARGS(reduction(+:s0))
+            for (int k = 0; k < K; k++)
+                s0 += static_cast<int32_t>(a[k]) * b0[k];
+
+            c[j] = s0;
+        }
+    }
+
+    void qgemm(const uint8_t* A, int aZeroPoint, const int8_t* B, const int* bZeroPoints, int M, int N, int K, int32_t* C) {
+        const bool parallel = (Nd4jLong) M * N * K > Environment::getInstance()->elementwiseThreshold();
+
+        // B is transposed once, so both operands are contiguous along K in the inner loop
+        std::vector<int8_t> bt((Nd4jLong) N * K);
+        std::vector<int32_t> colSums(N, 0);
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(parallel)
+        for (int j = 0; j < N; j++) {
+            int32_t sum = 0;
+            for (int k = 0; k < K; k++) {
+                const int8_t v = B[(Nd4jLong) k * N + j];
+                bt[(Nd4jLong) j * K + k] = v;
+                sum += v;
+            }
+            colSums[j] = sum;
+        }
+
+        bool hasBZeroPoints = false;
+        for (int j = 0; j < N; j++)
+            if (bZeroPoints[j] != 0) {
+                hasBZeroPoints = true;
+                break;
+            }
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(collapse(2) if(parallel))
+        for (int jb = 0; jb < N; jb += QGEMM_BLOCK_N) {
+            for (int i = 0; i < M; i++) {
+                const int width = nd4j::math::nd4j_min<int>(QGEMM_BLOCK_N, N - jb);
+                qgemmRow(A + (Nd4jLong) i * K, bt.data() + (Nd4jLong) jb * K, K, width, C + (Nd4jLong) i * N + jb);
+            }
+        }
+
+        if (aZeroPoint == 0 && !hasBZeroPoints)
+            return;
+
+        // zero points are applied afterwards: sum (a - za)(b - zb) = sum ab - za * sum b - zb * sum a + K * za * zb
+        PRAGMA_OMP_PARALLEL_FOR_IF(parallel)
+        for (int i = 0; i < M; i++) {
+            auto a = A + (Nd4jLong) i * K;
+            auto c = C + (Nd4jLong) i * N;
+
+            int32_t rowSum = 0;
+            if (hasBZeroPoints) {
+                PRAGMA_OMP_SIMD_ARGS(reduction(+:rowSum))
+                for (int k = 0; k < K; k++)
+                    rowSum += a[k];
+            }
+
+            PRAGMA_OMP_SIMD
+            for (int j = 0; j < N; j++)
+                c[j] += K * aZeroPoint * bZeroPoints[j] - aZeroPoint * colSums[j] - bZeroPoints[j] * rowSum;
+        }
+    }
+
+    template <typename Z>
+    static void dequantize_(const int32_t* acc, int M, int N, float xScale, const std::vector<float>& scales, const std::vector<float>& bias, NDArray& target) {
+        auto z = target.bufferAsT<Z>();
+
+        PRAGMA_OMP_PARALLEL_FOR_IF((Nd4jLong) M * N > Environment::getInstance()->elementwiseThreshold())
+        for (int i = 0; i < M; i++) {
+            auto a = acc + (Nd4jLong) i * N;
+            auto r = z + (Nd4jLong) i * N;
+            for (int j = 0; j < N; j++)
+                r[j] = static_cast<Z>(xScale * scales[j] * static_cast<float>(a[j]) + bias[j]);
+        }
+    }
+
+    // per-channel requantisation: q = round(xScale * scale[j] / outScale * acc + bias[j] / outScale) + outZeroPoint
+    static void requantize(const int32_t* acc, int M, int N, float xScale, const std::vector<float>& scales, const std::vector<float>& bias, float outScale, int outZeroPoint, NDArray& target) {
+        auto z = target.bufferAsT<uint8_t>();
+
+        std::vector<float> multipliers(N);
+        std::vector<float> offsets(N);
+        for (int j = 0; j < N; j++) {
+            multipliers[j] = xScale * scales[j] / outScale;
+            offsets[j] = bias[j] / outScale + static_cast<float>(outZeroPoint) + 0.5f;
+        }
+
+        PRAGMA_OMP_PARALLEL_FOR_IF((Nd4jLong) M * N > Environment::getInstance()->elementwiseThreshold())
+        for (int i = 0; i < M; i++) {
+            auto a = acc + (Nd4jLong) i * N;
+            auto r = z + (Nd4jLong) i * N;
+            for (int j = 0; j < N; j++) {
+                int q = static_cast<int>(nd4j::math::nd4j_floor<float, float>(multipliers[j] * static_cast<float>(a[j]) + offsets[j]));
+                r[j] = static_cast<uint8_t>(q < 0 ? 0 : q > 255 ? 255 : q);
+            }
+        }
+    }
+
+    // writes [M, N] accumulator into c-ordered contiguous target, dequantised or requantised depending on target type
+    static void storeAccumulator(const int32_t* acc, int M, int N, float xScale, const NDArray* scales, const NDArray* bias, float outScale, int outZeroPoint, NDArray& target) {
+        std::vector<float> channelScales(N);
+        std::vector<float> channelBias(N, 0.f);
+        for (int j = 0; j < N; j++) {
+            channelScales[j] = scales->lengthOf() == 1 ? scales->e<float>(0) : scales->e<float>(j);
+            if (bias != nullptr)
+                channelBias[j] = bias->e<float>(j);
+        }
+
+        if (target.dataType() == nd4j::DataType::UINT8)
+            requantize(acc, M, N, xScale, channelScales, channelBias, outScale, outZeroPoint, target);
+        else
+            BUILD_SINGLE_SELECTOR(target.dataType(), dequantize_, (acc, M, N, xScale, channelScales, channelBias, target), FLOAT_TYPES);
+    }
+
+    static std::vector<int> channelZeroPoints(const NDArray* zeroPoints, int N) {
+        std::vector<int> result(N);
+        for (int j = 0; j < N; j++)
+            result[j] = zeroPoints->lengthOf() == 1 ? zeroPoints->e<int>(0) : zeroPoints->e<int>(j);
+
+        return result;
+    }
+
+    // returns contiguous c-ordered UINT8 copy of x, quantising it if x is floating point
+    static NDArray* quantizedInput(const NDArray* x, float xScale, int xZeroPoint, int quantMin, int quantMax) {
+        auto result = new NDArray('c', x->getShapeAsVector(), nd4j::DataType::UINT8, x->getWorkspace());
+        if (x->dataType() == nd4j::DataType::UINT8)
+            result->assign(x);
+        else
+            quantize(*x, xScale, xZeroPoint, quantMin, quantMax, *result);
+
+        return result;
+    }
+
+    void qmatmul(const NDArray* x, const NDArray* y, float xScale, int xZeroPoint, const NDArray* yScales, const NDArray* yZeroPoints, const NDArray* bias, NDArray* output, float outScale, int outZeroPoint, int quantMin, int quantMax) {
+        const int M = x->sizeAt(0);
+        const int K = x->sizeAt(1);
+        const int N = y->sizeAt(1);
+
+        std::unique_ptr<NDArray> xTemp;
+        const uint8_t* a = nullptr;
+        if (x->dataType() == nd4j::DataType::UINT8 && x->ordering() == 'c' && x->ews() == 1)
+            a = x->bufferAsT<uint8_t>();
+        else {
+            xTemp.reset(quantizedInput(x, xScale, xZeroPoint, quantMin, quantMax));
+            a = xTemp->bufferAsT<uint8_t>();
+        }
+
+        std::unique_ptr<NDArray> yTemp;
+        const int8_t* b = nullptr;
+        if (y->ordering() == 'c' && y->ews() == 1)
+            b = y->bufferAsT<int8_t>();
+        else {
+            yTemp.reset(const_cast<NDArray*>(y)->dup('c'));
+            b = yTemp->bufferAsT<int8_t>();
+        }
+
+        auto zeroPoints = channelZeroPoints(yZeroPoints, N);
+        std::vector<int32_t> acc((Nd4jLong) M * N);
+        qgemm(a, xZeroPoint, b, zeroPoints.data(), M, N, K, acc.data());
+
+        if (output->ordering() == 'c' && output->ews() == 1)
+            storeAccumulator(acc.data(), M, N, xScale, yScales, bias, outScale, outZeroPoint, *output);
+        else {
+            NDArray target('c', {M, N}, output->dataType(), output->getWorkspace());
+            storeAccumulator(acc.data(), M, N, xScale, yScales, bias, outScale, outZeroPoint, target);
+            output->assign(target);
+        }
+    }
+
+    void qconv2d(const NDArray* input, const NDArray* weights, float xScale, int xZeroPoint, const NDArray* wScales, const NDArray* wZeroPoints, const NDArray* bias, NDArray* output, float outScale, int outZeroPoint, int quantMin, int quantMax,
+                 const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int isSameMode, const int isNCHW) {
+
+        int bS, iC, iH, iW, oC, oH, oW;                             // batch size, input channels, input height/width, output channels, output height/width;
+        int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;       // corresponding indexes
+        ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, *input, *output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWoC, indWkH, indOoH);
+
+        if(isSameMode)                       // SAME
+            ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
+
+        std::unique_ptr<NDArray> xTemp(quantizedInput(input, xScale, xZeroPoint, quantMin, quantMax));
+        const uint8_t* x = xTemp->bufferAsT<uint8_t>();
+
+        // im2col in quantised domain, rows are [bS, oH, oW], columns are [kH, kW, iC] to match weights layout
+        const int M = bS * oH * oW;
+        const int K = kH * kW * iC;
+        std::vector<uint8_t> columns((Nd4jLong) M * K);
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(collapse(2) if((Nd4jLong) M * K > Environment::getInstance()->elementwiseThreshold()))
+        for (int b = 0; b < bS; b++) {
+            for (int oh = 0; oh < oH; oh++) {
+                for (int ow = 0; ow < oW; ow++) {
+                    auto column = columns.data() + ((Nd4jLong) (b * oH + oh) * oW + ow) * K;
+
+                    for (int kh = 0; kh < kH; kh++) {
+                        const int ih = oh * sH - pH + kh * dH;
+
+                        for (int kw = 0; kw < kW; kw++) {
+                            const int iw = ow * sW - pW + kw * dW;
+                            auto patch = column + (kh * kW + kw) * iC;
+
+                            if (ih < 0 || ih >= iH || iw < 0 || iw >= iW) {
+                                for (int ic = 0; ic < iC; ic++)
+                                    patch[ic] = static_cast<uint8_t>(xZeroPoint);
+                            } else if (!isNCHW) {
+                                auto src = x + (((Nd4jLong) b * iH + ih) * iW + iw) * iC;
+                                for (int ic = 0; ic < iC; ic++)
+                                    patch[ic] = src[ic];
+                            } else {
+                                for (int ic = 0; ic < iC; ic++)
+                                    patch[ic] = x[(((Nd4jLong) b * iC + ic) * iH + ih) * iW + iw];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        std::unique_ptr<NDArray> wTemp;
+        const int8_t* w = nullptr;
+        if (weights->ordering() == 'c' && weights->ews() == 1)
+            w = weights->bufferAsT<int8_t>();
+        else {
+            wTemp.reset(const_cast<NDArray*>(weights)->dup('c'));
+            w = wTemp->bufferAsT<int8_t>();
+        }
+
+        auto zeroPoints = channelZeroPoints(wZeroPoints, oC);
+        std::vector<int32_t> acc((Nd4jLong) M * oC);
+        qgemm(columns.data(), xZeroPoint, w, zeroPoints.data(), M, oC, K, acc.data());
+
+        if (!isNCHW && output->ordering() == 'c' && output->ews() == 1)
+            storeAccumulator(acc.data(), M, oC, xScale, wScales, bias, outScale, outZeroPoint, *output);
+        else {
+            NDArray target('c', {bS, oH, oW, oC}, output->dataType(), output->getWorkspace());
+            storeAccumulator(acc.data(), M, oC, xScale, wScales, bias, outScale, outZeroPoint, target);
+
+            if (isNCHW)
+                target.permutei({0, 3, 1, 2});
+
+            output->assign(target);
+        }
+    }
+
+    BUILD_SINGLE_TEMPLATE(template void dequantize_, (const int32_t* acc, int M, int N, float xScale, const std::vector<float>& scales, const std::vector<float>& bias, NDArray& target), FLOAT_TYPES);
+
+}
+}
+}
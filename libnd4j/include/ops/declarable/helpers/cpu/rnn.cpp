@@ -22,6 +22,7 @@
 
 #include<ops/declarable/helpers/rnn.h>
 #include <helpers/BlasHelper.h>
+#include <array/NDArrayExpression.h>
 
 
 namespace nd4j    {
@@ -29,13 +30,6 @@ namespace ops     {
 namespace helpers {
 
 
-//////////////////////////////////////////////////////////////////////////
-static FORCEINLINE NDArray activation(const NDArray& arr) {
-
-    return (const_cast<NDArray&>(arr)).transform(transform::Tanh);
-}
-
-
 //////////////////////////////////////////////////////////////////////////
 void rnnCell(const NDArray* xt, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* ht_1, NDArray* ht) {
 
@@ -45,10 +39,12 @@ void rnnCell(const NDArray* xt, const NDArray* Wx, const NDArray* Wh, const NDAr
     // b    biases, [2*numUnits]: {0, numUnits} are input-to-hidden biases and {numUnits, 2*numUnits} are hidden-to-hidden biases
     // ht_1 previous cell output [bS x numUnits],  that is at previous time step t-1, in case of projection=false -> numUnits=numUnits!!!
 
+    using namespace nd4j::expr;
+
     const int numUnits  = ht_1->sizeAt(1);
     
-    // ht is current cell output [bS x numUnits], that is at current time step t                
-    ht->assign(activation(mmul(*xt, *Wx) + (*b)({{0, numUnits}})  +  mmul(*ht_1, *Wh) + (*b)({{numUnits, 2*numUnits}})));     // [bS x numUnits] + [numUnits]  +  [bS x numUnits] + [numUnits] = [bS x numUnits]
+    // ht is current cell output [bS x numUnits], that is at current time step t, activation is tanh
+    expr::assign(*ht, tanh(lazy(mmul(*xt, *Wx)) + (*b)({{0, numUnits}})  +  mmul(*ht_1, *Wh) + (*b)({{numUnits, 2*numUnits}})));     // [bS x numUnits] + [numUnits]  +  [bS x numUnits] + [numUnits] = [bS x numUnits]
 }
 
 
@@ -19,6 +19,9 @@
 //
 
 #include <ops/declarable/helpers/segment.h>
+#include <array/TadSet.h>
+#include <helpers/PrefixScan.h>
+#include <memory>
 
 namespace nd4j {
 namespace ops {
@@ -52,32 +55,30 @@ namespace helpers {
             for (Nd4jLong e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             auto numOfClasses = output->sizeAt(0); // number of classes
             std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto maxT = listOfOutTensors->at(idx);
+            auto maxT = listOfOutTensors.at(idx);
 
             //int pos = 0;
-            maxT->assign(listOfTensors->at(0));
+            maxT.assign(listOfTensors.at(0));
 
             for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
                 if (indices->e<int>(i) == idx) {
 
-                    for (Nd4jLong e = 0; e < maxT->lengthOf(); e++) {
-                       maxT->t<T>(e) = nd4j::math::nd4j_max(maxT->t<T>(e), listOfTensors->at(i)->t<T>(e));
+                    for (Nd4jLong e = 0; e < maxT.lengthOf(); e++) {
+                       maxT.t<T>(e) = nd4j::math::nd4j_max(maxT.t<T>(e), listOfTensors.at(i).t<T>(e));
                     }
                 }
                 else {
                     idx = indices->e<Nd4jLong>(i);
-                    maxT = listOfOutTensors->at(idx);
-                    maxT->assign(listOfTensors->at(i));
+                    maxT = listOfOutTensors.at(idx);
+                    maxT.assign(listOfTensors.at(i));
                 }
 
             }
-            delete listOfTensors;
-            delete listOfOutTensors;
         }
     }
 
@@ -109,27 +110,27 @@ namespace helpers {
             for (int e = 1; e < loop_length; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfTensors( input->allTensorsAlongDimension(restDims) );
-            std::unique_ptr<ResultSet> listOfOutTensors( output->allTensorsAlongDimension(restDims) );
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             int numOfClasses = output->sizeAt(0); // number of classes
             std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto minT = listOfOutTensors->at(idx);
+            auto minT = listOfOutTensors.at(idx);
 
             int pos = 0;
-            minT->assign(listOfTensors->at(0));
+            minT.assign(listOfTensors.at(0));
 
             for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
                 if (indices->e<T>(i) == idx) {
 
-                    for (int e = 0; e < minT->lengthOf(); e++) {
-                       minT->p(e, nd4j::math::nd4j_min(minT->e<T>(e), listOfTensors->at(i)->e<T>(e)));
+                    for (int e = 0; e < minT.lengthOf(); e++) {
+                       minT.p(e, nd4j::math::nd4j_min(minT.e<T>(e), listOfTensors.at(i).e<T>(e)));
                     }
                 }
                 else {
                     idx = indices->e<T>(i);
-                    minT = listOfOutTensors->at(idx);
-                    minT->assign(listOfTensors->at(i));
+                    minT = listOfOutTensors.at(idx);
+                    minT.assign(listOfTensors.at(i));
                 }
             }
         }
@@ -167,37 +168,35 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             int numOfClasses = output->sizeAt(0); // number of classes
             std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto meanT = listOfOutTensors->at(idx);
+            auto meanT = listOfOutTensors.at(idx);
             int count = 1;
-            auto meanV = meanT->dup();
-            meanV->assign(listOfTensors->at(0));
+            auto meanV = meanT.dup();
+            meanV->assign(listOfTensors.at(0));
 
             for (int i = 1; i < indices->lengthOf(); i++) {
                 if (indices->e<int>(i) == idx) {
                     PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < meanT->lengthOf(); e++) {
-                       meanV->p<T>(e, meanV->e<T>(e) + listOfTensors->at(i)->e<T>(e));
+                    for (int e = 0; e < meanT.lengthOf(); e++) {
+                       meanV->p<T>(e, meanV->e<T>(e) + listOfTensors.at(i).e<T>(e));
                     }
                     count++;
                 }
                 else {
-                    //meanT->assign(meanV);
-                    meanV->applyScalar(scalar::Divide, count, meanT, nullptr);
+                    //meanT.assign(meanV);
+                    meanV->applyScalar(scalar::Divide, count, &meanT, nullptr);
                     idx = indices->e<int>(i);
-                    meanT = listOfOutTensors->at(idx);
-                    meanV->assign(listOfTensors->at(i));
+                    meanT = listOfOutTensors.at(idx);
+                    meanV->assign(listOfTensors.at(i));
                     count = 1;
                 }
-                meanV->applyScalar(scalar::Divide, count, meanT, nullptr);
+                meanV->applyScalar(scalar::Divide, count, &meanT, nullptr);
             }
             delete meanV;
-            delete listOfTensors;
-            delete listOfOutTensors;
         }
     }
 
@@ -228,28 +227,26 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             int numOfClasses = output->sizeAt(0); // number of classes
             std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto sumT = listOfOutTensors->at(idx);
+            auto sumT = listOfOutTensors.at(idx);
 
             for (int i = 0; i < indices->lengthOf(); i++) {
                 if (indices->e<int>(i) == idx) {
                     PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < sumT->lengthOf(); e++) {
-                       sumT->p(e, sumT->e<T>(e) + listOfTensors->at(i)->e<T>(e));
+                    for (int e = 0; e < sumT.lengthOf(); e++) {
+                       sumT.p(e, sumT.e<T>(e) + listOfTensors.at(i).e<T>(e));
                     }
                 }
                 else {
                     idx = indices->e<int>(i);
-                    sumT = listOfOutTensors->at(idx);
-                    sumT->assign(listOfTensors->at(i));
+                    sumT = listOfOutTensors.at(idx);
+                    sumT.assign(listOfTensors.at(i));
                 }
             }
-            delete listOfTensors;
-            delete listOfOutTensors;
         }
     }
 
@@ -282,27 +279,25 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             int numOfClasses = output->sizeAt(0); // number of classes
-            auto sumT = listOfOutTensors->at(idx);
-            sumT->assign(listOfTensors->at(0));
+            auto sumT = listOfOutTensors.at(idx);
+            sumT.assign(listOfTensors.at(0));
             for (int i = 1; i < indices->lengthOf(); i++) {
                 if (indices->e<int>(i)  == idx) {
                     PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < sumT->lengthOf(); e++) {
-                       sumT->p(e, sumT->e<T>(e) * listOfTensors->at(i)->e<T>(e));
+                    for (int e = 0; e < sumT.lengthOf(); e++) {
+                       sumT.p(e, sumT.e<T>(e) * listOfTensors.at(i).e<T>(e));
                     }
                 }
                 else {
                     idx = indices->e<int>(i);
-                    sumT = listOfOutTensors->at(idx);
-                    sumT->assign(listOfTensors->at(i));
+                    sumT = listOfOutTensors.at(idx);
+                    sumT.assign(listOfTensors.at(i));
                 }
             }
-            delete listOfTensors;
-            delete listOfOutTensors;
         }
     }
 
@@ -352,6 +347,47 @@ namespace helpers {
     // Unsorted segment ops
     // -------------------------------------------------------------------------------------------------------------- //
 
+    // rows of input grouped by class with counting sort: exclusive scan of class sizes gives offsets of groups,
+    // rows within each group keep ascending order. Indices out of [0, numOfClasses) range are ignored
+    class SegmentGroups {
+    private:
+        std::vector<Nd4jLong> _offsets;
+        std::vector<Nd4jLong> _rows;
+
+    public:
+        SegmentGroups(NDArray* indices, Nd4jLong numOfClasses) : _offsets(numOfClasses + 1, 0) {
+            const Nd4jLong length = indices->lengthOf();
+            std::vector<Nd4jLong> classes(length);
+
+            for (Nd4jLong e = 0; e < length; ++e) {
+                classes[e] = indices->e<Nd4jLong>(e);
+                if (classes[e] >= 0 && classes[e] < numOfClasses)
+                    _offsets[classes[e]]++;
+            }
+
+            const Nd4jLong total = PrefixScan::scan<Nd4jLong, scan::Add<Nd4jLong>>(_offsets.data(), _offsets.data(), numOfClasses + 1, true);
+            _rows.resize(total);
+
+            std::vector<Nd4jLong> cursors(_offsets.begin(), _offsets.end() - 1);
+            for (Nd4jLong e = 0; e < length; ++e)
+                if (classes[e] >= 0 && classes[e] < numOfClasses)
+                    _rows[cursors[classes[e]]++] = e;
+        }
+
+        Nd4jLong classes() const {
+            return static_cast<Nd4jLong>(_offsets.size()) - 1;
+        }
+
+        Nd4jLong size(Nd4jLong c) const {
+            return _offsets[c + 1] - _offsets[c];
+        }
+
+        // index of i-th row of class c
+        Nd4jLong at(Nd4jLong c, Nd4jLong i) const {
+            return _rows[_offsets[c] + i];
+        }
+    };
+
     bool unsortedSegmentIndicesValidate(NDArray* indices, Nd4jLong expected, Nd4jLong& output) {
         Nd4jLong val = indices->e<Nd4jLong>(0);
 
@@ -369,50 +405,51 @@ namespace helpers {
 
         // if input is a vector: (as if in doc sample)
         //int idx = static_cast<int>((*indices)(0.));
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
+        SegmentGroups idxs(indices, numOfClasses);
 
         if (input->isVector()) { // 1D case
             T maxVal = DataTypeUtils::max<T>();
             output->assign(-maxVal);
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T val = input->e<T>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    val = nd4j::math::nd4j_max(val, input->e<T>(fi->second.at(idx)));
+            for (Nd4jLong fi = 0; fi < idxs.classes(); ++fi) {
+                if (idxs.size(fi) == 0)
+                    continue;
+
+                T val = input->e<T>(idxs.at(fi, 0));
+                for (Nd4jLong idx = 1; idx < idxs.size(fi); ++idx) {
+                    val = nd4j::math::nd4j_max(val, input->e<T>(idxs.at(fi, idx)));
                 }
-                output->p(fi->first, val);
+                output->p(fi, val);
             }
         }
         else {
             std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong idx = idxs[0][0];
             int loop_size = input->rankOf();
             PRAGMA_OMP_SIMD
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             T maxVal = DataTypeUtils::max<T>();
             output->assign(-maxVal);
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto maxT = listOfTensors->at(fi->second.at(idx));
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        T val = nd4j::math::nd4j_max(maxT->e<T>(e), outputT->e<T>(e));
+            for (Nd4jLong fi = 0; fi < idxs.classes(); ++fi) {
+                if (idxs.size(fi) == 0)
+                    continue;
+
+                auto outputT = listOfOutTensors.at(fi);
+                outputT.assign(listOfTensors.at(idxs.at(fi, 0)));
+                for (Nd4jLong idx = 1; idx < idxs.size(fi); ++idx) {
+                    auto maxT = listOfTensors.at(idxs.at(fi, idx));
+                    for (Nd4jLong e = 0; e < outputT.lengthOf(); ++e) {
+                        T val = nd4j::math::nd4j_max(maxT.e<T>(e), outputT.e<T>(e));
 
-                        outputT->p(e, val);
+                        outputT.p(e, val);
                     }
                 }
-                //outputT->assign(maxT);
+                //outputT.assign(maxT);
             }
         }
     }
@@ -425,49 +462,49 @@ namespace helpers {
     static void unsortedSegmentMinFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
         // if input is a vector: (as if in doc sample)
         //int idx = static_cast<int>((*indices)(0.));
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
+        SegmentGroups idxs(indices, numOfClasses);
 
         if (input->isVector()) { // 1D case
             T maxVal = DataTypeUtils::max<T>();
             output->assign(maxVal);
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T val = input->t<T>(fi->second.at(0));
+            for (Nd4jLong fi = 0; fi < idxs.classes(); ++fi) {
+                if (idxs.size(fi) == 0)
+                    continue;
+
+                T val = input->t<T>(idxs.at(fi, 0));
 
-                for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                    val = nd4j::math::nd4j_min(val, input->t<T>(fi->second.at(idx)));
+                for (size_t idx = 1; idx < idxs.size(fi); ++idx) {
+                    val = nd4j::math::nd4j_min(val, input->t<T>(idxs.at(fi, idx)));
                 }
-                output->t<T>(fi->first) = val;
+                output->t<T>(fi) = val;
             }
         }
         else {
             std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong idx = idxs[0][0];
             for (int e = 1; e < input->rankOf(); e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             T maxVal = DataTypeUtils::max<T>();
             output->assign(maxVal);
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto minT = listOfTensors->at(fi->second.at(idx));
+            for (Nd4jLong fi = 0; fi < idxs.classes(); ++fi) {
+                if (idxs.size(fi) == 0)
+                    continue;
 
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        outputT->t<T>(e) = nd4j::math::nd4j_min(minT->t<T>(e), outputT->t<T>(e));
+                auto outputT = listOfOutTensors.at(fi);
+                outputT.assign(listOfTensors.at(idxs.at(fi, 0)));
+                for (Nd4jLong idx = 1; idx < idxs.size(fi); ++idx) {
+                    auto minT = listOfTensors.at(idxs.at(fi, idx));
+
+                    for (Nd4jLong e = 0; e < outputT.lengthOf(); ++e) {
+                        outputT.t<T>(e) = nd4j::math::nd4j_min(minT.t<T>(e), outputT.t<T>(e));
                     }
                 }
-                //outputT->assign(maxT);
+                //outputT.assign(maxT);
             }
         }
 
@@ -480,23 +517,22 @@ namespace helpers {
     BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMinFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     void unsortedSegmentMeanFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
+        SegmentGroups idxs(indices, numOfClasses);
 
         if (input->isVector()) { // 1D case
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                int loop_size = fi->second.size();
+            for (Nd4jLong fi = 0; fi < idxs.classes(); ++fi) {
+                if (idxs.size(fi) == 0)
+                    continue;
+
+                double sumValue = input->e<double>(idxs.at(fi, 0));
+                int loop_size = idxs.size(fi);
                 PRAGMA_OMP_PARALLEL_FOR_SIMD_REDUCTION(+:sumValue)
                 for (size_t idx = 1; idx < loop_size; ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
+                    sumValue += input->e<double>(idxs.at(fi, idx));
                 }
 
-                output->p(fi->first, sumValue / fi->second.size());
+                output->p(fi, sumValue / idxs.size(fi));
             }
         }
         else {
@@ -505,38 +541,42 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
+
+            for (Nd4jLong fi = 0; fi < idxs.classes(); ++fi) {
+                if (idxs.size(fi) == 0)
+                    continue;
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                loop_size = fi->second.size();
+                auto outputT = listOfOutTensors.at(fi);
+                outputT.assign(listOfTensors.at(idxs.at(fi, 0)));
+                loop_size = idxs.size(fi);
                 PRAGMA_OMP_PARALLEL_FOR
                 for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *outputT += *current;
+                    auto current = listOfTensors.at(idxs.at(fi, idx));
+                    outputT += current;
                 }
-                (*outputT) /= double(fi->second.size());
+                outputT /= double(idxs.size(fi));
             }
         }
     }
 
     void unsortedSegmentSumFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
+        SegmentGroups idxs(indices, numOfClasses);
 
         if (input->isVector()) { // 1D case
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                Nd4jLong loop_size = fi->second.size();
+            for (Nd4jLong fi = 0; fi < idxs.classes(); ++fi) {
+                if (idxs.size(fi) == 0)
+                    continue;
+
+                double sumValue = input->e<double>(idxs.at(fi, 0));
+                Nd4jLong loop_size = idxs.size(fi);
                 PRAGMA_OMP_PARALLEL_FOR_REDUCTION(+:sumValue)
                 for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
+                    sumValue += input->e<double>(idxs.at(fi, idx));
                 }
-                output->p(fi->first, sumValue);
+                output->p(fi, sumValue);
             }
         }
         else {
@@ -545,40 +585,42 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                Nd4jLong loop_size = fi->second.size();
+            for (Nd4jLong fi = 0; fi < idxs.classes(); ++fi) {
+                if (idxs.size(fi) == 0)
+                    continue;
+
+                auto outputT = listOfOutTensors.at(fi);
+                outputT.assign(listOfTensors.at(idxs.at(fi, 0)));
+                Nd4jLong loop_size = idxs.size(fi);
                 PRAGMA_OMP_PARALLEL_FOR
                 for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *(outputT) += *current;
+                    auto current = listOfTensors.at(idxs.at(fi, idx));
+                    outputT += current;
                 }
-                //outputT->assign(maxT);
+                //outputT.assign(maxT);
             }
         }
     }
 
     template <typename T>
     void unsortedSegmentProdFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
+        SegmentGroups idxs(indices, numOfClasses);
 
         output->assign(1.f);
 
         if (input->isVector()) { // 1D case
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T prodValue = input->e<T>(fi->second.at(0));
-                for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                    prodValue *= input->e<T>(fi->second.at(idx));
+            for (Nd4jLong fi = 0; fi < idxs.classes(); ++fi) {
+                if (idxs.size(fi) == 0)
+                    continue;
+
+                T prodValue = input->e<T>(idxs.at(fi, 0));
+                for (size_t idx = 1; idx < idxs.size(fi); ++idx) {
+                    prodValue *= input->e<T>(idxs.at(fi, idx));
                 }
-                output->p(fi->first, prodValue);
+                output->p(fi, prodValue);
             }
         }
         else {
@@ -587,16 +629,19 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
+
+            for (Nd4jLong fi = 0; fi < idxs.classes(); ++fi) {
+                if (idxs.size(fi) == 0)
+                    continue;
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
+                auto outputT = listOfOutTensors.at(fi);
+                outputT.assign(listOfTensors.at(idxs.at(fi, 0)));
+                for (Nd4jLong idx = 1; idx < idxs.size(fi); ++idx) {
+                    auto current = listOfTensors.at(idxs.at(fi, idx));
 
-                    *outputT *= *current;
+                    outputT *= current;
                 }
             }
         }
@@ -608,19 +653,18 @@ namespace helpers {
     BUILD_SINGLE_TEMPLATE(template void unsortedSegmentProdFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     void unsortedSegmentSqrtNFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
+        SegmentGroups idxs(indices, numOfClasses);
 
         if (input->isVector()) { // 1D case
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
+            for (Nd4jLong fi = 0; fi < idxs.classes(); ++fi) {
+                if (idxs.size(fi) == 0)
+                    continue;
+
+                double sumValue = input->e<double>(idxs.at(fi, 0));
+                for (Nd4jLong idx = 1; idx < idxs.size(fi); ++idx) {
+                    sumValue += input->e<double>(idxs.at(fi, idx));
                 }
-                output->p(fi->first, sumValue / nd4j::math::nd4j_sqrt<Nd4jLong, double>(fi->second.size()));
+                output->p(fi, sumValue / nd4j::math::nd4j_sqrt<Nd4jLong, double>(idxs.size(fi)));
             }
         }
         else {
@@ -630,18 +674,21 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
+
+            for (Nd4jLong fi = 0; fi < idxs.classes(); ++fi) {
+                if (idxs.size(fi) == 0)
+                    continue;
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *outputT += *current;
+                auto outputT = listOfOutTensors.at(fi);
+                outputT.assign(listOfTensors.at(idxs.at(fi, 0)));
+                for (Nd4jLong idx = 1; idx < idxs.size(fi); ++idx) {
+                    auto current = listOfTensors.at(idxs.at(fi, idx));
+                    outputT += current;
                 }
-                //outputT->assign(maxT);
-                (*outputT) /= nd4j::math::nd4j_sqrt<size_t, double>(fi->second.size());
+                //outputT.assign(maxT);
+                outputT /= nd4j::math::nd4j_sqrt<size_t, double>(idxs.size(fi));
             }
         }
     }
@@ -674,10 +721,10 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfBPTensors(*tempRes, restDims);
+            TadSet listOfGradOuts(*gradOut, restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             //int numOfClasses = tempRes->sizeAt(0); // number of classes
             //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
@@ -687,13 +734,13 @@ namespace helpers {
             PRAGMA_OMP_PARALLEL_FOR
             for (Nd4jLong i = 0; i < indices->lengthOf(); i++) {
                 Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
+                auto current = listOfTensors.at(i);
+                auto currentOut = listOfOutTensors.at(i);
+                auto currentGradOut = listOfGradOuts.at(classNum);
 
-                for (Nd4jLong e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->e<T>(e) - current->e<T>(e)) <= T(1.e-6))
-                        currentOut->p(e, currentGradOut->e<T>(e));
+                for (Nd4jLong e = 0; e < current.lengthOf(); e++) {
+                    if (nd4j::math::nd4j_abs(listOfBPTensors.at(classNum).e<T>(e) - current.e<T>(e)) <= T(1.e-6))
+                        currentOut.p(e, currentGradOut.e<T>(e));
                 }
             }
         }
@@ -724,10 +771,10 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfBPTensors(*tempRes, restDims);
+            TadSet listOfGradOuts(*gradOut, restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             //int numOfClasses = tempRes->sizeAt(0); // number of classes
             //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
@@ -737,12 +784,12 @@ namespace helpers {
             PRAGMA_OMP_PARALLEL_FOR
             for (int i = 0; i < indices->lengthOf(); i++) {
                 Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->e<double>(e) - current->e<double>(e)) < 1.e-5)
-                        currentOut->p(e, currentGradOut->e<double>(e));
+                auto current = listOfTensors.at(i);
+                auto currentOut = listOfOutTensors.at(i);
+                auto currentGradOut = listOfGradOuts.at(classNum);
+                for (int e = 0; e < current.lengthOf(); e++) {
+                    if (nd4j::math::nd4j_abs(listOfBPTensors.at(classNum).e<double>(e) - current.e<double>(e)) < 1.e-5)
+                        currentOut.p(e, currentGradOut.e<double>(e));
                 }
             }
         }
@@ -775,9 +822,9 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfGradOuts(*gradOut, restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             //int numOfClasses = tempRes->sizeAt(0); // number of classes
             //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
@@ -786,12 +833,12 @@ namespace helpers {
             PRAGMA_OMP_PARALLEL_FOR
             for (int i = 0; i < indices->lengthOf(); i++) {
                 Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
+                auto current = listOfTensors.at(i);
+                auto currentOut = listOfOutTensors.at(i);
+                auto currentGradOut = listOfGradOuts.at(classNum);
 
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    currentOut->p(e, currentGradOut->e<double>(e) / classCount[classNum]);
+                for (int e = 0; e < current.lengthOf(); e++) {
+                    currentOut.p(e, currentGradOut.e<double>(e) / classCount[classNum]);
                 }
             }
         }
@@ -814,17 +861,17 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfGradOuts(*gradOut, restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             PRAGMA_OMP_PARALLEL_FOR
             for (int i = 0; i < indices->lengthOf(); i++) {
                 Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                currentOut->assign(currentGradOut);
+                auto current = listOfTensors.at(i);
+                auto currentOut = listOfOutTensors.at(i);
+                auto currentGradOut = listOfGradOuts.at(classNum);
+                currentOut.assign(currentGradOut);
             }
         }
         return ND4J_STATUS_OK;
@@ -845,10 +892,10 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfBPTensors(*tempRes, restDims);
+            TadSet listOfGradOuts(*gradOut, restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             //int numOfClasses = tempRes->sizeAt(0); // number of classes
             //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
@@ -856,12 +903,12 @@ namespace helpers {
             PRAGMA_OMP_PARALLEL_FOR
             for (int i = 0; i < indices->lengthOf(); i++) {
                 Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                NDArray* currentFFOut = listOfBPTensors->at(classNum);
+                auto current = listOfTensors.at(i);
+                auto currentOut = listOfOutTensors.at(i);
+                auto currentGradOut = listOfGradOuts.at(classNum);
+                auto currentFFOut = listOfBPTensors.at(classNum);
 
-                currentOut->assign((*currentFFOut) * (*currentGradOut) / (*current));
+                currentOut.assign(currentFFOut * currentGradOut / current);
             }
         }
         delete tempRes;
@@ -891,19 +938,19 @@ namespace helpers {
             for (int e = 1; e < input->rankOf(); e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfBPTensors(*tempRes, restDims);
+            TadSet listOfGradOuts(*gradOut, restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             for (int i = 0; i < indices->lengthOf(); i++) {
                 Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->e<double>(e) - current->e<double>(e)) < 1.e-5)
-                        currentOut->p(e, currentGradOut->e<T>(e));
+                auto current = listOfTensors.at(i);
+                auto currentOut = listOfOutTensors.at(i);
+                auto currentGradOut = listOfGradOuts.at(classNum);
+                for (int e = 0; e < current.lengthOf(); e++) {
+                    if (nd4j::math::nd4j_abs(listOfBPTensors.at(classNum).e<double>(e) - current.e<double>(e)) < 1.e-5)
+                        currentOut.p(e, currentGradOut.e<T>(e));
                 }
             }
         }
@@ -935,10 +982,10 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfBPTensors(*tempRes, restDims);
+            TadSet listOfGradOuts(*gradOut, restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             //int numOfClasses = tempRes->sizeAt(0); // number of classes
             //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
@@ -946,13 +993,13 @@ namespace helpers {
             PRAGMA_OMP_PARALLEL_FOR
             for (int i = 0; i < indices->lengthOf(); i++) {
                 Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
+                auto current = listOfTensors.at(i);
+                auto currentOut = listOfOutTensors.at(i);
+                auto currentGradOut = listOfGradOuts.at(classNum);
 
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->t<T>(e) - current->t<T>(e)) < 1.e-6)
-                        currentOut->t<T>(e) = currentGradOut->t<T>(e);
+                for (int e = 0; e < current.lengthOf(); e++) {
+                    if (nd4j::math::nd4j_abs(listOfBPTensors.at(classNum).t<T>(e) - current.t<T>(e)) < 1.e-6)
+                        currentOut.t<T>(e) = currentGradOut.t<T>(e);
                 }
             }
         }
@@ -989,16 +1036,16 @@ namespace helpers {
             for (int e = 1; e < input->rankOf(); e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfGradOuts(*gradOut, restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             for (int i = 0; i < indices->lengthOf(); i++) {
                 Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                currentOut->assign(*currentGradOut / double(classCount[classNum]));
+                auto current = listOfTensors.at(i);
+                auto currentOut = listOfOutTensors.at(i);
+                auto currentGradOut = listOfGradOuts.at(classNum);
+                currentOut.assign(currentGradOut / double(classCount[classNum]));
             }
         }
         return ND4J_STATUS_OK;
@@ -1020,18 +1067,18 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfGradOuts(*gradOut, restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             PRAGMA_OMP_PARALLEL_FOR
             for (int i = 0; i < indices->lengthOf(); i++) {
                 Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                //NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
+                //auto current = listOfTensors.at(i);
+                auto currentOut = listOfOutTensors.at(i);
+                auto currentGradOut = listOfGradOuts.at(classNum);
 
-                currentOut->assign(currentGradOut);
+                currentOut.assign(currentGradOut);
             }
         }
         return ND4J_STATUS_OK;
@@ -1054,20 +1101,20 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfBPTensors(*tempRes, restDims);
+            TadSet listOfGradOuts(*gradOut, restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             PRAGMA_OMP_PARALLEL_FOR
             for (int i = 0; i < indices->lengthOf(); i++) {
                 Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                auto currentFFOut = listOfBPTensors->at(classNum);
+                auto current = listOfTensors.at(i);
+                auto currentOut = listOfOutTensors.at(i);
+                auto currentGradOut = listOfGradOuts.at(classNum);
+                auto currentFFOut = listOfBPTensors.at(classNum);
 
-                currentOut->assign((*currentFFOut) * (*currentGradOut) / (*current));
+                currentOut.assign(currentFFOut * currentGradOut / current);
             }
         }
         delete tempRes;
@@ -1100,9 +1147,9 @@ namespace helpers {
             for (int e = 1; e < loop_size; e++)
                 restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
+            TadSet listOfGradOuts(*gradOut, restDims);
+            TadSet listOfTensors(*input, restDims);
+            TadSet listOfOutTensors(*output, restDims);
 
             //int numOfClasses = tempRes->sizeAt(0); // number of classes
             //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
@@ -1110,12 +1157,12 @@ namespace helpers {
             PRAGMA_OMP_PARALLEL_FOR
             for (int i = 0; i < indices->lengthOf(); i++) {
                 Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
+                auto current = listOfTensors.at(i);
+                auto currentOut = listOfOutTensors.at(i);
+                auto currentGradOut = listOfGradOuts.at(classNum);
 
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    currentOut->p(e, currentGradOut->e<double>(e) / nd4j::math::nd4j_sqrt<double,double>(classCount[classNum]));
+                for (int e = 0; e < current.lengthOf(); e++) {
+                    currentOut.p(e, currentGradOut.e<double>(e) / nd4j::math::nd4j_sqrt<double,double>(classCount[classNum]));
                 }
             }
         }
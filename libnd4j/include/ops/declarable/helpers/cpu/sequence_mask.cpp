@@ -26,11 +26,18 @@ namespace helpers {
 
     template <typename T>
     static void sequenceMask_(NDArray* input, NDArray* output, int maxIndex) {
-        PRAGMA_OMP_PARALLEL_FOR_SIMD_COLLAPSE(2)
-        for (Nd4jLong i = 0; i < maxIndex; i++)
-            for(Nd4jLong k = 0; k < input->lengthOf(); k++)
-                if (i < input->e<int>(k))
-                    output->p<T>(k * maxIndex + i,  T(1.0f));
+        // every row of mask is a run of ones followed by a run of zeros, so it's filled row by row with both runs
+        const Nd4jLong numOfRows = input->lengthOf();
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numOfRows * maxIndex > Environment::getInstance()->elementwiseThreshold())
+        for(Nd4jLong k = 0; k < numOfRows; k++) {
+            const Nd4jLong ones = nd4j::math::nd4j_max<Nd4jLong>(0, nd4j::math::nd4j_min<Nd4jLong>(maxIndex, input->e<Nd4jLong>(k)));
+
+            for (Nd4jLong i = 0; i < ones; i++)
+                output->p<T>(k * maxIndex + i, T(1.0f));
+            for (Nd4jLong i = ones; i < maxIndex; i++)
+                output->p<T>(k * maxIndex + i, T(0.0f));
+        }
     }
 
     void sequenceMask(NDArray* input, NDArray* output, int maxIndex) {
@@ -0,0 +1,318 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Batched Hogwild word2vec engine, see word2vecBatch() in helpers/sg_cb.h
+//
+// Rows of a group share output block, so the group is G x K problem instead of G separate dot/axpy chains:
+//     scores = hidden * outputs^T, gradients from expTable, dHidden = gradients * outputs, dOutputs = gradients^T * hidden
+// Output rows are read once per group, before any update, i.e. updates of one group become visible to the next one only,
+// same as with Hogwild updates coming from other threads.
+//
+
+#include <ops/declarable/helpers/sg_cb.h>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#define HS_MAX_EXP 6.0f
+
+namespace nd4j {
+    namespace ops {
+        namespace helpers {
+
+            // C[m, n] = A[m, k] * B[n, k]^T
+            template <typename T>
+            static void gemmNT(const int m, const int n, const int k, const T* a, const T* b, T* c) {
+                for (int i = 0; i < m; i++) {
+                    for (int j = 0; j < n; j++) {
+                        T dot = (T) 0.0f;
+                        for (int e = 0; e < k; e++)
+                            dot += a[i * k + e] * b[j * k + e];
+
+                        c[i * n + j] = dot;
+                    }
+                }
+            }
+
+            // C[m, n] = A[m, k] * B[k, n]
+            template <typename T>
+            static void gemmNN(const int m, const int n, const int k, const T* a, const T* b, T* c) {
+                memset(c, 0, m * n * sizeof(T));
+
+                for (int i = 0; i < m; i++) {
+                    for (int p = 0; p < k; p++) {
+                        const T v = a[i * k + p];
+                        if (v == (T) 0.0f)
+                            continue;
+
+                        PRAGMA_OMP_SIMD
+                        for (int j = 0; j < n; j++)
+                            c[i * n + j] += v * b[p * n + j];
+                    }
+                }
+            }
+
+            // C[m, n] = A[k, m]^T * B[k, n]
+            template <typename T>
+            static void gemmTN(const int m, const int n, const int k, const T* a, const T* b, T* c) {
+                memset(c, 0, m * n * sizeof(T));
+
+                for (int p = 0; p < k; p++) {
+                    for (int i = 0; i < m; i++) {
+                        const T v = a[p * m + i];
+                        if (v == (T) 0.0f)
+                            continue;
+
+                        PRAGMA_OMP_SIMD
+                        for (int j = 0; j < n; j++)
+                            c[i * n + j] += v * b[p * n + j];
+                    }
+                }
+            }
+
+            // gradient multiplier for given dot product, same rules as hSoftmax_ and nSampling_
+            template <typename T>
+            static FORCEINLINE T gradientOf(const T dot, const T label, const bool hierarchic, const double alpha, const T* expTable, const int expLength) {
+                if (hierarchic) {
+                    if (dot < (T) -HS_MAX_EXP || dot >= (T) HS_MAX_EXP)
+                        return (T) 0.0f;
+                } else {
+                    if (dot > (T) HS_MAX_EXP)
+                        return (label - (T) 1.0f) * (T) alpha;
+
+                    if (dot < (T) -HS_MAX_EXP)
+                        return label * (T) alpha;
+                }
+
+                int idx = static_cast<int>((dot + (T) HS_MAX_EXP) * ((T) expLength / HS_MAX_EXP / 2.0f));
+                if (idx >= expLength || idx < 0)
+                    return (T) 0.0f;
+
+                return (label - expTable[idx]) * (T) alpha;
+            }
+
+            template <typename T>
+            static Nd4jLong word2vecBatch_(NDArray &s0, NDArray &s1, NDArray &s1n, NDArray &vexpTable, NDArray &vnegTable, NDArray &inputs, NDArray &lockedRows, NDArray &positives, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, const int nsRounds, const int maxGroupSize, const int numThreads) {
+                const int vectorLength = s0.sizeAt(1);
+                const Nd4jLong inputRows = s0.sizeAt(0);
+
+                const bool useHs = !indices.isEmpty() && !codes.isEmpty() && !s1.isEmpty();
+                const bool useNs = !positives.isEmpty() && nsRounds > 0 && !s1n.isEmpty() && !vnegTable.isEmpty();
+
+                const int numExamples = inputs.rankOf() == 2 ? inputs.sizeAt(0) : inputs.lengthOf();
+                const int inputWidth = inputs.rankOf() == 2 ? inputs.sizeAt(1) : 1;
+                const int hsWidth = useHs ? (indices.rankOf() == 2 ? indices.sizeAt(1) : indices.lengthOf() / numExamples) : 0;
+
+                const auto syn0 = s0.bufferAsT<T>();
+                const auto syn1 = useHs ? s1.bufferAsT<T>() : nullptr;
+                const auto syn1Neg = useNs ? s1n.bufferAsT<T>() : nullptr;
+                const auto expTable = vexpTable.bufferAsT<T>();
+                const auto negTable = useNs ? vnegTable.bufferAsT<T>() : nullptr;
+                const int expLength = vexpTable.lengthOf();
+                const int negLength = useNs ? vnegTable.lengthOf() : 0;
+                const int hsVocab = useHs ? s1.sizeAt(0) : 0;
+                const int nsVocab = useNs ? s1n.sizeAt(0) : 0;
+
+                const auto bInputs = inputs.bufferAsT<int>();
+                const auto bLocked = lockedRows.isEmpty() ? nullptr : lockedRows.bufferAsT<int>();
+                const auto bPositives = useNs ? positives.bufferAsT<int>() : nullptr;
+                const auto bIndices = useHs ? indices.bufferAsT<int>() : nullptr;
+                const auto bCodes = useHs ? codes.bufferAsT<int8_t>() : nullptr;
+
+                // validation goes first, so nothing is thrown from parallel region
+                for (Nd4jLong e = 0; e < (Nd4jLong) numExamples * inputWidth; e++)
+                    if (bInputs[e] >= inputRows)
+                        throw std::runtime_error("word2vecBatch: input row can't be >= number of syn0 rows");
+
+                for (Nd4jLong e = 0; useHs && e < (Nd4jLong) numExamples * hsWidth; e++)
+                    if (bIndices[e] >= hsVocab)
+                        throw std::runtime_error("word2vecBatch: index can't be >= vocab size");
+
+                for (int e = 0; useNs && e < numExamples; e++)
+                    if (bPositives[e] >= nsVocab)
+                        throw std::runtime_error("word2vecBatch: positive word can't be >= vocab size");
+
+                // consecutive examples with the same positive word and hs path share output rows
+                std::vector<int> groups;
+                for (int e = 0; e < numExamples; e++) {
+                    bool sameOutputs = !groups.empty() && e - groups.back() < maxGroupSize;
+                    if (sameOutputs && useNs)
+                        sameOutputs = bPositives[e] == bPositives[groups.back()];
+
+                    if (sameOutputs && useHs)
+                        sameOutputs = memcmp(bIndices + e * hsWidth, bIndices + groups.back() * hsWidth, hsWidth * sizeof(int)) == 0 &&
+                                      memcmp(bCodes + e * hsWidth, bCodes + groups.back() * hsWidth, hsWidth * sizeof(int8_t)) == 0;
+
+                    if (!sameOutputs)
+                        groups.emplace_back(e);
+                }
+
+                const int numGroups = groups.size();
+                groups.emplace_back(numExamples);
+
+                const int maxOutputs = hsWidth + (useNs ? nsRounds + 1 : 0);
+                std::atomic<int> nextGroup;
+                nextGroup.store(0);
+
+                PRAGMA_OMP_PARALLEL_THREADS(numThreads)
+                {
+                    // per-thread scratch, reused for every group this thread takes
+                    std::vector<T> hidden(maxGroupSize * vectorLength), dHidden(maxGroupSize * vectorLength);
+                    std::vector<T> outputs(maxOutputs * vectorLength), dOutputs(maxOutputs * vectorLength);
+                    std::vector<T> scores(maxGroupSize * maxOutputs);
+                    std::vector<T*> rows(maxOutputs);
+                    std::vector<T> labels(maxOutputs);
+                    std::vector<bool> hierarchic(maxOutputs);
+                    std::vector<bool> valid(maxGroupSize);
+
+                    // groups are taken dynamically, there's no row ownership between threads
+                    for (int group = nextGroup++; group < numGroups; group = nextGroup++) {
+                        const int first = groups[group];
+                        const int groupSize = groups[group + 1] - first;
+
+                        // gathering output rows: hs path, then positive word and negatives
+                        int numOutputs = 0;
+                        for (int h = 0; h < hsWidth; h++) {
+                            const int irow = bIndices[first * hsWidth + h];
+                            if (irow < 0)
+                                continue;
+
+                            rows[numOutputs] = syn1 + irow * vectorLength;
+                            labels[numOutputs] = (T) (1 - bCodes[first * hsWidth + h]);
+                            hierarchic[numOutputs++] = true;
+                        }
+
+                        if (useNs && bPositives[first] >= 0) {
+                            const int nsStarter = bPositives[first];
+                            rows[numOutputs] = syn1Neg + nsStarter * vectorLength;
+                            labels[numOutputs] = (T) 1.0f;
+                            hierarchic[numOutputs++] = false;
+
+                            unsigned long long randomValue = nextRandom.e<Nd4jLong>(first);
+                            for (int r = 0; r < nsRounds; r++) {
+                                randomValue = randomValue * (unsigned long long) 25214903917 + 11;
+                                auto idx = nd4j::math::nd4j_abs<Nd4jLong>((randomValue >> 16) % negLength);
+                                int irow = idx >= negLength ? -1 : static_cast<int>(negTable[idx]);
+
+                                if (irow < 0 || irow >= nsVocab)
+                                    irow = randomValue % (nsVocab - 1) + 1;
+
+                                if (irow == nsStarter)
+                                    continue;
+
+                                rows[numOutputs] = syn1Neg + irow * vectorLength;
+                                labels[numOutputs] = (T) 0.0f;
+                                hierarchic[numOutputs++] = false;
+                            }
+                        }
+
+                        if (numOutputs == 0)
+                            continue;
+
+                        for (int k = 0; k < numOutputs; k++)
+                            memcpy(outputs.data() + k * vectorLength, rows[k], vectorLength * sizeof(T));
+
+                        // hidden vectors: mean of input rows
+                        for (int g = 0; g < groupSize; g++) {
+                            auto h = hidden.data() + g * vectorLength;
+                            memset(h, 0, vectorLength * sizeof(T));
+
+                            int count = 0;
+                            for (int c = 0; c < inputWidth; c++) {
+                                const int irow = bInputs[(first + g) * inputWidth + c];
+                                if (irow < 0)
+                                    continue;
+
+                                auto syn0row = syn0 + (Nd4jLong) irow * vectorLength;
+
+                                PRAGMA_OMP_SIMD
+                                for (int e = 0; e < vectorLength; e++)
+                                    h[e] += syn0row[e];
+
+                                count++;
+                            }
+
+                            if (count > 1) {
+                                const T scale = (T) 1.0f / (T) count;
+
+                                PRAGMA_OMP_SIMD
+                                for (int e = 0; e < vectorLength; e++)
+                                    h[e] *= scale;
+                            }
+
+                            valid[g] = count > 0;
+                        }
+
+                        gemmNT<T>(groupSize, numOutputs, vectorLength, hidden.data(), outputs.data(), scores.data());
+
+                        // scores become gradients in place
+                        for (int g = 0; g < groupSize; g++) {
+                            const double alpha = lr.e<double>(first + g);
+
+                            for (int k = 0; k < numOutputs; k++) {
+                                auto& v = scores[g * numOutputs + k];
+                                v = valid[g] ? gradientOf<T>(v, labels[k], hierarchic[k], alpha, expTable, expLength) : (T) 0.0f;
+                            }
+                        }
+
+                        gemmNN<T>(groupSize, vectorLength, numOutputs, scores.data(), outputs.data(), dHidden.data());
+                        gemmTN<T>(numOutputs, vectorLength, groupSize, scores.data(), hidden.data(), dOutputs.data());
+
+                        // Hogwild updates
+                        for (int k = 0; k < numOutputs; k++) {
+                            auto row = rows[k];
+                            auto d = dOutputs.data() + k * vectorLength;
+
+                            PRAGMA_OMP_SIMD
+                            for (int e = 0; e < vectorLength; e++)
+                                row[e] += d[e];
+                        }
+
+                        for (int g = 0; g < groupSize; g++) {
+                            if (!valid[g])
+                                continue;
+
+                            auto d = dHidden.data() + g * vectorLength;
+                            for (int c = 0; c < inputWidth; c++) {
+                                const Nd4jLong offset = (Nd4jLong) (first + g) * inputWidth + c;
+                                const int irow = bInputs[offset];
+                                if (irow < 0 || (bLocked != nullptr && bLocked[offset] == 1))
+                                    continue;
+
+                                auto syn0row = syn0 + (Nd4jLong) irow * vectorLength;
+
+                                PRAGMA_OMP_SIMD
+                                for (int e = 0; e < vectorLength; e++)
+                                    syn0row[e] += d[e];
+                            }
+                        }
+                    }
+                }
+
+                return numExamples;
+            }
+
+            Nd4jLong word2vecBatch(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &inputs, NDArray &lockedRows, NDArray &positives, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, const int nsRounds, const int maxGroupSize, const int numWorkers) {
+                auto xType = syn0.dataType();
+
+                BUILD_SINGLE_SELECTOR(xType, return word2vecBatch_, (syn0, syn1, syn1Neg, expTable, negTable, inputs, lockedRows, positives, indices, codes, alpha, randomValue, nsRounds, nd4j::math::nd4j_max<int>(1, maxGroupSize), nd4j::math::nd4j_max<int>(1, numWorkers)), FLOAT_TYPES);
+                return 0L;
+            }
+        }
+    }
+}
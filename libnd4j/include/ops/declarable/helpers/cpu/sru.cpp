@@ -22,27 +22,12 @@
 
 #include<ops/declarable/helpers/sru.h>
 #include <NDArrayFactory.h>
+#include <array/NDArrayExpression.h>
 
 namespace nd4j    {
 namespace ops     {
 namespace helpers {
 
-//////////////////////////////////////////////////////////////////////////
-static FORCEINLINE NDArray activation(const NDArray& arr) {
-    
-    // return (const_cast<NDArray<T>&>(arr)).template transform<simdOps::Tanh<T>>();    
-    auto result = NDArray(&arr, false, arr.getWorkspace());
-    (const_cast<NDArray&>(arr)).applyTransform(transform::Tanh, &result);
-    return result;
-}
-
-
-//////////////////////////////////////////////////////////////////////////
-static FORCEINLINE NDArray sigmoid(const NDArray& arr) {
-    return (const_cast<NDArray&>(arr)).transform(transform::Sigmoid);
-}
-
-
 //////////////////////////////////////////////////////////////////////////
 void sruCell(const NDArray* x, const NDArray* c0, const NDArray* w, const NDArray* b, NDArray* h, NDArray* c) {
 
@@ -54,23 +39,28 @@ void sruCell(const NDArray* x, const NDArray* c0, const NDArray* w, const NDArra
     // h   current cell output [bS x inSize], that is at current time step t
     // c   current cell state  [bS x inSize], that is at current time step t
 
+    using namespace nd4j::expr;
+
     const int inSize = x->sizeAt(1);           // inSize - number of features
             
     auto z = mmul(*x, *w);               //  [bS x 3*inSize]
+    auto zc = z({0,0, 0,        inSize});
+    auto zf = z({0,0, inSize,   2*inSize});
+    auto zr = z({0,0, 2*inSize, 3*inSize});
 
-    // forget gate = sigmoid(x*Wf + bf)
-    auto f = sigmoid(z({0,0, inSize,   2*inSize}) + (*b)({0, inSize}));
+    // forget gate = sigmoid(x*Wf + bf), kept in its slice of z
+    expr::assign(zf, sigmoid(lazy(zf) + (*b)({0, inSize})));
     
-    // reset gate = sigmoid(x*Wr + br)
-    auto r = sigmoid(z({0,0, 2*inSize, 3*inSize}) + (*b)({inSize, 2*inSize}));
+    // reset gate = sigmoid(x*Wr + br), kept in its slice of z
+    expr::assign(zr, sigmoid(lazy(zr) + (*b)({inSize, 2*inSize})));
 
     // ◦ means element-wise product or so called Hadamard product
     // current sell state = f◦c0 + (1 - f)◦(x*Wc)
-    c->assign( f*(*c0) + (1.f - f) * z({0,0 ,0, inSize}) );
+    expr::assign(*c, lazy(zf) * (*c0) + (1.f - lazy(zf)) * zc);
     // *c = f*(*c0 - z({},{0, inSize})) + z({{},{0, inSize}});
 
     // current cell output = r◦activation(c) + (1 - r)◦x
-    h->assign( r*activation(*c) + (1.f - r) * (*x) );
+    expr::assign(*h, lazy(zr) * tanh(lazy(*c)) + (1.f - lazy(zr)) * (*x));
     // *h = r * (activation<T>(c) - *x) + *x;        
 }
 
@@ -21,6 +21,8 @@
 #include <ops/declarable/helpers/top_k.h>
 #include <ops/declarable/headers/parity_ops.h>
 #include <NDArrayFactory.h>
+#include <array/TadSet.h>
+#include <helpers/SortHelper.h>
 
 namespace nd4j {
 namespace ops {
@@ -46,9 +48,12 @@ namespace helpers {
 
         const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(input->getShapeInfo(), dimsToExclude);
 
+        // sub-arrays along last dimension, without per-row shapeInfo allocations
+        TadSet inputTads(*input, {lastDim});
+
             if (k == 1) {
                 for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
-                    auto trial = (*input)(e, dimsToExclude);
+                    auto trial = inputTads.at(e);
                     //int maxPos = //lastDimList->at(e)->argMax();
                     Nd4jLong maxPos = 0;
                     //trial.printIndexedBuffer("TRIAL:");
@@ -67,8 +72,11 @@ namespace helpers {
             else { 
                 int nextPos = 0;
 
+                std::unique_ptr<TadSet> valuesTads(values == nullptr ? nullptr : new TadSet(*values, {lastDim}));
+                std::unique_ptr<TadSet> indicesTads(indeces == nullptr ? nullptr : new TadSet(*indeces, {lastDim}));
+
                 for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
-                    auto trial = (*input)(e, dimsToExclude);
+                    auto trial = inputTads.at(e);
 
                     // fill up the first k elements
                     NDArray topValues = NDArrayFactory::create<T>('c', {k});
@@ -81,7 +89,7 @@ namespace helpers {
                     //std::vector<T> sortedVals(topValues);
                     sortedVals.assign(topValues);// = NDArrayFactory::create<T>('c', {k});
                     //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-                    SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
+                    SortHelper::sort<T>(reinterpret_cast<T*>(sortedVals.buffer()), k, false);
                     for (int i = k; i < width; ++i) {
                         T val = trial.e<T>(i);
                         T minTopVal = sortedVals.t<T>(0);
@@ -99,12 +107,12 @@ namespace helpers {
                                 topIndices.t<Nd4jLong>(exchangePos) = i;
                                 sortedVals.t<T>(0) = val; // suppress in sorted
                                 //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-                                SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
+                                SortHelper::sort<T>(reinterpret_cast<T*>(sortedVals.buffer()), k, false);
                             }
                         }
                     }
                     if (needSort) {
-                        SpecialMethods<T>::sortGeneric(topValues.buffer(), topValues.shapeInfo(), true);
+                        SortHelper::sort<T>(reinterpret_cast<T*>(topValues.buffer()), k, true);
 
                         for (int j = 0; j < width; j++)
                             for (int pos = 0; pos < k; ++pos)
@@ -129,9 +137,9 @@ namespace helpers {
 
                     }
                     if (values)
-                    (*values)(e, dimsToExclude).assign(topValues);
+                        valuesTads->at(e).assign(topValues);
                     if (indeces)
-                    (*indeces)(e, dimsToExclude).assign(topIndices);
+                        indicesTads->at(e).assign(topIndices);
                 }
                 //indeces->printIndexedBuffer("Indices as is");
         }
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Batched triangular solve on top of LinearAlgebraHelper::trsm
+//
+
+#include <ops/declarable/helpers/triangular_solve.h>
+#include <ops/declarable/helpers/contiguous.h>
+#include <helpers/LinearAlgebraHelper.h>
+#include <Status.h>
+#include <memory>
+#include <vector>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    template <typename T>
+    static int triangularSolve_(NDArray* matrix, NDArray* rhs, bool lower, bool adjoint, NDArray* output) {
+        typedef typename AccumulatorOf<T>::type C;
+
+        std::unique_ptr<NDArray> matrixCopy, rhsCopy;
+        const T* a = contiguous(*matrix, matrixCopy).template bufferAsT<T>();
+        const T* b = contiguous(*rhs, rhsCopy).template bufferAsT<T>();
+
+        std::unique_ptr<NDArray> outputTemp;
+        T* z = contiguousOutput(*output, outputTemp).template bufferAsT<T>();
+
+        const int m = static_cast<int>(rhs->sizeAt(-2));
+        const int k = static_cast<int>(rhs->sizeAt(-1));
+        const Nd4jLong m2 = static_cast<Nd4jLong>(m) * m;
+        const Nd4jLong mk = static_cast<Nd4jLong>(m) * k;
+        const Nd4jLong batch = rhs->lengthOf() / (mk > 0 ? mk : 1);
+
+        // transposed lower matrix is upper one
+        const bool solveLower = adjoint ? !lower : lower;
+
+        // small systems are spread over threads, large ones are parallelized within trsm
+        const bool parallelOverBatch = batch > 1 && (m <= 2 * LinearAlgebraHelper::blockSize() || batch >= LinearAlgebraHelper::maxThreads());
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(parallelOverBatch) schedule(guided))
+        for (Nd4jLong e = 0; e < batch; e++) {
+            std::vector<C> x(m2), y(mk);
+            const T* src = a + e * m2;
+
+            for (int i = 0; i < m; i++)
+                for (int j = 0; j < m; j++)
+                    x[i * m + j] = static_cast<C>(adjoint ? src[j * m + i] : src[i * m + j]);
+
+            for (Nd4jLong i = 0; i < mk; i++)
+                y[i] = static_cast<C>(b[e * mk + i]);
+
+            LinearAlgebraHelper::trsm<C>(x.data(), m, solveLower, false, y.data(), k);
+
+            for (Nd4jLong i = 0; i < mk; i++)
+                z[e * mk + i] = static_cast<T>(y[i]);
+        }
+
+        if (outputTemp)
+            output->assign(outputTemp.get());
+
+        return Status::OK();
+    }
+
+    int triangularSolve(NDArray* matrix, NDArray* rhs, bool lower, bool adjoint, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(rhs->dataType(), return triangularSolve_, (matrix, rhs, lower, adjoint, output), FLOAT_TYPES);
+    }
+
+    BUILD_SINGLE_TEMPLATE(template int triangularSolve_, (NDArray* matrix, NDArray* rhs, bool lower, bool adjoint, NDArray* output), FLOAT_TYPES);
+
+}
+}
+}
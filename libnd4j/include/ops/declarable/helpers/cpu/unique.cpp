@@ -20,24 +20,38 @@
 
 #include <ops/declarable/helpers/unique.h>
 #include <Status.h>
+#include <helpers/SortHelper.h>
+#include <memory>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    // contiguous copy of input and stable permutation sorting it: equal values become adjacent, in order of appearance
+    template <typename T>
+    static NDArray* sortedInput_(NDArray* input, std::vector<Nd4jLong>& permutation) {
+        auto data = input->dup('c');
+
+        permutation.resize(input->lengthOf());
+        SortHelper::argSort<T>(reinterpret_cast<T*>(data->buffer()), input->lengthOf(), permutation.data(), false);
+
+        return data;
+    }
+
     template <typename T>
     static Nd4jLong uniqueCount_(NDArray* input) {
-        Nd4jLong count = 0;
+        if (input->lengthOf() == 0)
+            return 0;
 
-        std::vector<T> values;
+        std::vector<Nd4jLong> permutation;
+        std::unique_ptr<NDArray> data(sortedInput_<T>(input, permutation));
+        auto x = reinterpret_cast<T*>(data->buffer());
 
-        for (int e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(values.begin(), values.end(), v) == values.end()) {
-                values.push_back(v);
+        Nd4jLong count = 1;
+        for (Nd4jLong e = 1; e < input->lengthOf(); e++)
+            if (x[permutation[e]] != x[permutation[e - 1]])
                 count++;
-            }
-        }
+
         return count;
     }
 
@@ -50,35 +64,43 @@ namespace helpers {
 
     template <typename T>
     static Nd4jStatus uniqueFunctor_(NDArray* input, NDArray* values, NDArray* indices, NDArray* counts) {
-    
-        std::vector<T> valuesVector;
-        std::map<T, int> indicesMap;
-        std::map<T, int> countsMap;
-
-        for (int e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(valuesVector.begin(), valuesVector.end(), v) == valuesVector.end()) {
-                valuesVector.push_back(v);
-                indicesMap[v] = e;
-                countsMap[v] = 1;
-            }
-            else {
-                countsMap[v]++;
+        const Nd4jLong length = input->lengthOf();
+        if (length == 0)
+            return Status::OK();
+
+        std::vector<Nd4jLong> permutation;
+        std::unique_ptr<NDArray> data(sortedInput_<T>(input, permutation));
+        auto x = reinterpret_cast<T*>(data->buffer());
+
+        // runs of equal values in sorted order, permutation is stable so the first element of each run is its first occurrence
+        std::vector<Nd4jLong> firstOccurrences;
+        std::vector<Nd4jLong> runCounts;
+        std::vector<Nd4jLong> runOf(length);
+        for (Nd4jLong e = 0; e < length; e++) {
+            if (e == 0 || x[permutation[e]] != x[permutation[e - 1]]) {
+                firstOccurrences.push_back(permutation[e]);
+                runCounts.push_back(0);
             }
+            runOf[permutation[e]] = firstOccurrences.size() - 1;
+            runCounts.back()++;
         }
 
-        PRAGMA_OMP_PARALLEL_FOR_IF(values->lengthOf() > Environment::getInstance()->elementwiseThreshold())
-        for (int e = 0; e < values->lengthOf(); e++) {
-            values->p(e, static_cast<T>(valuesVector[e]));
-            if (counts != nullptr) 
-                counts->p(e, countsMap[valuesVector[e]]);
+        // unique values go in order of their first appearance in input
+        const Nd4jLong numUnique = firstOccurrences.size();
+        std::vector<Nd4jLong> order(numUnique);
+        std::vector<Nd4jLong> positionOf(numUnique);
+        SortHelper::argSort<Nd4jLong>(firstOccurrences.data(), numUnique, order.data(), false);
+        for (Nd4jLong e = 0; e < numUnique; e++)
+            positionOf[order[e]] = e;
+
+        for (Nd4jLong e = 0; e < numUnique; e++) {
+            values->p(e, x[firstOccurrences[order[e]]]);
+            if (counts != nullptr)
+                counts->p(e, runCounts[order[e]]);
         }
 
-        for (int e = 0; e < indices->lengthOf(); e++) {
-            auto posI = std::find(valuesVector.begin(), valuesVector.end(), input->e<T>(e));
-            auto dist = std::distance(valuesVector.begin(), posI);
-            indices->p(e, Nd4jLong(dist));//indicesMap[(*input)(e)];
-        }
+        for (Nd4jLong e = 0; e < indices->lengthOf(); e++)
+            indices->p(e, positionOf[runOf[e]]);
 
         return Status::OK();
     }
@@ -19,6 +19,8 @@
 //
 
 #include <ops/declarable/helpers/weights.h>
+#include <OmpLaunchHelper.h>
+#include <memory>
 
 namespace nd4j {
 namespace ops {
@@ -26,15 +28,39 @@ namespace helpers {
 
     template <typename T>
     static void adjustWeights_(NDArray* input, NDArray* weights, NDArray* output, int minLength, int maxLength) {
-            for (int e = 0; e < input->lengthOf(); e++) {
+        const Nd4jLong length = input->lengthOf();
+        const int bins = nd4j::math::nd4j_min<int>(maxLength, output->lengthOf());
+        if (bins <= 0)
+            return;
+
+        // every block of input is counted into its own bins, these are summed up into output at the end
+        const int numBlocks = OmpLaunchHelper::betterThreads(length);
+        const Nd4jLong span = OmpLaunchHelper::betterSpan(length, numBlocks);
+        std::unique_ptr<T[]> counts(new T[numBlocks * bins]());
+
+        PRAGMA_OMP_PARALLEL_FOR_THREADS(numBlocks)
+        for (int b = 0; b < numBlocks; b++) {
+            auto blockCounts = counts.get() + b * bins;
+            const Nd4jLong stop = nd4j::math::nd4j_min<Nd4jLong>(length, (b + 1) * span);
+
+            for (Nd4jLong e = b * span; e < stop; e++) {
                 int val = input->e<int>(e);
-                if (val < maxLength) {
+                if (val >= 0 && val < bins) {
                     if (weights != nullptr)
-                        output->p(val, output->e<T>(val) + weights->e<T>(e));
+                        blockCounts[val] += weights->e<T>(e);
                     else
-                        output->p(val, output->e<T>(val) + 1);
+                        blockCounts[val] += static_cast<T>(1);
                 }
             }
+        }
+
+        for (int val = 0; val < bins; val++) {
+            T sum = output->e<T>(val);
+            for (int b = 0; b < numBlocks; b++)
+                sum += counts[b * bins + val];
+
+            output->p(val, sum);
+        }
     }
 
     void adjustWeights(NDArray* input, NDArray* weights, NDArray* output, int minLength, int maxLength) {
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// k nearest neighbours search: blocked brute force over reduce3 all-pairs kernels and vantage-point tree index
+//
+// Metrics are given as reduce3 op numbers. Distances within search are always "smaller is closer".
+//
+
+#ifndef LIBND4J_HELPERS_KNN_H
+#define LIBND4J_HELPERS_KNN_H
+
+#include <op_boilerplate.h>
+#include <NDArray.h>
+#include <string>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    /**
+     * Brute force search of k nearest rows of data [N, d] for each row of queries [Q, d].
+     * Distances are evaluated tile by tile with reduce3 all-pairs kernels and merged into per-query bounded heaps right away,
+     * so full [Q, N] distance matrix is never materialised.
+     * metric: ManhattanDistance, EuclideanDistance or CosineDistance
+     * indices [Q, k] INT64 and distances [Q, k] are sorted by distance, ties are resolved by smaller index
+     */
+    void knnBruteForce(const NDArray& data, const NDArray& queries, int k, int metric, NDArray& indices, NDArray& distances);
+
+    /**
+     * Builds vantage-point tree over rows of data [N, d].
+     * Node n is row n of nodes [N, 3]: {point index, inner child, outer child}, -1 means no child, root is node 0.
+     * radii[n] is median distance from node's point to the rest of its subtree:
+     * points of inner subtree are not farther than radii[n], points of outer subtree are not closer.
+     * metric must satisfy triangle inequality: ManhattanDistance or EuclideanDistance
+     */
+    void vpTreeBuild(const NDArray& data, int metric, NDArray& nodes, NDArray& radii);
+
+    /**
+     * k nearest neighbours search in vantage-point tree built by vpTreeBuild over the same data.
+     * maxVisits == 0 gives exact search, otherwise each query stops after maxVisits distance evaluations (approximate search)
+     */
+    void vpTreeSearch(const NDArray& data, const NDArray& nodes, const NDArray& radii, const NDArray& queries, int k, int metric, Nd4jLong maxVisits, NDArray& indices, NDArray& distances);
+
+    // "VPTREE01"
+    static const Nd4jLong VPTREE_FILE_MAGIC = 0x3130454552545056LL;
+    static const Nd4jLong VPTREE_FILE_VERSION = 1;
+
+    /**
+     * VP-tree file layout, little endian:
+     * header: 8 x int64 {VPTREE_FILE_MAGIC, version, N, d, metric, data type, 0, 0}
+     * data [N, d] of given data type, nodes [N, 3] INT64, radii [N] of given data type, all c-ordered.
+     * Every section starts at 64-byte aligned offset, so mmap'd file can be wrapped into NDArrays without copies.
+     */
+    struct VPTreeFileLayout {
+        Nd4jLong numPoints;
+        Nd4jLong dims;
+        int metric;
+        nd4j::DataType dataType;
+
+        // byte offsets of sections within file
+        Nd4jLong dataOffset;
+        Nd4jLong nodesOffset;
+        Nd4jLong radiiOffset;
+        Nd4jLong fileLength;
+    };
+
+    void vpTreeWrite(const std::string& fileName, const NDArray& data, const NDArray& nodes, const NDArray& radii, int metric);
+
+    /**
+     * Validates header at the beginning of (mmap'd) VP-tree file and evaluates offsets of its sections
+     */
+    VPTreeFileLayout vpTreeFileLayout(const void* header);
+
+}
+}
+}
+
+#endif //LIBND4J_HELPERS_KNN_H
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Int8 inference helpers: affine quantisation, uint8 x int8 -> int32 GEMM and per-channel requantisation
+//
+// Real value r and its quantised counterpart q are related as r = scale * (q - zeroPoint).
+// Activations are UINT8, weights are INT8 with per-output-channel scale and zero point.
+//
+
+#ifndef LIBND4J_HELPERS_QUANTIZATION_H
+#define LIBND4J_HELPERS_QUANTIZATION_H
+
+#include <op_boilerplate.h>
+#include <NDArray.h>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    /**
+     * This method evaluates integer grid used by fake_quant_with_min_max_vars for given [min, max] range:
+     * range is nudged so that real zero is exactly representable, values are clamped to [quantMin, quantMax]
+     */
+    void nudgeQuantizationRange(float min, float max, int numBits, bool narrowed, float& scale, int& zeroPoint, int& quantMin, int& quantMax);
+
+    /**
+     * This method quantises floating point input onto [quantMin, quantMax] grid, rounding is the same as in fake_quant_with_min_max_vars.
+     * Output must be UINT8 or INT8. INT8 output is stored with offset: value - 128, so caller should use zeroPoint - 128 for it.
+     */
+    void quantize(const NDArray& input, float scale, int zeroPoint, int quantMin, int quantMax, NDArray& output);
+
+    /**
+     * Integer GEMM with int32 accumulation: C[M, N] = sum_k (A[i, k] - aZeroPoint) * (B[k, j] - bZeroPoints[j])
+     * All matrices are c-ordered and contiguous.
+     */
+    void qgemm(const uint8_t* A, int aZeroPoint, const int8_t* B, const int* bZeroPoints, int M, int N, int K, int32_t* C);
+
+    /**
+     * Quantised matmul, x [M, K] UINT8 or floating point (quantised on the fly), y [K, N] INT8.
+     * Output is either floating point (dequantised) or UINT8, requantised with outScale/outZeroPoint.
+     */
+    void qmatmul(const NDArray* x, const NDArray* y, float xScale, int xZeroPoint, const NDArray* yScales, const NDArray* yZeroPoints, const NDArray* bias, NDArray* output, float outScale, int outZeroPoint, int quantMin, int quantMax);
+
+    /**
+     * Quantised conv2d, input [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW] (NCHW), weights [kH, kW, iC, oC] INT8.
+     * Padding is filled with xZeroPoint, i.e. with quantised real zero.
+     */
+    void qconv2d(const NDArray* input, const NDArray* weights, float xScale, int xZeroPoint, const NDArray* wScales, const NDArray* wZeroPoints, const NDArray* bias, NDArray* output, float outScale, int outZeroPoint, int quantMin, int quantMax,
+                 const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int isSameMode, const int isNCHW);
+
+}
+}
+}
+
+#endif //LIBND4J_HELPERS_QUANTIZATION_H
@@ -32,6 +32,19 @@ namespace nd4j {
 
             void cbow(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &target, NDArray &ngStarter, int nsRounds, NDArray &context, NDArray &lockedWords, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, NDArray &numLabels, NDArray &inferenceVector, const bool trainWords, const int numWorkers);
 
+            /**
+             * Batched Hogwild engine for skipgram, cbow and fastText-style subword training.
+             *
+             * Each example b has hidden vector equal to mean of syn0 rows inputs[b, :] (negative values are padding), so skipgram
+             * example has single row, cbow example has context window, and subword example has word row followed by its n-gram
+             * rows. Consecutive examples sharing positive word and hierarchic softmax path are grouped, group output rows
+             * (hs path, positive word and negatives drawn once per group) are gathered into contiguous block, and dot products
+             * and updates are done as small GEMMs. Groups are processed in parallel without locks or row ownership.
+             *
+             * @return number of processed examples
+             */
+            Nd4jLong word2vecBatch(NDArray &syn0, NDArray &syn1, NDArray &syn1Neg, NDArray &expTable, NDArray &negTable, NDArray &inputs, NDArray &lockedRows, NDArray &positives, NDArray &indices, NDArray &codes, NDArray &alpha, NDArray &randomValue, const int nsRounds, const int maxGroupSize, const int numWorkers);
+
             int binarySearch(const int *haystack, const int needle, const int totalElements);
         }
     }
@@ -0,0 +1,42 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Batched solution of triangular systems, see LinearAlgebraHelper::trsm
+//
+
+#ifndef LIBND4J_HELPERS_TRIANGULAR_SOLVE_H
+#define LIBND4J_HELPERS_TRIANGULAR_SOLVE_H
+
+#include <op_boilerplate.h>
+#include <NDArray.h>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    /**
+     * Solves matrix * output = rhs for each pair of matrices within batch: matrix [..., M, M], rhs and output [..., M, K].
+     * Only lower (or upper) triangle of matrix is read. With adjoint set, system with transposed matrix is solved instead.
+     */
+    int triangularSolve(NDArray* matrix, NDArray* rhs, bool lower, bool adjoint, NDArray* output);
+
+}
+}
+}
+
+#endif //LIBND4J_HELPERS_TRIANGULAR_SOLVE_H
@@ -25,6 +25,7 @@
 #include <NDArrayFactory.h>
 #include <graph/exceptions/graph_exception.h>
 #include <graph/exceptions/unresolved_input_exception.h>
+#include <helpers/OpCounters.h>
 
 namespace nd4j {
     namespace ops {
@@ -431,6 +432,29 @@ namespace nd4j {
             return ND4J_STATUS_OK;
         }
 
+        // outputs produced by op, stops at first output index which doesn't exist
+        static void collectOutputs(Context& block, int numOutputs, std::vector<NDArray*>& outputs) {
+            auto vs = block.getVariableSpace();
+
+            for (int e = 0; e < numOutputs; e++) {
+                if (!block.isFastPath()) {
+                    if (!vs->hasVariable(block.nodeId(), e))
+                        break;
+                } else {
+                    // we have to check either in or out stack, depending on isInplace()
+                    if (block.isInplace()) {
+                        if (block.fastpath_in().size() <= e)
+                            break;
+                    } else {
+                        if (block.fastpath_out().size() <= e)
+                            break;
+                    }
+                }
+
+                outputs.emplace_back(block.isFastPath() ? block.isInplace() ? block.fastpath_in()[e] : block.fastpath_out()[e] : vs->getVariable(block.nodeId(), e)->getNDArray());
+            }
+        }
+
         Nd4jStatus nd4j::ops::DeclarableOp::execute(Context* block) {
             nd4j_debug("Executing op: [%s]\n", this->getOpName()->c_str());
 
@@ -441,26 +465,50 @@ namespace nd4j {
             if (Environment::getInstance()->isProfiling())
                 timeEnter = std::chrono::system_clock::now();
 
-            // basic validation: ensure inputs are set
-            REQUIRE_OK(this->validateNonEmptyInput(*block));
+            int numOutputs = 0;
+            if (block->hasKnownShapes()) {
+                // Graph::inferShapes() has already validated this node and preallocated its outputs for current input shapes
+                numOutputs = block->knownOutputs();
+            } else {
+                // basic validation: ensure inputs are set
+                REQUIRE_OK(this->validateNonEmptyInput(*block));
 
-            // ensure number of IArgs, TArgs match our expectations
-            REQUIRE_OK(this->validateArguments(*block));
+                // ensure number of IArgs, TArgs match our expectations
+                REQUIRE_OK(this->validateArguments(*block));
 
-            // validating data types for inputs and (optionally) outputs
-            REQUIRE_OK(this->validateDataTypes(*block));
+                // validating data types for inputs and (optionally) outputs
+                REQUIRE_OK(this->validateDataTypes(*block));
 
 
-            // this method will allocate output NDArrays for this op
-            auto numOutputs = this->prepareOutputs(*block);
+                // this method will allocate output NDArrays for this op
+                numOutputs = this->prepareOutputs(*block);
+            }
 
             if (Environment::getInstance()->isProfiling()) {
                 timeStart = std::chrono::system_clock::now();
                 prepTime = std::chrono::duration_cast<std::chrono::nanoseconds>(timeStart - timeEnter).count();
             }
 
+            auto opCounters = OpCounters::getInstance();
+            const bool counted = opCounters->isEnabled();
+            const Nd4jLong countersStart = counted ? OpCounters::currentTime() : 0L;
+            const PerfSample countersBefore = counted ? PerfCounters::getInstance()->read() : PerfSample();
+
             Nd4jStatus status = this->validateAndExecute(*block);
 
+            if (counted) {
+                auto countersDelta = PerfCounters::getInstance()->read() - countersBefore;
+                auto countersTime = OpCounters::currentTime() - countersStart;
+
+                std::vector<NDArray*> inputs, outputs;
+                for (int e = 0; e < (int) block->width(); e++)
+                    inputs.emplace_back(block->array(e));
+
+                collectOutputs(*block, numOutputs, outputs);
+
+                opCounters->record(*this->getOpName(), inputs, outputs, *block->getIArguments(), countersTime, countersDelta);
+            }
+
             // optionally saving execution time
             if (Environment::getInstance()->isProfiling()) {
                 timeEnd = std::chrono::system_clock::now();
@@ -485,26 +533,11 @@ namespace nd4j {
 
             // now we print out all outputs for this node
             if (nd4j::Environment::getInstance()->isDebugAndVerbose()) {
-                auto vs = block->getVariableSpace();
-
-                for (int e = 0; e < numOutputs; e++) {
-                    // if given output index doesn't exist - we're done
-
-                    if (!block->isFastPath()) {
-                        if (!vs->hasVariable(block->nodeId(), e))
-                            break;
-                    } else {
-                        // we have to check either in or out stack, depending on isInplace()
-                        if (block->isInplace()) {
-                            if (block->fastpath_in().size() <= e)
-                                break;
-                        } else {
-                            if (block->fastpath_out().size() <= e)
-                                break;
-                        }
-                    }
+                std::vector<NDArray*> outputs;
+                collectOutputs(*block, numOutputs, outputs);
 
-                    auto array = block->isFastPath() ? block->isInplace() ? block->fastpath_in()[e] : block->fastpath_out()[e] : vs->getVariable(block->nodeId(), e)->getNDArray();
+                for (int e = 0; e < outputs.size(); e++) {
+                    auto array = outputs[e];
 
                     auto shape = ShapeUtils::shapeAsString(array);
                     auto first = array->isEmpty() ? std::string("Empty NDArray") : array->asString(32);
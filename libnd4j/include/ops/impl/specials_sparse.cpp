@@ -28,6 +28,8 @@
 #endif
 #include <types/float16.h>
 #include <types/types.h>
+#include <helpers/SortHelper.h>
+#include <Environment.h>
 
 namespace nd4j {
     namespace sparse {
@@ -210,11 +212,37 @@ namespace nd4j {
 
         template <typename T>
         void SparseUtils<T>::sortCooIndicesGeneric(Nd4jLong *indices, T *values, Nd4jLong length, int rank) {
-#ifdef _OPENMP
-            coo_quickSort_parallel(indices, values, length, omp_get_max_threads(), rank);
-#else
-            coo_quickSort_parallel(indices, values, length, 1, rank);
-#endif
+            if (length < 2)
+                return;
+
+            // lexicographic order is built as LSD: stable sort by the last coordinate first, by the first one last.
+            // coordinates are small non-negative numbers, so radix sort skips most of their bytes
+            std::vector<Nd4jLong> permutation(length);
+            std::vector<Nd4jLong> keys(length);
+            for (Nd4jLong e = 0; e < length; e++)
+                permutation[e] = e;
+
+            for (int d = rank - 1; d >= 0; d--) {
+                PRAGMA_OMP_PARALLEL_FOR_IF(length > Environment::getInstance()->elementwiseThreshold())
+                for (Nd4jLong e = 0; e < length; e++)
+                    keys[e] = indices[permutation[e] * rank + d];
+
+                SortHelper::sortByKey<Nd4jLong, Nd4jLong>(keys.data(), permutation.data(), length, false);
+            }
+
+            std::vector<Nd4jLong> sortedIndices(length * rank);
+            std::vector<T> sortedValues(length);
+
+            PRAGMA_OMP_PARALLEL_FOR_IF(length > Environment::getInstance()->elementwiseThreshold())
+            for (Nd4jLong e = 0; e < length; e++) {
+                const Nd4jLong p = permutation[e];
+                for (int d = 0; d < rank; d++)
+                    sortedIndices[e * rank + d] = indices[p * rank + d];
+                sortedValues[e] = values[p];
+            }
+
+            std::copy(sortedIndices.begin(), sortedIndices.end(), indices);
+            std::copy(sortedValues.begin(), sortedValues.end(), values);
         }
 
         BUILD_SINGLE_TEMPLATE(template class ND4J_EXPORT SparseUtils, , LIBND4J_TYPES);
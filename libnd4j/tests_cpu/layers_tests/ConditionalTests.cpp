@@ -23,6 +23,8 @@
 #include <GraphExecutioner.h>
 #include <Node.h>
 #include <ops/declarable/CustomOperations.h>
+#include <graph/execution/FrameExecutor.h>
+#include <helpers/OpCounters.h>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -105,6 +107,19 @@ TEST_F(ConditionalTests, BasicTests_1) {
 
     ASSERT_NEAR(6.0, conditionalResult->meanNumber().e<double>(0), 1e-5);
 }
+// restores loop settings of Environment, even if assertion fails halfway
+class LoopSettingsGuard {
+private:
+    Nd4jLong _limit = Environment::getInstance()->maxLoopIterations();
+    bool _compile = Environment::getInstance()->isCompileLoops();
+
+public:
+    ~LoopSettingsGuard() {
+        Environment::getInstance()->setCompileLoops(_compile);
+        Environment::getInstance()->setMaxLoopIterations(_limit);
+    }
+};
+
 #ifdef GRAPH_FILES_OK
 /**
  * Condition is False
@@ -330,4 +345,154 @@ TEST_F(ConditionalTests, Flat_Test_8) {
 
     delete graph;
 }
+
+/**
+ * This test checks that loop executed by FrameExecutor gives the same results over multiple runs
+ */
+TEST_F(ConditionalTests, Flat_Test_9) {
+    auto graph = GraphExecutioner::importFromFlatBuffers("./resources/simplewhile_1.fb");
+    auto varSpace = graph->getVariableSpace();
+
+    auto exp = NDArrayFactory::create<float>('c', {2, 2}, {-3, -3, -3, -3});
+
+    for (int e = 0; e < 3; e++) {
+        varSpace->getVariable(1)->getNDArray()->assign(-9.0f);
+        varSpace->getVariable(2)->getNDArray()->assign(1.0f);
+
+        auto status = GraphExecutioner::execute(graph);
+        ASSERT_EQ(Status::OK(), status);
+
+        auto z = varSpace->getVariable(25)->getNDArray();
+        ASSERT_NE(nullptr, z);
+        ASSERT_TRUE(exp.equalsTo(z));
+    }
+
+    Node *enter = nullptr;
+    for (auto &v: *graph->getMapped())
+        if (v.second->opType() == OpType_LOGIC && v.second->opNum() == logic::Enter)
+            enter = v.second;
+
+    ASSERT_NE(nullptr, enter);
+    ASSERT_NE(nullptr, graph->frameExecutor(enter->getFrameId()));
+
+    delete graph;
+}
+
+/**
+ * This test checks loop iterations limit, for both FrameExecutor and generic execution
+ */
+TEST_F(ConditionalTests, Flat_Test_10) {
+    LoopSettingsGuard guard;
+    Environment::getInstance()->setMaxLoopIterations(1);
+
+    for (bool compile: {true, false}) {
+        Environment::getInstance()->setCompileLoops(compile);
+
+        auto graph = GraphExecutioner::importFromFlatBuffers("./resources/simplewhile_0_4.fb");
+        graph->getVariableSpace()->getVariable(2)->getNDArray()->assign(9.0);
+
+        // two cycles are required here
+        EXPECT_NE(Status::OK(), GraphExecutioner::execute(graph)) << "compileLoops: " << compile;
+
+        delete graph;
+    }
+}
+
+/**
+ * This test checks that iterations limit applies to each entry into frame, not to all executions of the graph
+ */
+TEST_F(ConditionalTests, Flat_Test_11) {
+    LoopSettingsGuard guard;
+    Environment::getInstance()->setMaxLoopIterations(4);
+    Environment::getInstance()->setCompileLoops(false);
+
+    auto graph = GraphExecutioner::importFromFlatBuffers("./resources/simplewhile_0_4.fb");
+    auto varSpace = graph->getVariableSpace();
+    auto exp = NDArrayFactory::create<float>('c', {2, 2}, {4, 4, 4, 4});
+
+    // FlowPath lives in VariableSpace, so without reset on frame entry cycles would add up across executions
+    for (int e = 0; e < 4; e++) {
+        varSpace->getVariable(2)->getNDArray()->assign(9.0);
+
+        EXPECT_EQ(Status::OK(), GraphExecutioner::execute(graph)) << "execution: " << e;
+
+        auto z = varSpace->getVariable(17)->getNDArray();
+        EXPECT_TRUE(exp.equalsTo(z)) << "execution: " << e;
+    }
+
+    delete graph;
+}
 #endif
+
+/**
+ * while (x < limit) x += tanh(w): tanh depends only on Enter node, so compiled frame evaluates it once
+ */
+TEST_F(ConditionalTests, Frame_Invariant_1) {
+    LoopSettingsGuard guard;
+    Environment::getInstance()->setCompileLoops(true);
+
+    Graph graph;
+    auto variableSpace = graph.getVariableSpace();
+    variableSpace->putVariable(-1, NDArrayFactory::create_(0.f));
+    variableSpace->putVariable(-2, NDArrayFactory::create_(3.f));
+    variableSpace->putVariable(-3, NDArrayFactory::create_(0.5f));
+
+    nd4j::ops::less less;
+    nd4j::ops::tanh tanh;
+    nd4j::ops::add add;
+
+    auto enterX = new Node(OpType_LOGIC, logic::Enter, 1, {-1});
+    auto enterLimit = new Node(OpType_LOGIC, logic::Enter, 2, {-2});
+    auto enterW = new Node(OpType_LOGIC, logic::Enter, 3, {-3});
+    for (auto enter: {enterX, enterLimit, enterW})
+        enter->setFrameId(1);
+
+    auto merge = new Node(OpType_LOGIC, logic::Merge, 4, {1, 12});
+    auto condition = new Node(&less, 5, {4, 2});
+    auto loopCond = new Node(OpType_LOGIC, logic::LoopCond, 6, {5});
+    auto routing = new Node(OpType_LOGIC, logic::Switch, 7, {4, 6});
+    auto invariant = new Node(&tanh, 8, {3});
+
+    auto body = new Node(&add, 9);
+    body->pickInput(7, 1);
+    body->pickInput(8, 0);
+
+    auto nextIteration = new Node(OpType_LOGIC, logic::NextIteration, 12, {9});
+
+    auto exit = new Node(OpType_LOGIC, logic::Exit, 13);
+    exit->pickInput(7, 0);
+
+    for (auto node: {enterX, enterLimit, enterW, merge, condition, loopCond, routing, invariant, body, nextIteration, exit})
+        graph.addNode(node);
+
+    auto counters = OpCounters::getInstance();
+    counters->reset();
+    counters->setEnabled(true);
+
+    auto status = GraphExecutioner::execute(&graph);
+    counters->setEnabled(false);
+    ASSERT_EQ(Status::OK(), status);
+
+    auto frame = graph.frameExecutor(1);
+    ASSERT_NE(nullptr, frame);
+    ASSERT_EQ(1, frame->invariant()->size());
+    ASSERT_EQ(8, frame->invariant()->at(0)->id());
+
+    // x grows by tanh(0.5) ~ 0.46 per iteration, so it takes 7 iterations to reach 3
+    Nd4jLong tanhCount = 0, addCount = 0;
+    for (const auto& entry: counters->entries()) {
+        if (entry.opName == "tanh")
+            tanhCount += entry.invocations;
+
+        if (entry.opName == "add")
+            addCount += entry.invocations;
+    }
+
+    ASSERT_EQ(1, tanhCount);
+    ASSERT_EQ(7, addCount);
+
+    ASSERT_TRUE(variableSpace->hasVariable(13, 0));
+    auto z = variableSpace->getVariable(13, 0)->getNDArray();
+    ASSERT_NE(nullptr, z);
+    ASSERT_NEAR(7 * std::tanh(0.5), z->e<double>(0), 1e-5);
+}
@@ -347,4 +347,30 @@ TEST_F(ContextTests, test_short_context_3) {
     auto z = ctx.fastpath_out()[0];
 
     ASSERT_EQ(exp, *z);
-}
\ No newline at end of file
+}
+TEST_F(ContextTests, test_input_slots_1) {
+    VariableSpace variableSpace;
+
+    auto _20 = NDArrayFactory::create_<float>('c', {2, 2});
+    auto _21 = NDArrayFactory::create_<float>('c', {2, 2});
+    _20->assign(1.0f);
+    _21->assign(2.0f);
+
+    variableSpace.putVariable(2, 0, _20);
+    variableSpace.putVariable(2, 1, _21);
+
+    std::pair<int, int> p0(2, 0), p1(2, 1);
+
+    ContextPrototype prototype(nullptr, 1);
+    prototype.pickInput(2, 0);
+    prototype.pickInput(2, 1);
+
+    // second slot is stale on purpose, so map lookup must be used for it
+    prototype.inputSlots()->emplace_back(variableSpace.registerSlot(p0));
+    prototype.inputSlots()->emplace_back(variableSpace.registerSlot(p0));
+
+    Context block(&prototype, &variableSpace);
+
+    ASSERT_EQ(_20, block.variable(0)->getNDArray());
+    ASSERT_EQ(_21, block.variable(1)->getNDArray());
+}
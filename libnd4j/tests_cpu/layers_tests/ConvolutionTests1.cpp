@@ -2500,5 +2500,43 @@ TYPED_TEST(TypedConvolutionTests1, deconv2d_tf_test1) {
 }
 
 
+#ifdef HAVE_MKLDNN
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests1, conv2d_mkldnn_cache_1) {
+    int bS=2, iH=5,iW=4,  iC=3,oC=4,  kH=2,kW=2,  sH=1,sW=1,  pH=0,pW=0,  dH=1,dW=1;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+    int dataFormat  = 1;             // 1-NHWC, 0-NCHW
+
+    MKLDNNCache::getInstance()->purge();
+    nd4j::ops::conv2d op;
+
+    // new arrays of the same shapes every iteration, primitives are built only once
+    for (int e = 0; e < 3; e++) {
+        auto input = NDArrayFactory::create<float>('c', {bS, iH, iW, iC});
+        auto weights = NDArrayFactory::create<float>('c', {kH, kW, iC, oC});
+        auto bias = NDArrayFactory::create<float>('c', {oC});
+        input.linspace(e + 1.0f, 0.5f);
+        weights.linspace(0.1f, 0.1f);
+        bias.assign(e);
+
+        Environment::getInstance()->setUseMKLDNN(false);
+        auto expected = op.execute({&input, &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+        Environment::getInstance()->setUseMKLDNN(true);
+
+        auto results = op.execute({&input, &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+        ASSERT_EQ(Status::OK(), results->status());
+        ASSERT_TRUE(expected->at(0)->equalsTo(results->at(0)));
+
+        delete expected;
+        delete results;
+    }
+
+    ASSERT_EQ(1, MKLDNNCache::getInstance()->misses());
+    ASSERT_EQ(2, MKLDNNCache::getInstance()->hits());
+    ASSERT_EQ(1, MKLDNNCache::getInstance()->size());
+}
+#endif
+
+
 #endif //LIBND4J_CONVOLUTIONTESTS1_H
 
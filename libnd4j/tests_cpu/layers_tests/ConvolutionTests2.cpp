@@ -314,6 +314,204 @@ TEST_F(ConvolutionTests2, sconv2d_bp_2) {
     ASSERT_EQ(Status::OK(), status);    
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, maxpool2d_nhwc_nchw_1) {
+
+    int bS=2, iH=7,iW=6,  iC=5,  kH=3,kW=2,  sH=2,sW=1,  pH=1,pW=1,  dH=2,dW=1;
+    int paddingMode = 0;             // 1-SAME, 0-VALID;
+
+    NDArray input('c', {bS, iC, iH, iW}, nd4j::DataType::FLOAT32);
+    input.linspace(-10., 0.1);
+    auto permuted  = input.permute({0, 2, 3, 1});
+    auto inputNHWC = permuted->dup('c');                                            // [bS, iH, iW, iC]
+
+    nd4j::ops::maxpool2d op;
+    auto resultsNCHW = op.execute({&input},    {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, 0, 0});
+    auto resultsNHWC = op.execute({inputNHWC}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, 0, 1});
+
+    ASSERT_EQ(Status::OK(), resultsNCHW->status());
+    ASSERT_EQ(Status::OK(), resultsNHWC->status());
+
+    auto outNHWC = resultsNHWC->at(0);
+    outNHWC->permutei({0, 3, 1, 2});                                                // [bS, oH, oW, iC] -> [bS, iC, oH, oW]
+
+    ASSERT_TRUE(resultsNCHW->at(0)->isSameShape(outNHWC));
+    ASSERT_TRUE(resultsNCHW->at(0)->equalsTo(outNHWC));
+
+    delete permuted;
+    delete inputNHWC;
+    delete resultsNCHW;
+    delete resultsNHWC;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, avgpool2d_nhwc_nchw_1) {
+
+    int bS=2, iH=7,iW=6,  iC=5,  kH=3,kW=3,  sH=2,sW=2,  pH=1,pW=1,  dH=1,dW=2;
+    int paddingMode = 0;             // 1-SAME, 0-VALID;
+
+    NDArray input('c', {bS, iC, iH, iW}, nd4j::DataType::FLOAT32);
+    input.linspace(-10., 0.1);
+    auto permuted  = input.permute({0, 2, 3, 1});
+    auto inputNHWC = permuted->dup('c');                                            // [bS, iH, iW, iC]
+
+    nd4j::ops::avgpool2d op;
+
+    for (int extraParam0 = 0; extraParam0 < 2; ++extraParam0) {                    // exclude and include padding
+        auto resultsNCHW = op.execute({&input},    {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, extraParam0, 0});
+        auto resultsNHWC = op.execute({inputNHWC}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, extraParam0, 1});
+
+        ASSERT_EQ(Status::OK(), resultsNCHW->status());
+        ASSERT_EQ(Status::OK(), resultsNHWC->status());
+
+        auto outNHWC = resultsNHWC->at(0);
+        outNHWC->permutei({0, 3, 1, 2});                                            // [bS, oH, oW, iC] -> [bS, iC, oH, oW]
+
+        ASSERT_TRUE(resultsNCHW->at(0)->isSameShape(outNHWC));
+        ASSERT_TRUE(resultsNCHW->at(0)->equalsTo(outNHWC));
+
+        delete resultsNCHW;
+        delete resultsNHWC;
+    }
+
+    delete permuted;
+    delete inputNHWC;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, pnormpool2d_nhwc_nchw_1) {
+
+    int bS=2, iH=6,iW=6,  iC=4,  kH=2,kW=2,  sH=1,sW=1,  pH=0,pW=0,  dH=1,dW=1;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+    int pnorm = 2;
+
+    NDArray input('c', {bS, iC, iH, iW}, nd4j::DataType::FLOAT32);
+    input.linspace(-5., 0.1);
+    auto permuted  = input.permute({0, 2, 3, 1});
+    auto inputNHWC = permuted->dup('c');                                            // [bS, iH, iW, iC]
+
+    nd4j::ops::pnormpool2d op;
+    auto resultsNCHW = op.execute({&input},    {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, pnorm, 0});
+    auto resultsNHWC = op.execute({inputNHWC}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, pnorm, 1});
+
+    ASSERT_EQ(Status::OK(), resultsNCHW->status());
+    ASSERT_EQ(Status::OK(), resultsNHWC->status());
+
+    auto outNHWC = resultsNHWC->at(0);
+    outNHWC->permutei({0, 3, 1, 2});                                                // [bS, oH, oW, iC] -> [bS, iC, oH, oW]
+
+    ASSERT_TRUE(resultsNCHW->at(0)->isSameShape(outNHWC));
+    ASSERT_TRUE(resultsNCHW->at(0)->equalsTo(outNHWC));
+
+    delete permuted;
+    delete inputNHWC;
+    delete resultsNCHW;
+    delete resultsNHWC;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, pooling3d_ndhwc_ncdhw_1) {
+
+    int bS=2, iD=4,iH=5,iW=4,  iC=3,  kD=2,kH=3,kW=2,  sD=1,sH=2,sW=1,  pD=1,pH=1,pW=0,  dD=1,dH=1,dW=2;
+    int paddingMode = 0;             // 1-SAME,  0-VALID
+
+    NDArray input('c', {bS, iC, iD, iH, iW}, nd4j::DataType::FLOAT32);
+    input.linspace(-10., 0.1);
+    auto permuted  = input.permute({0, 2, 3, 4, 1});
+    auto inputNDHWC = permuted->dup('c');                                           // [bS, iD, iH, iW, iC]
+
+    nd4j::ops::maxpool3dnew maxOp;
+    nd4j::ops::avgpool3dnew avgOp;
+    std::vector<nd4j::ops::DeclarableOp*> ops = {&maxOp, &avgOp};
+
+    for (auto op : ops) {
+        auto resultsNCDHW = op->execute({&input},     {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, 0, 0});
+        auto resultsNDHWC = op->execute({inputNDHWC}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, 0, 1});
+
+        ASSERT_EQ(Status::OK(), resultsNCDHW->status());
+        ASSERT_EQ(Status::OK(), resultsNDHWC->status());
+
+        auto outNDHWC = resultsNDHWC->at(0);
+        outNDHWC->permutei({0, 4, 1, 2, 3});                                        // [bS, oD, oH, oW, iC] -> [bS, iC, oD, oH, oW]
+
+        ASSERT_TRUE(resultsNCDHW->at(0)->isSameShape(outNDHWC));
+        ASSERT_TRUE(resultsNCDHW->at(0)->equalsTo(outNDHWC));
+
+        delete resultsNCDHW;
+        delete resultsNDHWC;
+    }
+
+    delete permuted;
+    delete inputNDHWC;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, conv2d_nhwc_nchw_1) {
+
+    int bS=2, iH=7,iW=6,  iC=3,oC=4,  kH=3,kW=2,  sH=2,sW=1,  pH=0,pW=0,  dH=1,dW=2;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+
+    NDArray input('c', {bS, iC, iH, iW}, nd4j::DataType::DOUBLE);
+    NDArray weights('c', {kH, kW, iC, oC}, nd4j::DataType::DOUBLE);
+    NDArray bias('c', {oC}, {-1., 0.5, 1., 2.}, nd4j::DataType::DOUBLE);
+    input.linspace(-3., 0.05);
+    weights.linspace(-0.5, 0.02);
+    auto permuted  = input.permute({0, 2, 3, 1});
+    auto inputNHWC = permuted->dup('c');                                            // [bS, iH, iW, iC]
+
+    nd4j::ops::conv2d op;
+    auto resultsNCHW = op.execute({&input,    &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, 0});
+    auto resultsNHWC = op.execute({inputNHWC, &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, 1});
+
+    ASSERT_EQ(Status::OK(), resultsNCHW->status());
+    ASSERT_EQ(Status::OK(), resultsNHWC->status());
+
+    auto outNHWC = resultsNHWC->at(0);
+    outNHWC->permutei({0, 3, 1, 2});                                                // [bS, oH, oW, oC] -> [bS, oC, oH, oW]
+
+    ASSERT_TRUE(resultsNCHW->at(0)->isSameShape(outNHWC));
+    ASSERT_TRUE(resultsNCHW->at(0)->equalsTo(outNHWC));
+
+    delete permuted;
+    delete inputNHWC;
+    delete resultsNCHW;
+    delete resultsNHWC;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, depthwise_conv2d_nhwc_nchw_1) {
+
+    int bS=2, iH=6,iW=7,  iC=3,mC=2,  kH=3,kW=3,  sH=1,sW=2,  pH=0,pW=0,  dH=2,dW=1;
+    int       oC=iC*mC;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+
+    NDArray input('c', {bS, iC, iH, iW}, nd4j::DataType::DOUBLE);
+    NDArray weights('c', {kH, kW, iC, mC}, nd4j::DataType::DOUBLE);
+    NDArray bias('c', {oC}, {-1., -0.5, 0., 0.5, 1., 1.5}, nd4j::DataType::DOUBLE);
+    input.linspace(-3., 0.05);
+    weights.linspace(-0.5, 0.02);
+    auto permuted  = input.permute({0, 2, 3, 1});
+    auto inputNHWC = permuted->dup('c');                                            // [bS, iH, iW, iC]
+
+    nd4j::ops::depthwise_conv2d op;
+    auto resultsNCHW = op.execute({&input,    &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, 0});
+    auto resultsNHWC = op.execute({inputNHWC, &weights, &bias}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, 1});
+
+    ASSERT_EQ(Status::OK(), resultsNCHW->status());
+    ASSERT_EQ(Status::OK(), resultsNHWC->status());
+
+    auto outNHWC = resultsNHWC->at(0);
+    outNHWC->permutei({0, 3, 1, 2});                                                // [bS, oH, oW, oC] -> [bS, oC, oH, oW]
+
+    ASSERT_TRUE(resultsNCHW->at(0)->isSameShape(outNHWC));
+    ASSERT_TRUE(resultsNCHW->at(0)->equalsTo(outNHWC));
+
+    delete permuted;
+    delete inputNHWC;
+    delete resultsNCHW;
+    delete resultsNHWC;
+}
+
  // @Test
  //    public void testSconv2dbp(){
 
@@ -2344,6 +2344,36 @@ TYPED_TEST(TypedDeclarableOpsTests10, batchnorm_new_test3) {
     delete results;
 }
 
+////////////////////////////////////////////////////////////////////
+TYPED_TEST(TypedDeclarableOpsTests10, batchnorm_new_test4) {
+
+    auto input    = NDArrayFactory::create<TypeParam>('c', {2,2,2,6});
+    auto mean     = NDArrayFactory::create<TypeParam>('c', {6}, {1., 1.5, 2., 2.5, 3., 3.5});
+    auto variance = NDArrayFactory::create<TypeParam>('c', {6}, {0.5, 0.6, 0.7, 0.8, 0.9, 1.});
+    auto gamma    = NDArrayFactory::create<TypeParam>('c', {6}, {1.2, 1.1, 1., 0.9, 0.8, 0.7});
+    auto beta     = NDArrayFactory::create<TypeParam>('c', {6}, {0.1, 0.2, 0.3, 0.4, 0.5, 0.6});
+
+    auto expected = NDArrayFactory::create<TypeParam>('c', {2,2,2,6}, {-1.42733537,-1.64610668,-1.73187412,-1.71307103,-1.60817339,-1.42998985,-0.40911179,-0.79405744,-1.01474208,-1.10933645,-1.10221178,-1.00999195,
+                                             0.60911179, 0.05799179,-0.29761004,-0.50560187,-0.59625017,-0.58999405, 1.62733537, 0.91004103, 0.41952201, 0.09813271,-0.09028855,-0.16999615,
+                                             2.64555896, 1.76209027, 1.13665405, 0.70186729, 0.41567306, 0.25000175, 3.66378254, 2.61413950, 1.85378609, 1.30560187, 0.92163468, 0.66999965,
+                                             4.68200612, 3.46618874, 2.57091814, 1.90933645, 1.42759629, 1.08999755, 5.70022970, 4.31823797, 3.28805018, 2.51307103, 1.93355791, 1.50999545});
+
+    input.linspace(0.1, 0.1);
+
+    nd4j::ops::batchnorm_new op;
+
+    auto results = op.execute({&input, &mean, &variance, &gamma, &beta}, {1e-5}, {1,1,3});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    auto output = results->at(0);
+
+    ASSERT_TRUE(expected.isSameShapeStrict(output));
+    ASSERT_TRUE(expected.equalsTo(output));
+
+    delete results;
+}
+
 ///////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests10, bool_broadcast_test_1) {
 
@@ -1328,6 +1328,26 @@ TEST_F(DeclarableOpsTests12, lrn_5) {
     delete results;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests12, lrn_6) {
+
+    NDArray input('c', {2,2,1,12});
+    NDArray exp('c', {2,2,1,12}, {-0.20986328, -0.17551154, -0.15097337, -0.13227999, -0.13612106, -0.14029981, -0.14486502, -0.14987461, -0.15539726, -0.17089024, -0.19073108, -0.21763970,
+                                  -0.38399356, -0.31541812, -0.26149355, -0.21480563, -0.22420805, -0.22734340, -0.21022410, -0.14164008,  0.        ,  0.20080045,  0.45292012,  0.70241170,
+                                   0.24155659,  0.22529866,  0.20904298,  0.19382336,  0.18439259,  0.17591060,  0.16831745,  0.16151381,  0.15539726,  0.17885914,  0.20912571,  0.25094343,
+                                   0.18233372,  0.15703664,  0.13904940,  0.12545259,  0.12240180,  0.11955777,  0.11689875,  0.11440598,  0.11206320,  0.12722335,  0.14731690,  0.17565967});
+
+    input.linspace(-10, 0.5);
+
+    nd4j::ops::lrn op;
+
+    auto results = op.execute({&input}, {1., 0.5, 0.75}, {3});
+    auto output = results->at(0);
+    ASSERT_EQ(*output, exp);
+
+    delete results;
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests12, inTopK_1) {
     
@@ -26,6 +26,8 @@
 #include <graph/Node.h>
 #include <graph/Graph.h>
 #include <GraphExecutioner.h>
+#include <graph/ExecutionPlan.h>
+#include <NativeOps.h>
 #include <ops/declarable/CustomOperations.h>
 
 using namespace nd4j;
@@ -206,6 +208,84 @@ TEST_F(FlatBuffersTest, FlatGraphTest1) {
     delete resultWrapper;
 }
 
+// abs -> cos over 5x5 variable filled with -2
+static void buildAbsCos(flatbuffers::FlatBufferBuilder &builder) {
+    auto array = NDArrayFactory::create<float>('c', {5, 5});
+    array.assign(-2.0f);
+
+    auto fShape = builder.CreateVector(array.getShapeInfoAsFlatVector());
+    auto fBuffer = builder.CreateVector(array.asByteVector());
+    auto fArray = CreateFlatArray(builder, fShape, fBuffer, nd4j::graph::DataType::DataType_FLOAT);
+    auto fVar = CreateFlatVariable(builder, CreateIntPair(builder, -1), 0, nd4j::graph::DataType::DataType_FLOAT, 0, fArray);
+
+    std::vector<int> inputs1({-1}), inputs2({1});
+    auto node1 = CreateFlatNode(builder, 1, builder.CreateString("abs"), OpType_TRANSFORM_SAME, transform::Abs, 0, builder.CreateVector(inputs1));
+    auto node2 = CreateFlatNode(builder, 2, builder.CreateString("cos"), OpType_TRANSFORM_STRICT, transform::Cosine, 0, builder.CreateVector(inputs2));
+
+    std::vector<flatbuffers::Offset<FlatVariable>> variables_vector({fVar});
+    std::vector<flatbuffers::Offset<FlatNode>> nodes_vector({node1, node2});
+    auto nodes = builder.CreateVector(nodes_vector);
+    auto variables = builder.CreateVector(variables_vector);
+
+    FlatGraphBuilder graphBuilder(builder);
+    graphBuilder.add_variables(variables);
+    graphBuilder.add_id(119);
+    graphBuilder.add_nodes(nodes);
+    builder.Finish(graphBuilder.Finish());
+}
+
+TEST_F(FlatBuffersTest, ExecutionPlan_Weights_1) {
+    flatbuffers::FlatBufferBuilder builder(4096);
+    buildAbsCos(builder);
+
+    auto buf = builder.GetBufferPointer();
+    auto flatGraph = GetFlatGraph(buf);
+
+    Graph graph(flatGraph);
+    auto plan = ExecutionPlan::fromGraph(&graph);
+    auto buffer = plan->asBuffer();
+    ASSERT_EQ(Graph::hashFlatGraph(flatGraph), plan->graphFingerprint());
+
+    NativeOps nativeOps;
+    ASSERT_EQ(ND4J_STATUS_OK, nativeOps.registerGraphWithPlan(nullptr, 119, reinterpret_cast<Nd4jPointer>(buf), buffer.data(), buffer.size()));
+    nativeOps.unregisterGraph(nullptr, 119);
+
+    // same topology with retrained weights must not reuse the plan, since folded constants would be stale
+    auto weights = const_cast<int8_t*>(flatGraph->variables()->Get(0)->ndarray()->buffer()->data());
+    weights[0] ^= 0x01;
+
+    ASSERT_NE(plan->graphFingerprint(), Graph::hashFlatGraph(flatGraph));
+    ASSERT_EQ(ND4J_STATUS_BAD_INPUT, nativeOps.registerGraphWithPlan(nullptr, 120, reinterpret_cast<Nd4jPointer>(buf), buffer.data(), buffer.size()));
+
+    delete plan;
+}
+
+TEST_F(FlatBuffersTest, ExecutionPlan_Export_1) {
+    NativeOps nativeOps;
+    ASSERT_EQ(nullptr, nativeOps.exportExecutionPlan(nullptr, 121));
+
+    flatbuffers::FlatBufferBuilder builder(4096);
+    buildAbsCos(builder);
+    ASSERT_EQ(ND4J_STATUS_OK, nativeOps.registerGraph(nullptr, 121, reinterpret_cast<Nd4jPointer>(builder.GetBufferPointer())));
+
+    // registered graph itself is never executed, so shapes come from shape pass
+    auto result = nativeOps.exportExecutionPlan(nullptr, 121);
+    ASSERT_NE(nullptr, result);
+
+    auto plan = ExecutionPlan::fromBuffer(result->pointer(), result->size());
+    ASSERT_EQ(2, plan->nodes()->size());
+    ASSERT_TRUE(plan->requiredMemory() > 0);
+    for (auto &np: *plan->nodes()) {
+        ASSERT_EQ(1, np.shapes.size());
+        ASSERT_EQ(std::vector<Nd4jLong>({5, 5}), std::vector<Nd4jLong>(shape::shapeOf(np.shapes[0].data()), shape::shapeOf(np.shapes[0].data()) + 2));
+    }
+
+    nativeOps.unregisterGraph(nullptr, 121);
+
+    delete plan;
+    delete result;
+}
+
 TEST_F(FlatBuffersTest, ExecutionTest1) {
     auto gA = new Node(OpType_TRANSFORM_SAME);
 
@@ -571,6 +651,88 @@ TEST_F(FlatBuffersTest, ReduceDim_1) {
     delete graph;
 }
 
+TEST_F(FlatBuffersTest, ExecutionPlan_1) {
+    auto data = nd4j::graph::readFlatBuffers("./resources/reduce_dim_false.fb");
+    auto graph = GraphExecutioner::importFromFlatPointer(reinterpret_cast<Nd4jPointer>(data));
+
+    ASSERT_EQ(ND4J_STATUS_OK, GraphExecutioner::execute(graph));
+
+    auto plan = ExecutionPlan::fromGraph(graph);
+    ASSERT_TRUE(plan->isCompatible());
+    ASSERT_EQ(graph->getMapped()->size(), plan->nodes()->size());
+    ASSERT_EQ(graph->getVariableSpace()->numberOfSlots(), plan->slots()->size());
+    ASSERT_TRUE(plan->requiredMemory() > 0);
+
+    auto buffer = plan->asBuffer();
+    auto restored = ExecutionPlan::fromBuffer(buffer.data(), buffer.size());
+    ASSERT_EQ(plan->nodes()->size(), restored->nodes()->size());
+    ASSERT_EQ(plan->requiredMemory(), restored->requiredMemory());
+
+    auto planned = GraphExecutioner::importFromFlatPointer(reinterpret_cast<Nd4jPointer>(data), restored);
+    for (auto &np: *plan->nodes()) {
+        ASSERT_TRUE(planned->hasNode(np.id));
+        ASSERT_EQ(np.layer, planned->nodeById(np.id)->getLayer());
+        ASSERT_EQ(np.inputSlots, *planned->nodeById(np.id)->getContextPrototype()->inputSlots());
+    }
+
+    ASSERT_EQ(ND4J_STATUS_OK, GraphExecutioner::execute(planned));
+
+    auto exp = graph->getVariableSpace()->getVariable(3)->getNDArray();
+    auto z = planned->getVariableSpace()->getVariable(3)->getNDArray();
+    ASSERT_TRUE(exp->isSameShape(z));
+    ASSERT_TRUE(exp->equalsTo(z));
+
+    delete plan;
+    delete restored;
+    delete planned;
+    delete graph;
+    delete[] data;
+}
+
+TEST_F(FlatBuffersTest, ExecutionPlan_2) {
+    std::vector<int8_t> garbage = {1, 2, 3, 4, 5, 6, 7, 8};
+    ASSERT_ANY_THROW(ExecutionPlan::fromBuffer(garbage.data(), garbage.size()));
+
+    auto graph = GraphExecutioner::importFromFlatBuffers("./resources/reduce_dim_false.fb");
+    auto plan = ExecutionPlan::fromGraph(graph);
+    auto buffer = plan->asBuffer();
+
+    // truncated plan must be rejected, not read past the end
+    buffer.resize(buffer.size() - 4);
+    ASSERT_ANY_THROW(ExecutionPlan::fromBuffer(buffer.data(), buffer.size()));
+
+    delete plan;
+    delete graph;
+}
+
+TEST_F(FlatBuffersTest, ExecutionPlan_3) {
+    auto data = nd4j::graph::readFlatBuffers("./resources/reduce_dim_false.fb");
+    auto other = nd4j::graph::readFlatBuffers("./resources/reduce_dim_true.fb");
+    auto graph = GraphExecutioner::importFromFlatPointer(reinterpret_cast<Nd4jPointer>(data));
+
+    auto plan = ExecutionPlan::fromGraph(graph);
+    ASSERT_EQ(graph->fingerprint(), plan->graphFingerprint());
+    ASSERT_NE(graph->fingerprint(), Graph::hashFlatGraph(nd4j::graph::GetFlatGraph(other)));
+
+    // plan captured from another graph is rejected
+    auto buffer = plan->asBuffer();
+    NativeOps nativeOps;
+    ASSERT_EQ(ND4J_STATUS_BAD_INPUT, nativeOps.registerGraphWithPlan(nullptr, 119, reinterpret_cast<Nd4jPointer>(other), buffer.data(), buffer.size()));
+
+    // node missing in plan isn't erased, graph is built from scratch instead
+    auto missing = plan->nodes()->back().id;
+    plan->nodes()->pop_back();
+    auto planned = GraphExecutioner::importFromFlatPointer(reinterpret_cast<Nd4jPointer>(data), plan);
+    ASSERT_TRUE(planned->hasNode(missing));
+    ASSERT_EQ(graph->getMapped()->size(), planned->getMapped()->size());
+
+    delete planned;
+    delete plan;
+    delete graph;
+    delete[] data;
+    delete[] other;
+}
+
 TEST_F(FlatBuffersTest, ReduceDim_2) {
     auto exp = NDArrayFactory::create<float>('c', {3, 1});
     exp.assign(3.0);
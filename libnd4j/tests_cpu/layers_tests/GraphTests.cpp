@@ -1638,3 +1638,547 @@ TEST_F(GraphTests, Test_Minifier_3) {
     //ASSERT_EQ(0, unlink("libnd4j_mini3.hpp"));
 
 }
+
+TEST_F(GraphTests, Test_Layouts_1) {
+    auto exp = NDArrayFactory::create<float>('c', {2, 3, 4, 5});
+
+    for (int enabled = 0; enabled < 2; enabled++) {
+        Environment::getInstance()->setOptimizeLayouts(enabled == 1);
+
+        Graph graph;
+
+        auto x = NDArrayFactory::create_<float>('c', {2, 3, 4, 5});
+        x->linspace(-2.f, 0.05f);
+        graph.getVariableSpace()->putVariable(-1, x);
+
+        nd4j::ops::permute permute;
+        nd4j::ops::sigmoid sigmoid;
+        nd4j::ops::tanh tanh;
+
+        graph.addNode(new Node(&permute, 1, {-1}, {}, {}, 0.0f, {}, {0, 2, 3, 1}));
+        graph.addNode(new Node(&sigmoid, 2, {1}));
+        graph.addNode(new Node(&permute, 3, {2}, {}, {}, 0.0f, {}, {0, 3, 1, 2}));
+        graph.addNode(new Node(&tanh, 4, {3}));
+
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+        auto z = graph.getVariableSpace()->getVariable(4)->getNDArray();
+        if (enabled) {
+            ASSERT_FALSE(graph.hasNode(1));
+            ASSERT_FALSE(graph.hasNode(3));
+            ASSERT_EQ(2, graph.eliminatedPermutes()->size());
+            ASSERT_EQ(-1, graph.nodeById(2)->input()->at(0).first);
+            ASSERT_EQ(2, graph.nodeById(4)->input()->at(0).first);
+            ASSERT_TRUE(exp.isSameShape(z));
+            ASSERT_TRUE(exp.equalsTo(z));
+        } else {
+            ASSERT_TRUE(graph.eliminatedPermutes()->empty());
+            exp.assign(z);
+        }
+    }
+
+    Environment::getInstance()->setOptimizeLayouts(true);
+}
+
+TEST_F(GraphTests, Test_Layouts_2) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {3, 4});
+    x->linspace(1);
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    nd4j::ops::transpose transpose;
+    nd4j::ops::sigmoid sigmoid;
+
+    graph.addNode(new Node(&transpose, 1, {-1}));
+    graph.addNode(new Node(&transpose, 2, {1}));
+    graph.addNode(new Node(&sigmoid, 3, {2}));
+
+    auto exp = sigmoid.execute({x}, {}, {});
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    ASSERT_FALSE(graph.hasNode(1));
+    ASSERT_FALSE(graph.hasNode(2));
+    ASSERT_EQ(-1, graph.nodeById(3)->input()->at(0).first);
+
+    auto z = graph.getVariableSpace()->getVariable(3)->getNDArray();
+    ASSERT_TRUE(exp->at(0)->isSameShape(z));
+    ASSERT_TRUE(exp->at(0)->equalsTo(z));
+
+    delete exp;
+}
+
+TEST_F(GraphTests, Test_Layouts_3) {
+    auto exp = NDArrayFactory::create<float>('c', {2, 4, 3, 3});
+
+    for (int enabled = 0; enabled < 2; enabled++) {
+        Environment::getInstance()->setOptimizeLayouts(enabled == 1);
+
+        Graph graph;
+
+        auto x = NDArrayFactory::create_<float>('c', {2, 3, 5, 5});
+        auto w = NDArrayFactory::create_<float>('c', {3, 3, 3, 4});
+        x->linspace(-1.f, 0.01f);
+        w->linspace(-0.5f, 0.01f);
+        graph.getVariableSpace()->putVariable(-1, x);
+        graph.getVariableSpace()->putVariable(-2, w);
+
+        nd4j::ops::permute permute;
+        nd4j::ops::conv2d conv2d;
+        nd4j::ops::tanh tanh;
+
+        // NCHW input goes through NHWC convolution and back
+        graph.addNode(new Node(&permute, 1, {-1}, {}, {}, 0.0f, {}, {0, 2, 3, 1}));
+        graph.addNode(new Node(&conv2d, 2, {1, -2}, {}, {}, 0.0f, {}, {3, 3, 1, 1, 0, 0, 1, 1, 0, 1}));
+        graph.addNode(new Node(&permute, 3, {2}, {}, {}, 0.0f, {}, {0, 3, 1, 2}));
+        graph.addNode(new Node(&tanh, 4, {3}));
+
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+        auto z = graph.getVariableSpace()->getVariable(4)->getNDArray();
+        if (enabled) {
+            ASSERT_FALSE(graph.hasNode(1));
+            ASSERT_FALSE(graph.hasNode(3));
+            ASSERT_EQ(0, graph.nodeById(2)->getContextPrototype()->getIArguments()->at(9));
+            ASSERT_TRUE(exp.isSameShape(z));
+            ASSERT_TRUE(exp.equalsTo(z, 1e-5));
+        } else {
+            exp.assign(z);
+        }
+    }
+
+    Environment::getInstance()->setOptimizeLayouts(true);
+}
+
+TEST_F(GraphTests, Test_Layouts_4) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {3, 4});
+    x->linspace(-1.f, 0.1f);
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    nd4j::ops::transpose transpose;
+    nd4j::ops::sigmoid sigmoid;
+
+    // final transpose is pinned, so first one is only moved past sigmoid and nothing gets eliminated
+    graph.addNode(new Node(&transpose, 1, {-1}));
+    graph.addNode(new Node(&sigmoid, 2, {1}));
+    graph.addNode(new Node(&transpose, 3, {2}));
+
+    auto exp = sigmoid.execute({x}, {}, {});
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    ASSERT_TRUE(graph.eliminatedPermutes()->empty());
+    ASSERT_EQ(-1, graph.nodeById(2)->input()->at(0).first);
+    ASSERT_EQ(2, graph.nodeById(1)->input()->at(0).first);
+
+    auto z = graph.getVariableSpace()->getVariable(3)->getNDArray();
+    ASSERT_TRUE(exp->at(0)->isSameShape(z));
+    ASSERT_TRUE(exp->at(0)->equalsTo(z));
+
+    delete exp;
+}
+
+TEST_F(GraphTests, Test_Layouts_5) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 3, 4, 5});
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    nd4j::ops::permute permute;
+
+    // Im2col reads its input as NCHW, so permutes around it must stay in place
+    graph.addNode(new Node(&permute, 1, {-1}, {}, {}, 0.0f, {}, {0, 2, 3, 1}));
+    graph.addNode(new Node(OpType_TRANSFORM_SAME, transform::Im2col, 2, {1}));
+    graph.addNode(new Node(&permute, 3, {2}, {}, {}, 0.0f, {}, {0, 3, 1, 2}));
+    graph.addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 4, {3}));
+
+    ASSERT_EQ(Status::OK(), graph.buildGraph());
+
+    ASSERT_TRUE(graph.eliminatedPermutes()->empty());
+    ASSERT_TRUE(graph.hasNode(1));
+    ASSERT_TRUE(graph.hasNode(3));
+    ASSERT_EQ(1, graph.nodeById(2)->input()->at(0).first);
+    ASSERT_EQ(2, graph.nodeById(3)->input()->at(0).first);
+}
+
+TEST_F(GraphTests, Test_Slots_1) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 2});
+    x->assign(-1.f);
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    nd4j::ops::sigmoid sigmoid;
+    nd4j::ops::tanh tanh;
+
+    graph.addNode(new Node(&sigmoid, 1, {-1}));
+    graph.addNode(new Node(&tanh, 2, {1}));
+    graph.addNode(new Node(&tanh, 3, {1}));
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    // (-1, 0), (1, 0), (2, 0) and (3, 0)
+    ASSERT_EQ(4, graph.getVariableSpace()->numberOfSlots());
+
+    for (int e = 1; e <= 3; e++) {
+        auto block = graph.nodeById(e)->getContextPrototype();
+        ASSERT_EQ(block->inputs()->size(), block->inputSlots()->size());
+    }
+
+    ASSERT_EQ(graph.nodeById(2)->getContextPrototype()->inputSlots()->at(0), graph.nodeById(3)->getContextPrototype()->inputSlots()->at(0));
+
+    auto exp = NDArrayFactory::create<float>('c', {2, 2});
+    exp.assign(std::tanh(1.f / (1.f + std::exp(1.f))));
+
+    ASSERT_TRUE(exp.equalsTo(graph.getVariableSpace()->getVariable(3)->getNDArray()));
+}
+
+TEST_F(GraphTests, Test_Fold_Constants_1) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 2});
+    auto y = NDArrayFactory::create_<float>('c', {2, 2});
+    x->assign(-1.f);
+    y->linspace(1);
+
+    auto placeholder = new Variable(true);
+    placeholder->setNDArray(y);
+
+    auto constant = new Variable(x);
+    constant->markConstant(true);
+
+    graph.getVariableSpace()->putVariable(-1, constant);
+    graph.getVariableSpace()->putVariable(-2, placeholder);
+
+    nd4j::ops::sigmoid sigmoid;
+    nd4j::ops::tanh tanh;
+    nd4j::ops::add add;
+
+    // sigmoid and tanh depend on constant only, so they're evaluated during build
+    graph.addNode(new Node(&sigmoid, 1, {-1}));
+    graph.addNode(new Node(&tanh, 2, {1}));
+    graph.addNode(new Node(&add, 3, {2, -2}));
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    ASSERT_FALSE(graph.hasNode(1));
+    ASSERT_FALSE(graph.hasNode(2));
+
+    auto folded = graph.nodeById(3)->input()->at(0);
+    ASSERT_TRUE(folded.first < 0);
+    ASSERT_TRUE(graph.getVariableSpace()->getVariable(folded)->isExternal());
+
+    auto exp = NDArrayFactory::create<float>('c', {2, 2});
+    exp.linspace(1);
+    exp += std::tanh(1.f / (1.f + std::exp(1.f)));
+
+    auto z = graph.getVariableSpace()->getVariable(3)->getNDArray();
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+}
+
+TEST_F(GraphTests, Test_Fold_Constants_2) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 2});
+    auto y = NDArrayFactory::create_<float>('c', {2, 2});
+    auto c = NDArrayFactory::create_<float>('c', {2, 2});
+    x->assign(-1.f);
+    y->linspace(1);
+    c->assign(2.f);
+
+    auto placeholder = new Variable(true);
+    placeholder->setNDArray(y);
+
+    auto constant = new Variable(c);
+    constant->markConstant(true);
+
+    // -1 is regular variable, so it can be fed after graph is built
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, placeholder);
+    graph.getVariableSpace()->putVariable(-3, constant);
+
+    nd4j::ops::sigmoid sigmoid;
+    nd4j::ops::tanh tanh;
+    nd4j::ops::add add;
+
+    graph.addNode(new Node(&sigmoid, 1, {-1}));
+    graph.addNode(new Node(&tanh, 2, {-3}));
+    graph.addNode(new Node(&add, 3, {1, 2}));
+    graph.addNode(new Node(&add, 4, {3, -2}));
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    ASSERT_TRUE(graph.hasNode(1));
+    ASSERT_FALSE(graph.hasNode(2));
+
+    // feeding new value the same way executeStoredGraph does
+    auto var = graph.getVariableSpace()->getVariable(-1);
+    delete var->getNDArray();
+    auto fed = NDArrayFactory::create_<float>('c', {2, 2});
+    fed->assign(1.f);
+    var->setNDArray(fed);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto exp = NDArrayFactory::create<float>('c', {2, 2});
+    exp.linspace(1);
+    exp += 1.f / (1.f + std::exp(-1.f)) + std::tanh(2.f);
+
+    auto z = graph.getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+}
+
+TEST_F(GraphTests, Test_Prune_Unreachable_1) {
+    Graph graph;
+    graph.getExecutorConfiguration()->_outputMode = OutputMode_EXPLICIT;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 2});
+    x->assign(-1.f);
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    nd4j::ops::sigmoid sigmoid;
+    nd4j::ops::tanh tanh;
+
+    graph.addNode(new Node(&sigmoid, 1, {-1}));
+    graph.addNode(new Node(&tanh, 2, {1}));
+    graph.addNode(new Node(&tanh, 3, {1}));
+    graph.addOutput(2);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    ASSERT_TRUE(graph.hasNode(1));
+    ASSERT_TRUE(graph.hasNode(2));
+    ASSERT_FALSE(graph.hasNode(3));
+
+    auto exp = NDArrayFactory::create<float>('c', {2, 2});
+    exp.assign(std::tanh(1.f / (1.f + std::exp(1.f))));
+
+    auto outputs = graph.fetchOutputs();
+    ASSERT_EQ(1, outputs->size());
+    ASSERT_TRUE(exp.equalsTo(outputs->at(0)->getNDArray()));
+
+    delete outputs;
+}
+
+TEST_F(GraphTests, Test_Simplify_1) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 2});
+    x->assign(-1.f);
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    nd4j::ops::sigmoid sigmoid;
+    nd4j::ops::add add;
+
+    // node 2 is exact duplicate of node 1
+    graph.addNode(new Node(&sigmoid, 1, {-1}));
+    graph.addNode(new Node(&sigmoid, 2, {-1}));
+    graph.addNode(new Node(&add, 3, {1, 2}));
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    ASSERT_TRUE(graph.hasNode(1));
+    ASSERT_FALSE(graph.hasNode(2));
+    ASSERT_EQ(1, graph.nodeById(3)->input()->at(0).first);
+    ASSERT_EQ(1, graph.nodeById(3)->input()->at(1).first);
+
+    auto exp = NDArrayFactory::create<float>('c', {2, 2});
+    exp.assign(2.f / (1.f + std::exp(1.f)));
+
+    ASSERT_TRUE(exp.equalsTo(graph.getVariableSpace()->getVariable(3)->getNDArray()));
+}
+
+TEST_F(GraphTests, Test_Simplify_2) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 3});
+    x->linspace(1);
+    auto one = new Variable(NDArrayFactory::create_<float>(1.f));
+    one->markConstant(true);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, one);
+
+    nd4j::ops::identity identity;
+    nd4j::ops::multiply multiply;
+    nd4j::ops::reshape reshape;
+    nd4j::ops::tanh tanh;
+
+    graph.addNode(new Node(&identity, 1, {-1}));
+    graph.addNode(new Node(&multiply, 2, {1, -2}));
+    graph.addNode(new Node(&reshape, 3, {2}, {}, {}, 0.0f, {}, {-99, 6}));
+    graph.addNode(new Node(&reshape, 4, {3}, {}, {}, 0.0f, {}, {-99, 3, 2}));
+    graph.addNode(new Node(&tanh, 5, {4}));
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    ASSERT_FALSE(graph.hasNode(1));
+    ASSERT_FALSE(graph.hasNode(2));
+    ASSERT_FALSE(graph.hasNode(3));
+    ASSERT_EQ(-1, graph.nodeById(4)->input()->at(0).first);
+
+    auto exp = x->reshape('c', {3, 2});
+    exp->applyTransform(transform::Tanh);
+
+    auto z = graph.getVariableSpace()->getVariable(5)->getNDArray();
+    ASSERT_TRUE(exp->isSameShape(z));
+    ASSERT_TRUE(exp->equalsTo(z));
+
+    delete exp;
+}
+
+TEST_F(GraphTests, Test_Simplify_3) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {3});
+    x->linspace(1);
+
+    auto oneDouble = new Variable(NDArrayFactory::create_<double>(1.));
+    auto oneMatrix = new Variable(NDArrayFactory::create_<float>('c', {1, 1}));
+    auto oneFloat = new Variable(NDArrayFactory::create_<float>(1.f));
+    oneMatrix->getNDArray()->assign(1.f);
+    for (auto v: {oneDouble, oneMatrix, oneFloat})
+        v->markConstant(true);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, oneDouble);
+    graph.getVariableSpace()->putVariable(-3, oneMatrix);
+    graph.getVariableSpace()->putVariable(-4, oneFloat);
+
+    nd4j::ops::multiply multiply;
+    nd4j::ops::add add;
+
+    // first one promotes result to double, second one broadcasts it to [1, 3], only third one is a plain copy
+    graph.addNode(new Node(&multiply, 1, {-1, -2}));
+    graph.addNode(new Node(&multiply, 2, {-1, -3}));
+    graph.addNode(new Node(&multiply, 3, {-1, -4}));
+    graph.addNode(new Node(&add, 4, {1, 2}));
+    graph.addNode(new Node(&add, 5, {4, 3}));
+
+    ASSERT_EQ(Status::OK(), graph.buildGraph());
+
+    ASSERT_TRUE(graph.hasNode(1));
+    ASSERT_TRUE(graph.hasNode(2));
+    ASSERT_FALSE(graph.hasNode(3));
+    ASSERT_EQ(-1, graph.nodeById(5)->input()->at(1).first);
+}
+
+TEST_F(GraphTests, Test_Simplify_4) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {4, 2});
+    auto indices = NDArrayFactory::create_<int>('c', {1}, {1});
+    auto updates = NDArrayFactory::create_<float>('c', {1, 2});
+    x->linspace(1);
+    updates->assign(-1.f);
+
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, indices);
+    graph.getVariableSpace()->putVariable(-3, updates);
+
+    nd4j::ops::scatter_upd scatter;
+    nd4j::ops::add add;
+
+    // scatter ops may write into their input, so identical nodes aren't merged
+    graph.addNode(new Node(&scatter, 1, {-1, -2, -3}));
+    graph.addNode(new Node(&scatter, 2, {-1, -2, -3}));
+    graph.addNode(new Node(&add, 3, {1, 2}));
+
+    ASSERT_EQ(Status::OK(), graph.buildGraph());
+
+    ASSERT_TRUE(graph.hasNode(1));
+    ASSERT_TRUE(graph.hasNode(2));
+    ASSERT_EQ(2, graph.nodeById(3)->input()->at(1).first);
+}
+
+TEST_F(GraphTests, Test_Infer_Shapes_1) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 3});
+    x->linspace(1);
+    graph.getVariableSpace()->putVariable(-1, x);
+
+    nd4j::ops::sigmoid sigmoid;
+    nd4j::ops::tanh tanh;
+
+    graph.addNode(new Node(&sigmoid, 1, {-1}));
+    graph.addNode(new Node(&tanh, 2, {1}));
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto variableSpace = graph.getVariableSpace();
+    ASSERT_NE(0, variableSpace->shapeClass());
+    ASSERT_EQ(1, graph.nodeById(1)->getContextPrototype()->knownOutputs());
+    ASSERT_EQ(variableSpace->shapeClass(), graph.nodeById(2)->getContextPrototype()->shapeClass());
+
+    // same shapes, nothing to infer again
+    ASSERT_EQ(0, graph.inferShapes());
+
+    auto exp = x->transform(transform::Sigmoid);
+    exp.applyTransform(transform::Tanh);
+
+    auto z = variableSpace->getVariable(2)->getNDArray();
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    // new shape of the input leads to new shape class, and outputs get reallocated
+    auto y = NDArrayFactory::create_<float>('c', {3, 4});
+    y->linspace(1);
+    variableSpace->getVariable(-1)->setNDArray(y);
+    delete x;
+
+    auto shapeClass = variableSpace->shapeClass();
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+    ASSERT_NE(shapeClass, variableSpace->shapeClass());
+
+    auto exp2 = y->transform(transform::Sigmoid);
+    exp2.applyTransform(transform::Tanh);
+
+    z = variableSpace->getVariable(2)->getNDArray();
+    ASSERT_TRUE(exp2.isSameShape(z));
+    ASSERT_TRUE(exp2.equalsTo(z));
+}
+
+TEST_F(GraphTests, Test_Infer_Shapes_2) {
+    Graph graph;
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 3});
+    auto shape = NDArrayFactory::create_<int>('c', {2}, {3, 2});
+    x->linspace(1);
+    graph.getVariableSpace()->putVariable(-1, x);
+    graph.getVariableSpace()->putVariable(-2, shape);
+
+    nd4j::ops::reshape reshape;
+    nd4j::ops::tanh tanh;
+
+    graph.addNode(new Node(&reshape, 1, {-1, -2}));
+    graph.addNode(new Node(&tanh, 2, {1}));
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+    auto variableSpace = graph.getVariableSpace();
+    auto z = variableSpace->getVariable(2)->getNDArray();
+    ASSERT_EQ(std::vector<Nd4jLong>({3, 2}), z->getShapeAsVector());
+
+    // shape argument isn't a placeholder, but it still can be overwritten, so its values are part of shape class
+    auto shapeClass = variableSpace->shapeClass();
+    shape->p(0, 6);
+    shape->p(1, 1);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+    ASSERT_NE(shapeClass, variableSpace->shapeClass());
+
+    auto exp = x->reshape('c', {6, 1});
+    exp->applyTransform(transform::Tanh);
+
+    z = variableSpace->getVariable(2)->getNDArray();
+    ASSERT_TRUE(exp->isSameShape(z));
+    ASSERT_TRUE(exp->equalsTo(z));
+
+    delete exp;
+}
@@ -0,0 +1,202 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Tests for k nearest neighbours search ops
+//
+
+#include "testlayers.h"
+#include <NDArray.h>
+#include <NDArrayFactory.h>
+#include <NativeOps.h>
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/knn.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace nd4j;
+
+class KnnTests : public testing::Test {
+public:
+
+    static NDArray points(Nd4jLong rows, Nd4jLong cols, Nd4jLong seed) {
+        auto x = NDArrayFactory::create<float>('c', {rows, cols});
+        auto buffer = reinterpret_cast<float*>(x.buffer());
+        for (Nd4jLong e = 0; e < x.lengthOf(); e++)
+            buffer[e] = static_cast<float>(((e + seed) * 7919) % 10007) / 10007.f - 0.5f;
+
+        return x;
+    }
+
+    // sorted (distance, index) pairs of all data rows for given query row
+    static std::vector<std::pair<double, Nd4jLong>> naive(NDArray& data, NDArray& queries, Nd4jLong q, int metric) {
+        std::vector<std::pair<double, Nd4jLong>> result;
+        for (Nd4jLong n = 0; n < data.sizeAt(0); n++) {
+            double dot = 0., normX = 0., normY = 0., l1 = 0., l2 = 0.;
+            for (Nd4jLong e = 0; e < data.sizeAt(1); e++) {
+                const double x = queries.e<double>(q, e);
+                const double y = data.e<double>(n, e);
+                dot += x * y;
+                normX += x * x;
+                normY += y * y;
+                l1 += std::abs(x - y);
+                l2 += (x - y) * (x - y);
+            }
+            const double dist = metric == 0 ? l1 : metric == 1 ? std::sqrt(l2) : 1. - dot / std::sqrt(normX * normY);
+            result.push_back(std::make_pair(dist, n));
+        }
+        std::sort(result.begin(), result.end());
+
+        return result;
+    }
+};
+
+TEST_F(KnnTests, Brute_Force_1) {
+    auto data = points(300, 8, 1);
+    auto queries = points(20, 8, 12345);
+    const int k = 5;
+
+    nd4j::ops::knn_search op;
+    for (int metric : {0, 1, 5}) {
+        auto result = op.execute({&data, &queries}, {}, {k, metric});
+        ASSERT_EQ(Status::OK(), result->status());
+
+        auto indices = result->at(0);
+        auto distances = result->at(1);
+        ASSERT_EQ(nd4j::DataType::INT64, indices->dataType());
+        ASSERT_TRUE(indices->isSameShape({20, k}));
+
+        for (Nd4jLong q = 0; q < 20; q++) {
+            auto exp = naive(data, queries, q, metric);
+            for (int j = 0; j < k; j++) {
+                ASSERT_EQ(exp[j].second, indices->e<Nd4jLong>(q, j));
+                ASSERT_NEAR(exp[j].first, distances->e<double>(q, j), 1e-4);
+            }
+        }
+
+        delete result;
+    }
+}
+
+TEST_F(KnnTests, VPTree_Exact_1) {
+    auto data = points(2000, 6, 3);
+    auto queries = points(50, 6, 777);
+    const int k = 7;
+
+    nd4j::ops::knn_search bruteForce;
+    nd4j::ops::vptree_build build;
+    nd4j::ops::vptree_search search;
+
+    for (int metric : {0, 1}) {
+        auto exp = bruteForce.execute({&data, &queries}, {}, {k, metric});
+        auto tree = build.execute({&data}, {}, {metric});
+        ASSERT_EQ(Status::OK(), tree->status());
+
+        auto result = search.execute({&data, tree->at(0), tree->at(1), &queries}, {}, {k, metric});
+        ASSERT_EQ(Status::OK(), result->status());
+
+        ASSERT_TRUE(exp->at(0)->equalsTo(result->at(0)));
+        ASSERT_TRUE(exp->at(1)->equalsTo(result->at(1), 1e-5));
+
+        delete exp;
+        delete tree;
+        delete result;
+    }
+}
+
+TEST_F(KnnTests, VPTree_Approximate_1) {
+    auto data = points(4000, 8, 5);
+    auto queries = points(100, 8, 31337);
+    const int k = 10;
+
+    nd4j::ops::vptree_build build;
+    nd4j::ops::vptree_search search;
+
+    auto tree = build.execute({&data}, {}, {1});
+    auto exact = search.execute({&data, tree->at(0), tree->at(1), &queries}, {}, {k, 1, 0});
+    auto approx = search.execute({&data, tree->at(0), tree->at(1), &queries}, {}, {k, 1, 1000});
+    ASSERT_EQ(Status::OK(), approx->status());
+
+    Nd4jLong hits = 0;
+    for (Nd4jLong q = 0; q < 100; q++) {
+        for (int j = 0; j < k; j++) {
+            // j-th approximate neighbour can't be closer than j-th exact one
+            ASSERT_TRUE(approx->at(1)->e<float>(q, j) >= exact->at(1)->e<float>(q, j) - 1e-6f);
+
+            for (int i = 0; i < k; i++)
+                if (approx->at(0)->e<Nd4jLong>(q, j) == exact->at(0)->e<Nd4jLong>(q, i))
+                    hits++;
+        }
+    }
+
+    ASSERT_TRUE(hits >= 100 * k / 2);
+
+    delete tree;
+    delete exact;
+    delete approx;
+}
+
+TEST_F(KnnTests, VPTree_File_1) {
+    auto data = points(500, 4, 9);
+    auto queries = points(10, 4, 99);
+    const int k = 3;
+    const char* fileName = "vptree_file_1.bin";
+
+    nd4j::ops::vptree_build build;
+    nd4j::ops::vptree_search search;
+
+    auto tree = build.execute({&data}, {}, {0});
+    auto exp = search.execute({&data, tree->at(0), tree->at(1), &queries}, {}, {k, 0});
+
+    helpers::vpTreeWrite(fileName, data, *tree->at(0), *tree->at(1), 0);
+
+    NativeOps nativeOps;
+    Nd4jLong header[8];
+    FILE* file = fopen(fileName, "rb");
+    ASSERT_TRUE(file != nullptr);
+    ASSERT_EQ(8, fread(header, sizeof(Nd4jLong), 8, file));
+    fclose(file);
+
+    auto layout = helpers::vpTreeFileLayout(header);
+    ASSERT_EQ(500, layout.numPoints);
+    ASSERT_EQ(4, layout.dims);
+    ASSERT_EQ(0, layout.metric);
+    ASSERT_EQ(nd4j::DataType::FLOAT32, layout.dataType);
+    ASSERT_EQ(0, layout.nodesOffset % 64);
+    ASSERT_EQ(0, layout.radiiOffset % 64);
+
+    auto map = nativeOps.mmapFile(nullptr, fileName, layout.fileLength);
+    ASSERT_FALSE(map == nullptr);
+    auto bytes = reinterpret_cast<int8_t*>(map[0]);
+
+    NDArray mappedData(bytes + layout.dataOffset, 'c', {layout.numPoints, layout.dims}, layout.dataType);
+    NDArray mappedNodes(bytes + layout.nodesOffset, 'c', {layout.numPoints, 3}, nd4j::DataType::INT64);
+    NDArray mappedRadii(bytes + layout.radiiOffset, 'c', {layout.numPoints}, layout.dataType);
+
+    auto result = search.execute({&mappedData, &mappedNodes, &mappedRadii, &queries}, {}, {k, layout.metric});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_TRUE(exp->at(0)->equalsTo(result->at(0)));
+    ASSERT_TRUE(exp->at(1)->equalsTo(result->at(1)));
+
+    delete result;
+    nativeOps.munmapFile(nullptr, map, layout.fileLength);
+    remove(fileName);
+
+    delete tree;
+    delete exp;
+}
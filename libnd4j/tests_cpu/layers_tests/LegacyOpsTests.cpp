@@ -595,6 +595,33 @@ TEST_F(LegacyOpsTests, test_Reduce3_All_1) {
                        tadPackY.primaryShapeInfo(), tadPackY.primaryOffsets());
 }
 
+TEST_F(LegacyOpsTests, test_Reduce3_All_2) {
+    // large enough for blocked kernels, y is f-ordered so its TADs are packed
+    auto x = NDArrayFactory::create<float>('c', {64, 40});
+    auto y = NDArrayFactory::create<float>('f', {32, 40});
+    for (Nd4jLong e = 0; e < x.lengthOf(); e++)
+        x.p(e, static_cast<float>(e % 7) * 0.5f);
+    for (Nd4jLong e = 0; e < y.lengthOf(); e++)
+        y.p(e, static_cast<float>(e % 5) * 0.5f);
+
+    std::vector<int> dims({1});
+    auto tadPackX = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(x.shapeInfo(), dims);
+    auto tadPackY = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(y.shapeInfo(), dims);
+
+    for (int opNum : {reduce3::ManhattanDistance, reduce3::EuclideanDistance, reduce3::CosineSimilarity, reduce3::Dot, reduce3::CosineDistance, reduce3::JaccardDistance, reduce3::SimpleHammingDistance}) {
+        auto z = NDArrayFactory::create<float>('c', {64, 32});
+        auto exp = NDArrayFactory::create<float>('c', {64, 32});
+
+        NativeOpExcutioner::execReduce3All(opNum, x.buffer(), x.shapeInfo(), nullptr, y.buffer(), y.shapeInfo(), z.buffer(), z.shapeInfo(), dims.data(), dims.size(),
+                                           tadPackX.primaryShapeInfo(), tadPackX.primaryOffsets(), tadPackY.primaryShapeInfo(), tadPackY.primaryOffsets());
+
+        functions::reduce3::Reduce3<float, float>::execAllLoops(opNum, x.buffer(), x.shapeInfo(), nullptr, y.buffer(), y.shapeInfo(), exp.buffer(), exp.shapeInfo(), dims.data(), dims.size(),
+                                           tadPackX.primaryShapeInfo(), tadPackX.primaryOffsets(), tadPackY.primaryShapeInfo(), tadPackY.primaryOffsets());
+
+        ASSERT_TRUE(exp.equalsTo(z, 1e-4));
+    }
+}
+
 TEST_F(LegacyOpsTests, Softmax_119_1) {
     auto x = NDArrayFactory::create<float>('c', {10, 10});
     x.linspace(1.0);
@@ -0,0 +1,266 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Tests for dense linear algebra ops: determinant, inverse, cholesky and triangular_solve
+//
+
+#include "testlayers.h"
+#include <NDArray.h>
+#include <NDArrayFactory.h>
+#include <ops/declarable/CustomOperations.h>
+#include <cmath>
+
+using namespace nd4j;
+
+class LinearAlgebraTests : public testing::Test {
+public:
+
+    // diagonally dominant, hence well conditioned, matrices [batch, n, n]
+    static NDArray regular(Nd4jLong batch, Nd4jLong n, Nd4jLong seed) {
+        auto x = NDArrayFactory::create<double>('c', {batch, n, n});
+        auto buffer = x.bufferAsT<double>();
+        for (Nd4jLong e = 0; e < x.lengthOf(); e++) {
+            const Nd4jLong i = (e / n) % n;
+            const Nd4jLong j = e % n;
+            buffer[e] = static_cast<double>(((e + seed) * 7919) % 10007) / 10007. - 0.5 + (i == j ? static_cast<double>(n) : 0.);
+        }
+
+        return x;
+    }
+
+    // symmetric positive definite matrix [n, n]: B * B^T + n * I
+    static NDArray spd(Nd4jLong n, Nd4jLong seed) {
+        auto b = regular(1, n, seed);
+        auto x = NDArrayFactory::create<double>('c', {n, n});
+        auto bb = b.bufferAsT<double>();
+        auto xb = x.bufferAsT<double>();
+        for (Nd4jLong i = 0; i < n; i++)
+            for (Nd4jLong j = 0; j < n; j++) {
+                double sum = i == j ? static_cast<double>(n) : 0.;
+                for (Nd4jLong k = 0; k < n; k++)
+                    sum += bb[i * n + k] * bb[j * n + k];
+                xb[i * n + j] = sum;
+            }
+
+        return x;
+    }
+
+    // max |A * B - C| over batch of c-ordered matrices
+    static double residual(NDArray& a, NDArray& b, NDArray& c, bool transposeB = false) {
+        const Nd4jLong m = a.sizeAt(-2), k = a.sizeAt(-1), n = c.sizeAt(-1);
+        const Nd4jLong batch = c.lengthOf() / (m * n);
+        auto ab = a.bufferAsT<double>(), bb = b.bufferAsT<double>(), cb = c.bufferAsT<double>();
+        double result = 0.;
+        for (Nd4jLong e = 0; e < batch; e++)
+            for (Nd4jLong i = 0; i < m; i++)
+                for (Nd4jLong j = 0; j < n; j++) {
+                    double sum = 0.;
+                    for (Nd4jLong p = 0; p < k; p++)
+                        sum += ab[e * m * k + i * k + p] * (transposeB ? bb[e * n * k + j * k + p] : bb[e * k * n + p * n + j]);
+                    result = nd4j::math::nd4j_max<double>(result, std::abs(sum - cb[e * m * n + i * n + j]));
+                }
+
+        return result;
+    }
+
+    static NDArray identity(Nd4jLong batch, Nd4jLong n) {
+        auto x = NDArrayFactory::create<double>('c', {batch, n, n});
+        x.assign(0.);
+        for (Nd4jLong e = 0; e < batch; e++)
+            for (Nd4jLong i = 0; i < n; i++)
+                x.p(e * n * n + i * n + i, 1.);
+
+        return x;
+    }
+};
+
+TEST_F(LinearAlgebraTests, Determinant_Batch_1) {
+    auto x = NDArrayFactory::create<double>('c', {3, 3, 3}, {2., 1., 0.,  1., 3., 1.,  0., 1., 4.,
+                                                              0., 1., 0.,  1., 0., 0.,  0., 0., 5.,
+                                                              1., 2., 3.,  2., 4., 6.,  0., 0., 1.});
+    auto exp = NDArrayFactory::create<double>('c', {3}, {18., -5., 0.});
+
+    nd4j::ops::matrix_determinant op;
+    auto result = op.execute({&x}, {}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    delete result;
+}
+
+TEST_F(LinearAlgebraTests, Determinant_Orders_1) {
+    // triangular matrices of orders 1..12 cover both small kernels and blocked LU, determinant is product of diagonal
+    for (Nd4jLong n = 1; n <= 12; n++) {
+        auto x = NDArrayFactory::create<double>('c', {2, n, n});
+        x.assign(0.);
+        double det = 1.;
+        for (Nd4jLong i = 0; i < n; i++) {
+            for (Nd4jLong j = 0; j <= i; j++)
+                x.p(i * n + j, i == j ? 1. + 0.25 * i : 0.5);
+            det *= 1. + 0.25 * i;
+        }
+        for (Nd4jLong e = 0; e < n * n; e++)
+            x.p(n * n + e, x.e<double>(e));
+
+        // swapping two rows of the second matrix flips sign
+        if (n > 1)
+            for (Nd4jLong j = 0; j < n; j++) {
+                auto t = x.e<double>(n * n + j);
+                x.p(n * n + j, x.e<double>(n * n + n + j));
+                x.p(n * n + n + j, t);
+            }
+
+        nd4j::ops::matrix_determinant op;
+        auto result = op.execute({&x}, {}, {});
+        ASSERT_EQ(Status::OK(), result->status());
+        ASSERT_NEAR(det, result->at(0)->e<double>(0), 1e-9 * det);
+        ASSERT_NEAR(n > 1 ? -det : det, result->at(0)->e<double>(1), 1e-9 * det);
+
+        delete result;
+    }
+}
+
+TEST_F(LinearAlgebraTests, Log_Determinant_Large_1) {
+    // determinant itself is 10^200, out of float range, while its logarithm is not
+    const Nd4jLong n = 200;
+    auto x = NDArrayFactory::create<float>('c', {n, n});
+    x.assign(0.f);
+    for (Nd4jLong i = 0; i < n; i++) {
+        x.p(i * n + i, 10.f);
+        if (i > 0)
+            x.p(i * n + i - 1, 3.f);
+    }
+
+    nd4j::ops::log_matrix_determinant op;
+    auto result = op.execute({&x}, {}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_NEAR(200. * std::log(10.), result->at(0)->e<double>(0), 1e-2);
+
+    delete result;
+}
+
+TEST_F(LinearAlgebraTests, Inverse_Batch_1) {
+    for (Nd4jLong n : {2, 3, 5, 8, 9, 40}) {
+        auto x = regular(16, n, n);
+        auto eye = identity(16, n);
+
+        nd4j::ops::matrix_inverse op;
+        auto result = op.execute({&x}, {}, {});
+        ASSERT_EQ(Status::OK(), result->status());
+        ASSERT_NEAR(0., residual(x, *result->at(0), eye), 1e-10);
+
+        delete result;
+    }
+}
+
+TEST_F(LinearAlgebraTests, Inverse_Large_1) {
+    auto x = regular(1, 150, 7);
+    auto eye = identity(1, 150);
+
+    nd4j::ops::matrix_inverse op;
+    auto result = op.execute({&x}, {}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_NEAR(0., residual(x, *result->at(0), eye), 1e-10);
+
+    delete result;
+}
+
+TEST_F(LinearAlgebraTests, Inverse_Singular_1) {
+    auto x = NDArrayFactory::create<double>('c', {2, 2, 2}, {1., 2., 3., 4.,  1., 2., 2., 4.});
+
+    nd4j::ops::matrix_inverse op;
+    auto result = op.execute({&x}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_VALIDATION, result->status());
+
+    delete result;
+}
+
+TEST_F(LinearAlgebraTests, Cholesky_Large_1) {
+    const Nd4jLong n = 130;
+    auto x = spd(n, 3);
+
+    nd4j::ops::cholesky op;
+    auto result = op.execute({&x}, {}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    auto l = result->at(0);
+    for (Nd4jLong i = 0; i < n; i++)
+        for (Nd4jLong j = i + 1; j < n; j++)
+            ASSERT_EQ(0., l->e<double>(i, j));
+
+    ASSERT_NEAR(0., residual(*l, *l, x, true), 1e-8);
+
+    delete result;
+}
+
+TEST_F(LinearAlgebraTests, Logdet_1) {
+    auto x = NDArrayFactory::create<double>('c', {2, 3, 3}, {4., 2., 0.,  2., 3., 1.,  0., 1., 2.,
+                                                              1., 0., 0.,  0., 2., 0.,  0., 0., 3.});
+    auto exp = NDArrayFactory::create<double>('c', {2}, {std::log(12.), std::log(6.)});
+
+    nd4j::ops::logdet op;
+    auto result = op.execute({&x}, {}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    delete result;
+}
+
+TEST_F(LinearAlgebraTests, Triangular_Solve_1) {
+    auto a = NDArrayFactory::create<float>('c', {3, 3}, {2.f, 0.f, 0.f,  1.f, 4.f, 0.f,  3.f, 2.f, 1.f});
+    auto b = NDArrayFactory::create<float>('c', {3, 2}, {2.f, 4.f,  5.f, 6.f,  6.f, 9.f});
+    // lower: x = [1, 2], [1, 1], [1, 1]
+    auto expLower = NDArrayFactory::create<float>('c', {3, 2}, {1.f, 2.f,  1.f, 1.f,  1.f, 1.f});
+    // adjoint: A^T is upper, x3 = b3, x2 = (b2 - 2 x3) / 4, x1 = (b1 - x2 - 3 x3) / 2
+    auto expAdjoint = NDArrayFactory::create<float>('c', {3, 2}, {-7.125f, -10.f,  -1.75f, -3.f,  6.f, 9.f});
+
+    nd4j::ops::triangular_solve op;
+    auto result = op.execute({&a, &b}, {}, {}, {true, false});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_TRUE(expLower.equalsTo(result->at(0)));
+    delete result;
+
+    result = op.execute({&a, &b}, {}, {}, {true, true});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_TRUE(expAdjoint.equalsTo(result->at(0)));
+    delete result;
+}
+
+TEST_F(LinearAlgebraTests, Triangular_Solve_Batch_1) {
+    // upper triangle of regular matrices, lower one is garbage which must be ignored
+    const Nd4jLong n = 100, k = 7;
+    auto a = regular(3, n, 11);
+    auto b = regular(3, n, 5)({0,0, 0,0, 0,k}, true);
+    auto bc = b.dup('c');
+
+    nd4j::ops::triangular_solve op;
+    auto result = op.execute({&a, bc}, {}, {}, {false});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    auto upper = a.dup('c');
+    for (Nd4jLong e = 0; e < 3; e++)
+        for (Nd4jLong i = 0; i < n; i++)
+            for (Nd4jLong j = 0; j < i; j++)
+                upper->p(e * n * n + i * n + j, 0.);
+
+    ASSERT_NEAR(0., residual(*upper, *result->at(0), *bc), 1e-10);
+
+    delete upper;
+    delete bc;
+    delete result;
+}
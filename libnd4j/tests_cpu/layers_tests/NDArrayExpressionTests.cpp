@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include "testlayers.h"
+#include <NDArray.h>
+#include <array/NDArrayExpression.h>
+
+using namespace nd4j;
+using namespace nd4j::expr;
+
+class NDArrayExpressionTests : public testing::Test {
+public:
+
+};
+
+TEST_F(NDArrayExpressionTests, Test_Broadcast_Sum_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4});
+    auto y = NDArrayFactory::create<float>('c', {3, 4});
+    auto b = NDArrayFactory::create<float>('c', {4}, {1.f, 2.f, 3.f, 4.f});
+    auto z = NDArrayFactory::create<float>('c', {3, 4});
+    x.linspace(1);
+    y.linspace(0.5, 0.5);
+
+    auto exp = x + y + b;
+
+    expr::assign(z, lazy(x) + y + b);
+
+    ASSERT_TRUE(exp.equalsTo(z));
+}
+
+TEST_F(NDArrayExpressionTests, Test_Activations_1) {
+    auto x = NDArrayFactory::create<double>('c', {2, 5});
+    auto y = NDArrayFactory::create<double>('c', {2, 5});
+    auto z = NDArrayFactory::create<double>('c', {2, 5});
+    x.linspace(-1, 0.2);
+    y.linspace(2, -0.3);
+
+    auto exp = (x + 0.5).transform(transform::Sigmoid) * y + (1. - x * x).transform(transform::Tanh);
+
+    expr::assign(z, sigmoid(lazy(x) + 0.5) * y + tanh(1. - lazy(x) * x));
+
+    ASSERT_TRUE(exp.equalsTo(z));
+}
+
+TEST_F(NDArrayExpressionTests, Test_View_Target_1) {
+    auto x = NDArrayFactory::create<float>('c', {4, 6});
+    auto y = NDArrayFactory::create<float>('f', {4, 3});
+    x.linspace(1);
+    y.linspace(1);
+
+    auto exp = NDArrayFactory::create<float>('c', {4, 6});
+    exp.linspace(1);
+    auto expView = exp({0,0, 3,6});
+    expView.assign(expView * y - 2.f);
+
+    auto view = x({0,0, 3,6});
+    expr::assign(view, lazy(view) * y - 2.f);
+
+    ASSERT_TRUE(exp.equalsTo(x));
+}
+
+TEST_F(NDArrayExpressionTests, Test_Evaluate_1) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    auto y = NDArrayFactory::create<double>('c', {1, 3}, {1., 0., -1.});
+    auto exp = NDArrayFactory::create<float>('c', {2, 3}, {0.f, 1.f, 6.f, -6.f, 2.5f, 21.f});
+
+    auto z = expr::evaluate(-(lazy(x) * x / 2.f) * y + lazy(x) / 2, {2, 3}, nd4j::DataType::FLOAT32);
+
+    ASSERT_TRUE(exp.equalsTo(z));
+}
+
+TEST_F(NDArrayExpressionTests, Test_Bad_Shape_1) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3});
+    auto y = NDArrayFactory::create<float>('c', {2, 2});
+    auto z = NDArrayFactory::create<float>('c', {2, 3});
+
+    ASSERT_ANY_THROW(expr::assign(z, lazy(x) + y));
+}
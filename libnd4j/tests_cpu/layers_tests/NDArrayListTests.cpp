@@ -70,4 +70,119 @@ TEST_F(NDArrayListTests, Test_Stack_UnStack_1) {
     ASSERT_TRUE(input.equalsTo(array));
 
     delete array;
-}
\ No newline at end of file
+}
+
+TEST_F(NDArrayListTests, Test_Contiguous_Write_Stack_1) {
+    NDArrayList list(5);
+
+    auto exp = NDArrayFactory::create<float>('c', {5, 3});
+    exp.linspace(1);
+
+    for (int e = 4; e >= 0; e--) {
+        auto row = NDArrayFactory::create<float>('c', {3});
+        row.linspace(e * 3 + 1);
+        ASSERT_EQ(ND4J_STATUS_OK, list.assign(e, row));
+    }
+
+    ASSERT_TRUE(list.isContiguous());
+    ASSERT_EQ(5, list.elements());
+
+    auto array = list.stack();
+
+    ASSERT_TRUE(exp.isSameShape(array));
+    ASSERT_TRUE(exp.equalsTo(array));
+
+    // stacked array owns its own copy of list storage
+    ASSERT_NE(list.readRaw(0)->getBuffer(), array->getBuffer());
+
+    delete array;
+}
+
+TEST_F(NDArrayListTests, Test_Contiguous_Ragged_Fallback_1) {
+    NDArrayList list(3);
+
+    auto x = NDArrayFactory::create<float>('c', {2, 4});
+    auto y = NDArrayFactory::create<float>('c', {3, 4});
+    x.assign(1.f);
+    y.assign(2.f);
+
+    ASSERT_EQ(ND4J_STATUS_OK, list.assign(0, x));
+    ASSERT_TRUE(list.isContiguous());
+
+    ASSERT_EQ(ND4J_STATUS_OK, list.assign(1, y));
+    ASSERT_FALSE(list.isContiguous());
+
+    ASSERT_TRUE(x.equalsTo(list.readRaw(0)));
+    ASSERT_TRUE(y.equalsTo(list.readRaw(1)));
+}
+
+TEST_F(NDArrayListTests, Test_Contiguous_UnStack_1) {
+    auto input = NDArrayFactory::create<float>('c', {3, 4, 5});
+    input.linspace(1);
+
+    NDArrayList list(0, true);
+
+    list.unstack(&input, 1);
+
+    ASSERT_TRUE(list.isContiguous());
+    ASSERT_EQ(4, list.elements());
+
+    for (int e = 0; e < 4; e++) {
+        auto exp = input({0,0, e,e+1, 0,0});
+        ASSERT_TRUE(exp.equalsTo(list.readRaw(e)));
+    }
+}
+
+TEST_F(NDArrayListTests, Test_Contiguous_Write_After_Stack_1) {
+    NDArrayList list(3);
+
+    auto exp = NDArrayFactory::create<float>('c', {3, 4});
+    exp.linspace(1);
+
+    for (int e = 0; e < 3; e++) {
+        auto row = NDArrayFactory::create<float>('c', {4});
+        row.linspace(e * 4 + 1);
+        ASSERT_EQ(ND4J_STATUS_OK, list.assign(e, row));
+    }
+
+    auto array = list.stack();
+
+    // overwriting list rows must not change previously stacked result
+    auto row = NDArrayFactory::create<float>('c', {4});
+    row.assign(-1.f);
+    ASSERT_EQ(ND4J_STATUS_OK, list.assign(1, row));
+    ASSERT_TRUE(list.isContiguous());
+    ASSERT_TRUE(row.equalsTo(list.readRaw(1)));
+
+    ASSERT_TRUE(exp.isSameShape(array));
+    ASSERT_TRUE(exp.equalsTo(array));
+
+    delete array;
+}
+
+TEST_F(NDArrayListTests, Test_Contiguous_Write_Then_Use_1) {
+    NDArrayList list(4);
+
+    auto exp = NDArrayFactory::create<double>('c', {4, 8});
+    for (int e = 0; e < 4; e++) {
+        auto row = NDArrayFactory::create_<double>('c', {8});
+        row->assign((double) e);
+        ASSERT_EQ(ND4J_STATUS_OK, list.write(e, row));
+
+        // list owns the row now, but it stays valid while list is alive
+        ASSERT_TRUE(list.isContiguous());
+        ASSERT_TRUE(row->equalsTo(list.readRaw(e)));
+        exp({e,e+1, 0,0}).assign(row);
+    }
+
+    // overwriting a slot releases previously adopted array only
+    auto row = NDArrayFactory::create_<double>('c', {8});
+    row->assign(3.0);
+    ASSERT_EQ(ND4J_STATUS_OK, list.write(3, row));
+    ASSERT_TRUE(row->equalsTo(list.readRaw(3)));
+
+    auto array = list.stack();
+    ASSERT_TRUE(exp.equalsTo(array));
+
+    delete array;
+}
@@ -1308,3 +1308,59 @@ TEST_F(NDArrayTest2, all_tads_1) {
 
     delete arrays;
 }
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest2, permuted_assign_1) {
+    auto x = NDArrayFactory::create<float>('c', {4, 40, 36});
+    x.linspace(1);
+
+    auto p = x.permute({2, 0, 1});
+    auto z = p->dup('c');
+
+    for (int i = 0; i < 36; i++)
+        for (int j = 0; j < 4; j++)
+            for (int k = 0; k < 40; k++)
+                ASSERT_EQ(x.e<float>(j, k, i), z->e<float>(i, j, k));
+
+    delete p;
+    delete z;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest2, permuted_assign_2) {
+    auto x = NDArrayFactory::create<double>('c', {2, 3, 4, 5, 6, 7});
+    x.linspace(1);
+
+    auto p = x.permute({3, 0, 5, 1, 4, 2});
+    auto zC = NDArrayFactory::create<double>('c', {5, 2, 7, 3, 6, 4});
+    auto zF = NDArrayFactory::create<double>('f', {5, 2, 7, 3, 6, 4});
+    zC.assign(p);
+    zF.assign(p);
+
+    for (Nd4jLong e = 0; e < x.lengthOf(); e++) {
+        ASSERT_EQ(p->e<double>(e), zC.e<double>(e));
+        ASSERT_EQ(p->e<double>(e), zF.e<double>(e));
+    }
+
+    delete p;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest2, permuted_assign_3) {
+    auto x = NDArrayFactory::create<float>('c', {6, 5});
+    x.linspace(1);
+
+    // shapes differ, so elements are matched by c-order indices
+    auto p = x.transpose();
+    auto zVec = NDArrayFactory::create<float>('c', {30});
+    auto zMat = NDArrayFactory::create<float>('f', {3, 10});
+    zVec.assign(p);
+    zMat.assign(p);
+
+    for (Nd4jLong e = 0; e < x.lengthOf(); e++) {
+        ASSERT_EQ(p->e<float>(e), zVec.e<float>(e));
+        ASSERT_EQ(p->e<float>(e), zMat.e<float>(e));
+    }
+
+    delete p;
+}
@@ -475,4 +475,135 @@ TEST_F(NlpTests, test_cbow_hs_batch_1) {
     ASSERT_EQ(exp2, row_s1_6);
 
     delete result;
-}
\ No newline at end of file
+}
+TEST_F(NlpTests, test_w2v_batch_subwords_1) {
+    // single example: word 2 and its n-grams 15 and 17, n-gram 15 is locked
+    auto inputs = NDArrayFactory::create<int>('c', {1, 3}, {2, 15, 17});
+    auto locked = NDArrayFactory::create<int>('c', {1, 3}, {0, 1, 0});
+    auto positives = NDArrayFactory::empty<int>();
+    auto indices = NDArrayFactory::create<int>('c', {1, 1}, {1});
+    auto codes = NDArrayFactory::create<int8_t>('c', {1, 1}, {0});
+    auto syn0 = NDArrayFactory::create<float>('c', {20, 10});
+    auto syn1 = NDArrayFactory::create<float>('c', {20, 10});
+    auto syn1Neg = NDArrayFactory::empty<float>();
+    auto expTable = NDArrayFactory::create<float>('c', {10000});
+    auto negTable = NDArrayFactory::empty<float>();
+    auto alpha = NDArrayFactory::create<double>('c', {1}, {0.025});
+    auto randomValue = NDArrayFactory::create<Nd4jLong>('c', {1}, {1L});
+
+    syn0.assign(0.01);
+    syn1.assign(0.02);
+    expTable.assign(0.5);
+
+    // g = (1 - code - 0.5) * alpha = 0.0125, hidden is mean of input rows
+    auto expSyn0 = NDArrayFactory::create<float>('c', {1, 10});
+    auto expSyn1 = NDArrayFactory::create<float>('c', {1, 10});
+    expSyn0.assign(0.01025f);
+    expSyn1.assign(0.020125f);
+
+    nd4j::ops::word2vec_batch op;
+    auto result = op.execute({&inputs, &locked, &positives, &indices, &codes, &syn0, &syn1, &syn1Neg, &expTable, &negTable, &alpha, &randomValue}, {}, {1, 0}, {}, true);
+    ASSERT_EQ(Status::OK(), result->status());
+
+    ASSERT_TRUE(expSyn0.equalsTo(syn0({2,3, 0,0}, true), 1e-6));
+    ASSERT_TRUE(expSyn0.equalsTo(syn0({17,18, 0,0}, true), 1e-6));
+    ASSERT_NEAR(0.01f, syn0.e<float>(15, 0), 1e-7);
+    ASSERT_NEAR(0.01f, syn0.e<float>(0, 0), 1e-7);
+    ASSERT_TRUE(expSyn1.equalsTo(syn1({1,2, 0,0}, true), 1e-6));
+
+    delete result;
+}
+
+TEST_F(NlpTests, test_w2v_batch_grouping_1) {
+    // two examples sharing hs path form a single group, so both see original syn1 row
+    auto inputs = NDArrayFactory::create<int>('c', {2}, {0, 5});
+    auto locked = NDArrayFactory::empty<int>();
+    auto positives = NDArrayFactory::empty<int>();
+    auto indices = NDArrayFactory::create<int>('c', {2, 1}, {1, 1});
+    auto codes = NDArrayFactory::create<int8_t>('c', {2, 1}, {0, 0});
+    auto syn1Neg = NDArrayFactory::empty<float>();
+    auto expTable = NDArrayFactory::create<float>('c', {10000});
+    auto negTable = NDArrayFactory::empty<float>();
+    auto alpha = NDArrayFactory::create<double>('c', {2}, {0.025, 0.025});
+    auto randomValue = NDArrayFactory::create<Nd4jLong>('c', {2}, {1L, 3L});
+
+    expTable.assign(0.5);
+
+    nd4j::ops::word2vec_batch op;
+
+    for (int groupSize: {16, 1}) {
+        auto syn0 = NDArrayFactory::create<float>('c', {20, 10});
+        auto syn1 = NDArrayFactory::create<float>('c', {20, 10});
+        syn0.assign(0.01);
+        syn1.assign(0.02);
+
+        auto result = op.execute({&inputs, &locked, &positives, &indices, &codes, &syn0, &syn1, &syn1Neg, &expTable, &negTable, &alpha, &randomValue}, {}, {1, 0, groupSize}, {}, true);
+        ASSERT_EQ(Status::OK(), result->status());
+        delete result;
+
+        ASSERT_NEAR(0.02025f, syn1.e<float>(1, 0), 1e-7);
+        ASSERT_NEAR(0.01025f, syn0.e<float>(0, 0), 1e-7);
+
+        // without grouping second example sees syn1 row updated by the first one
+        ASSERT_NEAR(groupSize == 1 ? 0.01f + 0.0125f * 0.020125f : 0.01025f, syn0.e<float>(5, 0), 1e-7);
+    }
+}
+
+TEST_F(NlpTests, test_w2v_batch_ns_vs_skipgram_1) {
+    const int batchSize = 8;
+    const int numWords = 100;
+    const int vectorLength = 10;
+    const int expLength = 1000;
+    const int nsRounds = 3;
+
+    // every example has its own positive word, so groups are single examples and results match skipgram
+    auto target = NDArrayFactory::create<int>('c', {batchSize});
+    auto ngStarter = NDArrayFactory::create<int>('c', {batchSize});
+    auto alpha = NDArrayFactory::create<double>('c', {batchSize});
+    auto randomValue = NDArrayFactory::create<Nd4jLong>('c', {batchSize});
+    auto expTable = NDArrayFactory::create<float>('c', {expLength});
+    auto negTable = NDArrayFactory::create<float>('c', {1000});
+    auto empty = NDArrayFactory::empty<int>();
+    auto emptyCodes = NDArrayFactory::empty<int8_t>();
+    auto syn1 = NDArrayFactory::empty<float>();
+    auto inferenceVector = NDArrayFactory::empty<float>();
+
+    for (int e = 0; e < expLength; e++) {
+        double v = exp((e / (double) expLength * 2 - 1) * 6.0);
+        expTable.p(e, v / (v + 1));
+    }
+
+    for (int e = 0; e < negTable.lengthOf(); e++)
+        negTable.p(e, (e * 7) % numWords);
+
+    for (int e = 0; e < batchSize; e++) {
+        target.p(e, e * 3);
+        ngStarter.p(e, 50 + e);
+        alpha.p(e, 0.025 - e * 0.001);
+        randomValue.p(e, 119L + e * 31L);
+    }
+
+    auto syn0 = NDArrayFactory::create<float>('c', {numWords, vectorLength});
+    auto syn1Neg = NDArrayFactory::create<float>('c', {numWords, vectorLength});
+    syn0.linspace(-0.05, 0.0001);
+    syn1Neg.linspace(0.05, -0.0001);
+
+    auto syn0Exp = syn0.dup();
+    auto syn1NegExp = syn1Neg.dup();
+
+    nd4j::ops::skipgram sg;
+    auto result = sg.execute({&target, &ngStarter, &empty, &emptyCodes, syn0Exp, &syn1, syn1NegExp, &expTable, &negTable, &alpha, &randomValue, &inferenceVector}, {}, {1, nsRounds}, {false, true}, true);
+    ASSERT_EQ(Status::OK(), result->status());
+    delete result;
+
+    nd4j::ops::word2vec_batch op;
+    result = op.execute({&target, &empty, &ngStarter, &empty, &emptyCodes, &syn0, &syn1, &syn1Neg, &expTable, &negTable, &alpha, &randomValue}, {}, {1, nsRounds}, {}, true);
+    ASSERT_EQ(Status::OK(), result->status());
+    delete result;
+
+    ASSERT_TRUE(syn0Exp->equalsTo(syn0, 1e-5));
+    ASSERT_TRUE(syn1NegExp->equalsTo(syn1Neg, 1e-5));
+
+    delete syn0Exp;
+    delete syn1NegExp;
+}
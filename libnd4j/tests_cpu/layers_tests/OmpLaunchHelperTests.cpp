@@ -21,6 +21,8 @@
 #include "testlayers.h"
 #include <NDArray.h>
 #include <OmpLaunchHelper.h>
+#include <helpers/ThresholdsTuner.h>
+#include <cstdio>
 
 
 using namespace nd4j;
@@ -37,6 +39,7 @@ public:
 
     ~OmpLaunchHelperTests() {
         Environment::getInstance()->setElementwiseThreshold(this->ewt);
+        ThresholdsTuner::getInstance()->reset();
     }
 };
 
@@ -145,4 +148,58 @@ TEST_F(OmpLaunchHelperTests, test_tad_threads_5) {
     Nd4jLong tadLength = Environment::getInstance()->elementwiseThreshold();
 
     ASSERT_EQ(exp, OmpLaunchHelper::tadThreads(tadLength, numTads));
-}
\ No newline at end of file
+}
+
+TEST_F(OmpLaunchHelperTests, test_tuned_threads_1) {
+    // nothing calibrated: same decisions as Environment thresholds give
+    ThresholdsTuner::getInstance()->reset();
+
+    ASSERT_EQ(OmpLaunchHelper::betterThreads(4000, 6), OmpLaunchHelper::betterThreads(4000, 6, LoopFamily::TRANSFORM_STRICT, nd4j::DataType::FLOAT32));
+    ASSERT_EQ(OmpLaunchHelper::tadThreads(1000, 2), OmpLaunchHelper::tadThreads(1000, 2, LoopFamily::REDUCE, nd4j::DataType::DOUBLE));
+}
+
+TEST_F(OmpLaunchHelperTests, test_tuned_threads_2) {
+    auto tuner = ThresholdsTuner::getInstance();
+    tuner->setEntry(LoopFamily::TRANSFORM_STRICT, nd4j::DataType::FLOAT32, 100, 64);
+    tuner->setEntry(LoopFamily::TRANSFORM, nd4j::DataType::FLOAT32, 100000, 2);
+
+    auto available = omp_get_max_threads();
+
+    // expensive loop gets threads much earlier than elementwise threshold suggests
+    ASSERT_EQ(1, OmpLaunchHelper::betterThreads(400, 6));
+    ASSERT_EQ(nd4j::math::nd4j_min<int>(4, available), OmpLaunchHelper::betterThreads(400, 6, LoopFamily::TRANSFORM_STRICT, nd4j::DataType::FLOAT32));
+
+    // cheap one gets them later, and never more than it scales to
+    ASSERT_EQ(1, OmpLaunchHelper::betterThreads(50000, 6, LoopFamily::TRANSFORM, nd4j::DataType::FLOAT32));
+    ASSERT_EQ(nd4j::math::nd4j_min<int>(2, available), OmpLaunchHelper::betterThreads(10000000, 6, LoopFamily::TRANSFORM, nd4j::DataType::FLOAT32));
+
+    // other data types and generic loops aren't affected
+    ASSERT_EQ(OmpLaunchHelper::betterThreads(400, 6), OmpLaunchHelper::betterThreads(400, 6, LoopFamily::TRANSFORM_STRICT, nd4j::DataType::DOUBLE));
+    ASSERT_EQ(OmpLaunchHelper::betterThreads(400, 6), OmpLaunchHelper::betterThreads(400, 6, LoopFamily::GENERIC, nd4j::DataType::FLOAT32));
+
+    OmpLaunchHelper info(1000, -1, LoopFamily::TRANSFORM_STRICT, nd4j::DataType::FLOAT32);
+    ASSERT_EQ(nd4j::math::nd4j_min<int>(10, available), info._numThreads);
+}
+
+TEST_F(OmpLaunchHelperTests, test_tuned_profile_1) {
+    auto tuner = ThresholdsTuner::getInstance();
+    tuner->setEntry(LoopFamily::PAIRWISE, nd4j::DataType::HALF, 12288, 3);
+    tuner->setEntry(LoopFamily::BROADCAST, nd4j::DataType::INT64, 4096, 5);
+
+    const char* path = "omp_thresholds_profile.tmp";
+    ASSERT_TRUE(tuner->save(path));
+
+    tuner->reset();
+    ASSERT_FALSE(tuner->isCalibrated());
+
+    ASSERT_TRUE(tuner->load(path));
+    std::remove(path);
+
+    ASSERT_TRUE(tuner->isCalibrated());
+    ASSERT_EQ(12288, tuner->elementsPerThread(LoopFamily::PAIRWISE, nd4j::DataType::HALF));
+    ASSERT_EQ(4096, tuner->elementsPerThread(LoopFamily::BROADCAST, nd4j::DataType::INT64));
+    ASSERT_EQ(Environment::getInstance()->elementwiseThreshold(), tuner->elementsPerThread(LoopFamily::PAIRWISE, nd4j::DataType::FLOAT32));
+    ASSERT_EQ(nd4j::math::nd4j_min<int>(5, omp_get_max_threads()), tuner->maxThreads(LoopFamily::BROADCAST, nd4j::DataType::INT64));
+
+    ASSERT_FALSE(tuner->load("this_profile_does_not_exist.tmp"));
+}
@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include "testlayers.h"
+#include <helpers/OpCounters.h>
+#include <ops/declarable/CustomOperations.h>
+#include <NDArrayFactory.h>
+#include <string>
+
+using namespace nd4j;
+
+class OpCountersTests : public testing::Test {
+public:
+
+};
+
+TEST_F(OpCountersTests, Test_Shape_Class_1) {
+    ASSERT_EQ(std::string("FLOAT/2^10"), OpCounters::shapeClass(nd4j::DataType::FLOAT32, 1000));
+    ASSERT_EQ(std::string("FLOAT/2^10"), OpCounters::shapeClass(nd4j::DataType::FLOAT32, 1024));
+    ASSERT_EQ(std::string("DOUBLE/2^0"), OpCounters::shapeClass(nd4j::DataType::DOUBLE, 1));
+}
+
+TEST_F(OpCountersTests, Test_Default_Cost_1) {
+    auto x = NDArrayFactory::create<float>('c', {4, 8});
+    auto z = NDArrayFactory::create<float>('c', {4, 8});
+
+    auto cost = OpCounters::getInstance()->costOf("some_unknown_op", {&x}, {&z}, {});
+
+    ASSERT_NEAR(32.0, cost.flops, 1e-5);
+    ASSERT_NEAR(256.0, cost.bytes, 1e-5);
+}
+
+TEST_F(OpCountersTests, Test_Matmul_Cost_1) {
+    auto x = NDArrayFactory::create<float>('c', {4, 8});
+    auto y = NDArrayFactory::create<float>('c', {8, 16});
+    auto z = NDArrayFactory::create<float>('c', {4, 16});
+
+    auto cost = OpCounters::getInstance()->costOf("matmul", {&x, &y}, {&z}, {});
+
+    ASSERT_NEAR(2.0 * 64 * 8, cost.flops, 1e-5);
+    ASSERT_NEAR((32 + 128 + 64) * 4.0, cost.bytes, 1e-5);
+
+    // transposed x: [8, 4]
+    auto xT = NDArrayFactory::create<float>('c', {8, 4});
+    cost = OpCounters::getInstance()->costOf("matmul", {&xT, &y}, {&z}, {1});
+
+    ASSERT_NEAR(2.0 * 64 * 8, cost.flops, 1e-5);
+}
+
+TEST_F(OpCountersTests, Test_Conv2d_Cost_1) {
+    auto input = NDArrayFactory::create<float>('c', {1, 3, 8, 8});
+    auto weights = NDArrayFactory::create<float>('c', {3, 3, 3, 16});
+    auto output = NDArrayFactory::create<float>('c', {1, 16, 6, 6});
+
+    auto cost = OpCounters::getInstance()->costOf("conv2d", {&input, &weights}, {&output}, {});
+
+    ASSERT_NEAR(2.0 * output.lengthOf() * 27, cost.flops, 1e-5);
+}
+
+TEST_F(OpCountersTests, Test_Collection_1) {
+    auto counters = OpCounters::getInstance();
+    counters->reset();
+    counters->setEnabled(true);
+
+    auto x = NDArrayFactory::create<float>('c', {4, 8});
+    auto y = NDArrayFactory::create<float>('c', {8, 16});
+    x.linspace(1);
+    y.linspace(1);
+
+    nd4j::ops::matmul op;
+    auto result = op.execute({&x, &y}, {}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+    delete result;
+
+    // legacy op goes through NativeOpExcutioner
+    x.applyTransform(transform::Abs, nullptr);
+
+    counters->setEnabled(false);
+
+    // nothing is collected once disabled
+    x.applyTransform(transform::Neg, nullptr);
+
+    bool hasMatmul = false, hasAbs = false, hasNeg = false;
+    for (const auto& entry: counters->entries()) {
+        if (entry.opName == "matmul") {
+            hasMatmul = true;
+            ASSERT_EQ(1, entry.invocations);
+            ASSERT_NEAR(2.0 * 64 * 8, entry.flops, 1e-5);
+            ASSERT_EQ(std::string("FLOAT/2^7"), entry.shapeClass);
+        }
+
+        if (entry.opName == "TRANSFORM_SAME_" + std::to_string(transform::Abs))
+            hasAbs = true;
+
+        if (entry.opName == "TRANSFORM_SAME_" + std::to_string(transform::Neg))
+            hasNeg = true;
+    }
+
+    ASSERT_TRUE(hasMatmul);
+    ASSERT_TRUE(hasAbs);
+    ASSERT_FALSE(hasNeg);
+
+    std::string report(counters->report());
+    ASSERT_EQ(0, report.find("op,shape_class,invocations,time_ns"));
+    ASSERT_NE(std::string::npos, report.find("\nmatmul,FLOAT/2^7,1,"));
+
+    counters->reset();
+    ASSERT_TRUE(counters->entries().empty());
+}
@@ -25,6 +25,7 @@
 #include <ops/declarable/CustomOperations.h>
 #include <graph/profiling/GraphProfilingHelper.h>
 #include <type_conversions.h>
+#include <gradient_codecs.h>
 #include <helpers/threshold.h>
 #include <helpers/MmulHelper.h>
 #include <ops/ops.h>
@@ -34,6 +35,8 @@
 
 #include <helpers/BenchmarkHelper.h>
 #include <helpers/ConstantTadHelper.h>
+#include <array/TadSet.h>
+#include <reduce3.h>
 #include <array>
 
 using namespace nd4j;
@@ -1043,6 +1046,113 @@ TEST_F(PlaygroundTests, loop_test_1) {
     delete[] t;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(PlaygroundTests, test_gradient_codecs_1) {
+    const Nd4jLong length = 10000000;
+    const int iterations = 10;
+
+    auto source = NDArrayFactory::create<float>('c', {length});
+    auto target = NDArrayFactory::create<float>('c', {length});
+
+    std::vector<std::pair<int, float>> configs = {{GradientCodec::THRESHOLD_VARINT, 2.5e-3f}, {GradientCodec::TOP_K, 1e-3f}, {GradientCodec::TOP_K, 1e-2f}, {GradientCodec::SIGN_1BIT, 0.0f}, {GradientCodec::SIGN_2BIT, 0.0f}};
+
+    for (const auto &config: configs) {
+        auto codec = GradientCodecs::getInstance()->codec(config.first);
+        std::vector<uint8_t> buffer(codec->maxEncodedLength(length, config.second));
+
+        Nd4jLong encodedLength = 0;
+        Nd4jLong encodeTime = 0;
+        Nd4jLong decodeTime = 0;
+
+        for (int e = 0; e < iterations; e++) {
+            // fresh gradients, scaled so threshold codec keeps ~1% of elements
+            source.linspace(-1.0f, 2.0f / length);
+            source.applyTransform(transform::Sin, nullptr, nullptr);
+            source *= 1e-3f;
+
+            auto timeStart = std::chrono::system_clock::now();
+            encodedLength = codec->encode(nd4j::DataType::FLOAT32, source.buffer(), length, buffer.data(), buffer.size(), config.second);
+            auto timeMid = std::chrono::system_clock::now();
+            codec->decode(buffer.data(), nd4j::DataType::FLOAT32, target.buffer(), length);
+            auto timeEnd = std::chrono::system_clock::now();
+
+            ASSERT_TRUE(encodedLength > 0);
+
+            encodeTime += std::chrono::duration_cast<std::chrono::microseconds> (timeMid - timeStart).count();
+            decodeTime += std::chrono::duration_cast<std::chrono::microseconds> (timeEnd - timeMid).count();
+        }
+
+        const double bytes = (double) length * sizeof(float) * iterations;
+        nd4j_printf("%s [%f]: compression ratio: %.1f; encode: %.2f GB/s; decode: %.2f GB/s\n", codec->name(), config.second, (double) length * sizeof(float) / encodedLength, bytes / encodeTime / 1e3, bytes / decodeTime / 1e3);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(PlaygroundTests, test_nhwc_nchw_layers_1) {
+    const int bS = 8, iH = 56, iW = 56, iC = 64, oC = 64;
+    const int iterations = 10;
+
+    auto inputNCHW = NDArrayFactory::create<float>('c', {bS, iC, iH, iW});
+    auto inputNHWC = NDArrayFactory::create<float>('c', {bS, iH, iW, iC});
+    auto weights   = NDArrayFactory::create<float>('c', {3, 3, iC, oC});
+    auto weightsDw = NDArrayFactory::create<float>('c', {3, 3, iC, 1});
+    auto bias      = NDArrayFactory::create<float>('c', {oC});
+    auto mean      = NDArrayFactory::create<float>('c', {iC});
+    auto variance  = NDArrayFactory::create<float>('c', {iC});
+    inputNCHW.linspace(-1.f, 1e-6f);
+    inputNHWC.linspace(-1.f, 1e-6f);
+    weights.linspace(-0.5f, 1e-5f);
+    weightsDw.linspace(-0.5f, 1e-3f);
+    bias = 0.1f;
+    mean = 0.5f;
+    variance = 2.f;
+
+    nd4j::ops::maxpool2d maxpool;
+    nd4j::ops::avgpool2d avgpool;
+    nd4j::ops::conv2d conv;
+    nd4j::ops::depthwise_conv2d depthwise;
+    nd4j::ops::batchnorm_new batchnorm;
+    nd4j::ops::lrn lrn;
+    nd4j::ops::biasadd biasAdd;
+
+    // dataFormat 0 is NCHW, 1 is NHWC
+    for (int dataFormat = 0; dataFormat < 2; dataFormat++) {
+        auto input = dataFormat == 0 ? &inputNCHW : &inputNHWC;
+        const Nd4jLong channelAxis = dataFormat == 0 ? 1 : 3;
+
+        std::vector<std::pair<std::string, std::function<nd4j::ResultSet*()>>> layers = {
+            {"maxpool2d",        [&]() { return maxpool.execute({input}, {}, {3,3, 2,2, 0,0, 1,1, 1, 0, dataFormat}); }},
+            {"avgpool2d",        [&]() { return avgpool.execute({input}, {}, {3,3, 2,2, 0,0, 1,1, 1, 0, dataFormat}); }},
+            {"conv2d",           [&]() { return conv.execute({input, &weights, &bias}, {}, {3,3, 1,1, 0,0, 1,1, 1, dataFormat}); }},
+            {"depthwise_conv2d", [&]() { return depthwise.execute({input, &weightsDw}, {}, {3,3, 1,1, 0,0, 1,1, 1, dataFormat}); }},
+            {"batchnorm",        [&]() { return batchnorm.execute({input, &mean, &variance}, {1e-5}, {0, 0, channelAxis}); }}
+        };
+
+        // lrn and biasadd always work along last dimension
+        if (dataFormat == 1) {
+            layers.emplace_back(std::string("lrn"),     [&]() { return lrn.execute({input}, {1., 1e-4, 0.75}, {2}); });
+            layers.emplace_back(std::string("biasadd"), [&]() { return biasAdd.execute({input, &bias}, {}, {}); });
+        }
+
+        for (auto &layer : layers) {
+            Nd4jLong time = 0;
+
+            for (int e = 0; e < iterations; e++) {
+                auto timeStart = std::chrono::system_clock::now();
+                auto results = layer.second();
+                auto timeEnd = std::chrono::system_clock::now();
+
+                ASSERT_EQ(Status::OK(), results->status());
+                delete results;
+
+                time += std::chrono::duration_cast<std::chrono::microseconds> (timeEnd - timeStart).count();
+            }
+
+            nd4j_printf("%s %s: %lld us\n", dataFormat == 0 ? "NCHW" : "NHWC", layer.first.c_str(), time / iterations);
+        }
+    }
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(PlaygroundTests, ndarray_tile_test1) {
 
@@ -1378,6 +1488,68 @@ TEST_F(PlaygroundTests, test_batched_skipgram_1) {
 }
 
 
+TEST_F(PlaygroundTests, test_word2vec_batch_1) {
+    const int numCenters = 2048;
+    const int window = 4;
+    const int batchSize = numCenters * window;
+    const int numWords = 10000;
+    const int vectorLength = 100;
+    const int nsRounds = 5;
+    const int numThreads = omp_get_max_threads();
+
+    // skipgram pairs: every center word has `window` context words, so consecutive examples share positive word
+    auto target = NDArrayFactory::create<int>('c', {batchSize});
+    auto ngStarter = NDArrayFactory::create<int>('c', {batchSize});
+    auto alpha = NDArrayFactory::create<double>('c', {batchSize});
+    auto randomValue = NDArrayFactory::create<Nd4jLong>('c', {batchSize});
+    auto empty = NDArrayFactory::empty<int>();
+    auto emptyCodes = NDArrayFactory::empty<int8_t>();
+    auto syn0 = NDArrayFactory::create<float>('c', {numWords, vectorLength});
+    auto syn1 = NDArrayFactory::empty<float>();
+    auto syn1Neg = NDArrayFactory::create<float>('c', {numWords, vectorLength});
+    auto expTable = NDArrayFactory::linspace<float>(0.001, 0.995, 10000);
+    auto negTable = NDArrayFactory::create<float>('c', {100000});
+    auto inferenceVector = NDArrayFactory::empty<float>();
+
+    syn0.assign(0.01);
+    syn1Neg.assign(0.02);
+    negTable.linspace(0.0, 0.1);
+
+    Nd4jLong rv = 2843242345121L;
+    for (int e = 0; e < batchSize; e++) {
+        rv = nd4j::math::nd4j_abs<Nd4jLong>(rv * 25214903917L + 11);
+        target.p(e, rv % numWords);
+        ngStarter.p(e, (e / window * 7) % numWords);
+        alpha.p(e, 0.025);
+        randomValue.p(e, rv);
+    }
+
+    const int iterations = 10;
+
+    nd4j::ops::skipgram sg;
+    auto timeStart = std::chrono::system_clock::now();
+    for (int e = 0; e < iterations; e++) {
+        auto result = sg.execute({&target, &ngStarter, &empty, &emptyCodes, &syn0, &syn1, &syn1Neg, expTable, &negTable, &alpha, &randomValue, &inferenceVector}, {}, {numThreads, nsRounds}, {false}, true);
+        ASSERT_EQ(Status::OK(), result->status());
+        delete result;
+    }
+    auto sgTime = std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::system_clock::now() - timeStart).count();
+
+    nd4j::ops::word2vec_batch op;
+    timeStart = std::chrono::system_clock::now();
+    for (int e = 0; e < iterations; e++) {
+        auto result = op.execute({&target, &empty, &ngStarter, &empty, &emptyCodes, &syn0, &syn1, &syn1Neg, expTable, &negTable, &alpha, &randomValue}, {}, {numThreads, nsRounds}, {}, true);
+        ASSERT_EQ(Status::OK(), result->status());
+        delete result;
+    }
+    auto batchTime = std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::system_clock::now() - timeStart).count();
+
+    const double words = (double) batchSize * iterations * 1e6;
+    nd4j_printf("skipgram: %.1f words/sec/core; word2vec_batch: %.1f words/sec/core\n", words / sgTime / numThreads, words / batchTime / numThreads);
+
+    delete expTable;
+}
+
 TEST_F(PlaygroundTests, test_reduce_scalar_float_1) {
     auto array = NDArrayFactory::create<float>('c', {32, 128, 256, 256});
     auto target = NDArrayFactory::create<float>(0.0f);
@@ -1658,6 +1830,188 @@ TEST_F(PlaygroundTests, softmax_1) {
 
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(PlaygroundTests, transcendental_precision_1) {
+
+    const int N = 50;
+    NDArray input('c', {1024, 1024}, nd4j::DataType::FLOAT32);
+    NDArray output('c', {1024, 1024}, nd4j::DataType::FLOAT32);
+    input.linspace(-10., 0.00002);
+
+    auto original = Environment::getInstance()->mathPrecision();
+    std::vector<nd4j::transform::StrictOps> ops = {transform::Exp, transform::Log, transform::Tanh, transform::Sigmoid, transform::Erf};
+    std::vector<std::string> names = {"exp", "log", "tanh", "sigmoid", "erf"};
+    std::vector<MathPrecision> precisions = {MATH_LIBM, MATH_VECTOR, MATH_FAST};
+
+    for (int o = 0; o < ops.size(); o++) {
+        for (auto precision : precisions) {
+            Environment::getInstance()->setMathPrecision(precision);
+
+            auto timeStart = std::chrono::system_clock::now();
+
+            for (int i = 0; i < N; i++)
+                input.applyTransform(ops[o], &output);
+
+            auto timeEnd = std::chrono::system_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart) / N).count();
+            printf("%s precision %i: %lld us\n", names[o].c_str(), (int) precision, (long long) duration);
+        }
+    }
+
+    Environment::getInstance()->setMathPrecision(original);
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(PlaygroundTests, qmatmul_vs_matmul_1) {
+
+    const int N = 20;
+    auto x = NDArrayFactory::create<float>('c', {64, 1024});
+    auto w = NDArrayFactory::create<float>('c', {1024, 1024});
+    auto xq = NDArrayFactory::create<uint8_t>('c', {64, 1024});
+    auto wq = NDArrayFactory::create<int8_t>('c', {1024, 1024});
+    auto wScales = NDArrayFactory::create<float>(0.01f);
+    auto wZeroPoints = NDArrayFactory::create<int>(0);
+    x.linspace(-1., 0.00003);
+    w.linspace(-1., 0.000002);
+    xq.assign(3);
+    wq.assign(-2);
+
+    nd4j::ops::matmul mmul;
+    nd4j::ops::qmatmul qmul;
+
+    auto timeStart = std::chrono::system_clock::now();
+    for (int i = 0; i < N; i++) {
+        auto result = mmul.execute({&x, &w}, {}, {});
+        delete result;
+    }
+    auto timeEnd = std::chrono::system_clock::now();
+    auto floatTime = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart) / N).count();
+
+    timeStart = std::chrono::system_clock::now();
+    for (int i = 0; i < N; i++) {
+        auto result = qmul.execute({&xq, &wq, &wScales, &wZeroPoints}, {0.02, 128.}, {});
+        delete result;
+    }
+    timeEnd = std::chrono::system_clock::now();
+    auto int8Time = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart) / N).count();
+
+    printf("matmul float32: %lld us; qmatmul uint8 x int8: %lld us\n", (long long) floatTime, (long long) int8Time);
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(PlaygroundTests, tad_set_vs_result_set_1) {
+
+    const int N = 100;
+    auto x = NDArrayFactory::create<float>('c', {10000, 16});
+    x.linspace(1.);
+
+    // ResultSet owns one heap-allocated NDArray per TAD, TadSet returns them by value
+    Nd4jLong resultSetAllocations = 0;
+    float sum = 0.f;
+    auto timeStart = std::chrono::system_clock::now();
+    for (int i = 0; i < N; i++) {
+        auto tads = x.allTensorsAlongDimension({1});
+        resultSetAllocations += tads->size();
+        for (int e = 0; e < tads->size(); e++)
+            sum += tads->at(e)->t<float>(0);
+        delete tads;
+    }
+    auto timeEnd = std::chrono::system_clock::now();
+    auto resultSetTime = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart) / N).count();
+
+    timeStart = std::chrono::system_clock::now();
+    for (int i = 0; i < N; i++) {
+        TadSet tads(x, {1});
+        for (int e = 0; e < tads.size(); e++)
+            sum += tads.at(e).t<float>(0);
+    }
+    timeEnd = std::chrono::system_clock::now();
+    auto tadSetTime = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart) / N).count();
+
+    printf("10000 TADs, per pass: ResultSet %lld us, %lld NDArray allocations; TadSet %lld us, 0 NDArray allocations; checksum %f\n",
+           (long long) resultSetTime, (long long) (resultSetAllocations / N), (long long) tadSetTime, sum);
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(PlaygroundTests, reduce3_all_blocked_vs_loops_1) {
+
+    const int N = 5;
+    auto x = NDArrayFactory::create<float>('c', {2048, 128});
+    auto y = NDArrayFactory::create<float>('c', {512, 128});
+    auto z = NDArrayFactory::create<float>('c', {2048, 512});
+    x.linspace(-1., 1e-5);
+    y.linspace(1., -3e-5);
+
+    std::vector<int> dims({1});
+    auto tadPackX = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(x.shapeInfo(), dims);
+    auto tadPackY = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(y.shapeInfo(), dims);
+
+    for (int opNum : {reduce3::EuclideanDistance, reduce3::CosineSimilarity, reduce3::ManhattanDistance}) {
+        auto timeStart = std::chrono::system_clock::now();
+        for (int i = 0; i < N; i++)
+            functions::reduce3::Reduce3<float, float>::execAllLoops(opNum, x.buffer(), x.shapeInfo(), nullptr, y.buffer(), y.shapeInfo(), z.buffer(), z.shapeInfo(), dims.data(), dims.size(),
+                                                                    tadPackX.primaryShapeInfo(), tadPackX.primaryOffsets(), tadPackY.primaryShapeInfo(), tadPackY.primaryOffsets());
+        auto timeEnd = std::chrono::system_clock::now();
+        auto loopsTime = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart) / N).count();
+
+        timeStart = std::chrono::system_clock::now();
+        for (int i = 0; i < N; i++)
+            NativeOpExcutioner::execReduce3All(opNum, x.buffer(), x.shapeInfo(), nullptr, y.buffer(), y.shapeInfo(), z.buffer(), z.shapeInfo(), dims.data(), dims.size(),
+                                               tadPackX.primaryShapeInfo(), tadPackX.primaryOffsets(), tadPackY.primaryShapeInfo(), tadPackY.primaryOffsets());
+        timeEnd = std::chrono::system_clock::now();
+        auto blockedTime = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart) / N).count();
+
+        printf("reduce3 op %i, 2048 x 512 pairs of 128: loops %lld us; blocked %lld us\n", opNum, (long long) loopsTime, (long long) blockedTime);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(PlaygroundTests, knn_recall_latency_1) {
+
+    auto data = NDArrayFactory::create<float>('c', {50000, 32});
+    auto queries = NDArrayFactory::create<float>('c', {500, 32});
+    auto dataBuffer = reinterpret_cast<float*>(data.buffer());
+    auto queriesBuffer = reinterpret_cast<float*>(queries.buffer());
+    for (Nd4jLong e = 0; e < data.lengthOf(); e++)
+        dataBuffer[e] = static_cast<float>((e * 7919) % 10007) / 10007.f;
+    for (Nd4jLong e = 0; e < queries.lengthOf(); e++)
+        queriesBuffer[e] = static_cast<float>((e * 104729 + 7) % 10009) / 10009.f;
+
+    const int k = 10;
+    nd4j::ops::knn_search bruteForce;
+    nd4j::ops::vptree_build build;
+    nd4j::ops::vptree_search search;
+
+    auto timeStart = std::chrono::system_clock::now();
+    auto exact = bruteForce.execute({&data, &queries}, {}, {k, 1});
+    auto timeEnd = std::chrono::system_clock::now();
+    printf("knn brute force: %lld us\n", (long long) std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+
+    timeStart = std::chrono::system_clock::now();
+    auto tree = build.execute({&data}, {}, {1});
+    timeEnd = std::chrono::system_clock::now();
+    printf("vptree build: %lld us\n", (long long) std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+
+    for (Nd4jLong maxVisits : {0, 20000, 5000, 1000}) {
+        timeStart = std::chrono::system_clock::now();
+        auto result = search.execute({&data, tree->at(0), tree->at(1), &queries}, {}, {k, 1, maxVisits});
+        timeEnd = std::chrono::system_clock::now();
+
+        Nd4jLong hits = 0;
+        for (Nd4jLong q = 0; q < queries.sizeAt(0); q++)
+            for (int j = 0; j < k; j++)
+                for (int i = 0; i < k; i++)
+                    if (result->at(0)->e<Nd4jLong>(q, j) == exact->at(0)->e<Nd4jLong>(q, i))
+                        hits++;
+
+        printf("vptree search, max visits %lld: %lld us; recall %f\n", (long long) maxVisits, (long long) std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count(), (double) hits / (queries.sizeAt(0) * k));
+        delete result;
+    }
+
+    delete exact;
+    delete tree;
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(PlaygroundTests, subarr_1) {
 
@@ -2073,3 +2427,40 @@ TEST_F(PlaygroundTests, loops_5) {
     auto myTime = std::chrono::duration_cast<std::chrono::milliseconds> ((timeEnd - timeStart) / N) .count();
     nd4j_printf("My  time: %lld us;\n", myTime);
 }
+
+TEST_F(PlaygroundTests, permuted_copy_1) {
+    const int iterations = 10;
+
+    auto x = NDArrayFactory::create<float>('c', {32, 64, 56, 56});
+    x.linspace(1);
+
+    std::vector<std::vector<int>> permutations = {{1, 0, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {3, 2, 1, 0}};
+
+    for (auto &permutation: permutations) {
+        auto p = x.permute(permutation);
+        auto z = NDArrayFactory::create<float>('c', p->getShapeAsVector());
+        auto zBuffer = z.bufferAsT<float>();
+        auto pBuffer = p->bufferAsT<float>();
+        const Nd4jLong len = x.lengthOf();
+
+        // per-element index evaluation, as done by generic loop before
+        auto timeStart = std::chrono::system_clock::now();
+        for (int e = 0; e < iterations; e++) {
+            PRAGMA_OMP_PARALLEL_FOR_SIMD
+            for (Nd4jLong i = 0; i < len; i++)
+                zBuffer[shape::getIndexOffset(i, z.getShapeInfo(), len)] = pBuffer[shape::getIndexOffset(i, p->getShapeInfo(), len)];
+        }
+        auto timeEnd = std::chrono::system_clock::now();
+        auto indexTime = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart) / iterations).count();
+
+        timeStart = std::chrono::system_clock::now();
+        for (int e = 0; e < iterations; e++)
+            z.assign(p);
+        timeEnd = std::chrono::system_clock::now();
+        auto coalescedTime = std::chrono::duration_cast<std::chrono::microseconds> ((timeEnd - timeStart) / iterations).count();
+
+        nd4j_printf("permute %s: index path %lld us; coalesced %lld us;\n", ShapeUtils::shapeAsString(std::vector<Nd4jLong>(permutation.begin(), permutation.end())).c_str(), indexTime, coalescedTime);
+
+        delete p;
+    }
+}
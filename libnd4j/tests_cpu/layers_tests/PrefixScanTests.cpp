@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Tests for parallel prefix scan engine and scan-based helpers
+//
+
+#include "testlayers.h"
+#include <NDArray.h>
+#include <NDArrayFactory.h>
+#include <helpers/PrefixScan.h>
+#include <ops/declarable/CustomOperations.h>
+#include <loops/type_conversions.h>
+#include <vector>
+
+using namespace nd4j;
+
+class PrefixScanTests : public testing::Test {
+public:
+
+};
+
+TEST_F(PrefixScanTests, Scan_Long_1) {
+    const Nd4jLong length = 300000;
+    std::vector<Nd4jLong> x(length);
+    for (Nd4jLong e = 0; e < length; e++)
+        x[e] = (e * 37) % 11 - 5;
+
+    for (int exclusive = 0; exclusive < 2; exclusive++) {
+        for (int reverse = 0; reverse < 2; reverse++) {
+            std::vector<Nd4jLong> exp(length), z(length);
+            Nd4jLong sum = 0;
+            for (Nd4jLong i = 0; i < length; i++) {
+                const Nd4jLong e = reverse ? length - i - 1 : i;
+                if (exclusive) {
+                    exp[e] = sum;
+                    sum += x[e];
+                } else {
+                    sum += x[e];
+                    exp[e] = sum;
+                }
+            }
+
+            auto total = PrefixScan::scan<Nd4jLong, scan::Add<Nd4jLong>>(x.data(), z.data(), length, exclusive == 1, reverse == 1);
+            ASSERT_EQ(sum, total);
+            ASSERT_EQ(exp, z);
+        }
+    }
+}
+
+TEST_F(PrefixScanTests, Scan_Long_2) {
+    const Nd4jLong length = 200000;
+    auto x = NDArrayFactory::create<double>('c', {length});
+    auto exp = NDArrayFactory::create<double>('c', {length});
+    for (Nd4jLong e = 0; e < length; e++) {
+        x.p(e, static_cast<double>(e % 3));
+        exp.p(e, static_cast<double>((e / 3) * 3 + (e % 3) * (e % 3 + 1) / 2));
+    }
+
+    nd4j::ops::cumsum op;
+    auto result = op.execute({&x}, {}, {0, 0});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    delete result;
+}
+
+TEST_F(PrefixScanTests, Scan_Tads_1) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3}, {1.f, 2.f, 3.f,   4.f, 5.f, 6.f});
+    auto expRows = NDArrayFactory::create<float>('c', {2, 3}, {6.f, 3.f, 1.f,   30.f, 6.f, 1.f});
+    auto expCols = NDArrayFactory::create<float>('c', {2, 3}, {1.f, 1.f, 1.f,   1.f, 2.f, 3.f});
+
+    nd4j::ops::cumprod op;
+    auto rows = op.execute({&x}, {}, {1, 1, 1});
+    auto cols = op.execute({&x}, {}, {1, 0, 0});
+    ASSERT_EQ(Status::OK(), rows->status());
+    ASSERT_EQ(Status::OK(), cols->status());
+
+    ASSERT_EQ(expRows, *rows->at(0));
+    ASSERT_EQ(expCols, *cols->at(0));
+
+    delete rows;
+    delete cols;
+}
+
+TEST_F(PrefixScanTests, Threshold_Encoding_1) {
+    const Nd4jLong length = 100000;
+    const int limit = 100;
+    std::vector<float> x(length, 0.f);
+    for (Nd4jLong e = 0; e < length; e += 500)
+        x[e] = e % 1000 == 0 ? 2.f : -2.f;
+
+    std::vector<int> z(limit + 4, 0);
+    FloatBits fb;
+    fb.f_ = 1.5f;
+    z[0] = limit;
+    z[2] = fb.i_;
+
+    TypeCast::convertToThreshold<float>(nullptr, x.data(), length, z.data());
+
+    // the first limit updates in order of elements, only these are subtracted from input
+    for (int e = 0; e < limit; e++)
+        ASSERT_EQ(e % 2 == 0 ? e * 500 + 1 : -(e * 500) - 1, z[e + 4]);
+
+    ASSERT_NEAR(0.5f, x[0], 1e-6f);
+    ASSERT_NEAR(-0.5f, x[(limit - 1) * 500], 1e-6f);
+    ASSERT_NEAR(2.f, x[limit * 500], 1e-6f);
+}
@@ -22,12 +22,28 @@
 #include "testlayers.h"
 #include <NDArray.h>
 #include <type_conversions.h>
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/quantization.h>
+#include <graph/Graph.h>
+#include <GraphExecutioner.h>
+#include <Environment.h>
+#include <cmath>
 
 
 using namespace nd4j;
+using namespace nd4j::graph;
 
 class QuantizationTests : public testing::Test {
+public:
+    bool fold;
 
+    QuantizationTests() {
+        fold = Environment::getInstance()->isFoldQuantization();
+    }
+
+    ~QuantizationTests() {
+        Environment::getInstance()->setFoldQuantization(fold);
+    }
 };
 
 TEST_F(QuantizationTests, Basic_Test_1) {
@@ -58,4 +74,281 @@ TEST_F(QuantizationTests, Compression_Test_1) {
     ASSERT_NEAR(10.0f, fq[1], 1e-5);
 
     delete[] q;
-}
\ No newline at end of file
+}
+
+// x [M, K] uint8, y [K, N] int8, result is dequantised product plus bias
+static std::vector<double> referenceProduct(NDArray& x, float xScale, int xZeroPoint, NDArray& y, NDArray& yScales, NDArray& yZeroPoints, NDArray& bias) {
+    const int M = x.sizeAt(0);
+    const int K = x.sizeAt(1);
+    const int N = y.sizeAt(1);
+
+    std::vector<double> result(M * N);
+    for (int i = 0; i < M; i++)
+        for (int j = 0; j < N; j++) {
+            double sum = 0.;
+            for (int k = 0; k < K; k++)
+                sum += (x.e<int>(i, k) - xZeroPoint) * (double) (y.e<int>(k, j) - yZeroPoints.e<int>(j));
+
+            result[i * N + j] = xScale * yScales.e<double>(j) * sum + bias.e<double>(j);
+        }
+
+    return result;
+}
+
+static void fillQuantized(NDArray& x, NDArray& y, NDArray& yScales, NDArray& yZeroPoints, NDArray& bias) {
+    for (int e = 0; e < x.lengthOf(); e++)
+        x.p(e, (e * 37 + 11) % 256);
+
+    for (int e = 0; e < y.lengthOf(); e++)
+        y.p(e, (e * 53 + 7) % 256 - 128);
+
+    for (int j = 0; j < yScales.lengthOf(); j++) {
+        yScales.p(j, 0.01f * (j + 1));
+        yZeroPoints.p(j, j % 3 - 1);
+        bias.p(j, 0.5f - 0.1f * j);
+    }
+}
+
+TEST_F(QuantizationTests, QMatmul_1) {
+    auto x = NDArrayFactory::create<uint8_t>('c', {5, 37});
+    auto y = NDArrayFactory::create<int8_t>('c', {37, 9});
+    auto yScales = NDArrayFactory::create<float>('c', {9});
+    auto yZeroPoints = NDArrayFactory::create<int>('c', {9});
+    auto bias = NDArrayFactory::create<float>('c', {9});
+    fillQuantized(x, y, yScales, yZeroPoints, bias);
+
+    auto exp = referenceProduct(x, 0.05f, 3, y, yScales, yZeroPoints, bias);
+
+    nd4j::ops::qmatmul op;
+    auto result = op.execute({&x, &y, &yScales, &yZeroPoints, &bias}, {0.05, 3.}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    auto z = result->at(0);
+    ASSERT_EQ(nd4j::DataType::FLOAT32, z->dataType());
+    ASSERT_TRUE(z->isSameShape({5, 9}));
+
+    for (int e = 0; e < z->lengthOf(); e++)
+        ASSERT_NEAR(exp[e], z->e<double>(e), 1e-4 * nd4j::math::nd4j_max<double>(1., std::fabs(exp[e])));
+
+    delete result;
+}
+
+TEST_F(QuantizationTests, QMatmul_Requantized_1) {
+    auto x = NDArrayFactory::create<uint8_t>('c', {4, 70});
+    auto y = NDArrayFactory::create<int8_t>('c', {70, 6});
+    auto yScales = NDArrayFactory::create<float>('c', {6});
+    auto yZeroPoints = NDArrayFactory::create<int>('c', {6});
+    auto bias = NDArrayFactory::create<float>('c', {6});
+    fillQuantized(x, y, yScales, yZeroPoints, bias);
+
+    const float outScale = 2.5f;
+    const int outZeroPoint = 100;
+    auto exp = referenceProduct(x, 0.01f, 0, y, yScales, yZeroPoints, bias);
+
+    nd4j::ops::qmatmul op;
+    auto result = op.execute({&x, &y, &yScales, &yZeroPoints, &bias}, {0.01, 0., outScale, (double) outZeroPoint}, {1});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    auto z = result->at(0);
+    ASSERT_EQ(nd4j::DataType::UINT8, z->dataType());
+
+    for (int e = 0; e < z->lengthOf(); e++) {
+        int q = static_cast<int>(std::floor(exp[e] / outScale + 0.5)) + outZeroPoint;
+        q = q < 0 ? 0 : q > 255 ? 255 : q;
+        ASSERT_NEAR(q, z->e<int>(e), 1);
+    }
+
+    delete result;
+}
+
+TEST_F(QuantizationTests, QMatmul_FakeQuant_Parity_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 21});
+    auto w = NDArrayFactory::create<float>('c', {21, 10});
+    x.linspace(-1.2, 0.04);
+    w.linspace(-0.5, 0.005);
+
+    auto xMin = NDArrayFactory::create<float>(-1.f);
+    auto xMax = NDArrayFactory::create<float>(1.f);
+    auto wMin = NDArrayFactory::create<float>(-0.5f);
+    auto wMax = NDArrayFactory::create<float>(0.5f);
+
+    nd4j::ops::fake_quant_with_min_max_vars fq;
+    nd4j::ops::matmul mmul;
+    auto fqX = fq.execute({&x, &xMin, &xMax}, {}, {});
+    auto fqW = fq.execute({&w, &wMin, &wMax}, {}, {});
+    auto exp = mmul.execute({fqX->at(0), fqW->at(0)}, {}, {});
+
+    float xScale, wScale;
+    int xZeroPoint, xQuantMin, xQuantMax, wZeroPoint, wQuantMin, wQuantMax;
+    ops::helpers::nudgeQuantizationRange(-1.f, 1.f, 8, false, xScale, xZeroPoint, xQuantMin, xQuantMax);
+    ops::helpers::nudgeQuantizationRange(-0.5f, 0.5f, 8, false, wScale, wZeroPoint, wQuantMin, wQuantMax);
+
+    auto wq = NDArrayFactory::create<int8_t>('c', {21, 10});
+    ops::helpers::quantize(w, wScale, wZeroPoint, wQuantMin, wQuantMax, wq);
+    auto wScales = NDArrayFactory::create<float>(wScale);
+    auto wZeroPoints = NDArrayFactory::create<int>(wZeroPoint - 128);
+
+    nd4j::ops::qmatmul op;
+    auto result = op.execute({&x, &wq, &wScales, &wZeroPoints}, {xScale, (double) xZeroPoint}, {0, xQuantMin, xQuantMax});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    ASSERT_TRUE(exp->at(0)->isSameShape(result->at(0)));
+    ASSERT_TRUE(exp->at(0)->equalsTo(result->at(0), 1e-4));
+
+    delete fqX;
+    delete fqW;
+    delete exp;
+    delete result;
+}
+
+TEST_F(QuantizationTests, QConv2d_1) {
+    const int bS = 2, iH = 5, iW = 6, iC = 3, oC = 5, kH = 3, kW = 3;
+
+    for (int isNHWC = 0; isNHWC < 2; isNHWC++) {
+        auto input = isNHWC ? NDArrayFactory::create<uint8_t>('c', {bS, iH, iW, iC}) : NDArrayFactory::create<uint8_t>('c', {bS, iC, iH, iW});
+        auto weights = NDArrayFactory::create<int8_t>('c', {kH, kW, iC, oC});
+        auto wScales = NDArrayFactory::create<float>('c', {oC});
+        auto wZeroPoints = NDArrayFactory::create<int>('c', {oC});
+        auto bias = NDArrayFactory::create<float>('c', {oC});
+
+        for (int e = 0; e < input.lengthOf(); e++)
+            input.p(e, (e * 29 + 5) % 256);
+
+        for (int e = 0; e < weights.lengthOf(); e++)
+            weights.p(e, (e * 41 + 3) % 256 - 128);
+
+        for (int j = 0; j < oC; j++) {
+            wScales.p(j, 0.002f * (j + 1));
+            wZeroPoints.p(j, j - 2);
+            bias.p(j, 0.1f * j);
+        }
+
+        const float xScale = 0.03f;
+        const int xZeroPoint = 17;
+
+        // same convolution in real domain, zero padding there is xZeroPoint in quantised one
+        auto inputReal = NDArrayFactory::create<float>(input.ordering(), input.getShapeAsVector());
+        auto weightsReal = NDArrayFactory::create<float>('c', {kH, kW, iC, oC});
+        for (int e = 0; e < input.lengthOf(); e++)
+            inputReal.p(e, xScale * (input.e<int>(e) - xZeroPoint));
+
+        for (int e = 0; e < weights.lengthOf(); e++)
+            weightsReal.p(e, wScales.e<float>(e % oC) * (weights.e<int>(e) - wZeroPoints.e<int>(e % oC)));
+
+        nd4j::ops::conv2d conv;
+        auto exp = conv.execute({&inputReal, &weightsReal, &bias}, {}, {kH, kW, 1, 1, 0, 0, 1, 1, 1, isNHWC});
+        ASSERT_EQ(Status::OK(), exp->status());
+
+        nd4j::ops::qconv2d op;
+        auto result = op.execute({&input, &weights, &wScales, &wZeroPoints, &bias}, {xScale, (double) xZeroPoint}, {kH, kW, 1, 1, 0, 0, 1, 1, 1, isNHWC});
+        ASSERT_EQ(Status::OK(), result->status());
+
+        ASSERT_TRUE(exp->at(0)->isSameShape(result->at(0)));
+        ASSERT_TRUE(exp->at(0)->equalsTo(result->at(0), 1e-4));
+
+        delete exp;
+        delete result;
+    }
+}
+
+TEST_F(QuantizationTests, Graph_Fold_FakeQuant_1) {
+    for (int enabled = 0; enabled < 2; enabled++) {
+        Environment::getInstance()->setFoldQuantization(enabled == 1);
+
+        Graph graph;
+
+        auto x = NDArrayFactory::create_<float>('c', {4, 16});
+        auto w = NDArrayFactory::create_<float>('c', {16, 6});
+        x->linspace(-1.5, 0.05);
+        w->linspace(-0.3, 0.007);
+
+        graph.getVariableSpace()->putVariable(-1, x);
+        graph.getVariableSpace()->putVariable(-2, NDArrayFactory::create_<float>(-1.5f));
+        graph.getVariableSpace()->putVariable(-3, NDArrayFactory::create_<float>(1.5f));
+        graph.getVariableSpace()->putVariable(-4, w);
+        graph.getVariableSpace()->putVariable(-5, NDArrayFactory::create_<float>(-0.4f));
+        graph.getVariableSpace()->putVariable(-6, NDArrayFactory::create_<float>(0.4f));
+
+        nd4j::ops::fake_quant_with_min_max_vars fq;
+        nd4j::ops::matmul mmul;
+
+        graph.addNode(new Node(&fq, 1, {-1, -2, -3}));
+        graph.addNode(new Node(&fq, 2, {-4, -5, -6}));
+        graph.addNode(new Node(&mmul, 3, {1, 2}));
+
+        // expected values are evaluated with plain fake-quant + matmul
+        auto xMin = NDArrayFactory::create<float>(-1.5f);
+        auto xMax = NDArrayFactory::create<float>(1.5f);
+        auto wMin = NDArrayFactory::create<float>(-0.4f);
+        auto wMax = NDArrayFactory::create<float>(0.4f);
+        auto fqX = fq.execute({x, &xMin, &xMax}, {}, {});
+        auto fqW = fq.execute({w, &wMin, &wMax}, {}, {});
+        auto exp = mmul.execute({fqX->at(0), fqW->at(0)}, {}, {});
+
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+
+        if (enabled) {
+            ASSERT_FALSE(graph.hasNode(1));
+            ASSERT_FALSE(graph.hasNode(2));
+            ASSERT_EQ(std::string("qmatmul"), *graph.nodeById(3)->getCustomOp()->getOpName());
+        } else
+            ASSERT_EQ(std::string("matmul"), *graph.nodeById(3)->getCustomOp()->getOpName());
+
+        auto z = graph.getVariableSpace()->getVariable(3)->getNDArray();
+        ASSERT_TRUE(exp->at(0)->isSameShape(z));
+        ASSERT_TRUE(exp->at(0)->equalsTo(z, 1e-4));
+
+        delete fqX;
+        delete fqW;
+        delete exp;
+    }
+}
+
+TEST_F(QuantizationTests, Graph_Fold_FakeQuant_Saturated_1) {
+    ASSERT_FALSE(fold);
+
+    // inputs exceed both ranges, so results depend on the upper grid bound the op uses
+    for (int enabled = 0; enabled < 2; enabled++) {
+        Environment::getInstance()->setFoldQuantization(enabled == 1);
+
+        Graph graph;
+
+        auto x = NDArrayFactory::create_<float>('c', {3, 8});
+        auto w = NDArrayFactory::create_<float>('c', {8, 5});
+        x->linspace(-3.0, 0.25);
+        w->linspace(-1.0, 0.05);
+
+        graph.getVariableSpace()->putVariable(-1, x);
+        graph.getVariableSpace()->putVariable(-2, NDArrayFactory::create_<float>(-1.f));
+        graph.getVariableSpace()->putVariable(-3, NDArrayFactory::create_<float>(1.f));
+        graph.getVariableSpace()->putVariable(-4, w);
+        graph.getVariableSpace()->putVariable(-5, NDArrayFactory::create_<float>(-0.5f));
+        graph.getVariableSpace()->putVariable(-6, NDArrayFactory::create_<float>(0.5f));
+
+        nd4j::ops::fake_quant_with_min_max_vars fq;
+        nd4j::ops::matmul mmul;
+
+        graph.addNode(new Node(&fq, 1, {-1, -2, -3}));
+        graph.addNode(new Node(&fq, 2, {-4, -5, -6}));
+        graph.addNode(new Node(&mmul, 3, {1, 2}));
+
+        auto xMin = NDArrayFactory::create<float>(-1.f);
+        auto xMax = NDArrayFactory::create<float>(1.f);
+        auto wMin = NDArrayFactory::create<float>(-0.5f);
+        auto wMax = NDArrayFactory::create<float>(0.5f);
+        auto fqX = fq.execute({x, &xMin, &xMax}, {}, {});
+        auto fqW = fq.execute({w, &wMin, &wMax}, {}, {});
+        auto exp = mmul.execute({fqX->at(0), fqW->at(0)}, {}, {});
+
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(&graph));
+        ASSERT_EQ(enabled == 1, !graph.hasNode(1));
+
+        auto z = graph.getVariableSpace()->getVariable(3)->getNDArray();
+        ASSERT_TRUE(exp->at(0)->isSameShape(z));
+        ASSERT_TRUE(exp->at(0)->equalsTo(z, 1e-4));
+
+        delete fqX;
+        delete fqW;
+        delete exp;
+    }
+}
@@ -22,6 +22,7 @@
 #include <Graph.h>
 #include <Node.h>
 #include <ops/declarable/CustomOperations.h>
+#include <array/TadSet.h>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -48,4 +49,35 @@ TEST_F(ResultSetTests, basic_test_1) {
         ASSERT_EQ(5, tensors->at(e)->lengthOf());
 
     delete tensors;
-}
\ No newline at end of file
+}
+
+TEST_F(ResultSetTests, tad_set_test_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4, 5});
+    x.linspace(1);
+
+    auto tensors = x.allTensorsAlongDimension({1, 2});
+    TadSet tads(x, {1, 2});
+
+    ASSERT_EQ(tensors->size(), tads.size());
+
+    for (int e = 0; e < tads.size(); e++) {
+        auto tad = tads.at(e);
+        ASSERT_TRUE(tensors->at(e)->isSameShape(tad));
+        ASSERT_TRUE(tensors->at(e)->equalsTo(tad));
+        ASSERT_EQ(tensors->at(e)->getBuffer(), tad.getBuffer());
+        ASSERT_EQ(tensors->at(e)->getBuffer(), tads.bufferAt<float>(e));
+    }
+
+    delete tensors;
+}
+
+TEST_F(ResultSetTests, tad_set_test_2) {
+    auto x = NDArrayFactory::create<float>('c', {4, 3});
+    auto exp = NDArrayFactory::create<float>('c', {4, 3}, {1.f, 1.f, 1.f, 2.f, 2.f, 2.f, 3.f, 3.f, 3.f, 4.f, 4.f, 4.f});
+
+    float value = 1.f;
+    for (auto tad : TadSet::examples(x))
+        tad.assign(value++);
+
+    ASSERT_EQ(exp, x);
+}
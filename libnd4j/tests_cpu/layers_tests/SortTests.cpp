@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Tests for radix/merge sort engine
+//
+
+#include "testlayers.h"
+#include <NDArray.h>
+#include <NDArrayFactory.h>
+#include <helpers/SortHelper.h>
+#include <helpers/ConstantTadHelper.h>
+#include <ops/specials.h>
+#include <algorithm>
+#include <vector>
+
+using namespace nd4j;
+
+class SortTests : public testing::Test {
+public:
+
+};
+
+TEST_F(SortTests, Sort_Radix_1) {
+    const Nd4jLong length = 100000;
+    auto x = NDArrayFactory::create<float>('c', {length});
+    auto buffer = reinterpret_cast<float*>(x.buffer());
+    for (Nd4jLong e = 0; e < length; e++)
+        buffer[e] = static_cast<float>((e * 7919) % 20011) - 10000.f + 0.5f;
+
+    std::vector<float> exp(buffer, buffer + length);
+    std::sort(exp.begin(), exp.end());
+
+    SpecialMethods<float>::sortGeneric(x.buffer(), x.shapeInfo(), false);
+    for (Nd4jLong e = 0; e < length; e++)
+        ASSERT_EQ(exp[e], buffer[e]);
+
+    SpecialMethods<float>::sortGeneric(x.buffer(), x.shapeInfo(), true);
+    for (Nd4jLong e = 0; e < length; e++)
+        ASSERT_EQ(exp[length - e - 1], buffer[e]);
+}
+
+TEST_F(SortTests, Sort_Radix_2) {
+    std::vector<Nd4jLong> x = {5, -3, 1000000000000LL, 0, -1000000000000LL, 7, -3, 2};
+    for (int e = 0; e < 300; e++)
+        x.push_back((e * 31) % 17 - 8);
+
+    auto exp = x;
+    std::sort(exp.begin(), exp.end());
+
+    SortHelper::sort<Nd4jLong>(x.data(), x.size(), false);
+    ASSERT_EQ(exp, x);
+}
+
+TEST_F(SortTests, Sort_Tad_1) {
+    auto x = NDArrayFactory::create<double>('c', {3, 4}, {3., 1., 2., 0.,   -1., 5., 4., -2.,   7., 7., 1., 8.});
+    auto expRows = NDArrayFactory::create<double>('c', {3, 4}, {3., 2., 1., 0.,   5., 4., -1., -2.,   8., 7., 7., 1.});
+    auto expCols = NDArrayFactory::create<double>('c', {3, 4}, {-1., 1., 1., -2.,   3., 5., 2., 0.,   7., 7., 4., 8.});
+
+    auto y = x.dup('c');
+    std::vector<int> dims({1});
+    auto rows = ConstantTadHelper::getInstance()->tadForDimensions(y->shapeInfo(), dims);
+    SpecialMethods<double>::sortTadGeneric(y->buffer(), y->shapeInfo(), dims.data(), dims.size(), rows.primaryShapeInfo(), rows.primaryOffsets(), true);
+    ASSERT_EQ(expRows, *y);
+
+    // strided TADs
+    dims = {0};
+    auto cols = ConstantTadHelper::getInstance()->tadForDimensions(x.shapeInfo(), dims);
+    SpecialMethods<double>::sortTadGeneric(x.buffer(), x.shapeInfo(), dims.data(), dims.size(), cols.primaryShapeInfo(), cols.primaryOffsets(), false);
+    ASSERT_EQ(expCols, x);
+
+    delete y;
+}
+
+TEST_F(SortTests, ArgSort_Stable_1) {
+    const Nd4jLong length = 1000;
+    std::vector<float> x(length);
+    for (Nd4jLong e = 0; e < length; e++)
+        x[e] = static_cast<float>(e % 5);
+
+    std::vector<Nd4jLong> indices(length);
+    SortHelper::argSort<float>(x.data(), length, indices.data(), true);
+
+    for (Nd4jLong e = 1; e < length; e++) {
+        ASSERT_TRUE(x[indices[e - 1]] >= x[indices[e]]);
+        if (x[indices[e - 1]] == x[indices[e]])
+            ASSERT_TRUE(indices[e - 1] < indices[e]);
+    }
+
+    // x is left intact
+    ASSERT_EQ(3.f, x[3]);
+}
+
+TEST_F(SortTests, MergeSort_1) {
+    const Nd4jLong length = 200000;
+    std::vector<std::pair<int, int>> x(length);
+    for (Nd4jLong e = 0; e < length; e++)
+        x[e] = std::make_pair(static_cast<int>((e * 7919) % 1013), static_cast<int>(e));
+
+    auto less = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+    auto exp = x;
+    std::stable_sort(exp.begin(), exp.end(), less);
+
+    SortHelper::mergeSort(x.data(), length, less);
+    ASSERT_EQ(exp, x);
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include "testlayers.h"
+#include <graph/Graph.h>
+#include <graph/Node.h>
+#include <GraphExecutioner.h>
+#include <graph/profiling/TraceExporter.h>
+#include <NDArrayFactory.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace nd4j;
+using namespace nd4j::graph;
+
+class TraceExporterTests : public testing::Test {
+public:
+
+};
+
+static std::string readTrace(const char* path) {
+    std::ifstream file(path);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+TEST_F(TraceExporterTests, Test_Manual_Spans_1) {
+    const char* path = "trace_exporter_test_1.json";
+    auto tracer = TraceExporter::getInstance();
+
+    ASSERT_TRUE(tracer->start(path));
+    ASSERT_TRUE(tracer->isCapturing());
+
+    TraceSpan span;
+    span.name = "matmul";
+    span.category = "node";
+    span.nodeId = 7;
+    span.nodeName = "dense/\"kernel\"";
+    span.start = 1000L;
+    span.duration = 2500L;
+    span.memoryUsed = 4096L;
+    span.memoryDelta = 1024L;
+    tracer->record(span);
+
+    ASSERT_TRUE(tracer->stop());
+    ASSERT_FALSE(tracer->isCapturing());
+    ASSERT_FALSE(tracer->stop());
+
+    auto trace = readTrace(path);
+    std::remove(path);
+
+    ASSERT_EQ(0, trace.find("{\"displayTimeUnit\""));
+    ASSERT_NE(std::string::npos, trace.rfind("]}"));
+    ASSERT_NE(std::string::npos, trace.find("\"name\":\"matmul\""));
+    ASSERT_NE(std::string::npos, trace.find("dense/\\\"kernel\\\""));
+    ASSERT_NE(std::string::npos, trace.find("\"ph\":\"C\""));
+    ASSERT_NE(std::string::npos, trace.find("\"dur\":2.500"));
+}
+
+TEST_F(TraceExporterTests, Test_Sampling_1) {
+    const char* path = "trace_exporter_test_2.json";
+    auto tracer = TraceExporter::getInstance();
+
+    ASSERT_TRUE(tracer->start(path, 3));
+
+    int sampled = 0;
+    for (int e = 0; e < 9; e++)
+        if (tracer->sampleExecution())
+            sampled++;
+
+    ASSERT_EQ(3, sampled);
+
+    tracer->stop();
+    std::remove(path);
+
+    // no capture - nothing is sampled
+    ASSERT_FALSE(tracer->sampleExecution());
+}
+
+TEST_F(TraceExporterTests, Test_Graph_Execution_1) {
+    const char* path = "trace_exporter_test_3.json";
+    auto tracer = TraceExporter::getInstance();
+
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {5, 5});
+    x->assign(-2.0f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2});
+    auto nodeB = new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 2, {1}, {});
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+
+    ASSERT_TRUE(tracer->start(path));
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+
+    tracer->stop();
+
+    // 2 nodes + graph itself
+    ASSERT_LE(3, tracer->numberOfEvents());
+
+    auto trace = readTrace(path);
+    std::remove(path);
+
+    ASSERT_NE(std::string::npos, trace.find("\"name\":\"TRANSFORM_SAME_"));
+    ASSERT_NE(std::string::npos, trace.find("\"name\":\"TRANSFORM_STRICT_"));
+    ASSERT_NE(std::string::npos, trace.find("\"cat\":\"graph\""));
+
+    delete graph;
+}
@@ -21,6 +21,7 @@
 #include "testlayers.h"
 #include <ops/declarable/CustomOperations.h>
 #include <loops/type_conversions.h>
+#include <loops/gradient_codecs.h>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -63,4 +64,133 @@ TEST_F(TypeCastTests, Test_ConvertDtype_1) {
 
     for (int e = 0; e < 5; e++)
         ASSERT_NEAR(exp[e], dst[e], (float16) 0.01f);
-}
\ No newline at end of file
+}
+
+TEST_F(TypeCastTests, Test_Codec_Threshold_Varint_1) {
+    auto x = NDArrayFactory::create<float>('c', {200000});
+    x.linspace(-1.0f, 1e-5f);
+    auto original = x.dup();
+    auto z = NDArrayFactory::create<float>('c', {200000});
+
+    NativeOps ops;
+    auto capacity = ops.estimateGradientsEncodingLength(GradientCodec::THRESHOLD_VARINT, x.lengthOf(), 0.9f);
+    std::vector<uint8_t> buffer(capacity);
+
+    auto length = ops.encodeGradients(nullptr, GradientCodec::THRESHOLD_VARINT, x.buffer(), x.shapeInfo(), x.lengthOf(), buffer.data(), capacity, 0.9f);
+    ASSERT_TRUE(length > 0);
+    ASSERT_EQ(length, GradientCodec::lengthOf(buffer.data()));
+    ASSERT_EQ((int) GradientCodec::THRESHOLD_VARINT, GradientCodec::codecOf(buffer.data()));
+
+    ops.decodeGradients(nullptr, buffer.data(), z.lengthOf(), z.buffer(), z.shapeInfo());
+
+    // decoded + residual gives original, and only elements above threshold were sent
+    for (Nd4jLong e = 0; e < x.lengthOf(); e++) {
+        ASSERT_NEAR(original->e<float>(e), x.e<float>(e) + z.e<float>(e), 1e-5f);
+        ASSERT_NEAR(nd4j::math::nd4j_abs<float>(original->e<float>(e)) >= 0.9f ? 0.9f : 0.0f, nd4j::math::nd4j_abs<float>(z.e<float>(e)), 1e-5f);
+    }
+
+    delete original;
+}
+
+TEST_F(TypeCastTests, Test_Codec_TopK_1) {
+    auto x = NDArrayFactory::create<double>('c', {10}, {0.1, -5.0, 0.3, 2.0, -2.0, 0.0, 7.0, 2.0, -0.5, 1.0});
+    auto z = NDArrayFactory::create<double>('c', {10});
+    auto exp = NDArrayFactory::create<double>('c', {10}, {0.0, -5.0, 0.0, 2.0, -2.0, 0.0, 7.0, 0.0, 0.0, 0.0});
+
+    std::vector<uint8_t> buffer(GradientCodecs::getInstance()->codec(GradientCodec::TOP_K)->maxEncodedLength(10, 4.0f));
+
+    // 4 elements: 7, -5 and first two of three elements with magnitude 2
+    auto length = GradientCodecs::getInstance()->encode(GradientCodec::TOP_K, nd4j::DataType::DOUBLE, x.buffer(), x.lengthOf(), buffer.data(), buffer.size(), 4.0f);
+    ASSERT_TRUE(length > 0);
+
+    GradientCodecs::getInstance()->decode(buffer.data(), nd4j::DataType::DOUBLE, z.buffer(), z.lengthOf());
+    ASSERT_EQ(exp, z);
+
+    // error feedback: encoded elements are removed from source
+    auto residual = NDArrayFactory::create<double>('c', {10}, {0.1, 0.0, 0.3, 0.0, 0.0, 0.0, 0.0, 2.0, -0.5, 1.0});
+    ASSERT_EQ(residual, x);
+}
+
+TEST_F(TypeCastTests, Test_Codec_TopK_2) {
+    auto x = NDArrayFactory::create<float>('c', {300000});
+    x.linspace(1.0f, 1.0f);
+    auto z = NDArrayFactory::create<float>('c', {300000});
+
+    std::vector<uint8_t> buffer(GradientCodecs::getInstance()->codec(GradientCodec::TOP_K)->maxEncodedLength(x.lengthOf(), 0.01f));
+
+    // too small buffer: nothing is encoded, source stays intact
+    auto length = GradientCodecs::getInstance()->encode(GradientCodec::TOP_K, nd4j::DataType::FLOAT32, x.buffer(), x.lengthOf(), buffer.data(), 100, 0.01f);
+    ASSERT_TRUE(length < -100);
+    ASSERT_NEAR(300000.f, x.e<float>(299999), 1e-5f);
+
+    length = GradientCodecs::getInstance()->encode(GradientCodec::TOP_K, nd4j::DataType::FLOAT32, x.buffer(), x.lengthOf(), buffer.data(), buffer.size(), 0.01f);
+    ASSERT_TRUE(length > 0);
+
+    GradientCodecs::getInstance()->decode(buffer.data(), nd4j::DataType::FLOAT32, z.buffer(), z.lengthOf());
+
+    // largest 1% of elements are the last 3000 ones
+    for (Nd4jLong e = 0; e < x.lengthOf(); e++) {
+        if (e < 297000) {
+            ASSERT_NEAR(0.0f, z.e<float>(e), 1e-5f);
+            ASSERT_NEAR(e + 1.0f, x.e<float>(e), 1e-5f);
+        } else {
+            ASSERT_NEAR(e + 1.0f, z.e<float>(e), 1e-5f);
+            ASSERT_NEAR(0.0f, x.e<float>(e), 1e-5f);
+        }
+    }
+}
+
+TEST_F(TypeCastTests, Test_Codec_Sign_1) {
+    auto x = NDArrayFactory::create<float>('c', {8}, {1.0f, -2.0f, 3.0f, -4.0f, 0.0f, 4.0f, -6.0f, 2.0f});
+    auto z = NDArrayFactory::create<float>('c', {8});
+
+    // non-negative mean is 2, negative mean magnitude is 4
+    auto exp = NDArrayFactory::create<float>('c', {8}, {2.0f, -4.0f, 2.0f, -4.0f, 2.0f, 2.0f, -4.0f, 2.0f});
+    auto residual = NDArrayFactory::create<float>('c', {8}, {-1.0f, 2.0f, 1.0f, 0.0f, -2.0f, 2.0f, -2.0f, 0.0f});
+
+    std::vector<uint8_t> buffer(GradientCodecs::getInstance()->codec(GradientCodec::SIGN_1BIT)->maxEncodedLength(8, 0.0f));
+    auto length = GradientCodecs::getInstance()->encode(GradientCodec::SIGN_1BIT, nd4j::DataType::FLOAT32, x.buffer(), x.lengthOf(), buffer.data(), buffer.size(), 0.0f);
+    ASSERT_EQ(GradientCodec::HEADER_LENGTH + 12, length);
+
+    GradientCodecs::getInstance()->decode(buffer.data(), nd4j::DataType::FLOAT32, z.buffer(), z.lengthOf());
+
+    ASSERT_EQ(exp, z);
+    ASSERT_EQ(residual, x);
+}
+
+TEST_F(TypeCastTests, Test_Codec_Sign_2) {
+    auto x = NDArrayFactory::create<float>('c', {10000});
+    x.linspace(-1.0f, 2e-4f);
+    auto original = x.dup();
+    auto z1 = NDArrayFactory::create<float>('c', {10000});
+    auto z2 = NDArrayFactory::create<float>('c', {10000});
+    auto x1 = x.dup();
+
+    std::vector<uint8_t> buffer(GradientCodecs::getInstance()->codec(GradientCodec::SIGN_2BIT)->maxEncodedLength(x.lengthOf(), 0.0f));
+
+    GradientCodecs::getInstance()->encode(GradientCodec::SIGN_1BIT, nd4j::DataType::FLOAT32, x1->buffer(), x1->lengthOf(), buffer.data(), buffer.size(), 0.0f);
+    GradientCodecs::getInstance()->decode(buffer.data(), nd4j::DataType::FLOAT32, z1.buffer(), z1.lengthOf());
+
+    GradientCodecs::getInstance()->encode(GradientCodec::SIGN_2BIT, nd4j::DataType::FLOAT32, x.buffer(), x.lengthOf(), buffer.data(), buffer.size(), 0.0f);
+    GradientCodecs::getInstance()->decode(buffer.data(), nd4j::DataType::FLOAT32, z2.buffer(), z2.lengthOf());
+
+    // both codecs preserve signs and keep exact residual, 2 bits give smaller error
+    double error1 = 0.0, error2 = 0.0;
+    for (Nd4jLong e = 0; e < x.lengthOf(); e++) {
+        auto v = original->e<float>(e);
+        ASSERT_NEAR(v, x.e<float>(e) + z2.e<float>(e), 1e-5f);
+        ASSERT_NEAR(v, x1->e<float>(e) + z1.e<float>(e), 1e-5f);
+        if (v != 0.0f) {
+            ASSERT_EQ(v > 0.0f, z1.e<float>(e) > 0.0f);
+            ASSERT_EQ(v > 0.0f, z2.e<float>(e) > 0.0f);
+        }
+
+        error1 += x1->e<float>(e) * x1->e<float>(e);
+        error2 += x.e<float>(e) * x.e<float>(e);
+    }
+
+    ASSERT_TRUE(error2 < error1);
+
+    delete original;
+    delete x1;
+}
@@ -217,4 +217,35 @@ TEST_F(VariableSpaceTest, Test_DType_Conversion_1) {
     delete sd;
     delete sf;
     */
-}
\ No newline at end of file
+}
+TEST_F(VariableSpaceTest, Slots_1) {
+    VariableSpace space;
+
+    std::pair<int, int> pairA(-1, 0);
+    std::pair<int, int> pairB(3, 1);
+
+    auto slotA = space.registerSlot(pairA);
+    auto slotB = space.registerSlot(pairB);
+
+    ASSERT_NE(slotA, slotB);
+    ASSERT_EQ(slotA, space.registerSlot(pairA));
+    ASSERT_EQ(2, space.numberOfSlots());
+
+    // nothing was put yet
+    ASSERT_TRUE(space.getVariableBySlot(slotB, pairB) == nullptr);
+
+    space.putVariable(-1, NDArrayFactory::create_<float>('c', {2, 2}));
+    space.putVariable(pairB, NDArrayFactory::create_<float>('c', {3, 3}));
+
+    ASSERT_TRUE(space.getVariable(pairA) == space.getVariableBySlot(slotA, pairA));
+    ASSERT_TRUE(space.getVariable(pairB) == space.getVariableBySlot(slotB, pairB));
+
+    // slot doesn't belong to this pair
+    ASSERT_TRUE(space.getVariableBySlot(slotA, pairB) == nullptr);
+    ASSERT_TRUE(space.getVariableBySlot(5, pairB) == nullptr);
+
+    // cached variable is dropped once pair gets new one
+    auto replacement = new Variable(NDArrayFactory::create_<float>('c', {4}), nullptr, 3, 1);
+    space.putVariable(pairB, replacement);
+    ASSERT_TRUE(replacement == space.getVariableBySlot(slotB, pairB));
+}
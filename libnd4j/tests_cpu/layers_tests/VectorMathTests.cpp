@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Tests for vectorised transcendental kernels
+//
+
+#include "testlayers.h"
+#include <ops/declarable/CustomOperations.h>
+#include <NDArray.h>
+#include <helpers/VectorMath.h>
+#include <Environment.h>
+#include <cmath>
+
+using namespace nd4j;
+
+class VectorMathTests : public testing::Test {
+public:
+    MathPrecision precision;
+
+    VectorMathTests() {
+        precision = Environment::getInstance()->mathPrecision();
+    }
+
+    ~VectorMathTests() {
+        Environment::getInstance()->setMathPrecision(precision);
+    }
+};
+
+template <typename OpType, bool fast>
+static double maxRelativeError(float from, float to, int steps) {
+    double result = 0.;
+    for (int e = 0; e < steps; e++) {
+        float x = from + (to - from) * e / (steps - 1);
+        double exp = OpType::template ref<double>(static_cast<double>(x));
+        double got = OpType::template op<fast>(x);
+        double err = std::fabs(got - exp) / nd4j::math::nd4j_max<double>(std::fabs(exp), 1e-30);
+        result = nd4j::math::nd4j_max<double>(result, err);
+    }
+    return result;
+}
+
+TEST_F(VectorMathTests, Test_Precise_Bounds_1) {
+    ASSERT_GT(1.5e-7, (maxRelativeError<math::vec::Exp, false>(-87.f, 88.f, 100000)));
+    ASSERT_GT(1.5e-7, (maxRelativeError<math::vec::Log, false>(1e-30f, 1e30f, 100000)));
+    ASSERT_GT(1.5e-7, (maxRelativeError<math::vec::Log, false>(0.5f, 2.f, 100000)));
+    ASSERT_GT(2.5e-7, (maxRelativeError<math::vec::Tanh, false>(-20.f, 20.f, 100000)));
+    ASSERT_GT(3.5e-7, (maxRelativeError<math::vec::Sigmoid, false>(-80.f, 80.f, 100000)));
+    ASSERT_GT(3.5e-7, (maxRelativeError<math::vec::Erf, false>(-5.f, 5.f, 100000)));
+}
+
+TEST_F(VectorMathTests, Test_Fast_Bounds_1) {
+    ASSERT_GT(5e-6, (maxRelativeError<math::vec::Exp, true>(-87.f, 88.f, 100000)));
+    ASSERT_GT(2e-6, (maxRelativeError<math::vec::Log, true>(1e-30f, 1e30f, 100000)));
+    ASSERT_GT(5e-7, (maxRelativeError<math::vec::Tanh, true>(-20.f, 20.f, 100000)));
+    ASSERT_GT(5e-6, (maxRelativeError<math::vec::Sigmoid, true>(-80.f, 80.f, 100000)));
+    ASSERT_GT(6e-7, (maxRelativeError<math::vec::Erf, true>(-5.f, 5.f, 100000)));
+}
+
+TEST_F(VectorMathTests, Test_Special_Values_1) {
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    ASSERT_EQ(inf, math::vec::exp<false>(inf));
+    ASSERT_EQ(inf, math::vec::exp<false>(100.f));
+    ASSERT_EQ(0.f, math::vec::exp<false>(-inf));
+    ASSERT_EQ(1.f, math::vec::exp<false>(0.f));
+    ASSERT_TRUE(std::isnan(math::vec::exp<false>(nan)));
+
+    ASSERT_EQ(-inf, math::vec::log<false>(0.f));
+    ASSERT_EQ(inf, math::vec::log<false>(inf));
+    ASSERT_EQ(0.f, math::vec::log<false>(1.f));
+    ASSERT_TRUE(std::isnan(math::vec::log<false>(-1.f)));
+    ASSERT_TRUE(std::isnan(math::vec::log<false>(nan)));
+
+    ASSERT_EQ(1.f, math::vec::tanh<false>(inf));
+    ASSERT_EQ(-1.f, math::vec::tanh<false>(-inf));
+    ASSERT_EQ(1.f, math::vec::sigmoid<false>(inf));
+    ASSERT_EQ(0.f, math::vec::sigmoid<false>(-inf));
+    ASSERT_EQ(1.f, math::vec::erf<false>(inf));
+    ASSERT_EQ(-1.f, math::vec::erf<false>(-inf));
+}
+
+TEST_F(VectorMathTests, Test_Transform_Strict_1) {
+    auto x = NDArrayFactory::create<float>('c', {5, 1000});
+    x.linspace(-10.f, 0.004f);
+
+    std::vector<transform::StrictOps> ops = {transform::Exp, transform::Tanh, transform::Sigmoid, transform::Erf, transform::GELU, transform::Swish, transform::ELU};
+
+    for (auto op : ops) {
+        Environment::getInstance()->setMathPrecision(MATH_LIBM);
+        auto exp = x.transform(op);
+
+        Environment::getInstance()->setMathPrecision(MATH_VECTOR);
+        auto z = x.transform(op);
+        ASSERT_TRUE(exp.equalsTo(z, 1e-6));
+
+        Environment::getInstance()->setMathPrecision(MATH_FAST);
+        z = x.transform(op);
+        ASSERT_TRUE(exp.equalsTo(z, 1e-5));
+    }
+}
+
+TEST_F(VectorMathTests, Test_Transform_Strict_2) {
+    auto x = NDArrayFactory::create<float>('c', {3, 700});
+    x.linspace(0.01f, 0.01f);
+
+    Environment::getInstance()->setMathPrecision(MATH_LIBM);
+    auto exp = x.transform(transform::Log);
+
+    Environment::getInstance()->setMathPrecision(MATH_VECTOR);
+    auto z = x.transform(transform::Log);
+
+    ASSERT_TRUE(exp.equalsTo(z, 1e-6));
+}
+
+TEST_F(VectorMathTests, Test_Transform_Strict_Half_1) {
+    auto x = NDArrayFactory::create<float16>('c', {1000});
+    x.linspace(-4.f, 0.008f);
+
+    Environment::getInstance()->setMathPrecision(MATH_LIBM);
+    auto exp = x.transform(transform::Tanh);
+
+    Environment::getInstance()->setMathPrecision(MATH_VECTOR);
+    auto z = x.transform(transform::Tanh);
+
+    ASSERT_TRUE(exp.equalsTo(z, 1e-3));
+}
+
+TEST_F(VectorMathTests, Test_Transform_Strict_View_1) {
+    auto x = NDArrayFactory::create<float>('c', {32, 64});
+    x.linspace(-3.f, 0.003f);
+
+    // strided view falls back to TransformLoops
+    auto t = x.transpose();
+    Environment::getInstance()->setMathPrecision(MATH_VECTOR);
+    auto z = t->transform(transform::Sigmoid);
+
+    Environment::getInstance()->setMathPrecision(MATH_LIBM);
+    auto exp = t->transform(transform::Sigmoid);
+
+    ASSERT_TRUE(exp.equalsTo(z, 1e-6));
+    delete t;
+}
+
+TEST_F(VectorMathTests, Test_Softmax_1) {
+    auto x = NDArrayFactory::create<float>('c', {16, 256});
+    x.linspace(-20.f, 0.01f);
+
+    nd4j::ops::softmax op;
+
+    Environment::getInstance()->setMathPrecision(MATH_LIBM);
+    auto resultA = op.execute({&x}, {}, {1}, {});
+    ASSERT_EQ(Status::OK(), resultA->status());
+
+    Environment::getInstance()->setMathPrecision(MATH_VECTOR);
+    auto resultB = op.execute({&x}, {}, {1}, {});
+    ASSERT_EQ(Status::OK(), resultB->status());
+
+    ASSERT_TRUE(resultA->at(0)->equalsTo(resultB->at(0), 1e-6));
+
+    delete resultA;
+    delete resultB;
+}
+
+TEST_F(VectorMathTests, Test_Default_Precision_1) {
+    // vectorised kernels are opt-in, default results are the same as libm ones
+    ASSERT_EQ(MATH_LIBM, precision);
+
+    auto x = NDArrayFactory::create<float>('c', {4, 100});
+    x.linspace(-5.f, 0.025f);
+
+    auto z = x.transform(transform::Tanh);
+
+    Environment::getInstance()->setMathPrecision(MATH_LIBM);
+    auto exp = x.transform(transform::Tanh);
+
+    ASSERT_TRUE(exp.equalsTo(z, 0.));
+}
+
+TEST_F(VectorMathTests, Test_Precision_Validation_1) {
+    ASSERT_ANY_THROW(Environment::getInstance()->setMathPrecision(static_cast<MathPrecision>(5)));
+}